@@ -0,0 +1,197 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "access_token.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+namespace livekit {
+namespace bench {
+
+namespace {
+
+using Digest = std::array<std::uint8_t, 32>;
+
+constexpr std::uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+std::uint32_t rotr(std::uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+Digest sha256(const std::string &data) {
+  std::uint32_t h[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+  std::string msg = data;
+  const std::uint64_t bit_len = static_cast<std::uint64_t>(data.size()) * 8;
+  msg.push_back(static_cast<char>(0x80));
+  while (msg.size() % 64 != 56) {
+    msg.push_back('\0');
+  }
+  for (int i = 7; i >= 0; --i) {
+    msg.push_back(static_cast<char>((bit_len >> (i * 8)) & 0xff));
+  }
+
+  for (std::size_t block = 0; block < msg.size(); block += 64) {
+    std::uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+      const auto *p =
+          reinterpret_cast<const unsigned char *>(msg.data() + block + i * 4);
+      w[i] = (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) |
+             (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+      const std::uint32_t s0 =
+          rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      const std::uint32_t s1 =
+          rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+    std::uint32_t e = h[4], f = h[5], g = h[6], k = h[7];
+    for (int i = 0; i < 64; ++i) {
+      const std::uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+      const std::uint32_t ch = (e & f) ^ (~e & g);
+      const std::uint32_t t1 = k + s1 + ch + kRoundConstants[i] + w[i];
+      const std::uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+      const std::uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      const std::uint32_t t2 = s0 + maj;
+      k = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+    h[5] += f;
+    h[6] += g;
+    h[7] += k;
+  }
+
+  Digest out;
+  for (int i = 0; i < 8; ++i) {
+    out[i * 4] = static_cast<std::uint8_t>(h[i] >> 24);
+    out[i * 4 + 1] = static_cast<std::uint8_t>(h[i] >> 16);
+    out[i * 4 + 2] = static_cast<std::uint8_t>(h[i] >> 8);
+    out[i * 4 + 3] = static_cast<std::uint8_t>(h[i]);
+  }
+  return out;
+}
+
+Digest hmacSha256(const std::string &key, const std::string &message) {
+  std::string block_key = key;
+  if (block_key.size() > 64) {
+    const Digest d = sha256(key);
+    block_key.assign(d.begin(), d.end());
+  }
+  block_key.resize(64, '\0');
+  std::string inner(64, '\0');
+  std::string outer(64, '\0');
+  for (int i = 0; i < 64; ++i) {
+    inner[i] = static_cast<char>(block_key[i] ^ 0x36);
+    outer[i] = static_cast<char>(block_key[i] ^ 0x5c);
+  }
+  const Digest inner_hash = sha256(inner + message);
+  return sha256(outer + std::string(inner_hash.begin(), inner_hash.end()));
+}
+
+std::string base64Url(const std::string &in) {
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+  std::string out;
+  std::size_t i = 0;
+  for (; i + 3 <= in.size(); i += 3) {
+    const std::uint32_t v = (std::uint8_t(in[i]) << 16) |
+                            (std::uint8_t(in[i + 1]) << 8) |
+                            std::uint8_t(in[i + 2]);
+    out.push_back(kAlphabet[(v >> 18) & 63]);
+    out.push_back(kAlphabet[(v >> 12) & 63]);
+    out.push_back(kAlphabet[(v >> 6) & 63]);
+    out.push_back(kAlphabet[v & 63]);
+  }
+  const std::size_t rest = in.size() - i;
+  if (rest > 0) {
+    std::uint32_t v = std::uint8_t(in[i]) << 16;
+    if (rest == 2) {
+      v |= std::uint8_t(in[i + 1]) << 8;
+    }
+    out.push_back(kAlphabet[(v >> 18) & 63]);
+    out.push_back(kAlphabet[(v >> 12) & 63]);
+    if (rest == 2) {
+      out.push_back(kAlphabet[(v >> 6) & 63]);
+    }
+  }
+  return out; // unpadded, as JWT requires
+}
+
+} // namespace
+
+std::string hmacSha256Hex(const std::string &key, const std::string &message) {
+  static const char kHex[] = "0123456789abcdef";
+  const Digest d = hmacSha256(key, message);
+  std::string out;
+  for (std::uint8_t b : d) {
+    out.push_back(kHex[b >> 4]);
+    out.push_back(kHex[b & 15]);
+  }
+  return out;
+}
+
+std::string makeJoinToken(const std::string &api_key,
+                          const std::string &api_secret,
+                          const std::string &room, const std::string &identity,
+                          std::chrono::seconds ttl) {
+  const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+  // Room names and identities are generated by the benchmarks and need no
+  // JSON escaping.
+  std::ostringstream claims;
+  claims << "{\"iss\":\"" << api_key << "\",\"sub\":\"" << identity
+         << "\",\"name\":\"" << identity << "\",\"nbf\":" << now - 10
+         << ",\"exp\":" << now + ttl.count() << ",\"video\":{\"room\":\""
+         << room
+         << "\",\"roomJoin\":true,\"canPublish\":true,"
+            "\"canSubscribe\":true,\"canPublishData\":true}}";
+  const std::string signing_input =
+      base64Url("{\"alg\":\"HS256\",\"typ\":\"JWT\"}") + "." +
+      base64Url(claims.str());
+  const Digest sig = hmacSha256(api_secret, signing_input);
+  return signing_input + "." + base64Url(std::string(sig.begin(), sig.end()));
+}
+
+} // namespace bench
+} // namespace livekit
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace livekit {
+namespace bench {
+
+/**
+ * Mint a room-join access token (HS256 JWT) for benchmarks, so a run against
+ * `livekit-server --dev` (key "devkey", secret "secret") needs no external
+ * token tooling. Not meant for production use.
+ */
+std::string makeJoinToken(const std::string &api_key,
+                          const std::string &api_secret,
+                          const std::string &room, const std::string &identity,
+                          std::chrono::seconds ttl = std::chrono::hours(6));
+
+/// Hex-encoded HMAC-SHA256, exposed for self-checks.
+std::string hmacSha256Hex(const std::string &key, const std::string &message);
+
+} // namespace bench
+} // namespace livekit
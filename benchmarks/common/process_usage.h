@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+#if defined(__linux__)
+#include <fstream>
+#endif
+
+namespace livekit {
+namespace bench {
+
+/// Process-wide CPU time and resident memory at one instant.
+struct ProcessUsage {
+  std::chrono::microseconds cpu{0}; ///< User + system time.
+  std::size_t rss_bytes = 0;        ///< 0 if unsupported on this platform.
+  std::chrono::steady_clock::time_point when;
+
+  static ProcessUsage now() {
+    ProcessUsage usage;
+    usage.when = std::chrono::steady_clock::now();
+#if defined(__unix__) || defined(__APPLE__)
+    rusage ru{};
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+      usage.cpu =
+          std::chrono::seconds(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+          std::chrono::microseconds(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec);
+    }
+#endif
+#if defined(__linux__)
+    // Current (not peak) RSS: the second field of statm, in pages.
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size_pages = 0;
+    std::size_t resident_pages = 0;
+    if (statm >> size_pages >> resident_pages) {
+      usage.rss_bytes =
+          resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+#elif defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info),
+                  &count) == KERN_SUCCESS) {
+      usage.rss_bytes = static_cast<std::size_t>(info.resident_size);
+    }
+#endif
+    return usage;
+  }
+};
+
+/// CPU use between two samples, in percent of one core.
+inline double cpuPercent(const ProcessUsage &from, const ProcessUsage &to) {
+  const auto wall = std::chrono::duration_cast<std::chrono::microseconds>(
+      to.when - from.when);
+  if (wall.count() <= 0) {
+    return 0.0;
+  }
+  return 100.0 * static_cast<double>((to.cpu - from.cpu).count()) /
+         static_cast<double>(wall.count());
+}
+
+} // namespace bench
+} // namespace livekit
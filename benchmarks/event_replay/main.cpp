@@ -0,0 +1,210 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Records the FFI events of a live session, and replays recordings offline
+// so room and delegate dispatch can be measured without a server:
+//
+//   livekit_event_replay record --url ws://localhost:7880 --seconds 30 \
+//       --out session.lkev
+//   livekit_event_replay replay session.lkev --speed 0 --repeat 20
+//
+// Record a session with other participants publishing (e.g. the
+// room_scale bench or the examples) to capture a useful event mix.
+
+#include <livekit/livekit.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "access_token.h"
+
+using namespace livekit;
+
+namespace {
+
+struct Args {
+  std::string mode;
+  std::string file;
+  std::string url = "ws://localhost:7880";
+  std::string api_key = "devkey";
+  std::string api_secret = "secret";
+  std::string room = "replay-bench";
+  int seconds = 30;
+  double speed = 0.0;
+  int repeat = 1;
+};
+
+void usage() {
+  std::cout
+      << "Usage: livekit_event_replay record --out FILE [--url URL]\n"
+         "         [--room NAME] [--seconds N] [--api-key KEY]\n"
+         "         [--api-secret SECRET]\n"
+         "       livekit_event_replay replay FILE [--speed X] [--repeat N]\n"
+         "\n"
+         "  --speed   1 keeps the recorded pacing, 0 (default) replays\n"
+         "            back to back\n"
+         "  --repeat  replays, each into a fresh Room (default 1)\n";
+}
+
+bool parseArgs(int argc, char **argv, Args &args) {
+  if (argc < 2) {
+    return false;
+  }
+  args.mode = argv[1];
+  int i = 2;
+  if (args.mode == "replay") {
+    if (argc < 3) {
+      return false;
+    }
+    args.file = argv[i++];
+  } else if (args.mode != "record") {
+    return false;
+  }
+  for (; i < argc; ++i) {
+    const std::string a = argv[i];
+    const char *v = i + 1 < argc ? argv[++i] : nullptr;
+    if (!v) {
+      return false;
+    }
+    if (a == "--out") {
+      args.file = v;
+    } else if (a == "--url") {
+      args.url = v;
+    } else if (a == "--room") {
+      args.room = v;
+    } else if (a == "--seconds") {
+      args.seconds = std::max(1, std::atoi(v));
+    } else if (a == "--api-key") {
+      args.api_key = v;
+    } else if (a == "--api-secret") {
+      args.api_secret = v;
+    } else if (a == "--speed") {
+      args.speed = std::max(0.0, std::atof(v));
+    } else if (a == "--repeat") {
+      args.repeat = std::max(1, std::atoi(v));
+    } else {
+      return false;
+    }
+  }
+  return !args.file.empty();
+}
+
+// Counts the delegate calls a replay produces.
+class CountingDelegate : public RoomDelegate {
+public:
+  std::atomic<std::uint64_t> calls{0};
+
+  void onParticipantConnected(Room &,
+                              const ParticipantConnectedEvent &) override {
+    ++calls;
+  }
+  void
+  onParticipantDisconnected(Room &,
+                            const ParticipantDisconnectedEvent &) override {
+    ++calls;
+  }
+  void onTrackSubscribed(Room &, const TrackSubscribedEvent &) override {
+    ++calls;
+  }
+  void onActiveSpeakersChanged(Room &,
+                               const ActiveSpeakersChangedEvent &) override {
+    ++calls;
+  }
+  void onUserPacketReceived(Room &, const UserDataPacketEvent &) override {
+    ++calls;
+  }
+};
+
+int record(const Args &args) {
+  RoomOptions options;
+  options.auto_subscribe = true;
+  // Start before connecting so the connect callback is in the recording.
+  startEventRecording(args.file);
+  Room room;
+  const std::string token = bench::makeJoinToken(
+      args.api_key, args.api_secret, args.room, "replay-recorder");
+  const ConnectResult result =
+      room.connectAsync(args.url, token, options).get();
+  if (!result.connected) {
+    stopEventRecording();
+    std::cerr << "Connect failed: " << result.error << "\n";
+    return 1;
+  }
+  std::cout << "Recording " << args.room << " for " << args.seconds
+            << " s to " << args.file << "\n";
+  std::this_thread::sleep_for(std::chrono::seconds(args.seconds));
+  const std::uint64_t events = stopEventRecording();
+  std::cout << "Recorded " << events << " events\n";
+  return 0;
+}
+
+int replay(const Args &args) {
+  double total_s = 0.0;
+  std::uint64_t events = 0;
+  for (int i = 0; i < args.repeat; ++i) {
+    CountingDelegate delegate;
+    auto room = std::make_unique<Room>();
+    room->setDelegate(&delegate);
+    EventReplayOptions options;
+    options.speed = args.speed;
+    options.room = room.get();
+    const EventReplayResult r = replayEvents(args.file, options);
+    const double s = std::chrono::duration<double>(r.elapsed).count();
+    total_s += s;
+    events += r.events;
+    std::cout << std::fixed << std::setprecision(3) << "Replay " << i + 1
+              << ": " << r.events << " events (" << r.skipped
+              << " replies skipped, " << r.bytes << " bytes) in " << s * 1e3
+              << " ms, recorded "
+              << std::chrono::duration<double>(r.recorded).count()
+              << " s, room " << (r.room_attached ? "attached" : "not attached")
+              << ", " << delegate.calls.load() << " delegate calls\n";
+    room->setDelegate(nullptr);
+  }
+  if (total_s > 0.0) {
+    std::cout << std::fixed << std::setprecision(0)
+              << "Throughput: " << static_cast<double>(events) / total_s
+              << " events/s\n";
+  }
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Args args;
+  if (!parseArgs(argc, argv, args)) {
+    usage();
+    return 2;
+  }
+  livekit::initialize(LogSink::kConsole);
+  int code = 0;
+  try {
+    code = args.mode == "record" ? record(args) : replay(args);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    code = 1;
+  }
+  livekit::shutdown();
+  return code;
+}
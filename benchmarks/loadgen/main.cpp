@@ -0,0 +1,531 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Headless synthetic load: N participants in one process, all joining one
+// room, each publishing and subscribing per a profile. Reports CPU and RSS
+// per participant, data and RPC delivery latency and dropped frames, to
+// find where one process stops keeping up:
+//
+//   livekit_loadgen --participants 20 --profile audio,video --seconds 60
+//
+// The media loops follow examples/simple_room/fallback_capture.cpp (noise
+// audio in 10 ms frames, a color-cycling 720p picture at 30 fps), without
+// the WAV file so the generator needs no assets.
+
+#include <livekit/livekit.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "access_token.h"
+#include "process_usage.h"
+
+using namespace livekit;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr const char *kDataTopic = "loadgen";
+constexpr const char *kRpcMethod = "loadgen.echo";
+
+struct Profile {
+  bool audio = false;
+  bool video = false;
+  bool data = false;
+  bool rpc = false;
+};
+
+struct Args {
+  std::string url = "ws://localhost:7880";
+  std::string api_key = "devkey";
+  std::string api_secret = "secret";
+  std::string room = "loadgen";
+  int participants = 10;
+  int seconds = 30;
+  Profile profile{true, false, false, false};
+  bool subscribe = true;
+  int data_rate = 50;   // packets per second per participant
+  int data_size = 1024; // bytes
+  int rpc_rate = 5;     // calls per second per participant
+  bool sharded = true;
+};
+
+void usage() {
+  std::cout
+      << "Usage: livekit_loadgen [--url URL] [--room NAME]\n"
+         "         [--participants N] [--seconds N]\n"
+         "         [--profile audio,video,data,rpc] [--no-subscribe]\n"
+         "         [--data-rate N] [--data-size BYTES] [--rpc-rate N]\n"
+         "         [--api-key KEY] [--api-secret SECRET] [--inline]\n"
+         "\n"
+         "  --profile    what each participant publishes (default audio):\n"
+         "               audio  48 kHz mono noise, 10 ms frames\n"
+         "               video  1280x720 I420 at 30 fps\n"
+         "               data   reliable packets at --data-rate per second\n"
+         "               rpc    calls to the next participant at --rpc-rate\n"
+         "  --no-subscribe  do not subscribe to other participants' tracks\n"
+         "  --inline     dispatch events on the FFI thread instead of\n"
+         "               EventDispatchOptions::manyRooms()\n";
+}
+
+bool parseProfile(const std::string &list, Profile &profile) {
+  profile = Profile{};
+  std::stringstream in(list);
+  std::string item;
+  while (std::getline(in, item, ',')) {
+    if (item == "audio") {
+      profile.audio = true;
+    } else if (item == "video") {
+      profile.video = true;
+    } else if (item == "data") {
+      profile.data = true;
+    } else if (item == "rpc") {
+      profile.rpc = true;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool parseArgs(int argc, char **argv, Args &args) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--inline") {
+      args.sharded = false;
+      continue;
+    }
+    if (a == "--no-subscribe") {
+      args.subscribe = false;
+      continue;
+    }
+    const char *v = i + 1 < argc ? argv[++i] : nullptr;
+    if (a == "--help" || a == "-h" || !v) {
+      return false;
+    }
+    if (a == "--url") {
+      args.url = v;
+    } else if (a == "--room") {
+      args.room = v;
+    } else if (a == "--participants") {
+      args.participants = std::max(1, std::atoi(v));
+    } else if (a == "--seconds") {
+      args.seconds = std::max(1, std::atoi(v));
+    } else if (a == "--profile") {
+      if (!parseProfile(v, args.profile)) {
+        return false;
+      }
+    } else if (a == "--data-rate") {
+      args.data_rate = std::max(1, std::atoi(v));
+    } else if (a == "--data-size") {
+      args.data_size = std::max(16, std::atoi(v));
+    } else if (a == "--rpc-rate") {
+      args.rpc_rate = std::max(1, std::atoi(v));
+    } else if (a == "--api-key") {
+      args.api_key = v;
+    } else if (a == "--api-secret") {
+      args.api_secret = v;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now().time_since_epoch())
+      .count();
+}
+
+// Latency samples in milliseconds; percentiles at report time.
+class Samples {
+public:
+  void add(double ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    values_.push_back(ms);
+  }
+
+  double percentile(double p) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (values_.empty()) {
+      return 0.0;
+    }
+    std::vector<double> sorted = values_;
+    std::sort(sorted.begin(), sorted.end());
+    const auto i = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1));
+    return sorted[i];
+  }
+
+  std::size_t count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return values_.size();
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<double> values_;
+};
+
+// One headless participant: its room, synthetic sources, the streams it
+// subscribed to and what it measured.
+class LoadParticipant : public RoomDelegate {
+public:
+  LoadParticipant(std::string identity, std::string next_identity,
+                  const Args &args)
+      : identity_(std::move(identity)),
+        next_identity_(std::move(next_identity)), args_(args) {}
+
+  ~LoadParticipant() override { stop(); }
+
+  const std::string &identity() const { return identity_; }
+
+  AsyncOperation<ConnectResult> connect(const std::string &token) {
+    RoomOptions options;
+    options.auto_subscribe = args_.subscribe;
+    room_.setDelegate(this);
+    room_.registerDataPacketHandler(
+        kDataTopic, [this](const UserDataPacketView &packet) {
+          std::int64_t sent = 0;
+          if (packet.size >= sizeof(sent)) {
+            std::memcpy(&sent, packet.data, sizeof(sent));
+            data_latency_.add((nowNs() - sent) / 1e6);
+          }
+        });
+    return room_.connectAsync(args_.url, token, options);
+  }
+
+  // After connect: publish tracks, register the RPC method, start loops.
+  void start() {
+    LocalParticipant *local = room_.localParticipant();
+    if (!local) {
+      return;
+    }
+    if (args_.profile.rpc) {
+      local->registerRpcMethod(
+          kRpcMethod,
+          [](const RpcInvocationData &data) -> std::optional<std::string> {
+            return data.payload;
+          });
+    }
+    if (args_.profile.audio) {
+      audio_source_ = std::make_shared<AudioSource>(48000, 1, 0);
+      TrackPublishOptions options;
+      options.source = TrackSource::SOURCE_MICROPHONE;
+      local->publishTrack(
+          LocalAudioTrack::createLocalAudioTrack("noise", audio_source_),
+          options);
+    }
+    if (args_.profile.video) {
+      video_source_ = std::make_shared<VideoSource>(1280, 720, 2);
+      TrackPublishOptions options;
+      options.source = TrackSource::SOURCE_CAMERA;
+      local->publishTrack(
+          LocalVideoTrack::createLocalVideoTrack("color", video_source_),
+          options);
+    }
+    running_.store(true);
+    if (audio_source_ || video_source_) {
+      media_pacer_ = MediaClock::shared().schedule(
+          10ms, [this](std::uint64_t tick) { mediaTick(tick); });
+    }
+    if (args_.profile.data || args_.profile.rpc) {
+      control_thread_ = std::thread([this] { runControl(); });
+    }
+  }
+
+  void stop() {
+    running_.store(false);
+    if (media_pacer_.active()) {
+      media_pacer_.stop();
+      if (audio_source_) {
+        audio_source_->flush(500);
+      }
+    }
+    if (control_thread_.joinable()) {
+      control_thread_.join();
+    }
+    room_.setDelegate(nullptr);
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    video_streams_.clear();
+    audio_streams_.clear();
+  }
+
+  void onTrackSubscribed(Room &, const TrackSubscribedEvent &ev) override {
+    if (!ev.track) {
+      return;
+    }
+    // Push mode keeps subscribers off extra threads; frames are counted
+    // and released on the dispatch thread.
+    if (ev.track->kind() == TrackKind::KIND_VIDEO) {
+      VideoStream::Options options;
+      options.format = VideoBufferType::I420;
+      options.zero_copy = true;
+      options.on_frame = [this](VideoFrameEvent &&) { ++video_received_; };
+      auto stream = VideoStream::fromTrack(ev.track, options);
+      std::lock_guard<std::mutex> lock(streams_mutex_);
+      video_streams_.push_back(std::move(stream));
+    } else if (ev.track->kind() == TrackKind::KIND_AUDIO) {
+      AudioStream::Options options;
+      options.on_frame = [this](AudioFrameViewEvent &&) { ++audio_received_; };
+      auto stream = AudioStream::fromTrack(ev.track, options);
+      std::lock_guard<std::mutex> lock(streams_mutex_);
+      audio_streams_.push_back(std::move(stream));
+    }
+  }
+
+  // Frames the subscribed streams dropped, plus frames the publish side
+  // could not queue.
+  std::uint64_t droppedFrames() const {
+    std::uint64_t dropped = publish_dropped_.load();
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    for (const auto &s : video_streams_) {
+      dropped += s->stats().frames_dropped;
+    }
+    for (const auto &s : audio_streams_) {
+      dropped += s->stats().frames_dropped;
+    }
+    return dropped;
+  }
+
+  std::uint64_t audioReceived() const { return audio_received_.load(); }
+  std::uint64_t videoReceived() const { return video_received_.load(); }
+  std::uint64_t rpcFailures() const { return rpc_failures_.load(); }
+  const Samples &dataLatency() const { return data_latency_; }
+  const Samples &rpcLatency() const { return rpc_latency_; }
+
+private:
+  // One 10 ms tick of synthetic media. Runs on the shared MediaClock
+  // thread, so every participant's sources are paced by the same thread.
+  void mediaTick(std::uint64_t tick) {
+    if (audio_source_) {
+      AudioFrame frame = audio_source_->acquireFrame(480);
+      for (auto &sample : frame.data()) {
+        sample = static_cast<std::int16_t>(noise_(rng_));
+      }
+      if (!audio_source_->pushFrame(std::move(frame))) {
+        ++publish_dropped_;
+      }
+    }
+    // 30 fps on the 10 ms tick: frames on ticks 0, 3, 7 of every 10.
+    const std::uint64_t phase = tick % 10;
+    if (video_source_ && (phase == 0 || phase == 3 || phase == 7)) {
+      if (pending_video_.valid() &&
+          pending_video_.wait_for(0s) == std::future_status::ready &&
+          !pending_video_.get()) {
+        ++publish_dropped_;
+      }
+      VideoFrame frame = video_source_->acquireFrame(VideoBufferType::I420);
+      // Cycle the luma every second; chroma stays neutral.
+      const std::uint64_t seconds = tick / 100;
+      const std::size_t luma = static_cast<std::size_t>(frame.width()) *
+                               static_cast<std::size_t>(frame.height());
+      std::memset(frame.data(), static_cast<int>(40 + (seconds % 4) * 60),
+                  luma);
+      std::memset(frame.data() + luma, 128, frame.dataSize() - luma);
+      const auto timestamp_us = static_cast<std::int64_t>(tick) * 10000;
+      pending_video_ =
+          video_source_->captureFrameAsync(std::move(frame), timestamp_us);
+    }
+  }
+
+  void runControl() {
+    LocalParticipant *local = room_.localParticipant();
+    std::vector<std::uint8_t> payload(
+        static_cast<std::size_t>(args_.data_size), 0x6C);
+    const auto data_interval =
+        std::chrono::nanoseconds(1'000'000'000 / args_.data_rate);
+    const auto rpc_interval =
+        std::chrono::nanoseconds(1'000'000'000 / args_.rpc_rate);
+    auto next_data = Clock::now();
+    auto next_rpc = next_data;
+    while (running_.load(std::memory_order_relaxed)) {
+      const auto now = Clock::now();
+      if (args_.profile.data && now >= next_data) {
+        const std::int64_t sent = nowNs();
+        std::memcpy(payload.data(), &sent, sizeof(sent));
+        try {
+          local->publishData(payload, true, {}, kDataTopic);
+        } catch (const std::exception &) {
+          ++publish_dropped_;
+        }
+        next_data += data_interval;
+      }
+      if (args_.profile.rpc && next_identity_ != identity_ &&
+          now >= next_rpc) {
+        const auto call_started = Clock::now();
+        try {
+          local->performRpc(next_identity_, kRpcMethod, "ping", 5.0);
+          rpc_latency_.add(std::chrono::duration<double, std::milli>(
+                               Clock::now() - call_started)
+                               .count());
+        } catch (const std::exception &) {
+          ++rpc_failures_;
+        }
+        next_rpc += rpc_interval;
+      }
+      auto wake = args_.profile.data ? next_data : next_rpc;
+      if (args_.profile.data && args_.profile.rpc) {
+        wake = std::min(next_data, next_rpc);
+      }
+      std::this_thread::sleep_until(wake);
+    }
+  }
+
+  const std::string identity_;
+  const std::string next_identity_;
+  const Args &args_;
+  Room room_;
+
+  std::shared_ptr<AudioSource> audio_source_;
+  std::shared_ptr<VideoSource> video_source_;
+  std::atomic<bool> running_{false};
+  MediaClock::Pacer media_pacer_;
+  std::thread control_thread_;
+
+  // Media tick state; MediaClock thread only.
+  std::mt19937 rng_{std::hash<std::string>{}(identity_)};
+  std::uniform_int_distribution<int> noise_{-3000, 3000};
+  std::future<bool> pending_video_;
+
+  mutable std::mutex streams_mutex_;
+  std::vector<std::shared_ptr<VideoStream>> video_streams_;
+  std::vector<std::shared_ptr<AudioStream>> audio_streams_;
+
+  std::atomic<std::uint64_t> audio_received_{0};
+  std::atomic<std::uint64_t> video_received_{0};
+  std::atomic<std::uint64_t> publish_dropped_{0};
+  std::atomic<std::uint64_t> rpc_failures_{0};
+  Samples data_latency_;
+  Samples rpc_latency_;
+};
+
+double mib(std::size_t bytes) {
+  return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Args args;
+  if (!parseArgs(argc, argv, args)) {
+    usage();
+    return 2;
+  }
+
+  if (args.sharded) {
+    livekit::initialize(LogSink::kConsole, EventDispatchOptions::manyRooms());
+  } else {
+    livekit::initialize(LogSink::kConsole);
+  }
+  const auto baseline = bench::ProcessUsage::now();
+
+  std::vector<std::unique_ptr<LoadParticipant>> participants;
+  for (int i = 0; i < args.participants; ++i) {
+    participants.push_back(std::make_unique<LoadParticipant>(
+        "loadgen-" + std::to_string(i),
+        "loadgen-" + std::to_string((i + 1) % args.participants), args));
+  }
+
+  std::cout << "Connecting " << args.participants << " participants to "
+            << args.url << " room " << args.room << "\n";
+  std::vector<AsyncOperation<ConnectResult>> connects;
+  for (auto &p : participants) {
+    connects.push_back(p->connect(bench::makeJoinToken(
+        args.api_key, args.api_secret, args.room, p->identity())));
+  }
+  int connected = 0;
+  for (std::size_t i = 0; i < connects.size(); ++i) {
+    const ConnectResult result = connects[i].get();
+    if (result.connected) {
+      ++connected;
+    } else {
+      std::cerr << participants[i]->identity()
+                << " failed to connect: " << result.error << "\n";
+    }
+  }
+  for (auto &p : participants) {
+    try {
+      p->start();
+    } catch (const std::exception &e) {
+      std::cerr << p->identity() << " failed to start: " << e.what() << "\n";
+    }
+  }
+  const auto started = bench::ProcessUsage::now();
+
+  std::this_thread::sleep_for(std::chrono::seconds(args.seconds));
+  const auto finished = bench::ProcessUsage::now();
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "\n"
+            << std::left << std::setw(14) << "participant" << std::right
+            << std::setw(10) << "audio rx" << std::setw(10) << "video rx"
+            << std::setw(9) << "dropped" << std::setw(11) << "data p50"
+            << std::setw(11) << "data p95" << std::setw(10) << "rpc p50"
+            << std::setw(10) << "rpc p95" << std::setw(9) << "rpc err"
+            << "\n";
+  std::uint64_t total_dropped = 0;
+  for (auto &p : participants) {
+    const std::uint64_t dropped = p->droppedFrames();
+    total_dropped += dropped;
+    std::cout << std::left << std::setw(14) << p->identity() << std::right
+              << std::setw(10) << p->audioReceived() << std::setw(10)
+              << p->videoReceived() << std::setw(9) << dropped
+              << std::setw(11) << p->dataLatency().percentile(50)
+              << std::setw(11) << p->dataLatency().percentile(95)
+              << std::setw(10) << p->rpcLatency().percentile(50)
+              << std::setw(10) << p->rpcLatency().percentile(95)
+              << std::setw(9) << p->rpcFailures() << "\n";
+  }
+
+  const double per_participant = connected > 0 ? 1.0 / connected : 0.0;
+  std::cout << "\nConnected      " << connected << "/" << args.participants
+            << "\n";
+  std::cout << "CPU            " << bench::cpuPercent(started, finished)
+            << " % of a core, "
+            << bench::cpuPercent(started, finished) * per_participant
+            << " % per participant\n";
+  std::cout << "RSS            " << mib(finished.rss_bytes) << " MiB, "
+            << (mib(finished.rss_bytes) - mib(baseline.rss_bytes)) *
+                   per_participant
+            << " MiB per participant over the SDK baseline\n";
+  std::cout << "Dropped frames " << total_dropped << "\n";
+  std::cout << "(latencies in ms; data = publishData() to the receiving "
+               "handler)\n";
+
+  for (auto &p : participants) {
+    p->stop();
+  }
+  participants.clear();
+  livekit::shutdown();
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Data stream chunking: the per-chunk work of TextStreamWriter and
+// ByteStreamWriter short of the FFI call itself.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ffi.pb.h"
+#include "livekit/data_stream.h"
+#include "room.pb.h"
+#include "utf8_chunk.h"
+
+namespace {
+
+// arg = payload size in bytes; mixed 1-4 byte code points.
+void BM_Utf8ChunkSplit(benchmark::State &state) {
+  const std::string pattern = "ascii \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 ";
+  std::string text;
+  while (text.size() < static_cast<std::size_t>(state.range(0))) {
+    text += pattern;
+  }
+  for (auto _ : state) {
+    std::size_t chunks = 0;
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+      begin = livekit::detail::utf8ChunkEnd(text.data(), begin, text.size(),
+                                            livekit::kStreamChunkSize);
+      ++chunks;
+    }
+    benchmark::DoNotOptimize(chunks);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_Utf8ChunkSplit)->Arg(64 << 10)->Arg(1 << 20);
+
+// Slicing a byte payload and serializing one send_stream_chunk request per
+// slice, as ByteStreamWriter::write does; arg = payload size in bytes.
+void BM_ByteStreamChunkRequests(benchmark::State &state) {
+  const std::vector<std::uint8_t> payload(
+      static_cast<std::size_t>(state.range(0)), 0x5A);
+  livekit::proto::FfiRequest req;
+  std::string wire;
+  for (auto _ : state) {
+    std::uint64_t index = 0;
+    for (std::size_t offset = 0; offset < payload.size();
+         offset += livekit::kStreamChunkSize) {
+      const std::size_t n =
+          std::min(livekit::kStreamChunkSize, payload.size() - offset);
+      auto *msg = req.mutable_send_stream_chunk();
+      msg->set_local_participant_handle(1);
+      auto *chunk = msg->mutable_chunk();
+      chunk->set_stream_id("bench-stream");
+      chunk->set_chunk_index(index++);
+      chunk->set_content(payload.data() + offset, n);
+      msg->set_request_async_id(index);
+      req.SerializeToString(&wire);
+      benchmark::DoNotOptimize(wire.data());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(payload.size()));
+}
+BENCHMARK(BM_ByteStreamChunkRequests)->Arg(64 << 10)->Arg(1 << 20);
+
+} // namespace
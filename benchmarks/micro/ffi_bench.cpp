@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// FFI request round trips and event dispatch.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ffi.pb.h"
+#include "ffi_client.h"
+#include "livekit/audio_source.h"
+#include "room.pb.h"
+
+namespace {
+
+// One synchronous request (clear_audio_buffer) through serialize, the FFI
+// call and response parsing.
+void BM_FfiSendRequest(benchmark::State &state) {
+  livekit::AudioSource source(48000, 1, 0);
+  for (auto _ : state) {
+    source.clearQueue();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FfiSendRequest);
+
+// Parsing and dispatching one FFI event to N broadcast listeners, as the
+// FFI callback thread does; arg = listener count.
+void BM_FfiEventDispatch(benchmark::State &state) {
+  auto &client = livekit::FfiClient::instance();
+  std::atomic<std::uint64_t> seen{0};
+  std::vector<livekit::FfiClient::ListenerId> ids;
+  for (int i = 0; i < state.range(0); ++i) {
+    ids.push_back(client.AddListener([&seen](const auto &) {
+      seen.fetch_add(1, std::memory_order_relaxed);
+    }));
+  }
+
+  livekit::proto::FfiEvent event;
+  // No room owns this handle, so only the broadcast listeners run.
+  event.mutable_room_event()->set_room_handle(0xBE7C4);
+  event.mutable_room_event()->mutable_reconnecting();
+  std::string bytes;
+  event.SerializeToString(&bytes);
+  const auto *data = reinterpret_cast<const std::uint8_t *>(bytes.data());
+
+  for (auto _ : state) {
+    livekit::LivekitFfiCallback(data, bytes.size());
+  }
+  for (auto id : ids) {
+    client.RemoveListener(id);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["listener_calls"] = static_cast<double>(seen.load());
+}
+BENCHMARK(BM_FfiEventDispatch)->Arg(1)->Arg(8)->Arg(64);
+
+} // namespace
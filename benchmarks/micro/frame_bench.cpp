@@ -0,0 +1,145 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Frame wrapping and pixel conversion.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "audio_frame.pb.h"
+#include "livekit/audio_frame.h"
+#include "livekit/video_frame.h"
+#include "video_frame.pb.h"
+
+namespace {
+
+using livekit::VideoBufferType;
+
+// Handle id 0 is never dropped, so the buffers below stay owned by the
+// benchmark while the SDK treats them like FFI-owned frames.
+livekit::proto::OwnedAudioFrameBuffer
+ownedAudio(std::vector<std::int16_t> &samples, int rate, int channels) {
+  livekit::proto::OwnedAudioFrameBuffer owned;
+  owned.mutable_handle()->set_id(0);
+  auto *info = owned.mutable_info();
+  info->set_data_ptr(reinterpret_cast<std::uint64_t>(samples.data()));
+  info->set_sample_rate(static_cast<std::uint32_t>(rate));
+  info->set_num_channels(static_cast<std::uint32_t>(channels));
+  info->set_samples_per_channel(
+      static_cast<std::uint32_t>(samples.size() / channels));
+  return owned;
+}
+
+livekit::proto::OwnedVideoBuffer ownedI420(std::vector<std::uint8_t> &pixels,
+                                           int width, int height) {
+  livekit::proto::OwnedVideoBuffer owned;
+  owned.mutable_handle()->set_id(0);
+  auto *info = owned.mutable_info();
+  info->set_type(livekit::proto::VideoBufferType::I420);
+  info->set_width(static_cast<std::uint32_t>(width));
+  info->set_height(static_cast<std::uint32_t>(height));
+  const std::uint32_t y_size = static_cast<std::uint32_t>(width * height);
+  const std::uint32_t c_stride = static_cast<std::uint32_t>((width + 1) / 2);
+  const std::uint32_t c_size = c_stride * ((height + 1) / 2);
+  pixels.assign(y_size + 2 * c_size, 0x80);
+  const auto base = reinterpret_cast<std::uint64_t>(pixels.data());
+  info->set_data_ptr(base);
+  const std::uint64_t offsets[] = {0, y_size, y_size + c_size};
+  const std::uint32_t strides[] = {static_cast<std::uint32_t>(width),
+                                   c_stride, c_stride};
+  const std::uint32_t sizes[] = {y_size, c_size, c_size};
+  for (int i = 0; i < 3; ++i) {
+    auto *component = info->add_components();
+    component->set_data_ptr(base + offsets[i]);
+    component->set_stride(strides[i]);
+    component->set_size(sizes[i]);
+  }
+  return owned;
+}
+
+// 10 ms of audio at 48 kHz; arg = channels.
+void BM_AudioFrameFromOwnedInfo(benchmark::State &state) {
+  const int channels = static_cast<int>(state.range(0));
+  std::vector<std::int16_t> samples(480 * channels, 1000);
+  const auto owned = ownedAudio(samples, 48000, channels);
+  for (auto _ : state) {
+    auto frame = livekit::AudioFrame::fromOwnedInfo(owned);
+    benchmark::DoNotOptimize(frame.data().data());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(samples.size() * 2));
+}
+BENCHMARK(BM_AudioFrameFromOwnedInfo)->Arg(1)->Arg(2);
+
+void BM_AudioFrameViewFromOwnedInfo(benchmark::State &state) {
+  const int channels = static_cast<int>(state.range(0));
+  std::vector<std::int16_t> samples(480 * channels, 1000);
+  const auto owned = ownedAudio(samples, 48000, channels);
+  for (auto _ : state) {
+    auto view = livekit::AudioFrameView::fromOwnedInfo(owned);
+    benchmark::DoNotOptimize(view.data());
+  }
+}
+BENCHMARK(BM_AudioFrameViewFromOwnedInfo)->Arg(1)->Arg(2);
+
+// args = width, height.
+void BM_VideoFrameFromOwnedInfo(benchmark::State &state) {
+  std::vector<std::uint8_t> pixels;
+  const auto owned = ownedI420(pixels, static_cast<int>(state.range(0)),
+                               static_cast<int>(state.range(1)));
+  for (auto _ : state) {
+    auto frame = livekit::VideoFrame::fromOwnedInfo(owned);
+    benchmark::DoNotOptimize(frame.data());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(pixels.size()));
+}
+BENCHMARK(BM_VideoFrameFromOwnedInfo)->Args({640, 360})->Args({1280, 720});
+
+// args = source type, destination type (VideoBufferType values), 720p.
+void BM_VideoFrameConvert(benchmark::State &state) {
+  const auto src_type = static_cast<VideoBufferType>(state.range(0));
+  const auto dst_type = static_cast<VideoBufferType>(state.range(1));
+  auto src = livekit::VideoFrame::create(1280, 720, src_type);
+  auto dst = livekit::VideoFrame::create(1280, 720, dst_type);
+  for (auto _ : state) {
+    src.convertInto(dst);
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void ConvertPairs(benchmark::internal::Benchmark *b) {
+  const VideoBufferType pairs[][2] = {
+      {VideoBufferType::I420, VideoBufferType::RGBA},
+      {VideoBufferType::I420, VideoBufferType::BGRA},
+      {VideoBufferType::NV12, VideoBufferType::RGBA},
+      {VideoBufferType::RGBA, VideoBufferType::I420},
+      {VideoBufferType::BGRA, VideoBufferType::I420},
+      {VideoBufferType::RGBA, VideoBufferType::NV12},
+      {VideoBufferType::RGBA, VideoBufferType::BGRA},
+      {VideoBufferType::I420, VideoBufferType::I420},
+  };
+  b->ArgNames({"src", "dst"});
+  for (const auto &pair : pairs) {
+    b->Args({static_cast<int>(pair[0]), static_cast<int>(pair[1])});
+  }
+}
+BENCHMARK(BM_VideoFrameConvert)->Apply(ConvertPairs);
+
+} // namespace
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// livekit_benchmarks: Google Benchmark suite for SDK hot paths.
+//
+// Everything runs in-process; no server is needed. Pass the usual Google
+// Benchmark flags, e.g. --benchmark_format=json or
+// --benchmark_out=bench.json --benchmark_out_format=json to keep results
+// for comparing SDK releases (tools/compare.py in the benchmark repo).
+
+#include <benchmark/benchmark.h>
+
+#include "livekit/livekit.h"
+
+int main(int argc, char **argv) {
+  // Callback logging keeps the FFI from interleaving output with results.
+  livekit::initialize(livekit::LogSink::kCallback);
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    livekit::shutdown();
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  livekit::shutdown();
+  return 0;
+}
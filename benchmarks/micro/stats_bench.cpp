@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Converting getStats() results from proto to the public stats types.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "livekit/stats.h"
+#include "stats.pb.h"
+
+namespace {
+
+// A report shaped like one subscriber transport: per-track inbound RTP,
+// codecs and candidate pairs; arg = inbound streams.
+std::vector<livekit::proto::RtcStats> makeReport(int streams) {
+  std::vector<livekit::proto::RtcStats> report;
+  for (int i = 0; i < streams; ++i) {
+    livekit::proto::RtcStats inbound;
+    auto *in = inbound.mutable_inbound_rtp();
+    in->mutable_rtc()->set_id("IT01V" + std::to_string(i));
+    in->mutable_rtc()->set_timestamp(1700000000000 + i);
+    in->mutable_stream()->set_ssrc(1000 + i);
+    in->mutable_stream()->set_kind("video");
+    in->mutable_received()->set_packets_received(123456);
+    in->mutable_received()->set_jitter(0.004);
+    auto *detail = in->mutable_inbound();
+    detail->set_track_identifier("TR_" + std::to_string(i));
+    detail->set_mid(std::to_string(i));
+    detail->set_frames_decoded(9000);
+    detail->set_frame_width(1280);
+    detail->set_frame_height(720);
+    detail->set_frames_per_second(30);
+    detail->set_bytes_received(50000000);
+    report.push_back(std::move(inbound));
+
+    livekit::proto::RtcStats codec;
+    codec.mutable_codec()->mutable_rtc()->set_id("CIT01_" +
+                                                 std::to_string(i));
+    codec.mutable_codec()->mutable_codec()->set_mime_type("video/VP8");
+    codec.mutable_codec()->mutable_codec()->set_clock_rate(90000);
+    report.push_back(std::move(codec));
+  }
+  for (int i = 0; i < 4; ++i) {
+    livekit::proto::RtcStats pair;
+    pair.mutable_candidate_pair()->mutable_rtc()->set_id(
+        "CP" + std::to_string(i));
+    pair.mutable_candidate_pair()->mutable_candidate_pair()->set_nominated(
+        i == 0);
+    report.push_back(std::move(pair));
+  }
+  return report;
+}
+
+void BM_StatsFromProto(benchmark::State &state) {
+  const auto report = makeReport(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    auto stats = livekit::fromProto(report);
+    benchmark::DoNotOptimize(stats.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(report.size()));
+}
+BENCHMARK(BM_StatsFromProto)->Arg(4)->Arg(32);
+
+} // namespace
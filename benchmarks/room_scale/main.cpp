@@ -0,0 +1,220 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Connects many rooms from one process and reports connect latency, CPU and
+// RSS per room. Intended to run against a local `livekit-server --dev`:
+//
+//   livekit_room_scale_bench --url ws://localhost:7880 --rooms 1000
+//
+// Each room gets its own token, minted from --api-key/--api-secret (default
+// the dev server's devkey/secret).
+
+#include <livekit/livekit.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "access_token.h"
+#include "process_usage.h"
+
+using namespace livekit;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Args {
+  std::string url = "ws://localhost:7880";
+  std::string api_key = "devkey";
+  std::string api_secret = "secret";
+  int rooms = 1000;
+  int concurrency = 50;
+  int hold_seconds = 10;
+  bool sharded = true;
+};
+
+void usage() {
+  std::cout << "Usage: livekit_room_scale_bench [--url URL] [--rooms N]\n"
+               "         [--concurrency N] [--hold SECONDS]\n"
+               "         [--api-key KEY] [--api-secret SECRET] [--inline]\n"
+               "\n"
+               "  --concurrency  connects in flight at once (default 50)\n"
+               "  --hold         seconds to stay connected while idle CPU is\n"
+               "                 measured (default 10)\n"
+               "  --inline       dispatch events on the FFI thread instead of\n"
+               "                 EventDispatchOptions::manyRooms()\n";
+}
+
+bool parseArgs(int argc, char **argv, Args &args) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    auto value = [&]() -> const char * {
+      return i + 1 < argc ? argv[++i] : nullptr;
+    };
+    const char *v = nullptr;
+    if (a == "--inline") {
+      args.sharded = false;
+      continue;
+    }
+    if (a == "--help" || a == "-h" || !(v = value())) {
+      return false;
+    }
+    if (a == "--url") {
+      args.url = v;
+    } else if (a == "--rooms") {
+      args.rooms = std::max(1, std::atoi(v));
+    } else if (a == "--concurrency") {
+      args.concurrency = std::max(1, std::atoi(v));
+    } else if (a == "--hold") {
+      args.hold_seconds = std::max(0, std::atoi(v));
+    } else if (a == "--api-key") {
+      args.api_key = v;
+    } else if (a == "--api-secret") {
+      args.api_secret = v;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  const auto i = static_cast<std::size_t>(p / 100.0 * (values.size() - 1));
+  return values[i];
+}
+
+double ms(std::chrono::microseconds us) { return us.count() / 1000.0; }
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Args args;
+  if (!parseArgs(argc, argv, args)) {
+    usage();
+    return 2;
+  }
+
+  const auto before_init = bench::ProcessUsage::now();
+  if (args.sharded) {
+    livekit::initialize(LogSink::kConsole, EventDispatchOptions::manyRooms());
+  } else {
+    livekit::initialize(LogSink::kConsole);
+  }
+  const auto baseline = bench::ProcessUsage::now();
+
+  std::cout << "Connecting " << args.rooms << " rooms to " << args.url
+            << " (" << args.concurrency << " in flight, "
+            << (args.sharded ? "sharded" : "inline") << " dispatch)\n";
+
+  std::vector<std::unique_ptr<Room>> rooms;
+  rooms.reserve(static_cast<std::size_t>(args.rooms));
+  std::deque<AsyncOperation<ConnectResult>> in_flight;
+  std::vector<ConnectResult> results;
+  results.reserve(static_cast<std::size_t>(args.rooms));
+
+  RoomOptions options;
+  options.auto_subscribe = false; // idle rooms; don't pull media
+  auto drainOne = [&] {
+    results.push_back(in_flight.front().get());
+    in_flight.pop_front();
+  };
+  for (int i = 0; i < args.rooms; ++i) {
+    const std::string name = "bench-" + std::to_string(i);
+    const std::string token =
+        bench::makeJoinToken(args.api_key, args.api_secret, name, name);
+    rooms.push_back(std::make_unique<Room>());
+    in_flight.push_back(rooms.back()->connectAsync(args.url, token, options));
+    if (static_cast<int>(in_flight.size()) >= args.concurrency) {
+      drainOne();
+    }
+  }
+  while (!in_flight.empty()) {
+    drainOne();
+  }
+  const auto connected_usage = bench::ProcessUsage::now();
+
+  std::vector<double> join_ms;
+  std::vector<double> total_ms;
+  std::vector<double> setup_ms;
+  int connected = 0;
+  std::string first_error;
+  for (const auto &r : results) {
+    if (!r.connected) {
+      if (first_error.empty()) {
+        first_error = r.error;
+      }
+      continue;
+    }
+    ++connected;
+    total_ms.push_back(ms(r.timing.total));
+    join_ms.push_back(ms(r.timing.join));
+    setup_ms.push_back(ms(r.timing.setup));
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(args.hold_seconds));
+  const auto held_usage = bench::ProcessUsage::now();
+
+  const double per_room = connected > 0 ? 1.0 / connected : 0.0;
+  const double connect_wall_s =
+      std::chrono::duration<double>(connected_usage.when - baseline.when)
+          .count();
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "\nConnected " << connected << "/" << args.rooms << " rooms in "
+            << connect_wall_s << " s\n";
+  if (!first_error.empty()) {
+    std::cout << "First failure: " << first_error << "\n";
+  }
+  std::cout << "Connect total  p50 " << percentile(total_ms, 50) << " ms, p95 "
+            << percentile(total_ms, 95) << " ms, max "
+            << percentile(total_ms, 100) << " ms\n";
+  std::cout << "  join         p50 " << percentile(join_ms, 50) << " ms, p95 "
+            << percentile(join_ms, 95) << " ms\n";
+  std::cout << "  SDK setup    p50 " << percentile(setup_ms, 50)
+            << " ms, p95 " << percentile(setup_ms, 95) << " ms\n";
+  std::cout << "SDK init RSS   "
+            << (static_cast<double>(baseline.rss_bytes) -
+                static_cast<double>(before_init.rss_bytes)) /
+                   1024.0
+            << " KiB\n";
+  if (connected > 0) {
+    std::cout << "RSS per room   "
+              << (static_cast<double>(held_usage.rss_bytes) -
+                  static_cast<double>(baseline.rss_bytes)) /
+                     1024.0 * per_room
+              << " KiB\n";
+    std::cout << "CPU per room   "
+              << ms(connected_usage.cpu - baseline.cpu) * per_room
+              << " ms to connect, "
+              << bench::cpuPercent(connected_usage, held_usage) * per_room
+              << " % of a core while idle\n";
+  }
+
+  rooms.clear();
+  livekit::shutdown();
+  return connected == args.rooms ? 0 : 1;
+}
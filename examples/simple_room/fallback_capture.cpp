@@ -22,10 +22,10 @@
 #include <chrono>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <thread>
 
 #include "livekit/livekit.h"
-#include "wav_audio_source.h"
 
 using namespace livekit;
 
@@ -37,15 +37,24 @@ void runNoiseCaptureLoop(const std::shared_ptr<AudioSource> &source,
   const int frame_ms = 10;
   const int samples_per_channel = sample_rate * frame_ms / 1000;
 
-  // FIX: variable name should not shadow the type
-  WavAudioSource wavSource("data/welcome.wav", 48000, 1, false);
+  // Streamed from a memory mapping; frames are pulled with readFrame() so
+  // this loop keeps control of pacing and of running_flag.
+  std::unique_ptr<FileAudioSource> file;
+  try {
+    file = std::make_unique<FileAudioSource>("data/welcome.wav", source);
+  } catch (const std::exception &e) {
+    std::cerr << "Failed to open data/welcome.wav (if this file exists in "
+                 "the repo, ensure Git LFS is installed and run `git lfs "
+                 "pull`): "
+              << e.what() << std::endl;
+    return;
+  }
 
-  using Clock = std::chrono::steady_clock;
-  auto next_deadline = Clock::now();
+  FramePacer pacer{std::chrono::milliseconds(frame_ms)};
   while (running_flag.load(std::memory_order_relaxed)) {
     AudioFrame frame =
         AudioFrame::create(sample_rate, num_channels, samples_per_channel);
-    wavSource.fillFrame(frame);
+    file->readFrame(frame);
     try {
       source->captureFrame(frame);
     } catch (const std::exception &e) {
@@ -53,9 +62,7 @@ void runNoiseCaptureLoop(const std::shared_ptr<AudioSource> &source,
       break;
     }
 
-    // Pace the loop to roughly real-time
-    next_deadline += std::chrono::milliseconds(frame_ms);
-    std::this_thread::sleep_until(next_deadline);
+    pacer.wait();
   }
 
   try {
@@ -69,7 +76,7 @@ void runNoiseCaptureLoop(const std::shared_ptr<AudioSource> &source,
 void runFakeVideoCaptureLoop(const std::shared_ptr<VideoSource> &source,
                              std::atomic<bool> &running_flag) {
   auto frame = VideoFrame::create(1280, 720, VideoBufferType::BGRA);
-  const double framerate = 1.0 / 30.0;
+  FramePacer pacer(MediaClock::framePeriod(30), /*skip_missed=*/true);
 
   while (running_flag.load(std::memory_order_relaxed)) {
     static auto start = std::chrono::high_resolution_clock::now();
@@ -116,6 +123,6 @@ void runFakeVideoCaptureLoop(const std::shared_ptr<VideoSource> &source,
       break;
     }
 
-    std::this_thread::sleep_for(std::chrono::duration<double>(framerate));
+    pacer.wait();
   }
 }
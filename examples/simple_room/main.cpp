@@ -200,8 +200,12 @@ public:
 
     // If this is a VIDEO track, create a VideoStream and attach to renderer
     if (ev.track && ev.track->kind() == TrackKind::KIND_VIDEO) {
+      // The renderer uploads I420 planes as they are; latest_only with
+      // zero_copy means frames it skips are never copied either.
       VideoStream::Options opts;
-      opts.format = livekit::VideoBufferType::RGBA;
+      opts.format = livekit::VideoBufferType::I420;
+      opts.latest_only = true;
+      opts.zero_copy = true;
       auto video_stream = VideoStream::fromTrack(ev.track, opts);
       if (!video_stream) {
         std::cerr << "Failed to create VideoStream for track " << track_sid
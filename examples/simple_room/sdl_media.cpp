@@ -39,13 +39,14 @@ bool SDLMicSource::init() {
   spec_.channels = static_cast<Uint8>(channels_);
   spec_.freq = sample_rate_;
 
+  buffer_.assign(static_cast<std::size_t>(frame_samples_) * channels_, 0);
+
   // Open default recording device as an audio stream
   // This works for both playback and recording, depending on the device id.
+  // SDL calls onStreamData() whenever it has put recorded data in the stream.
   stream_ = SDL_OpenAudioDeviceStream(
       SDL_AUDIO_DEVICE_DEFAULT_RECORDING, // recording device
-      &spec_,
-      nullptr, // no callback, we'll poll
-      nullptr);
+      &spec_, &SDLMicSource::onStreamData, this);
 
   if (!stream_) {
     std::cerr << "Failed to open recording stream: " << SDL_GetError() << "\n";
@@ -61,32 +62,31 @@ bool SDLMicSource::init() {
   return true;
 }
 
-void SDLMicSource::pump() {
-  if (!stream_ || !callback_)
+void SDLCALL SDLMicSource::onStreamData(void *userdata,
+                                        SDL_AudioStream *stream,
+                                        int /*additional_amount*/,
+                                        int /*total_amount*/) {
+  auto *self = static_cast<SDLMicSource *>(userdata);
+  if (!self->callback_)
     return;
 
-  const int samples_per_frame_total = frame_samples_ * channels_;
-  const int bytes_per_frame = samples_per_frame_total * sizeof(int16_t);
-
-  // Only pull if at least one "frame" worth of audio is available
-  const int available = SDL_GetAudioStreamAvailable(stream_); // bytes
-  if (available < bytes_per_frame) {
-    return;
-  }
+  const int bytes_per_frame =
+      static_cast<int>(self->buffer_.size() * sizeof(int16_t));
 
-  std::vector<int16_t> buffer(samples_per_frame_total);
+  // Deliver whole frames only; a partial one waits for the next call.
+  while (SDL_GetAudioStreamAvailable(stream) >= bytes_per_frame) {
+    const int got_bytes =
+        SDL_GetAudioStreamData(stream, self->buffer_.data(), bytes_per_frame);
+    if (got_bytes <= 0) {
+      return; // nothing or error (log if you like)
+    }
 
-  const int got_bytes = SDL_GetAudioStreamData(stream_, buffer.data(),
-                                               bytes_per_frame); //
+    const int got_samples_total = got_bytes / sizeof(int16_t);
+    const int got_samples_per_channel = got_samples_total / self->channels_;
 
-  if (got_bytes <= 0) {
-    return; // nothing or error (log if you like)
+    self->callback_(self->buffer_.data(), got_samples_per_channel,
+                    self->sample_rate_, self->channels_);
   }
-
-  const int got_samples_total = got_bytes / sizeof(int16_t);
-  const int got_samples_per_channel = got_samples_total / channels_;
-
-  callback_(buffer.data(), got_samples_per_channel, sample_rate_, channels_);
 }
 
 void SDLMicSource::pause() {
@@ -24,9 +24,9 @@
 // -------------------------
 // SDLMicSource
 // -------------------------
-// Periodically call pump() from your main loop or a capture thread.
-// It will pull 10ms frames from the mic (by default) and pass them to the
-// AudioCallback.
+// init() opens the default mic with an SDL stream callback: as SDL records,
+// each 10ms frame (by default) is passed to the AudioCallback on SDL's audio
+// thread, so no thread has to poll for data.
 class SDLMicSource {
 public:
   using AudioCallback = std::function<void(
@@ -41,21 +41,23 @@ public:
   // Initialize SDL audio stream for recording
   bool init();
 
-  // Call regularly to pull mic data and send to callback.
-  void pump();
-
   void pause();
   void resume();
 
   bool isValid() const { return stream_ != nullptr; }
 
 private:
+  // SDL_AudioStreamCallback; hands every whole frame available to callback_.
+  static void SDLCALL onStreamData(void *userdata, SDL_AudioStream *stream,
+                                   int additional_amount, int total_amount);
+
   SDL_AudioStream *stream_ = nullptr;
   SDL_AudioSpec spec_{};
   int sample_rate_;
   int channels_;
   int frame_samples_;
   AudioCallback callback_;
+  std::vector<int16_t> buffer_; // one frame, only touched by onStreamData
 };
 
 // -------------------------
@@ -85,49 +85,45 @@ bool SDLMediaManager::startMic(
   // We have at least one mic; use SDL
   mic_using_sdl_ = true;
 
+  // The adapter copies each buffer and captures it from its own thread, so
+  // SDL's audio callback never waits for the FFI.
+  AudioCaptureAdapter::Options capture;
+  capture.sample_rate = mic_source_->sample_rate();
+  capture.num_channels = mic_source_->num_channels();
+  mic_capture_ = std::make_unique<AudioCaptureAdapter>(mic_source_, capture);
+
   mic_sdl_ = std::make_unique<SDLMicSource>(
       mic_source_->sample_rate(), mic_source_->num_channels(),
       mic_source_->sample_rate() / 100, // ~10ms
-      [src = mic_source_](const int16_t *samples, int num_samples_per_channel,
-                          int sample_rate, int num_channels) {
-        AudioFrame frame = AudioFrame::create(sample_rate, num_channels,
-                                              num_samples_per_channel);
-        std::memcpy(frame.data().data(), samples,
-                    num_samples_per_channel * num_channels * sizeof(int16_t));
-        try {
-          src->captureFrame(frame);
-        } catch (const std::exception &e) {
-          std::cerr << "Error in captureFrame (SDL mic): " << e.what()
-                    << std::endl;
-        }
+      [capture = mic_capture_.get()](const int16_t *samples,
+                                     int num_samples_per_channel,
+                                     int /*sample_rate*/,
+                                     int /*num_channels*/) {
+        capture->push(samples, num_samples_per_channel);
       });
 
   if (!mic_sdl_->init()) {
     std::cerr << "Failed to init SDL mic, falling back to noise loop.\n";
     mic_using_sdl_ = false;
     mic_sdl_.reset();
+    mic_capture_.reset();
     mic_thread_ =
         std::thread(runNoiseCaptureLoop, mic_source_, std::ref(mic_running_));
     return true;
   }
 
-  mic_thread_ = std::thread(&SDLMediaManager::micLoopSDL, this);
+  // SDL now delivers recorded frames from its own audio thread.
   return true;
 }
 
-void SDLMediaManager::micLoopSDL() {
-  while (mic_running_.load(std::memory_order_relaxed)) {
-    mic_sdl_->pump();
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
-  }
-}
-
 void SDLMediaManager::stopMic() {
   mic_running_.store(false, std::memory_order_relaxed);
   if (mic_thread_.joinable()) {
     mic_thread_.join();
   }
+  // Destroying the SDL stream stops its callback before the adapter goes.
   mic_sdl_.reset();
+  mic_capture_.reset();
   mic_source_.reset();
 }
 
@@ -145,6 +141,23 @@ bool SDLMediaManager::startCamera(
   cam_source_ = video_source;
   cam_running_.store(true, std::memory_order_relaxed);
 
+#if defined(__linux__)
+  // Prefer V4L2: it streams the camera's buffers without SDL's conversion
+  // and copy, and waits on the device instead of polling.
+  try {
+    V4L2VideoSource::Options options;
+    options.width = video_source->width();
+    options.height = video_source->height();
+    cam_v4l2_ = std::make_unique<V4L2VideoSource>(cam_source_, options);
+    cam_v4l2_->start();
+    return true;
+  } catch (const std::exception &e) {
+    std::cerr << "V4L2 camera unavailable (" << e.what()
+              << "), trying SDL.\n";
+    cam_v4l2_.reset();
+  }
+#endif
+
   // Try SDL
   if (!ensureSDLInit(SDL_INIT_CAMERA)) {
     std::cerr << "No SDL camera subsystem, using fake video loop.\n";
@@ -217,6 +230,7 @@ void SDLMediaManager::stopCamera() {
   if (cam_thread_.joinable()) {
     cam_thread_.join();
   }
+  cam_v4l2_.reset();
   can_sdl_.reset();
   cam_source_.reset();
 }
@@ -258,8 +272,9 @@ bool SDLMediaManager::startSpeaker(
 
 void SDLMediaManager::speakerLoopSDL() {
   SDL_AudioStream *localStream = nullptr;
-  SDL_AudioDeviceID dev = 0;
 
+  // This thread only moves decoded frames into the playout buffer; the SDL
+  // device pulls from it in speakerCallback() at its own pace.
   while (speaker_running_.load(std::memory_order_relaxed)) {
     if (!speaker_stream_) {
       break;
@@ -272,23 +287,26 @@ void SDLMediaManager::speakerLoopSDL() {
     }
 
     const livekit::AudioFrame &frame = ev.frame;
-    const auto &data = frame.data();
-    if (data.empty()) {
+    if (frame.data().empty()) {
       continue;
     }
 
-    // Lazily open SDL audio stream based on the first frame's format, so no
-    // resampler is needed.
+    // Lazily open the device in the first frame's format, so no resampler is
+    // needed.
     if (!localStream) {
+      AudioPlayoutBuffer::Options options;
+      options.sample_rate = frame.sample_rate();
+      options.num_channels = frame.num_channels();
+      speaker_playout_ = std::make_unique<AudioPlayoutBuffer>(options);
+
       SDL_AudioSpec want{};
       want.format = SDL_AUDIO_S16;
       want.channels = static_cast<Uint8>(frame.num_channels());
       want.freq = frame.sample_rate();
 
-      localStream =
-          SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &want,
-                                    /*callback=*/nullptr,
-                                    /*userdata=*/nullptr);
+      localStream = SDL_OpenAudioDeviceStream(
+          SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &want,
+          &SDLMediaManager::speakerCallback, this);
 
       if (!localStream) {
         std::cerr << "speakerLoopSDL: SDL_OpenAudioDeviceStream failed: "
@@ -298,35 +316,18 @@ void SDLMediaManager::speakerLoopSDL() {
 
       sdl_audio_stream_ = localStream; // store if you want to inspect later
 
-      dev = SDL_GetAudioStreamDevice(localStream);
-      if (dev == 0) {
-        std::cerr << "speakerLoopSDL: SDL_GetAudioStreamDevice failed: "
-                  << SDL_GetError() << "\n";
-        break;
-      }
-
-      if (!SDL_ResumeAudioDevice(dev)) {
-        std::cerr << "speakerLoopSDL: SDL_ResumeAudioDevice failed: "
+      if (!SDL_ResumeAudioStreamDevice(localStream)) {
+        std::cerr << "speakerLoopSDL: SDL_ResumeAudioStreamDevice failed: "
                   << SDL_GetError() << "\n";
         break;
       }
     }
 
-    // Push PCM to SDL. We assume frames are already S16, interleaved, matching
-    // sample_rate / channels we used above.
-    const int numBytes = static_cast<int>(data.size() * sizeof(std::int16_t));
-
-    if (!SDL_PutAudioStreamData(localStream, data.data(), numBytes)) {
-      std::cerr << "speakerLoopSDL: SDL_PutAudioStreamData failed: "
-                << SDL_GetError() << "\n";
-      break;
-    }
-
-    // Tiny sleep to avoid busy loop; SDL buffers internally.
-    SDL_Delay(2);
+    speaker_playout_->push(frame);
   }
 
   if (localStream) {
+    // Stops the callback before the playout buffer goes away.
     SDL_DestroyAudioStream(localStream);
     localStream = nullptr;
     sdl_audio_stream_ = nullptr;
@@ -335,6 +336,27 @@ void SDLMediaManager::speakerLoopSDL() {
   speaker_running_.store(false, std::memory_order_relaxed);
 }
 
+void SDLCALL SDLMediaManager::speakerCallback(void *userdata,
+                                              SDL_AudioStream *stream,
+                                              int additional_amount,
+                                              int /*total_amount*/) {
+  auto *self = static_cast<SDLMediaManager *>(userdata);
+  const int channels = self->speaker_playout_->num_channels();
+  const int frames =
+      additional_amount / static_cast<int>(channels * sizeof(std::int16_t));
+  if (frames <= 0) {
+    return;
+  }
+  auto &scratch = self->speaker_scratch_;
+  const auto samples = static_cast<std::size_t>(frames) * channels;
+  if (scratch.size() < samples) {
+    scratch.resize(samples); // grows during the first few callbacks only
+  }
+  self->speaker_playout_->fill(scratch.data(), frames);
+  SDL_PutAudioStreamData(stream, scratch.data(),
+                         static_cast<int>(samples * sizeof(std::int16_t)));
+}
+
 void SDLMediaManager::stopSpeaker() {
   speaker_running_.store(false, std::memory_order_relaxed);
   if (speaker_thread_.joinable()) {
@@ -344,6 +366,7 @@ void SDLMediaManager::stopSpeaker() {
     SDL_DestroyAudioStream(sdl_audio_stream_);
     sdl_audio_stream_ = nullptr;
   }
+  speaker_playout_.reset();
   speaker_stream_.reset();
 }
 
@@ -17,8 +17,10 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_audio.h>
@@ -27,7 +29,10 @@
 #include "wav_audio_source.h"
 
 namespace livekit {
+class AudioCaptureAdapter;
+class AudioPlayoutBuffer;
 class AudioSource;
+class V4L2VideoSource;
 class VideoSource;
 class AudioStream;
 class VideoStream;
@@ -71,7 +76,6 @@ private:
   bool ensureSDLInit(Uint32 flags);
 
   // ---- Mic helpers ----
-  void micLoopSDL();
   void micLoopNoise();
 
   // ---- Camera helpers ----
@@ -80,10 +84,13 @@ private:
 
   // ---- Speaker helpers (TODO: wire AudioStream -> SDL audio) ----
   void speakerLoopSDL();
+  static void SDLCALL speakerCallback(void *userdata, SDL_AudioStream *stream,
+                                      int additional_amount, int total_amount);
 
   // Mic
   std::shared_ptr<livekit::AudioSource> mic_source_;
   std::unique_ptr<SDLMicSource> mic_sdl_;
+  std::unique_ptr<livekit::AudioCaptureAdapter> mic_capture_;
   std::thread mic_thread_;
   std::atomic<bool> mic_running_{false};
   bool mic_using_sdl_ = false;
@@ -91,6 +98,7 @@ private:
   // Camera
   std::shared_ptr<livekit::VideoSource> cam_source_;
   std::unique_ptr<SDLCamSource> can_sdl_;
+  std::unique_ptr<livekit::V4L2VideoSource> cam_v4l2_;
   std::thread cam_thread_;
   std::atomic<bool> cam_running_{false};
   bool cam_using_sdl_ = false;
@@ -100,6 +108,8 @@ private:
   std::thread speaker_thread_;
   std::atomic<bool> speaker_running_{false};
   SDL_AudioStream *sdl_audio_stream_ = nullptr;
+  std::unique_ptr<livekit::AudioPlayoutBuffer> speaker_playout_;
+  std::vector<std::int16_t> speaker_scratch_; // callback thread only
 
   // Renderer (remote video) – left mostly as a placeholder
   std::unique_ptr<SDLVideoRenderer> sdl_renderer_;
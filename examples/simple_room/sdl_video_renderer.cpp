@@ -45,15 +45,96 @@ bool SDLVideoRenderer::init(const char *title, int width, int height) {
     return false;
   }
 
-  // Note, web will send out BGRA as default, and we can't use ARGB since ffi
-  // does not support converting from BGRA to ARGB.
-  texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888,
-                               SDL_TEXTUREACCESS_STREAMING, width_, height_);
+  // Most remote video decodes to I420, so start with a matching texture.
+  return ensureTexture(SDL_PIXELFORMAT_IYUV, width_, height_);
+}
+
+bool SDLVideoRenderer::ensureTexture(SDL_PixelFormat format, int width,
+                                     int height) {
+  if (texture_ && format == texture_format_ && width == width_ &&
+      height == height_) {
+    return true;
+  }
+  if (texture_) {
+    SDL_DestroyTexture(texture_);
+    texture_ = nullptr;
+  }
+  width_ = width;
+  height_ = height;
+  texture_format_ = format;
+  texture_ = SDL_CreateTexture(renderer_, format, SDL_TEXTUREACCESS_STREAMING,
+                               width_, height_);
   if (!texture_) {
-    std::cerr << "SDL_CreateTexture failed: " << SDL_GetError() << "\n";
+    std::cerr << "SDLVideoRenderer: SDL_CreateTexture failed: "
+              << SDL_GetError() << "\n";
+    return false;
+  }
+  return true;
+}
+
+bool SDLVideoRenderer::uploadYuv(const livekit::VideoFrame &frame) {
+  const bool nv12 = frame.type() == livekit::VideoBufferType::NV12;
+  if (!ensureTexture(nv12 ? SDL_PIXELFORMAT_NV12 : SDL_PIXELFORMAT_IYUV,
+                     frame.width(), frame.height())) {
+    return false;
+  }
+  // planeInfos() carries the strides of native (zero-copy) frames too.
+  const auto planes = frame.planeInfos();
+  auto plane = [&](std::size_t i) {
+    return reinterpret_cast<const Uint8 *>(planes[i].data_ptr);
+  };
+  auto pitch = [&](std::size_t i) {
+    return static_cast<int>(planes[i].stride);
+  };
+  bool ok = false;
+  if (nv12 && planes.size() >= 2) {
+    ok = SDL_UpdateNVTexture(texture_, nullptr, plane(0), pitch(0), plane(1),
+                             pitch(1));
+  } else if (!nv12 && planes.size() >= 3) {
+    ok = SDL_UpdateYUVTexture(texture_, nullptr, plane(0), pitch(0), plane(1),
+                              pitch(1), plane(2), pitch(2));
+  }
+  if (!ok) {
+    std::cerr << "SDLVideoRenderer: YUV texture update failed: "
+              << SDL_GetError() << "\n";
+  }
+  return ok;
+}
+
+bool SDLVideoRenderer::uploadRgba(livekit::VideoFrame &frame) {
+  // Fallback for streams opened with an RGB format.
+  if (frame.type() != livekit::VideoBufferType::RGBA) {
+    try {
+      frame = frame.convert(livekit::VideoBufferType::RGBA, false);
+    } catch (const std::exception &ex) {
+      std::cerr << "SDLVideoRenderer: convert to RGBA failed: " << ex.what()
+                << "\n";
+      return false;
+    }
+  }
+  // Note, SDL_PIXELFORMAT_RGBA8888 is not compatible with Livekit RGBA
+  // format.
+  if (!ensureTexture(SDL_PIXELFORMAT_RGBA32, frame.width(), frame.height())) {
     return false;
   }
 
+  void *pixels = nullptr;
+  int pitch = 0;
+  if (!SDL_LockTexture(texture_, nullptr, &pixels, &pitch)) {
+    std::cerr << "SDLVideoRenderer: SDL_LockTexture failed: " << SDL_GetError()
+              << "\n";
+    return false;
+  }
+
+  const std::uint8_t *src = frame.data();
+  const int srcPitch = frame.width() * 4; // RGBA: 4 bytes per pixel
+
+  for (int y = 0; y < frame.height(); ++y) {
+    std::memcpy(static_cast<std::uint8_t *>(pixels) + y * pitch,
+                src + y * srcPitch, srcPitch);
+  }
+
+  SDL_UnlockTexture(texture_);
   return true;
 }
 
@@ -61,6 +142,7 @@ void SDLVideoRenderer::shutdown() {
   if (texture_) {
     SDL_DestroyTexture(texture_);
     texture_ = nullptr;
+    texture_format_ = SDL_PIXELFORMAT_UNKNOWN;
   }
   if (renderer_) {
     SDL_DestroyRenderer(renderer_);
@@ -107,69 +189,26 @@ void SDLVideoRenderer::render() {
   }
   last_render_time_ = now;
 
-  // 3) Read a frame from VideoStream (blocking until one is available)
+  // 3) Take the newest frame, if one arrived since the last tick. The stream
+  //    is opened with latest_only, so at most one frame is waiting and a
+  //    slow tick never leaves a backlog.
   livekit::VideoFrameEvent vfe;
-  bool gotFrame = stream_->read(vfe);
-  if (!gotFrame) {
-    // EOS / closed – nothing more to render
+  if (!stream_->tryRead(vfe)) {
     return;
   }
 
   livekit::VideoFrame &frame = vfe.frame;
 
-  // 4) Ensure the frame is RGBA.
-  //    Ideally you requested RGBA from VideoStream::Options so this is a no-op.
-  if (frame.type() != livekit::VideoBufferType::RGBA) {
-    try {
-      frame = frame.convert(livekit::VideoBufferType::RGBA, false);
-    } catch (const std::exception &ex) {
-      std::cerr << "SDLVideoRenderer: convert to RGBA failed: " << ex.what()
-                << "\n";
-      return;
-    }
-  }
-
-  // Handle size change: recreate texture if needed
-  if (frame.width() != width_ || frame.height() != height_) {
-    width_ = frame.width();
-    height_ = frame.height();
-
-    if (texture_) {
-      SDL_DestroyTexture(texture_);
-      texture_ = nullptr;
-    }
-    texture_ = SDL_CreateTexture(
-        renderer_,
-        SDL_PIXELFORMAT_RGBA32, // Note, SDL_PIXELFORMAT_RGBA8888 is not
-                                // compatible with Livekit RGBA format.
-        SDL_TEXTUREACCESS_STREAMING, width_, height_);
-    if (!texture_) {
-      std::cerr << "SDLVideoRenderer: SDL_CreateTexture failed: "
-                << SDL_GetError() << "\n";
-      return;
-    }
-  }
-
-  // 6) Upload RGBA data to SDL texture
-  void *pixels = nullptr;
-  int pitch = 0;
-  if (!SDL_LockTexture(texture_, nullptr, &pixels, &pitch)) {
-    std::cerr << "SDLVideoRenderer: SDL_LockTexture failed: " << SDL_GetError()
-              << "\n";
+  // 4) Upload. I420/NV12 planes go to the GPU as they are (the texture is
+  //    converted to RGB while drawing), so there is no per-frame conversion
+  //    or allocation on the CPU.
+  const bool yuv = frame.type() == livekit::VideoBufferType::I420 ||
+                   frame.type() == livekit::VideoBufferType::NV12;
+  if (!(yuv ? uploadYuv(frame) : uploadRgba(frame))) {
     return;
   }
 
-  const std::uint8_t *src = frame.data();
-  const int srcPitch = frame.width() * 4; // RGBA: 4 bytes per pixel
-
-  for (int y = 0; y < frame.height(); ++y) {
-    std::memcpy(static_cast<std::uint8_t *>(pixels) + y * pitch,
-                src + y * srcPitch, srcPitch);
-  }
-
-  SDL_UnlockTexture(texture_);
-
-  // 7) Present
+  // 5) Present
   SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
   SDL_RenderClear(renderer_);
   SDL_RenderTexture(renderer_, texture_, nullptr, nullptr);
@@ -18,10 +18,12 @@
 
 #include <SDL3/SDL.h>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <thread>
 
 namespace livekit {
+class VideoFrame;
 class VideoStream;
 }
 
@@ -42,9 +44,17 @@ public:
   void shutdown(); // destroy window/renderer/texture
 
 private:
+  // (Re)creates texture_ if the frame size or pixel format changed.
+  bool ensureTexture(SDL_PixelFormat format, int width, int height);
+  // Upload paths: YUV planes go straight into an IYUV/NV12 texture; other
+  // formats are converted to RGBA first.
+  bool uploadYuv(const livekit::VideoFrame &frame);
+  bool uploadRgba(livekit::VideoFrame &frame);
+
   SDL_Window *window_ = nullptr;
   SDL_Renderer *renderer_ = nullptr;
   SDL_Texture *texture_ = nullptr;
+  SDL_PixelFormat texture_format_ = SDL_PIXELFORMAT_UNKNOWN;
 
   std::shared_ptr<livekit::VideoStream> stream_;
   int width_ = 0;
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "livekit/audio_frame.h"
+#include "livekit/audio_processing_module.h"
+
+namespace livekit {
+
+namespace detail {
+class ApmWorkers;
+struct ApmStreamState;
+} // namespace detail
+
+/**
+ * @brief Counters for one ApmStream, see ApmStream::stats().
+ *
+ * Latency is measured from pushCapture() to the end of processing, just
+ * before the frame is handed to the stream's callback.
+ */
+struct ApmStreamStats {
+  /// Capture frames processed and delivered.
+  std::uint64_t processed_frames = 0;
+  /// Render (far-end) frames fed to the echo canceller.
+  std::uint64_t render_frames = 0;
+  /// Frames rejected by pushCapture()/pushRender() because the queue was full.
+  std::uint64_t dropped_frames = 0;
+  /// Batches the APM reported an error for; their frames are not delivered.
+  std::uint64_t errors = 0;
+  /// Frames waiting in the queues right now.
+  std::size_t queued_frames = 0;
+  std::chrono::microseconds last_latency{0};
+  std::chrono::microseconds mean_latency{0};
+  std::chrono::microseconds max_latency{0};
+};
+
+/**
+ * @brief One audio stream processed by an ApmEngine.
+ *
+ * Owns its own AudioProcessingModule. Frames are queued without taking a
+ * lock and processed in order on the engine's workers, one worker at a time
+ * per stream. Within each batch, render frames are fed to the APM before
+ * capture frames.
+ *
+ * pushCapture() and pushRender() may be called from different threads, but
+ * each one from a single thread at a time. Destroying the stream discards
+ * queued frames and waits for a batch that is being processed; it must not
+ * be destroyed from its own callback.
+ */
+class ApmStream {
+public:
+  /// Receives each processed capture frame on an engine worker thread. The
+  /// frame may be moved from. Must not block.
+  using ProcessedCallback = std::function<void(AudioFrame &frame)>;
+
+  ~ApmStream();
+
+  ApmStream(const ApmStream &) = delete;
+  ApmStream &operator=(const ApmStream &) = delete;
+
+  /**
+   * @brief Queue a near-end (microphone) frame for processing.
+   *
+   * @return false if the queue is full or the engine is gone; the frame is
+   *         dropped.
+   * @throws std::invalid_argument unless the frame holds exactly 10ms.
+   */
+  bool pushCapture(AudioFrame &&frame);
+
+  /**
+   * @brief Queue a far-end (speaker) frame as the echo reference.
+   *
+   * @return false if the queue is full or the engine is gone.
+   * @throws std::invalid_argument unless the frame holds exactly 10ms.
+   */
+  bool pushRender(AudioFrame &&frame);
+
+  /// See AudioProcessingModule::setStreamDelayMs(). Applied by the worker
+  /// before the next batch.
+  void setStreamDelayMs(int delay_ms);
+
+  ApmStreamStats stats() const;
+
+private:
+  friend class ApmEngine;
+
+  explicit ApmStream(std::shared_ptr<detail::ApmStreamState> state);
+
+  std::shared_ptr<detail::ApmStreamState> state_;
+};
+
+/**
+ * @brief Processes many ApmStreams on a fixed pool of worker threads.
+ *
+ * Driving one AudioProcessingModule per call from the call's own thread
+ * costs a thread and 100 synchronous FFI round trips per second per call.
+ * The engine instead queues frames per stream and lets a small pool drain
+ * whichever streams have work, processing up to Options::max_batch_frames
+ * frames per stream in one batch before moving on to the next stream.
+ *
+ * @code
+ * ApmEngine engine;
+ * ApmEngine::StreamOptions opts;
+ * opts.apm.echo_cancellation = true;
+ * opts.apm.noise_suppression = true;
+ * opts.on_processed = [source](AudioFrame &f) {
+ *   source->pushFrame(std::move(f));
+ * };
+ * auto call = engine.addStream(opts);
+ * call->pushRender(std::move(speaker_10ms));
+ * call->pushCapture(std::move(mic_10ms));
+ * @endcode
+ */
+class ApmEngine {
+public:
+  struct Options {
+    /// Worker threads; 0 uses one per hardware thread.
+    std::size_t threads = 0;
+    /// Per stream and direction; further frames are rejected.
+    std::size_t max_queued_frames = 20;
+    /// Most frames per direction a worker takes from one stream at a time.
+    std::size_t max_batch_frames = 10;
+  };
+
+  struct StreamOptions {
+    AudioProcessingModule::Options apm;
+    ApmStream::ProcessedCallback on_processed;
+  };
+
+  ApmEngine();
+  explicit ApmEngine(const Options &options);
+
+  /// Stops the workers. Streams that outlive the engine reject new frames.
+  ~ApmEngine();
+
+  ApmEngine(const ApmEngine &) = delete;
+  ApmEngine &operator=(const ApmEngine &) = delete;
+
+  /**
+   * @brief Create a stream with its own AudioProcessingModule.
+   *
+   * @throws std::runtime_error if the APM could not be created.
+   */
+  std::unique_ptr<ApmStream> addStream(StreamOptions options);
+
+  std::size_t threadCount() const noexcept;
+
+  /// Streams created by this engine and not yet destroyed.
+  std::size_t streamCount() const noexcept;
+
+private:
+  // Shared with the streams, which may outlive the engine.
+  std::shared_ptr<detail::ApmWorkers> workers_;
+};
+
+} // namespace livekit
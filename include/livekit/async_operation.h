@@ -0,0 +1,144 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L &&      \
+    defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define LIVEKIT_HAS_COROUTINES 1
+#endif
+#endif
+#ifndef LIVEKIT_HAS_COROUTINES
+#define LIVEKIT_HAS_COROUTINES 0
+#endif
+
+namespace livekit {
+
+namespace detail {
+
+/**
+ * Arrange for `resume(ctx)` to be called on the FFI event thread once the
+ * request identified by `async_id` completes or is cancelled.
+ *
+ * Returns false, without registering anything, if the request is no longer
+ * pending; in that case its result is already (or about to be) available
+ * and the caller should continue inline.
+ */
+bool setAsyncContinuation(std::uint64_t async_id, void (*resume)(void *),
+                          void *ctx);
+
+} // namespace detail
+
+/**
+ * Handle to an in-flight FFI request.
+ *
+ * Wraps the std::future produced by the request and adds a completion hook,
+ * so callers can react to the result without parking a thread in get().
+ *
+ * In C++17 use onComplete() or the future-style accessors. When compiled as
+ * C++20 (LIVEKIT_HAS_COROUTINES == 1) the operation is also directly
+ * awaitable:
+ *
+ *   std::string reply = co_await participant->performRpcAsync(id, "m", "p");
+ *
+ * The awaiting coroutine is resumed on the FFI event thread, so it should
+ * not block there; hop to another executor for long-running work.
+ *
+ * An operation has a single consumer: call get() or co_await it once.
+ */
+template <typename T> class AsyncOperation {
+public:
+  AsyncOperation() = default;
+  AsyncOperation(std::future<T> future, std::uint64_t async_id)
+      : future_(std::move(future)), async_id_(async_id) {}
+
+  AsyncOperation(AsyncOperation &&) noexcept = default;
+  AsyncOperation &operator=(AsyncOperation &&) noexcept = default;
+  AsyncOperation(const AsyncOperation &) = delete;
+  AsyncOperation &operator=(const AsyncOperation &) = delete;
+
+  /// False for a default-constructed or already consumed operation.
+  bool valid() const noexcept { return future_.valid(); }
+
+  /// True once the result (value or exception) is available.
+  bool ready() const {
+    return future_.wait_for(std::chrono::seconds(0)) ==
+           std::future_status::ready;
+  }
+
+  /// Block until complete.
+  void wait() const { future_.wait(); }
+
+  template <class Rep, class Period>
+  std::future_status
+  waitFor(const std::chrono::duration<Rep, Period> &timeout) const {
+    return future_.wait_for(timeout);
+  }
+
+  /// Block until complete and return the result, rethrowing any error.
+  T get() { return future_.get(); }
+
+  /// Release the underlying future.
+  std::future<T> takeFuture() { return std::move(future_); }
+
+  /**
+   * Invoke `callback` once the operation completes: on the FFI event thread,
+   * or immediately on the calling thread if it has already completed. The
+   * callback typically calls get(), which will not block.
+   *
+   * Register at most one callback per operation.
+   */
+  void onComplete(std::function<void()> callback) {
+    auto *heap = new std::function<void()>(std::move(callback));
+    auto run = [](void *ctx) {
+      auto *fn = static_cast<std::function<void()> *>(ctx);
+      (*fn)();
+      delete fn;
+    };
+    if (!detail::setAsyncContinuation(async_id_, run, heap)) {
+      run(heap);
+    }
+  }
+
+#if LIVEKIT_HAS_COROUTINES
+  bool await_ready() const { return ready(); }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    return detail::setAsyncContinuation(
+        async_id_,
+        [](void *address) {
+          std::coroutine_handle<>::from_address(address).resume();
+        },
+        handle.address());
+  }
+
+  T await_resume() { return future_.get(); }
+#endif
+
+private:
+  std::future<T> future_;
+  std::uint64_t async_id_ = 0;
+};
+
+} // namespace livekit
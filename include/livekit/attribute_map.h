@@ -0,0 +1,165 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+
+/**
+ * Participant attributes as a flat map: one contiguous vector of key/value
+ * pairs kept sorted by key.
+ *
+ * Attribute sets are small and read far more often than they are rebuilt, so
+ * a sorted vector beats a node-based map on both memory and lookup cost. That
+ * matters when a room holds hundreds of participants whose attributes change
+ * many times a second. Iteration yields `std::pair<std::string, std::string>`
+ * in key order.
+ */
+class AttributeMap {
+public:
+  using value_type = std::pair<std::string, std::string>;
+  using container_type = std::vector<value_type>;
+  using const_iterator = container_type::const_iterator;
+  using iterator = const_iterator;
+  using size_type = std::size_t;
+
+  AttributeMap() = default;
+
+  AttributeMap(std::initializer_list<value_type> init) {
+    entries_.reserve(init.size());
+    for (const auto &kv : init) {
+      set(kv.first, kv.second);
+    }
+  }
+
+  /**
+   * Take ownership of unsorted entries. Keys are expected to be unique; for
+   * duplicates the first entry wins.
+   */
+  explicit AttributeMap(container_type entries) : entries_(std::move(entries)) {
+    std::stable_sort(entries_.begin(), entries_.end(),
+                     [](const value_type &a, const value_type &b) {
+                       return a.first < b.first;
+                     });
+    entries_.erase(std::unique(entries_.begin(), entries_.end(),
+                               [](const value_type &a, const value_type &b) {
+                                 return a.first == b.first;
+                               }),
+                   entries_.end());
+  }
+
+  /** Implicit so existing `std::unordered_map` callers keep compiling. */
+  AttributeMap(const std::unordered_map<std::string, std::string> &map)
+      : AttributeMap(container_type(map.begin(), map.end())) {}
+
+  /** Copy into a node-based map, for code that still wants one. */
+  std::unordered_map<std::string, std::string> toUnorderedMap() const {
+    return std::unordered_map<std::string, std::string>(entries_.begin(),
+                                                        entries_.end());
+  }
+
+  /**
+   * Implicit copy into the map type Participant::attributes() used to
+   * return, so `const std::unordered_map<...> &a = p.attributes();` and
+   * functions taking that map keep compiling.
+   */
+  operator std::unordered_map<std::string, std::string>() const {
+    return toUnorderedMap();
+  }
+
+  const_iterator begin() const noexcept { return entries_.begin(); }
+  const_iterator end() const noexcept { return entries_.end(); }
+  size_type size() const noexcept { return entries_.size(); }
+  bool empty() const noexcept { return entries_.empty(); }
+  void reserve(size_type n) { entries_.reserve(n); }
+  void clear() noexcept { entries_.clear(); }
+
+  const_iterator find(const std::string &key) const {
+    auto it = lowerBound(key);
+    return it != entries_.end() && it->first == key ? it : entries_.end();
+  }
+  size_type count(const std::string &key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+  bool contains(const std::string &key) const { return find(key) != end(); }
+
+  /** @throws std::out_of_range if @p key is not present. */
+  const std::string &at(const std::string &key) const {
+    auto it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("AttributeMap::at: no such key: " + key);
+    }
+    return it->second;
+  }
+
+  /**
+   * Insert or overwrite @p key.
+   * @return true if the stored value changed.
+   */
+  bool set(const std::string &key, std::string value) {
+    auto it = lowerBound(key);
+    if (it != entries_.end() && it->first == key) {
+      if (it->second == value) {
+        return false;
+      }
+      it->second = std::move(value);
+      return true;
+    }
+    entries_.emplace(it, key, std::move(value));
+    return true;
+  }
+
+  /** @return true if @p key was present. */
+  bool erase(const std::string &key) {
+    auto it = lowerBound(key);
+    if (it == entries_.end() || it->first != key) {
+      return false;
+    }
+    entries_.erase(it);
+    return true;
+  }
+
+  friend bool operator==(const AttributeMap &a, const AttributeMap &b) {
+    return a.entries_ == b.entries_;
+  }
+  friend bool operator!=(const AttributeMap &a, const AttributeMap &b) {
+    return !(a == b);
+  }
+
+private:
+  static bool keyLess(const value_type &kv, const std::string &key) {
+    return kv.first < key;
+  }
+  container_type::iterator lowerBound(const std::string &key) {
+    return std::lower_bound(entries_.begin(), entries_.end(), key, keyLess);
+  }
+  const_iterator lowerBound(const std::string &key) const {
+    return std::lower_bound(entries_.begin(), entries_.end(), key, keyLess);
+  }
+
+  container_type entries_;
+};
+
+} // namespace livekit
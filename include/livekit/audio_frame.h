@@ -16,10 +16,14 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "ffi_handle.h"
+
 namespace livekit {
 
 namespace proto {
@@ -27,6 +31,12 @@ class AudioFrameBufferInfo;
 class OwnedAudioFrameBuffer;
 } // namespace proto
 
+namespace detail {
+template <typename T> class FrameBufferPool;
+} // namespace detail
+
+class AudioFramePool;
+
 /**
  * @brief Represents a raw PCM audio frame with interleaved int16 samples.
  *
@@ -50,7 +60,13 @@ public:
   AudioFrame(std::vector<std::int16_t> data, int sample_rate, int num_channels,
              int samples_per_channel);
   AudioFrame(); // Default constructor
-  virtual ~AudioFrame() = default;
+  virtual ~AudioFrame();
+
+  AudioFrame(const AudioFrame &) = default;
+  AudioFrame &operator=(const AudioFrame &) = default;
+  AudioFrame(AudioFrame &&) noexcept = default;
+  // Hands the current buffer back to its pool (if any) before taking over.
+  AudioFrame &operator=(AudioFrame &&other) noexcept;
 
   /**
    * Create a new zero-initialized AudioFrame instance.
@@ -83,6 +99,15 @@ public:
   /// Duration in seconds (samples_per_channel / sample_rate).
   double duration() const noexcept;
 
+  /**
+   * Return a copy of this frame with `num_channels` channels.
+   *
+   * Downmixing to mono averages all channels; upmixing from mono duplicates
+   * the single channel. Other layouts map output channel c to input channel
+   * c % num_channels(). Throws std::invalid_argument if num_channels <= 0.
+   */
+  AudioFrame remix(int num_channels) const;
+
   /// A human-readable description.
   std::string to_string() const;
 
@@ -91,12 +116,158 @@ protected:
   // Used internally by AudioSource.
   proto::AudioFrameBufferInfo toProto() const;
   friend class AudioSource;
+  friend class AudioFramePool;
 
 private:
   std::vector<std::int16_t> data_;
   int sample_rate_;
   int num_channels_;
   int samples_per_channel_;
+
+  // Set for frames acquired from an AudioFramePool; data_ is handed back to
+  // the pool on destruction.
+  std::weak_ptr<detail::FrameBufferPool<std::int16_t>> pool_;
+};
+
+/// Sample layout of a FloatAudioFrame.
+enum class AudioSampleLayout {
+  kInterleaved, ///< Frame by frame: c0 c1 c0 c1 ...
+  kPlanar,      ///< Channel by channel: all of c0, then all of c1, ...
+};
+
+/**
+ * @brief PCM audio frame with float32 samples, interleaved or planar.
+ *
+ * Samples are normalized to [-1, 1) of full scale. The FFI exchanges
+ * interleaved int16 only, so AudioSource and AudioStream convert a
+ * FloatAudioFrame exactly once, with SIMD, at the SDK boundary; fromFrame()
+ * and toFrame() use the same kernels. Conversion to int16 rounds to nearest
+ * and saturates.
+ */
+class FloatAudioFrame {
+public:
+  /**
+   * Throws std::invalid_argument unless data.size() equals
+   * num_channels * samples_per_channel.
+   */
+  FloatAudioFrame(std::vector<float> data, int sample_rate, int num_channels,
+                  int samples_per_channel,
+                  AudioSampleLayout layout = AudioSampleLayout::kInterleaved);
+  FloatAudioFrame();
+
+  /// Create a zero-initialized frame.
+  static FloatAudioFrame
+  create(int sample_rate, int num_channels, int samples_per_channel,
+         AudioSampleLayout layout = AudioSampleLayout::kInterleaved);
+
+  /// Convert an int16 frame.
+  static FloatAudioFrame
+  fromFrame(const AudioFrame &frame,
+            AudioSampleLayout layout = AudioSampleLayout::kInterleaved);
+
+  const std::vector<float> &data() const noexcept { return data_; }
+  std::vector<float> &data() noexcept { return data_; }
+
+  AudioSampleLayout layout() const noexcept { return layout_; }
+  std::size_t total_samples() const noexcept { return data_.size(); }
+  int sample_rate() const noexcept { return sample_rate_; }
+  int num_channels() const noexcept { return num_channels_; }
+  int samples_per_channel() const noexcept { return samples_per_channel_; }
+
+  /// Duration in seconds (samples_per_channel / sample_rate).
+  double duration() const noexcept;
+
+  /**
+   * Samples of channel `c` (samples_per_channel() of them). Planar frames
+   * only; throws std::invalid_argument for interleaved frames or if `c` is
+   * out of range.
+   */
+  float *channel(int c);
+  const float *channel(int c) const;
+
+  /// Convert to an interleaved int16 frame.
+  AudioFrame toFrame() const;
+
+  /// As toFrame(), with storage from `pool`.
+  AudioFrame toFrame(AudioFramePool &pool) const;
+
+  /// A human-readable description.
+  std::string to_string() const;
+
+private:
+  std::vector<float> data_;
+  int sample_rate_;
+  int num_channels_;
+  int samples_per_channel_;
+  AudioSampleLayout layout_;
+};
+
+/**
+ * @brief Zero-copy view over a Rust-owned OwnedAudioFrameBuffer.
+ *
+ * The view keeps the native buffer alive through its FfiHandle and exposes
+ * the interleaved int16 samples in place, so no allocation or memcpy happens
+ * when a frame is received. The native buffer is dropped when the view is
+ * destroyed or release() is called; data() must not be used afterwards.
+ *
+ * Use toFrame() to obtain an owning AudioFrame copy when the samples need to
+ * outlive the view.
+ */
+class AudioFrameView {
+public:
+  AudioFrameView() = default;
+  ~AudioFrameView() = default;
+
+  AudioFrameView(const AudioFrameView &) = delete;
+  AudioFrameView &operator=(const AudioFrameView &) = delete;
+  AudioFrameView(AudioFrameView &&other) noexcept;
+  AudioFrameView &operator=(AudioFrameView &&other) noexcept;
+
+  /**
+   * Wrap an OwnedAudioFrameBuffer without copying. Takes ownership of the
+   * buffer handle.
+   */
+  static AudioFrameView
+  fromOwnedInfo(const proto::OwnedAudioFrameBuffer &owned);
+
+  /// Pointer to the first interleaved sample (nullptr if empty/released).
+  const std::int16_t *data() const noexcept { return data_; }
+
+  /// Number of samples in the buffer (per all channels).
+  std::size_t total_samples() const noexcept {
+    return static_cast<std::size_t>(num_channels_) *
+           static_cast<std::size_t>(samples_per_channel_);
+  }
+
+  int sample_rate() const noexcept { return sample_rate_; }
+  int num_channels() const noexcept { return num_channels_; }
+  int samples_per_channel() const noexcept { return samples_per_channel_; }
+
+  /// Duration in seconds (samples_per_channel / sample_rate).
+  double duration() const noexcept;
+
+  /// True while the view still references a native buffer.
+  bool valid() const noexcept { return handle_.valid(); }
+
+  /// Copy the samples into an owning AudioFrame.
+  AudioFrame toFrame() const;
+
+  /// Copy the samples into a frame whose storage comes from `pool`.
+  AudioFrame toFrame(AudioFramePool &pool) const;
+
+  /// Convert the samples straight into a float frame.
+  FloatAudioFrame toFloatFrame(
+      AudioSampleLayout layout = AudioSampleLayout::kInterleaved) const;
+
+  /// Drop the native buffer now rather than at destruction.
+  void release() noexcept;
+
+private:
+  FfiHandle handle_;
+  const std::int16_t *data_{nullptr};
+  int sample_rate_{0};
+  int num_channels_{0};
+  int samples_per_channel_{0};
 };
 
 } // namespace livekit
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "audio_frame.h"
+#include "frame_pool.h"
+
+namespace livekit {
+
+class AudioStream;
+
+/**
+ * Mixes many PCM inputs into a single AudioFrame per tick.
+ *
+ * Inputs are either AudioStreams, which the mixer drains without blocking on
+ * every tick, or manual inputs fed through pushFrame(). Each input keeps a
+ * small FIFO of samples so frames of any size line up on tick boundaries; an
+ * input that has nothing (or not enough) for a tick contributes silence for
+ * the missing part. Samples are summed with saturating int16 arithmetic.
+ *
+ * All inputs must already match the mixer's sample rate and channel count;
+ * frames in any other format are dropped.
+ *
+ * Typical usage (one thread for the whole room):
+ *
+ *   AudioMixer mixer;
+ *   for (auto &stream : streams) mixer.addStream(stream);
+ *   while (recording) {
+ *     AudioFrame mixed = mixer.mix();
+ *     sink.write(mixed);
+ *     sleep_until(next_tick += 10ms);
+ *   }
+ */
+class AudioMixer {
+public:
+  struct Options {
+    int sample_rate{48000};
+    int num_channels{1};
+
+    /// Duration of each mixed frame.
+    int frame_duration_ms{10};
+
+    /// Upper bound on samples buffered per input. Older samples are dropped
+    /// so an input that delivers in bursts cannot drift behind the others.
+    int max_buffered_ms{200};
+  };
+
+  using InputId = std::uint64_t;
+
+  AudioMixer();
+  explicit AudioMixer(const Options &options);
+  ~AudioMixer();
+
+  AudioMixer(const AudioMixer &) = delete;
+  AudioMixer &operator=(const AudioMixer &) = delete;
+
+  /// Add a stream to mix. It is removed automatically once it has ended and
+  /// its buffered samples have been mixed. The stream must not be read by
+  /// anyone else.
+  InputId addStream(std::shared_ptr<AudioStream> stream);
+
+  /// Add an input fed manually with pushFrame().
+  InputId addInput();
+
+  /// Queue samples for a manual input. Unknown ids are ignored.
+  void pushFrame(InputId id, const AudioFrame &frame);
+
+  void removeInput(InputId id);
+
+  std::size_t inputCount() const;
+
+  /// Produce the next mixed frame (samplesPerChannel() samples per channel).
+  /// Never blocks; the caller is responsible for pacing ticks.
+  AudioFrame mix();
+
+  int samplesPerChannel() const noexcept { return samples_per_channel_; }
+
+  /// Number of input frames dropped because of a format mismatch.
+  std::uint64_t droppedFrames() const;
+
+private:
+  struct Input {
+    std::shared_ptr<AudioStream> stream;
+    std::vector<std::int16_t> pending; // interleaved
+  };
+
+  void appendLocked(Input &input, const std::int16_t *data,
+                    std::size_t samples);
+  bool acceptsFormat(int sample_rate, int num_channels) const noexcept;
+
+  Options options_;
+  int samples_per_channel_{0};
+  std::size_t max_buffered_samples_{0};
+
+  mutable std::mutex mutex_;
+  std::map<InputId, Input> inputs_;
+  InputId next_id_{1};
+  std::uint64_t dropped_frames_{0};
+
+  AudioFramePool pool_;
+};
+
+} // namespace livekit
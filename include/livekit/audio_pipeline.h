@@ -0,0 +1,167 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include "audio_frame.h"
+#include "audio_mixer.h"
+#include "audio_processing_module.h"
+#include "audio_stream.h"
+
+namespace livekit {
+
+class AudioSource;
+
+/**
+ * Echo-cancelling audio path between remote playout and local capture.
+ *
+ * AudioPipeline owns an AudioProcessingModule and wires both sides of it:
+ *
+ *  - Far end: remote AudioStreams (or manual inputs) are mixed, and each
+ *    10ms mix is fed to the APM as the reverse stream at the moment the
+ *    audio device pulls it with renderPlayout().
+ *  - Near end: captureFrame() runs microphone audio of any length through
+ *    the APM in 10ms chunks and hands the processed audio to the
+ *    AudioSource.
+ *
+ * The stream delay required by AEC is measured from the render and capture
+ * timestamps instead of being configured by hand, and pushed to the APM
+ * whenever it moves.
+ *
+ * @code
+ * auto pipeline = std::make_shared<AudioPipeline>(source);
+ * pipeline->addRemoteStream(AudioStream::fromTrack(
+ *     remote_track, pipeline->remoteStreamOptions()));
+ *
+ * // speaker callback, every 10ms
+ * AudioFrame out = pipeline->renderPlayout(expected_render_time);
+ * // microphone callback
+ * pipeline->captureFrame(mic_frame, capture_time);
+ * @endcode
+ *
+ * renderPlayout() and captureFrame() may run on different threads, but
+ * each must be called from one thread at a time.
+ */
+class AudioPipeline {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Options {
+    /// Processing features. AEC is enabled by default.
+    AudioProcessingModule::Options apm = defaultApmOptions();
+
+    int sample_rate{48000};
+    int num_channels{1};
+
+    /// Device output latency assumed when renderPlayout() is not given an
+    /// explicit render time.
+    int render_latency_ms{0};
+
+    /// Device input latency assumed when captureFrame() is not given an
+    /// explicit capture time.
+    int capture_latency_ms{0};
+
+    /// Far-end jitter allowance per remote input.
+    int max_buffered_ms{200};
+
+    static AudioProcessingModule::Options defaultApmOptions() {
+      AudioProcessingModule::Options o;
+      o.echo_cancellation = true;
+      return o;
+    }
+  };
+
+  /// `source` receives the processed capture audio and must use the
+  /// pipeline's sample rate and channel count.
+  /// @throws std::invalid_argument on a null source or mismatched format.
+  explicit AudioPipeline(std::shared_ptr<AudioSource> source);
+  AudioPipeline(std::shared_ptr<AudioSource> source, const Options &options);
+  ~AudioPipeline();
+
+  AudioPipeline(const AudioPipeline &) = delete;
+  AudioPipeline &operator=(const AudioPipeline &) = delete;
+
+  // -------------------------------------------------------------------------
+  // Far end
+  // -------------------------------------------------------------------------
+
+  /// AudioStream options that deliver frames in the pipeline's format.
+  AudioStream::Options remoteStreamOptions() const;
+
+  /// Mix `stream` into the playout. The stream must not be read elsewhere.
+  AudioMixer::InputId addRemoteStream(std::shared_ptr<AudioStream> stream);
+
+  /// Add a far-end input fed with pushPlayout().
+  AudioMixer::InputId addPlayoutInput();
+  void pushPlayout(AudioMixer::InputId id, const AudioFrame &frame);
+
+  void removePlayoutInput(AudioMixer::InputId id);
+
+  /**
+   * Produce the next 10ms of playout and register it as the APM reverse
+   * stream. Call from the audio device's render callback.
+   *
+   * @param render_time When the first sample will reach the speaker. If
+   *                    default-constructed, now + render_latency_ms.
+   */
+  AudioFrame renderPlayout(Clock::time_point render_time = {});
+
+  // -------------------------------------------------------------------------
+  // Near end
+  // -------------------------------------------------------------------------
+
+  /**
+   * Echo-cancel microphone audio and capture it into the AudioSource.
+   * Input may be any length; whole 10ms chunks are forwarded immediately and
+   * the remainder is carried over to the next call.
+   *
+   * @param capture_time When the first sample was captured by the device. If
+   *                     default-constructed, now - capture_latency_ms.
+   * @throws std::invalid_argument if the frame format does not match.
+   */
+  void captureFrame(const AudioFrame &frame,
+                    Clock::time_point capture_time = {});
+
+  /// Delay last pushed to the APM via setStreamDelayMs().
+  int streamDelayMs() const noexcept {
+    return applied_delay_ms_.load(std::memory_order_relaxed);
+  }
+
+  AudioProcessingModule &apm() noexcept { return apm_; }
+
+private:
+  void updateDelayLocked(double capture_delay_ms);
+
+  Options options_;
+  std::shared_ptr<AudioSource> source_;
+  AudioProcessingModule apm_;
+  AudioMixer mixer_;
+
+  std::mutex capture_mutex_;
+  AudioProcessingStream capture_stream_;
+  double smoothed_delay_ms_{-1.0};
+
+  // Written by the render thread, read by the capture thread.
+  std::atomic<double> render_delay_ms_{0.0};
+  std::atomic<int> applied_delay_ms_{-1};
+};
+
+} // namespace livekit
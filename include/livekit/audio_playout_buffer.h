@@ -0,0 +1,252 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audio_frame.h"
+#include "audio_stream.h"
+#include "frame_pool.h"
+
+namespace livekit {
+
+class AudioResampler;
+class AudioSource;
+
+/**
+ * Adaptive jitter buffer between an AudioStream and a pull-model playback
+ * device.
+ *
+ * Frames are pushed as they arrive, typically from AudioStream's push mode
+ * (Options::on_frame = buffer.sink()), and the device's audio callback pulls
+ * exactly what it needs with fill(). fill() never blocks, locks or
+ * allocates, so it can be called straight from a real-time callback such as
+ * SDL's or CoreAudio's; one thread pushes and one thread fills.
+ *
+ * The playout delay follows the measured arrival jitter between
+ * min_delay_ms and max_delay_ms. When the buffer runs dry the device gets
+ * the last 10 ms played again, fading out, and playback restarts with a
+ * short fade-in once the target delay has built up again. Sender and device
+ * clocks never run at exactly the same rate, so a buffer that stays away
+ * from the target speeds playout up or slows it down by at most
+ * max_rate_adjust (resampled, not skipped) until it is back.
+ *
+ * Frames in another channel layout (mono vs. multi-channel) are remixed and
+ * other sample rates are resampled on push.
+ *
+ * @code
+ * AudioPlayoutBuffer playout({48000, 2});
+ * AudioStream::Options options;
+ * options.on_frame = playout.sink();
+ * auto stream = AudioStream::fromTrack(track, options);
+ * // in the device callback:
+ * playout.fill(device_buffer, frames);
+ * @endcode
+ */
+class AudioPlayoutBuffer {
+public:
+  struct Options {
+    /// Device format; fill() writes interleaved samples in this format.
+    int sample_rate{48000};
+    int num_channels{1};
+    /// Bounds of the adaptive playout delay.
+    int min_delay_ms{20};
+    int max_delay_ms{200};
+    /// Audio arriving while this much is buffered is dropped.
+    int capacity_ms{1000};
+    /// Largest playout speed change used for drift correction (0.01 = 1%).
+    double max_rate_adjust{0.01};
+  };
+
+  struct Stats {
+    /// Frames (samples per channel) currently buffered.
+    std::size_t buffered_frames = 0;
+    int target_delay_ms = 0;
+    double jitter_ms = 0.0;
+    std::uint64_t frames_pushed = 0;
+    /// Arrived frames that did not fit the capacity.
+    std::uint64_t frames_dropped = 0;
+    std::uint64_t frames_played = 0;
+    /// Frames synthesized while the buffer was empty or refilling.
+    std::uint64_t frames_concealed = 0;
+    std::uint64_t underruns = 0;
+    /// Device frames produced while playing faster or slower than real
+    /// time.
+    std::uint64_t frames_sped_up = 0;
+    std::uint64_t frames_slowed_down = 0;
+  };
+
+  AudioPlayoutBuffer();
+  /// Throws std::invalid_argument on a non-positive format or delay bounds
+  /// that do not fit the capacity.
+  explicit AudioPlayoutBuffer(const Options &options);
+  ~AudioPlayoutBuffer();
+
+  AudioPlayoutBuffer(const AudioPlayoutBuffer &) = delete;
+  AudioPlayoutBuffer &operator=(const AudioPlayoutBuffer &) = delete;
+
+  /// Producer side. Frames with more than one channel going to a device
+  /// with a different multi-channel count are dropped.
+  void push(const AudioFrame &frame);
+  void push(const AudioFrameView &frame);
+  void push(const std::int16_t *interleaved, int samples_per_channel,
+            int sample_rate, int num_channels);
+
+  /// Callback for AudioStream::Options::on_frame. The buffer must outlive
+  /// the stream.
+  std::function<void(AudioFrameViewEvent &&)> sink();
+
+  /// Consumer side: write exactly `frames` interleaved frames to `out`.
+  /// Real-time safe.
+  void fill(std::int16_t *out, int frames) noexcept;
+
+  int sample_rate() const noexcept { return options_.sample_rate; }
+  int num_channels() const noexcept { return options_.num_channels; }
+
+  Stats stats() const noexcept;
+
+private:
+  std::size_t available() const noexcept;
+  void write(const std::int16_t *interleaved, std::size_t frames);
+  void noteArrival(std::size_t frames);
+  // Play `frames` output frames, advancing `step` input frames for each.
+  void play(std::int16_t *out, std::size_t frames, double step) noexcept;
+  void conceal(std::int16_t *out, std::size_t frames) noexcept;
+
+  const Options options_;
+  const std::size_t channels_;
+
+  // Sample ring, single producer and single consumer. Positions are in
+  // samples and only ever grow; capacity is a power of two.
+  std::vector<std::int16_t> ring_;
+  std::size_t mask_ = 0;
+  std::size_t capacity_samples_ = 0;
+  std::atomic<std::size_t> write_pos_{0};
+  std::atomic<std::size_t> read_pos_{0};
+
+  // Producer state.
+  std::unique_ptr<AudioResampler> resampler_;
+  std::vector<std::int16_t> remixed_;
+  std::chrono::steady_clock::time_point last_arrival_{};
+  std::size_t last_frames_ = 0;
+  double jitter_ms_ = 0.0;
+  std::atomic<double> jitter_out_{0.0};
+  std::atomic<std::size_t> target_frames_{0};
+  std::size_t min_target_ = 0;
+  std::size_t max_target_ = 0;
+
+  // Consumer state.
+  bool playing_ = false;
+  bool started_ = false;
+  int drift_ = 0;               // -1 slowing down, +1 speeding up
+  double phase_ = 0.0;          // fractional input position carried over
+  std::vector<float> history_;  // last kConcealMs of played audio
+  std::size_t history_pos_ = 0; // next frame to overwrite
+  std::size_t conceal_pos_ = 0;
+  float conceal_gain_ = 0.0f;
+  std::size_t fade_in_left_ = 0;
+
+  std::atomic<std::uint64_t> pushed_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> played_{0};
+  std::atomic<std::uint64_t> concealed_{0};
+  std::atomic<std::uint64_t> underruns_{0};
+  std::atomic<std::uint64_t> sped_up_{0};
+  std::atomic<std::uint64_t> slowed_down_{0};
+};
+
+/**
+ * Push-model capture counterpart of AudioPlayoutBuffer, feeding an
+ * AudioSource from a device capture callback.
+ *
+ * push() copies the device's samples into a lock-free ring and returns; a
+ * worker thread cuts them into frame_duration_ms frames and captures them
+ * into the source (or hands them to a FrameSink). The worker sleeps until a
+ * whole frame is buffered, so nothing polls.
+ */
+class AudioCaptureAdapter {
+public:
+  struct Options {
+    /// Format of the samples passed to push().
+    int sample_rate{48000};
+    int num_channels{1};
+    int frame_duration_ms{10};
+    /// Samples pushed while this much is waiting are dropped.
+    int capacity_ms{500};
+  };
+
+  struct Stats {
+    std::uint64_t frames_pushed = 0;  // samples per channel
+    std::uint64_t frames_dropped = 0; // lost to a full ring
+    std::uint64_t frames_sent = 0;    // AudioFrames delivered
+  };
+
+  using FrameSink = std::function<void(const AudioFrame &)>;
+
+  /// Capture into `source`, whose format the options must match. Throws
+  /// std::invalid_argument on a null or mismatched source.
+  AudioCaptureAdapter(std::shared_ptr<AudioSource> source,
+                      const Options &options);
+  /// Deliver the frames to `sink` on the worker thread instead.
+  AudioCaptureAdapter(FrameSink sink, const Options &options);
+  /// Stops the worker; a partial frame still buffered is discarded.
+  ~AudioCaptureAdapter();
+
+  AudioCaptureAdapter(const AudioCaptureAdapter &) = delete;
+  AudioCaptureAdapter &operator=(const AudioCaptureAdapter &) = delete;
+
+  /// Device callback: copy `frames` interleaved frames. Never blocks or
+  /// allocates. Returns the frames accepted (fewer once the ring is full).
+  int push(const std::int16_t *interleaved, int frames) noexcept;
+
+  Stats stats() const noexcept;
+
+private:
+  void run();
+
+  const Options options_;
+  const std::size_t channels_;
+  const std::size_t frame_samples_;
+  FrameSink sink_;
+
+  std::vector<std::int16_t> ring_;
+  std::size_t mask_ = 0;
+  std::atomic<std::size_t> write_pos_{0};
+  std::atomic<std::size_t> read_pos_{0};
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::atomic<bool> waiting_{false};
+  bool stop_ = false;
+
+  AudioFramePool pool_;
+  std::atomic<std::uint64_t> pushed_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> sent_{0};
+  std::thread worker_;
+};
+
+} // namespace livekit
@@ -16,13 +16,22 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "livekit/audio_frame.h"
 #include "livekit/ffi_handle.h"
 
 namespace livekit {
 
+namespace proto {
+class FfiRequest;
+} // namespace proto
+
+class AudioProcessingStream;
+class FfiArenaScope;
+
 /**
  * @brief WebRTC Audio Processing Module (APM) for real-time audio enhancement.
  *
@@ -129,6 +138,27 @@ public:
    */
   void processReverseStream(AudioFrame &frame);
 
+  /**
+   * @brief Process several consecutive near-end frames in order.
+   *
+   * Equivalent to calling processStream() on each frame, but reuses one
+   * request across the batch. Empty frames are skipped. Each frame must
+   * still be exactly 10ms; use AudioProcessingStream for arbitrary lengths.
+   *
+   * @throws std::runtime_error if processing any frame fails; earlier frames
+   *         in the batch remain processed.
+   */
+  void processStreamBatch(AudioFrame *frames, std::size_t count);
+  void processStreamBatch(std::vector<AudioFrame> &frames);
+
+  /**
+   * @brief Process several consecutive far-end frames in order.
+   *
+   * The reverse-stream counterpart of processStreamBatch().
+   */
+  void processReverseStreamBatch(AudioFrame *frames, std::size_t count);
+  void processReverseStreamBatch(std::vector<AudioFrame> &frames);
+
   /**
    * @brief Set the estimated delay between the reverse and forward streams.
    *
@@ -155,6 +185,14 @@ public:
   void setStreamDelayMs(int delay_ms);
 
 private:
+  friend class AudioProcessingStream;
+
+  void processBatch(bool reverse, AudioFrame *frames, std::size_t count);
+  // Process one 10ms chunk of interleaved samples in place.
+  void processRaw(bool reverse, std::int16_t *data, std::size_t total_samples,
+                  int sample_rate, int num_channels, proto::FfiRequest &req,
+                  FfiArenaScope &arena);
+
   /// Check if the APM handle is valid (used internally).
   bool valid() const noexcept { return handle_.valid(); }
 
@@ -166,4 +204,70 @@ private:
   FfiHandle handle_;
 };
 
+/**
+ * @brief Feeds arbitrary-length audio through an AudioProcessingModule.
+ *
+ * The APM only accepts 10ms frames. AudioProcessingStream buffers input of
+ * any length, processes every complete 10ms chunk, and returns the
+ * processed samples; a partial chunk is carried over to the next call.
+ * Output therefore lags input by less than 10ms.
+ *
+ * @code
+ * AudioProcessingStream mic(apm, AudioProcessingStream::Direction::kForward,
+ *                           48000, 1);
+ * AudioFrame clean = mic.process(device_buffer); // any length
+ * if (clean.samples_per_channel() > 0) source->captureFrame(clean);
+ * @endcode
+ *
+ * Not thread-safe; the APM must outlive the stream.
+ */
+class AudioProcessingStream {
+public:
+  enum class Direction {
+    /// Near-end audio (microphone), processed with processStream().
+    kForward,
+    /// Far-end audio (speaker), processed with processReverseStream().
+    kReverse,
+  };
+
+  /// @throws std::invalid_argument unless sample_rate is a positive multiple
+  ///         of 100 and num_channels is positive.
+  AudioProcessingStream(AudioProcessingModule &apm, Direction direction,
+                        int sample_rate, int num_channels);
+
+  /**
+   * Append `input` and return all audio processed so far (a whole number of
+   * 10ms chunks, possibly empty).
+   *
+   * @throws std::invalid_argument if the frame format does not match.
+   * @throws std::runtime_error if the APM reports an error.
+   */
+  AudioFrame process(const AudioFrame &input);
+
+  /// Same as above for raw interleaved samples in the stream's format.
+  AudioFrame process(const std::int16_t *data,
+                     std::size_t samples_per_channel);
+
+  /// Process buffered samples (padded with silence internally) and return
+  /// them. Use at end of stream.
+  AudioFrame flush();
+
+  /// Discard buffered samples without processing them.
+  void reset();
+
+  /// Samples per channel currently buffered, waiting for a full chunk.
+  std::size_t pendingSamplesPerChannel() const noexcept;
+
+  int sampleRate() const noexcept { return sample_rate_; }
+  int numChannels() const noexcept { return num_channels_; }
+
+private:
+  AudioProcessingModule *apm_;
+  Direction direction_;
+  int sample_rate_;
+  int num_channels_;
+  std::size_t chunk_samples_ = 0;
+  std::vector<std::int16_t> pending_;
+};
+
 } // namespace livekit
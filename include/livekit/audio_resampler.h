@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "audio_frame.h"
+
+namespace livekit {
+
+/**
+ * Streaming sample-rate converter for interleaved int16 PCM, running fully
+ * in-process (no FFI round trip).
+ *
+ * Uses a windowed-sinc polyphase FIR for the exact rational ratio
+ * output_rate / input_rate, with vectorized inner products. Filter state is
+ * carried across calls, so consecutive frames convert without seams; e.g.
+ * feeding 10 ms frames at 44.1 kHz yields 10 ms frames at 48 kHz.
+ *
+ * Not thread-safe: use one instance per stream.
+ */
+class AudioResampler {
+public:
+  /**
+   * @param input_rate   Sample rate of frames passed to resample().
+   * @param output_rate  Sample rate of the returned frames.
+   * @param num_channels Channel count of input and output frames.
+   * @param taps         Filter length per phase at full bandwidth. Higher
+   *                     values give a sharper anti-aliasing filter at a
+   *                     higher CPU cost; downsampling scales it up further.
+   *
+   * Throws std::invalid_argument on non-positive arguments or if the reduced
+   * rate ratio is too large to tabulate.
+   */
+  AudioResampler(int input_rate, int output_rate, int num_channels,
+                 int taps = 16);
+
+  /**
+   * Convert one frame. The output holds every sample that can be produced so
+   * far, so its length can differ by one from the ideal ratio while the
+   * filter primes.
+   *
+   * Throws std::invalid_argument if the frame's rate or channel count does
+   * not match the resampler.
+   */
+  AudioFrame resample(const AudioFrame &frame);
+
+  /// Drain the filter tail (pads the input with silence) and reset state.
+  AudioFrame flush();
+
+  /// Drop all buffered input and restart with fresh filter state.
+  void reset();
+
+  int inputRate() const noexcept { return input_rate_; }
+  int outputRate() const noexcept { return output_rate_; }
+  int numChannels() const noexcept { return num_channels_; }
+
+private:
+  AudioFrame process(const std::int16_t *data, std::size_t frames);
+
+  int input_rate_;
+  int output_rate_;
+  int num_channels_;
+
+  // Reduced ratio: output advances the input by down_/up_ samples.
+  std::size_t up_{1};
+  std::size_t down_{1};
+  std::size_t taps_{0};
+
+  // up_ phases of taps_ coefficients, each stored time-reversed so an output
+  // sample is a forward dot product over the input history.
+  std::vector<float> coeffs_;
+
+  // Per-channel input history (deinterleaved, float).
+  std::vector<std::vector<float>> history_;
+  std::size_t phase_{0};
+};
+
+} // namespace livekit
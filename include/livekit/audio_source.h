@@ -16,10 +16,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
 
 #include "livekit/audio_frame.h"
 #include "livekit/ffi_handle.h"
+#include "livekit/frame_pool.h"
 
 namespace livekit {
 
@@ -69,7 +74,7 @@ public:
    *     queue_size_ms must be a multiple of 10.
    */
   AudioSource(int sample_rate, int num_channels, int queue_size_ms = 0);
-  virtual ~AudioSource() = default;
+  virtual ~AudioSource();
 
   AudioSource(const AudioSource &) = delete;
   AudioSource &operator=(const AudioSource &) = delete;
@@ -88,6 +93,10 @@ public:
   }
 
   /// Current duration of queued audio (in seconds).
+  ///
+  /// Once non-blocking capture (pushFrame) is in use, this is the audio that
+  /// was pushed but not yet acknowledged by the native side, rather than a
+  /// wall-clock estimate.
   double queuedDuration() const noexcept;
 
   /**
@@ -141,7 +150,81 @@ public:
    */
   void captureFrame(const AudioFrame &frame, int timeout_ms = 20);
 
+  /**
+   * Float variant of captureFrame(). The samples are converted to int16 once
+   * (SIMD, into a pooled buffer) before being handed to the FFI, which only
+   * accepts interleaved int16. Interleaved and planar frames are accepted.
+   */
+  void captureFrame(const FloatAudioFrame &frame, int timeout_ms = 20);
+
+  /**
+   * Get a frame matching this source's sample rate and channel count whose
+   * buffer comes from the source's frame pool. The buffer is recycled once
+   * the frame is destroyed, so steady-state capture loops do not allocate.
+   * Recycled buffers are not zeroed.
+   */
+  AudioFrame acquireFrame(int samples_per_channel);
+
+  /// Configuration for non-blocking capture (see pushFrame()).
+  struct AsyncCaptureOptions {
+    /// Maximum number of frames waiting locally; pushFrame() rejects frames
+    /// beyond this instead of dropping queued audio.
+    std::size_t max_queued_frames{64};
+
+    /// Upper bound on audio coalesced into a single FFI capture request.
+    int max_batch_ms{50};
+
+    /// Invoked on the capture worker thread once per FFI request with the
+    /// number of frames it carried; `error` is null on success.
+    std::function<void(std::size_t frames, std::exception_ptr error)>
+        on_complete;
+  };
+
+  /**
+   * Start non-blocking capture with the given options. Optional: pushFrame()
+   * starts it with default options. Throws std::runtime_error if it has
+   * already been started.
+   */
+  void enableAsyncCapture(const AsyncCaptureOptions &options);
+
+  /**
+   * Fire-and-forget capture.
+   *
+   * The frame is queued in a lock-free single-producer ring and returns
+   * immediately. A worker thread coalesces whatever has accumulated (up to
+   * AsyncCaptureOptions::max_batch_ms) into one FFI request and waits for its
+   * acknowledgement before sending the next, so a bursty producer issues far
+   * fewer FFI calls than captureFrame() would.
+   *
+   * Must be called from a single thread. Frames must match the source's
+   * sample rate and channel count (std::invalid_argument otherwise).
+   *
+   * @return false if the local queue is full; the frame was not queued.
+   */
+  bool pushFrame(AudioFrame &&frame);
+
+  /// Float variant of pushFrame(); converted to a pooled int16 frame first.
+  bool pushFrame(const FloatAudioFrame &frame);
+
+  /**
+   * Block until everything queued with pushFrame() has been acknowledged.
+   * @param timeout_ms  0 waits indefinitely.
+   * @return false on timeout.
+   */
+  bool flush(int timeout_ms = 0);
+
 private:
+  struct AsyncCapture;
+  // Owns the AsyncCapture once created.
+  struct AsyncSlot;
+
+  // The running AsyncCapture, or nullptr before the first pushFrame() or
+  // enableAsyncCapture().
+  AsyncCapture *asyncCapture() const noexcept;
+  // Creates the AsyncCapture unless one exists; throws if `exclusive`.
+  AsyncCapture *startAsyncCapture(const AsyncCaptureOptions &options,
+                                  bool exclusive);
+
   // Internal helper to reset the local queue tracking (like _release_waiter).
   void resetQueueTracking() noexcept;
 
@@ -155,6 +238,12 @@ private:
   // Queue tracking (all in seconds; based on steady_clock in the .cpp).
   mutable double last_capture_{0.0};
   mutable double q_size_{0.0};
+
+  AudioFramePool frame_pool_;
+
+  // Non-blocking capture state; declared last so its worker stops before
+  // handle_ is released.
+  std::unique_ptr<AsyncSlot> async_;
 };
 
 } // namespace livekit
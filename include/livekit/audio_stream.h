@@ -16,17 +16,24 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "audio_frame.h"
+#include "audio_resampler.h"
 #include "ffi_handle.h"
+#include "frame_pool.h"
 #include "participant.h"
+#include "stream_stats.h"
 #include "track.h"
 
 namespace livekit {
@@ -35,6 +42,26 @@ namespace proto {
 class FfiEvent;
 }
 
+class SharedFrameRing;
+
+namespace detail {
+template <typename T> class SpscRing;
+class MediaStreamStatsRecorder;
+class VoiceDetector;
+} // namespace detail
+
+/**
+ * Signal levels of one received frame, see AudioStream::Options::
+ * measure_levels. Levels span all channels and are normalized to [0, 1]
+ * of full scale.
+ */
+struct AudioLevels {
+  float rms = 0.0f;
+  float peak = 0.0f;
+  /// Voice activity; only set with Options::detect_voice.
+  bool voice = false;
+};
+
 /**
  * @brief Event containing an audio frame received from an AudioStream.
  *
@@ -43,6 +70,38 @@ class FfiEvent;
  */
 struct AudioFrameEvent {
   AudioFrame frame; ///< The decoded PCM audio frame.
+  /// Levels of the frame as received (before any remix or resample); set
+  /// when the stream measures levels.
+  std::optional<AudioLevels> levels;
+  /// Receive-side media time of the first sample, in microseconds of
+  /// std::chrono::steady_clock: the arrival time of the stream's first
+  /// frame plus the duration of all audio received since. Unlike arrival
+  /// times it does not jitter; it restarts from the arrival time after a
+  /// gap or burst of more than 200 ms. The FFI carries no RTP timestamp
+  /// for audio.
+  std::int64_t timestamp_us = 0;
+};
+
+/**
+ * @brief Float32 variant of AudioFrameEvent, see
+ * AudioStream::read(FloatAudioFrameEvent&).
+ */
+struct FloatAudioFrameEvent {
+  FloatAudioFrame frame; ///< Layout per AudioStream::Options::float_layout.
+  std::optional<AudioLevels> levels; ///< As in AudioFrameEvent.
+  std::int64_t timestamp_us = 0;     ///< As in AudioFrameEvent.
+};
+
+/**
+ * @brief Zero-copy variant of AudioFrameEvent.
+ *
+ * The view references the Rust-owned buffer directly; the buffer is released
+ * when the event (or its view) is destroyed.
+ */
+struct AudioFrameViewEvent {
+  AudioFrameView frame; ///< View over the native PCM buffer.
+  std::optional<AudioLevels> levels; ///< As in AudioFrameEvent.
+  std::int64_t timestamp_us = 0;     ///< As in AudioFrameEvent.
 };
 
 /**
@@ -60,6 +119,9 @@ struct AudioFrameEvent {
  *   }
  *
  *   stream->close();  // optional, called automatically in destructor
+ *
+ * Frames always arrive decoded (the FFI does not expose the received Opus
+ * payloads). AudioFrameViewEvent reads and push mode avoid copying them.
  */
 class AudioStream {
 public:
@@ -80,6 +142,68 @@ public:
     /// Optional: JSON-encoded configuration for the noise cancellation module.
     /// Empty string means "use module defaults".
     std::string noise_cancellation_options_json;
+
+    /// Optional output format for frames delivered as AudioFrameEvent or
+    /// FloatAudioFrameEvent. When non-zero, frames are remixed to
+    /// `num_channels` and/or resampled to `sample_rate` in-process before
+    /// read() returns them. Zero-copy AudioFrameViewEvent reads and push-mode
+    /// callbacks always see the track's native format.
+    int sample_rate{0};
+    int num_channels{0};
+
+    /// Layout of frames delivered as FloatAudioFrameEvent.
+    AudioSampleLayout float_layout{AudioSampleLayout::kInterleaved};
+
+    /// Pool supplying storage for frames copied by read(AudioFrameEvent&).
+    /// Frames return their buffer to the pool once destroyed. If null, the
+    /// stream uses a private pool.
+    std::shared_ptr<AudioFramePool> frame_pool;
+
+    /// If true and capacity > 0, frames are queued in a fixed-size lock-free
+    /// single-producer/single-consumer ring instead of a mutex-guarded deque.
+    /// Drop-oldest semantics are kept, and read() spins briefly before
+    /// parking. Only one thread may read from the stream in this mode, and
+    /// frames already queued when the stream reaches EOS are still delivered.
+    bool spsc_ring{false};
+
+    /// If true, RMS and peak are computed for every frame with SIMD on the
+    /// FFI event thread, straight from the native buffer, and reported in
+    /// the event's `levels`.
+    bool measure_levels{false};
+
+    /// If true, an energy-based voice activity detector runs on the levels
+    /// (implies measure_levels) and sets AudioLevels::voice. A frame is
+    /// voice when its RMS is `vad_threshold_db` above the tracked noise
+    /// floor; a voice decision is held for `vad_hangover_ms`.
+    bool detect_voice{false};
+    float vad_threshold_db{9.0f};
+    int vad_hangover_ms{300};
+
+    /// If true (implies detect_voice), frames without voice are released
+    /// before they are queued, so readers such as ASR only ever see speech.
+    /// Skipped frames count as dropped in stats().
+    bool voice_only{false};
+
+    /// Optional push-mode delivery. If set, every frame is handed to this
+    /// callback instead of being queued, and read() only ever reports the end
+    /// of the stream. Saves the queue hop and reader wakeup per frame.
+    std::function<void(AudioFrameViewEvent &&)> on_frame;
+
+    /// Push mode only: called once when the stream reaches EOS.
+    std::function<void()> on_eos;
+
+    /// Push mode only: runs on_frame / on_eos. If empty, callbacks run inline
+    /// on the FFI event thread and must not block.
+    std::function<void(std::function<void()>)> callback_executor;
+
+    /// Shared-memory export: every frame (after voice_only filtering) is
+    /// copied from the FFI buffer straight into this ring (Kind::kAudio) in
+    /// the track's native format.
+    std::shared_ptr<SharedFrameRing> export_ring;
+
+    /// With export_ring: release each frame once exported instead of
+    /// queuing it, so read() only reports EOS.
+    bool export_only{false};
   };
 
   /// Factory: create an AudioStream bound to a specific Track
@@ -107,6 +231,45 @@ public:
   ///         (end-of-stream or close()) and no more data is available.
   bool read(AudioFrameEvent &out_event);
 
+  /// Zero-copy blocking read. Same semantics as read(AudioFrameEvent&), but
+  /// hands out a view over the native buffer instead of copying the samples.
+  /// The native buffer is dropped when the consumer releases the view.
+  bool read(AudioFrameViewEvent &out_event);
+
+  /// Float32 blocking read. Samples are converted once, with SIMD, from the
+  /// native int16 buffer into Options::float_layout; with a sample_rate or
+  /// num_channels set, the frame is remixed/resampled first.
+  bool read(FloatAudioFrameEvent &out_event);
+
+  /// Non-blocking read. Returns false immediately if no frame is queued; use
+  /// isEnded() to tell an empty queue from a finished stream.
+  bool tryRead(AudioFrameEvent &out_event);
+  bool tryRead(AudioFrameViewEvent &out_event);
+  bool tryRead(FloatAudioFrameEvent &out_event);
+
+  /// Like read(), but waits at most `timeout` for a frame. Returns false on
+  /// timeout or once the stream has ended.
+  bool readFor(AudioFrameEvent &out_event, std::chrono::milliseconds timeout);
+  bool readFor(AudioFrameViewEvent &out_event,
+               std::chrono::milliseconds timeout);
+  bool readFor(FloatAudioFrameEvent &out_event,
+               std::chrono::milliseconds timeout);
+
+  /// Non-blocking batch read: appends up to `max_events` queued frames to
+  /// `out` (taking the queue lock once) and returns how many were appended.
+  std::size_t readBatch(std::vector<AudioFrameEvent> &out,
+                        std::size_t max_events);
+  std::size_t readBatch(std::vector<AudioFrameViewEvent> &out,
+                        std::size_t max_events);
+
+  /// True once the stream was closed, or reached EOS and every queued frame
+  /// has been read.
+  bool isEnded() const;
+
+  /// Counters for this stream since it was created; safe to call from any
+  /// thread while frames flow.
+  MediaStreamStats stats() const;
+
   /// Signal that we are no longer interested in audio frames.
   ///
   /// This disposes the underlying FFI audio stream, unregisters the listener
@@ -115,28 +278,89 @@ public:
   void close();
 
 private:
-  AudioStream() = default;
+  AudioStream();
 
   void initFromTrack(const std::shared_ptr<Track> &track,
                      const Options &options);
   void initFromParticipant(Participant &participant, TrackSource track_source,
                            const Options &options);
 
+  // Registers onFfiEvent with FfiClient, routed by stream_handle_. Must be
+  // called once the stream handle is known.
+  void subscribeToStreamEvents();
+
   // FFI event handler (registered with FfiClient)
   void onFfiEvent(const proto::FfiEvent &event);
 
+  // Shared by both init helpers.
+  void applyOptions(const Options &options);
+
+  // Options::measure_levels: fills ev.levels; false if voice_only drops the
+  // frame. FFI event thread only.
+  bool analyzeFrame(AudioFrameViewEvent &ev);
+  // AudioFrameEvent::timestamp_us for the next frame. FFI event thread only.
+  std::int64_t mediaTimestamp(const AudioFrameView &frame);
+
+  // Copies a view into an AudioFrame in the format requested by options_.
+  AudioFrame convertFrame(const AudioFrameView &view);
+  // As convertFrame(), into a float frame laid out per options_.
+  FloatAudioFrame convertFloatFrame(const AudioFrameView &view);
+
+  // A queued frame and its arrival time, for MediaStreamStats::queue_time.
+  // `arrived` is the FFI event time, set only while latency tracing is on.
+  struct QueuedFrame {
+    AudioFrameViewEvent event;
+    std::chrono::steady_clock::time_point enqueued;
+    std::chrono::steady_clock::time_point arrived{};
+  };
+
   // Queue helpers
-  void pushFrame(AudioFrameEvent &&ev);
+  void pushFrame(AudioFrameViewEvent &&ev,
+                 std::chrono::steady_clock::time_point arrived = {});
   void pushEos();
+  // Push mode: hands `ev` to on_frame_ via the configured executor.
+  void deliverToCallback(AudioFrameViewEvent &&ev,
+                         std::chrono::steady_clock::time_point arrived);
+  // Moves a dequeued frame to the reader and records its queue time.
+  void takeFrame(QueuedFrame &queued, AudioFrameViewEvent &out);
 
   mutable std::mutex mutex_;
   std::condition_variable cv_;
-  std::deque<AudioFrameEvent> queue_;
+  // Frames are queued as views; read(AudioFrameEvent&) copies on the
+  // consumer's thread, read(AudioFrameViewEvent&) does not copy at all.
+  std::deque<QueuedFrame> queue_;
   std::size_t capacity_{0};
   bool eof_{false};
   bool closed_{false};
 
+  // Lock-free queue used instead of queue_ when Options::spsc_ring is set.
+  std::unique_ptr<detail::SpscRing<QueuedFrame>> ring_;
+
+  // Last queue depth, byte estimate and ring drop count reported to the
+  // SDK metrics.
+  std::atomic<std::int64_t> metrics_depth_{0};
+  std::atomic<std::int64_t> metrics_bytes_{0};
+  std::atomic<std::uint64_t> metrics_ring_dropped_{0};
+
+  std::unique_ptr<detail::MediaStreamStatsRecorder> stats_;
+  // Options::detect_voice state; FFI event thread only.
+  std::unique_ptr<detail::VoiceDetector> vad_;
+  // AudioFrameEvent::timestamp_us state; FFI event thread only.
+  std::int64_t media_anchor_us_{0};
+  std::int64_t media_samples_{0};
+  int media_rate_{0};
+
+  // Push-mode callbacks are moved out of options_ into their own members,
+  // as in VideoStream.
   Options options_;
+  std::function<void(AudioFrameViewEvent &&)> on_frame_;
+  std::function<void()> on_eos_;
+  std::function<void(std::function<void()>)> callback_executor_;
+  std::shared_ptr<AudioFramePool> frame_pool_;
+
+  // Created on demand when Options::sample_rate differs from the track's.
+  std::mutex convert_mutex_;
+  std::unique_ptr<AudioResampler> resampler_;
 
   // Underlying FFI audio stream handle
   FfiHandle stream_handle_;
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "audio_stream.h"
+#include "video_stream.h"
+
+namespace livekit {
+
+class Participant;
+class Track;
+
+/// One audio frame and the video frame that belongs on screen with it.
+struct AvSyncFrame {
+  AudioFrameEvent audio;
+  /// Newest video frame due at or before audio.timestamp_us; shared by the
+  /// consecutive audio frames it spans. Null until video has started.
+  std::shared_ptr<const VideoFrameEvent> video;
+  /// `video` differs from the previous AvSyncFrame's.
+  bool video_changed = false;
+  /// Audio time minus video time, in microseconds; positive when the video
+  /// frame is older than the audio.
+  std::int64_t skew_us = 0;
+};
+
+/// Counters for one AvSync, see AvSync::stats().
+struct AvSyncStats {
+  std::uint64_t audio_frames = 0;
+  std::uint64_t video_frames = 0;
+  /// Video frames never paired with audio: superseded within one audio
+  /// frame, evicted from a full buffer or left over at close().
+  std::uint64_t video_dropped = 0;
+  /// Audio frames released after Options::max_delay without video having
+  /// caught up with them.
+  std::uint64_t audio_unsynced = 0;
+  std::int64_t last_skew_us = 0;
+};
+
+/**
+ * Lip-syncs a participant's audio and video.
+ *
+ * Audio is the master clock: every audio frame is delivered once, in order,
+ * paired with the video frame due at its AudioFrameEvent::timestamp_us.
+ * Video times come from VideoFrameEvent::timestamp_us, mapped onto the
+ * receive clock by the smallest arrival offset seen over the last 64
+ * frames. An audio frame is held until a later video frame has arrived, or
+ * for at most Options::max_delay, and at most Options::max_video_frames
+ * video frames are buffered, so buffering stays bounded by the actual skew
+ * rather than a fixed safety margin.
+ *
+ * The callback runs on the thread that pushed the frame completing the
+ * pair (the FFI event thread when attached to streams) and must not block
+ * or call back into this AvSync.
+ *
+ * @code
+ * AvSync sync([&](AvSyncFrame &&f) { recorder.write(f); });
+ * sync.attach(remoteParticipant);
+ * @endcode
+ */
+class AvSync {
+public:
+  using Callback = std::function<void(AvSyncFrame &&)>;
+
+  struct Options {
+    /// Longest an audio frame waits for video, in audio media time.
+    std::chrono::milliseconds max_delay{150};
+    /// Video frames buffered ahead of the audio; the oldest is dropped
+    /// beyond this.
+    std::size_t max_video_frames{8};
+    /// Added to every video time; positive pairs video with later audio.
+    std::chrono::milliseconds video_offset{0};
+    /// Format of the video stream opened by attach().
+    VideoBufferType video_format{VideoBufferType::I420};
+  };
+
+  /// Throws std::invalid_argument if `on_frame` is empty.
+  explicit AvSync(Callback on_frame);
+  AvSync(Callback on_frame, const Options &options);
+  /// Calls close().
+  ~AvSync();
+
+  AvSync(const AvSync &) = delete;
+  AvSync &operator=(const AvSync &) = delete;
+
+  /// Open push-mode streams on the two tracks and sync them. The end of
+  /// the audio stream acts like close().
+  void attach(const std::shared_ptr<Track> &audio_track,
+              const std::shared_ptr<Track> &video_track);
+  /// Same, on a participant's tracks of the given sources.
+  void attach(Participant &participant,
+              TrackSource audio_source = TrackSource::SOURCE_MICROPHONE,
+              TrackSource video_source = TrackSource::SOURCE_CAMERA);
+
+  /// Feed frames directly, e.g. from streams read elsewhere. An audio
+  /// frame without timestamp_us is stamped with the current time; video
+  /// arrival defaults to now, in steady_clock microseconds.
+  void pushAudio(AudioFrameEvent &&event);
+  void pushVideo(VideoFrameEvent &&event);
+  void pushVideo(VideoFrameEvent &&event, std::int64_t arrival_us);
+
+  /// Close attached streams and deliver the audio still held. Idempotent.
+  void close();
+
+  AvSyncStats stats() const;
+
+private:
+  struct Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+} // namespace livekit
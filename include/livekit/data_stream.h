@@ -16,15 +16,21 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdio>
 #include <cstdint>
 #include <deque>
+#include <exception>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace livekit {
@@ -36,6 +42,10 @@ class LocalParticipant;
 // channels.
 constexpr std::size_t kStreamChunkSize = 15'000; // 15 KB
 
+// Default number of chunks a writer keeps in flight before waiting for the
+// oldest one to be acknowledged.
+constexpr std::size_t kDefaultMaxInFlightChunks = 8;
+
 /// Base metadata for any stream (text or bytes).
 struct BaseStreamInfo {
   /// Unique identifier for this stream.
@@ -69,6 +79,135 @@ struct ByteStreamInfo : BaseStreamInfo {
   std::string name;
 };
 
+// Attributes attached to every stream of a striped file transfer (see
+// SendFileOptions::num_streams). Stripe k covers the bytes
+// [offset, offset + size) of the original file; receivers reassemble the
+// file by collecting `count` streams that share the same transfer id.
+constexpr const char *kStripeTransferIdAttribute = "lk_stripe_transfer_id";
+constexpr const char *kStripeIndexAttribute = "lk_stripe_index";
+constexpr const char *kStripeCountAttribute = "lk_stripe_count";
+constexpr const char *kStripeOffsetAttribute = "lk_stripe_offset";
+constexpr const char *kStripeTotalSizeAttribute = "lk_stripe_total_size";
+
+/// Options for LocalParticipant::sendFile().
+struct SendFileOptions {
+  /// Name advertised in the byte stream header. Defaults to the file name
+  /// component of the path.
+  std::string name;
+  std::string topic;
+  std::string mime_type = "application/octet-stream";
+  std::map<std::string, std::string> attributes;
+  std::vector<std::string> destination_identities;
+
+  /// Number of byte streams the file is striped across. Each stream carries
+  /// one contiguous, chunk-aligned slice and the kStripe* attributes. 1 sends
+  /// a plain byte stream without stripe attributes. Clamped to the number of
+  /// chunks in the file.
+  std::size_t num_streams = 1;
+
+  /// In-flight chunk window of each stream.
+  std::size_t max_in_flight_chunks = kDefaultMaxInFlightChunks;
+};
+
+/// What an incoming stream does when buffering a chunk would exceed its
+/// memory budget (see StreamBufferOptions).
+enum class StreamOverflowPolicy {
+  /// Hold the event thread until the consumer drains enough, for at most
+  /// StreamBufferOptions::block_timeout; then drop the stream.
+  kBlock,
+  /// End the stream for the consumer and discard its buffered data.
+  kDropStream,
+  /// Move the stream's buffered data to a temporary file and keep
+  /// buffering there; reads continue transparently from the file.
+  kSpillToFile,
+};
+
+/// Memory limits for incoming data streams, set through RoomOptions.
+/// A limit of 0 means unlimited (the default, matching earlier releases).
+struct StreamBufferOptions {
+  /// Bytes buffered in memory by one reader but not yet read.
+  std::size_t max_reader_bytes = 0;
+
+  /// Bytes buffered in memory by all readers of a room together.
+  std::size_t max_room_bytes = 0;
+
+  StreamOverflowPolicy policy = StreamOverflowPolicy::kBlock;
+
+  /// Longest a chunk waits for budget under kBlock.
+  std::chrono::milliseconds block_timeout{5000};
+
+  /// Directory for kSpillToFile files; the system temp directory if empty.
+  std::string spill_directory;
+};
+
+/// Counters for a room's incoming stream buffers (Room::streamBufferStats).
+struct StreamBufferStats {
+  /// Bytes currently buffered in memory across all readers.
+  std::size_t buffered_bytes = 0;
+  /// Highest value buffered_bytes has reached.
+  std::size_t peak_buffered_bytes = 0;
+  /// Chunks that had to wait for budget under kBlock.
+  std::uint64_t blocked_chunks = 0;
+  /// Streams ended early because they exceeded their budget.
+  std::uint64_t dropped_streams = 0;
+  /// Streams moved to a spill file.
+  std::uint64_t spilled_streams = 0;
+};
+
+/// Send class of reliable data, highest first. Packets waiting for the
+/// send budget (see DataSendOptions) go out in this order, and bulk traffic
+/// only ever fills part of the budget so that a control or state packet can
+/// be sent without waiting behind it.
+enum class DataPriority {
+  /// Latency-sensitive messages; the default for publishData().
+  kControl,
+  /// Application state and text streams.
+  kState,
+  /// Byte streams and sendFile().
+  kBulk,
+};
+
+// Send budget used until the room reports the reliable channel's
+// buffered-amount-low threshold.
+constexpr std::size_t kDefaultDataSendBufferBytes = 256 * 1024;
+
+/// Backpressure for outgoing reliable data, set through RoomOptions or
+/// LocalParticipant::setDataSendOptions(). Bytes count as buffered from the
+/// moment a packet is handed to the FFI until the send is acknowledged;
+/// packets that would exceed the budget wait in a local queue instead of
+/// piling up in the data channel. A packet is always sent when nothing is
+/// buffered, however large. Lossy packets bypass the queue.
+struct DataSendOptions {
+  /// Budget in bytes. 0 follows the reliable channel's buffered-amount-low
+  /// threshold (DataChannelBufferedAmountLowThresholdChangedEvent), or
+  /// kDefaultDataSendBufferBytes until the room has reported one.
+  std::size_t max_buffered_bytes = 0;
+
+  /// Share of the budget, in percent, that DataPriority::kBulk packets may
+  /// fill.
+  unsigned bulk_share_percent = 75;
+};
+
+/// Counters for LocalParticipant::dataSendStats().
+struct DataSendStats {
+  /// Bytes sent and not yet acknowledged.
+  std::size_t buffered_bytes = 0;
+  /// Budget currently in effect.
+  std::size_t limit_bytes = 0;
+  /// Packets (and their bytes) waiting for budget.
+  std::size_t queued_packets = 0;
+  std::size_t queued_bytes = 0;
+  /// Reliable packets handed to the FFI.
+  std::uint64_t packets_sent = 0;
+  /// Of those, packets that had to wait in the queue first.
+  std::uint64_t packets_delayed = 0;
+};
+
+namespace detail {
+class SpillFile;
+class StreamBudget;
+} // namespace detail
+
 // Readers
 //   - TextStreamReader: yields UTF-8 text chunks (std::string)
 //   - ByteStreamReader: yields raw bytes (std::vector<uint8_t>)
@@ -80,6 +219,8 @@ public:
   /// Construct a reader from initial stream metadata.
   explicit TextStreamReader(const TextStreamInfo &info);
 
+  ~TextStreamReader();
+
   TextStreamReader(const TextStreamReader &) = delete;
   TextStreamReader &operator=(const TextStreamReader &) = delete;
 
@@ -91,12 +232,22 @@ public:
   /// Blocks until the stream is closed.
   std::string readAll();
 
+  /// True if the stream was ended early because it exceeded its buffer
+  /// budget (see StreamBufferOptions).
+  bool dropped() const noexcept;
+
+  /// Bytes received and held in memory but not read yet.
+  std::size_t bufferedBytes() const noexcept { return memory_bytes_.load(); }
+
   /// Metadata associated with this stream.
   const TextStreamInfo &info() const noexcept { return info_; }
 
 private:
   friend class Room;
 
+  /// Called by the Room before the reader is handed out.
+  void attachBudget(std::shared_ptr<detail::StreamBudget> budget);
+
   /// Called by the Room when a new chunk arrives.
   void onChunkUpdate(const std::string &text);
 
@@ -104,22 +255,42 @@ private:
   /// Additional trailer attributes are merged into info().attributes.
   void onStreamClose(const std::map<std::string, std::string> &trailer_attrs);
 
+  /// Move buffered chunks to a spill file. False if that failed.
+  bool spillLocked();
+  /// End the stream and discard everything buffered.
+  void dropLocked();
+
   TextStreamInfo info_;
 
   // Queue of text chunks; empty string with closed_==true means EOS.
   std::deque<std::string> queue_;
   bool closed_ = false;
 
+  // Budget accounting. Once spilled, chunks live in spill_ and
+  // spilled_sizes_ keeps their boundaries.
+  std::shared_ptr<detail::StreamBudget> budget_;
+  std::atomic<std::size_t> memory_bytes_{0};
+  std::unique_ptr<detail::SpillFile> spill_;
+  std::deque<std::size_t> spilled_sizes_;
+  std::atomic<bool> dropped_{false};
+
   std::mutex mutex_;
   std::condition_variable cv_;
 };
 
 /// Reader for incoming byte streams.
+///
+/// Incoming chunks are appended in place to one contiguous buffer, pre-sized
+/// from info().size when the sender announced it. Consume the stream either
+/// chunk by chunk (readNext), into caller-owned memory (readInto), in one
+/// piece (readAll), or by routing it straight to a file (setFileSink).
 class ByteStreamReader {
 public:
   /// Construct a reader from initial stream metadata.
   explicit ByteStreamReader(const ByteStreamInfo &info);
 
+  ~ByteStreamReader();
+
   ByteStreamReader(const ByteStreamReader &) = delete;
   ByteStreamReader &operator=(const ByteStreamReader &) = delete;
 
@@ -127,24 +298,83 @@ public:
   /// Returns false when the stream has ended.
   bool readNext(std::vector<std::uint8_t> &out);
 
+  /// Blocking read of up to `capacity` bytes into `dest`, across chunk
+  /// boundaries. Returns the number of bytes copied; 0 once the stream has
+  /// ended.
+  std::size_t readInto(std::uint8_t *dest, std::size_t capacity);
+
+  /// Read the rest of the stream into a single buffer.
+  /// Blocks until the stream is closed. If nothing was consumed before, the
+  /// reassembly buffer itself is returned without another copy.
+  std::vector<std::uint8_t> readAll();
+
+  /// Write the stream to `path` instead of buffering it. Bytes already
+  /// received are written immediately; later chunks are written as they
+  /// arrive, on the thread delivering room events. Safe to call from the
+  /// ByteStreamHandler. The read methods then see no data and report
+  /// end-of-stream once the stream closes.
+  /// Throws std::runtime_error if the file cannot be opened or a sink is
+  /// already set.
+  void setFileSink(const std::string &path);
+
+  /// Block until the stream is closed and return the total number of bytes
+  /// received. Throws std::runtime_error if writing to the file sink failed.
+  std::uint64_t waitForClose();
+
+  /// True if the stream was ended early because it exceeded its buffer
+  /// budget (see StreamBufferOptions).
+  bool dropped() const noexcept;
+
+  /// Bytes received and held in memory but not read yet. Spilled data and
+  /// data sent to a file sink are not counted.
+  std::size_t bufferedBytes() const noexcept { return memory_bytes_.load(); }
+
   /// Metadata associated with this stream.
   const ByteStreamInfo &info() const noexcept { return info_; }
 
 private:
   friend class Room;
 
+  /// Called by the Room before the reader is handed out.
+  void attachBudget(std::shared_ptr<detail::StreamBudget> budget);
+
   /// Called by the Room when a new chunk arrives.
-  void onChunkUpdate(const std::vector<std::uint8_t> &bytes);
+  void onChunkUpdate(const std::uint8_t *data, std::size_t size);
 
   /// Called by the Room when the stream is closed.
   /// Additional trailer attributes are merged into info().attributes.
   void onStreamClose(const std::map<std::string, std::string> &trailer_attrs);
 
+  /// Drop consumed bytes from the front of buffer_ once they dominate it.
+  void compactLocked();
+  /// Move unread bytes to a spill file. False if that failed.
+  bool spillLocked();
+  /// End the stream and discard everything buffered.
+  void dropLocked();
+  /// Account for `n` bytes handed to the consumer.
+  void consumedLocked(std::size_t n);
+
   ByteStreamInfo info_;
 
-  std::deque<std::vector<std::uint8_t>> queue_;
+  // Unconsumed bytes are buffer_[read_offset_, buffer_.size()). chunk_sizes_
+  // holds the unconsumed length of each chunk, for readNext().
+  std::vector<std::uint8_t> buffer_;
+  std::size_t read_offset_ = 0;
+  std::deque<std::size_t> chunk_sizes_;
+  std::uint64_t bytes_received_ = 0;
   bool closed_ = false;
 
+  std::unique_ptr<std::FILE, int (*)(std::FILE *)> sink_{nullptr,
+                                                         &std::fclose};
+  bool sink_failed_ = false;
+
+  // Budget accounting. Once spilled, unread bytes live in spill_ instead of
+  // buffer_; chunk_sizes_ still describes them.
+  std::shared_ptr<detail::StreamBudget> budget_;
+  std::atomic<std::size_t> memory_bytes_{0};
+  std::unique_ptr<detail::SpillFile> spill_;
+  std::atomic<bool> dropped_{false};
+
   std::mutex mutex_;
   std::condition_variable cv_;
 };
@@ -171,10 +401,30 @@ public:
   bool isClosed() const noexcept { return closed_; }
 
   /// Close the stream with optional reason and attributes.
-  /// Throws on FFI error or if already closed.
+  /// Waits for chunks still in flight, then sends the trailer.
+  /// Throws on FFI error (including a failed in-flight chunk) or if already
+  /// closed. After a failed chunk the trailer is still sent, with the error
+  /// in its reason, before the error is rethrown.
   void close(const std::string &reason = "",
              const std::map<std::string, std::string> &attributes = {});
 
+  /// Maximum number of chunks sent but not yet acknowledged. write() only
+  /// blocks once this many are outstanding, so throughput is no longer
+  /// bounded by one FFI round trip per chunk. 1 restores strictly
+  /// sequential sends. Values below 1 are treated as 1.
+  void setMaxInFlightChunks(std::size_t max_in_flight);
+  std::size_t maxInFlightChunks() const noexcept { return max_in_flight_; }
+
+  /// Send class of this stream's chunks in the reliable send queue (see
+  /// DataSendOptions): kState for text streams, kBulk for byte streams.
+  void setPriority(DataPriority priority) noexcept { priority_ = priority; }
+  DataPriority priority() const noexcept { return priority_; }
+
+  /// Send anything the writer is still holding back (see
+  /// TextStreamWriter::setCoalescing), then block until every chunk sent so
+  /// far is acknowledged. Throws the first chunk error, if any.
+  void flush();
+
 protected:
   BaseStreamWriter(LocalParticipant &local_participant,
                    const std::string &topic = "",
@@ -206,13 +456,33 @@ protected:
   std::string reply_to_id_;
   std::string byte_name_; // Used by ByteStreamWriter
 
+  // Acknowledgements for chunks in flight, oldest first. A failure is kept
+  // in chunk_error_ and rethrown by every later sendChunk()/flush()/close().
+  std::deque<std::future<void>> in_flight_;
+  std::size_t max_in_flight_ = kDefaultMaxInFlightChunks;
+  std::exception_ptr chunk_error_;
+  DataPriority priority_ = DataPriority::kState;
+
+  // Serializes every path that sends chunks or touches the state above:
+  // write(), flush(), close() and TextStreamWriter's coalescing timer.
+  std::mutex write_mutex_;
+
+  /// Collect finished acknowledgements, waiting until at most `keep` chunks
+  /// remain in flight. Throws the first chunk error seen.
+  void drainInFlight(std::size_t keep);
+
   /// Ensure the header has been sent once.
   /// Throws on error.
   void ensureHeaderSent();
 
-  /// Send a raw chunk of bytes.
-  /// Throws on error or if stream is closed.
-  void sendChunk(const std::vector<std::uint8_t> &content);
+  /// Send a raw chunk of bytes (at most kStreamChunkSize) without waiting
+  /// for it to be acknowledged, once the in-flight window has room.
+  /// Throws on error (including an earlier chunk's) or if stream is closed.
+  void sendChunk(const std::uint8_t *data, std::size_t size);
+
+  /// Send data buffered by the subclass. Called by flush() and close()
+  /// with write_mutex_ held.
+  virtual void flushPending() {}
 
   /// Send the trailer with given reason and attributes.
   /// Throws on error.
@@ -232,17 +502,50 @@ public:
                    const std::vector<std::string> &destination_identities = {},
                    const std::string &sender_identity = "");
 
+  /// Stops the coalescing timer and sends any text still held back, best
+  /// effort: failures are logged, not thrown, and no trailer is sent. Call
+  /// close() to end the stream and see errors.
+  ~TextStreamWriter() override;
+
   /// Write a UTF-8 string to the stream.
   /// Data will be split into chunks of at most kStreamChunkSize bytes.
   /// Throws on error or if the stream is closed.
   void write(const std::string &text);
 
+  /// Opt in to Nagle-style coalescing for many small writes (e.g. one per
+  /// LLM token). Instead of one chunk per write(), text is held back until
+  /// `max_bytes` have accumulated (capped at kStreamChunkSize) or the oldest
+  /// held byte is `max_delay` old, whichever comes first. A background timer
+  /// sends on the deadline, so latency stays bounded even if writes stop.
+  /// flush() and close() send immediately. A zero `max_delay` turns
+  /// coalescing off again, sending anything held back.
+  void setCoalescing(std::chrono::milliseconds max_delay,
+                     std::size_t max_bytes = kStreamChunkSize);
+
   /// Metadata associated with this stream.
   const TextStreamInfo &info() const noexcept { return info_; }
 
+protected:
+  void flushPending() override;
+
 private:
+  /// Send everything in pending_. Requires write_mutex_.
+  void sendPendingLocked();
+  void coalesceLoop();
+
   TextStreamInfo info_;
-  std::mutex write_mutex_;
+
+  // Coalescing state, guarded by write_mutex_. pending_ holds text not yet
+  // sent; deadline_ is when its oldest byte must go out.
+  std::string pending_;
+  std::chrono::milliseconds coalesce_delay_{0};
+  std::size_t coalesce_bytes_ = kStreamChunkSize;
+  std::chrono::steady_clock::time_point deadline_;
+  std::condition_variable coalesce_cv_;
+  std::thread coalesce_thread_;
+  bool stop_coalescing_ = false;
+  // Failure on the timer thread, rethrown by the next write()/flush().
+  std::exception_ptr coalesce_error_;
 };
 
 /// Writer for outgoing byte streams.
@@ -262,12 +565,18 @@ public:
   /// Throws on error or if the stream is closed.
   void write(const std::vector<std::uint8_t> &data);
 
+  /// Write `size` bytes starting at `data` (e.g. a slice of a larger buffer
+  /// or a memory-mapped file). Chunks are copied straight from this memory
+  /// into the outgoing requests; the buffer only needs to stay valid for
+  /// the duration of the call.
+  /// Throws on error or if the stream is closed.
+  void write(const std::uint8_t *data, std::size_t size);
+
   /// Metadata associated with this stream.
   const ByteStreamInfo &info() const noexcept { return info_; }
 
 private:
   ByteStreamInfo info_;
-  std::mutex write_mutex_;
 };
 
 /* Callback invoked when a new incoming text stream is opened.
@@ -290,4 +599,43 @@ using ByteStreamHandler =
     std::function<void(std::shared_ptr<ByteStreamReader>,
                        const std::string &participant_identity)>;
 
+/// Runs a task on some thread, e.g. by posting it to a thread pool. See
+/// Room::setStreamCallbackExecutor().
+using StreamExecutor = std::function<void(std::function<void()>)>;
+
+/// Callbacks consuming one incoming text stream without a reader or a
+/// blocking thread (see Room::registerTextStreamCallbacks). Calls for one
+/// stream never overlap and arrive in stream order; calls for different
+/// streams may run concurrently. Either callback may be empty.
+struct TextStreamCallbacks {
+  /// One chunk of UTF-8 text, as received.
+  std::function<void(const std::string &text)> on_chunk;
+
+  /// Called exactly once, after the last on_chunk. `info` includes the
+  /// trailer's attributes. `dropped` is true if the stream ended early:
+  /// it exceeded its buffer budget, or the room disconnected before the
+  /// trailer arrived.
+  std::function<void(const TextStreamInfo &info, bool dropped)> on_close;
+};
+
+/// Byte stream counterpart of TextStreamCallbacks.
+struct ByteStreamCallbacks {
+  /// One chunk of the stream. `data` is only valid during the call.
+  std::function<void(const std::uint8_t *data, std::size_t size)> on_chunk;
+
+  /// Called exactly once, after the last on_chunk (see TextStreamCallbacks).
+  std::function<void(const ByteStreamInfo &info, bool dropped)> on_close;
+};
+
+/* Callback invoked when a new incoming text stream is opened, returning the
+ * callbacks that consume it. Runs on the stream executor as the stream's
+ * first call.
+ */
+using TextStreamOpenHandler = std::function<TextStreamCallbacks(
+    const TextStreamInfo &info, const std::string &participant_identity)>;
+
+/* Byte stream counterpart of TextStreamOpenHandler. */
+using ByteStreamOpenHandler = std::function<ByteStreamCallbacks(
+    const ByteStreamInfo &info, const std::string &participant_identity)>;
+
 } // namespace livekit
@@ -16,14 +16,24 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace livekit {
 
+enum class EncryptionState;
+
+namespace detail {
+struct FrameCryptorCache;
+struct KeyRotation;
+} // namespace detail
+
 /* Encryption algorithm type used by the underlying stack.
  * Keep this aligned with your proto enum values. */
 enum class EncryptionType {
@@ -89,6 +99,72 @@ struct E2EEOptions {
   EncryptionType encryption_type = EncryptionType::GCM; // default & recommended
 };
 
+/// Number of key slots (key indices 0..15) in the media engine's key ring.
+inline constexpr int kKeyRingSize = 16;
+
+/**
+ * Schedule for E2EEManager::startKeyRotation().
+ *
+ * A rotation happens in two steps. The next key is first installed in a
+ * spare slot, where receivers can already use it while senders still
+ * encrypt with the old slot. After `activation_delay` (or on
+ * activatePendingKey()) every frame cryptor switches to the new slot.
+ * Frames carry their key index, so no frame fails to decrypt across the
+ * switch as long as every participant installed the same key in the same
+ * slot before anyone activated it.
+ *
+ * With an `interval`, rotations follow a shared epoch rather than a
+ * per-process timer: epoch = floor(wall clock / interval), rotating at each
+ * boundary into slot `epoch % key_slots`, or the slot after it when that
+ * one is still active. Participants with synchronized clocks therefore
+ * rotate together whenever each of them started, provided clock skew plus
+ * install time stays below `activation_delay`. Only
+ * `epoch_key` makes the key itself independent of start time; see below.
+ */
+struct KeyRotationOptions {
+  /// Epoch length for periodic rotation. Zero rotates only on
+  /// rotateKeyNow(), which picks the slot after the active one and needs the
+  /// application to trigger it on every participant.
+  std::chrono::milliseconds interval{0};
+
+  /// How long a new key waits in its slot before it becomes active; must
+  /// cover the time all participants need to install it.
+  std::chrono::milliseconds activation_delay{1000};
+
+  /// Slots cycled through, 2..kKeyRingSize.
+  int key_slots = kKeyRingSize;
+
+  /// Returns the key of the periodic rotation for `epoch` (see above);
+  /// every participant must derive the same key from the same epoch, e.g.
+  /// HKDF(room secret, epoch). Recommended for interval mode, since it is
+  /// the only source that lets late joiners agree with everyone else.
+  /// Takes precedence over next_key for periodic rotations.
+  std::function<std::vector<std::uint8_t>(std::int64_t epoch)> epoch_key;
+
+  /// Returns the key for slot `key_index`; every participant must get the
+  /// same key. If neither this nor epoch_key applies, the active shared key
+  /// is copied into the slot and ratcheted there. That local chain only
+  /// matches across participants that started from the same key and have
+  /// performed the same rotations, i.e. joined before the first one.
+  std::function<std::vector<std::uint8_t>(int key_index)> next_key;
+};
+
+/// See E2EEManager::keyRotationStats().
+struct KeyRotationStats {
+  /// Rotations whose key became active.
+  std::uint64_t rotations = 0;
+  int active_key_index = 0;
+  /// Slot holding a key that is installed but not active yet.
+  std::optional<int> pending_key_index;
+  /// DecryptionFailed and MissingKey reports from frame cryptors, since the
+  /// room connected and since the latest activation.
+  std::uint64_t decryption_failures = 0;
+  std::uint64_t missing_key = 0;
+  std::uint64_t failures_since_rotation = 0;
+  /// Rotations that could not install or activate their key.
+  std::uint64_t errors = 0;
+};
+
 /**
  * E2EE manager for a connected room.
  *
@@ -147,6 +223,17 @@ public:
     std::vector<std::uint8_t>
     ratchetKey(const std::string &participant_identity, int key_index = 0);
 
+    /// setKey() for every (identity, key) entry, reusing one request
+    /// message so a room-wide rotation costs no per-key allocation.
+    void setKeys(const std::unordered_map<std::string,
+                                          std::vector<std::uint8_t>> &keys,
+                 int key_index = 0);
+
+    /// ratchetKey() for each identity; returns the new key per identity.
+    std::unordered_map<std::string, std::vector<std::uint8_t>>
+    ratchetKeys(const std::vector<std::string> &participant_identities,
+                int key_index = 0);
+
   private:
     friend class E2EEManager;
     KeyProvider(std::uint64_t room_handle,
@@ -176,13 +263,17 @@ public:
     void setKeyIndex(int key_index);
 
   private:
+    friend class E2EEManager;
     std::uint64_t room_handle_{0};
     bool enabled_{false};
     std::string participant_identity_;
     int key_index_{0};
+    // Set for cryptors handed out by frameCryptors(), so the setters keep
+    // the manager's cached list current.
+    std::shared_ptr<detail::FrameCryptorCache> cache_;
   };
 
-  ~E2EEManager() = default;
+  ~E2EEManager();
   E2EEManager(const E2EEManager &) = delete;
   E2EEManager &operator=(const E2EEManager &) = delete;
   E2EEManager(E2EEManager &&) noexcept = delete;
@@ -204,18 +295,60 @@ public:
   const KeyProvider *keyProvider() const;
 
   /// Retrieves the current list of frame cryptors from the underlying runtime.
+  ///
+  /// The list is cached and only fetched again after a room event that can
+  /// change it (participants joining or leaving, tracks being published or
+  /// subscribed, E2EE state changes, reconnects).
   std::vector<E2EEManager::FrameCryptor> frameCryptors() const;
 
+  /// FrameCryptor::setEnabled() on every frame cryptor.
+  void setAllEnabled(bool enabled);
+
+  /// FrameCryptor::setKeyIndex() on every frame cryptor.
+  void setAllKeyIndex(int key_index);
+
+  /// Ratchets the key at `key_index` of every participant with a frame
+  /// cryptor; returns the new key per identity.
+  std::unordered_map<std::string, std::vector<std::uint8_t>>
+  ratchetAll(int key_index = 0);
+
+  /// Start rotating keys on a background thread; see KeyRotationOptions.
+  /// @throws std::invalid_argument for an out-of-range key_slots.
+  /// @throws std::runtime_error if rotation is already running.
+  void startKeyRotation(const KeyRotationOptions &options);
+
+  /// Stop the scheduler. A key that is installed but not active yet stays
+  /// in its slot unused.
+  void stopKeyRotation();
+
+  /// Install the next key now; it becomes active after activation_delay.
+  /// Does nothing while a rotation is pending.
+  /// @throws std::runtime_error if rotation is not running.
+  void rotateKeyNow();
+
+  /// Activate the pending key immediately, e.g. when the application's own
+  /// signal says every participant has it. Does nothing if none is pending.
+  void activatePendingKey();
+
+  KeyRotationStats keyRotationStats() const;
+
 protected:
   /// Internal constructor used by Room when E2EEOptions are provided.
   explicit E2EEManager(std::uint64_t room_handle, const E2EEOptions &options);
   friend class Room;
 
 private:
+  // Called by Room for events that add or remove frame cryptors.
+  void invalidateFrameCryptors();
+  // Called by Room for every E2EE state change, feeds keyRotationStats().
+  void recordEncryptionState(EncryptionState state);
+
   std::uint64_t room_handle_{0};
   bool enabled_{false};
   E2EEOptions options_;
   KeyProvider key_provider_;
+  std::shared_ptr<detail::FrameCryptorCache> cryptors_;
+  std::unique_ptr<detail::KeyRotation> rotation_;
 };
 
 } // namespace livekit
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace livekit {
+
+/// Which thread runs FFI event handling (protobuf parsing, Room event
+/// processing, RoomDelegate callbacks, stream listeners).
+enum class EventDispatchMode {
+  /// Everything runs on the Rust SDK's callback thread. A slow delegate
+  /// stalls event delivery for every room.
+  kInline = 0,
+
+  /// Raw events are queued and parsed/dispatched on one SDK-owned thread.
+  /// Global event order is preserved.
+  kDedicatedThread = 1,
+
+  /// Events are parsed on the callback thread and dispatched on a pool of
+  /// SDK-owned threads, sharded by owning handle (room, stream, reader).
+  /// Events for the same handle stay in order; events for different handles
+  /// may be handled concurrently.
+  kShardedPool = 2,
+};
+
+/// Options controlling FFI event dispatch, passed to livekit::initialize().
+struct EventDispatchOptions {
+  EventDispatchMode mode = EventDispatchMode::kInline;
+
+  /// Maximum events queued per dispatch thread. When full, the Rust callback
+  /// thread waits for the listeners to catch up; events are never dropped.
+  std::size_t queue_capacity = 4096;
+
+  /// Number of dispatch threads for kShardedPool.
+  int pool_threads = 4;
+
+  /// Deliver AudioStream events on a worker of their own (ThreadRole::kAudio,
+  /// see ThreadOptions::audio) so audio is not queued behind room or video
+  /// events. Ignored for kInline. With kDedicatedThread, audio is then no
+  /// longer ordered against other events; each stream stays in order.
+  bool dedicated_audio_thread = false;
+
+  /**
+   * Preset for processes hosting many rooms (recorders, agent workers):
+   * kShardedPool with one thread per core (2 to 16). Every room, stream and
+   * reader listener is routed by its FFI handle, so an event costs the same
+   * with a thousand rooms as with one, and all rooms share these threads. A
+   * slow delegate only delays the rooms that hash to its thread.
+   */
+  static EventDispatchOptions manyRooms();
+};
+
+} // namespace livekit
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace livekit {
+
+class Room;
+
+/**
+ * Record every event the FFI delivers, as raw bytes with its arrival time,
+ * to `path` (truncated). Recordings feed replayEvents(), which lets room,
+ * stream and delegate dispatch be benchmarked without a server.
+ *
+ * Throws std::runtime_error if recording is already running or the file
+ * cannot be opened. While stopped the callback path pays one relaxed load.
+ */
+void startEventRecording(const std::string &path);
+
+/// Stop recording and close the file. Returns the number of events written
+/// (0 if no recording was running).
+std::uint64_t stopEventRecording();
+
+bool eventRecordingActive();
+
+struct EventReplayOptions {
+  /// Playback rate relative to the recording: 1.0 keeps the recorded
+  /// spacing, 10.0 plays ten times faster and 0 replays back to back.
+  double speed = 1.0;
+  /// If set, this (disconnected) room is bound to the first connect
+  /// callback in the recording, so the room events that follow run through
+  /// Room::OnEvent and its delegate as they did live. The room keeps the
+  /// recorded state afterwards; destroy it before connecting again.
+  ///
+  /// Objects built from the recording adopt its FFI handle ids, which are
+  /// then dropped when they are destroyed, so bind a room only in a process
+  /// that has not created FFI objects (sources, tracks, rooms) of its own.
+  Room *room = nullptr;
+};
+
+struct EventReplayResult {
+  /// Events dispatched to listeners.
+  std::uint64_t events = 0;
+  /// Replies to requests made while recording; they are not replayed since
+  /// no request of this process is waiting for them.
+  std::uint64_t skipped = 0;
+  std::uint64_t bytes = 0;
+  /// Span of the recording, and the wall time the replay took.
+  std::chrono::nanoseconds recorded{0};
+  std::chrono::nanoseconds elapsed{0};
+  /// Whether options.room was bound to a recorded connect.
+  bool room_attached = false;
+};
+
+/**
+ * Feed a recording made by startEventRecording() back through the SDK's
+ * event dispatch on the calling thread, paced by options.speed. Listeners
+ * run on this thread even if an EventDispatchOptions pool is configured,
+ * which keeps replays deterministic.
+ *
+ * Throws std::runtime_error if the file cannot be read or is not a
+ * recording.
+ */
+EventReplayResult replayEvents(const std::string &path,
+                               const EventReplayOptions &options = {});
+
+} // namespace livekit
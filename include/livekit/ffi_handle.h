@@ -18,6 +18,8 @@
 
 #include <cstdint>
 
+#include "livekit/resources.h"
+
 namespace livekit {
 
 /**
@@ -28,7 +30,21 @@ namespace livekit {
  */
 class FfiHandle {
 public:
+  /// How the handle is released by reset() and the destructor.
+  enum class Disposal {
+    /// livekit_ffi_drop_handle() right away.
+    kImmediate,
+    /// Buffer handles on hot paths: handed to the background disposal queue
+    /// when InitializeOptions::deferred_handle_disposal is set, otherwise
+    /// dropped right away.
+    kDeferrable,
+  };
+
   explicit FfiHandle(uintptr_t h = 0) noexcept;
+  FfiHandle(uintptr_t h, Disposal disposal) noexcept;
+  /// Tagged handle, counted by resourceSnapshot() while metrics are enabled.
+  FfiHandle(uintptr_t h, ResourceKind kind,
+            Disposal disposal = Disposal::kImmediate) noexcept;
   ~FfiHandle();
 
   // Non-copyable
@@ -39,7 +55,8 @@ public:
   FfiHandle(FfiHandle &&other) noexcept;
   FfiHandle &operator=(FfiHandle &&other) noexcept;
 
-  // Replace the current handle with a new one, dropping the old if needed
+  // Replace the current handle with a new one, dropping the old if needed.
+  // The new handle keeps this handle's Disposal and ResourceKind.
   void reset(uintptr_t new_handle = 0) noexcept;
 
   // Release ownership of the handle without dropping it
@@ -51,11 +68,21 @@ public:
   // Get the raw handle value
   [[nodiscard]] uintptr_t get() const noexcept;
 
+  [[nodiscard]] ResourceKind kind() const noexcept { return kind_; }
+
   // Allow `if (handle)` syntax
   explicit operator bool() const noexcept { return valid(); }
 
 private:
+  // Count handle_ under kind_ if metrics are on. The flag remembers it so
+  // that untrack() stays balanced when metrics are toggled meanwhile.
+  void track() noexcept;
+  void untrack() noexcept;
+
   uintptr_t handle_{0};
+  Disposal disposal_{Disposal::kImmediate};
+  ResourceKind kind_{ResourceKind::kOther};
+  bool tracked_{false};
 };
 
 } // namespace livekit
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace livekit {
+
+class AudioFrame;
+class AudioSource;
+
+namespace detail {
+class MappedFile;
+} // namespace detail
+
+/**
+ * Plays a 16-bit PCM file into an AudioSource in real time.
+ *
+ * The file is memory-mapped, never loaded: each 10 ms chunk is copied
+ * straight from the mapping into a pooled frame, and pages already played
+ * are handed back to the OS, so resident memory stays constant however
+ * long the file is. Playback runs on its own thread, paced against the
+ * start time (chunk n is due at start + n * 10 ms), so it does not drift
+ * with scheduling jitter.
+ *
+ * WAV files (PCM or WAVE_FORMAT_EXTENSIBLE, 16-bit) describe their own
+ * format; anything without a RIFF header is read as raw interleaved s16le
+ * in Options::raw_sample_rate / raw_num_channels.
+ *
+ * @code
+ * FileAudioSource::Options options;
+ * options.loop = true;
+ * FileAudioSource file("hold_music.wav", options);
+ * room.localParticipant()->publishTrack(
+ *     LocalAudioTrack::createLocalAudioTrack("music", file.audioSource()),
+ *     TrackPublishOptions{});
+ * file.start();
+ * @endcode
+ */
+class FileAudioSource {
+public:
+  struct Options {
+    /// Restart from the beginning at the end of the file.
+    bool loop{false};
+    /// Format of raw PCM files; ignored for WAV files.
+    int raw_sample_rate{48000};
+    int raw_num_channels{1};
+    /// Non-looping playback reached the end; runs on the playback thread.
+    std::function<void()> on_end;
+  };
+
+  /// Throws std::runtime_error if the file cannot be mapped or is not
+  /// 16-bit PCM, std::invalid_argument on a bad raw format.
+  explicit FileAudioSource(const std::string &path);
+  FileAudioSource(const std::string &path, const Options &options);
+  /// Play into an existing source (e.g. one already published), which must
+  /// match the file's format. Throws std::invalid_argument on a null or
+  /// mismatched source.
+  FileAudioSource(const std::string &path, std::shared_ptr<AudioSource> source);
+  FileAudioSource(const std::string &path, std::shared_ptr<AudioSource> source,
+                  const Options &options);
+  ~FileAudioSource();
+
+  FileAudioSource(const FileAudioSource &) = delete;
+  FileAudioSource &operator=(const FileAudioSource &) = delete;
+
+  int sample_rate() const noexcept { return sample_rate_; }
+  int num_channels() const noexcept { return num_channels_; }
+  std::chrono::microseconds duration() const noexcept;
+  /// Current playhead; advances as chunks are captured.
+  std::chrono::microseconds position() const noexcept;
+
+  /// The source the file is played into, in the file's format (created
+  /// unless one was passed in). Publish it with
+  /// LocalAudioTrack::createLocalAudioTrack().
+  const std::shared_ptr<AudioSource> &audioSource() const noexcept {
+    return source_;
+  }
+
+  /// Start (or resume) real-time playback. No-op while playing.
+  void start();
+  /// Pause playback; the position is kept. Blocks until the playback
+  /// thread has stopped.
+  void stop();
+  bool playing() const noexcept { return playing_.load(); }
+
+  /// Move the playhead (clamped to the file); takes effect with the next
+  /// chunk. Safe from any thread.
+  void seek(std::chrono::microseconds position);
+
+  /**
+   * Copy the next frame.samples_per_channel() samples into `frame` without
+   * pacing, e.g. to drive playback from an audio callback instead of
+   * start(). Past the end the rest of the frame is silent (or, with loop,
+   * continues from the start). Returns the samples per channel taken from
+   * the file (0 once a non-looping file is exhausted). Must not be mixed
+   * with start().
+   *
+   * Throws std::invalid_argument if the frame's channel count differs.
+   */
+  int readFrame(AudioFrame &frame);
+
+private:
+  void run();
+
+  std::unique_ptr<detail::MappedFile> file_;
+  const std::int16_t *samples_ = nullptr; // interleaved, in the mapping
+  std::size_t data_offset_ = 0;           // of samples_ in the file
+  std::uint64_t total_frames_ = 0;        // samples per channel
+  int sample_rate_ = 0;
+  int num_channels_ = 0;
+  Options options_;
+  std::shared_ptr<AudioSource> source_;
+
+  // Playhead in samples per channel, and a pending seek (-1 if none).
+  std::atomic<std::uint64_t> playhead_{0};
+  std::atomic<std::int64_t> seek_to_{-1};
+  // Mapping bytes before this offset were already released.
+  std::size_t released_ = 0;
+
+  std::atomic<bool> playing_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_requested_ = false;
+  std::thread thread_;
+};
+
+} // namespace livekit
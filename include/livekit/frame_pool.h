@@ -0,0 +1,170 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "audio_frame.h"
+#include "video_frame.h"
+
+namespace livekit {
+
+namespace detail {
+
+/**
+ * Thread-safe cache of std::vector<T> buffers, bucketed by element count.
+ *
+ * Frames acquired from a pool hold a weak reference to it and hand their
+ * storage back on destruction. If the pool is gone by then, the storage is
+ * simply freed.
+ */
+template <typename T> class FrameBufferPool {
+public:
+  explicit FrameBufferPool(std::size_t max_per_bucket)
+      : max_per_bucket_(max_per_bucket) {}
+
+  /// Returns a buffer of exactly `count` elements. Reused buffers are not
+  /// cleared; freshly allocated ones are zero-initialized.
+  std::vector<T> acquire(std::size_t count) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = buckets_.find(count);
+      if (it != buckets_.end() && !it->second.empty()) {
+        std::vector<T> buf = std::move(it->second.back());
+        it->second.pop_back();
+        return buf;
+      }
+    }
+    return std::vector<T>(count);
+  }
+
+  /// Returns a buffer to its bucket, or frees it if the bucket is full.
+  void recycle(std::vector<T> &&buf) noexcept {
+    if (buf.empty()) {
+      return;
+    }
+    try {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &bucket = buckets_[buf.size()];
+      if (bucket.size() < max_per_bucket_) {
+        bucket.push_back(std::move(buf));
+      }
+    } catch (...) {
+      // Allocation failure while caching: just let the buffer be freed.
+    }
+  }
+
+  std::size_t cachedBuffers() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t n = 0;
+    for (const auto &kv : buckets_) {
+      n += kv.second.size();
+    }
+    return n;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buckets_.clear();
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::size_t, std::vector<std::vector<T>>> buckets_;
+  std::size_t max_per_bucket_;
+};
+
+} // namespace detail
+
+/**
+ * Size-bucketed pool of VideoFrame pixel buffers.
+ *
+ * Frames returned by acquire() give their storage back to the pool when they
+ * are destroyed, so steady-state capture or receive loops stop allocating.
+ * The pool may be shared between threads; copies of a VideoFramePool share
+ * the same underlying cache.
+ *
+ * Typical usage:
+ *
+ *   VideoFramePool pool;
+ *   while (capturing) {
+ *     VideoFrame frame = pool.acquire(1280, 720, VideoBufferType::I420);
+ *     fill(frame.data(), frame.dataSize());
+ *     source->captureFrame(frame);
+ *   } // frame storage is recycled here
+ */
+class VideoFramePool {
+public:
+  /// @param max_buffers_per_bucket Upper bound on idle buffers kept per
+  ///                               distinct buffer size.
+  explicit VideoFramePool(std::size_t max_buffers_per_bucket = 4);
+
+  /**
+   * Get a frame with the correct buffer size for the given format. Unlike
+   * VideoFrame::create(), recycled buffers are not zeroed.
+   */
+  VideoFrame acquire(int width, int height, VideoBufferType type);
+
+  /// Number of idle buffers currently cached.
+  std::size_t cachedBuffers() const;
+
+  /// Free all idle buffers.
+  void clear();
+
+private:
+  friend class VideoFrame;
+  // Frame of `bytes` bytes (>= the format's minimum size) backed by the pool.
+  VideoFrame acquireBytes(int width, int height, VideoBufferType type,
+                          std::size_t bytes);
+
+  std::shared_ptr<detail::FrameBufferPool<std::uint8_t>> pool_;
+};
+
+/**
+ * Size-bucketed pool of AudioFrame sample buffers, keyed by total sample
+ * count (num_channels * samples_per_channel).
+ *
+ * Same recycling semantics as VideoFramePool.
+ */
+class AudioFramePool {
+public:
+  explicit AudioFramePool(std::size_t max_buffers_per_bucket = 16);
+
+  /**
+   * Get a frame with room for num_channels * samples_per_channel samples.
+   * Unlike AudioFrame::create(), recycled buffers are not zeroed.
+   */
+  AudioFrame acquire(int sample_rate, int num_channels,
+                     int samples_per_channel);
+
+  /// Number of idle buffers currently cached.
+  std::size_t cachedBuffers() const;
+
+  /// Free all idle buffers.
+  void clear();
+
+private:
+  std::shared_ptr<detail::FrameBufferPool<std::int16_t>> pool_;
+};
+
+} // namespace livekit
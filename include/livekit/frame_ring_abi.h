@@ -0,0 +1,159 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Memory layout of a SharedFrameRing, for consumers in other processes.
+ *
+ * Plain C with no dependency on the SDK: map the shared memory object (its
+ * name, or the fd passed over a socket), check the header, then read frames
+ * in place. Everything is little-endian and shared by one writer and any
+ * number of readers.
+ *
+ *   lk_frame_ring_header   (LK_FRAME_RING_ALIGN bytes)
+ *   slot 0                 (header->slot_size bytes)
+ *   slot 1 ...
+ *
+ * Each slot starts with an lk_frame_slot_header, followed by the payload at
+ * LK_FRAME_SLOT_PAYLOAD_OFFSET. Slots are guarded by a seqlock: `seq` is odd
+ * while the writer is filling the slot. A reader takes the sequence with
+ * lk_frame_slot_begin(), uses the payload where it lies, and then checks
+ * lk_frame_slot_end(); if that fails the writer lapped the reader and
+ * whatever was read must be discarded.
+ *
+ *   uint64_t next = lk_frame_ring_write_index(ring);  // start at the newest
+ *   ...
+ *   if (lk_frame_ring_write_index(ring) > next) {
+ *     const lk_frame_slot_header *slot = lk_frame_ring_slot(ring, next);
+ *     uint64_t seq = lk_frame_slot_begin(slot);
+ *     if (seq != 0 && slot->frame_index == next) {
+ *       consume(lk_frame_slot_payload(slot), slot->payload_size);
+ *       if (!lk_frame_slot_end(slot, seq)) { discard(); }
+ *     }
+ *     ++next;
+ *   }
+ */
+
+#ifndef LIVEKIT_FRAME_RING_ABI_H
+#define LIVEKIT_FRAME_RING_ABI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LK_FRAME_RING_MAGIC 0x52464b4cu /* "LKFR" */
+#define LK_FRAME_RING_VERSION 1u
+#define LK_FRAME_RING_ALIGN 64u
+#define LK_FRAME_RING_MAX_PLANES 4
+#define LK_FRAME_SLOT_PAYLOAD_OFFSET 128u
+
+enum lk_frame_ring_kind {
+  LK_FRAME_RING_VIDEO = 1,
+  LK_FRAME_RING_AUDIO = 2,
+};
+
+typedef struct lk_frame_ring_header {
+  uint32_t magic;      /* LK_FRAME_RING_MAGIC */
+  uint32_t version;    /* LK_FRAME_RING_VERSION */
+  uint32_t kind;       /* lk_frame_ring_kind */
+  uint32_t slot_count;
+  uint64_t slot_size;  /* bytes per slot, header included */
+  uint64_t max_payload;
+  /* Frames published so far; the newest is write_index - 1, in slot
+   * (write_index - 1) % slot_count. Read with lk_frame_ring_write_index(). */
+  uint64_t write_index;
+  /* Frames skipped because they did not fit max_payload. */
+  uint64_t dropped;
+  uint32_t producer_pid;
+  uint32_t closed;     /* set once the writer has finished */
+  uint8_t reserved[8];
+} lk_frame_ring_header;
+
+typedef struct lk_frame_slot_header {
+  uint64_t seq;          /* seqlock; odd while being written */
+  uint64_t frame_index;  /* write_index value this slot was written for */
+  int64_t timestamp_us;
+  uint32_t payload_size;
+  uint32_t format;       /* video: livekit::VideoBufferType; audio: 0 = s16 */
+  /* Video frames. */
+  uint32_t width;
+  uint32_t height;
+  uint32_t rotation;     /* degrees */
+  uint32_t plane_count;
+  uint32_t plane_offset[LK_FRAME_RING_MAX_PLANES]; /* from the payload */
+  uint32_t plane_stride[LK_FRAME_RING_MAX_PLANES];
+  /* Audio frames: interleaved samples. */
+  uint32_t sample_rate;
+  uint32_t num_channels;
+  uint32_t samples_per_channel;
+  uint32_t reserved;
+} lk_frame_slot_header;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LK_FRAME_RING_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define LK_FRAME_RING_FENCE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+#error "frame_ring_abi.h needs GCC or Clang atomics"
+#endif
+
+static inline int lk_frame_ring_valid(const lk_frame_ring_header *ring,
+                                      size_t mapped_size) {
+  return mapped_size >= sizeof(lk_frame_ring_header) &&
+         ring->magic == LK_FRAME_RING_MAGIC &&
+         ring->version == LK_FRAME_RING_VERSION && ring->slot_count > 0 &&
+         LK_FRAME_RING_ALIGN + ring->slot_size * ring->slot_count <=
+             mapped_size;
+}
+
+static inline uint64_t
+lk_frame_ring_write_index(const lk_frame_ring_header *ring) {
+  return LK_FRAME_RING_LOAD(&ring->write_index);
+}
+
+static inline const lk_frame_slot_header *
+lk_frame_ring_slot(const lk_frame_ring_header *ring, uint64_t frame_index) {
+  const uint8_t *base = (const uint8_t *)ring + LK_FRAME_RING_ALIGN;
+  return (const lk_frame_slot_header *)(base +
+                                        (frame_index % ring->slot_count) *
+                                            ring->slot_size);
+}
+
+static inline const uint8_t *
+lk_frame_slot_payload(const lk_frame_slot_header *slot) {
+  return (const uint8_t *)slot + LK_FRAME_SLOT_PAYLOAD_OFFSET;
+}
+
+/* Sequence to pass to lk_frame_slot_end(), or 0 while the slot is being
+ * written. */
+static inline uint64_t lk_frame_slot_begin(const lk_frame_slot_header *slot) {
+  const uint64_t seq = LK_FRAME_RING_LOAD(&slot->seq);
+  return (seq & 1u) ? 0 : seq;
+}
+
+/* Non-zero if the slot was not rewritten since lk_frame_slot_begin(). */
+static inline int lk_frame_slot_end(const lk_frame_slot_header *slot,
+                                    uint64_t seq) {
+  LK_FRAME_RING_FENCE();
+  return __atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIVEKIT_FRAME_RING_ABI_H */
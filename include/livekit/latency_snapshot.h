@@ -0,0 +1,45 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+
+/**
+ * Point-in-time copy of a latency histogram.
+ *
+ * Buckets are log-linear (16 per power of two), so any reported value is
+ * within about 6% of the recorded one.
+ */
+struct LatencySnapshot {
+  std::uint64_t count = 0;
+  std::chrono::microseconds min{0};
+  std::chrono::microseconds max{0};
+  std::chrono::microseconds total{0};
+  /// Non-empty buckets as (inclusive upper bound, sample count), ascending.
+  std::vector<std::pair<std::chrono::microseconds, std::uint64_t>> buckets;
+
+  /// Value at quantile `q` in [0, 1]; 0 if there are no samples.
+  std::chrono::microseconds percentile(double q) const;
+  std::chrono::microseconds mean() const;
+};
+
+} // namespace livekit
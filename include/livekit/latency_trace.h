@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the “License”);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "latency_snapshot.h"
+
+#include <cstddef>
+#include <string>
+
+namespace livekit {
+
+enum class TraceMedia { kAudio, kVideo };
+
+/**
+ * SDK-side stages of a frame's trip, timed on the steady clock.
+ *
+ * Encode, network and decode run inside the FFI, so they appear as the gap
+ * between kCapture on the sender and the start of kReceiveConvert on the
+ * receiver. Video spans carry the frame's timestamp_us, which lines up the
+ * two sides when both are traced from one process.
+ */
+enum class TraceStage {
+  /// captureFrame() until the FFI accepted the frame (toProto + copy).
+  kCapture,
+  /// captureFrameAsync(): waiting for the capture worker.
+  kCaptureQueue,
+  /// FFI frame event until the SDK frame is ready (wrap, copy, scale). For
+  /// audio this is the AudioFrame conversion done by read(AudioFrameEvent&).
+  kReceiveConvert,
+  /// Queued in the stream until handed out, including a deferred copy.
+  kReceiveQueue,
+  /// FFI frame event until read() returned it or on_frame was invoked.
+  kReceiveTotal,
+};
+
+constexpr std::size_t kTraceStageCount = 5;
+
+/// Per-stage latency histograms, see latencyTraceReport().
+struct LatencyTraceReport {
+  LatencySnapshot audio[kTraceStageCount];
+  LatencySnapshot video[kTraceStageCount];
+
+  const LatencySnapshot &at(TraceMedia media, TraceStage stage) const {
+    const auto i = static_cast<std::size_t>(stage);
+    return media == TraceMedia::kAudio ? audio[i] : video[i];
+  }
+};
+
+/**
+ * Turn per-frame latency tracing on or off (default: off).
+ *
+ * While disabled each trace point costs one relaxed atomic load. Frames
+ * already queued when tracing is enabled are not traced.
+ */
+void setLatencyTracingEnabled(bool enabled);
+bool latencyTracingEnabled();
+
+/// Histograms of every span recorded since the last reset. They are also
+/// exported by metricsToOpenMetrics() once they hold samples.
+LatencyTraceReport latencyTraceReport();
+
+/**
+ * The most recent spans (up to 16384) in the Chrome trace-event JSON format,
+ * for chrome://tracing or ui.perfetto.dev. Timestamps are steady-clock
+ * microseconds; each span sits on the thread that recorded it.
+ */
+std::string latencyTraceToChromeJson();
+
+/// Drop the recorded spans and clear the histograms.
+void resetLatencyTrace();
+
+} // namespace livekit
@@ -16,26 +16,60 @@
 
 #pragma once
 
+#include "apm_engine.h"
+#include "async_operation.h"
+#include "attribute_map.h"
 #include "audio_frame.h"
+#include "audio_mixer.h"
+#include "audio_pipeline.h"
+#include "audio_playout_buffer.h"
 #include "audio_processing_module.h"
+#include "audio_resampler.h"
 #include "audio_source.h"
 #include "audio_stream.h"
+#include "av_sync.h"
 #include "build.h"
 #include "e2ee.h"
+#include "event_dispatch.h"
+#include "event_replay.h"
+#include "file_audio_source.h"
+#include "frame_pool.h"
+#include "latency_snapshot.h"
+#include "latency_trace.h"
 #include "local_audio_track.h"
+#include "logging.h"
 #include "local_participant.h"
 #include "local_track_publication.h"
 #include "local_video_track.h"
+#include "media_clock.h"
+#include "media_recorder.h"
+#include "metrics.h"
+#include "native_video_buffer.h"
 #include "participant.h"
 #include "remote_participant.h"
 #include "remote_track_publication.h"
+#include "resources.h"
 #include "room.h"
 #include "room_delegate.h"
 #include "room_event_types.h"
+#include "rpc_metrics.h"
+#include "rpc_payload.h"
+#include "shared_frame_ring.h"
+#include "stats_sampler.h"
+#include "stream_stats.h"
+#include "thread_options.h"
 #include "track_publication.h"
+#include "v4l2_video_source.h"
+#include "video_compositor.h"
+#include "video_format.h"
 #include "video_frame.h"
 #include "video_source.h"
 #include "video_stream.h"
+#include "video_stream_hub.h"
+
+#include <future>
+#include <optional>
+#include <string>
 
 namespace livekit {
 
@@ -44,7 +78,8 @@ enum class LogSink {
   /// Logs are printed to the default console output (FFI prints directly).
   kConsole = 0,
 
-  /// Logs are delivered to the application's FFI callback for capturing.
+  /// Rust logs are captured into the SDK log pipeline (see logging.h) and
+  /// reach stderr and any addLogOutput() outputs from there.
   kCallback = 1,
 };
 
@@ -59,6 +94,54 @@ enum class LogSink {
 /// already initialized.
 bool initialize(LogSink log_sink = LogSink::kConsole);
 
+/// Initialize the LiveKit SDK with an explicit event dispatch policy.
+///
+/// By default FFI events are handled on the Rust callback thread; use
+/// EventDispatchMode::kDedicatedThread or kShardedPool so that slow
+/// RoomDelegate callbacks do not hold up event delivery for other rooms.
+bool initialize(LogSink log_sink, const EventDispatchOptions &dispatch);
+
+/// Start-up policy for initialize(const InitializeOptions &).
+struct InitializeOptions {
+  LogSink log_sink = LogSink::kConsole;
+  EventDispatchOptions dispatch;
+  /// Start the FFI runtime on a background thread and return immediately.
+  /// Any SDK call that needs the runtime (creating a Room connection, a
+  /// source, a track, ...) blocks until start-up has finished, so the
+  /// application can do its own set-up in parallel.
+  bool background = false;
+  /// Also warm the media engine (see prewarm()) once the runtime is up, so
+  /// the first track or connect does not pay for it.
+  bool prewarm_media = false;
+  /// Release received frame, data-packet and response buffers on a
+  /// background thread, in batches, instead of calling into the FFI on the
+  /// thread that lets go of them (often the FFI callback or a consumer's
+  /// read loop). Buffers then live up to a few milliseconds longer.
+  bool deferred_handle_disposal = false;
+  /// Log filtering and outputs, applied before the FFI starts so that
+  /// LogOptions::push_down_to_ffi can take effect. Unset keeps whatever
+  /// configureLogging() last set.
+  std::optional<LogOptions> logging;
+  /// Naming, CPU pinning and scheduling priority of SDK-owned threads,
+  /// applied before any of them starts. The Rust FFI's own threads are not
+  /// affected. See also EventDispatchOptions::dedicated_audio_thread.
+  ThreadOptions threads;
+};
+
+/// Initialize the LiveKit SDK; see InitializeOptions.
+bool initialize(const InitializeOptions &options);
+
+/// Do the connection work that does not need a token ahead of time.
+///
+/// Resolves the host of `url` (DNS results are cached by the OS resolver)
+/// and warms the media engine, whose threads and factories are otherwise
+/// created lazily by the first track or connect. Pass an empty `url` to
+/// warm the media engine only. Runs in the background; the returned future
+/// becomes ready when done and never throws, failures are only logged.
+/// Throws std::runtime_error if the SDK is not initialized; shutdown()
+/// waits for a prewarm that is still running.
+std::future<void> prewarm(const std::string &url);
+
 /// Shut down the LiveKit SDK.
 ///
 /// After shutdown, you may call initialize() again.
@@ -16,25 +16,38 @@
 
 #pragma once
 
+#include "livekit/async_operation.h"
+#include "livekit/data_stream.h"
 #include "livekit/ffi_handle.h"
 #include "livekit/participant.h"
 #include "livekit/room_event_types.h"
 #include "livekit/rpc_error.h"
+#include "livekit/rpc_payload.h"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace livekit {
 
 struct ParticipantTrackPermission;
 
+namespace detail {
+class DataSendQueue;
+class TaskPool;
+class TranscriptionBatcher;
+} // namespace detail
+
 class FfiClient;
 class Track;
 class LocalTrackPublication;
@@ -44,6 +57,115 @@ struct RpcInvocationData {
   std::string caller_identity;
   std::string payload;
   double response_timeout_sec; // seconds
+  /// True if the caller sent arbitrary bytes (RpcCallOptions::binary);
+  /// `payload` then holds them unencoded.
+  bool binary = false;
+  /// Codec the caller negotiated (RpcCallOptions::compression), or empty.
+  /// `payload` is already decompressed; the reply is compressed with it.
+  std::string compression;
+};
+
+/// Per-call options for LocalParticipant::performRpc().
+struct RpcCallOptions {
+  /// Response timeout in seconds; the server default if unset.
+  std::optional<double> response_timeout;
+  /// The payload (and reply) may hold arbitrary bytes. They are carried
+  /// base64-encoded on the wire and decoded transparently on both ends.
+  bool binary = false;
+  /// Name of a codec registered with registerRpcCompression() to compress
+  /// the payload and reply with. Empty sends them uncompressed.
+  std::string compression;
+};
+
+/// Per-method settings for LocalParticipant::registerRpcMethod().
+struct RpcMethodOptions {
+  /// Maximum number of invocations of this method running at once; further
+  /// invocations wait in arrival order. 0 means no limit.
+  std::size_t max_concurrency = 0;
+};
+
+/// Options for LocalParticipant::performRpcMany().
+struct RpcManyOptions {
+  /// Per-call response timeout in seconds; the server default if unset.
+  std::optional<double> response_timeout;
+  /// Maximum number of calls in flight at once. 0 issues them all at once.
+  std::size_t max_concurrency = 0;
+  /// As in RpcCallOptions.
+  bool binary = false;
+  std::string compression;
+  /// Bound on the whole batch. Calls not answered in time, including any
+  /// not yet issued, report RESPONSE_TIMEOUT.
+  std::optional<std::chrono::milliseconds> deadline;
+};
+
+/// Outcome of one call made by LocalParticipant::performRpcMany().
+struct RpcCallResult {
+  std::string destination_identity;
+  std::string payload;           // Valid when ok().
+  std::optional<RpcError> error; // Set when the call failed.
+
+  bool ok() const noexcept { return !error.has_value(); }
+};
+
+/// Outcome of one track in LocalParticipant::publishTracks().
+struct TrackPublishResult {
+  std::shared_ptr<LocalTrackPublication> publication; // Set when ok().
+  std::string error;                                  // Set on failure.
+
+  bool ok() const noexcept { return publication != nullptr; }
+};
+
+/// Outcome of one track in LocalParticipant::unpublishTracks().
+struct TrackUnpublishResult {
+  std::string track_sid;
+  std::string error; // Empty on success.
+
+  bool ok() const noexcept { return error.empty(); }
+};
+
+/**
+ * Completion handle passed to an asynchronous RPC handler.
+ *
+ * The handler may return immediately and answer later, from any thread, by
+ * calling respond() or fail() exactly once; further calls are ignored. Copies
+ * share the same invocation. If the last copy is destroyed without an answer,
+ * the caller receives an APPLICATION_ERROR.
+ *
+ * The invocation counts as in flight (for max_concurrency and for shutdown
+ * draining) until it has been answered.
+ */
+class RpcResponder {
+public:
+  RpcResponder() = default;
+
+  /// Send a successful response; std::nullopt sends an empty body.
+  void respond(std::optional<std::string> payload = std::nullopt);
+
+  /// Send `error` to the caller.
+  void fail(const RpcError &error);
+
+  /// True once respond() or fail() has been called on any copy.
+  bool responded() const noexcept;
+
+private:
+  friend class LocalParticipant;
+  struct Completion;
+  explicit RpcResponder(std::shared_ptr<Completion> completion)
+      : completion_(std::move(completion)) {}
+
+  std::shared_ptr<Completion> completion_;
+};
+
+/// Runs one unit of RPC work (a handler invocation plus its response).
+/// Must eventually call the task exactly once, on any thread.
+using RpcExecutor = std::function<void(std::function<void()>)>;
+
+/// One packet of LocalParticipant::publishDataBatch(). The payload is
+/// borrowed and only needs to stay valid for the duration of the call.
+struct DataPacketView {
+  const std::uint8_t *data = nullptr;
+  std::size_t size = 0;
+  std::string topic;
 };
 
 /**
@@ -69,16 +191,36 @@ public:
   using RpcHandler =
       std::function<std::optional<std::string>(const RpcInvocationData &)>;
 
+  /**
+   * Asynchronous RPC handler: answers through `responder` whenever the reply
+   * is ready instead of returning it, so an RPC waiting on another service
+   * does not hold a thread. Throwing before answering behaves like
+   * RpcHandler.
+   */
+  using AsyncRpcHandler =
+      std::function<void(const RpcInvocationData &, RpcResponder)>;
+
   LocalParticipant(FfiHandle handle, std::string sid, std::string name,
                    std::string identity, std::string metadata,
-                   std::unordered_map<std::string, std::string> attributes,
-                   ParticipantKind kind, DisconnectReason reason);
+                   AttributeMap attributes, ParticipantKind kind,
+                   DisconnectReason reason);
+  ~LocalParticipant() override;
 
-  /// Track publications associated with this participant, keyed by track SID.
-  const PublicationMap &trackPublications() const noexcept {
-    return track_publications_;
+  /// Track publications associated with this participant, keyed by track
+  /// SID. Returns a copy; trackPublicationsSnapshot() avoids it.
+  PublicationMap trackPublications() const {
+    return *trackPublicationsSnapshot();
   }
 
+  /// Immutable view of the publications at one point in time. Reading never
+  /// blocks, including while other threads publish or unpublish; those
+  /// install a new map instead of changing this one.
+  std::shared_ptr<const PublicationMap> trackPublicationsSnapshot() const;
+
+  /// The publication of `sid`, or nullptr.
+  std::shared_ptr<LocalTrackPublication>
+  trackPublication(const std::string &sid) const;
+
   /**
    * Publish arbitrary data to the room.
    *
@@ -86,27 +228,148 @@ public:
    * @param reliable               Whether to send reliably or not.
    * @param destination_identities Optional list of participant identities.
    * @param topic                  Optional topic string.
+   * @param priority               Send class of a reliable packet while it
+   *                               waits for the send budget (see
+   *                               DataSendOptions). Ignored for lossy data.
    *
    * Throws std::runtime_error if FFI reports an error (if you wire that up).
    */
   void publishData(const std::vector<std::uint8_t> &payload,
                    bool reliable = true,
+                   const std::vector<std::string> &destination_identities = {},
+                   const std::string &topic = {},
+                   DataPriority priority = DataPriority::kControl);
+
+  /**
+   * publishData() for a payload that is not in a std::vector, e.g. a slice
+   * of a larger buffer. The bytes are copied before this returns.
+   */
+  void publishData(const std::uint8_t *data, std::size_t size,
+                   bool reliable = true,
+                   const std::vector<std::string> &destination_identities = {},
+                   const std::string &topic = {},
+                   DataPriority priority = DataPriority::kControl);
+
+  /**
+   * Fire-and-forget lossy publish for high-rate state (e.g. 60 Hz game
+   * updates). Returns as soon as the FFI has copied the payload; no future
+   * is created and no completion is awaited, so a later send failure is not
+   * reported.
+   */
+  void
+  publishLossyData(const std::uint8_t *data, std::size_t size,
                    const std::vector<std::string> &destination_identities = {},
                    const std::string &topic = {});
 
+  /**
+   * Publish many packets (possibly on different topics) in one call,
+   * amortizing request construction across the batch. Reliable batches
+   * block until every packet is acknowledged and throw the first error;
+   * lossy ones are fire-and-forget like publishLossyData(). Empty packets
+   * are skipped. A reliable batch waits for the send budget as one unit of
+   * its total size, in class `priority`; it is ignored for lossy batches.
+   */
+  void
+  publishDataBatch(const std::vector<DataPacketView> &packets,
+                   bool reliable = false,
+                   const std::vector<std::string> &destination_identities = {},
+                   DataPriority priority = DataPriority::kControl);
+
+  /**
+   * Non-blocking publishData(). The payload is copied before this returns;
+   * the operation completes once the FFI acknowledges the send, which for
+   * a reliable packet over budget includes its time in the send queue.
+   */
+  AsyncOperation<void>
+  publishDataAsync(const std::vector<std::uint8_t> &payload,
+                   bool reliable = true,
+                   const std::vector<std::string> &destination_identities = {},
+                   const std::string &topic = {},
+                   DataPriority priority = DataPriority::kControl);
+
+  /// Replace the reliable send budget (normally set through RoomOptions).
+  /// Packets already waiting are re-evaluated against the new budget.
+  void setDataSendOptions(const DataSendOptions &options);
+
+  /// Current state of the reliable send queue.
+  DataSendStats dataSendStats() const;
+
+  /**
+   * Send a file as one or more byte streams.
+   *
+   * The file is memory-mapped and chunks are sent straight from the mapping
+   * through the pipelined stream writer; pages already sent are released as
+   * the transfer advances, so resident memory stays proportional to the
+   * in-flight window rather than to the file size. With
+   * options.num_streams > 1 the file is striped across that many streams,
+   * which are filled round-robin and tagged with the kStripe* attributes.
+   *
+   * Blocks until every stream has been closed.
+   *
+   * @return Metadata of each stream sent, in stripe order.
+   *
+   * Throws std::runtime_error if the file cannot be mapped or a send fails.
+   */
+  std::vector<ByteStreamInfo> sendFile(const std::string &path,
+                                       const SendFileOptions &options = {});
+
   /**
    * Publish SIP DTMF message.
    */
   void publishDtmf(int code, const std::string &digit);
 
+  /**
+   * Publish transcription segments for `track_sid`, the track whose speech
+   * they transcribe. `participant_identity` is who spoke; empty means this
+   * participant (agents transcribing others pass the speaker's identity).
+   *
+   * Returns without waiting: segments are batched per participant and track
+   * (see TranscriptionOptions), and an update to a segment ID that has not
+   * been sent yet replaces the earlier text. Send failures are logged and
+   * reported by flushTranscriptions().
+   *
+   * Throws std::invalid_argument on an empty track SID or segment ID.
+   */
+  void publishTranscription(const std::string &track_sid,
+                            const std::vector<TranscriptionSegment> &segments,
+                            const std::string &participant_identity = {});
+
+  /**
+   * Send every batched segment now and wait for the FFI to acknowledge all
+   * transcriptions published so far. Throws the first send error since the
+   * previous call.
+   */
+  void flushTranscriptions();
+
+  void setTranscriptionOptions(const TranscriptionOptions &options);
+  TranscriptionStats transcriptionStats() const;
+
   // -------------------------------------------------------------------------
   // Metadata APIs (set metadata / name / attributes)
   // -------------------------------------------------------------------------
 
   void setMetadata(const std::string &metadata);
   void setName(const std::string &name);
-  void
-  setAttributes(const std::unordered_map<std::string, std::string> &attributes);
+
+  /**
+   * Send @p attributes to the server. Keys not listed are left as they are
+   * server-side; prefer updateAttributes() when only a few keys change.
+   */
+  void setAttributes(const AttributeMap &attributes);
+
+  /**
+   * Send only an attribute delta: @p changed keys are added or overwritten
+   * and @p removed keys are deleted. Does nothing if both are empty.
+   *
+   * The participant's local attributes() are updated once the server echoes
+   * the change as a ParticipantAttributesChangedEvent.
+   *
+   * @throws std::invalid_argument if a key is empty, a value in @p changed is
+   *         empty (an empty value is how removal is signalled), or a key
+   *         appears in both lists.
+   */
+  void updateAttributes(const AttributeMap &changed,
+                        const std::vector<std::string> &removed = {});
 
   /**
    * Set track subscription permissions for this participant.
@@ -135,6 +398,27 @@ public:
    */
   void unpublishTrack(const std::string &track_sid);
 
+  /**
+   * Publish several tracks at once.
+   *
+   * All publish requests are issued before waiting on any of them, so the
+   * FFI can negotiate them together instead of one round trip per track.
+   * Returns once every publish has resolved, with one result per entry in
+   * input order; successful publications are cached like publishTrack().
+   * A failed publish does not affect the others.
+   *
+   * @throws std::invalid_argument if any track is null (nothing is sent).
+   * @throws std::runtime_error if the participant handle is invalid.
+   */
+  std::vector<TrackPublishResult> publishTracks(
+      const std::vector<std::pair<std::shared_ptr<Track>, TrackPublishOptions>>
+          &tracks);
+
+  /// Unpublish several tracks at once, like publishTracks(). Returns one
+  /// result per SID in input order; empty SIDs are reported as errors.
+  std::vector<TrackUnpublishResult>
+  unpublishTracks(const std::vector<std::string> &track_sids);
+
   /**
    * Initiate an RPC call to a remote participant.
    *
@@ -156,6 +440,46 @@ public:
                          const std::string &method, const std::string &payload,
                          std::optional<double> response_timeout = std::nullopt);
 
+  /**
+   * Non-blocking performRpc(). The returned operation yields the response
+   * payload, or rethrows the RpcError from get() / co_await.
+   *
+   * Lets one thread keep many RPCs in flight, e.g. from C++20 coroutines:
+   *
+   *   auto a = lp->performRpcAsync("alice", "ping", "");
+   *   auto b = lp->performRpcAsync("bob", "ping", "");
+   *   std::string ra = co_await a;
+   *   std::string rb = co_await b;
+   */
+  AsyncOperation<std::string>
+  performRpcAsync(const std::string &destination_identity,
+                  const std::string &method, const std::string &payload,
+                  std::optional<double> response_timeout = std::nullopt);
+
+  /**
+   * performRpc() with binary and/or compressed payloads. The returned
+   * operation yields the decoded reply.
+   */
+  AsyncOperation<std::string>
+  performRpcAsync(const std::string &destination_identity,
+                  const std::string &method, const std::string &payload,
+                  const RpcCallOptions &options);
+  std::string performRpc(const std::string &destination_identity,
+                         const std::string &method, const std::string &payload,
+                         const RpcCallOptions &options);
+
+  /**
+   * Call `method` with the same payload on every destination concurrently
+   * and wait for all of them. Results are returned in `destinations` order;
+   * a failure on one destination does not affect the others.
+   *
+   * @throws std::runtime_error If the underlying FFI handle is invalid.
+   */
+  std::vector<RpcCallResult>
+  performRpcMany(const std::vector<std::string> &destinations,
+                 const std::string &method, const std::string &payload,
+                 const RpcManyOptions &options = {});
+
   /**
    * Register a handler for an incoming RPC method.
    *
@@ -172,7 +496,30 @@ public:
    * replaced by the new handler.
    */
 
-  void registerRpcMethod(const std::string &method_name, RpcHandler handler);
+  void registerRpcMethod(const std::string &method_name, RpcHandler handler,
+                         const RpcMethodOptions &options = {});
+
+  /**
+   * Register an asynchronous handler for an incoming RPC method. Replaces
+   * any handler, synchronous or not, registered under the same name.
+   */
+  void registerRpcMethodAsync(const std::string &method_name,
+                              AsyncRpcHandler handler,
+                              const RpcMethodOptions &options = {});
+
+  /**
+   * Run RPC handlers on `executor` instead of inline on the Room event
+   * thread, so a slow handler no longer stalls other RPCs and room events.
+   * Pass an empty executor to go back to inline execution (the default).
+   * Replaces any pool set by setRpcWorkerThreads().
+   */
+  void setRpcExecutor(RpcExecutor executor);
+
+  /**
+   * Run RPC handlers on a built-in pool of `threads` workers. 0 returns to
+   * inline execution on the Room event thread.
+   */
+  void setRpcWorkerThreads(std::size_t threads);
 
   /**
    * Unregister a previously registered RPC method handler.
@@ -204,26 +551,85 @@ protected:
                                  const std::string &caller_identity,
                                  const std::string &payload,
                                  double response_timeout);
+  // Called by Room on kDataChannelLowThresholdChanged.
+  void onDataChannelThreshold(DataPacketKind kind, std::uint64_t threshold);
   // Called by Room events like kTrackMuted.
   std::shared_ptr<TrackPublication>
   findTrackPublication(const std::string &sid) const override;
   friend class Room;
+  friend class BaseStreamWriter;
 
 private:
-  PublicationMap track_publications_;
-  std::unordered_map<std::string, RpcHandler> rpc_handlers_;
+  // Reliable publish through the send queue; reports the completion's id.
+  std::future<void>
+  publishReliable(std::uint64_t handle, const std::uint8_t *data,
+                  std::size_t size,
+                  const std::vector<std::string> &destination_identities,
+                  const std::string &topic, DataPriority priority,
+                  std::uint64_t *async_id_out);
+  // One data stream chunk through the send queue, for BaseStreamWriter.
+  std::future<void>
+  sendStreamChunk(const std::string &stream_id, std::uint64_t chunk_index,
+                  const std::uint8_t *data, std::size_t size,
+                  const std::vector<std::string> &destination_identities,
+                  const std::string &sender_identity, DataPriority priority);
+
+  // Copy-on-write, like Room's participant snapshot: readers atomic_load
+  // the current map, writers copy it under publications_write_mutex_ and
+  // atomic_store the result, so readers never wait for a writer.
+  std::shared_ptr<const PublicationMap> track_publications_;
+  std::mutex publications_write_mutex_;
+  void storePublication(std::shared_ptr<LocalTrackPublication> publication);
+  void erasePublication(const std::string &sid);
+
+  struct RpcMethod {
+    AsyncRpcHandler handler; // Synchronous handlers are adapted on register.
+    std::size_t max_concurrency = 0;
+    std::size_t running = 0;
+    // Invocations held back by max_concurrency, oldest first.
+    std::deque<std::function<void()>> waiting;
+  };
 
   // Shared state for RPC invocation tracking. Using shared_ptr so the state
   // can outlive the LocalParticipant if there are in-flight invocations when
-  // the participant is destroyed.
+  // the participant is destroyed. Queued invocations hold it instead of a
+  // pointer to the participant.
   struct RpcInvocationState {
     std::mutex mutex;
     std::condition_variable cv;
     int active_invocations = 0;
     bool shutting_down = false;
+    std::unordered_map<std::string, std::shared_ptr<RpcMethod>> methods;
+    RpcExecutor executor; // Empty: run on the Room event thread.
+    // Calls into a copied executor still in progress; an executor is not
+    // destroyed until these have returned.
+    int dispatching = 0;
   };
   std::shared_ptr<RpcInvocationState> rpc_state_ =
       std::make_shared<RpcInvocationState>();
+  std::unique_ptr<detail::TaskPool> rpc_pool_;
+  // Reliable data backpressure (see DataSendOptions).
+  std::shared_ptr<detail::DataSendQueue> send_queue_;
+  std::unique_ptr<detail::TranscriptionBatcher> transcriptions_;
+
+  static void dispatchRpcTask(const std::shared_ptr<RpcInvocationState> &state,
+                              const RpcExecutor &executor,
+                              std::function<void()> task);
+  static void runRpcInvocation(const std::shared_ptr<RpcInvocationState> &state,
+                               const std::shared_ptr<RpcMethod> &method,
+                               const std::string &method_name,
+                               std::chrono::steady_clock::time_point received,
+                               std::uint64_t participant_handle,
+                               std::uint64_t invocation_id,
+                               const RpcInvocationData &params);
+  // Send the response (unless shutting down) and release the invocation's
+  // concurrency slot, starting the next waiting invocation if any.
+  static void finishRpcInvocation(
+      const std::shared_ptr<RpcInvocationState> &state,
+      const std::shared_ptr<RpcMethod> &method,
+      std::uint64_t participant_handle, std::uint64_t invocation_id,
+      const std::optional<RpcError> &error,
+      const std::optional<std::string> &payload);
 };
 
 } // namespace livekit
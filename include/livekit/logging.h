@@ -0,0 +1,117 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+
+/// Severity of a log record; each level includes the ones above it.
+enum class LogLevel {
+  kOff = -1,
+  kError = 0,
+  kWarn,
+  kInfo,
+  kDebug,
+  kTrace,
+};
+
+/**
+ * One record, as handed to a LogOutput on the logging thread.
+ *
+ * The views stay valid only for the duration of the call. Messages longer
+ * than the queue slot (512 bytes) are truncated.
+ */
+struct LogRecord {
+  LogLevel level = LogLevel::kInfo;
+  /// "livekit::audio", or the Rust module target for FFI records.
+  std::string_view target;
+  std::string_view message;
+  /// Source location, empty / 0 if unknown.
+  std::string_view file;
+  std::uint32_t line = 0;
+  /// True for records emitted by the Rust FFI (LogSink::kCallback).
+  bool from_ffi = false;
+  std::chrono::system_clock::time_point time;
+};
+
+using LogOutput = std::function<void(const LogRecord &)>;
+
+/**
+ * Filtering and queueing for the SDK log pipeline.
+ *
+ * Records are formatted into a fixed-size slot of a lock-free queue by the
+ * thread that logs them and written out by one background thread, so a
+ * media thread never blocks or allocates to log. When the queue is full the
+ * record is dropped and counted.
+ */
+struct LogOptions {
+  /// Records above this level are discarded where they are produced.
+  LogLevel level = LogLevel::kInfo;
+
+  /// Per-target overrides: the longest matching prefix of a record's target
+  /// decides, e.g. {"livekit::rtc_engine", LogLevel::kDebug}.
+  std::vector<std::pair<std::string, LogLevel>> targets;
+
+  /// Queue slots (rounded up to a power of two), allocated up front.
+  std::size_t queue_capacity = 1024;
+
+  /// Write records to stderr in addition to any addLogOutput() outputs.
+  bool console = true;
+
+  /// With LogSink::kCallback, also hand the level and targets to the Rust
+  /// logger through RUST_LOG (unless the environment already sets it), so
+  /// filtered records are never serialized by the FFI.
+  bool push_down_to_ffi = true;
+};
+
+struct LogStats {
+  std::uint64_t written = 0;
+  /// Queue was full.
+  std::uint64_t dropped = 0;
+  /// Passed the level check but not the target overrides.
+  std::uint64_t filtered = 0;
+};
+
+/// Replace the current log configuration. Also applied by
+/// initialize(const InitializeOptions &) from InitializeOptions::logging.
+void configureLogging(const LogOptions &options);
+
+/// Change only the global level.
+void setLogLevel(LogLevel level);
+LogLevel logLevel();
+
+/// Register an output, called on the logging thread for every record that
+/// passes the filters. Returns an id for removeLogOutput().
+int addLogOutput(LogOutput output);
+/// Once this returns the output is not called again (unless it is called
+/// from an output, on the logging thread).
+void removeLogOutput(int id);
+
+/// Block until every record queued so far has been written.
+void flushLogs();
+
+LogStats logStats();
+
+} // namespace livekit
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "latency_snapshot.h"
+
+namespace livekit {
+
+namespace detail {
+class LatencyHistogram;
+} // namespace detail
+
+/// Tick counters for a MediaClock::Pacer or a FramePacer.
+struct PacerStats {
+  /// Ticks delivered.
+  std::uint64_t ticks = 0;
+  /// Ticks skipped because the pacer fell too far behind (see
+  /// MediaClock::PacerOptions::skip_missed).
+  std::uint64_t missed_ticks = 0;
+  /// How long after its deadline each tick actually ran.
+  LatencySnapshot lateness;
+};
+
+/**
+ * One timer thread that drives many periodic capture callbacks.
+ *
+ * Each pacer's tick n is due at start + n * period, an absolute deadline,
+ * so sleeping late never pushes later ticks back and pacers do not drift.
+ * All pacers of a clock share its thread, so hundreds of synthetic sources
+ * cost one thread instead of one each. Callbacks run on that thread and
+ * must not block: use AudioSource::pushFrame() and
+ * VideoSource::captureFrameAsync() rather than the blocking captures.
+ *
+ * @code
+ * auto pacer = MediaClock::shared().schedule(
+ *     std::chrono::milliseconds(10), [&](std::uint64_t tick) {
+ *       source->pushFrame(nextFrame(tick));
+ *     });
+ * // ...
+ * pacer.stop();
+ * @endcode
+ */
+class MediaClock {
+public:
+  using TickCallback = std::function<void(std::uint64_t tick)>;
+
+  struct PacerOptions {
+    /// Behind by more than a period, skip the missed ticks (suits video)
+    /// instead of running them back to back so no audio is lost. Either
+    /// way, ticks more than 200 ms late are skipped.
+    bool skip_missed{false};
+  };
+
+  /// Handle to a scheduled callback; destroying it stops the callback.
+  class Pacer {
+  public:
+    Pacer() = default;
+    ~Pacer();
+    Pacer(Pacer &&) noexcept = default;
+    Pacer &operator=(Pacer &&other) noexcept;
+    Pacer(const Pacer &) = delete;
+    Pacer &operator=(const Pacer &) = delete;
+
+    /// Stop ticking. Called from another thread, waits for a running
+    /// callback to return, so whatever it captured may be destroyed right
+    /// after. Safe to call from the callback itself. Idempotent; stats()
+    /// stay available.
+    void stop();
+
+    bool active() const noexcept;
+    PacerStats stats() const;
+
+  private:
+    friend class MediaClock;
+    struct Entry;
+    std::shared_ptr<Entry> entry_;
+  };
+
+  MediaClock();
+  /// Stops the thread; remaining pacers become inactive.
+  ~MediaClock();
+
+  MediaClock(const MediaClock &) = delete;
+  MediaClock &operator=(const MediaClock &) = delete;
+
+  /// Process-wide clock, started on first use.
+  static MediaClock &shared();
+
+  /// Run `callback` every `period`, first right away. Throws
+  /// std::invalid_argument if the period is not positive.
+  Pacer schedule(std::chrono::nanoseconds period, TickCallback callback);
+  Pacer schedule(std::chrono::nanoseconds period, TickCallback callback,
+                 const PacerOptions &options);
+
+  /// Pacers scheduled and not yet stopped.
+  std::size_t activePacers() const;
+
+  /// Period of one frame at `fps`, e.g. for schedule().
+  static std::chrono::nanoseconds framePeriod(double fps);
+
+private:
+  struct Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+/**
+ * Absolute-deadline pacing for a loop that owns its thread, in place of
+ * sleep_for()/sleep_until() bookkeeping:
+ *
+ * @code
+ * FramePacer pacer(MediaClock::framePeriod(30));
+ * while (running) {
+ *   source->captureFrame(frame);
+ *   pacer.wait();
+ * }
+ * @endcode
+ */
+class FramePacer {
+public:
+  /// Tick 0 is now. Throws std::invalid_argument if the period is not
+  /// positive.
+  explicit FramePacer(std::chrono::nanoseconds period,
+                      bool skip_missed = false);
+  ~FramePacer();
+
+  FramePacer(const FramePacer &) = delete;
+  FramePacer &operator=(const FramePacer &) = delete;
+
+  /// Sleep until the next tick's deadline and return its index. Returns
+  /// right away if it is overdue.
+  std::uint64_t wait();
+
+  /// Restart at tick 0 now, e.g. after a pause.
+  void reset();
+
+  std::chrono::nanoseconds period() const noexcept { return period_; }
+  PacerStats stats() const;
+
+private:
+  const std::chrono::nanoseconds period_;
+  const bool skip_missed_;
+  std::chrono::steady_clock::time_point start_;
+  std::uint64_t tick_{0};
+  std::uint64_t ticks_{0};
+  std::uint64_t missed_{0};
+  std::unique_ptr<detail::LatencyHistogram> lateness_;
+};
+
+} // namespace livekit
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "audio_stream.h"
+#include "video_stream.h"
+
+namespace livekit {
+
+class AudioFrame;
+class AudioFrameView;
+class Track;
+class VideoFrame;
+
+/**
+ * Counters for one AudioRecorder or VideoRecorder, see their stats().
+ *
+ * While recording, pushed = frames_written + frames_dropped + queue_depth
+ * (VideoRecorder frames superseded by a newer one within the same frame
+ * slot are not counted as either).
+ */
+struct MediaRecorderStats {
+  /// Frames that made it into the file.
+  std::uint64_t frames_written = 0;
+  /// Frames refused by a full queue or a closed recorder, or that could not
+  /// be written (format change, failed conversion).
+  std::uint64_t frames_dropped = 0;
+  /// Bytes handed to the OS so far.
+  std::uint64_t bytes_written = 0;
+  /// Failed writes. After the first one the rest of the recording is
+  /// discarded.
+  std::uint64_t write_errors = 0;
+  std::size_t queue_depth = 0;
+  std::size_t max_queue_depth = 0;
+};
+
+/**
+ * Records decoded audio to a 16-bit PCM WAV file without blocking the
+ * thread that delivers the frames.
+ *
+ * push() only moves the frame (for stream callbacks, a view over the
+ * native buffer) into a bounded queue; a dedicated I/O thread copies the
+ * samples into a large page-aligned buffer and writes it out in whole
+ * buffers. A full queue drops the newest frame and counts it, so a stalled
+ * disk never back-pressures the FFI callback thread. The WAV header takes
+ * its format from the first frame and its sizes are filled in by close().
+ *
+ * @code
+ * AudioRecorder recorder("alice.wav");
+ * auto stream = recorder.attach(remoteAudioTrack);
+ * // ...
+ * stream->close();
+ * recorder.close();
+ * @endcode
+ */
+class AudioRecorder {
+public:
+  struct Options {
+    /// Frames waiting for the I/O thread; 500 is 5 s of 10 ms frames.
+    std::size_t queue_frames{500};
+    /// Size of each write to the file.
+    std::size_t write_buffer_bytes{1 << 20};
+  };
+
+  /// Creates or truncates `path`. Throws std::runtime_error if it cannot be
+  /// opened.
+  explicit AudioRecorder(const std::string &path);
+  AudioRecorder(const std::string &path, const Options &options);
+  /// Calls close().
+  ~AudioRecorder();
+
+  AudioRecorder(const AudioRecorder &) = delete;
+  AudioRecorder &operator=(const AudioRecorder &) = delete;
+
+  /// Push-mode stream options feeding this recorder; the stream's end stops
+  /// taking frames. Other fields may be adjusted before opening the stream.
+  AudioStream::Options streamOptions() const;
+
+  /// AudioStream::fromTrack(track, streamOptions()).
+  std::shared_ptr<AudioStream> attach(const std::shared_ptr<Track> &track);
+
+  /**
+   * Queue a frame. Never blocks; returns false if it was dropped. Only one
+   * thread may push at a time (stream callbacks already satisfy this).
+   */
+  bool push(AudioFrameView &&frame);
+  bool push(AudioFrame &&frame);
+
+  /// Write out everything queued, finish the header and close the file.
+  /// Frames pushed afterwards are dropped. Idempotent.
+  void close();
+
+  MediaRecorderStats stats() const;
+
+private:
+  struct Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+/**
+ * Records decoded video to an uncompressed YUV4MPEG2 (.y4m) file without
+ * blocking the thread that delivers the frames.
+ *
+ * Works like AudioRecorder: push() moves the frame (native buffers are kept,
+ * not copied) into a bounded queue, and the I/O thread converts it to I420,
+ * scales it to the output size if needed and writes it through a large
+ * page-aligned buffer. Native buffers are released as soon as they have
+ * been copied, so at most queue_frames of them are ever held.
+ *
+ * Y4M has a fixed size and frame rate. By default frames are placed by
+ * timestamp on the Options::fps grid: a frame is repeated to fill gaps and
+ * superseded when a newer one lands in the same slot, so the file plays
+ * back in real time. Gaps longer than 10 s are not filled.
+ */
+class VideoRecorder {
+public:
+  struct Options {
+    std::size_t queue_frames{30};
+    std::size_t write_buffer_bytes{8 << 20};
+    /// Output size; 0 takes the first frame's size. Frames of another size
+    /// are scaled.
+    int width{0};
+    int height{0};
+    /// Frame rate written to the header.
+    int fps{30};
+    /// Place frames by timestamp (see above) rather than writing each one
+    /// once in arrival order.
+    bool constant_frame_rate{true};
+  };
+
+  /// Creates or truncates `path`. Throws std::runtime_error if it cannot be
+  /// opened, std::invalid_argument on a bad size or frame rate.
+  explicit VideoRecorder(const std::string &path);
+  VideoRecorder(const std::string &path, const Options &options);
+  /// Calls close().
+  ~VideoRecorder();
+
+  VideoRecorder(const VideoRecorder &) = delete;
+  VideoRecorder &operator=(const VideoRecorder &) = delete;
+
+  /// Push-mode, zero-copy I420 stream options feeding this recorder; the
+  /// stream's end stops taking frames.
+  VideoStream::Options streamOptions() const;
+
+  /// VideoStream::fromTrack(track, streamOptions()).
+  std::shared_ptr<VideoStream> attach(const std::shared_ptr<Track> &track);
+
+  /// Queue a frame. Never blocks; returns false if it was dropped. Only one
+  /// thread may push at a time.
+  bool push(VideoFrameEvent &&event);
+  bool push(VideoFrame &&frame, std::int64_t timestamp_us);
+
+  /// Write out everything queued and close the file. Idempotent.
+  void close();
+
+  MediaRecorderStats stats() const;
+
+private:
+  struct Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+} // namespace livekit
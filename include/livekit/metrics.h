@@ -0,0 +1,47 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace livekit {
+
+/**
+ * Turn collection of the SDK's internal metrics on or off (default: off).
+ *
+ * Covers stream queue depth and drops, FFI request counts and latency,
+ * data-stream throughput, and the live handle counts behind
+ * resourceSnapshot() (see resources.h). While disabled, each instrumented site costs one
+ * relaxed atomic load. Stream queue gauges are only exact for streams
+ * created after metrics were enabled. RPC metrics (see rpc_metrics.h) follow
+ * the same switch.
+ */
+void setMetricsEnabled(bool enabled);
+bool metricsEnabled();
+
+/**
+ * Render all SDK metrics in the OpenMetrics text format, terminated by
+ * "# EOF", e.g. to serve from a Prometheus scrape endpoint. Pending async
+ * operations and FFI listeners are sampled at call time.
+ */
+std::string metricsToOpenMetrics();
+
+/// Clear the counters behind metricsToOpenMetrics(), including RPC metrics.
+/// Queue-depth gauges are left alone since they mirror live streams.
+void resetMetrics();
+
+} // namespace livekit
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "livekit/video_frame.h"
+
+namespace livekit {
+
+/// Where the pixels of a NativeVideoBuffer live.
+enum class NativeBufferKind {
+  kDmaBuf,        ///< Linux DMA-BUF; handle is the file descriptor.
+  kCudaDevicePtr, ///< CUDA device memory; handle is the CUdeviceptr.
+  kCVPixelBuffer, ///< Apple CVPixelBufferRef.
+  kD3D11Texture,  ///< ID3D11Texture2D pointer.
+};
+
+/// Position of one plane inside a NativeVideoBuffer's memory.
+struct NativeVideoPlane {
+  std::uint64_t offset = 0; ///< Bytes from the start of the buffer.
+  std::uint32_t stride = 0; ///< Bytes per row, padding included.
+};
+
+/**
+ * A frame held in GPU or hardware-codec memory, described by handle rather
+ * than by CPU pointer. Pass it to VideoSource::captureNativeFrame().
+ *
+ * The handle is borrowed: the SDK never closes or frees it, and calls
+ * `release` once it no longer touches the memory.
+ */
+struct NativeVideoBuffer {
+  NativeBufferKind kind = NativeBufferKind::kDmaBuf;
+  std::uintptr_t handle = 0;
+  int width = 0;
+  int height = 0;
+  /// Pixel layout of the memory, e.g. NV12 from a hardware decoder.
+  VideoBufferType layout = VideoBufferType::NV12;
+  /// Planes in VideoFrame::planeInfos() order.
+  std::vector<NativeVideoPlane> planes;
+  /// Bytes behind the handle; for DMA-BUF, 0 means "ask the fd".
+  std::size_t size = 0;
+  std::function<void()> release;
+};
+
+/**
+ * Turns a NativeVideoBuffer into a frame the FFI can read, ideally without
+ * a copy (e.g. VideoFrame::wrapExternal() over a mapping whose release
+ * unmaps it and then calls buffer.release). Throws to reject the buffer.
+ */
+using NativeBufferMapper = std::function<VideoFrame(NativeVideoBuffer &&)>;
+
+} // namespace livekit
@@ -21,6 +21,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "livekit/attribute_map.h"
 #include "livekit/ffi_handle.h"
 #include "livekit/room_delegate.h"
 
@@ -32,8 +33,8 @@ class Participant {
 public:
   Participant(FfiHandle handle, std::string sid, std::string name,
               std::string identity, std::string metadata,
-              std::unordered_map<std::string, std::string> attributes,
-              ParticipantKind kind, DisconnectReason reason)
+              AttributeMap attributes, ParticipantKind kind,
+              DisconnectReason reason)
       : handle_(std::move(handle)), sid_(std::move(sid)),
         name_(std::move(name)), identity_(std::move(identity)),
         metadata_(std::move(metadata)), attributes_(std::move(attributes)),
@@ -45,9 +46,11 @@ public:
   const std::string &name() const noexcept { return name_; }
   const std::string &identity() const noexcept { return identity_; }
   const std::string &metadata() const noexcept { return metadata_; }
-  const std::unordered_map<std::string, std::string> &
-  attributes() const noexcept {
-    return attributes_;
+  const AttributeMap &attributes() const noexcept { return attributes_; }
+  // Copy of attributes() in the node-based map it returned before
+  // AttributeMap, e.g. for callers that modify it or use operator[].
+  std::unordered_map<std::string, std::string> attributesMap() const {
+    return attributes_.toUnorderedMap();
   }
   ParticipantKind kind() const noexcept { return kind_; }
   DisconnectReason disconnectReason() const noexcept { return reason_; }
@@ -59,12 +62,11 @@ public:
   void set_metadata(std::string metadata) noexcept {
     metadata_ = std::move(metadata);
   }
-  void
-  set_attributes(std::unordered_map<std::string, std::string> attrs) noexcept {
+  void set_attributes(AttributeMap attrs) noexcept {
     attributes_ = std::move(attrs);
   }
   void set_attribute(const std::string &key, const std::string &value) {
-    attributes_[key] = value;
+    attributes_.set(key, value);
   }
   void remove_attribute(const std::string &key) { attributes_.erase(key); }
   void set_kind(ParticipantKind kind) noexcept { kind_ = kind; }
@@ -80,7 +82,7 @@ protected:
 private:
   FfiHandle handle_;
   std::string sid_, name_, identity_, metadata_;
-  std::unordered_map<std::string, std::string> attributes_;
+  AttributeMap attributes_;
   ParticipantKind kind_;
   DisconnectReason reason_;
 };
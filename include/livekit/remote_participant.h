@@ -19,6 +19,7 @@
 #include "participant.h"
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -33,18 +34,23 @@ public:
 
   RemoteParticipant(FfiHandle handle, std::string sid, std::string name,
                     std::string identity, std::string metadata,
-                    std::unordered_map<std::string, std::string> attributes,
-                    ParticipantKind kind, DisconnectReason reason);
+                    AttributeMap attributes, ParticipantKind kind,
+                    DisconnectReason reason);
 
-  // A dictionary of track publications associated with the participant.
-  const PublicationMap &trackPublications() const noexcept {
-    return track_publications_;
+  /// Track publications associated with this participant, keyed by track
+  /// SID. Returns a copy; trackPublicationsSnapshot() avoids it.
+  PublicationMap trackPublications() const {
+    return *trackPublicationsSnapshot();
   }
 
-  // Optional: non-const access if you want to mutate in-place.
-  PublicationMap &mutableTrackPublications() noexcept {
-    return track_publications_;
-  }
+  /// Immutable view of the publications at one point in time. Safe to
+  /// iterate while Room applies track events; those install a new map
+  /// instead of changing this one.
+  std::shared_ptr<const PublicationMap> trackPublicationsSnapshot() const;
+
+  /// The publication of `sid`, or nullptr.
+  std::shared_ptr<RemoteTrackPublication>
+  trackPublication(const std::string &sid) const;
 
   std::string to_string() const;
 
@@ -56,7 +62,13 @@ protected:
   friend class Room;
 
 private:
-  PublicationMap track_publications_;
+  // Copy-on-write, like LocalParticipant: readers atomic_load the current
+  // map, Room copies it under publications_write_mutex_ and atomic_stores
+  // the result.
+  std::shared_ptr<const PublicationMap> track_publications_;
+  std::mutex publications_write_mutex_;
+  void storePublication(std::shared_ptr<RemoteTrackPublication> publication);
+  void erasePublication(const std::string &sid);
 };
 
 // Convenience for logging / streaming
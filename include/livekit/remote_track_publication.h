@@ -26,6 +26,13 @@ class OwnedTrackPublication;
 
 class Track;
 
+/// Simulcast layer preference for a remote video track.
+enum class VideoQuality {
+  QUALITY_LOW = 0,
+  QUALITY_MEDIUM = 1,
+  QUALITY_HIGH = 2,
+};
+
 class RemoteTrackPublication : public TrackPublication {
 public:
   /// Note, this RemoteTrackPublication is constructed internally only;
@@ -39,8 +46,38 @@ public:
 
   void setSubscribed(bool subscribed);
 
+  /// False once setEnabled(false) paused delivery of this track.
+  bool enabled() const noexcept { return enabled_; }
+
+  /**
+   * Pause (false) or resume (true) media for this track without
+   * unsubscribing, e.g. for a tile scrolled off screen. While paused the
+   * server forwards no packets, so nothing is downloaded or decoded.
+   *
+   * Throws std::runtime_error if the publication has no FFI handle.
+   */
+  void setEnabled(bool enabled);
+
+  /**
+   * Tell the server the size this video is rendered at, so it forwards the
+   * smallest simulcast layer that covers it instead of full resolution.
+   *
+   * Throws std::runtime_error if the publication has no FFI handle.
+   */
+  void setVideoDimensions(std::uint32_t width, std::uint32_t height);
+
+  /**
+   * Prefer a simulcast layer. The FFI selects layers by size, so this asks
+   * for a quarter (low), half (medium) or all (high) of the published
+   * resolution via setVideoDimensions().
+   */
+  void setVideoQuality(VideoQuality quality);
+
 private:
+  void requireHandle(const char *what) const;
+
   bool subscribed_{false};
+  bool enabled_{true};
 };
 
 } // namespace livekit
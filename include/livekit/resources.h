@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace livekit {
+
+/// What an FfiHandle refers to, for resourceSnapshot().
+enum class ResourceKind : std::uint8_t {
+  kOther = 0, ///< Untagged, e.g. transient FFI response buffers.
+  kRoom,
+  kParticipant,
+  kTrack,
+  kTrackPublication,
+  kAudioSource,
+  kVideoSource,
+  kAudioStream,
+  kVideoStream,
+  kAudioBuffer, ///< Rust-owned PCM buffer (AudioFrameView).
+  kVideoBuffer, ///< Rust-owned video buffer (native VideoFrame).
+  kDataBuffer,  ///< Rust-owned data packet payload.
+  kAudioProcessor,
+};
+
+constexpr std::size_t kResourceKindCount =
+    static_cast<std::size_t>(ResourceKind::kAudioProcessor) + 1;
+
+/// Stable lower-case name, e.g. "video_buffer".
+const char *resourceKindName(ResourceKind kind) noexcept;
+
+/**
+ * Live SDK resources at one point in time, for leak and bloat detection in
+ * soak tests.
+ *
+ * Collected only while metrics are enabled (see setMetricsEnabled()): a
+ * handle is counted if it was created while enabled, and stays counted
+ * until it is dropped even if metrics are switched off in between. Compare
+ * two snapshots taken with metrics enabled throughout.
+ */
+struct ResourceSnapshot {
+  /// Live FfiHandles by ResourceKind. A handle passed to the deferred
+  /// disposal queue no longer counts.
+  std::array<std::int64_t, kResourceKindCount> live_handles{};
+
+  /// Bytes of frames waiting in AudioStream / VideoStream queues, estimated
+  /// from the size of each stream's most recent frame.
+  std::int64_t audio_stream_bytes = 0;
+  std::int64_t video_stream_bytes = 0;
+
+  /// Bytes buffered in memory by TextStreamReader / ByteStreamReader and
+  /// stream callbacks awaiting delivery. Counted whether or not metrics are
+  /// enabled.
+  std::int64_t stream_reader_bytes = 0;
+
+  std::int64_t handles(ResourceKind kind) const noexcept {
+    return live_handles[static_cast<std::size_t>(kind)];
+  }
+  std::int64_t totalHandles() const noexcept {
+    std::int64_t total = 0;
+    for (std::int64_t n : live_handles) {
+      total += n;
+    }
+    return total;
+  }
+  std::int64_t totalBytes() const noexcept {
+    return audio_stream_bytes + video_stream_bytes + stream_reader_bytes;
+  }
+};
+
+/// Sample the live handle and queued byte counts.
+ResourceSnapshot resourceSnapshot();
+
+} // namespace livekit
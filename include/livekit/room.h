@@ -17,26 +17,48 @@
 #ifndef LIVEKIT_ROOM_H
 #define LIVEKIT_ROOM_H
 
+#include "livekit/async_operation.h"
 #include "livekit/data_stream.h"
 #include "livekit/e2ee.h"
 #include "livekit/ffi_handle.h"
 #include "livekit/room_event_types.h"
+#include "livekit/stats.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace livekit {
 
 class RoomDelegate;
 struct RoomInfoData;
 namespace proto {
+class ConnectCallback;
 class FfiEvent;
-}
+} // namespace proto
+namespace detail {
+struct EventReplayAccess;
+class CompactParticipantStore;
+class StreamDispatcher;
+} // namespace detail
 
 struct E2EEOptions;
 class E2EEManager;
 class LocalParticipant;
 class RemoteParticipant;
 
+/* Callback for user data packets on one topic; see
+ * Room::registerDataPacketHandler(). */
+using DataPacketHandler = std::function<void(const UserDataPacketView &)>;
+
 // Represents a single ICE server configuration.
 struct IceServer {
   // TURN/STUN server URL (e.g. "stun:stun.l.google.com:19302").
@@ -78,6 +100,94 @@ struct RoomOptions {
 
   // Optional end-to-end encryption settings.
   std::optional<E2EEOptions> encryption;
+
+  // Memory limits and overflow policy for incoming text/byte streams.
+  StreamBufferOptions stream_buffer;
+
+  // Send budget and priority queue for outgoing reliable data.
+  DataSendOptions data_send;
+
+  // Tune the connection for quick recovery from network blips. ICE keeps
+  // gathering candidates for the whole session, so after a network change
+  // the resume can switch to an already checked candidate pair instead of
+  // gathering from scratch. The rtc_config of the last successful connect
+  // to a URL is kept per process and reused by later fast_resume connects
+  // to that URL that do not pass one. See Room::reconnectStats().
+  bool fast_resume = false;
+
+  // For very large rooms (webinars with thousands of listeners): remote
+  // participants are kept as compact records with pooled strings, and a
+  // RemoteParticipant is created only when one is asked for by identity, or
+  // when the participant publishes a track or is the subject of another
+  // participant event. Until then:
+  //   - ParticipantConnected/DisconnectedEvent carry only `identity`
+  //     (`participant` is nullptr); call Room::remoteParticipant() to get
+  //     the full object.
+  //   - remoteParticipants() and remoteParticipantsSnapshot() list only
+  //     materialized participants; remoteParticipantCount() counts all.
+  //   - ParticipantsUpdatedEvent and ConnectionQualityChangedEvent are not
+  //     raised for them.
+  bool lazy_participants = false;
+};
+
+/// Reconnect history of one Room since its last connect, see
+/// Room::reconnectStats(). A reconnect starts with ReconnectingEvent and ends
+/// with ReconnectedEvent, or with a disconnect when it fails.
+struct ReconnectStats {
+  std::uint64_t attempts = 0;
+  std::uint64_t completed = 0;
+  std::uint64_t failed = 0;
+  /// Duration of the most recent completed reconnect.
+  std::chrono::microseconds last{0};
+  std::chrono::microseconds longest{0};
+  /// Time spent reconnecting, completed and failed attempts together.
+  std::chrono::microseconds total{0};
+  /// True while an attempt is in progress.
+  bool reconnecting = false;
+};
+
+/// Where one connect attempt spent its time, on the steady clock. See
+/// Room::connectAsync().
+struct ConnectTiming {
+  /// Building and sending the FFI connect request.
+  std::chrono::microseconds request{0};
+  /// Request sent until the FFI reported the room joined: the signal
+  /// WebSocket, the join response, ICE gathering and the DTLS handshake of
+  /// the primary transport. The FFI reports these as a single step, so they
+  /// cannot be split further from the SDK.
+  std::chrono::microseconds join{0};
+  /// Building participants and publications from the join response and
+  /// installing the room's event listeners.
+  std::chrono::microseconds setup{0};
+  /// request + join + setup.
+  std::chrono::microseconds total{0};
+  /// connectAsync() until the first remote track was subscribed. Usually
+  /// later than the connect itself, so only Room::connectTiming() has it.
+  std::optional<std::chrono::microseconds> first_track_subscribed;
+};
+
+/// Outcome of Room::connectAsync().
+struct ConnectResult {
+  bool connected = false;
+  /// Why the attempt failed; empty on success.
+  std::string error;
+  ConnectTiming timing;
+};
+
+/// Immutable view of a room's remote participants at one point in time, see
+/// Room::remoteParticipantsSnapshot(). Holding it keeps the listed
+/// participants alive; later joins and leaves publish a new snapshot instead
+/// of changing this one.
+struct RemoteParticipantSnapshot {
+  /// In no particular order.
+  std::vector<std::shared_ptr<RemoteParticipant>> participants;
+  std::unordered_map<std::string, std::shared_ptr<RemoteParticipant>>
+      by_identity;
+  /// Bumped each time the room publishes a new snapshot.
+  std::uint64_t version = 0;
+
+  /// nullptr if no participant with `identity` is in this snapshot.
+  RemoteParticipant *find(const std::string &identity) const;
 };
 
 /// Represents a LiveKit room session.
@@ -126,6 +236,29 @@ public:
   bool Connect(const std::string &url, const std::string &token,
                const RoomOptions &options);
 
+  /**
+   * Non-blocking Connect(). The room is fully set up (participants,
+   * listeners, E2EE) before the operation completes, so a continuation can
+   * use it right away; that setup runs on the FFI event thread. Failures are
+   * reported in the result rather than thrown. Connect() is
+   * connectAsync().get().
+   *
+   * Many rooms can be joined in parallel this way. A Room must not be
+   * destroyed while its connect is in flight; ~Room waits for it.
+   *
+   * @throws std::runtime_error if the room is connected or connecting.
+   */
+  AsyncOperation<ConnectResult> connectAsync(const std::string &url,
+                                             const std::string &token,
+                                             const RoomOptions &options);
+
+  /// Timing of the latest connect attempt, including first_track_subscribed
+  /// once a remote track has been subscribed.
+  ConnectTiming connectTiming() const;
+
+  /// Reconnects since the latest connect, see ReconnectStats.
+  ReconnectStats reconnectStats() const;
+
   // Accessors
 
   /* Retrieve static metadata about the room.
@@ -154,7 +287,9 @@ public:
    * Parameters:
    *   identity — The participant’s identity string (not SID)
    * Return value:
-   *   Pointer to RemoteParticipant if present, otherwise nullptr.
+   *   Pointer to RemoteParticipant if present, otherwise nullptr. With
+   *   RoomOptions::lazy_participants this materializes a compact
+   *   participant on first use.
    * RemoteParticipant contains:
    *   - identity/name/metadata
    *   - track publications
@@ -165,6 +300,17 @@ public:
   /// Returns a snapshot of all current remote participants.
   std::vector<std::shared_ptr<RemoteParticipant>> remoteParticipants() const;
 
+  /// Number of remote participants in the room, including those not yet
+  /// materialized under RoomOptions::lazy_participants.
+  std::size_t remoteParticipantCount() const;
+
+  /// The current participant set as an immutable snapshot. Does not take the
+  /// room lock or copy anything, so it is cheap to call at frame rate; compare
+  /// `version` to detect changes. remoteParticipant() and
+  /// remoteParticipants() read from the same snapshot.
+  std::shared_ptr<const RemoteParticipantSnapshot>
+  remoteParticipantsSnapshot() const;
+
   /* Register a handler for incoming text streams on a specific topic.
    *
    * When a remote participant opens a text stream with the given topic,
@@ -218,6 +364,91 @@ public:
    */
   void unregisterByteStreamHandler(const std::string &topic);
 
+  /* Register callbacks for incoming text streams on a specific topic.
+   *
+   * Unlike registerTextStreamHandler(), no reader or blocking thread is
+   * involved: `handler` runs when a stream opens and returns the
+   * TextStreamCallbacks that receive its chunks and its end. All three run
+   * on the stream executor (see setStreamCallbackExecutor()), in stream
+   * order, so many concurrent streams are served by a few threads.
+   * Chunks waiting for their callback count against
+   * RoomOptions::stream_buffer.
+   *
+   * Throws:
+   *   std::runtime_error if a handler or callbacks are already registered
+   *   for the topic.
+   */
+  void registerTextStreamCallbacks(const std::string &topic,
+                                   TextStreamOpenHandler handler);
+
+  /* Unregister text stream callbacks for the given topic. Streams already
+   * open keep their callbacks. No-op if none are registered.
+   */
+  void unregisterTextStreamCallbacks(const std::string &topic);
+
+  /* Byte stream counterpart of registerTextStreamCallbacks(). */
+  void registerByteStreamCallbacks(const std::string &topic,
+                                   ByteStreamOpenHandler handler);
+
+  /* Unregister byte stream callbacks for the given topic. */
+  void unregisterByteStreamCallbacks(const std::string &topic);
+
+  /* Run stream callbacks on `executor` instead of inline on the Room event
+   * thread. Calls for one stream still never overlap. Pass an empty
+   * executor to go back to inline execution (the default). Replaces any
+   * pool set by setStreamCallbackThreads(). Must not be called from a
+   * stream callback.
+   */
+  void setStreamCallbackExecutor(StreamExecutor executor);
+
+  /* Run stream callbacks on a built-in pool of `threads` workers. 0 returns
+   * to inline execution on the Room event thread.
+   */
+  void setStreamCallbackThreads(std::size_t threads);
+
+  /* Register a handler for user data packets on a specific topic.
+   *
+   * The handler receives a borrowed UserDataPacketView, so no copy of the
+   * payload is made. Lookup is a single hash probe per packet.
+   *
+   * Notes:
+   *   - Only one handler may be registered per topic ("" is a valid topic).
+   *   - While at least one handler is registered, packets are routed by
+   *     topic only: those without a matching handler are dropped before
+   *     any copy is made, and RoomDelegate::onUserPacketReceived is not
+   *     called. With no handlers registered, every packet goes to the
+   *     delegate as before.
+   *   - The handler runs on the Room event thread and must not block.
+   *
+   * Throws:
+   *   std::runtime_error if a handler is already registered for the topic.
+   */
+  void registerDataPacketHandler(const std::string &topic,
+                                 DataPacketHandler handler);
+
+  /* Unregister the data packet handler for the given topic.
+   *
+   * If no handler exists for the topic, this function is a no-op.
+   */
+  void unregisterDataPacketHandler(const std::string &topic);
+
+  /* Snapshot of the memory held by this room's incoming stream readers and
+   * of how often RoomOptions::stream_buffer limits kicked in. All zero
+   * before the first Connect().
+   */
+  StreamBufferStats streamBufferStats() const;
+
+  /**
+   * Publisher and subscriber transport stats in one FFI round trip,
+   * independent of the number of tracks. By default only peer-connection,
+   * transport and candidate-pair stats are converted; pass a wider mask to
+   * receive more (extra types land in PeerConnectionSessionStats::other).
+   *
+   * @throws std::runtime_error if the room is not connected.
+   */
+  AsyncOperation<SessionStats>
+  getSessionStatsAsync(RtcStatsTypeMask types = kSessionStatsTypes) const;
+
   /**
    * Returns the room's E2EE manager, or nullptr if E2EE was not enabled at
    * connect time.
@@ -229,28 +460,102 @@ public:
   E2EEManager *e2eeManager() const;
 
 private:
+  // State is split by concern so busy data streams, participant events and
+  // app-thread API calls do not serialize on one mutex. No two of these
+  // locks are ever held at the same time.
+
+  // Connection state, room info and handle, E2EE, listener IDs.
   mutable std::mutex lock_;
   ConnectionState connection_state_ = ConnectionState::Disconnected;
-  RoomDelegate *delegate_ = nullptr; // Not owned
   RoomInfoData room_info_;
   std::shared_ptr<FfiHandle> room_handle_;
+  // room_handle_->get() (0 when disconnected), checked on every event.
+  std::atomic<std::uint64_t> room_handle_id_{0};
+  // E2EE
+  std::unique_ptr<E2EEManager> e2ee_manager_;
+  // Latest connect attempt; connect_started_ anchors first_track_subscribed.
+  ConnectTiming connect_timing_;
+  std::chrono::steady_clock::time_point connect_started_;
+  // Set by a successful connect, cleared by the first TrackSubscribed.
+  std::atomic<bool> first_track_pending_{false};
+  // When connectAsync() finished sending the request, as steady-clock
+  // nanoseconds since epoch; 0 until then (the callback may win the race).
+  std::atomic<std::int64_t> connect_sent_ns_{0};
+  // Reset by each connect; reconnect_started_ is set while reconnecting.
+  ReconnectStats reconnect_stats_;
+  std::chrono::steady_clock::time_point reconnect_started_;
+
+  // A connectAsync() completion runs on the FFI event thread and uses this
+  // room, so ~Room waits while one is pending.
+  std::mutex connect_mutex_;
+  std::condition_variable connect_cv_;
+  bool connect_pending_ = false;
+  // Resets per-connect state and marks a connect as pending.
+  void beginConnect(std::chrono::steady_clock::time_point started);
+  void endConnect();
+
+  std::atomic<RoomDelegate *> delegate_{nullptr}; // Not owned
+  // delegate_->interestedEvents(), captured by setDelegate().
+  std::atomic<std::uint64_t> delegate_events_{0};
+
+  // Participants: the local and remote participant objects and the state the
+  // event thread updates on them (publications, metadata, ...).
+  mutable std::mutex participants_lock_;
   std::unique_ptr<LocalParticipant> local_participant_;
   std::unordered_map<std::string, std::shared_ptr<RemoteParticipant>>
       remote_participants_;
-  // Data stream
+  // Copy of remote_participants_ for lock-free readers. Republished under
+  // participants_lock_ after every change to the map; read with
+  // std::atomic_load.
+  // Starts as an empty snapshot shared by every room, so an unconnected
+  // Room allocates nothing.
+  std::shared_ptr<const RemoteParticipantSnapshot> participants_snapshot_;
+  void publishParticipantsLocked();
+  // RoomOptions::lazy_participants: participants not in remote_participants_
+  // yet. Null for rooms that connected without the option.
+  std::unique_ptr<detail::CompactParticipantStore> compact_participants_;
+  // compact_participants_ != nullptr, readable without participants_lock_.
+  std::atomic<bool> lazy_participants_{false};
+  // The RemoteParticipant for `identity`, materializing a compact record.
+  RemoteParticipant *findRemoteLocked(const std::string &identity);
+
+  // Data stream and data packet handlers registered by the app.
+  mutable std::mutex handlers_lock_;
   std::unordered_map<std::string, TextStreamHandler> text_stream_handlers_;
   std::unordered_map<std::string, ByteStreamHandler> byte_stream_handlers_;
+  std::unordered_map<std::string, TextStreamOpenHandler>
+      text_stream_callbacks_;
+  std::unordered_map<std::string, ByteStreamOpenHandler>
+      byte_stream_callbacks_;
+  // Handlers are shared so the event thread can hold one across the call
+  // without copying it or keeping handlers_lock_.
+  std::unordered_map<std::string, std::shared_ptr<const DataPacketHandler>>
+      data_packet_handlers_;
+
+  // Open incoming data streams, touched on every chunk.
+  mutable std::mutex streams_lock_;
   std::unordered_map<std::string, std::shared_ptr<TextStreamReader>>
       text_stream_readers_;
   std::unordered_map<std::string, std::shared_ptr<ByteStreamReader>>
       byte_stream_readers_;
-  // E2EE
-  std::unique_ptr<E2EEManager> e2ee_manager_;
-
-  // FfiClient listener ID (0 means no listener registered)
+  // Shared by all readers; outlives the room if a reader is still held.
+  std::shared_ptr<detail::StreamBudget> stream_budget_;
+  // Streams opened through register*StreamCallbacks(), with their
+  // executor.
+  std::unique_ptr<detail::StreamDispatcher> stream_dispatcher_;
+
+  // FfiClient listener IDs (0 means no listener registered). Room events are
+  // routed by room handle, RPC invocations by local participant handle.
   int listener_id_{0};
+  int rpc_listener_id_{0};
 
   void OnEvent(const proto::FfiEvent &event);
+  // connectAsync() completion, on the FFI event thread.
+  ConnectResult finishConnect(const proto::ConnectCallback &cb,
+                              const RoomOptions &options);
+
+  // replayEvents(): sets the room up from a recorded connect callback.
+  friend struct detail::EventReplayAccess;
 };
 } // namespace livekit
 
@@ -18,10 +18,63 @@
 
 #include "livekit/room_event_types.h"
 
+#include <cstdint>
+
 namespace livekit {
 
 class Room;
 
+/// One bit per RoomDelegate callback, for RoomDelegate::interestedEvents().
+enum class RoomEventType : std::uint64_t {
+  kParticipantConnected = 1ull << 0,
+  kParticipantDisconnected = 1ull << 1,
+  kLocalTrackPublished = 1ull << 2,
+  kLocalTrackUnpublished = 1ull << 3,
+  kLocalTrackSubscribed = 1ull << 4,
+  kTrackPublished = 1ull << 5,
+  kTrackUnpublished = 1ull << 6,
+  kTrackSubscribed = 1ull << 7,
+  kTrackUnsubscribed = 1ull << 8,
+  kTrackSubscriptionFailed = 1ull << 9,
+  kTrackMuted = 1ull << 10,
+  kTrackUnmuted = 1ull << 11,
+  kActiveSpeakersChanged = 1ull << 12,
+  kRoomMetadataChanged = 1ull << 13,
+  kRoomSidChanged = 1ull << 14,
+  kRoomUpdated = 1ull << 15,
+  kRoomMoved = 1ull << 16,
+  kParticipantMetadataChanged = 1ull << 17,
+  kParticipantNameChanged = 1ull << 18,
+  kParticipantAttributesChanged = 1ull << 19,
+  kParticipantEncryptionStatusChanged = 1ull << 20,
+  kConnectionQualityChanged = 1ull << 21,
+  kConnectionStateChanged = 1ull << 22,
+  kDisconnected = 1ull << 23,
+  kReconnecting = 1ull << 24,
+  kReconnected = 1ull << 25,
+  kE2eeStateChanged = 1ull << 26,
+  kRoomEos = 1ull << 27,
+  kUserPacketReceived = 1ull << 28,
+  kSipDtmfReceived = 1ull << 29,
+  kDataStreamHeaderReceived = 1ull << 30,
+  kDataStreamChunkReceived = 1ull << 31,
+  kDataStreamTrailerReceived = 1ull << 32,
+  kDataChannelBufferedAmountLowThresholdChanged = 1ull << 33,
+  kByteStreamOpened = 1ull << 34,
+  kTextStreamOpened = 1ull << 35,
+  kParticipantsUpdated = 1ull << 36,
+};
+
+using RoomEventMask = std::uint64_t;
+constexpr RoomEventMask kAllRoomEvents = (1ull << 37) - 1;
+
+constexpr RoomEventMask operator|(RoomEventType a, RoomEventType b) {
+  return static_cast<RoomEventMask>(a) | static_cast<RoomEventMask>(b);
+}
+constexpr RoomEventMask operator|(RoomEventMask a, RoomEventType b) {
+  return a | static_cast<RoomEventMask>(b);
+}
+
 /**
  * Interface for receiving room-level events.
  *
@@ -35,6 +88,14 @@ class RoomDelegate {
 public:
   virtual ~RoomDelegate() = default;
 
+  /**
+   * Callbacks this delegate implements. For events outside the mask, Room
+   * skips building the event struct (and the strings, attribute maps and
+   * payload copies it holds) along with the call; the room's own participant
+   * and track state is updated either way. Read once by Room::setDelegate().
+   */
+  virtual RoomEventMask interestedEvents() const { return kAllRoomEvents; }
+
   // ------------------------------------------------------------------
   // Participant lifecycle
   // ------------------------------------------------------------------
@@ -16,11 +16,14 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace livekit {
@@ -127,6 +130,60 @@ struct SipDtmfData {
   std::optional<std::string> digit;
 };
 
+/**
+ * One segment of a transcription, e.g. a sentence of recognized speech.
+ */
+struct TranscriptionSegment {
+  /** Stable ID; later updates to the segment reuse it. */
+  std::string id;
+
+  /** Text recognized so far (the full segment, not a delta). */
+  std::string text;
+
+  /** Start and end of the segment in milliseconds of track time. */
+  std::uint64_t start_time = 0;
+  std::uint64_t end_time = 0;
+
+  /** True once the text will not change any more. */
+  bool is_final = false;
+
+  /** Language code, e.g. "en". */
+  std::string language;
+};
+
+/**
+ * Batching of LocalParticipant::publishTranscription().
+ */
+struct TranscriptionOptions {
+  /**
+   * How long interim segments are held back so that further updates to the
+   * same segment replace them instead of being sent separately. Final
+   * segments are sent without waiting. Zero sends as soon as possible,
+   * coalescing only what arrives while a send is under way.
+   */
+  std::chrono::milliseconds batch_window{100};
+
+  /** A batch holding this many distinct segments is sent right away. */
+  std::size_t max_batch_segments = 64;
+};
+
+/**
+ * Counters of LocalParticipant::publishTranscription().
+ */
+struct TranscriptionStats {
+  /** Segments passed to publishTranscription(). */
+  std::uint64_t segments_submitted = 0;
+
+  /** Segments replaced by a later update before being sent. */
+  std::uint64_t segments_coalesced = 0;
+
+  /** Transcription requests sent to the FFI. */
+  std::uint64_t batches_sent = 0;
+
+  /** Requests that failed; details are logged. */
+  std::uint64_t send_failures = 0;
+};
+
 /**
  * Snapshot of core room information.
  */
@@ -309,7 +366,10 @@ struct TrackPublishOptions {
   /** Optional audio encoding parameters. */
   std::optional<AudioEncodingOptions> audio_encoding;
 
-  /** Optional video codec to use. */
+  /**
+   * Optional video codec to use. Frames from a VideoSource are encoded
+   * with it; publishing already encoded frames is not supported by the FFI.
+   */
   std::optional<VideoCodec> video_codec;
 
   /** Enable or disable discontinuous transmission (DTX). */
@@ -339,17 +399,25 @@ struct TrackPublishOptions {
  * Fired when a remote participant joins the room.
  */
 struct ParticipantConnectedEvent {
-  /** The newly connected remote participant (owned by Room). */
+  /** The newly connected remote participant (owned by Room). nullptr under
+   *  RoomOptions::lazy_participants; see Room::remoteParticipant(). */
   RemoteParticipant *participant = nullptr;
+
+  /** Identity of the participant. */
+  std::string identity;
 };
 
 /**
  * Fired when a remote participant leaves the room.
  */
 struct ParticipantDisconnectedEvent {
-  /** The participant that disconnected (owned by Room). */
+  /** The participant that disconnected (owned by Room). nullptr if it was
+   *  never materialized under RoomOptions::lazy_participants. */
   RemoteParticipant *participant = nullptr;
 
+  /** Identity of the participant. */
+  std::string identity;
+
   /** Reason for the disconnect, if known. */
   DisconnectReason reason = DisconnectReason::Unknown;
 };
@@ -524,13 +592,22 @@ struct ParticipantNameChangedEvent {
 
 /**
  * Fired when a participant's attributes change.
+ *
+ * Carries only the keys touched by this update; the participant's full set
+ * (already updated) is available from Participant::attributes().
  */
 struct ParticipantAttributesChangedEvent {
   /** Participant whose attributes changed (owned by Room). */
   Participant *participant = nullptr;
 
-  /** Set of attributes that changed (key/value pairs). */
+  /**
+   * Attributes that were added, given a new value or removed; a removed
+   * key has an empty value, as in earlier releases.
+   */
   std::vector<AttributeEntry> changed_attributes;
+
+  /** Keys that were removed (also in changed_attributes, with no value). */
+  std::vector<std::string> removed_attributes;
 };
 
 /**
@@ -573,6 +650,20 @@ struct UserDataPacketEvent {
   std::string topic;
 };
 
+/**
+ * Borrowed view of a received user data packet, passed to handlers
+ * registered with Room::registerDataPacketHandler(). The payload and topic
+ * point into the FFI event and are only valid during the handler call;
+ * copy what must outlive it.
+ */
+struct UserDataPacketView {
+  const std::uint8_t *data = nullptr;
+  std::size_t size = 0;
+  DataPacketKind kind = DataPacketKind::Reliable;
+  RemoteParticipant *participant = nullptr;
+  std::string_view topic;
+};
+
 /**
  * Fired when a SIP DTMF packet is received.
  */
@@ -611,7 +702,10 @@ struct ReconnectingEvent {};
 /**
  * Fired after successfully reconnecting.
  */
-struct ReconnectedEvent {};
+struct ReconnectedEvent {
+  /// Time since the matching ReconnectingEvent.
+  std::chrono::microseconds duration{0};
+};
 
 /**
  * Fired when the room has reached end-of-stream (no more events).
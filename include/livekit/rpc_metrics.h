@@ -0,0 +1,57 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "latency_snapshot.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace livekit {
+
+/// Counters and latencies for one RPC method in one direction.
+struct RpcMethodMetrics {
+  std::string method;
+  std::uint64_t calls = 0;
+  /// Calls answered with an RpcError, excluding timeouts.
+  std::uint64_t errors = 0;
+  /// Calls that failed with CONNECTION_TIMEOUT or RESPONSE_TIMEOUT.
+  std::uint64_t timeouts = 0;
+  /// Outgoing: round trip as seen by performRpc. Incoming: from handler
+  /// start until it answered.
+  LatencySnapshot latency;
+  /// Incoming only: from arrival until the handler started, i.e. time spent
+  /// behind the executor or a max_concurrency limit.
+  LatencySnapshot queueing;
+};
+
+/// Process-wide RPC metrics, one entry per method name.
+struct RpcMetrics {
+  std::vector<RpcMethodMetrics> outgoing; ///< performRpc / performRpcAsync
+  std::vector<RpcMethodMetrics> incoming; ///< Registered handlers
+};
+
+/// Snapshot the metrics collected since start-up or the last reset, while
+/// metrics were enabled (see setMetricsEnabled). Cheap enough to scrape
+/// periodically; recording continues concurrently.
+RpcMetrics rpcMetrics();
+
+/// Clear all RPC metrics.
+void resetRpcMetrics();
+
+} // namespace livekit
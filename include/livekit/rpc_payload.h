@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace livekit {
+
+/**
+ * A named compression codec for RPC payloads, e.g. zstd or lz4 provided by
+ * the application:
+ *
+ *   livekit::registerRpcCompression({"zstd", zstdCompress, zstdDecompress});
+ *
+ * Both sides must register a codec under the same name. A caller opts in per
+ * call with RpcCallOptions::compression; the handler receives the payload
+ * already decompressed and its reply is compressed with the same codec.
+ * A receiver without the codec answers APPLICATION_ERROR, and the caller
+ * may retry uncompressed.
+ */
+struct RpcCompression {
+  std::string name;
+  std::function<std::string(std::string_view)> compress;
+  /// May throw on corrupt input; the call then fails with APPLICATION_ERROR.
+  std::function<std::string(std::string_view)> decompress;
+  /// Payloads smaller than this are sent uncompressed.
+  std::size_t min_size = 512;
+};
+
+/// Register `codec` process-wide, replacing any codec of the same name.
+/// Throws std::invalid_argument if the name is empty or a function missing.
+void registerRpcCompression(RpcCompression codec);
+
+} // namespace livekit
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "livekit/video_source.h"
+
+namespace livekit {
+
+class AudioFrame;
+class AudioFrameView;
+class VideoFrame;
+
+/**
+ * Shared-memory ring of fixed-size frame slots for consumers in other
+ * processes.
+ *
+ * The ring lives in a POSIX shared memory object (shm_open) or, with no
+ * name, an anonymous memfd whose fd() can be passed over a Unix socket.
+ * Every write copies the frame straight into the next slot, so with
+ * VideoStream::Options::export_ring the only copy is the one out of the
+ * FFI buffer. Readers map the object and read in place using the layout and
+ * seqlock helpers in livekit/frame_ring_abi.h, which is plain C. The writer
+ * never waits for readers: a reader that falls slot_count frames behind has
+ * its frames overwritten and sees the seqlock check fail.
+ *
+ * One writer at a time. Not available on Windows; the constructor throws.
+ */
+class SharedFrameRing {
+public:
+  enum class Kind { kVideo = 1, kAudio = 2 };
+
+  struct Options {
+    /// shm_open name such as "/lk-camera"; empty creates an anonymous
+    /// memfd (Linux only).
+    std::string name;
+    /// Remove the name when the ring is destroyed. Readers that already
+    /// mapped it keep their mapping.
+    bool unlink_on_destroy = true;
+    std::size_t slot_count = 4;
+    /// Payload capacity per slot, e.g. width * height * 4 for RGBA video or
+    /// samples_per_channel * channels * 2 for audio. Larger frames are
+    /// skipped and counted in the header's `dropped`.
+    std::size_t max_frame_bytes = 0;
+  };
+
+  struct Stats {
+    std::uint64_t frames_written = 0;
+    std::uint64_t frames_too_large = 0;
+  };
+
+  /// @throws std::invalid_argument for a zero slot_count or
+  ///         max_frame_bytes, std::runtime_error if the memory cannot be
+  ///         created or mapped.
+  SharedFrameRing(Kind kind, const Options &options);
+  ~SharedFrameRing();
+
+  SharedFrameRing(const SharedFrameRing &) = delete;
+  SharedFrameRing &operator=(const SharedFrameRing &) = delete;
+
+  /// Copy a frame (native or owned, any plane layout) into the next slot.
+  /// Returns false if the ring is for audio, closed, or the frame is too
+  /// large.
+  bool write(const VideoFrame &frame, std::int64_t timestamp_us,
+             VideoRotation rotation = VideoRotation::VIDEO_ROTATION_0);
+  bool write(const AudioFrameView &frame, std::int64_t timestamp_us);
+  bool write(const AudioFrame &frame, std::int64_t timestamp_us);
+
+  /// Set the header's `closed` flag; later writes are refused.
+  void close() noexcept;
+
+  Kind kind() const noexcept { return kind_; }
+  const std::string &name() const noexcept { return name_; }
+  /// Descriptor of the shared memory object, valid for the ring's lifetime.
+  int fd() const noexcept { return fd_; }
+  /// Bytes to map on the reader side.
+  std::size_t mappedSize() const noexcept { return size_; }
+  Stats stats() const noexcept;
+
+private:
+  // Slot for the next frame with its seqlock opened, or nullptr (and the
+  // drop counted) if `payload_size` does not fit; publish() closes it.
+  void *beginWrite(std::size_t payload_size) noexcept;
+  void publish(void *slot) noexcept;
+  bool writeAudio(const std::int16_t *samples, int sample_rate,
+                  int num_channels, int samples_per_channel,
+                  std::int64_t timestamp_us);
+
+  Kind kind_;
+  std::string name_;
+  bool unlink_on_destroy_;
+  int fd_ = -1;
+  std::size_t size_ = 0;
+  std::size_t slot_size_ = 0;
+  std::size_t slot_count_ = 0;
+  std::size_t max_payload_ = 0;
+  std::uint8_t *base_ = nullptr;
+  std::uint64_t next_index_ = 0;
+  std::atomic<std::uint64_t> written_{0};
+  std::atomic<std::uint64_t> too_large_{0};
+  bool closed_ = false;
+};
+
+} // namespace livekit
@@ -501,6 +501,62 @@ struct RtcStats {
   RtcStatsVariant stats;
 };
 
+/// One bit per RtcStatsVariant alternative, for requesting a subset of
+/// stats. Unselected entries are skipped before conversion.
+enum class RtcStatsType : std::uint32_t {
+  kCodec = 1u << 0,
+  kInboundRtp = 1u << 1,
+  kOutboundRtp = 1u << 2,
+  kRemoteInboundRtp = 1u << 3,
+  kRemoteOutboundRtp = 1u << 4,
+  kMediaSource = 1u << 5,
+  kMediaPlayout = 1u << 6,
+  kPeerConnection = 1u << 7,
+  kDataChannel = 1u << 8,
+  kTransport = 1u << 9,
+  kCandidatePair = 1u << 10,
+  kLocalCandidate = 1u << 11,
+  kRemoteCandidate = 1u << 12,
+  kCertificate = 1u << 13,
+  kStream = 1u << 14,
+};
+
+using RtcStatsTypeMask = std::uint32_t;
+constexpr RtcStatsTypeMask kAllRtcStatsTypes = (1u << 15) - 1;
+
+constexpr RtcStatsTypeMask operator|(RtcStatsType a, RtcStatsType b) {
+  return static_cast<RtcStatsTypeMask>(a) | static_cast<RtcStatsTypeMask>(b);
+}
+constexpr RtcStatsTypeMask operator|(RtcStatsTypeMask a, RtcStatsType b) {
+  return a | static_cast<RtcStatsTypeMask>(b);
+}
+
+/// Stats of one peer connection, from Room::getSessionStatsAsync().
+struct PeerConnectionSessionStats {
+  std::optional<RtcPeerConnectionStats> peer_connection;
+  std::vector<RtcTransportStats> transports;
+  std::vector<RtcCandidatePairStats> candidate_pairs;
+  /// Any other requested stats types, in delivery order.
+  std::vector<RtcStats> other;
+
+  /// The pair a transport reports as selected, else a nominated pair;
+  /// nullptr if neither is present.
+  const RtcCandidatePairStats *selectedCandidatePair() const;
+};
+
+/// Transport-level stats of a whole room connection.
+struct SessionStats {
+  PeerConnectionSessionStats publisher;
+  PeerConnectionSessionStats subscriber;
+};
+
+constexpr RtcStatsTypeMask kSessionStatsTypes =
+    RtcStatsType::kPeerConnection | RtcStatsType::kTransport |
+    RtcStatsType::kCandidatePair;
+
+/// Sort converted stats into `out` by type.
+void appendSessionStats(RtcStats stats, PeerConnectionSessionStats &out);
+
 // ----------------------
 // fromProto declarations
 // ----------------------
@@ -532,6 +588,9 @@ StreamStats fromProto(const proto::StreamStats &);
 // High-level:
 RtcStats fromProto(const proto::RtcStats &);
 
+// Whether `s` is one of the types in `mask`. Cheap; call before fromProto.
+bool rtcStatsSelected(const proto::RtcStats &s, RtcStatsTypeMask mask);
+
 // helper if you have repeated RtcStats in proto:
 std::vector<RtcStats> fromProto(const std::vector<proto::RtcStats> &);
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/stats.h"
+#include "livekit/track.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace livekit {
+
+class Room;
+
+/**
+ * Per-track rates over one sampling interval, derived from successive
+ * getStats() snapshots. Rates are 0 on a track's first sample.
+ */
+struct TrackStatsSummary {
+  std::string participant_identity;
+  std::string track_sid;
+  TrackKind kind = TrackKind::KIND_UNKNOWN;
+  bool local = false; ///< Published by us (outbound) rather than subscribed.
+
+  double interval_sec = 0.0;
+  double bitrate_bps = 0.0;
+  double packets_per_sec = 0.0;
+  /// Fraction of packets lost in the interval, 0..1. For local tracks this
+  /// is the receiver's report (remote-inbound fraction_lost).
+  double packet_loss = 0.0;
+  double jitter_ms = 0.0;
+  /// Change in jitter since the previous sample; positive is worsening.
+  double jitter_delta_ms = 0.0;
+  double round_trip_time_ms = 0.0; ///< Local tracks only, when reported.
+
+  // Video only.
+  double frames_per_second = 0.0;
+  std::uint32_t frame_width = 0;
+  std::uint32_t frame_height = 0;
+  /// Local video: the encoder's current limitation, of its largest layer.
+  QualityLimitationReason quality_limitation =
+      QualityLimitationReason::None;
+  /// True if quality_limitation differs from the previous sample.
+  bool quality_limitation_changed = false;
+};
+
+namespace detail {
+
+// Turns successive stats snapshots of one track into rates. Exposed for
+// StatsSampler and tests; not thread-safe.
+class TrackStatsAccumulator {
+public:
+  TrackStatsSummary update(const std::vector<RtcStats> &stats, bool local);
+
+private:
+  bool has_previous_ = false;
+  std::int64_t timestamp_ms_ = 0;
+  std::uint64_t bytes_ = 0;
+  std::uint64_t packets_ = 0;
+  std::int64_t lost_ = 0;
+  double jitter_ms_ = 0.0;
+  QualityLimitationReason limitation_ =
+      QualityLimitationReason::None;
+};
+
+} // namespace detail
+
+/**
+ * Polls every published and subscribed track of a Room at a fixed interval
+ * and delivers one TrackStatsSummary per track.
+ *
+ * Only the RTP stats types the summary needs are converted, and all tracks
+ * are queried concurrently each round. The callback runs on the sampler's
+ * own thread.
+ */
+class StatsSampler {
+public:
+  struct Options {
+    std::chrono::milliseconds interval{1000};
+    bool local_tracks = true;
+    bool remote_tracks = true;
+  };
+  using Callback = std::function<void(const std::vector<TrackStatsSummary> &)>;
+
+  /// `room` must outlive the sampler.
+  StatsSampler(Room &room, Options options, Callback callback);
+  ~StatsSampler();
+
+  StatsSampler(const StatsSampler &) = delete;
+  StatsSampler &operator=(const StatsSampler &) = delete;
+
+  /// Start the background thread; no-op if already running.
+  void start();
+  /// Stop and join the background thread.
+  void stop();
+
+  /// Take one sample now on the calling thread and return it, without
+  /// invoking the callback. Do not call concurrently with start().
+  std::vector<TrackStatsSummary> sampleOnce();
+
+private:
+  void run();
+
+  Room &room_;
+  const Options options_;
+  Callback callback_;
+  // Keyed by track SID; entries for vanished tracks are pruned each round.
+  std::unordered_map<std::string, detail::TrackStatsAccumulator> tracks_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+} // namespace livekit
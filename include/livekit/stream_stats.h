@@ -0,0 +1,47 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "latency_snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace livekit {
+
+/**
+ * Delivery counters for one AudioStream or VideoStream, see their stats().
+ *
+ * received = delivered + dropped + queue_depth while the stream is open.
+ * Use queue_time percentiles against the frame interval to size
+ * Options::capacity.
+ */
+struct MediaStreamStats {
+  /// Frames handed to the stream by the FFI.
+  std::uint64_t frames_received = 0;
+  /// Frames returned by a read call or passed to on_frame.
+  std::uint64_t frames_delivered = 0;
+  /// Frames evicted by a full queue. With Options::spsc_ring, frames skipped
+  /// by the ring are counted once the reader catches up.
+  std::uint64_t frames_dropped = 0;
+  std::size_t queue_depth = 0;
+  std::size_t max_queue_depth = 0;
+  /// Arrival to read, per delivered frame. Empty in push mode.
+  LatencySnapshot queue_time;
+};
+
+} // namespace livekit
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace livekit {
+
+/// What an SDK thread does; each role gets its own ThreadPlacement.
+enum class ThreadRole {
+  /// EventDispatcher workers (EventDispatchMode::kDedicatedThread and
+  /// kShardedPool).
+  kEventDispatch,
+  /// Audio delivery and capture: the dedicated audio dispatch worker (see
+  /// EventDispatchOptions::dedicated_audio_thread), AudioSource async
+  /// capture and FileAudioSource.
+  kAudio,
+  /// VideoSource async capture.
+  kVideo,
+  /// MediaClock pacer thread.
+  kMediaClock,
+  /// Everything else: logging, stats sampling, recorders, handle disposal.
+  kBackground,
+};
+
+enum class ThreadPriority {
+  /// Leave the OS default.
+  kDefault,
+  /// Raised priority within normal time-sharing (nice -10 on Linux,
+  /// THREAD_PRIORITY_HIGHEST on Windows).
+  kElevated,
+  /// Real-time scheduling (SCHED_FIFO on Linux and macOS,
+  /// THREAD_PRIORITY_TIME_CRITICAL on Windows).
+  kRealtime,
+};
+
+/// Where and how threads of one role run. The OS may refuse affinity or
+/// priority changes (e.g. SCHED_FIFO without CAP_SYS_NICE); the thread then
+/// runs as it would have, and ThreadCpuStats::placement_error says why.
+struct ThreadPlacement {
+  /// CPU indices the threads may run on; empty means any. Not supported on
+  /// macOS.
+  std::vector<int> cpus;
+  ThreadPriority priority = ThreadPriority::kDefault;
+  /// SCHED_FIFO priority used by kRealtime on POSIX (1-99).
+  int realtime_priority = 10;
+};
+
+/// Thread set-up applied by every SDK-owned thread when it starts; pass in
+/// InitializeOptions::threads or configureThreads().
+struct ThreadOptions {
+  /// Name threads "lk-<what>" so they show up in top, perf and debuggers.
+  bool name_threads = true;
+  ThreadPlacement event_dispatch;
+  ThreadPlacement audio;
+  ThreadPlacement video;
+  ThreadPlacement media_clock;
+  ThreadPlacement background;
+};
+
+/// CPU time of one live thread registered with the SDK.
+struct ThreadCpuStats {
+  std::string name;
+  ThreadRole role = ThreadRole::kBackground;
+  /// User plus system time consumed so far.
+  std::chrono::microseconds cpu_time{0};
+  /// Empty if the placement was applied in full.
+  std::string placement_error;
+};
+
+/// Replace the thread options. Threads already running keep their current
+/// placement; threads started afterwards use the new one.
+void configureThreads(const ThreadOptions &options);
+
+/**
+ * Apply the placement of `role` to the calling thread and register it for
+ * threadCpuStats() until it exits, e.g. from an application thread that
+ * reads an AudioStream. `name` is applied when ThreadOptions::name_threads
+ * is set; Linux truncates it to 15 characters. Returns false if part of
+ * the placement could not be applied.
+ */
+bool applyThreadRole(ThreadRole role, const std::string &name = {});
+
+/// CPU time of every live registered thread. Also exported by
+/// metricsToOpenMetrics() as livekit_thread_cpu_seconds_total.
+std::vector<ThreadCpuStats> threadCpuStats();
+
+} // namespace livekit
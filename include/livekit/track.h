@@ -93,6 +93,9 @@ public:
 
   // Async get stats
   std::future<std::vector<RtcStats>> getStats() const;
+  // Only the selected stats types, e.g.
+  // getStats(RtcStatsType::kInboundRtp | RtcStatsType::kOutboundRtp).
+  std::future<std::vector<RtcStats>> getStats(RtcStatsTypeMask types) const;
 
   // Internal updates (called by Room)
   void setStreamState(StreamState s) noexcept { state_ = s; }
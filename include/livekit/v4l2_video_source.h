@@ -0,0 +1,139 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace livekit {
+
+class VideoSource;
+
+/// Camera pixel formats V4L2VideoSource can stream.
+enum class V4L2PixelFormat {
+  kAuto,   ///< First of NV12, YUV420, YUYV that the device offers.
+  kNV12,   ///< Passed to the FFI in place.
+  kYUV420, ///< Planar I420 ("YU12"); passed to the FFI in place.
+  kYUYV,   ///< Packed 4:2:2; de-interleaved into a pooled I422 frame.
+};
+
+/// Counters of one V4L2VideoSource since it was opened.
+struct V4L2CaptureStats {
+  std::uint64_t frames_captured = 0;
+  /// Older buffers requeued unsent because a newer one was already ready.
+  std::uint64_t frames_skipped = 0;
+  /// Buffers the driver flagged as corrupt, or that the FFI rejected.
+  std::uint64_t frames_failed = 0;
+};
+
+/**
+ * Streams a Linux V4L2 camera (e.g. /dev/video0) into a VideoSource.
+ *
+ * Frames are captured into the driver's streaming buffers, which are
+ * mmapped once at open. A capture thread waits on the device with epoll,
+ * wraps each dequeued buffer with VideoFrame::wrapExternal(), using the
+ * driver's row pitch as stride, and hands it to VideoSource::captureFrame().
+ * The buffer is requeued as soon as the FFI has consumed it. NV12 and
+ * YUV420 are never copied on the SDK side; YUYV, which the FFI cannot take,
+ * costs a single de-interleaving pass into I422. If several buffers are
+ * ready at once, only the newest is sent, so a slow consumer adds no
+ * latency.
+ *
+ * With Options::export_dmabuf the buffers are exported as DMA-BUFs and
+ * delivered through VideoSource::captureNativeFrame() instead, so that a
+ * mapper set with VideoSource::setNativeBufferMapper() (e.g. a GPU import)
+ * sees them.
+ *
+ * @code
+ * V4L2VideoSource::Options options;
+ * options.device = "/dev/video0";
+ * V4L2VideoSource camera(options);
+ * room.localParticipant()->publishTrack(
+ *     LocalVideoTrack::createLocalVideoTrack("cam", camera.videoSource()),
+ *     TrackPublishOptions{});
+ * camera.start();
+ * @endcode
+ */
+class V4L2VideoSource {
+public:
+  struct Options {
+    std::string device{"/dev/video0"};
+    /// Requested size and rate; the driver picks the nearest it supports
+    /// (see width(), height()).
+    int width{1280};
+    int height{720};
+    int fps{30};
+    V4L2PixelFormat format{V4L2PixelFormat::kAuto};
+    /// Streaming buffers requested from the driver (it may grant more).
+    std::uint32_t buffer_count{4};
+    /// Deliver VIDIOC_EXPBUF DMA-BUFs via captureNativeFrame().
+    bool export_dmabuf{false};
+    /// Capture stopped on a device error (e.g. the camera was unplugged);
+    /// runs on the capture thread.
+    std::function<void(const std::string &)> on_error;
+  };
+
+  /// Open and configure the device, creating a VideoSource of the
+  /// negotiated size. Throws std::runtime_error if the device cannot be
+  /// opened, cannot stream, or offers none of the supported formats (and
+  /// always on platforms without V4L2).
+  explicit V4L2VideoSource(const Options &options);
+  /// Capture into an existing source. Frames keep the negotiated size even
+  /// if it differs from the source's. Throws std::invalid_argument on a
+  /// null source, otherwise like the constructor above.
+  V4L2VideoSource(std::shared_ptr<VideoSource> source, const Options &options);
+  ~V4L2VideoSource();
+
+  V4L2VideoSource(const V4L2VideoSource &) = delete;
+  V4L2VideoSource &operator=(const V4L2VideoSource &) = delete;
+
+  /// Negotiated frame size and format (never kAuto).
+  int width() const noexcept;
+  int height() const noexcept;
+  V4L2PixelFormat format() const noexcept;
+
+  /// The source frames are captured into. Publish it with
+  /// LocalVideoTrack::createLocalVideoTrack().
+  const std::shared_ptr<VideoSource> &videoSource() const noexcept {
+    return source_;
+  }
+
+  /// Start streaming. No-op while capturing. Throws std::runtime_error if
+  /// the driver refuses to start.
+  void start();
+  /// Stop streaming; blocks until the capture thread has exited.
+  void stop();
+  bool capturing() const noexcept { return capturing_.load(); }
+
+  V4L2CaptureStats stats() const noexcept;
+
+private:
+  struct Device;
+
+  void run();
+
+  std::shared_ptr<VideoSource> source_;
+  std::unique_ptr<Device> device_;
+  std::atomic<bool> capturing_{false};
+  std::thread thread_;
+};
+
+} // namespace livekit
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "frame_pool.h"
+#include "media_clock.h"
+#include "video_frame.h"
+
+namespace livekit {
+
+class VideoSource;
+class VideoStream;
+
+namespace detail {
+class TaskPool;
+} // namespace detail
+
+/// Placement of one input on the canvas, in canvas pixels.
+struct VideoCompositorRect {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+/// How one input of a VideoCompositor is placed and drawn.
+struct VideoCompositorInputOptions {
+  /// Fixed placement. Inputs without one share a grid laid over the
+  /// whole canvas, in the order they were added.
+  std::optional<VideoCompositorRect> rect;
+
+  /// Higher values are drawn later, on top.
+  int z_order{0};
+
+  /// 1 draws the tile opaquely; lower values blend it over what is below.
+  /// Per-pixel alpha of RGBA inputs is not used.
+  float opacity{1.0f};
+};
+
+/// Counters for VideoCompositor::stats().
+struct VideoCompositorStats {
+  /// Canvas frames produced.
+  std::uint64_t frames_composed = 0;
+  /// Ticks skipped because composing fell behind the frame rate.
+  std::uint64_t missed_ticks = 0;
+  /// Input frames that arrived in a format other than the canvas's and
+  /// were converted first.
+  std::uint64_t converted_frames = 0;
+  /// Time spent composing the most recent frame.
+  std::chrono::microseconds last_compose_time{0};
+};
+
+/**
+ * Composites many video inputs into one canvas at a fixed frame rate, e.g.
+ * a grid view of every participant for recording or egress.
+ *
+ * Each input is a VideoStream, read in latest-frame fashion (open it with
+ * VideoStream::Options::latest_only and the canvas format to avoid both
+ * queueing and conversion), or a push input fed through pushFrame(). Every
+ * tick the newest frame of each input is box-filtered straight into its
+ * tile of a pooled canvas frame (see VideoFrame::scaleInto()); inputs with
+ * opacity below 1 are scaled aside and alpha-blended with SIMD kernels.
+ * The canvas is split into row bands composed in parallel, each band
+ * drawing the background and then every tile crossing it in z order, so
+ * overlapping tiles need no synchronization.
+ *
+ * The result goes to Options::source via captureFrameAsync() and/or to
+ * Options::on_frame.
+ *
+ * @code
+ * VideoCompositor::Options opts;
+ * opts.source = std::make_shared<VideoSource>(1280, 720);
+ * VideoCompositor grid(opts);
+ * for (auto &stream : participantStreams)
+ *   grid.addInput(stream);
+ * @endcode
+ */
+class VideoCompositor {
+public:
+  struct Options {
+    /// Canvas size. Rounded down to even sizes for I420.
+    int width{1280};
+    int height{720};
+
+    /// Canvas format: I420, RGBA or BGRA.
+    VideoBufferType format{VideoBufferType::I420};
+
+    /// Frames per second composed by the compositor's own thread. 0 starts
+    /// no thread; call composeFrame() instead.
+    double fps{30};
+
+    /// Threads composing row bands, the tick thread included. 0 picks one
+    /// per core, at most 8.
+    std::size_t threads{0};
+
+    /// Canvas colour behind and between tiles, as R, G, B.
+    std::array<std::uint8_t, 3> background{0, 0, 0};
+
+    /// Fit each frame into its tile keeping its aspect ratio (letterbox)
+    /// instead of stretching it.
+    bool keep_aspect{true};
+
+    /// Receives every composed frame, if set.
+    std::shared_ptr<VideoSource> source;
+
+    /// Called with every composed frame on the tick thread, before it goes
+    /// to `source`. Must not block.
+    std::function<void(const VideoFrame &frame, std::int64_t timestamp_us)>
+        on_frame;
+  };
+
+  using InputOptions = VideoCompositorInputOptions;
+
+  /// Throws std::invalid_argument for an unsupported format or a canvas
+  /// smaller than 2x2.
+  explicit VideoCompositor(const Options &options);
+  /// Stops the tick thread.
+  ~VideoCompositor();
+
+  VideoCompositor(const VideoCompositor &) = delete;
+  VideoCompositor &operator=(const VideoCompositor &) = delete;
+
+  /// Add a stream input and return its id. The input leaves the canvas on
+  /// its own once the stream has ended.
+  int addInput(std::shared_ptr<VideoStream> stream,
+               const InputOptions &options = {});
+
+  /// Add a push input, fed by pushFrame(), and return its id.
+  int addInput(const InputOptions &options = {});
+
+  /// Replace the frame shown by push input `id`. Throws
+  /// std::invalid_argument for an unknown id.
+  void pushFrame(int id, VideoFrame frame);
+
+  /// Throws std::invalid_argument for an unknown id.
+  void updateInput(int id, const InputOptions &options);
+
+  /// No-op for an unknown id.
+  void removeInput(int id);
+
+  std::size_t inputCount() const;
+
+  /// Compose the canvas from the newest frame of each input, now. Called by
+  /// the tick thread; with Options::fps 0 it is the only way to produce
+  /// frames. The frame's buffer comes from the compositor's pool.
+  VideoFrame composeFrame();
+
+  VideoCompositorStats stats() const;
+
+  const Options &options() const noexcept { return options_; }
+
+private:
+  struct Input;
+  struct Tile;
+
+  void run();
+  // Newest frame of every input, dropping ended stream inputs.
+  std::vector<Tile> collectTiles();
+  // Background and every tile crossing rows [row_begin, row_end).
+  void composeBand(const VideoFrame &canvas, std::vector<Tile> &tiles,
+                   int row_begin, int row_end) const;
+
+  Options options_;
+  std::size_t band_count_{1};
+  std::unique_ptr<detail::TaskPool> workers_;
+  VideoFramePool pool_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<Input>> inputs_;
+  int next_input_id_{1};
+  VideoCompositorStats stats_;
+
+  std::atomic<bool> stopping_{false};
+  std::thread thread_;
+};
+
+} // namespace livekit
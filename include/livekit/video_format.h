@@ -0,0 +1,196 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace livekit {
+
+// Mirror of WebRTC video buffer type
+enum class VideoBufferType {
+  RGBA = 0,
+  ABGR,
+  ARGB,
+  BGRA,
+  RGB24,
+  I420,
+  I420A,
+  I422,
+  I444,
+  I010,
+  NV12
+};
+
+struct VideoPlaneInfo {
+  std::uintptr_t data_ptr; // pointer to plane data (for FFI)
+  std::uint32_t stride;    // bytes per row
+  std::uint32_t size;      // plane size in bytes
+};
+
+/// Most planes of any VideoBufferType (I420A: Y, U, V, A).
+inline constexpr std::size_t kMaxVideoPlanes = 4;
+
+/**
+ * Shape of one plane of a pixel format relative to the frame: bytes per
+ * sample and the log2 of the horizontal and vertical subsampling.
+ */
+struct VideoPlaneFormat {
+  std::uint8_t bytes_per_sample = 0; // 4 for RGBA, 2 for NV12's UV, ...
+  std::uint8_t log2_subsample_x = 0;
+  std::uint8_t log2_subsample_y = 0;
+
+  /// Samples per row for a frame `frame_width` pixels wide (rounded up).
+  constexpr std::uint32_t width(int frame_width) const noexcept {
+    return frame_width <= 0
+               ? 0
+               : (static_cast<std::uint32_t>(frame_width) +
+                  (1u << log2_subsample_x) - 1) >>
+                     log2_subsample_x;
+  }
+  constexpr std::uint32_t rows(int frame_height) const noexcept {
+    return frame_height <= 0
+               ? 0
+               : (static_cast<std::uint32_t>(frame_height) +
+                  (1u << log2_subsample_y) - 1) >>
+                     log2_subsample_y;
+  }
+  /// Bytes per row without padding.
+  constexpr std::uint32_t rowBytes(int frame_width) const noexcept {
+    return width(frame_width) * bytes_per_sample;
+  }
+};
+
+/**
+ * Plane layout of a pixel format. Tightly packed frames (VideoFrame::create(),
+ * VideoFramePool) store the planes back-to-back in this order without row
+ * padding.
+ */
+struct VideoFormatLayout {
+  std::size_t num_planes = 0; // 0 for an unknown format
+  std::array<VideoPlaneFormat, kMaxVideoPlanes> planes{};
+
+  constexpr std::size_t planeSize(std::size_t plane, int width,
+                                  int height) const noexcept {
+    return std::size_t{planes[plane].rowBytes(width)} *
+           planes[plane].rows(height);
+  }
+  /// Byte offset of `plane` in a packed buffer.
+  constexpr std::size_t planeOffset(std::size_t plane, int width,
+                                    int height) const noexcept {
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < plane; ++i) {
+      offset += planeSize(i, width, height);
+    }
+    return offset;
+  }
+  constexpr std::size_t bufferSize(int width, int height) const noexcept {
+    return planeOffset(num_planes, width, height);
+  }
+};
+
+/// Layout of `type`; usable in constant expressions.
+constexpr VideoFormatLayout videoFormatLayout(VideoBufferType type) noexcept {
+  VideoFormatLayout layout;
+  switch (type) {
+  case VideoBufferType::RGBA:
+  case VideoBufferType::ABGR:
+  case VideoBufferType::ARGB:
+  case VideoBufferType::BGRA:
+    layout.num_planes = 1;
+    layout.planes[0] = VideoPlaneFormat{4, 0, 0};
+    break;
+  case VideoBufferType::RGB24:
+    layout.num_planes = 1;
+    layout.planes[0] = VideoPlaneFormat{3, 0, 0};
+    break;
+  case VideoBufferType::I420:
+  case VideoBufferType::I420A:
+    layout.num_planes = type == VideoBufferType::I420A ? 4 : 3;
+    layout.planes[0] = VideoPlaneFormat{1, 0, 0};
+    layout.planes[1] = VideoPlaneFormat{1, 1, 1};
+    layout.planes[2] = VideoPlaneFormat{1, 1, 1};
+    layout.planes[3] = VideoPlaneFormat{1, 0, 0}; // alpha, I420A only
+    break;
+  case VideoBufferType::I422:
+    layout.num_planes = 3;
+    layout.planes[0] = VideoPlaneFormat{1, 0, 0};
+    layout.planes[1] = VideoPlaneFormat{1, 1, 0};
+    layout.planes[2] = VideoPlaneFormat{1, 1, 0};
+    break;
+  case VideoBufferType::I444:
+    layout.num_planes = 3;
+    layout.planes[0] = VideoPlaneFormat{1, 0, 0};
+    layout.planes[1] = VideoPlaneFormat{1, 0, 0};
+    layout.planes[2] = VideoPlaneFormat{1, 0, 0};
+    break;
+  case VideoBufferType::I010:
+    // 10-bit samples stored in 16 bits.
+    layout.num_planes = 3;
+    layout.planes[0] = VideoPlaneFormat{2, 0, 0};
+    layout.planes[1] = VideoPlaneFormat{2, 1, 1};
+    layout.planes[2] = VideoPlaneFormat{2, 1, 1};
+    break;
+  case VideoBufferType::NV12:
+    layout.num_planes = 2;
+    layout.planes[0] = VideoPlaneFormat{1, 0, 0};
+    layout.planes[1] = VideoPlaneFormat{2, 1, 1}; // interleaved UV
+    break;
+  }
+  return layout;
+}
+
+/**
+ * Compile-time layout of one format, e.g.
+ * VideoFormatTraits<VideoBufferType::NV12>::kNumPlanes == 2.
+ */
+template <VideoBufferType Format> struct VideoFormatTraits {
+  static constexpr VideoBufferType kType = Format;
+  static constexpr VideoFormatLayout kLayout = videoFormatLayout(Format);
+  static constexpr std::size_t kNumPlanes = kLayout.num_planes;
+  static_assert(kNumPlanes > 0, "unknown VideoBufferType");
+
+  template <std::size_t Plane>
+  static constexpr VideoPlaneFormat plane() noexcept {
+    static_assert(Plane < kNumPlanes, "plane index out of range");
+    return kLayout.planes[Plane];
+  }
+  static constexpr std::size_t bufferSize(int width, int height) noexcept {
+    return kLayout.bufferSize(width, height);
+  }
+};
+
+/**
+ * A frame's planes in a fixed-size array, as returned by
+ * VideoFrame::planes(); unlike planeInfos() it never allocates.
+ */
+struct VideoPlanes {
+  std::array<VideoPlaneInfo, kMaxVideoPlanes> plane{};
+  std::size_t count = 0;
+
+  std::size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0; }
+  const VideoPlaneInfo &operator[](std::size_t i) const noexcept {
+    return plane[i];
+  }
+  VideoPlaneInfo &operator[](std::size_t i) noexcept { return plane[i]; }
+  const VideoPlaneInfo *begin() const noexcept { return plane.data(); }
+  const VideoPlaneInfo *end() const noexcept { return plane.data() + count; }
+};
+
+} // namespace livekit
@@ -16,42 +16,50 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
-namespace livekit {
+#include "ffi_handle.h"
+#include "video_format.h"
 
-// Mirror of WebRTC video buffer type
-enum class VideoBufferType {
-  RGBA = 0,
-  ABGR,
-  ARGB,
-  BGRA,
-  RGB24,
-  I420,
-  I420A,
-  I422,
-  I444,
-  I010,
-  NV12
-};
+namespace livekit {
 
-struct VideoPlaneInfo {
-  std::uintptr_t data_ptr; // pointer to plane data (for FFI)
-  std::uint32_t stride;    // bytes per row
-  std::uint32_t size;      // plane size in bytes
+/**
+ * Per-frame tag carried from VideoSource::captureFrame() to
+ * VideoFrameEvent::metadata, e.g. to measure glass-to-glass latency or to
+ * match a frame with a data packet.
+ */
+struct VideoFrameMetadata {
+  std::uint64_t id = 0;
+  /// Sender's system_clock time in microseconds since the Unix epoch; 0 on
+  /// capture means "now".
+  std::int64_t capture_wallclock_us = 0;
 };
 
 namespace proto {
 class OwnedVideoBuffer;
 }
 
+namespace detail {
+template <typename T> class FrameBufferPool;
+} // namespace detail
+
+class VideoFramePool;
+
 /**
  * Public SDK representation of a video frame.
  *
- * - Owns its pixel buffer (std::vector<uint8_t>).
+ * - Owns its pixel buffer (std::vector<uint8_t>), or, for frames received
+ *   from a zero-copy VideoStream, borrows the Rust-owned OwnedVideoBuffer and
+ *   keeps it alive until the frame is destroyed (see isNative()), or wraps
+ *   caller-owned planes with arbitrary strides (see wrapExternal()).
  * - Developers can allocate and fill frames in C++ and pass them to the SDK.
  * - The SDK can expose the backing memory to Rust via data_ptr + layout for
  *   the duration of a blocking FFI call (similar to AudioFrame).
@@ -61,12 +69,13 @@ public:
   VideoFrame();
   VideoFrame(int width, int height, VideoBufferType type,
                std::vector<std::uint8_t> data);
-  virtual ~VideoFrame() = default;
+  virtual ~VideoFrame();
 
   VideoFrame(const VideoFrame &) = delete;
   VideoFrame &operator=(const VideoFrame &) = delete;
   VideoFrame(VideoFrame &&) noexcept = default;
-  VideoFrame &operator=(VideoFrame &&) noexcept = default;
+  // Hands the current buffer back to its pool (if any) before taking over.
+  VideoFrame &operator=(VideoFrame &&other) noexcept;
 
   /**
    * Allocate a new frame with the correct buffer size for the given format.
@@ -74,28 +83,88 @@ public:
    */
   static VideoFrame create(int width, int height, VideoBufferType type);
 
+  /**
+   * Wrap caller-owned pixel memory without copying, e.g. padded rows from a
+   * capture card or a GPU readback.
+   *
+   * `planes` lists the format's planes in planeInfos() order (one plane for
+   * packed RGB formats; Y, U, V for I420; Y, UV for NV12; ...), each with
+   * its own stride, which may exceed the packed row size, and size. The
+   * memory must stay valid and unchanged until `release` (may be empty)
+   * runs, once the frame is destroyed or assigned over.
+   *
+   * VideoSource::captureFrame() hands the planes to the FFI as they are,
+   * with no repacking; toOwned() packs them tightly.
+   *
+   * Throws std::invalid_argument if the planes do not fit width, height and
+   * type.
+   */
+  static VideoFrame wrapExternal(int width, int height, VideoBufferType type,
+                                 std::vector<VideoPlaneInfo> planes,
+                                 std::function<void()> release = {});
+
   // Basic properties
   int width() const noexcept { return width_; }
   int height() const noexcept { return height_; }
   VideoBufferType type() const noexcept { return type_; }
 
-  std::uint8_t *data() noexcept { return data_.data(); }
-  const std::uint8_t *data() const noexcept { return data_.data(); }
-  std::size_t dataSize() const noexcept { return data_.size(); }
+  /**
+   * Backing pixel memory.
+   *
+   * For native frames this points at the first plane of the Rust-owned
+   * buffer, and dataSize() spans all planes only if they are laid out
+   * back-to-back; otherwise it covers the first plane. Prefer planeInfos()
+   * when working with planar native frames.
+   */
+  std::uint8_t *data() noexcept {
+    return borrowed() ? native_data_ : data_.data();
+  }
+  const std::uint8_t *data() const noexcept {
+    return borrowed() ? native_data_ : data_.data();
+  }
+  std::size_t dataSize() const noexcept {
+    return borrowed() ? native_size_ : data_.size();
+  }
+
+  /**
+   * True if this frame wraps a Rust-owned OwnedVideoBuffer instead of owning
+   * its pixels.
+   */
+  bool isNative() const noexcept { return native_handle_.valid(); }
+
+  /// True if this frame wraps caller-owned memory (see wrapExternal()).
+  bool isExternal() const noexcept { return external_release_ != nullptr; }
+
+  /**
+   * Return an owning copy of this frame, with planes packed back-to-back.
+   * For frames that already own their buffer this is a plain copy.
+   */
+  VideoFrame toOwned() const;
+
+  /// Same as toOwned(), with the copy's storage taken from `pool`.
+  VideoFrame toOwned(VideoFramePool &pool) const;
 
   /**
    * Compute plane layout for this frame (Y/U/V, UV, etc.), in terms of
    * pointers & sizes relative to this frame's backing buffer.
    *
+   * For native frames this returns the layout reported by the FFI (including
+   * its strides) without copying.
+   *
    * For packed formats (ARGB, RGB24) this will be either 1 plane or empty.
    */
   std::vector<VideoPlaneInfo> planeInfos() const;
 
+  /// planeInfos() without the allocation, for per-frame processing.
+  VideoPlanes planes() const noexcept;
+
   /**
    * Convert this frame into another pixel format.
    *
-   * This uses the underlying FFI `video_convert` pipeline to transform the
-   * current frame into a new `VideoFrame` with the requested
+   * Common pairs (I420/NV12 <-> RGBA/BGRA/ARGB/ABGR, swizzles between the
+   * 4-byte RGB formats, and same-format flips) are converted in-process with
+   * SIMD kernels. Anything else uses the FFI `video_convert` pipeline to
+   * transform the current frame into a new `VideoFrame` with the requested
    * `dst` buffer type (e.g. ARGB → I420, BGRA → RGB24, etc.).
    *
    * @param dst     Desired output format (see VideoBufferType).
@@ -118,17 +187,173 @@ public:
    */
   VideoFrame convert(VideoBufferType dst, bool flip_y = false) const;
 
+  /**
+   * Convert this frame into `dst`, which must already have the same
+   * dimensions and the desired format (e.g. from VideoFramePool::acquire()).
+   *
+   * For natively supported pairs (see convert()) this writes straight into
+   * dst's buffer with no serialization and no allocation; other pairs fall
+   * back to the FFI and copy the result into dst.
+   *
+   * Throws std::invalid_argument if the dimensions differ or dst is a native
+   * (Rust-owned) frame, and std::runtime_error if the conversion fails.
+   */
+  void convertInto(VideoFrame &dst, bool flip_y = false) const;
+
+  /**
+   * Resample this frame into `dst`, which must already have the desired
+   * size and the same format, e.g. from VideoFramePool::acquire().
+   *
+   * Downscaling averages the source pixels behind each destination pixel
+   * (box filter) and upscaling repeats pixels. Runs in-process for RGBA,
+   * BGRA, ARGB, ABGR, RGB24, I420, I420A, I422, I444 and NV12, reading
+   * native frames in place.
+   *
+   * Throws std::invalid_argument if the formats differ, the format is not
+   * supported, or dst is a native (Rust-owned) frame.
+   */
+  void scaleInto(VideoFrame &dst) const;
+
 protected:
   friend class VideoStream;
   // Only internal classes (e.g., VideoStream)
   // should construct frames directly from FFI buffers.
   static VideoFrame fromOwnedInfo(const proto::OwnedVideoBuffer &owned);
 
+  // Wrap an FFI buffer without copying; takes ownership of its handle.
+  static VideoFrame wrapOwnedInfo(const proto::OwnedVideoBuffer &owned);
+
+  friend class VideoFramePool;
+
 private:
+  // Native or external planes rather than data_.
+  bool borrowed() const noexcept { return isNative() || isExternal(); }
+
+  // Sets native_planes_ and the data()/dataSize() view over them.
+  void adoptPlanes(const VideoPlanes &planes);
+
+  // Borrowed planes packed back-to-back without row padding: total size,
+  // and copy into `dst`.
+  std::size_t nativePackedSize() const;
+  void packNativePlanes(std::uint8_t *dst) const;
+
   int width_;
   int height_;
   VideoBufferType type_;
   std::vector<std::uint8_t> data_;
+
+  // Borrowed storage, set by wrapOwnedInfo() (native_handle_) or
+  // wrapExternal() (external_release_, which runs the release callback).
+  FfiHandle native_handle_;
+  std::shared_ptr<std::function<void()>> external_release_;
+  VideoPlanes native_planes_;
+  std::uint8_t *native_data_{nullptr};
+  std::size_t native_size_{0};
+
+  // Set for frames acquired from a VideoFramePool; data_ is handed back to
+  // the pool on destruction.
+  std::weak_ptr<detail::FrameBufferPool<std::uint8_t>> pool_;
+};
+
+/// One plane of a TypedVideoFrame.
+template <typename Byte> struct VideoPlaneView {
+  Byte *data = nullptr;
+  std::uint32_t stride = 0; // bytes per row, including any padding
+  std::uint32_t width = 0;  // samples per row
+  std::uint32_t rows = 0;
+
+  Byte *row(std::uint32_t y) const noexcept {
+    return data + static_cast<std::size_t>(y) * stride;
+  }
+};
+
+/**
+ * View of a VideoFrame whose format is fixed at compile time.
+ *
+ * The plane count, subsampling and sample size come from
+ * VideoFormatTraits<Format>, so the planes live in a fixed-size array and
+ * kernels written against a TypedVideoFrame need no runtime format switch.
+ * For frames that own their buffer the plane offsets follow from the width
+ * and height alone; borrowed frames (native or wrapExternal()) keep their
+ * own pointers and strides. The frame must outlive the view.
+ *
+ * @code
+ * TypedVideoFrame<VideoBufferType::NV12> nv12(frame);
+ * const auto &uv = nv12.plane<1>();
+ * for (std::uint32_t y = 0; y < uv.rows; ++y) { uv.row(y)[0] = 128; }
+ * @endcode
+ *
+ * Use `const std::uint8_t` as Byte (ConstTypedVideoFrame) to view a const
+ * frame.
+ */
+template <VideoBufferType Format, typename Byte = std::uint8_t>
+class TypedVideoFrame {
+  static_assert(std::is_same<std::remove_const_t<Byte>, std::uint8_t>::value,
+                "Byte must be std::uint8_t or const std::uint8_t");
+
+public:
+  using Traits = VideoFormatTraits<Format>;
+  using Frame = std::conditional_t<std::is_const<Byte>::value,
+                                   const VideoFrame, VideoFrame>;
+  using Plane = VideoPlaneView<Byte>;
+  static constexpr std::size_t kNumPlanes = Traits::kNumPlanes;
+
+  /// Throws std::invalid_argument if `frame` has another format, or its
+  /// planes do not match the format.
+  explicit TypedVideoFrame(Frame &frame)
+      : width_(frame.width()), height_(frame.height()) {
+    if (frame.type() != Format) {
+      throw std::invalid_argument("TypedVideoFrame: frame format mismatch");
+    }
+    if (!frame.isNative() && !frame.isExternal()) {
+      if (frame.data() == nullptr ||
+          frame.dataSize() < Traits::bufferSize(width_, height_)) {
+        throw std::invalid_argument(
+            "TypedVideoFrame: buffer too small for the format");
+      }
+      Byte *base = frame.data();
+      for (std::size_t i = 0; i < kNumPlanes; ++i) {
+        const VideoPlaneFormat &format = Traits::kLayout.planes[i];
+        planes_[i].data =
+            base + Traits::kLayout.planeOffset(i, width_, height_);
+        planes_[i].stride = format.rowBytes(width_);
+        planes_[i].width = format.width(width_);
+        planes_[i].rows = format.rows(height_);
+      }
+      return;
+    }
+    const VideoPlanes borrowed = frame.planes();
+    if (borrowed.size() != kNumPlanes) {
+      throw std::invalid_argument(
+          "TypedVideoFrame: plane count does not match the format");
+    }
+    for (std::size_t i = 0; i < kNumPlanes; ++i) {
+      const VideoPlaneFormat &format = Traits::kLayout.planes[i];
+      planes_[i].data = reinterpret_cast<Byte *>(borrowed[i].data_ptr);
+      planes_[i].stride = borrowed[i].stride;
+      planes_[i].width = format.width(width_);
+      planes_[i].rows = format.rows(height_);
+    }
+  }
+
+  int width() const noexcept { return width_; }
+  int height() const noexcept { return height_; }
+
+  template <std::size_t I> const Plane &plane() const noexcept {
+    static_assert(I < kNumPlanes, "plane index out of range");
+    return planes_[I];
+  }
+  const std::array<Plane, kNumPlanes> &planes() const noexcept {
+    return planes_;
+  }
+
+private:
+  int width_;
+  int height_;
+  std::array<Plane, kNumPlanes> planes_{};
 };
 
+template <VideoBufferType Format>
+using ConstTypedVideoFrame = TypedVideoFrame<Format, const std::uint8_t>;
+
 } // namespace livekit
@@ -16,14 +16,18 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
 
 #include "livekit/ffi_handle.h"
+#include "livekit/frame_pool.h"
+#include "livekit/native_video_buffer.h"
 
 namespace livekit {
 
-class VideoFrame;
-
 /**
  * Rotation of a video frame.
  *
@@ -39,6 +43,12 @@ enum class VideoRotation {
 /**
  * Represents a real-time video source that can accept frames from the
  * application and feed them into the LiveKit core.
+ *
+ * Frames are always raw pictures that WebRTC encodes with the codec chosen
+ * in TrackPublishOptions::video_codec. The FFI has no request for already
+ * encoded access units, so a pre-encoded feed has to be decoded first;
+ * deliver decoded frames as NativeVideoBuffer or VideoFrame::wrapExternal()
+ * to at least avoid copying them again.
  */
 class VideoSource {
 public:
@@ -52,7 +62,17 @@ public:
    * does not contain the expected new_video_source field.
    */
   VideoSource(int width, int height);
-  virtual ~VideoSource() = default;
+
+  /**
+   * Same as above, with a bound on frames queued by captureFrameAsync().
+   *
+   * @param queue_size_frames  Frames waiting to be handed to the FFI. When
+   *                           the queue is full, the oldest waiting frame is
+   *                           dropped (drop-oldest, like AudioSource's
+   *                           queue_size_ms). Must be >= 1.
+   */
+  VideoSource(int width, int height, std::size_t queue_size_frames);
+  virtual ~VideoSource();
 
   VideoSource(const VideoSource &) = delete;
   VideoSource &operator=(const VideoSource &) = delete;
@@ -77,14 +97,96 @@ public:
    * Notes:
    *   - Fire-and-forget to send a frame to FFI
    *     lifetime correctly (e.g., persistent frame pools, GPU buffers, etc.).
+   *   - Frames from VideoFrame::wrapExternal() go to the FFI with their own
+   *     plane pointers and strides; nothing is repacked or copied here.
    */
   void captureFrame(const VideoFrame &frame, std::int64_t timestamp_us = 0,
                     VideoRotation rotation = VideoRotation::VIDEO_ROTATION_0);
 
+  /**
+   * Same as above, tagging the frame with `metadata`, which a VideoStream
+   * opened with Options::read_metadata reports in VideoFrameEvent::metadata.
+   *
+   * The FFI has no per-frame side channel, so the tag is drawn into the
+   * picture as a black-and-white grid from the top-left corner (on a pooled
+   * copy; `frame` is untouched). Its cells are large enough to survive
+   * encoding, so the grid covers 80% of the frame width and a band one
+   * eighth of the width tall. Meant for test and measurement streams. A
+   * zero capture_wallclock_us is replaced by the current time.
+   *
+   * Throws std::invalid_argument if the format cannot carry a tag (I010) or
+   * the frame is narrower than 80 pixels or too short for its width.
+   */
+  void captureFrame(const VideoFrame &frame, const VideoFrameMetadata &metadata,
+                    std::int64_t timestamp_us = 0,
+                    VideoRotation rotation = VideoRotation::VIDEO_ROTATION_0);
+
+  /**
+   * Get a frame at the source resolution whose buffer comes from this
+   * source's frame pool. The buffer is recycled once the frame is destroyed,
+   * so a capture loop that acquires, fills and captures one frame per tick
+   * does not allocate in steady state. Recycled buffers are not zeroed.
+   */
+  VideoFrame acquireFrame(VideoBufferType type = VideoBufferType::I420);
+
+  /**
+   * Queue a frame for capture without blocking the calling thread.
+   *
+   * The frame is moved into the source and kept alive until the FFI has
+   * consumed it, so the caller can go on to acquire and fill the next frame
+   * while this one is being converted and encoded. Frames are delivered in
+   * order by a per-source worker thread.
+   *
+   * @return A future that becomes true once the FFI accepted the frame, or
+   *         false if it was dropped because the queue overflowed or the
+   *         source was destroyed first. FFI errors surface as exceptions
+   *         from future::get().
+   */
+  std::future<bool>
+  captureFrameAsync(VideoFrame &&frame, std::int64_t timestamp_us = 0,
+                    VideoRotation rotation = VideoRotation::VIDEO_ROTATION_0);
+
+  /// Frames queued by captureFrameAsync() and not yet consumed by the FFI.
+  std::size_t pendingFrames() const;
+
+  /**
+   * Capture a frame that lives in GPU or hardware-codec memory.
+   *
+   * The FFI capture request only takes CPU-addressable planes, so the
+   * buffer is mapped, never downloaded into a staging copy: the mapper set
+   * for buffer.kind (see setNativeBufferMapper()) produces the frame, and
+   * on Linux DMA-BUFs are mmapped in place by default. The mapping, and
+   * buffer.release, are released before this returns.
+   *
+   * Throws std::runtime_error if no mapper handles buffer.kind, or if the
+   * mapping or the FFI call fails.
+   */
+  void
+  captureNativeFrame(NativeVideoBuffer &&buffer, std::int64_t timestamp_us = 0,
+                     VideoRotation rotation = VideoRotation::VIDEO_ROTATION_0);
+
+  /// Map buffers of `kind` with `mapper` (e.g. a CUDA host mapping or
+  /// CVPixelBufferLockBaseAddress). For kDmaBuf this replaces the built-in
+  /// mmap; an empty mapper restores the default. Not synchronized with
+  /// captureNativeFrame(); set mappers before capturing.
+  void setNativeBufferMapper(NativeBufferKind kind, NativeBufferMapper mapper);
+
 private:
+  struct AsyncCapture;
+  // Owns the AsyncCapture once created; see asyncCapture().
+  struct AsyncSlot;
+
+  AsyncCapture *asyncCapture();
+
   FfiHandle handle_; // owned FFI handle
   int width_{0};
   int height_{0};
+  std::size_t queue_size_frames_{2};
+  VideoFramePool frame_pool_;
+  std::map<NativeBufferKind, NativeBufferMapper> native_mappers_;
+  // The AsyncCapture is created on first captureFrameAsync(); declared last
+  // so its worker stops before handle_ is released.
+  std::unique_ptr<AsyncSlot> async_;
 };
 
 } // namespace livekit
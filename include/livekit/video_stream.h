@@ -16,15 +16,21 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 #include "ffi_handle.h"
+#include "frame_pool.h"
 #include "participant.h"
+#include "stream_stats.h"
 #include "track.h"
 #include "video_frame.h"
 #include "video_source.h"
@@ -36,12 +42,23 @@ struct VideoFrameEvent {
   VideoFrame frame;
   std::int64_t timestamp_us;
   VideoRotation rotation;
+  // Tag passed to VideoSource::captureFrame() by the sender, if the stream
+  // was opened with Options::read_metadata and the frame carries one.
+  std::optional<VideoFrameMetadata> metadata;
 };
 
 namespace proto {
 class FfiEvent;
 }
 
+class RemoteTrackPublication;
+class SharedFrameRing;
+
+namespace detail {
+template <typename T> class SpscRing;
+class MediaStreamStatsRecorder;
+} // namespace detail
+
 // Represents a pull-based stream of decoded PCM audio frames coming from
 // a remote (or local) LiveKit track. Similar to VideoStream, but for audio.
 //
@@ -57,6 +74,11 @@ class FfiEvent;
 //
 //   stream->close();  // optional, called automatically in destructor
 //
+// Frames always arrive decoded: the FFI does not expose the received
+// compressed payloads, so there is no encoded-frame stream. Recorders can
+// still skip the copy out of the native buffer with Options::zero_copy, as
+// VideoRecorder does.
+//
 class VideoStream {
 public:
   struct Options {
@@ -70,6 +92,79 @@ public:
     // Preferred pixel format for frames delivered by read(). The FFI layer
     // converts into this format if supported (e.g., RGBA, BGRA, I420, ...).
     VideoBufferType format{VideoBufferType::RGBA};
+
+    // Frame-rate cap, by frame timestamp. A frame arriving sooner than
+    // 1/max_fps after the previously accepted one is released without
+    // touching its pixels and counts as dropped in stats(). 0 keeps every
+    // frame.
+    double max_fps{0};
+
+    // Downscale target. Larger frames are box-filtered to this size while
+    // being copied out of the FFI buffer, so no full-resolution copy is made.
+    // If one of the two is 0 it follows the frame's aspect ratio; both 0
+    // disables scaling. Frames are never upscaled. Needs a format supported
+    // by VideoFrame::scaleInto(); scaled frames are always copies, whatever
+    // zero_copy says.
+    int target_width{0};
+    int target_height{0};
+
+    // If true, frames delivered by read() wrap the Rust-owned buffer instead
+    // of being copied into a packed std::vector (see VideoFrame::isNative()).
+    // The native buffer is released when the VideoFrame is destroyed; call
+    // VideoFrame::toOwned() to keep a copy.
+    bool zero_copy{false};
+
+    // Pool supplying storage for copied frames (ignored when zero_copy is
+    // set). Frames return their buffer to the pool once destroyed. If null,
+    // the stream uses a private pool.
+    std::shared_ptr<VideoFramePool> frame_pool;
+
+    // If true and capacity > 0, frames are queued in a fixed-size lock-free
+    // single-producer/single-consumer ring instead of a mutex-guarded deque.
+    // Drop-oldest semantics are kept, and read() spins briefly before
+    // parking. Only one thread may read from the stream in this mode, and
+    // frames already queued when the stream reaches EOS are still delivered.
+    bool spsc_ring{false};
+
+    // If true, the stream keeps only the newest frame ("mailbox" mode): each
+    // arriving frame replaces the pending one, whose native buffer is
+    // released right away. The copy into a pooled frame (unless zero_copy is
+    // set) happens in read(), so frames the consumer never reads are never
+    // copied. Overrides capacity and spsc_ring; ignored in push mode.
+    bool latest_only{false};
+
+    // If true, frames are checked for a VideoFrameMetadata tag drawn by
+    // VideoSource::captureFrame(frame, metadata, ...), reported in
+    // VideoFrameEvent::metadata. Costs a read of the top-left corner per
+    // frame; the tag's pixels are left in the picture.
+    bool read_metadata{false};
+
+    // Optional push-mode delivery. If set, every frame is handed to this
+    // callback instead of being queued, and read() only ever reports the end
+    // of the stream. Saves the queue hop and reader wakeup per frame.
+    std::function<void(VideoFrameEvent &&)> on_frame;
+
+    // Push mode only: called once when the stream reaches EOS.
+    std::function<void()> on_eos;
+
+    // Push mode only: runs on_frame / on_eos. If empty, callbacks run inline
+    // on the FFI event thread and must not block.
+    std::function<void(std::function<void()>)> callback_executor;
+
+    // Adaptive stream: the remote publication behind this stream. When set,
+    // setRenderSize() asks the server for the simulcast layer that covers
+    // the on-screen size and pauses the track while it is hidden. A target
+    // size with both dimensions set is reported as the initial render size.
+    std::shared_ptr<RemoteTrackPublication> adaptive_publication;
+
+    // Shared-memory export: every admitted frame is copied from the FFI
+    // buffer straight into this ring (Kind::kVideo), before it is queued.
+    // Frames larger than the ring's slots are skipped.
+    std::shared_ptr<SharedFrameRing> export_ring;
+
+    // With export_ring: release each frame once exported instead of queuing
+    // it, so read() only reports EOS and no in-process copy is made.
+    bool export_only{false};
   };
 
   // Factory: create a VideoStream bound to a specific Track
@@ -96,6 +191,34 @@ public:
   ///         (end-of-stream or close()) and no more data is available.
   bool read(VideoFrameEvent &out);
 
+  /// Non-blocking read. Returns false immediately if no frame is queued; use
+  /// isEnded() to tell an empty queue from a finished stream.
+  bool tryRead(VideoFrameEvent &out);
+
+  /// Like read(), but waits at most `timeout` for a frame. Returns false on
+  /// timeout or once the stream has ended.
+  bool readFor(VideoFrameEvent &out, std::chrono::milliseconds timeout);
+
+  /// Non-blocking batch read: appends up to `max_events` queued frames to
+  /// `out` (taking the queue lock once) and returns how many were appended.
+  std::size_t readBatch(std::vector<VideoFrameEvent> &out,
+                        std::size_t max_events);
+
+  /// True once the stream was closed, or reached EOS and every queued frame
+  /// has been read.
+  bool isEnded() const;
+
+  /// Counters for this stream since it was created; safe to call from any
+  /// thread while frames flow.
+  MediaStreamStats stats() const;
+
+  /// Adaptive stream (see Options::adaptive_publication): report the size
+  /// frames are drawn at. 0x0 means hidden and pauses the track; a visible
+  /// size resumes it and requests the matching layer. Sizes within 1/8 of
+  /// the last one sent are not re-sent, so a window drag does not flood the
+  /// server. No-op without an adaptive publication.
+  void setRenderSize(int width, int height);
+
   /// Signal that we are no longer interested in video frames.
   ///
   /// This disposes the underlying FFI video stream, unregisters the listener
@@ -104,7 +227,7 @@ public:
   void close();
 
 private:
-  VideoStream() = default;
+  VideoStream();
 
   // Internal init helpers, used by the factories
   void initFromTrack(const std::shared_ptr<Track> &track,
@@ -112,20 +235,84 @@ private:
   void initFromParticipant(Participant &participant, TrackSource source,
                            const Options &options);
 
+  // Registers onFfiEvent with FfiClient, routed by stream_handle_. Must be
+  // called once the stream handle is known.
+  void subscribeToStreamEvents();
+
   // FFI event handler (registered with FfiClient)
   void onFfiEvent(const proto::FfiEvent &event);
 
+  // A queued frame and its arrival time, for MediaStreamStats::queue_time.
+  // `arrived` is the FFI event time, set only while latency tracing is on.
+  struct QueuedFrame {
+    VideoFrameEvent event;
+    std::chrono::steady_clock::time_point enqueued;
+    std::chrono::steady_clock::time_point arrived{};
+  };
+
   // Queue helpers
-  void pushFrame(VideoFrameEvent &&ev);
+  void pushFrame(VideoFrameEvent &&ev,
+                 std::chrono::steady_clock::time_point arrived = {});
   void pushEos();
+  // Push mode: hands `ev` to on_frame_ via the configured executor.
+  void deliverToCallback(VideoFrameEvent &&ev,
+                         std::chrono::steady_clock::time_point arrived);
+  // Moves a dequeued frame to the reader and records its queue time. In
+  // latest_only mode this is where the pending native frame gets copied.
+  void takeFrame(QueuedFrame &queued, VideoFrameEvent &out);
+  // Shared by both init helpers.
+  void applyOptions(const Options &options);
+  // max_fps: false if the frame at `timestamp_us` should be skipped. Only
+  // called from the FFI event thread.
+  bool admitFrame(std::int64_t timestamp_us);
+  // Size `frame` is delivered at; false if it needs no scaling.
+  bool scaledSize(const VideoFrame &frame, int &width, int &height) const;
+  // Copy of a native frame for the reader: scaled if needed, pooled.
+  VideoFrame materialize(const VideoFrame &native);
 
   mutable std::mutex mutex_;
   std::condition_variable cv_;
-  std::deque<VideoFrameEvent> queue_;
+  std::deque<QueuedFrame> queue_;
   std::size_t capacity_{0};
+  bool zero_copy_{false};
+  bool latest_only_{false};
+  bool read_metadata_{false};
+  std::shared_ptr<SharedFrameRing> export_ring_;
+  bool export_only_{false};
+  int target_width_{0};
+  int target_height_{0};
+
+  // max_fps decimation state (FFI event thread only).
+  std::int64_t frame_interval_us_{0};
+  std::int64_t next_frame_due_us_{0};
+  bool frame_due_set_{false};
+  std::shared_ptr<VideoFramePool> frame_pool_;
   bool eof_{false};
   bool closed_{false};
 
+  // Push-mode callbacks (Options::on_frame and friends).
+  std::function<void(VideoFrameEvent &&)> on_frame_;
+  std::function<void()> on_eos_;
+  std::function<void(std::function<void()>)> callback_executor_;
+
+  // Adaptive stream state, guarded by adaptive_mutex_ (FFI calls are made
+  // under it so reports stay ordered).
+  std::mutex adaptive_mutex_;
+  std::shared_ptr<RemoteTrackPublication> adaptive_publication_;
+  int reported_width_{-1};
+  int reported_height_{-1};
+
+  // Lock-free queue used instead of queue_ when Options::spsc_ring is set.
+  std::unique_ptr<detail::SpscRing<QueuedFrame>> ring_;
+
+  // Last queue depth, byte estimate and ring drop count reported to the
+  // SDK metrics.
+  std::atomic<std::int64_t> metrics_depth_{0};
+  std::atomic<std::int64_t> metrics_bytes_{0};
+  std::atomic<std::uint64_t> metrics_ring_dropped_{0};
+
+  std::unique_ptr<detail::MediaStreamStatsRecorder> stats_;
+
   // Underlying FFI handle for the video stream
   FfiHandle stream_handle_;
 
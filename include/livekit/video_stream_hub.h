@@ -0,0 +1,236 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "frame_pool.h"
+#include "participant.h"
+#include "stream_stats.h"
+#include "track.h"
+#include "video_frame.h"
+#include "video_source.h"
+#include "video_stream.h"
+
+namespace livekit {
+
+namespace detail {
+class MediaStreamStatsRecorder;
+} // namespace detail
+
+/**
+ * One received frame shared by every consumer of a VideoStreamHub.
+ *
+ * The source frame is immutable. Other formats are converted on first
+ * request and cached, so each distinct format costs one conversion per
+ * frame however many consumers ask for it. Conversions run on the thread
+ * that asks and are thread-safe.
+ */
+class SharedVideoFrame {
+public:
+  /// `pool`, if set, supplies storage for converted copies.
+  SharedVideoFrame(VideoFrame source, std::int64_t timestamp_us,
+                   VideoRotation rotation,
+                   std::shared_ptr<VideoFramePool> pool = nullptr);
+
+  SharedVideoFrame(const SharedVideoFrame &) = delete;
+  SharedVideoFrame &operator=(const SharedVideoFrame &) = delete;
+
+  /// The frame as received (a native buffer when it comes from a hub).
+  const std::shared_ptr<const VideoFrame> &source() const noexcept {
+    return source_;
+  }
+
+  /// This frame in `format`: the source itself if it already matches,
+  /// otherwise a cached conversion. Throws like VideoFrame::convert().
+  std::shared_ptr<const VideoFrame> as(VideoBufferType format) const;
+
+  std::int64_t timestampUs() const noexcept { return timestamp_us_; }
+  VideoRotation rotation() const noexcept { return rotation_; }
+
+private:
+  const std::shared_ptr<const VideoFrame> source_;
+  const std::int64_t timestamp_us_;
+  const VideoRotation rotation_;
+  const std::shared_ptr<VideoFramePool> pool_;
+
+  mutable std::mutex mutex_;
+  mutable std::map<VideoBufferType, std::shared_ptr<const VideoFrame>>
+      conversions_;
+};
+
+/// A frame delivered to one VideoStreamConsumer.
+struct SharedVideoFrameEvent {
+  /// The frame in the consumer's format; shared, never modify it.
+  std::shared_ptr<const VideoFrame> frame;
+  std::int64_t timestamp_us = 0;
+  VideoRotation rotation = VideoRotation::VIDEO_ROTATION_0;
+};
+
+/// What a consumer's full queue does with a new frame.
+enum class VideoConsumerPolicy {
+  kDropOldest, ///< Evict the oldest queued frame (favours freshness).
+  kDropNewest, ///< Discard the arriving frame (favours continuity).
+};
+
+/**
+ * One reader of a VideoStreamHub, with its own format and queue.
+ *
+ * A slow consumer only fills its own queue; it never delays the hub or the
+ * other consumers. Read calls mirror VideoStream's.
+ */
+class VideoStreamConsumer {
+public:
+  struct Options {
+    /// Format delivered by read(). Converted lazily, once per frame and
+    /// format across all consumers of the hub.
+    VideoBufferType format{VideoBufferType::RGBA};
+
+    /// Queued frames; 0 means unbounded. Queued frames keep the shared
+    /// native buffer alive, so keep this small.
+    std::size_t capacity{2};
+
+    VideoConsumerPolicy policy{VideoConsumerPolicy::kDropOldest};
+  };
+
+  ~VideoStreamConsumer();
+
+  VideoStreamConsumer(const VideoStreamConsumer &) = delete;
+  VideoStreamConsumer &operator=(const VideoStreamConsumer &) = delete;
+
+  /// Blocks for the next frame; false once closed or the hub ended.
+  bool read(SharedVideoFrameEvent &out);
+
+  /// Non-blocking read.
+  bool tryRead(SharedVideoFrameEvent &out);
+
+  /// Like read(), but waits at most `timeout`.
+  bool readFor(SharedVideoFrameEvent &out, std::chrono::milliseconds timeout);
+
+  /// True once closed, or the hub ended and the queue is drained.
+  bool isEnded() const;
+
+  MediaStreamStats stats() const;
+
+  /// Stop receiving frames and wake blocked readers. The hub forgets the
+  /// consumer on its next frame.
+  void close();
+
+  const Options &options() const noexcept { return options_; }
+
+private:
+  friend class VideoStreamHub;
+
+  explicit VideoStreamConsumer(Options options);
+
+  struct QueuedFrame {
+    std::shared_ptr<const SharedVideoFrame> frame;
+    std::chrono::steady_clock::time_point enqueued;
+  };
+
+  // Called by the hub on the FFI event thread. Returns false once closed.
+  bool deliver(const std::shared_ptr<const SharedVideoFrame> &frame);
+  void finish();
+
+  // Converts outside the lock and fills `out`.
+  void take(QueuedFrame &queued, SharedVideoFrameEvent &out);
+
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<QueuedFrame> queue_;
+  bool eof_{false};
+  bool closed_{false};
+
+  std::unique_ptr<detail::MediaStreamStatsRecorder> stats_;
+};
+
+/**
+ * Receives a video track once and fans it out to any number of consumers.
+ *
+ * Replaces one VideoStream per reader: there is a single FFI stream and
+ * listener. Each frame is held once, as a ref-counted native buffer, and
+ * converted at most once per distinct consumer format.
+ *
+ *   auto hub = VideoStreamHub::fromTrack(track, {});
+ *   auto render = hub->addConsumer({VideoBufferType::RGBA, 1});
+ *   auto record = hub->addConsumer({VideoBufferType::I420, 8,
+ *                                   VideoConsumerPolicy::kDropNewest});
+ */
+class VideoStreamHub {
+public:
+  struct Options {
+    /// Format requested from the FFI. Consumers asking for it get the
+    /// received buffer with no conversion at all.
+    VideoBufferType format{VideoBufferType::I420};
+
+    /// Storage for converted copies; a private pool if null.
+    std::shared_ptr<VideoFramePool> frame_pool;
+  };
+
+  static std::shared_ptr<VideoStreamHub>
+  fromTrack(const std::shared_ptr<Track> &track, const Options &options);
+
+  static std::shared_ptr<VideoStreamHub>
+  fromParticipant(Participant &participant, TrackSource track_source,
+                  const Options &options);
+
+  ~VideoStreamHub();
+
+  VideoStreamHub(const VideoStreamHub &) = delete;
+  VideoStreamHub &operator=(const VideoStreamHub &) = delete;
+
+  /// Adds a consumer; it sees frames that arrive from now on. The hub only
+  /// holds it weakly, and a consumer that outlives the hub reads as ended.
+  std::shared_ptr<VideoStreamConsumer>
+  addConsumer(const VideoStreamConsumer::Options &options);
+
+  /// Consumers currently attached (and not closed).
+  std::size_t consumerCount() const;
+
+  /// Stats of the underlying stream (frames received from the FFI).
+  MediaStreamStats stats() const;
+
+  /// Closes the FFI stream and ends every consumer.
+  void close();
+
+private:
+  explicit VideoStreamHub(const Options &options);
+  // Push-mode VideoStream options feeding onFrame() / onEos().
+  VideoStream::Options streamOptions(const Options &options);
+
+  void onFrame(VideoFrameEvent &&ev);
+  void onEos();
+
+  const std::shared_ptr<VideoFramePool> frame_pool_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::weak_ptr<VideoStreamConsumer>> consumers_;
+  bool ended_{false};
+
+  std::shared_ptr<VideoStream> stream_;
+};
+
+} // namespace livekit
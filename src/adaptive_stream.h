@@ -0,0 +1,71 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+#include "livekit/remote_track_publication.h"
+
+namespace livekit {
+namespace detail {
+
+// Dimensions RemoteTrackPublication::setVideoQuality() requests for a
+// publication of width x height (zero if unknown, taken as 720p): a
+// quarter, half or all of it for low, medium and high.
+inline std::pair<std::uint32_t, std::uint32_t>
+videoQualityDimensions(VideoQuality quality, std::uint32_t width,
+                       std::uint32_t height) {
+  const std::uint32_t full_w = width ? width : 1280;
+  const std::uint32_t full_h = height ? height : 720;
+  std::uint32_t divisor = 1;
+  switch (quality) {
+  case VideoQuality::QUALITY_LOW:
+    divisor = 4;
+    break;
+  case VideoQuality::QUALITY_MEDIUM:
+    divisor = 2;
+    break;
+  case VideoQuality::QUALITY_HIGH:
+    break;
+  }
+  return {full_w / divisor, full_h / divisor};
+}
+
+// What VideoStream::setRenderSize() sends upstream for a render size of
+// width x height, given the size it reported last (-1 before the first
+// report): nothing while visibility is unchanged and both edges are within
+// 1/8 of the reported ones, else a pause (0x0) or the new dimensions.
+enum class RenderSizeReport { kNone, kPause, kResize };
+
+inline RenderSizeReport renderSizeReport(int reported_width,
+                                         int reported_height, int width,
+                                         int height) {
+  const bool visible = width > 0 && height > 0;
+  const bool was_visible = reported_width > 0 && reported_height > 0;
+  auto near = [](int a, int b) { return std::abs(a - b) * 8 <= b; };
+  if (reported_width >= 0 && visible == was_visible &&
+      (!visible ||
+       (near(width, reported_width) && near(height, reported_height)))) {
+    return RenderSizeReport::kNone;
+  }
+  return visible ? RenderSizeReport::kResize : RenderSizeReport::kPause;
+}
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,384 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/apm_engine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "log.h"
+#include "spsc_ring.h"
+#include "thread_util.h"
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kNoPendingDelay = std::numeric_limits<int>::min();
+
+void checkFrame(const AudioFrame &frame, const char *what) {
+  if (frame.samples_per_channel() <= 0 ||
+      frame.samples_per_channel() * 100 != frame.sample_rate()) {
+    throw std::invalid_argument(std::string(what) +
+                                ": frame must hold exactly 10ms");
+  }
+}
+
+} // namespace
+
+struct ApmQueuedFrame {
+  AudioFrame frame;
+  Clock::time_point queued;
+};
+
+struct ApmStreamState {
+  ApmStreamState(std::shared_ptr<ApmWorkers> w, AudioProcessingModule &&m,
+                 ApmStream::ProcessedCallback cb, std::size_t capacity)
+      : workers(std::move(w)), apm(std::move(m)), on_processed(std::move(cb)),
+        capture(capacity), render(capacity) {}
+
+  const std::shared_ptr<ApmWorkers> workers;
+  AudioProcessingModule apm;
+  const ApmStream::ProcessedCallback on_processed;
+  SpscRing<ApmQueuedFrame> capture;
+  SpscRing<ApmQueuedFrame> render;
+
+  // Set while the stream sits in the ready queue or is being drained, so
+  // exactly one worker owns the consumer side of both rings.
+  std::atomic<bool> scheduled{false};
+  std::atomic<int> pending_delay_ms{kNoPendingDelay};
+
+  // Guards closed/busy, so ~ApmStream can wait out a running batch.
+  std::mutex busy_mutex;
+  std::condition_variable busy_cv;
+  bool closed = false;
+  bool busy = false;
+
+  // Worker-owned scratch, reused across batches.
+  std::vector<AudioFrame> batch;
+  std::vector<Clock::time_point> queued;
+
+  // Written only by the worker that owns the stream.
+  std::atomic<std::uint64_t> processed_frames{0};
+  std::atomic<std::uint64_t> render_frames{0};
+  std::atomic<std::uint64_t> dropped_frames{0};
+  std::atomic<std::uint64_t> errors{0};
+  std::atomic<std::int64_t> latency_total_us{0};
+  std::atomic<std::int64_t> latency_last_us{0};
+  std::atomic<std::int64_t> latency_max_us{0};
+};
+
+// Ready queue of streams with queued frames, drained by a fixed set of
+// threads. A stream is queued once per idle-to-busy transition, never per
+// frame, so producers only touch the mutex when a stream wakes up.
+class ApmWorkers {
+public:
+  explicit ApmWorkers(const ApmEngine::Options &options)
+      : max_queued_frames(std::max<std::size_t>(options.max_queued_frames, 1)),
+        max_batch_frames(std::max<std::size_t>(options.max_batch_frames, 1)) {
+    std::size_t threads = options.threads;
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this] {
+        detail::registerThread(ThreadRole::kAudio, "lk-apm");
+        run();
+      });
+    }
+  }
+
+  ~ApmWorkers() { stop(); }
+
+  ApmWorkers(const ApmWorkers &) = delete;
+  ApmWorkers &operator=(const ApmWorkers &) = delete;
+
+  // Joins the workers; streams still queued are dropped from the queue.
+  void stop() {
+    std::deque<std::shared_ptr<ApmStreamState>> abandoned;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopping_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      stopping_.store(true, std::memory_order_release);
+      abandoned.swap(ready_);
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  // Lock-free, as push() asks on every frame.
+  bool stopped() const noexcept {
+    return stopping_.load(std::memory_order_acquire);
+  }
+
+  void schedule(std::shared_ptr<ApmStreamState> stream) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopping_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      ready_.push_back(std::move(stream));
+    }
+    cv_.notify_one();
+  }
+
+  std::size_t threadCount() const noexcept { return workers_.size(); }
+
+  const std::size_t max_queued_frames;
+  const std::size_t max_batch_frames;
+  std::atomic<std::size_t> streams{0};
+
+private:
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      cv_.wait(lock, [this] {
+        return stopping_.load(std::memory_order_relaxed) || !ready_.empty();
+      });
+      if (stopping_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      std::shared_ptr<ApmStreamState> stream = std::move(ready_.front());
+      ready_.pop_front();
+      lock.unlock();
+      drain(stream);
+      stream.reset();
+      lock.lock();
+    }
+  }
+
+  void drain(const std::shared_ptr<ApmStreamState> &stream) {
+    ApmStreamState &s = *stream;
+    {
+      std::lock_guard<std::mutex> lock(s.busy_mutex);
+      if (s.closed) {
+        return; // stays scheduled, so it is never queued again
+      }
+      s.busy = true;
+    }
+    const int delay_ms =
+        s.pending_delay_ms.exchange(kNoPendingDelay, std::memory_order_acq_rel);
+    if (delay_ms != kNoPendingDelay) {
+      try {
+        s.apm.setStreamDelayMs(delay_ms);
+      } catch (const std::exception &e) {
+        s.errors.fetch_add(1, std::memory_order_relaxed);
+        LK_LOG_WARN("livekit::apm_engine", "setStreamDelayMs failed: %s",
+                    e.what());
+      }
+    }
+    // The echo canceller needs the far end before the matching near end.
+    processBatch(s, s.render, /*reverse=*/true);
+    processBatch(s, s.capture, /*reverse=*/false);
+    {
+      std::lock_guard<std::mutex> lock(s.busy_mutex);
+      s.busy = false;
+    }
+    s.busy_cv.notify_all();
+
+    // Pairs with the fence in ApmStream::push(): either the producer sees
+    // the flag cleared and queues the stream, or we see its frame here.
+    s.scheduled.store(false, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if ((s.render.size() != 0 || s.capture.size() != 0) &&
+        !s.scheduled.exchange(true, std::memory_order_acq_rel)) {
+      // Back of the queue, so one busy stream cannot starve the others.
+      schedule(stream);
+    }
+  }
+
+  void processBatch(ApmStreamState &s, SpscRing<ApmQueuedFrame> &ring,
+                    bool reverse) {
+    s.batch.clear();
+    s.queued.clear();
+    ApmQueuedFrame item;
+    while (s.batch.size() < max_batch_frames && ring.tryPop(item)) {
+      s.batch.push_back(std::move(item.frame));
+      s.queued.push_back(item.queued);
+    }
+    if (s.batch.empty()) {
+      return;
+    }
+    try {
+      if (reverse) {
+        s.apm.processReverseStreamBatch(s.batch);
+      } else {
+        s.apm.processStreamBatch(s.batch);
+      }
+    } catch (const std::exception &e) {
+      s.errors.fetch_add(1, std::memory_order_relaxed);
+      LK_LOG_WARN("livekit::apm_engine", "APM batch of %zu frames failed: %s",
+                  s.batch.size(), e.what());
+      return;
+    }
+    if (reverse) {
+      s.render_frames.fetch_add(s.batch.size(), std::memory_order_relaxed);
+      return;
+    }
+
+    const Clock::time_point done = Clock::now();
+    for (std::size_t i = 0; i < s.batch.size(); ++i) {
+      const std::int64_t us =
+          std::chrono::duration_cast<std::chrono::microseconds>(done -
+                                                                s.queued[i])
+              .count();
+      s.latency_last_us.store(us, std::memory_order_relaxed);
+      s.latency_total_us.fetch_add(us, std::memory_order_relaxed);
+      if (us > s.latency_max_us.load(std::memory_order_relaxed)) {
+        s.latency_max_us.store(us, std::memory_order_relaxed);
+      }
+      s.processed_frames.fetch_add(1, std::memory_order_relaxed);
+      if (!s.on_processed) {
+        continue;
+      }
+      try {
+        s.on_processed(s.batch[i]);
+      } catch (const std::exception &e) {
+        LK_LOG_ERROR("livekit::apm_engine", "on_processed threw: %s",
+                     e.what());
+      }
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<ApmStreamState>> ready_;
+  // Written under mutex_, which also orders it against ready_; read without
+  // it by stopped().
+  std::atomic<bool> stopping_{false};
+  std::vector<std::thread> workers_;
+};
+
+} // namespace detail
+
+// ============================================================================
+// ApmStream
+// ============================================================================
+
+namespace {
+
+bool push(const std::shared_ptr<detail::ApmStreamState> &state,
+          detail::SpscRing<detail::ApmQueuedFrame> &ring, AudioFrame &&frame) {
+  detail::ApmStreamState &s = *state;
+  // Checking the size first keeps the ring from ever skipping queued audio.
+  if (ring.size() >= ring.capacity() || s.workers->stopped()) {
+    s.dropped_frames.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  ring.push(detail::ApmQueuedFrame{std::move(frame),
+                                   std::chrono::steady_clock::now()});
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!s.scheduled.exchange(true, std::memory_order_acq_rel)) {
+    s.workers->schedule(state);
+  }
+  return true;
+}
+
+} // namespace
+
+ApmStream::ApmStream(std::shared_ptr<detail::ApmStreamState> state)
+    : state_(std::move(state)) {}
+
+ApmStream::~ApmStream() {
+  {
+    std::unique_lock<std::mutex> lock(state_->busy_mutex);
+    state_->closed = true;
+    state_->busy_cv.wait(lock, [this] { return !state_->busy; });
+  }
+  state_->workers->streams.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool ApmStream::pushCapture(AudioFrame &&frame) {
+  detail::checkFrame(frame, "ApmStream::pushCapture");
+  return push(state_, state_->capture, std::move(frame));
+}
+
+bool ApmStream::pushRender(AudioFrame &&frame) {
+  detail::checkFrame(frame, "ApmStream::pushRender");
+  return push(state_, state_->render, std::move(frame));
+}
+
+void ApmStream::setStreamDelayMs(int delay_ms) {
+  state_->pending_delay_ms.store(delay_ms, std::memory_order_release);
+}
+
+ApmStreamStats ApmStream::stats() const {
+  const detail::ApmStreamState &s = *state_;
+  ApmStreamStats out;
+  out.processed_frames = s.processed_frames.load(std::memory_order_relaxed);
+  out.render_frames = s.render_frames.load(std::memory_order_relaxed);
+  out.dropped_frames = s.dropped_frames.load(std::memory_order_relaxed);
+  out.errors = s.errors.load(std::memory_order_relaxed);
+  out.queued_frames = s.capture.size() + s.render.size();
+  out.last_latency = std::chrono::microseconds(
+      s.latency_last_us.load(std::memory_order_relaxed));
+  out.max_latency = std::chrono::microseconds(
+      s.latency_max_us.load(std::memory_order_relaxed));
+  if (out.processed_frames != 0) {
+    out.mean_latency = std::chrono::microseconds(
+        s.latency_total_us.load(std::memory_order_relaxed) /
+        static_cast<std::int64_t>(out.processed_frames));
+  }
+  return out;
+}
+
+// ============================================================================
+// ApmEngine
+// ============================================================================
+
+ApmEngine::ApmEngine() : ApmEngine(Options{}) {}
+
+ApmEngine::ApmEngine(const Options &options)
+    : workers_(std::make_shared<detail::ApmWorkers>(options)) {}
+
+ApmEngine::~ApmEngine() { workers_->stop(); }
+
+std::unique_ptr<ApmStream> ApmEngine::addStream(StreamOptions options) {
+  AudioProcessingModule apm(options.apm);
+  auto state = std::make_shared<detail::ApmStreamState>(
+      workers_, std::move(apm), std::move(options.on_processed),
+      workers_->max_queued_frames);
+  workers_->streams.fetch_add(1, std::memory_order_relaxed);
+  return std::unique_ptr<ApmStream>(new ApmStream(std::move(state)));
+}
+
+std::size_t ApmEngine::threadCount() const noexcept {
+  return workers_->threadCount();
+}
+
+std::size_t ApmEngine::streamCount() const noexcept {
+  return workers_->streams.load(std::memory_order_relaxed);
+}
+
+} // namespace livekit
@@ -18,16 +18,55 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
 
 #include "audio_frame.pb.h"
+#include "audio_simd.h"
 #include "handle.pb.h"
 #include "livekit/ffi_handle.h"
+#include "livekit/frame_pool.h"
 
 namespace livekit {
 
+namespace {
+
+FloatAudioFrame toFloat(const std::int16_t *src, int sample_rate,
+                        int num_channels, int samples_per_channel,
+                        AudioSampleLayout layout) {
+  FloatAudioFrame out = FloatAudioFrame::create(
+      sample_rate, num_channels, samples_per_channel, layout);
+  if (src == nullptr || out.total_samples() == 0) {
+    return out;
+  }
+  if (layout == AudioSampleLayout::kPlanar) {
+    detail::deinterleaveInt16ToFloat(
+        src, out.data().data(), num_channels,
+        static_cast<std::size_t>(samples_per_channel));
+  } else {
+    detail::int16ToFloat(src, out.data().data(), out.total_samples());
+  }
+  return out;
+}
+
+// `dst` holds src.total_samples() interleaved samples.
+void toInt16(const FloatAudioFrame &src, std::int16_t *dst) {
+  if (src.total_samples() == 0) {
+    return;
+  }
+  if (src.layout() == AudioSampleLayout::kPlanar) {
+    detail::interleaveFloatToInt16(
+        src.data().data(), dst, src.num_channels(),
+        static_cast<std::size_t>(src.samples_per_channel()));
+  } else {
+    detail::floatToInt16(src.data().data(), dst, src.total_samples());
+  }
+}
+
+} // namespace
+
 AudioFrame::AudioFrame()
     : sample_rate_(0), num_channels_(0), samples_per_channel_(0) {}
 
@@ -49,6 +88,26 @@ AudioFrame::AudioFrame(std::vector<std::int16_t> data, int sample_rate,
   }
 }
 
+AudioFrame::~AudioFrame() {
+  if (auto pool = pool_.lock()) {
+    pool->recycle(std::move(data_));
+  }
+}
+
+AudioFrame &AudioFrame::operator=(AudioFrame &&other) noexcept {
+  if (this != &other) {
+    if (auto pool = pool_.lock()) {
+      pool->recycle(std::move(data_));
+    }
+    data_ = std::move(other.data_);
+    sample_rate_ = other.sample_rate_;
+    num_channels_ = other.num_channels_;
+    samples_per_channel_ = other.samples_per_channel_;
+    pool_ = std::move(other.pool_);
+  }
+  return *this;
+}
+
 AudioFrame AudioFrame::create(int sample_rate, int num_channels,
                               int samples_per_channel) {
   const std::size_t count = static_cast<std::size_t>(num_channels) *
@@ -60,36 +119,9 @@ AudioFrame AudioFrame::create(int sample_rate, int num_channels,
 
 AudioFrame
 AudioFrame::fromOwnedInfo(const proto::OwnedAudioFrameBuffer &owned) {
-  const auto &info = owned.info();
-
-  const int num_channels = static_cast<int>(info.num_channels());
-  const int samples_per_channel = static_cast<int>(info.samples_per_channel());
-  const int sample_rate = static_cast<int>(info.sample_rate());
-
-  const std::size_t count = static_cast<std::size_t>(num_channels) *
-                            static_cast<std::size_t>(samples_per_channel);
-
-  const std::int16_t *ptr =
-      reinterpret_cast<const std::int16_t *>(info.data_ptr());
-
-  if (ptr == nullptr && count > 0) {
-    throw std::runtime_error(
-        "AudioFrame::fromOwnedInfo: null data_ptr with nonzero size");
-  }
-
-  std::vector<std::int16_t> data;
-  if (count > 0) {
-    data.assign(ptr, ptr + count);
-  }
-
-  {
-    FfiHandle guard(static_cast<uintptr_t>(owned.handle().id()));
-    // guard is destroyed at end of scope, which should call into the FFI to
-    // drop the OwnedAudioFrameBuffer.
-  }
-
-  return AudioFrame(std::move(data), sample_rate, num_channels,
-                    samples_per_channel);
+  // The temporary view drops the OwnedAudioFrameBuffer once the samples have
+  // been copied out.
+  return AudioFrameView::fromOwnedInfo(owned).toFrame();
 }
 
 proto::AudioFrameBufferInfo AudioFrame::toProto() const {
@@ -113,6 +145,42 @@ double AudioFrame::duration() const noexcept {
          static_cast<double>(sample_rate_);
 }
 
+AudioFrame AudioFrame::remix(int num_channels) const {
+  if (num_channels <= 0) {
+    throw std::invalid_argument("AudioFrame::remix: num_channels must be > 0");
+  }
+  if (num_channels == num_channels_ || num_channels_ <= 0) {
+    AudioFrame copy = *this;
+    copy.pool_.reset();
+    return copy;
+  }
+
+  const std::size_t frames = static_cast<std::size_t>(samples_per_channel_);
+  const std::size_t in_ch = static_cast<std::size_t>(num_channels_);
+  const std::size_t out_ch = static_cast<std::size_t>(num_channels);
+  std::vector<std::int16_t> out(frames * out_ch);
+  const std::int16_t *in = data_.data();
+
+  if (out_ch == 1) {
+    const std::int32_t divisor = static_cast<std::int32_t>(in_ch);
+    for (std::size_t f = 0; f < frames; ++f) {
+      std::int32_t sum = 0;
+      for (std::size_t c = 0; c < in_ch; ++c) {
+        sum += in[f * in_ch + c];
+      }
+      out[f] = static_cast<std::int16_t>(sum / divisor);
+    }
+  } else {
+    for (std::size_t f = 0; f < frames; ++f) {
+      for (std::size_t c = 0; c < out_ch; ++c) {
+        out[f * out_ch + c] = in[f * in_ch + c % in_ch];
+      }
+    }
+  }
+  return AudioFrame(std::move(out), sample_rate_, num_channels,
+                    samples_per_channel_);
+}
+
 std::string AudioFrame::to_string() const {
   std::ostringstream oss;
   oss << "rtc.AudioFrame(sample_rate=" << sample_rate_
@@ -123,4 +191,212 @@ std::string AudioFrame::to_string() const {
   return oss.str();
 }
 
+// ----------------------------------------------------------------------------
+// FloatAudioFrame
+// ----------------------------------------------------------------------------
+
+FloatAudioFrame::FloatAudioFrame()
+    : sample_rate_(0), num_channels_(0), samples_per_channel_(0),
+      layout_(AudioSampleLayout::kInterleaved) {}
+
+FloatAudioFrame::FloatAudioFrame(std::vector<float> data, int sample_rate,
+                                 int num_channels, int samples_per_channel,
+                                 AudioSampleLayout layout)
+    : data_(std::move(data)), sample_rate_(sample_rate),
+      num_channels_(num_channels), samples_per_channel_(samples_per_channel),
+      layout_(layout) {
+  if (num_channels_ < 0 || samples_per_channel_ < 0) {
+    throw std::invalid_argument(
+        "FloatAudioFrame: negative channel or sample count");
+  }
+  const std::size_t expected = static_cast<std::size_t>(num_channels_) *
+                               static_cast<std::size_t>(samples_per_channel_);
+  if (data_.size() != expected) {
+    throw std::invalid_argument(
+        "FloatAudioFrame: data size must be num_channels * "
+        "samples_per_channel");
+  }
+}
+
+FloatAudioFrame FloatAudioFrame::create(int sample_rate, int num_channels,
+                                        int samples_per_channel,
+                                        AudioSampleLayout layout) {
+  const std::size_t count = static_cast<std::size_t>(num_channels) *
+                            static_cast<std::size_t>(samples_per_channel);
+  return FloatAudioFrame(std::vector<float>(count, 0.0f), sample_rate,
+                         num_channels, samples_per_channel, layout);
+}
+
+FloatAudioFrame FloatAudioFrame::fromFrame(const AudioFrame &frame,
+                                           AudioSampleLayout layout) {
+  // AudioFrame tolerates trailing samples; only the first frame counts.
+  return toFloat(frame.data().data(), frame.sample_rate(),
+                 frame.num_channels(), frame.samples_per_channel(), layout);
+}
+
+double FloatAudioFrame::duration() const noexcept {
+  if (sample_rate_ <= 0) {
+    return 0.0;
+  }
+  return static_cast<double>(samples_per_channel_) /
+         static_cast<double>(sample_rate_);
+}
+
+float *FloatAudioFrame::channel(int c) {
+  return const_cast<float *>(
+      static_cast<const FloatAudioFrame *>(this)->channel(c));
+}
+
+const float *FloatAudioFrame::channel(int c) const {
+  if (layout_ != AudioSampleLayout::kPlanar) {
+    throw std::invalid_argument(
+        "FloatAudioFrame::channel: frame is not planar");
+  }
+  if (c < 0 || c >= num_channels_) {
+    throw std::invalid_argument(
+        "FloatAudioFrame::channel: channel out of range");
+  }
+  return data_.data() + static_cast<std::size_t>(c) *
+                            static_cast<std::size_t>(samples_per_channel_);
+}
+
+AudioFrame FloatAudioFrame::toFrame() const {
+  AudioFrame frame =
+      AudioFrame::create(sample_rate_, num_channels_, samples_per_channel_);
+  toInt16(*this, frame.data().data());
+  return frame;
+}
+
+AudioFrame FloatAudioFrame::toFrame(AudioFramePool &pool) const {
+  AudioFrame frame =
+      pool.acquire(sample_rate_, num_channels_, samples_per_channel_);
+  toInt16(*this, frame.data().data());
+  return frame;
+}
+
+std::string FloatAudioFrame::to_string() const {
+  std::ostringstream oss;
+  oss << "rtc.FloatAudioFrame(sample_rate=" << sample_rate_
+      << ", num_channels=" << num_channels_
+      << ", samples_per_channel=" << samples_per_channel_ << ", layout="
+      << (layout_ == AudioSampleLayout::kPlanar ? "planar" : "interleaved")
+      << ", duration=" << std::fixed << std::setprecision(3) << duration()
+      << ")";
+  return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// AudioFrameView
+// ----------------------------------------------------------------------------
+
+AudioFrameView::AudioFrameView(AudioFrameView &&other) noexcept
+    : handle_(std::move(other.handle_)), data_(other.data_),
+      sample_rate_(other.sample_rate_), num_channels_(other.num_channels_),
+      samples_per_channel_(other.samples_per_channel_) {
+  other.data_ = nullptr;
+  other.num_channels_ = 0;
+  other.samples_per_channel_ = 0;
+}
+
+AudioFrameView &AudioFrameView::operator=(AudioFrameView &&other) noexcept {
+  if (this != &other) {
+    handle_ = std::move(other.handle_);
+    data_ = other.data_;
+    sample_rate_ = other.sample_rate_;
+    num_channels_ = other.num_channels_;
+    samples_per_channel_ = other.samples_per_channel_;
+    other.data_ = nullptr;
+    other.num_channels_ = 0;
+    other.samples_per_channel_ = 0;
+  }
+  return *this;
+}
+
+AudioFrameView
+AudioFrameView::fromOwnedInfo(const proto::OwnedAudioFrameBuffer &owned) {
+  const auto &info = owned.info();
+
+  AudioFrameView view;
+  // Take ownership first so the buffer is dropped even if validation throws.
+  view.handle_ = FfiHandle(static_cast<uintptr_t>(owned.handle().id()),
+                           ResourceKind::kAudioBuffer,
+                           FfiHandle::Disposal::kDeferrable);
+  view.num_channels_ = static_cast<int>(info.num_channels());
+  view.samples_per_channel_ = static_cast<int>(info.samples_per_channel());
+  view.sample_rate_ = static_cast<int>(info.sample_rate());
+  view.data_ = reinterpret_cast<const std::int16_t *>(info.data_ptr());
+
+  if (view.data_ == nullptr && view.total_samples() > 0) {
+    throw std::runtime_error(
+        "AudioFrameView::fromOwnedInfo: null data_ptr with nonzero size");
+  }
+  return view;
+}
+
+double AudioFrameView::duration() const noexcept {
+  if (sample_rate_ <= 0) {
+    return 0.0;
+  }
+  return static_cast<double>(samples_per_channel_) /
+         static_cast<double>(sample_rate_);
+}
+
+AudioFrame AudioFrameView::toFrame() const {
+  const std::size_t count = total_samples();
+  std::vector<std::int16_t> data;
+  if (count > 0 && data_ != nullptr) {
+    data.assign(data_, data_ + count);
+  } else {
+    data.resize(count, 0);
+  }
+  return AudioFrame(std::move(data), sample_rate_, num_channels_,
+                    samples_per_channel_);
+}
+
+AudioFrame AudioFrameView::toFrame(AudioFramePool &pool) const {
+  AudioFrame frame =
+      pool.acquire(sample_rate_, num_channels_, samples_per_channel_);
+  const std::size_t count = total_samples();
+  if (count > 0 && data_ != nullptr) {
+    std::memcpy(frame.data().data(), data_, count * sizeof(std::int16_t));
+  }
+  return frame;
+}
+
+FloatAudioFrame AudioFrameView::toFloatFrame(AudioSampleLayout layout) const {
+  return toFloat(data_, sample_rate_, num_channels_, samples_per_channel_,
+                 layout);
+}
+
+void AudioFrameView::release() noexcept {
+  handle_.reset();
+  data_ = nullptr;
+  num_channels_ = 0;
+  samples_per_channel_ = 0;
+}
+
+// ----------------------------------------------------------------------------
+// AudioFramePool
+// ----------------------------------------------------------------------------
+
+AudioFramePool::AudioFramePool(std::size_t max_buffers_per_bucket)
+    : pool_(std::make_shared<detail::FrameBufferPool<std::int16_t>>(
+          max_buffers_per_bucket)) {}
+
+AudioFrame AudioFramePool::acquire(int sample_rate, int num_channels,
+                                   int samples_per_channel) {
+  const std::size_t count = static_cast<std::size_t>(num_channels) *
+                            static_cast<std::size_t>(samples_per_channel);
+  AudioFrame frame(pool_->acquire(count), sample_rate, num_channels,
+                   samples_per_channel);
+  frame.pool_ = pool_;
+  return frame;
+}
+
+std::size_t AudioFramePool::cachedBuffers() const {
+  return pool_->cachedBuffers();
+}
+
+void AudioFramePool::clear() { pool_->clear(); }
+
 } // namespace livekit
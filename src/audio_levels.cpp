@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "audio_levels.h"
+
+#include "audio_simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace livekit {
+namespace detail {
+
+AudioLevels measureLevels(const std::int16_t *samples,
+                          std::size_t count) noexcept {
+  AudioLevels levels;
+  if (count == 0 || samples == nullptr) {
+    return levels;
+  }
+  std::uint64_t sum_squares = 0;
+  int peak = 0;
+  sumSquaresPeakInt16(samples, count, sum_squares, peak);
+  levels.rms = static_cast<float>(
+      std::sqrt(static_cast<double>(sum_squares) / static_cast<double>(count)) /
+      32768.0);
+  levels.peak = static_cast<float>(peak) / 32767.0f;
+  return levels;
+}
+
+bool VoiceDetector::update(float rms, double frame_ms) noexcept {
+  const float db = 20.0f * std::log10(std::max(rms, 1e-6f));
+  const float rise =
+      kFloorRiseDbPerSecond * static_cast<float>(frame_ms / 1000.0);
+  floor_db_ = std::min(db, floor_db_ + rise);
+
+  const bool active = db >= kMinVoiceDbfs && db >= floor_db_ + threshold_db_;
+  if (active) {
+    hold_ms_ = hangover_ms_;
+    return true;
+  }
+  hold_ms_ = std::max(0.0, hold_ms_ - frame_ms);
+  return hold_ms_ > 0.0;
+}
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/audio_stream.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace livekit {
+namespace detail {
+
+// RMS and peak of interleaved samples across all channels, normalized to
+// [0, 1]; `voice` is left false.
+AudioLevels measureLevels(const std::int16_t *samples,
+                          std::size_t count) noexcept;
+
+// Energy VAD used by AudioStream::Options::detect_voice.
+//
+// Tracks the noise floor, starting at kInitialFloorDbfs: it follows quieter
+// frames down at once and creeps up by kFloorRiseDbPerSecond otherwise, so
+// steady background noise is learned within seconds while speech pauses
+// keep pulling it back. A frame is voice when its RMS sits `threshold_db`
+// above the floor and above kMinVoiceDbfs; the decision is held for
+// `hangover_ms` so gaps between words are not cut out.
+class VoiceDetector {
+public:
+  static constexpr float kInitialFloorDbfs = -60.0f;
+  static constexpr float kFloorRiseDbPerSecond = 3.0f;
+  static constexpr float kMinVoiceDbfs = -55.0f;
+
+  VoiceDetector(float threshold_db, int hangover_ms) noexcept
+      : threshold_db_(threshold_db), hangover_ms_(hangover_ms) {}
+
+  bool update(float rms, double frame_ms) noexcept;
+
+private:
+  float threshold_db_;
+  int hangover_ms_;
+  float floor_db_ = kInitialFloorDbfs;
+  double hold_ms_ = 0.0;
+};
+
+} // namespace detail
+} // namespace livekit
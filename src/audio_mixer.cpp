@@ -0,0 +1,159 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/audio_mixer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "audio_simd.h"
+#include "livekit/audio_stream.h"
+
+namespace livekit {
+
+AudioMixer::AudioMixer() : AudioMixer(Options{}) {}
+
+AudioMixer::AudioMixer(const Options &options) : options_(options) {
+  if (options_.sample_rate <= 0 || options_.num_channels <= 0 ||
+      options_.frame_duration_ms <= 0) {
+    throw std::invalid_argument(
+        "AudioMixer: sample_rate, num_channels and frame_duration_ms must be "
+        "positive");
+  }
+  samples_per_channel_ =
+      options_.sample_rate * options_.frame_duration_ms / 1000;
+  const int buffered_ms =
+      std::max(options_.max_buffered_ms, options_.frame_duration_ms);
+  max_buffered_samples_ =
+      static_cast<std::size_t>(options_.sample_rate) * buffered_ms / 1000 *
+      static_cast<std::size_t>(options_.num_channels);
+}
+
+AudioMixer::~AudioMixer() = default;
+
+AudioMixer::InputId AudioMixer::addStream(std::shared_ptr<AudioStream> stream) {
+  if (!stream) {
+    throw std::invalid_argument("AudioMixer::addStream: stream is null");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  const InputId id = next_id_++;
+  inputs_[id].stream = std::move(stream);
+  return id;
+}
+
+AudioMixer::InputId AudioMixer::addInput() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const InputId id = next_id_++;
+  inputs_[id];
+  return id;
+}
+
+void AudioMixer::pushFrame(InputId id, const AudioFrame &frame) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = inputs_.find(id);
+  if (it == inputs_.end()) {
+    return;
+  }
+  if (!acceptsFormat(frame.sample_rate(), frame.num_channels())) {
+    ++dropped_frames_;
+    return;
+  }
+  appendLocked(it->second, frame.data().data(), frame.total_samples());
+}
+
+void AudioMixer::removeInput(InputId id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  inputs_.erase(id);
+}
+
+std::size_t AudioMixer::inputCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return inputs_.size();
+}
+
+std::uint64_t AudioMixer::droppedFrames() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_frames_;
+}
+
+AudioFrame AudioMixer::mix() {
+  AudioFrame out = pool_.acquire(options_.sample_rate, options_.num_channels,
+                                 samples_per_channel_);
+  std::int16_t *dst = out.data().data();
+  const std::size_t needed = out.total_samples();
+  std::memset(dst, 0, needed * sizeof(std::int16_t));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = inputs_.begin(); it != inputs_.end();) {
+    Input &input = it->second;
+    if (input.stream) {
+      AudioFrameViewEvent ev;
+      while (input.stream->tryRead(ev)) {
+        if (acceptsFormat(ev.frame.sample_rate(), ev.frame.num_channels())) {
+          appendLocked(input, ev.frame.data(), ev.frame.total_samples());
+        } else {
+          ++dropped_frames_;
+        }
+      }
+    }
+
+    // Underrun: mix what we have; the rest of the tick stays silent.
+    const std::size_t n = std::min(needed, input.pending.size());
+    if (n > 0) {
+      detail::addSaturateInt16(dst, input.pending.data(), n);
+      input.pending.erase(input.pending.begin(),
+                          input.pending.begin() +
+                              static_cast<std::ptrdiff_t>(n));
+    }
+
+    if (input.stream && input.pending.empty() && input.stream->isEnded()) {
+      it = inputs_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return out;
+}
+
+void AudioMixer::appendLocked(Input &input, const std::int16_t *data,
+                              std::size_t samples) {
+  if (samples == 0) {
+    return;
+  }
+  if (samples >= max_buffered_samples_) {
+    // A single oversized frame: keep only its newest part.
+    data += samples - max_buffered_samples_;
+    samples = max_buffered_samples_;
+    input.pending.clear();
+  } else if (input.pending.size() + samples > max_buffered_samples_) {
+    const std::size_t excess =
+        input.pending.size() + samples - max_buffered_samples_;
+    input.pending.erase(input.pending.begin(),
+                        input.pending.begin() +
+                            static_cast<std::ptrdiff_t>(excess));
+  }
+  input.pending.insert(input.pending.end(), data, data + samples);
+}
+
+bool AudioMixer::acceptsFormat(int sample_rate,
+                               int num_channels) const noexcept {
+  return sample_rate == options_.sample_rate &&
+         num_channels == options_.num_channels;
+}
+
+} // namespace livekit
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/audio_pipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "livekit/audio_source.h"
+
+namespace livekit {
+
+namespace {
+
+// Smoothing for the measured delay, and how far it must drift before the
+// APM is updated (AEC3 tolerates small errors; frequent resets do not help).
+constexpr double kDelaySmoothing = 0.1;
+constexpr int kDelayHysteresisMs = 2;
+
+double millisBetween(AudioPipeline::Clock::time_point from,
+                     AudioPipeline::Clock::time_point to) {
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+AudioMixer::Options mixerOptions(const AudioPipeline::Options &options) {
+  AudioMixer::Options mixer;
+  mixer.sample_rate = options.sample_rate;
+  mixer.num_channels = options.num_channels;
+  mixer.frame_duration_ms = 10;
+  mixer.max_buffered_ms = options.max_buffered_ms;
+  return mixer;
+}
+
+} // namespace
+
+AudioPipeline::AudioPipeline(std::shared_ptr<AudioSource> source)
+    : AudioPipeline(std::move(source), Options{}) {}
+
+AudioPipeline::AudioPipeline(std::shared_ptr<AudioSource> source,
+                             const Options &options)
+    : options_(options), source_(std::move(source)), apm_(options.apm),
+      mixer_(mixerOptions(options)),
+      capture_stream_(apm_, AudioProcessingStream::Direction::kForward,
+                      options.sample_rate, options.num_channels) {
+  if (!source_) {
+    throw std::invalid_argument("AudioPipeline: source is null");
+  }
+  if (source_->sample_rate() != options_.sample_rate ||
+      source_->num_channels() != options_.num_channels) {
+    throw std::invalid_argument(
+        "AudioPipeline: source format does not match pipeline options");
+  }
+}
+
+AudioPipeline::~AudioPipeline() = default;
+
+AudioStream::Options AudioPipeline::remoteStreamOptions() const {
+  AudioStream::Options opts;
+  opts.sample_rate = options_.sample_rate;
+  opts.num_channels = options_.num_channels;
+  return opts;
+}
+
+AudioMixer::InputId
+AudioPipeline::addRemoteStream(std::shared_ptr<AudioStream> stream) {
+  return mixer_.addStream(std::move(stream));
+}
+
+AudioMixer::InputId AudioPipeline::addPlayoutInput() {
+  return mixer_.addInput();
+}
+
+void AudioPipeline::pushPlayout(AudioMixer::InputId id,
+                                const AudioFrame &frame) {
+  mixer_.pushFrame(id, frame);
+}
+
+void AudioPipeline::removePlayoutInput(AudioMixer::InputId id) {
+  mixer_.removeInput(id);
+}
+
+AudioFrame AudioPipeline::renderPlayout(Clock::time_point render_time) {
+  const auto now = Clock::now();
+  if (render_time == Clock::time_point{}) {
+    render_time = now + std::chrono::milliseconds(options_.render_latency_ms);
+  }
+  // Analyze time is now: the mix goes to the APM and the device together.
+  AudioFrame frame = mixer_.mix();
+  apm_.processReverseStream(frame);
+  render_delay_ms_.store(std::max(0.0, millisBetween(now, render_time)),
+                         std::memory_order_relaxed);
+  return frame;
+}
+
+void AudioPipeline::captureFrame(const AudioFrame &frame,
+                                 Clock::time_point capture_time) {
+  const auto now = Clock::now();
+  if (capture_time == Clock::time_point{}) {
+    capture_time =
+        now - std::chrono::milliseconds(options_.capture_latency_ms);
+  }
+
+  AudioFrame processed;
+  {
+    std::lock_guard<std::mutex> lock(capture_mutex_);
+    // Samples carried over from the previous call were captured before
+    // this frame, so the chunks processed now started that much earlier.
+    const double carried_ms =
+        1000.0 *
+        static_cast<double>(capture_stream_.pendingSamplesPerChannel()) /
+        options_.sample_rate;
+    processed = capture_stream_.process(frame);
+    if (processed.samples_per_channel() == 0) {
+      return;
+    }
+    updateDelayLocked(millisBetween(capture_time, now) + carried_ms);
+  }
+  source_->captureFrame(processed);
+}
+
+void AudioPipeline::updateDelayLocked(double capture_delay_ms) {
+  if (!options_.apm.echo_cancellation) {
+    return; // setStreamDelayMs must only be used with echo processing on
+  }
+  const double delay = std::max(0.0, capture_delay_ms) +
+                       render_delay_ms_.load(std::memory_order_relaxed);
+  smoothed_delay_ms_ =
+      smoothed_delay_ms_ < 0.0
+          ? delay
+          : smoothed_delay_ms_ + kDelaySmoothing * (delay - smoothed_delay_ms_);
+
+  const int rounded = static_cast<int>(std::lround(smoothed_delay_ms_));
+  const int applied = applied_delay_ms_.load(std::memory_order_relaxed);
+  if (applied < 0 || std::abs(rounded - applied) >= kDelayHysteresisMs) {
+    apm_.setStreamDelayMs(rounded);
+    applied_delay_ms_.store(rounded, std::memory_order_relaxed);
+  }
+}
+
+} // namespace livekit
@@ -0,0 +1,536 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/audio_playout_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "livekit/audio_resampler.h"
+#include "livekit/audio_source.h"
+#include "log.h"
+#include "thread_util.h"
+
+namespace livekit {
+
+namespace {
+
+// Length of the audio repeated while concealing an underrun; its gain halves
+// on every repetition.
+constexpr int kConcealMs = 10;
+// Concealment stops below this gain and plays silence instead.
+constexpr float kMinConcealGain = 1.0f / 32.0f;
+// Ramp applied when playback (re)starts.
+constexpr int kFadeInMs = 5;
+// Smallest deviation from the target delay that triggers drift correction.
+constexpr int kMinDriftHysteresisMs = 2;
+
+std::size_t nextPowerOfTwo(std::size_t n) {
+  std::size_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+
+std::size_t msToFrames(int ms, int sample_rate) {
+  return static_cast<std::size_t>(ms) * static_cast<std::size_t>(sample_rate) /
+         1000;
+}
+
+std::int16_t toSample(float v) {
+  v = std::round(v);
+  v = std::min(std::max(v, -32768.0f), 32767.0f);
+  return static_cast<std::int16_t>(v);
+}
+
+const AudioPlayoutBuffer::Options &
+validated(const AudioPlayoutBuffer::Options &o) {
+  if (o.sample_rate <= 0 || o.num_channels <= 0) {
+    throw std::invalid_argument(
+        "AudioPlayoutBuffer: sample_rate and num_channels must be positive");
+  }
+  if (o.min_delay_ms < 0 || o.max_delay_ms < o.min_delay_ms ||
+      o.capacity_ms <= o.max_delay_ms) {
+    throw std::invalid_argument(
+        "AudioPlayoutBuffer: need 0 <= min_delay_ms <= max_delay_ms < "
+        "capacity_ms");
+  }
+  if (o.max_rate_adjust < 0.0 || o.max_rate_adjust > 0.1) {
+    throw std::invalid_argument(
+        "AudioPlayoutBuffer: max_rate_adjust must be within [0, 0.1]");
+  }
+  return o;
+}
+
+const AudioCaptureAdapter::Options &
+validated(const AudioCaptureAdapter::Options &o) {
+  if (o.sample_rate <= 0 || o.num_channels <= 0 || o.frame_duration_ms <= 0 ||
+      o.capacity_ms < o.frame_duration_ms) {
+    throw std::invalid_argument(
+        "AudioCaptureAdapter: invalid format, frame duration or capacity");
+  }
+  return o;
+}
+
+std::shared_ptr<AudioSource>
+checkedSource(std::shared_ptr<AudioSource> source,
+              const AudioCaptureAdapter::Options &o) {
+  if (!source || source->sample_rate() != o.sample_rate ||
+      source->num_channels() != o.num_channels) {
+    throw std::invalid_argument(
+        "AudioCaptureAdapter: source is null or its format does not match");
+  }
+  return source;
+}
+
+} // namespace
+
+// ============================================================================
+// AudioPlayoutBuffer
+// ============================================================================
+
+AudioPlayoutBuffer::AudioPlayoutBuffer() : AudioPlayoutBuffer(Options{}) {}
+
+AudioPlayoutBuffer::AudioPlayoutBuffer(const Options &options)
+    : options_(validated(options)),
+      channels_(static_cast<std::size_t>(options.num_channels)) {
+  capacity_samples_ =
+      msToFrames(options_.capacity_ms, options_.sample_rate) * channels_;
+  ring_.assign(nextPowerOfTwo(capacity_samples_), 0);
+  mask_ = ring_.size() - 1;
+
+  min_target_ = msToFrames(options_.min_delay_ms, options_.sample_rate);
+  max_target_ = msToFrames(options_.max_delay_ms, options_.sample_rate);
+  target_frames_.store(min_target_, std::memory_order_relaxed);
+
+  const std::size_t conceal_frames =
+      std::max<std::size_t>(msToFrames(kConcealMs, options_.sample_rate), 1);
+  history_.assign(conceal_frames * channels_, 0.0f);
+}
+
+AudioPlayoutBuffer::~AudioPlayoutBuffer() = default;
+
+// ---- producer side ---------------------------------------------------------
+
+void AudioPlayoutBuffer::push(const AudioFrame &frame) {
+  push(frame.data().data(), frame.samples_per_channel(), frame.sample_rate(),
+       frame.num_channels());
+}
+
+void AudioPlayoutBuffer::push(const AudioFrameView &frame) {
+  push(frame.data(), frame.samples_per_channel(), frame.sample_rate(),
+       frame.num_channels());
+}
+
+void AudioPlayoutBuffer::push(const std::int16_t *interleaved,
+                              int samples_per_channel, int sample_rate,
+                              int num_channels) {
+  if (!interleaved || samples_per_channel <= 0 || sample_rate <= 0 ||
+      num_channels <= 0) {
+    return;
+  }
+  const auto frames = static_cast<std::size_t>(samples_per_channel);
+  const auto in_channels = static_cast<std::size_t>(num_channels);
+
+  const std::int16_t *src = interleaved;
+  if (in_channels != channels_) {
+    if (in_channels != 1 && channels_ != 1) {
+      pushed_.fetch_add(frames, std::memory_order_relaxed);
+      dropped_.fetch_add(frames, std::memory_order_relaxed);
+      return;
+    }
+    remixed_.resize(frames * channels_);
+    if (in_channels == 1) {
+      for (std::size_t i = 0; i < frames; ++i) {
+        std::fill_n(remixed_.begin() + i * channels_, channels_,
+                    interleaved[i]);
+      }
+    } else {
+      for (std::size_t i = 0; i < frames; ++i) {
+        int sum = 0;
+        for (std::size_t c = 0; c < in_channels; ++c) {
+          sum += interleaved[i * in_channels + c];
+        }
+        remixed_[i] =
+            static_cast<std::int16_t>(sum / static_cast<int>(in_channels));
+      }
+    }
+    src = remixed_.data();
+  }
+
+  if (sample_rate == options_.sample_rate) {
+    resampler_.reset();
+    noteArrival(frames);
+    write(src, frames);
+    return;
+  }
+  if (!resampler_ || resampler_->inputRate() != sample_rate) {
+    resampler_ = std::make_unique<AudioResampler>(
+        sample_rate, options_.sample_rate, options_.num_channels);
+  }
+  AudioFrame converted = resampler_->resample(
+      AudioFrame(std::vector<std::int16_t>(src, src + frames * channels_),
+                 sample_rate, options_.num_channels, samples_per_channel));
+  const auto out_frames =
+      static_cast<std::size_t>(converted.samples_per_channel());
+  if (out_frames > 0) {
+    noteArrival(out_frames);
+    write(converted.data().data(), out_frames);
+  }
+}
+
+std::function<void(AudioFrameViewEvent &&)> AudioPlayoutBuffer::sink() {
+  return [this](AudioFrameViewEvent &&event) { push(event.frame); };
+}
+
+void AudioPlayoutBuffer::noteArrival(std::size_t frames) {
+  const auto now = std::chrono::steady_clock::now();
+  if (last_frames_ > 0) {
+    const double gap_ms =
+        std::chrono::duration<double, std::milli>(now - last_arrival_).count();
+    const double expected_ms =
+        1000.0 * static_cast<double>(last_frames_) / options_.sample_rate;
+    // A stream that paused and came back is not jitter.
+    const double deviation = std::min(std::abs(gap_ms - expected_ms),
+                                      static_cast<double>(options_.max_delay_ms));
+    jitter_ms_ += (deviation - jitter_ms_) / 16.0;
+    jitter_out_.store(jitter_ms_, std::memory_order_relaxed);
+
+    const auto wanted = static_cast<std::size_t>(
+        (options_.min_delay_ms + 3.0 * jitter_ms_) * options_.sample_rate /
+        1000.0);
+    target_frames_.store(std::min(std::max(wanted, min_target_), max_target_),
+                         std::memory_order_relaxed);
+  }
+  last_arrival_ = now;
+  last_frames_ = frames;
+}
+
+void AudioPlayoutBuffer::write(const std::int16_t *interleaved,
+                               std::size_t frames) {
+  const std::size_t w = write_pos_.load(std::memory_order_relaxed);
+  const std::size_t r = read_pos_.load(std::memory_order_acquire);
+  const std::size_t free_frames = (capacity_samples_ - (w - r)) / channels_;
+  const std::size_t n = std::min(frames, free_frames);
+  const std::size_t samples = n * channels_;
+
+  const std::size_t offset = w & mask_;
+  const std::size_t first = std::min(samples, ring_.size() - offset);
+  std::memcpy(ring_.data() + offset, interleaved,
+              first * sizeof(std::int16_t));
+  std::memcpy(ring_.data(), interleaved + first,
+              (samples - first) * sizeof(std::int16_t));
+  write_pos_.store(w + samples, std::memory_order_release);
+
+  pushed_.fetch_add(frames, std::memory_order_relaxed);
+  if (n < frames) {
+    dropped_.fetch_add(frames - n, std::memory_order_relaxed);
+  }
+}
+
+// ---- consumer side ---------------------------------------------------------
+
+std::size_t AudioPlayoutBuffer::available() const noexcept {
+  const std::size_t w = write_pos_.load(std::memory_order_acquire);
+  const std::size_t r = read_pos_.load(std::memory_order_acquire);
+  return (w - r) / channels_;
+}
+
+void AudioPlayoutBuffer::fill(std::int16_t *out, int frames) noexcept {
+  if (!out || frames <= 0) {
+    return;
+  }
+  const auto n = static_cast<std::size_t>(frames);
+  std::size_t avail = available();
+  const std::size_t target = target_frames_.load(std::memory_order_relaxed);
+
+  if (!playing_) {
+    if (avail == 0 || avail < target) {
+      conceal(out, n);
+      return;
+    }
+    playing_ = true;
+    started_ = true;
+    drift_ = 0;
+    phase_ = 0.0;
+    fade_in_left_ = msToFrames(kFadeInMs, options_.sample_rate);
+  }
+
+  // Far behind real time (e.g. the device stalled): catch up at once rather
+  // than through a percent of speed-up.
+  if (avail > target + max_target_) {
+    const std::size_t skip = avail - target;
+    read_pos_.fetch_add(skip * channels_, std::memory_order_release);
+    dropped_.fetch_add(skip, std::memory_order_relaxed);
+    avail = target;
+    phase_ = 0.0;
+  }
+
+  // Drift correction with hysteresis: start adjusting once the delay leaves
+  // the band around the target and keep going until it is back on target.
+  const std::size_t band = std::max(
+      msToFrames(kMinDriftHysteresisMs, options_.sample_rate), target / 4);
+  if (avail > target + band) {
+    drift_ = 1;
+  } else if (avail + band < target) {
+    drift_ = -1;
+  } else if ((drift_ > 0 && avail <= target) ||
+             (drift_ < 0 && avail >= target)) {
+    drift_ = 0;
+    phase_ = 0.0;
+  }
+  if (options_.max_rate_adjust == 0.0) {
+    drift_ = 0;
+  }
+
+  const double step = 1.0 + drift_ * options_.max_rate_adjust;
+  // Interpolation reads one frame past the last one consumed.
+  const std::size_t needed =
+      drift_ == 0 && phase_ == 0.0
+          ? n
+          : static_cast<std::size_t>(phase_ + static_cast<double>(n) * step) +
+                1;
+  if (avail >= needed) {
+    play(out, n, step);
+    played_.fetch_add(n, std::memory_order_relaxed);
+    if (drift_ > 0) {
+      sped_up_.fetch_add(n, std::memory_order_relaxed);
+    } else if (drift_ < 0) {
+      slowed_down_.fetch_add(n, std::memory_order_relaxed);
+    }
+    return;
+  }
+
+  // Underrun: play out what is left, conceal the rest and rebuffer.
+  phase_ = 0.0;
+  const std::size_t have = std::min(avail, n);
+  play(out, have, 1.0);
+  played_.fetch_add(have, std::memory_order_relaxed);
+  underruns_.fetch_add(1, std::memory_order_relaxed);
+  playing_ = false;
+  conceal_pos_ = history_pos_;
+  conceal_gain_ = 1.0f;
+  conceal(out + have * channels_, n - have);
+}
+
+void AudioPlayoutBuffer::play(std::int16_t *out, std::size_t frames,
+                              double step) noexcept {
+  const std::size_t r = read_pos_.load(std::memory_order_relaxed);
+  const std::size_t fade_frames = msToFrames(kFadeInMs, options_.sample_rate);
+  const std::size_t history_frames = history_.size() / channels_;
+  double pos = phase_;
+  for (std::size_t i = 0; i < frames; ++i) {
+    const auto i0 = static_cast<std::size_t>(pos);
+    const auto frac = static_cast<float>(pos - static_cast<double>(i0));
+    float gain = 1.0f;
+    if (fade_in_left_ > 0) {
+      gain = 1.0f - static_cast<float>(fade_in_left_) /
+                        static_cast<float>(fade_frames);
+      --fade_in_left_;
+    }
+    for (std::size_t c = 0; c < channels_; ++c) {
+      float v = ring_[(r + i0 * channels_ + c) & mask_];
+      if (frac > 0.0f) {
+        const float next = ring_[(r + (i0 + 1) * channels_ + c) & mask_];
+        v += (next - v) * frac;
+      }
+      v *= gain;
+      out[i * channels_ + c] = toSample(v);
+      history_[history_pos_ * channels_ + c] = v;
+    }
+    history_pos_ = history_pos_ + 1 == history_frames ? 0 : history_pos_ + 1;
+    pos += step;
+  }
+  const auto consumed = static_cast<std::size_t>(pos);
+  phase_ = pos - static_cast<double>(consumed);
+  read_pos_.store(r + consumed * channels_, std::memory_order_release);
+}
+
+void AudioPlayoutBuffer::conceal(std::int16_t *out,
+                                 std::size_t frames) noexcept {
+  const std::size_t history_frames = history_.size() / channels_;
+  // Per-frame decay that halves the gain over one repetition.
+  const float decay =
+      std::pow(0.5f, 1.0f / static_cast<float>(history_frames));
+  for (std::size_t i = 0; i < frames; ++i) {
+    if (conceal_gain_ < kMinConcealGain) {
+      std::fill_n(out + i * channels_, (frames - i) * channels_,
+                  std::int16_t{0});
+      break;
+    }
+    for (std::size_t c = 0; c < channels_; ++c) {
+      out[i * channels_ + c] =
+          toSample(history_[conceal_pos_ * channels_ + c] * conceal_gain_);
+    }
+    conceal_gain_ *= decay;
+    conceal_pos_ = conceal_pos_ + 1 == history_frames ? 0 : conceal_pos_ + 1;
+  }
+  if (started_) {
+    concealed_.fetch_add(frames, std::memory_order_relaxed);
+  }
+}
+
+AudioPlayoutBuffer::Stats AudioPlayoutBuffer::stats() const noexcept {
+  Stats s;
+  s.buffered_frames = available();
+  s.target_delay_ms = static_cast<int>(
+      target_frames_.load(std::memory_order_relaxed) * 1000 /
+      static_cast<std::size_t>(options_.sample_rate));
+  s.jitter_ms = jitter_out_.load(std::memory_order_relaxed);
+  s.frames_pushed = pushed_.load(std::memory_order_relaxed);
+  s.frames_dropped = dropped_.load(std::memory_order_relaxed);
+  s.frames_played = played_.load(std::memory_order_relaxed);
+  s.frames_concealed = concealed_.load(std::memory_order_relaxed);
+  s.underruns = underruns_.load(std::memory_order_relaxed);
+  s.frames_sped_up = sped_up_.load(std::memory_order_relaxed);
+  s.frames_slowed_down = slowed_down_.load(std::memory_order_relaxed);
+  return s;
+}
+
+// ============================================================================
+// AudioCaptureAdapter
+// ============================================================================
+
+AudioCaptureAdapter::AudioCaptureAdapter(std::shared_ptr<AudioSource> source,
+                                         const Options &options)
+    : AudioCaptureAdapter(
+          [source = checkedSource(std::move(source), options)](
+              const AudioFrame &frame) {
+            // Blocks until the FFI took the frame; only the worker waits.
+            source->captureFrame(frame);
+          },
+          options) {}
+
+AudioCaptureAdapter::AudioCaptureAdapter(FrameSink sink,
+                                         const Options &options)
+    : options_(validated(options)),
+      channels_(static_cast<std::size_t>(options.num_channels)),
+      frame_samples_(
+          std::max<std::size_t>(
+              msToFrames(options.frame_duration_ms, options.sample_rate), 1) *
+          channels_),
+      sink_(std::move(sink)), pool_(4) {
+  if (!sink_) {
+    throw std::invalid_argument("AudioCaptureAdapter: sink must be set");
+  }
+  const std::size_t capacity = std::max(
+      msToFrames(options_.capacity_ms, options_.sample_rate) * channels_,
+      frame_samples_);
+  ring_.assign(nextPowerOfTwo(capacity), 0);
+  mask_ = ring_.size() - 1;
+  worker_ = std::thread([this] {
+    detail::registerThread(ThreadRole::kAudio, "lk-audio-dev");
+    run();
+  });
+}
+
+AudioCaptureAdapter::~AudioCaptureAdapter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_one();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+int AudioCaptureAdapter::push(const std::int16_t *interleaved,
+                              int frames) noexcept {
+  if (!interleaved || frames <= 0) {
+    return 0;
+  }
+  const std::size_t w = write_pos_.load(std::memory_order_relaxed);
+  const std::size_t r = read_pos_.load(std::memory_order_acquire);
+  const std::size_t free_frames = (ring_.size() - (w - r)) / channels_;
+  const std::size_t n =
+      std::min(static_cast<std::size_t>(frames), free_frames);
+  const std::size_t samples = n * channels_;
+
+  const std::size_t offset = w & mask_;
+  const std::size_t first = std::min(samples, ring_.size() - offset);
+  std::memcpy(ring_.data() + offset, interleaved,
+              first * sizeof(std::int16_t));
+  std::memcpy(ring_.data(), interleaved + first,
+              (samples - first) * sizeof(std::int16_t));
+  write_pos_.store(w + samples, std::memory_order_release);
+
+  pushed_.fetch_add(static_cast<std::uint64_t>(frames),
+                    std::memory_order_relaxed);
+  if (n < static_cast<std::size_t>(frames)) {
+    dropped_.fetch_add(frames - n, std::memory_order_relaxed);
+  }
+  // Not taking the mutex keeps the callback lock-free; a wakeup lost to the
+  // race with the worker going to sleep is covered by its timed wait.
+  if (w + samples - r >= frame_samples_ &&
+      waiting_.load(std::memory_order_acquire)) {
+    cv_.notify_one();
+  }
+  return static_cast<int>(n);
+}
+
+void AudioCaptureAdapter::run() {
+  const auto spc = static_cast<int>(frame_samples_ / channels_);
+  const auto backstop = std::chrono::milliseconds(options_.frame_duration_ms);
+  auto ready = [this] {
+    return write_pos_.load(std::memory_order_acquire) -
+               read_pos_.load(std::memory_order_relaxed) >=
+           frame_samples_;
+  };
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      waiting_.store(true, std::memory_order_release);
+      cv_.wait_for(lock, backstop, [&] { return stop_ || ready(); });
+      waiting_.store(false, std::memory_order_relaxed);
+      if (stop_) {
+        return;
+      }
+    }
+    while (ready()) {
+      const std::size_t r = read_pos_.load(std::memory_order_relaxed);
+      AudioFrame frame =
+          pool_.acquire(options_.sample_rate, options_.num_channels, spc);
+      const std::size_t offset = r & mask_;
+      const std::size_t first = std::min(frame_samples_, ring_.size() - offset);
+      std::int16_t *dst = frame.data().data();
+      std::memcpy(dst, ring_.data() + offset, first * sizeof(std::int16_t));
+      std::memcpy(dst + first, ring_.data(),
+                  (frame_samples_ - first) * sizeof(std::int16_t));
+      read_pos_.store(r + frame_samples_, std::memory_order_release);
+      try {
+        sink_(frame);
+        sent_.fetch_add(1, std::memory_order_relaxed);
+      } catch (const std::exception &e) {
+        LK_LOG_WARN("livekit::audio_capture", "capture failed: %s", e.what());
+      }
+    }
+  }
+}
+
+AudioCaptureAdapter::Stats AudioCaptureAdapter::stats() const noexcept {
+  Stats s;
+  s.frames_pushed = pushed_.load(std::memory_order_relaxed);
+  s.frames_dropped = dropped_.load(std::memory_order_relaxed);
+  s.frames_sent = sent_.load(std::memory_order_relaxed);
+  return s;
+}
+
+} // namespace livekit
@@ -17,9 +17,11 @@
 #include "livekit/audio_processing_module.h"
 
 #include <stdexcept>
+#include <utility>
 
 #include "audio_frame.pb.h"
 #include "ffi.pb.h"
+#include "ffi_arena.h"
 #include "ffi_client.h"
 
 namespace livekit {
@@ -43,7 +45,8 @@ AudioProcessingModule::AudioProcessingModule(const Options &options) {
   }
 
   const auto &apm_info = resp.new_apm().apm();
-  handle_ = FfiHandle(static_cast<uintptr_t>(apm_info.handle().id()));
+  handle_ = FfiHandle(static_cast<uintptr_t>(apm_info.handle().id()),
+                      ResourceKind::kAudioProcessor);
 
   if (!handle_.valid()) {
     throw std::runtime_error(
@@ -52,62 +55,96 @@ AudioProcessingModule::AudioProcessingModule(const Options &options) {
 }
 
 void AudioProcessingModule::processStream(AudioFrame &frame) {
-  if (!handle_.valid()) {
-    throw std::runtime_error("AudioProcessingModule: invalid handle");
-  }
+  processStreamBatch(&frame, 1);
+}
 
-  if (frame.data().empty()) {
-    return;
-  }
+void AudioProcessingModule::processReverseStream(AudioFrame &frame) {
+  processReverseStreamBatch(&frame, 1);
+}
 
-  proto::FfiRequest req;
-  auto *msg = req.mutable_apm_process_stream();
-  msg->set_apm_handle(static_cast<std::uint64_t>(handle_.get()));
-  msg->set_data_ptr(reinterpret_cast<std::uint64_t>(frame.data().data()));
-  msg->set_size(
-      static_cast<std::uint32_t>(frame.data().size() * sizeof(std::int16_t)));
-  msg->set_sample_rate(static_cast<std::uint32_t>(frame.sample_rate()));
-  msg->set_num_channels(static_cast<std::uint32_t>(frame.num_channels()));
+void AudioProcessingModule::processStreamBatch(AudioFrame *frames,
+                                               std::size_t count) {
+  processBatch(false, frames, count);
+}
 
-  proto::FfiResponse resp = FfiClient::instance().sendRequest(req);
+void AudioProcessingModule::processStreamBatch(
+    std::vector<AudioFrame> &frames) {
+  processBatch(false, frames.data(), frames.size());
+}
 
-  if (!resp.has_apm_process_stream()) {
-    throw std::runtime_error(
-        "AudioProcessingModule::processStream: unexpected response");
-  }
+void AudioProcessingModule::processReverseStreamBatch(AudioFrame *frames,
+                                                      std::size_t count) {
+  processBatch(true, frames, count);
+}
 
-  const auto &result = resp.apm_process_stream();
-  if (result.has_error()) {
-    throw std::runtime_error("AudioProcessingModule::processStream: " +
-                             result.error());
-  }
+void AudioProcessingModule::processReverseStreamBatch(
+    std::vector<AudioFrame> &frames) {
+  processBatch(true, frames.data(), frames.size());
 }
 
-void AudioProcessingModule::processReverseStream(AudioFrame &frame) {
+void AudioProcessingModule::processBatch(bool reverse, AudioFrame *frames,
+                                         std::size_t count) {
   if (!handle_.valid()) {
     throw std::runtime_error("AudioProcessingModule: invalid handle");
   }
+  // One arena-backed request is reused for the whole batch.
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
+  for (std::size_t i = 0; i < count; ++i) {
+    AudioFrame &frame = frames[i];
+    if (frame.data().empty()) {
+      continue;
+    }
+    processRaw(reverse, frame.data().data(), frame.data().size(),
+               frame.sample_rate(), frame.num_channels(), req, arena);
+  }
+}
 
-  if (frame.data().empty()) {
+void AudioProcessingModule::processRaw(bool reverse, std::int16_t *data,
+                                       std::size_t total_samples,
+                                       int sample_rate, int num_channels,
+                                       proto::FfiRequest &req,
+                                       FfiArenaScope &arena) {
+  const auto apm_handle = static_cast<std::uint64_t>(handle_.get());
+  const auto data_ptr = reinterpret_cast<std::uint64_t>(data);
+  const auto size =
+      static_cast<std::uint32_t>(total_samples * sizeof(std::int16_t));
+
+  if (!reverse) {
+    auto *msg = req.mutable_apm_process_stream();
+    msg->set_apm_handle(apm_handle);
+    msg->set_data_ptr(data_ptr);
+    msg->set_size(size);
+    msg->set_sample_rate(static_cast<std::uint32_t>(sample_rate));
+    msg->set_num_channels(static_cast<std::uint32_t>(num_channels));
+
+    const proto::FfiResponse &resp =
+        FfiClient::instance().sendRequest(req, arena);
+    if (!resp.has_apm_process_stream()) {
+      throw std::runtime_error(
+          "AudioProcessingModule::processStream: unexpected response");
+    }
+    const auto &result = resp.apm_process_stream();
+    if (result.has_error()) {
+      throw std::runtime_error("AudioProcessingModule::processStream: " +
+                               result.error());
+    }
     return;
   }
 
-  proto::FfiRequest req;
   auto *msg = req.mutable_apm_process_reverse_stream();
-  msg->set_apm_handle(static_cast<std::uint64_t>(handle_.get()));
-  msg->set_data_ptr(reinterpret_cast<std::uint64_t>(frame.data().data()));
-  msg->set_size(
-      static_cast<std::uint32_t>(frame.data().size() * sizeof(std::int16_t)));
-  msg->set_sample_rate(static_cast<std::uint32_t>(frame.sample_rate()));
-  msg->set_num_channels(static_cast<std::uint32_t>(frame.num_channels()));
-
-  proto::FfiResponse resp = FfiClient::instance().sendRequest(req);
+  msg->set_apm_handle(apm_handle);
+  msg->set_data_ptr(data_ptr);
+  msg->set_size(size);
+  msg->set_sample_rate(static_cast<std::uint32_t>(sample_rate));
+  msg->set_num_channels(static_cast<std::uint32_t>(num_channels));
 
+  const proto::FfiResponse &resp =
+      FfiClient::instance().sendRequest(req, arena);
   if (!resp.has_apm_process_reverse_stream()) {
     throw std::runtime_error(
         "AudioProcessingModule::processReverseStream: unexpected response");
   }
-
   const auto &result = resp.apm_process_reverse_stream();
   if (result.has_error()) {
     throw std::runtime_error("AudioProcessingModule::processReverseStream: " +
@@ -139,4 +176,91 @@ void AudioProcessingModule::setStreamDelayMs(int delay_ms) {
   }
 }
 
+// ---------------------------------------------------------------------------
+// AudioProcessingStream
+// ---------------------------------------------------------------------------
+
+AudioProcessingStream::AudioProcessingStream(AudioProcessingModule &apm,
+                                             Direction direction,
+                                             int sample_rate, int num_channels)
+    : apm_(&apm), direction_(direction), sample_rate_(sample_rate),
+      num_channels_(num_channels) {
+  if (sample_rate <= 0 || sample_rate % 100 != 0 || num_channels <= 0) {
+    throw std::invalid_argument(
+        "AudioProcessingStream: sample_rate must be a positive multiple of "
+        "100 and num_channels positive");
+  }
+  chunk_samples_ = static_cast<std::size_t>(sample_rate / 100) *
+                   static_cast<std::size_t>(num_channels);
+}
+
+AudioFrame AudioProcessingStream::process(const AudioFrame &input) {
+  if (input.sample_rate() != sample_rate_ ||
+      input.num_channels() != num_channels_) {
+    throw std::invalid_argument(
+        "AudioProcessingStream::process: frame format does not match stream");
+  }
+  return process(input.data().data(),
+                 static_cast<std::size_t>(input.samples_per_channel()));
+}
+
+AudioFrame AudioProcessingStream::process(const std::int16_t *data,
+                                          std::size_t samples_per_channel) {
+  pending_.insert(pending_.end(), data,
+                  data + samples_per_channel *
+                             static_cast<std::size_t>(num_channels_));
+  const std::size_t chunks = pending_.size() / chunk_samples_;
+  if (chunks == 0) {
+    return AudioFrame({}, sample_rate_, num_channels_, 0);
+  }
+
+  const std::size_t ready = chunks * chunk_samples_;
+  const bool reverse = direction_ == Direction::kReverse;
+  {
+    FfiArenaScope arena;
+    auto &req = *arena.create<proto::FfiRequest>();
+    for (std::size_t c = 0; c < chunks; ++c) {
+      apm_->processRaw(reverse, pending_.data() + c * chunk_samples_,
+                       chunk_samples_, sample_rate_, num_channels_, req,
+                       arena);
+    }
+  }
+
+  // Hand the processed prefix out and keep the remainder for next time.
+  std::vector<std::int16_t> out;
+  if (ready == pending_.size()) {
+    out.swap(pending_);
+  } else {
+    out.assign(pending_.begin(),
+               pending_.begin() + static_cast<std::ptrdiff_t>(ready));
+    pending_.erase(pending_.begin(),
+                   pending_.begin() + static_cast<std::ptrdiff_t>(ready));
+  }
+  const int spc =
+      static_cast<int>(ready / static_cast<std::size_t>(num_channels_));
+  return AudioFrame(std::move(out), sample_rate_, num_channels_, spc);
+}
+
+AudioFrame AudioProcessingStream::flush() {
+  const std::size_t tail = pending_.size();
+  if (tail == 0) {
+    return AudioFrame({}, sample_rate_, num_channels_, 0);
+  }
+  // Pad the partial chunk with silence, process it, then drop the padding.
+  pending_.resize(chunk_samples_, 0);
+  AudioFrame out = process(nullptr, 0);
+  std::vector<std::int16_t> samples = std::move(out.data());
+  samples.resize(tail);
+  pending_.clear();
+  return AudioFrame(
+      std::move(samples), sample_rate_, num_channels_,
+      static_cast<int>(tail / static_cast<std::size_t>(num_channels_)));
+}
+
+std::size_t AudioProcessingStream::pendingSamplesPerChannel() const noexcept {
+  return pending_.size() / static_cast<std::size_t>(num_channels_);
+}
+
+void AudioProcessingStream::reset() { pending_.clear(); }
+
 } // namespace livekit
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/audio_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "audio_simd.h"
+
+namespace livekit {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Upper bound on tabulated phases; rates used in practice reduce to far less
+// (44.1k <-> 48k is 160/147).
+constexpr std::size_t kMaxPhases = 4096;
+
+double sinc(double x) {
+  if (std::abs(x) < 1e-12) {
+    return 1.0;
+  }
+  return std::sin(kPi * x) / (kPi * x);
+}
+
+} // namespace
+
+AudioResampler::AudioResampler(int input_rate, int output_rate,
+                               int num_channels, int taps)
+    : input_rate_(input_rate), output_rate_(output_rate),
+      num_channels_(num_channels) {
+  if (input_rate <= 0 || output_rate <= 0 || num_channels <= 0 || taps <= 0) {
+    throw std::invalid_argument(
+        "AudioResampler: rates, num_channels and taps must be positive");
+  }
+  const int g = std::gcd(input_rate, output_rate);
+  up_ = static_cast<std::size_t>(output_rate / g);
+  down_ = static_cast<std::size_t>(input_rate / g);
+  if (up_ > kMaxPhases) {
+    throw std::invalid_argument("AudioResampler: unsupported rate ratio");
+  }
+
+  // When downsampling, lower the cutoff below the output Nyquist and widen
+  // the filter to keep the same transition sharpness.
+  const double cutoff =
+      std::min(1.0, static_cast<double>(up_) / static_cast<double>(down_));
+  taps_ = static_cast<std::size_t>(std::ceil(taps / cutoff));
+
+  // Prototype low-pass at the upsampled rate, split into up_ phases.
+  const std::size_t length = taps_ * up_;
+  const double center = (static_cast<double>(length) - 1.0) / 2.0;
+  const double span = length > 1 ? static_cast<double>(length - 1) : 1.0;
+  coeffs_.assign(length, 0.0f);
+  for (std::size_t p = 0; p < up_; ++p) {
+    for (std::size_t k = 0; k < taps_; ++k) {
+      const std::size_t j = p + k * up_;
+      const double t = (static_cast<double>(j) - center) / up_;
+      // Blackman window.
+      const double w = 0.42 - 0.5 * std::cos(2.0 * kPi * j / span) +
+                       0.08 * std::cos(4.0 * kPi * j / span);
+      const double h = cutoff * sinc(cutoff * t) * w;
+      coeffs_[p * taps_ + (taps_ - 1 - k)] = static_cast<float>(h);
+    }
+  }
+
+  // Normalize every phase to unity DC gain so there is no phase-dependent
+  // ripple on constant signals.
+  for (std::size_t p = 0; p < up_; ++p) {
+    float *phase = coeffs_.data() + p * taps_;
+    const double sum = std::accumulate(phase, phase + taps_, 0.0);
+    if (sum != 0.0) {
+      for (std::size_t k = 0; k < taps_; ++k) {
+        phase[k] = static_cast<float>(phase[k] / sum);
+      }
+    }
+  }
+
+  reset();
+}
+
+void AudioResampler::reset() {
+  history_.assign(static_cast<std::size_t>(num_channels_),
+                  std::vector<float>(taps_ - 1, 0.0f));
+  phase_ = 0;
+}
+
+AudioFrame AudioResampler::resample(const AudioFrame &frame) {
+  if (frame.sample_rate() != input_rate_ ||
+      frame.num_channels() != num_channels_) {
+    throw std::invalid_argument(
+        "AudioResampler::resample: frame format does not match resampler");
+  }
+  return process(frame.data().data(),
+                 static_cast<std::size_t>(frame.samples_per_channel()));
+}
+
+AudioFrame AudioResampler::flush() {
+  const std::vector<std::int16_t> silence(
+      taps_ * static_cast<std::size_t>(num_channels_), 0);
+  AudioFrame out = process(silence.data(), taps_);
+  reset();
+  return out;
+}
+
+AudioFrame AudioResampler::process(const std::int16_t *data,
+                                   std::size_t frames) {
+  const std::size_t channels = static_cast<std::size_t>(num_channels_);
+  for (std::size_t c = 0; c < channels; ++c) {
+    std::vector<float> &h = history_[c];
+    const std::size_t base = h.size();
+    h.resize(base + frames);
+    for (std::size_t f = 0; f < frames; ++f) {
+      h[base + f] = static_cast<float>(data[f * channels + c]);
+    }
+  }
+
+  const std::size_t available = history_[0].size();
+  // Count outputs first so the frame is allocated once.
+  std::size_t out_frames = 0;
+  {
+    std::size_t idx = 0;
+    std::size_t phase = phase_;
+    while (idx + taps_ <= available) {
+      ++out_frames;
+      phase += down_;
+      idx += phase / up_;
+      phase %= up_;
+    }
+  }
+
+  std::vector<std::int16_t> out(out_frames * channels);
+  std::size_t idx = 0;
+  for (std::size_t n = 0; n < out_frames; ++n) {
+    const float *phase_coeffs = coeffs_.data() + phase_ * taps_;
+    for (std::size_t c = 0; c < channels; ++c) {
+      const float v =
+          detail::dotFloat(phase_coeffs, history_[c].data() + idx, taps_);
+      out[n * channels + c] =
+          detail::saturateInt16(static_cast<std::int32_t>(std::lrint(v)));
+    }
+    phase_ += down_;
+    idx += phase_ / up_;
+    phase_ %= up_;
+  }
+
+  // Keep only the history the next call still needs.
+  for (auto &h : history_) {
+    h.erase(h.begin(), h.begin() + static_cast<std::ptrdiff_t>(idx));
+  }
+
+  return AudioFrame(std::move(out), output_rate_, num_channels_,
+                    static_cast<int>(out_frames));
+}
+
+} // namespace livekit
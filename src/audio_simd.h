@@ -0,0 +1,384 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIVEKIT_AUDIO_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LIVEKIT_AUDIO_SIMD_NEON 1
+#endif
+
+namespace livekit {
+namespace detail {
+
+inline std::int16_t saturateInt16(std::int32_t v) noexcept {
+  if (v > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (v < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return static_cast<std::int16_t>(v);
+}
+
+// Vectorized kernels shared by AudioMixer and AudioResampler.
+
+/**
+ * dst[i] = saturate(dst[i] + src[i]) for i in [0, n).
+ *
+ * Uses AVX2, SSE2 or NEON saturating adds when the target supports them, with
+ * a scalar tail. Pointers need no particular alignment.
+ */
+inline void addSaturateInt16(std::int16_t *dst, const std::int16_t *src,
+                             std::size_t n) noexcept {
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 16 <= n; i += 16) {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+    const __m256i b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_adds_epi16(a, b));
+  }
+#elif defined(LIVEKIT_AUDIO_SIMD_SSE2)
+  for (; i + 8 <= n; i += 8) {
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+    const __m128i b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_adds_epi16(a, b));
+  }
+#elif defined(LIVEKIT_AUDIO_SIMD_NEON)
+  for (; i + 8 <= n; i += 8) {
+    vst1q_s16(dst + i, vqaddq_s16(vld1q_s16(dst + i), vld1q_s16(src + i)));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = saturateInt16(static_cast<std::int32_t>(dst[i]) + src[i]);
+  }
+}
+
+/**
+ * Sum of squares and peak magnitude of `n` samples, for level metering.
+ *
+ * The sum is exact (64-bit accumulation of pairwise int16 products). The
+ * peak saturates at 32767, so a full-scale negative sample reads as 32767.
+ */
+inline void sumSquaresPeakInt16(const std::int16_t *src, std::size_t n,
+                                std::uint64_t &sum_squares,
+                                int &peak) noexcept {
+  std::size_t i = 0;
+  std::uint64_t sum = 0;
+  int max_abs = 0;
+#if defined(__AVX2__) || defined(LIVEKIT_AUDIO_SIMD_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc = zero;  // 2 x u64
+  __m128i vmax = zero; // 8 x |s16|
+  for (; i + 8 <= n; i += 8) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    // Pairwise sums of squares fit in u32 (at most 2 * 2^30).
+    const __m128i sq = _mm_madd_epi16(v, v);
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(sq, zero));
+    acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(sq, zero));
+    vmax = _mm_max_epi16(vmax, _mm_max_epi16(v, _mm_subs_epi16(zero, v)));
+  }
+  alignas(16) std::uint64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+  sum = lanes[0] + lanes[1];
+  vmax = _mm_max_epi16(vmax, _mm_srli_si128(vmax, 8));
+  vmax = _mm_max_epi16(vmax, _mm_srli_si128(vmax, 4));
+  vmax = _mm_max_epi16(vmax, _mm_srli_si128(vmax, 2));
+  max_abs = _mm_extract_epi16(vmax, 0);
+#elif defined(LIVEKIT_AUDIO_SIMD_NEON)
+  uint64x2_t acc = vdupq_n_u64(0);
+  int16x8_t vmax = vdupq_n_s16(0);
+  for (; i + 8 <= n; i += 8) {
+    const int16x8_t v = vld1q_s16(src + i);
+    const int32x4_t lo = vmull_s16(vget_low_s16(v), vget_low_s16(v));
+    const int32x4_t hi = vmull_s16(vget_high_s16(v), vget_high_s16(v));
+    acc = vpadalq_u32(acc, vreinterpretq_u32_s32(lo));
+    acc = vpadalq_u32(acc, vreinterpretq_u32_s32(hi));
+    vmax = vmaxq_s16(vmax, vqabsq_s16(v));
+  }
+  sum = vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1);
+  int16x4_t m = vpmax_s16(vget_low_s16(vmax), vget_high_s16(vmax));
+  m = vpmax_s16(m, m);
+  m = vpmax_s16(m, m);
+  max_abs = vget_lane_s16(m, 0);
+#endif
+  for (; i < n; ++i) {
+    const std::int32_t v = src[i];
+    sum += static_cast<std::uint64_t>(v * v);
+    const int a = v < 0 ? (v == INT16_MIN ? INT16_MAX : -v) : v;
+    max_abs = a > max_abs ? a : max_abs;
+  }
+  sum_squares = sum;
+  peak = max_abs;
+}
+
+// int16 <-> float32 sample conversion. Floats are normalized so that
+// [-32768, 32767] maps to [-1, 1); float -> int16 rounds to nearest and
+// saturates (NaN becomes -32768), identically on every path.
+
+constexpr float kInt16ToFloat = 1.0f / 32768.0f;
+
+inline std::int16_t floatToInt16Sample(float x) noexcept {
+  const float v = x * 32768.0f;
+  if (!(v > -32768.0f)) {
+    return INT16_MIN;
+  }
+  if (v >= 32767.0f) {
+    return INT16_MAX;
+  }
+  return static_cast<std::int16_t>(std::lrintf(v));
+}
+
+#if defined(__AVX2__) || defined(LIVEKIT_AUDIO_SIMD_SSE2)
+// Scales 4 floats to int16 range and clamps them, as floatToInt16Sample().
+inline __m128 scaleClamp128(__m128 v) noexcept {
+  v = _mm_mul_ps(v, _mm_set1_ps(32768.0f));
+  // maxps returns its second operand for NaN lanes.
+  v = _mm_max_ps(v, _mm_set1_ps(-32768.0f));
+  return _mm_min_ps(v, _mm_set1_ps(32767.0f));
+}
+#elif defined(LIVEKIT_AUDIO_SIMD_NEON) && defined(__aarch64__)
+inline int16x4_t floatToInt16x4(float32x4_t v) noexcept {
+  v = vmulq_n_f32(v, 32768.0f);
+  v = vmaxnmq_f32(v, vdupq_n_f32(-32768.0f)); // NaN -> -32768
+  v = vminq_f32(v, vdupq_n_f32(32767.0f));
+  return vqmovn_s32(vcvtnq_s32_f32(v));
+}
+#endif
+
+/// dst[i] = src[i] / 32768 for i in [0, n).
+inline void int16ToFloat(const std::int16_t *src, float *dst,
+                         std::size_t n) noexcept {
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  const __m256 scale = _mm256_set1_ps(kInt16ToFloat);
+  for (; i + 8 <= n; i += 8) {
+    const __m256i v = _mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+#elif defined(LIVEKIT_AUDIO_SIMD_SSE2)
+  const __m128 scale = _mm_set1_ps(kInt16ToFloat);
+  for (; i + 8 <= n; i += 8) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    // Sign-extend by placing each sample in the high half, then shifting.
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+#elif defined(LIVEKIT_AUDIO_SIMD_NEON)
+  for (; i + 8 <= n; i += 8) {
+    const int16x8_t v = vld1q_s16(src + i);
+    const float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+    const float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+    vst1q_f32(dst + i, vmulq_n_f32(lo, kInt16ToFloat));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(hi, kInt16ToFloat));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = static_cast<float>(src[i]) * kInt16ToFloat;
+  }
+}
+
+/// dst[i] = floatToInt16Sample(src[i]) for i in [0, n).
+inline void floatToInt16(const float *src, std::int16_t *dst,
+                         std::size_t n) noexcept {
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  const __m256 k = _mm256_set1_ps(32768.0f);
+  const __m256 lo = _mm256_set1_ps(-32768.0f);
+  const __m256 hi = _mm256_set1_ps(32767.0f);
+  for (; i + 16 <= n; i += 16) {
+    __m256 a = _mm256_mul_ps(_mm256_loadu_ps(src + i), k);
+    __m256 b = _mm256_mul_ps(_mm256_loadu_ps(src + i + 8), k);
+    a = _mm256_min_ps(_mm256_max_ps(a, lo), hi);
+    b = _mm256_min_ps(_mm256_max_ps(b, lo), hi);
+    // packs works per 128-bit lane; restore sample order afterwards.
+    __m256i p =
+        _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+    p = _mm256_permute4x64_epi64(p, 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), p);
+  }
+#elif defined(LIVEKIT_AUDIO_SIMD_SSE2)
+  for (; i + 8 <= n; i += 8) {
+    const __m128i a = _mm_cvtps_epi32(scaleClamp128(_mm_loadu_ps(src + i)));
+    const __m128i b =
+        _mm_cvtps_epi32(scaleClamp128(_mm_loadu_ps(src + i + 4)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_packs_epi32(a, b));
+  }
+#elif defined(LIVEKIT_AUDIO_SIMD_NEON) && defined(__aarch64__)
+  for (; i + 8 <= n; i += 8) {
+    const int16x4_t a = floatToInt16x4(vld1q_f32(src + i));
+    const int16x4_t b = floatToInt16x4(vld1q_f32(src + i + 4));
+    vst1q_s16(dst + i, vcombine_s16(a, b));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = floatToInt16Sample(src[i]);
+  }
+}
+
+/**
+ * Interleaved int16 to planar float: channel c of frame f goes to
+ * dst[c * frames + f]. Mono and stereo are vectorized.
+ */
+inline void deinterleaveInt16ToFloat(const std::int16_t *src, float *dst,
+                                     int channels,
+                                     std::size_t frames) noexcept {
+  if (channels == 1) {
+    int16ToFloat(src, dst, frames);
+    return;
+  }
+  std::size_t f = 0;
+  if (channels == 2) {
+    float *left = dst;
+    float *right = dst + frames;
+#if defined(__AVX2__) || defined(LIVEKIT_AUDIO_SIMD_SSE2)
+    const __m128 scale = _mm_set1_ps(kInt16ToFloat);
+    for (; f + 4 <= frames; f += 4) {
+      const __m128i v =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * f));
+      const __m128 a = _mm_cvtepi32_ps(
+          _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)); // L0 R0 L1 R1
+      const __m128 b = _mm_cvtepi32_ps(
+          _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)); // L2 R2 L3 R3
+      _mm_storeu_ps(left + f,
+                    _mm_mul_ps(_mm_shuffle_ps(a, b, 0x88), scale));
+      _mm_storeu_ps(right + f,
+                    _mm_mul_ps(_mm_shuffle_ps(a, b, 0xDD), scale));
+    }
+#elif defined(LIVEKIT_AUDIO_SIMD_NEON)
+    for (; f + 8 <= frames; f += 8) {
+      const int16x8x2_t v = vld2q_s16(src + 2 * f);
+      for (int c = 0; c < 2; ++c) {
+        float *out = (c == 0 ? left : right) + f;
+        const int16x8_t s = v.val[c];
+        vst1q_f32(out, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))),
+                                   kInt16ToFloat));
+        vst1q_f32(out + 4,
+                  vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))),
+                              kInt16ToFloat));
+      }
+    }
+#endif
+  }
+  const std::size_t ch = static_cast<std::size_t>(channels);
+  for (; f < frames; ++f) {
+    for (std::size_t c = 0; c < ch; ++c) {
+      dst[c * frames + f] = static_cast<float>(src[f * ch + c]) * kInt16ToFloat;
+    }
+  }
+}
+
+/// Planar float to interleaved int16; inverse of deinterleaveInt16ToFloat().
+inline void interleaveFloatToInt16(const float *src, std::int16_t *dst,
+                                   int channels,
+                                   std::size_t frames) noexcept {
+  if (channels == 1) {
+    floatToInt16(src, dst, frames);
+    return;
+  }
+  std::size_t f = 0;
+  if (channels == 2) {
+    const float *left = src;
+    const float *right = src + frames;
+#if defined(__AVX2__) || defined(LIVEKIT_AUDIO_SIMD_SSE2)
+    for (; f + 4 <= frames; f += 4) {
+      const __m128 l = scaleClamp128(_mm_loadu_ps(left + f));
+      const __m128 r = scaleClamp128(_mm_loadu_ps(right + f));
+      const __m128i a = _mm_cvtps_epi32(_mm_unpacklo_ps(l, r));
+      const __m128i b = _mm_cvtps_epi32(_mm_unpackhi_ps(l, r));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * f),
+                       _mm_packs_epi32(a, b));
+    }
+#elif defined(LIVEKIT_AUDIO_SIMD_NEON) && defined(__aarch64__)
+    for (; f + 4 <= frames; f += 4) {
+      int16x4x2_t v;
+      v.val[0] = floatToInt16x4(vld1q_f32(left + f));
+      v.val[1] = floatToInt16x4(vld1q_f32(right + f));
+      vst2_s16(dst + 2 * f, v);
+    }
+#endif
+  }
+  const std::size_t ch = static_cast<std::size_t>(channels);
+  for (; f < frames; ++f) {
+    for (std::size_t c = 0; c < ch; ++c) {
+      dst[f * ch + c] = floatToInt16Sample(src[c * frames + f]);
+    }
+  }
+}
+
+/// Returns sum of a[i] * b[i] for i in [0, n). Used by the resampler's FIR.
+inline float dotFloat(const float *a, const float *b, std::size_t n) noexcept {
+  std::size_t i = 0;
+  float sum = 0.0f;
+#if defined(__AVX2__)
+  __m256 acc = _mm256_setzero_ps();
+  for (; i + 8 <= n; i += 8) {
+    const __m256 prod =
+        _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    acc = _mm256_add_ps(acc, prod);
+  }
+  __m128 lo = _mm_add_ps(_mm256_castps256_ps128(acc),
+                         _mm256_extractf128_ps(acc, 1));
+  lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+  lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 0x55));
+  sum = _mm_cvtss_f32(lo);
+#elif defined(LIVEKIT_AUDIO_SIMD_SSE2)
+  __m128 acc = _mm_setzero_ps();
+  for (; i + 4 <= n; i += 4) {
+    acc =
+        _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+  acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 0x55));
+  sum = _mm_cvtss_f32(acc);
+#elif defined(LIVEKIT_AUDIO_SIMD_NEON)
+  float32x4_t acc = vdupq_n_f32(0.0f);
+  for (; i + 4 <= n; i += 4) {
+    acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+  }
+  float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+  sum = vget_lane_f32(vpadd_f32(pair, pair), 0);
+#endif
+  for (; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+} // namespace detail
+} // namespace livekit
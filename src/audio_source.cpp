@@ -16,14 +16,25 @@
 
 #include "livekit/audio_source.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
 #include <stdexcept>
 #include <thread>
+#include <utility>
 
 #include "audio_frame.pb.h"
 #include "ffi.pb.h"
+#include "ffi_arena.h"
 #include "ffi_client.h"
+#include "latency_trace.h"
+#include "log.h"
 #include "livekit/audio_frame.h"
+#include "spsc_ring.h"
+#include "thread_util.h"
 
 namespace livekit {
 
@@ -35,13 +46,184 @@ static double now_seconds() {
   return std::chrono::duration_cast<std::chrono::duration<double>>(now).count();
 }
 
+// ============================================================================
+// AudioSource::AsyncCapture
+// ============================================================================
+
+// Worker behind pushFrame(): drains the ring, coalesces frames into one
+// buffer and keeps exactly one capture request in flight.
+struct AudioSource::AsyncCapture {
+  AsyncCapture(std::uint64_t handle, int rate, int channels,
+               const AsyncCaptureOptions &opts)
+      : source_handle(handle), sample_rate(rate), num_channels(channels),
+        options(opts),
+        ring(opts.max_queued_frames == 0 ? 1 : opts.max_queued_frames) {
+    const int batch_ms = std::max(options.max_batch_ms, 10);
+    max_batch_samples = rate * batch_ms / 1000;
+    worker = std::thread([this] {
+      detail::registerThread(ThreadRole::kAudio, "lk-audio-cap");
+      run();
+    });
+  }
+
+  ~AsyncCapture() {
+    ring.close(/*discard_pending=*/true);
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+
+  // Producer side (single thread).
+  bool push(AudioFrame &&frame) {
+    // Checking the size first keeps the ring from ever skipping queued audio
+    // (it only drops when more than capacity() items are outstanding).
+    if (ring.size() >= ring.capacity()) {
+      return false;
+    }
+    const auto samples =
+        static_cast<std::uint64_t>(frame.samples_per_channel());
+    pushed_frames.fetch_add(1, std::memory_order_relaxed);
+    pushed_samples.fetch_add(samples, std::memory_order_release);
+    ring.push(std::move(frame));
+    return true;
+  }
+
+  void clear() {
+    discard_before.store(pushed_frames.load(std::memory_order_relaxed),
+                         std::memory_order_release);
+  }
+
+  double queuedSeconds() const noexcept {
+    const std::uint64_t pushed = pushed_samples.load(std::memory_order_acquire);
+    const std::uint64_t acked = acked_samples.load(std::memory_order_acquire);
+    return static_cast<double>(pushed - acked) / sample_rate;
+  }
+
+  bool waitForAcks(int timeout_ms) {
+    std::unique_lock<std::mutex> lock(ack_mutex);
+    auto drained = [this] {
+      return acked_samples.load(std::memory_order_acquire) ==
+                 pushed_samples.load(std::memory_order_acquire) ||
+             stopped;
+    };
+    if (timeout_ms <= 0) {
+      ack_cv.wait(lock, drained);
+      return true;
+    }
+    return ack_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                           drained);
+  }
+
+  void run() {
+    AudioFramePool pool(4);
+    AudioFrame next;
+    bool have_next = false;
+    for (;;) {
+      if (!have_next && !ring.pop(next)) {
+        break;
+      }
+      have_next = false;
+
+      // Coalesce: start with one frame, then take whatever else is already
+      // queued while it fits the batch limit.
+      std::vector<AudioFrame> batch;
+      batch.push_back(std::move(next));
+      int batch_samples = batch.back().samples_per_channel();
+      while (batch_samples < max_batch_samples && ring.tryPop(next)) {
+        if (batch_samples + next.samples_per_channel() > max_batch_samples) {
+          have_next = true;
+          break;
+        }
+        batch_samples += next.samples_per_channel();
+        batch.push_back(std::move(next));
+      }
+
+      const std::uint64_t first_index = popped_frames;
+      popped_frames += batch.size();
+      std::exception_ptr error;
+      if (first_index + batch.size() >
+          discard_before.load(std::memory_order_acquire)) {
+        error = send(pool, batch, batch_samples);
+      }
+      acknowledge(batch, static_cast<std::uint64_t>(batch_samples), error);
+    }
+    {
+      std::lock_guard<std::mutex> lock(ack_mutex);
+      stopped = true;
+    }
+    ack_cv.notify_all();
+  }
+
+  std::exception_ptr send(AudioFramePool &pool,
+                          const std::vector<AudioFrame> &batch,
+                          int batch_samples) {
+    detail::TraceSpan span(TraceMedia::kAudio, TraceStage::kCapture);
+    try {
+      AudioFrame merged =
+          pool.acquire(sample_rate, num_channels, batch_samples);
+      std::int16_t *dst = merged.data().data();
+      for (const auto &frame : batch) {
+        std::memcpy(dst, frame.data().data(),
+                    frame.total_samples() * sizeof(std::int16_t));
+        dst += frame.total_samples();
+      }
+      proto::AudioFrameBufferInfo buf = merged.toProto();
+      // One request in flight: the ack keeps `merged` alive until Rust has
+      // consumed it.
+      FfiClient::instance().captureAudioFrameAsync(source_handle, buf).get();
+      return nullptr;
+    } catch (...) {
+      return std::current_exception();
+    }
+  }
+
+  void acknowledge(const std::vector<AudioFrame> &batch,
+                   std::uint64_t samples, std::exception_ptr error) {
+    if (options.on_complete) {
+      options.on_complete(batch.size(), error);
+    }
+    {
+      std::lock_guard<std::mutex> lock(ack_mutex);
+      acked_samples.fetch_add(samples, std::memory_order_release);
+    }
+    ack_cv.notify_all();
+  }
+
+  const std::uint64_t source_handle;
+  const int sample_rate;
+  const int num_channels;
+  const AsyncCaptureOptions options;
+  int max_batch_samples{0};
+
+  detail::SpscRing<AudioFrame> ring;
+  std::atomic<std::uint64_t> pushed_frames{0};
+  std::atomic<std::uint64_t> pushed_samples{0};
+  std::atomic<std::uint64_t> acked_samples{0};
+  std::atomic<std::uint64_t> discard_before{0};
+  std::uint64_t popped_frames{0}; // worker-owned
+
+  std::mutex ack_mutex;
+  std::condition_variable ack_cv;
+  bool stopped{false};
+  std::thread worker;
+};
+
+// Two producers may race on the first pushFrame(), and queuedDuration()
+// and flush() may run on other threads, so creation is serialized and the
+// result published through an atomic.
+struct AudioSource::AsyncSlot {
+  std::mutex mutex;
+  std::atomic<AsyncCapture *> capture{nullptr};
+  std::unique_ptr<AsyncCapture> owner;
+};
+
 // ============================================================================
 // AudioSource
 // ============================================================================
 
 AudioSource::AudioSource(int sample_rate, int num_channels, int queue_size_ms)
     : sample_rate_(sample_rate), num_channels_(num_channels),
-      queue_size_ms_(queue_size_ms) {
+      queue_size_ms_(queue_size_ms), async_(std::make_unique<AsyncSlot>()) {
   proto::FfiRequest req;
   auto *msg = req.mutable_new_audio_source();
   msg->set_type(proto::AudioSourceType::AUDIO_SOURCE_NATIVE);
@@ -53,10 +235,16 @@ AudioSource::AudioSource(int sample_rate, int num_channels, int queue_size_ms)
 
   const auto &source_info = resp.new_audio_source().source();
   // Wrap FFI handle in RAII FfiHandle
-  handle_ = FfiHandle(static_cast<uintptr_t>(source_info.handle().id()));
+  handle_ = FfiHandle(static_cast<uintptr_t>(source_info.handle().id()),
+                      ResourceKind::kAudioSource);
 }
 
+AudioSource::~AudioSource() = default;
+
 double AudioSource::queuedDuration() const noexcept {
+  if (const AsyncCapture *async = asyncCapture()) {
+    return async->queuedSeconds();
+  }
   if (last_capture_ == 0.0) {
     return 0.0;
   }
@@ -78,11 +266,17 @@ void AudioSource::clearQueue() {
     return;
   }
 
-  proto::FfiRequest req;
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
   auto *msg = req.mutable_clear_audio_buffer();
   msg->set_source_handle(static_cast<std::uint64_t>(handle_.get()));
 
-  (void)FfiClient::instance().sendRequest(req);
+  if (AsyncCapture *async = asyncCapture()) {
+    // Frames still waiting locally are acknowledged without being sent.
+    async->clear();
+  }
+
+  (void)FfiClient::instance().sendRequest(req, arena);
 
   // Reset local queue tracking.
   resetQueueTracking();
@@ -109,6 +303,7 @@ void AudioSource::captureFrame(const AudioFrame &frame, int timeout_ms) {
   }
   last_capture_ = now;
 
+  detail::TraceSpan span(TraceMedia::kAudio, TraceStage::kCapture);
   // Build AudioFrameBufferInfo from the wrapper
   proto::AudioFrameBufferInfo buf = frame.toProto();
   // Use async FFI API and block until the callback completes
@@ -123,9 +318,74 @@ void AudioSource::captureFrame(const AudioFrame &frame, int timeout_ms) {
       status == std::future_status::deferred) {
     fut.get();
   } else { // std::future_status::timeout
-    std::cerr << "captureAudioFrameAsync timed out after " << timeout_ms
-              << " ms\n";
+    LK_LOG_WARN("livekit::audio_source",
+                "captureAudioFrameAsync timed out after %d ms", timeout_ms);
+  }
+}
+
+void AudioSource::captureFrame(const FloatAudioFrame &frame, int timeout_ms) {
+  if (!handle_ || frame.samples_per_channel() == 0) {
+    return;
   }
+  // The FFI takes interleaved int16; convert once into a pooled buffer.
+  captureFrame(frame.toFrame(frame_pool_), timeout_ms);
+}
+
+AudioFrame AudioSource::acquireFrame(int samples_per_channel) {
+  return frame_pool_.acquire(sample_rate_, num_channels_, samples_per_channel);
+}
+
+void AudioSource::enableAsyncCapture(const AsyncCaptureOptions &options) {
+  startAsyncCapture(options, /*exclusive=*/true);
+}
+
+AudioSource::AsyncCapture *AudioSource::asyncCapture() const noexcept {
+  return async_ ? async_->capture.load(std::memory_order_acquire) : nullptr;
+}
+
+AudioSource::AsyncCapture *
+AudioSource::startAsyncCapture(const AsyncCaptureOptions &options,
+                               bool exclusive) {
+  std::lock_guard<std::mutex> lock(async_->mutex);
+  if (async_->owner) {
+    if (exclusive) {
+      throw std::runtime_error(
+          "AudioSource::enableAsyncCapture: already started");
+    }
+    return async_->owner.get();
+  }
+  async_->owner = std::make_unique<AsyncCapture>(handle_.get(), sample_rate_,
+                                                 num_channels_, options);
+  async_->capture.store(async_->owner.get(), std::memory_order_release);
+  return async_->owner.get();
+}
+
+bool AudioSource::pushFrame(AudioFrame &&frame) {
+  if (!handle_ || frame.samples_per_channel() == 0) {
+    return false;
+  }
+  if (frame.sample_rate() != sample_rate_ ||
+      frame.num_channels() != num_channels_) {
+    throw std::invalid_argument(
+        "AudioSource::pushFrame: frame format does not match the source");
+  }
+  AsyncCapture *async = asyncCapture();
+  if (!async) {
+    async = startAsyncCapture(AsyncCaptureOptions{}, /*exclusive=*/false);
+  }
+  return async->push(std::move(frame));
+}
+
+bool AudioSource::pushFrame(const FloatAudioFrame &frame) {
+  if (!handle_ || frame.samples_per_channel() == 0) {
+    return false;
+  }
+  return pushFrame(frame.toFrame(frame_pool_));
+}
+
+bool AudioSource::flush(int timeout_ms) {
+  AsyncCapture *async = asyncCapture();
+  return async ? async->waitForAcks(timeout_ms) : true;
 }
 
 } // namespace livekit
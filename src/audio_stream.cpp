@@ -16,17 +16,42 @@
 
 #include "livekit/audio_stream.h"
 
+#include <algorithm>
+#include <stdexcept>
 #include <utility>
 
 #include "audio_frame.pb.h"
+#include "audio_levels.h"
 #include "ffi.pb.h"
 #include "ffi_client.h"
+#include "latency_trace.h"
+#include "livekit/shared_frame_ring.h"
 #include "livekit/track.h"
+#include "media_stream_stats.h"
+#include "sdk_metrics.h"
+#include "spsc_ring.h"
 
 namespace livekit {
 
 using proto::FfiEvent;
 using proto::FfiRequest;
+using TimePoint = std::chrono::steady_clock::time_point;
+
+namespace {
+
+// AudioFrameEvent::timestamp_us restarts beyond this drift from arrivals.
+constexpr std::int64_t kMaxMediaDriftUs = 200000;
+
+// Traces arrival to on_frame invocation, once the callback is about to run.
+void traceCallback(TimePoint arrived) {
+  if (arrived != TimePoint{}) {
+    detail::LatencyTracer::instance().record(
+        TraceMedia::kAudio, TraceStage::kReceiveTotal, arrived,
+        detail::TraceClock::now());
+  }
+}
+
+} // namespace
 
 // ------------------------
 // Factory helpers
@@ -52,6 +77,9 @@ AudioStream::fromParticipant(Participant &participant, TrackSource track_source,
 // Destructor / move
 // ------------------------
 
+AudioStream::AudioStream()
+    : stats_(std::make_unique<detail::MediaStreamStatsRecorder>()) {}
+
 AudioStream::~AudioStream() { close(); }
 
 AudioStream::AudioStream(AudioStream &&other) noexcept {
@@ -61,6 +89,20 @@ AudioStream::AudioStream(AudioStream &&other) noexcept {
   eof_ = other.eof_;
   closed_ = other.closed_;
   options_ = other.options_;
+  on_frame_ = std::move(other.on_frame_);
+  on_eos_ = std::move(other.on_eos_);
+  callback_executor_ = std::move(other.callback_executor_);
+  frame_pool_ = std::move(other.frame_pool_);
+  ring_ = std::move(other.ring_);
+  stats_ = std::move(other.stats_);
+  vad_ = std::move(other.vad_);
+  media_anchor_us_ = other.media_anchor_us_;
+  media_samples_ = other.media_samples_;
+  media_rate_ = other.media_rate_;
+  metrics_depth_.store(other.metrics_depth_.exchange(0));
+  metrics_bytes_.store(other.metrics_bytes_.exchange(0));
+  metrics_ring_dropped_.store(other.metrics_ring_dropped_.exchange(0));
+  resampler_ = std::move(other.resampler_);
   stream_handle_ = std::move(other.stream_handle_);
   listener_id_ = other.listener_id_;
 
@@ -84,6 +126,20 @@ AudioStream &AudioStream::operator=(AudioStream &&other) noexcept {
     eof_ = other.eof_;
     closed_ = other.closed_;
     options_ = other.options_;
+    on_frame_ = std::move(other.on_frame_);
+    on_eos_ = std::move(other.on_eos_);
+    callback_executor_ = std::move(other.callback_executor_);
+    frame_pool_ = std::move(other.frame_pool_);
+    ring_ = std::move(other.ring_);
+    stats_ = std::move(other.stats_);
+    vad_ = std::move(other.vad_);
+    media_anchor_us_ = other.media_anchor_us_;
+    media_samples_ = other.media_samples_;
+    media_rate_ = other.media_rate_;
+    metrics_depth_.store(other.metrics_depth_.exchange(0));
+    metrics_bytes_.store(other.metrics_bytes_.exchange(0));
+    metrics_ring_dropped_.store(other.metrics_ring_dropped_.exchange(0));
+    resampler_ = std::move(other.resampler_);
     stream_handle_ = std::move(other.stream_handle_);
     listener_id_ = other.listener_id_;
 
@@ -95,26 +151,208 @@ AudioStream &AudioStream::operator=(AudioStream &&other) noexcept {
 }
 
 bool AudioStream::read(AudioFrameEvent &out_event) {
-  std::unique_lock<std::mutex> lock(mutex_);
+  AudioFrameViewEvent ev;
+  if (!read(ev)) {
+    return false;
+  }
+  // Copy outside the lock; the native buffer is dropped when `ev` goes out of
+  // scope.
+  out_event.frame = convertFrame(ev.frame);
+  out_event.levels = ev.levels;
+  out_event.timestamp_us = ev.timestamp_us;
+  return true;
+}
+
+bool AudioStream::read(FloatAudioFrameEvent &out_event) {
+  AudioFrameViewEvent ev;
+  if (!read(ev)) {
+    return false;
+  }
+  out_event.frame = convertFloatFrame(ev.frame);
+  out_event.levels = ev.levels;
+  out_event.timestamp_us = ev.timestamp_us;
+  return true;
+}
+
+bool AudioStream::read(AudioFrameViewEvent &out_event) {
+  QueuedFrame queued;
+  if (ring_) {
+    if (!ring_->pop(queued)) {
+      return false;
+    }
+  } else {
+    std::unique_lock<std::mutex> lock(mutex_);
 
-  cv_.wait(lock, [this] { return !queue_.empty() || eof_ || closed_; });
+    cv_.wait(lock, [this] { return !queue_.empty() || eof_ || closed_; });
 
-  if (closed_ || (queue_.empty() && eof_)) {
-    return false; // EOS / closed
+    if (closed_ || (queue_.empty() && eof_)) {
+      return false; // EOS / closed
+    }
+
+    queued = std::move(queue_.front());
+    queue_.pop_front();
   }
+  takeFrame(queued, out_event);
+  return true;
+}
 
-  out_event = std::move(queue_.front());
-  queue_.pop_front();
+bool AudioStream::tryRead(AudioFrameEvent &out_event) {
+  AudioFrameViewEvent ev;
+  if (!tryRead(ev)) {
+    return false;
+  }
+  out_event.frame = convertFrame(ev.frame);
+  out_event.levels = ev.levels;
+  out_event.timestamp_us = ev.timestamp_us;
   return true;
 }
 
+bool AudioStream::tryRead(FloatAudioFrameEvent &out_event) {
+  AudioFrameViewEvent ev;
+  if (!tryRead(ev)) {
+    return false;
+  }
+  out_event.frame = convertFloatFrame(ev.frame);
+  out_event.levels = ev.levels;
+  out_event.timestamp_us = ev.timestamp_us;
+  return true;
+}
+
+bool AudioStream::tryRead(AudioFrameViewEvent &out_event) {
+  QueuedFrame queued;
+  if (ring_) {
+    if (!ring_->tryPop(queued)) {
+      return false;
+    }
+  } else {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_ || queue_.empty()) {
+      return false;
+    }
+    queued = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  takeFrame(queued, out_event);
+  return true;
+}
+
+bool AudioStream::readFor(AudioFrameEvent &out_event,
+                          std::chrono::milliseconds timeout) {
+  AudioFrameViewEvent ev;
+  if (!readFor(ev, timeout)) {
+    return false;
+  }
+  out_event.frame = convertFrame(ev.frame);
+  out_event.levels = ev.levels;
+  out_event.timestamp_us = ev.timestamp_us;
+  return true;
+}
+
+bool AudioStream::readFor(FloatAudioFrameEvent &out_event,
+                          std::chrono::milliseconds timeout) {
+  AudioFrameViewEvent ev;
+  if (!readFor(ev, timeout)) {
+    return false;
+  }
+  out_event.frame = convertFloatFrame(ev.frame);
+  out_event.levels = ev.levels;
+  out_event.timestamp_us = ev.timestamp_us;
+  return true;
+}
+
+bool AudioStream::readFor(AudioFrameViewEvent &out_event,
+                          std::chrono::milliseconds timeout) {
+  QueuedFrame queued;
+  if (ring_) {
+    if (!ring_->popFor(queued, timeout)) {
+      return false;
+    }
+  } else {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, timeout,
+                 [this] { return !queue_.empty() || eof_ || closed_; });
+    if (closed_ || queue_.empty()) {
+      return false; // timeout / EOS / closed
+    }
+    queued = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  takeFrame(queued, out_event);
+  return true;
+}
+
+std::size_t AudioStream::readBatch(std::vector<AudioFrameEvent> &out,
+                                   std::size_t max_events) {
+  std::vector<AudioFrameViewEvent> views;
+  const std::size_t n = readBatch(views, max_events);
+  // Copy outside the lock, as in read().
+  out.reserve(out.size() + n);
+  for (auto &ev : views) {
+    out.push_back(
+        AudioFrameEvent{convertFrame(ev.frame), ev.levels, ev.timestamp_us});
+  }
+  return n;
+}
+
+std::size_t AudioStream::readBatch(std::vector<AudioFrameViewEvent> &out,
+                                   std::size_t max_events) {
+  std::size_t n = 0;
+  if (ring_) {
+    QueuedFrame queued;
+    while (n < max_events && ring_->tryPop(queued)) {
+      out.emplace_back();
+      takeFrame(queued, out.back());
+      ++n;
+    }
+    return n;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    return 0;
+  }
+  n = std::min(max_events, queue_.size());
+  auto end = queue_.begin() + static_cast<std::ptrdiff_t>(n);
+  out.reserve(out.size() + n);
+  for (auto it = queue_.begin(); it != end; ++it) {
+    out.emplace_back();
+    takeFrame(*it, out.back());
+  }
+  queue_.erase(queue_.begin(), end);
+  return n;
+}
+
+bool AudioStream::isEnded() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    return true;
+  }
+  if (!eof_) {
+    return false;
+  }
+  return ring_ ? ring_->size() == 0 : queue_.empty();
+}
+
+MediaStreamStats AudioStream::stats() const {
+  if (!stats_) {
+    return {}; // moved-from
+  }
+  if (ring_) {
+    return stats_->snapshot(ring_->size(), ring_->dropped());
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_->snapshot(queue_.size(), 0);
+}
+
 void AudioStream::close() {
+  std::size_t discarded = 0;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     if (closed_) {
       return;
     }
     closed_ = true;
+    discarded = queue_.size();
   }
 
   // Dispose FFI handle
@@ -128,22 +366,52 @@ void AudioStream::close() {
     listener_id_ = 0;
   }
 
+  auto &metrics = detail::SdkMetrics::instance().audio;
+  if (ring_) {
+    metrics.observeRingDrops(ring_->dropped(), metrics_ring_dropped_);
+    discarded = ring_->size();
+  }
+  metrics.release(discarded, metrics_depth_);
+  metrics.releaseBytes(metrics_bytes_);
+
   // Wake any waiting readers
+  if (ring_) {
+    ring_->close(/*discard_pending=*/true);
+  }
   cv_.notify_all();
 }
 
 // Internal functions
 
-void AudioStream::initFromTrack(const std::shared_ptr<Track> &track,
-                                const Options &options) {
+void AudioStream::applyOptions(const Options &options) {
+  if (options.export_ring &&
+      options.export_ring->kind() != SharedFrameRing::Kind::kAudio) {
+    throw std::invalid_argument(
+        "AudioStream: export_ring is not an audio ring");
+  }
   capacity_ = options.capacity;
   options_ = options;
+  options_.detect_voice = options.detect_voice || options.voice_only;
+  options_.measure_levels = options.measure_levels || options_.detect_voice;
+  on_frame_ = std::exchange(options_.on_frame, nullptr);
+  on_eos_ = std::exchange(options_.on_eos, nullptr);
+  callback_executor_ = std::exchange(options_.callback_executor, nullptr);
+  frame_pool_ = options.frame_pool ? options.frame_pool
+                                   : std::make_shared<AudioFramePool>();
+  if (options.spsc_ring && capacity_ > 0) {
+    ring_ = std::make_unique<detail::SpscRing<QueuedFrame>>(capacity_);
+  }
+  if (options_.detect_voice) {
+    vad_ = std::make_unique<detail::VoiceDetector>(options.vad_threshold_db,
+                                                   options.vad_hangover_ms);
+  }
+}
 
-  // 1) Subscribe to FFI events
-  listener_id_ = FfiClient::instance().AddListener(
-      [this](const FfiEvent &e) { this->onFfiEvent(e); });
+void AudioStream::initFromTrack(const std::shared_ptr<Track> &track,
+                                const Options &options) {
+  applyOptions(options);
 
-  // 2) Send FfiRequest to create a new audio stream bound to this track
+  // Send FfiRequest to create a new audio stream bound to this track
   FfiRequest req;
   auto *new_audio_stream = req.mutable_new_audio_stream();
   new_audio_stream->set_track_handle(
@@ -163,22 +431,23 @@ void AudioStream::initFromTrack(const std::shared_ptr<Track> &track,
         options_.noise_cancellation_options_json);
   }
 
+  // Events for the new stream that beat subscribeToStreamEvents() are held
+  // for its listener instead of being dropped.
+  auto hold =
+      FfiClient::instance().holdHandleEvents(FfiEvent::kAudioStreamEvent);
   auto resp = FfiClient::instance().sendRequest(req);
   const auto &stream = resp.new_audio_stream().stream();
-  stream_handle_ = FfiHandle(static_cast<uintptr_t>(stream.handle().id()));
+  stream_handle_ = FfiHandle(static_cast<uintptr_t>(stream.handle().id()),
+                             ResourceKind::kAudioStream);
+  subscribeToStreamEvents();
 }
 
 void AudioStream::initFromParticipant(Participant &participant,
                                       TrackSource track_source,
                                       const Options &options) {
-  capacity_ = options.capacity;
-  options_ = options;
-
-  // 1) Subscribe to FFI events
-  listener_id_ = FfiClient::instance().AddListener(
-      [this](const FfiEvent &e) { this->onFfiEvent(e); });
+  applyOptions(options);
 
-  // 2) Send FfiRequest to create audio stream from participant + track source
+  // Send FfiRequest to create audio stream from participant + track source
   FfiRequest req;
   auto *as = req.mutable_audio_stream_from_participant();
   as->set_participant_handle(participant.ffiHandleId());
@@ -196,9 +465,22 @@ void AudioStream::initFromParticipant(Participant &participant,
     as->set_audio_filter_options(options_.noise_cancellation_options_json);
   }
 
+  auto hold =
+      FfiClient::instance().holdHandleEvents(FfiEvent::kAudioStreamEvent);
   auto resp = FfiClient::instance().sendRequest(req);
   const auto &stream = resp.audio_stream_from_participant().stream();
-  stream_handle_ = FfiHandle(static_cast<uintptr_t>(stream.handle().id()));
+  stream_handle_ = FfiHandle(static_cast<uintptr_t>(stream.handle().id()),
+                             ResourceKind::kAudioStream);
+  subscribeToStreamEvents();
+}
+
+void AudioStream::subscribeToStreamEvents() {
+  // Events are routed by stream handle, so this listener only ever sees
+  // events for this stream.
+  listener_id_ = FfiClient::instance().AddHandleListener(
+      FfiEvent::kAudioStreamEvent,
+      static_cast<std::uint64_t>(stream_handle_.get()),
+      [this](const FfiEvent &e) { this->onFfiEvent(e); });
 }
 
 void AudioStream::onFfiEvent(const FfiEvent &event) {
@@ -212,15 +494,138 @@ void AudioStream::onFfiEvent(const FfiEvent &event) {
   }
   if (ase.has_frame_received()) {
     const auto &fr = ase.frame_received();
-    AudioFrame frame = AudioFrame::fromOwnedInfo(fr.frame());
-    AudioFrameEvent ev{std::move(frame)};
-    pushFrame(std::move(ev));
+    const auto arrived =
+        detail::tracingOn() ? detail::TraceClock::now() : TimePoint{};
+    AudioFrameViewEvent ev{AudioFrameView::fromOwnedInfo(fr.frame()), {}};
+    ev.timestamp_us = mediaTimestamp(ev.frame);
+    if (options_.measure_levels && !analyzeFrame(ev)) {
+      return;
+    }
+    if (options_.export_ring) {
+      options_.export_ring->write(ev.frame, ev.timestamp_us);
+      if (options_.export_only) {
+        detail::SdkMetrics::instance().audio.frames_received.add();
+        stats_->onReceived();
+        stats_->onDelivered();
+        return;
+      }
+    }
+    pushFrame(std::move(ev), arrived);
   } else if (ase.has_eos()) {
     pushEos();
   }
 }
 
-void AudioStream::pushFrame(AudioFrameEvent &&ev) {
+std::int64_t AudioStream::mediaTimestamp(const AudioFrameView &frame) {
+  const std::int64_t now_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  const int rate = frame.sample_rate();
+  if (rate <= 0) {
+    return now_us;
+  }
+  std::int64_t timestamp = 0;
+  if (rate == media_rate_) {
+    timestamp = media_anchor_us_ + media_samples_ * 1000000 / rate;
+  }
+  // First frame, format change, or the media time has drifted too far from
+  // arrivals (a muted or stalled track): restart from the arrival time.
+  if (rate != media_rate_ || timestamp > now_us + kMaxMediaDriftUs ||
+      timestamp < now_us - kMaxMediaDriftUs) {
+    media_anchor_us_ = now_us;
+    media_samples_ = 0;
+    media_rate_ = rate;
+    timestamp = now_us;
+  }
+  media_samples_ += frame.samples_per_channel();
+  return timestamp;
+}
+
+bool AudioStream::analyzeFrame(AudioFrameViewEvent &ev) {
+  AudioLevels levels =
+      detail::measureLevels(ev.frame.data(), ev.frame.total_samples());
+  if (vad_) {
+    levels.voice = vad_->update(levels.rms, ev.frame.duration() * 1000.0);
+  }
+  ev.levels = levels;
+  if (options_.voice_only && !levels.voice) {
+    // The native buffer is released with `ev`; nothing was copied.
+    detail::SdkMetrics::instance().audio.frames_received.add();
+    stats_->onReceived();
+    stats_->onEvicted();
+    return false;
+  }
+  return true;
+}
+
+AudioFrame AudioStream::convertFrame(const AudioFrameView &view) {
+  detail::TraceSpan span(TraceMedia::kAudio, TraceStage::kReceiveConvert);
+  const int target_channels = options_.num_channels;
+  const int target_rate = options_.sample_rate;
+  AudioFrame frame = view.toFrame(*frame_pool_);
+  if (target_channels > 0 && frame.num_channels() != target_channels) {
+    frame = frame.remix(target_channels);
+  }
+  if (target_rate <= 0 || frame.sample_rate() == target_rate) {
+    return frame;
+  }
+
+  std::lock_guard<std::mutex> lock(convert_mutex_);
+  if (!resampler_ || resampler_->inputRate() != frame.sample_rate() ||
+      resampler_->numChannels() != frame.num_channels()) {
+    // (Re)create on the first frame or if the track's format changed.
+    resampler_ = std::make_unique<AudioResampler>(
+        frame.sample_rate(), target_rate, frame.num_channels());
+  }
+  return resampler_->resample(frame);
+}
+
+FloatAudioFrame AudioStream::convertFloatFrame(const AudioFrameView &view) {
+  const bool remix = options_.num_channels > 0 &&
+                     view.num_channels() != options_.num_channels;
+  const bool resample = options_.sample_rate > 0 &&
+                        view.sample_rate() != options_.sample_rate;
+  if (remix || resample) {
+    // Remixing and resampling work on int16; convert their (pooled) output.
+    return FloatAudioFrame::fromFrame(convertFrame(view),
+                                      options_.float_layout);
+  }
+  detail::TraceSpan span(TraceMedia::kAudio, TraceStage::kReceiveConvert);
+  return view.toFloatFrame(options_.float_layout);
+}
+
+void AudioStream::pushFrame(AudioFrameViewEvent &&ev, TimePoint arrived) {
+  auto &metrics = detail::SdkMetrics::instance().audio;
+  metrics.frames_received.add();
+  if (on_frame_) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_ || eof_) {
+        return;
+      }
+    }
+    stats_->onReceived();
+    stats_->onDelivered();
+    deliverToCallback(std::move(ev), arrived);
+    return;
+  }
+  const std::size_t frame_bytes =
+      ev.frame.total_samples() * sizeof(std::int16_t);
+  if (ring_) {
+    // Lock-free path: the ring applies drop-oldest itself and wakes a parked
+    // reader only when needed.
+    if (!ring_->closed()) {
+      stats_->onReceived();
+      ring_->push(QueuedFrame{std::move(ev), TimePoint::clock::now(), arrived});
+      const std::size_t depth = ring_->size();
+      stats_->onQueued(depth);
+      metrics.observeRingDrops(ring_->dropped(), metrics_ring_dropped_);
+      metrics.observeDepth(depth, metrics_depth_);
+      metrics.observeBytes(depth * frame_bytes, metrics_bytes_);
+    }
+    return;
+  }
   {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -228,12 +633,19 @@ void AudioStream::pushFrame(AudioFrameEvent &&ev) {
       return;
     }
 
+    stats_->onReceived();
     if (capacity_ > 0 && queue_.size() >= capacity_) {
       // Ring behavior: drop oldest frame when full.
       queue_.pop_front();
+      metrics.frames_dropped.add();
+      stats_->onEvicted();
     }
 
-    queue_.push_back(std::move(ev));
+    queue_.push_back(
+        QueuedFrame{std::move(ev), TimePoint::clock::now(), arrived});
+    stats_->onQueued(queue_.size());
+    metrics.observeDepth(queue_.size(), metrics_depth_);
+    metrics.observeBytes(queue_.size() * frame_bytes, metrics_bytes_);
   }
   cv_.notify_one();
 }
@@ -246,7 +658,47 @@ void AudioStream::pushEos() {
     }
     eof_ = true;
   }
+  if (ring_) {
+    ring_->close();
+  }
   cv_.notify_all();
+
+  if (on_frame_ && on_eos_) {
+    if (callback_executor_) {
+      callback_executor_(on_eos_);
+    } else {
+      on_eos_();
+    }
+  }
+}
+
+void AudioStream::takeFrame(QueuedFrame &queued, AudioFrameViewEvent &out) {
+  const auto now = std::chrono::steady_clock::now();
+  stats_->onDelivered(queued.enqueued, now);
+  out = std::move(queued.event);
+  if (queued.arrived != TimePoint{}) {
+    auto &tracer = detail::LatencyTracer::instance();
+    tracer.record(TraceMedia::kAudio, TraceStage::kReceiveQueue,
+                  queued.enqueued, now);
+    tracer.record(TraceMedia::kAudio, TraceStage::kReceiveTotal,
+                  queued.arrived, now);
+  }
+}
+
+void AudioStream::deliverToCallback(AudioFrameViewEvent &&ev,
+                                    TimePoint arrived) {
+  if (!callback_executor_) {
+    traceCallback(arrived);
+    on_frame_(std::move(ev));
+    return;
+  }
+  // std::function needs a copyable target, so the move-only frame travels
+  // behind a shared_ptr.
+  auto frame = std::make_shared<AudioFrameViewEvent>(std::move(ev));
+  callback_executor_([cb = on_frame_, frame, arrived] {
+    traceCallback(arrived);
+    cb(std::move(*frame));
+  });
 }
 
 } // namespace livekit
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/av_sync.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "livekit/frame_pool.h"
+#include "livekit/participant.h"
+
+namespace livekit {
+
+namespace {
+
+constexpr std::size_t kOffsetWindow = 64;
+
+std::int64_t nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+struct AvSync::Impl {
+  struct QueuedVideo {
+    std::int64_t time_us;
+    std::shared_ptr<const VideoFrameEvent> event;
+  };
+
+  Impl(Callback cb, const Options &opts)
+      : options(opts), callback(std::move(cb)), pool(8) {}
+
+  void pushAudio(AudioFrameEvent &&event) {
+    if (event.timestamp_us == 0) {
+      event.timestamp_us = nowUs();
+    }
+    std::lock_guard<std::mutex> order(deliver_mutex);
+    std::vector<AvSyncFrame> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (closed) {
+        return;
+      }
+      newest_audio_us = std::max(newest_audio_us, event.timestamp_us);
+      audio.push_back(std::move(event));
+      collect(ready, /*flush=*/false);
+    }
+    deliver(ready);
+  }
+
+  void pushVideo(VideoFrameEvent &&event, std::int64_t arrival_us) {
+    std::lock_guard<std::mutex> order(deliver_mutex);
+    std::vector<AvSyncFrame> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (closed) {
+        return;
+      }
+      ++stats.video_frames;
+      const std::int64_t time_us = videoTime(event.timestamp_us, arrival_us);
+      if (video.size() >= std::max<std::size_t>(options.max_video_frames, 1)) {
+        video.pop_front();
+        ++stats.video_dropped;
+      }
+      video.push_back(QueuedVideo{
+          time_us, std::make_shared<const VideoFrameEvent>(std::move(event))});
+      collect(ready, /*flush=*/false);
+    }
+    deliver(ready);
+  }
+
+  void flush() {
+    std::lock_guard<std::mutex> order(deliver_mutex);
+    std::vector<AvSyncFrame> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (closed) {
+        return;
+      }
+      closed = true;
+      collect(ready, /*flush=*/true);
+      stats.video_dropped += video.size() + (current && !current_shown);
+      video.clear();
+      current.reset();
+    }
+    deliver(ready);
+  }
+
+  // Maps a sender timestamp onto the receive clock with the smallest
+  // arrival offset in the window, i.e. the least-delayed recent frame.
+  std::int64_t videoTime(std::int64_t timestamp_us, std::int64_t arrival_us) {
+    offsets[offset_count % kOffsetWindow] = arrival_us - timestamp_us;
+    ++offset_count;
+    const std::size_t n = std::min(offset_count, kOffsetWindow);
+    const std::int64_t offset =
+        *std::min_element(offsets.begin(), offsets.begin() + n);
+    const auto extra =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            options.video_offset)
+            .count();
+    return timestamp_us + offset + extra;
+  }
+
+  // Pairs every audio frame that is ready; with `flush`, all of them.
+  // Caller holds `mutex`.
+  void collect(std::vector<AvSyncFrame> &ready, bool flush) {
+    const auto max_delay_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(options.max_delay)
+            .count();
+    while (!audio.empty()) {
+      const std::int64_t a = audio.front().timestamp_us;
+      const bool video_past = !video.empty() && video.back().time_us > a;
+      const bool waited = newest_audio_us - a >= max_delay_us;
+      if (!flush && !video_past && !waited) {
+        break;
+      }
+      if (!video_past && stats.video_frames > 0) {
+        ++stats.audio_unsynced;
+      }
+      while (!video.empty() && video.front().time_us <= a) {
+        if (current && !current_shown) {
+          ++stats.video_dropped;
+        }
+        current = std::move(video.front().event);
+        current_us = video.front().time_us;
+        current_shown = false;
+        video.pop_front();
+      }
+
+      AvSyncFrame frame;
+      frame.audio = std::move(audio.front());
+      audio.pop_front();
+      frame.video = current;
+      frame.video_changed = current && !current_shown;
+      frame.skew_us = current ? a - current_us : 0;
+      current_shown = current_shown || current != nullptr;
+      ++stats.audio_frames;
+      stats.last_skew_us = frame.skew_us;
+      ready.push_back(std::move(frame));
+    }
+  }
+
+  void deliver(std::vector<AvSyncFrame> &ready) {
+    for (auto &frame : ready) {
+      callback(std::move(frame));
+    }
+  }
+
+  void attachStreams(std::shared_ptr<AudioStream> a,
+                     std::shared_ptr<VideoStream> v) {
+    std::lock_guard<std::mutex> lock(mutex);
+    audio_stream = std::move(a);
+    video_stream = std::move(v);
+  }
+
+  const Options options;
+  const Callback callback;
+  AudioFramePool pool;
+
+  // Serializes delivery so frames reach the callback in order.
+  std::mutex deliver_mutex;
+  mutable std::mutex mutex;
+  std::deque<AudioFrameEvent> audio;
+  std::deque<QueuedVideo> video;
+  std::shared_ptr<const VideoFrameEvent> current;
+  std::int64_t current_us{0};
+  bool current_shown{false};
+  std::int64_t newest_audio_us{std::numeric_limits<std::int64_t>::min()};
+  std::array<std::int64_t, kOffsetWindow> offsets{};
+  std::size_t offset_count{0};
+  bool closed{false};
+  AvSyncStats stats;
+
+  std::shared_ptr<AudioStream> audio_stream;
+  std::shared_ptr<VideoStream> video_stream;
+};
+
+AvSync::AvSync(Callback on_frame) : AvSync(std::move(on_frame), Options{}) {}
+
+AvSync::AvSync(Callback on_frame, const Options &options) {
+  if (!on_frame) {
+    throw std::invalid_argument("AvSync: on_frame must be set");
+  }
+  impl_ = std::make_shared<Impl>(std::move(on_frame), options);
+}
+
+AvSync::~AvSync() { close(); }
+
+namespace {
+
+// Stream options feeding `impl`; the callbacks keep it alive, so frames
+// arriving after close() are just ignored.
+template <typename ImplPtr>
+AudioStream::Options audioOptions(const ImplPtr &impl) {
+  AudioStream::Options options;
+  options.on_frame = [impl](AudioFrameViewEvent &&ev) {
+    impl->pushAudio(AudioFrameEvent{ev.frame.toFrame(impl->pool), ev.levels,
+                                    ev.timestamp_us});
+  };
+  options.on_eos = [impl] { impl->flush(); };
+  return options;
+}
+
+template <typename ImplPtr>
+VideoStream::Options videoOptions(const ImplPtr &impl) {
+  VideoStream::Options options;
+  options.format = impl->options.video_format;
+  options.zero_copy = true;
+  options.on_frame = [impl](VideoFrameEvent &&ev) {
+    impl->pushVideo(std::move(ev), nowUs());
+  };
+  return options;
+}
+
+} // namespace
+
+void AvSync::attach(const std::shared_ptr<Track> &audio_track,
+                    const std::shared_ptr<Track> &video_track) {
+  auto audio = AudioStream::fromTrack(audio_track, audioOptions(impl_));
+  auto video = VideoStream::fromTrack(video_track, videoOptions(impl_));
+  impl_->attachStreams(std::move(audio), std::move(video));
+}
+
+void AvSync::attach(Participant &participant, TrackSource audio_source,
+                    TrackSource video_source) {
+  auto audio = AudioStream::fromParticipant(participant, audio_source,
+                                            audioOptions(impl_));
+  auto video = VideoStream::fromParticipant(participant, video_source,
+                                            videoOptions(impl_));
+  impl_->attachStreams(std::move(audio), std::move(video));
+}
+
+void AvSync::pushAudio(AudioFrameEvent &&event) {
+  impl_->pushAudio(std::move(event));
+}
+
+void AvSync::pushVideo(VideoFrameEvent &&event) {
+  impl_->pushVideo(std::move(event), nowUs());
+}
+
+void AvSync::pushVideo(VideoFrameEvent &&event, std::int64_t arrival_us) {
+  impl_->pushVideo(std::move(event), arrival_us);
+}
+
+void AvSync::close() {
+  std::shared_ptr<AudioStream> audio;
+  std::shared_ptr<VideoStream> video;
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    audio = std::move(impl_->audio_stream);
+    video = std::move(impl_->video_stream);
+  }
+  if (audio) {
+    audio->close();
+  }
+  if (video) {
+    video->close();
+  }
+  impl_->flush();
+}
+
+AvSyncStats AvSync::stats() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  return impl_->stats;
+}
+
+} // namespace livekit
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compact_participants.h"
+
+namespace livekit {
+namespace detail {
+
+const std::string *StringPool::acquire(const std::string &value) {
+  auto it = strings_.try_emplace(value, 0).first;
+  ++it->second;
+  return &it->first;
+}
+
+void StringPool::release(const std::string *value) noexcept {
+  if (!value) {
+    return;
+  }
+  auto it = strings_.find(*value);
+  if (it != strings_.end() && --it->second == 0) {
+    strings_.erase(it);
+  }
+}
+
+CompactParticipantStore::~CompactParticipantStore() { clear(); }
+
+void CompactParticipantStore::insert(ParticipantFields fields) {
+  erase(fields.identity);
+  Record record;
+  record.handle = std::move(fields.handle);
+  record.sid = std::move(fields.sid);
+  record.kind = fields.kind;
+  record.reason = fields.reason;
+  assign(record, fields.name, fields.metadata, fields.attributes);
+  records_.emplace(std::move(fields.identity), std::move(record));
+}
+
+bool CompactParticipantStore::update(const std::string &identity,
+                                     const std::string &name,
+                                     const std::string &metadata,
+                                     const AttributeMap &attributes,
+                                     ParticipantKind kind,
+                                     DisconnectReason reason) {
+  auto it = records_.find(identity);
+  if (it == records_.end()) {
+    return false;
+  }
+  Record &record = it->second;
+  // Acquire before releasing so unchanged values keep their pool entry.
+  Record old;
+  old.name = record.name;
+  old.metadata = record.metadata;
+  old.attributes = std::move(record.attributes);
+  assign(record, name, metadata, attributes);
+  releaseStrings(old);
+  record.kind = kind;
+  record.reason = reason;
+  return true;
+}
+
+std::optional<ParticipantFields>
+CompactParticipantStore::take(const std::string &identity) {
+  auto it = records_.find(identity);
+  if (it == records_.end()) {
+    return std::nullopt;
+  }
+  Record &record = it->second;
+  ParticipantFields fields;
+  fields.handle = std::move(record.handle);
+  fields.sid = std::move(record.sid);
+  fields.identity = it->first;
+  fields.name = *record.name;
+  fields.metadata = *record.metadata;
+  AttributeMap::container_type entries;
+  entries.reserve(record.attributes.size());
+  for (const auto &kv : record.attributes) {
+    entries.emplace_back(*kv.first, *kv.second);
+  }
+  fields.attributes = AttributeMap(std::move(entries));
+  fields.kind = record.kind;
+  fields.reason = record.reason;
+  releaseStrings(record);
+  records_.erase(it);
+  return fields;
+}
+
+bool CompactParticipantStore::erase(const std::string &identity) {
+  auto it = records_.find(identity);
+  if (it == records_.end()) {
+    return false;
+  }
+  releaseStrings(it->second);
+  records_.erase(it);
+  return true;
+}
+
+void CompactParticipantStore::clear() noexcept {
+  for (auto &kv : records_) {
+    releaseStrings(kv.second);
+  }
+  records_.clear();
+}
+
+void CompactParticipantStore::assign(Record &record, const std::string &name,
+                                     const std::string &metadata,
+                                     const AttributeMap &attributes) {
+  record.name = pool_.acquire(name);
+  record.metadata = pool_.acquire(metadata);
+  record.attributes.clear();
+  record.attributes.reserve(attributes.size());
+  for (const auto &kv : attributes) {
+    record.attributes.emplace_back(pool_.acquire(kv.first),
+                                   pool_.acquire(kv.second));
+  }
+}
+
+void CompactParticipantStore::releaseStrings(Record &record) noexcept {
+  pool_.release(record.name);
+  pool_.release(record.metadata);
+  for (const auto &kv : record.attributes) {
+    pool_.release(kv.first);
+    pool_.release(kv.second);
+  }
+  record.name = nullptr;
+  record.metadata = nullptr;
+  record.attributes.clear();
+}
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/attribute_map.h"
+#include "livekit/ffi_handle.h"
+#include "livekit/participant.h"
+#include "livekit/room_event_types.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+// Reference-counted pool of immutable strings. Names, metadata and attribute
+// keys/values repeat heavily across the listeners of a large room ("Guest",
+// role=viewer, ...), so each distinct value is stored once. Returned pointers
+// stay valid until the last matching release().
+class StringPool {
+public:
+  const std::string *acquire(const std::string &value);
+  void release(const std::string *value) noexcept;
+
+  // Distinct strings currently held.
+  std::size_t size() const noexcept { return strings_.size(); }
+
+private:
+  // Node-based, so element addresses survive rehashing.
+  std::unordered_map<std::string, std::size_t> strings_;
+};
+
+// Everything needed to build a RemoteParticipant.
+struct ParticipantFields {
+  FfiHandle handle;
+  std::string sid;
+  std::string identity;
+  std::string name;
+  std::string metadata;
+  AttributeMap attributes;
+  ParticipantKind kind = ParticipantKind::Standard;
+  DisconnectReason reason = DisconnectReason::Unknown;
+};
+
+// Remote participants of a RoomOptions::lazy_participants room that nothing
+// has asked for yet. A record keeps the participant's FFI handle, its sid and
+// pooled strings; the identity is only the map key. take() hands the fields
+// back when the Room materializes a full RemoteParticipant.
+//
+// Not thread-safe; the Room guards it with participants_lock_.
+class CompactParticipantStore {
+public:
+  CompactParticipantStore() = default;
+  ~CompactParticipantStore();
+  CompactParticipantStore(const CompactParticipantStore &) = delete;
+  CompactParticipantStore &operator=(const CompactParticipantStore &) = delete;
+
+  // Store `fields`, replacing any record with the same identity.
+  void insert(ParticipantFields fields);
+
+  // Refresh the mutable fields of a stored participant (ParticipantsUpdated).
+  // Returns false if `identity` is not stored.
+  bool update(const std::string &identity, const std::string &name,
+              const std::string &metadata, const AttributeMap &attributes,
+              ParticipantKind kind, DisconnectReason reason);
+
+  // Remove a participant and return its fields, or nullopt if not stored.
+  std::optional<ParticipantFields> take(const std::string &identity);
+
+  // Remove a participant, dropping its handle. Returns false if not stored.
+  bool erase(const std::string &identity);
+
+  bool contains(const std::string &identity) const {
+    return records_.count(identity) != 0;
+  }
+  std::size_t size() const noexcept { return records_.size(); }
+  // Distinct pooled strings, for tests and diagnostics.
+  std::size_t pooledStrings() const noexcept { return pool_.size(); }
+
+  void clear() noexcept;
+
+private:
+  using PooledPair = std::pair<const std::string *, const std::string *>;
+  struct Record {
+    FfiHandle handle;
+    std::string sid;
+    const std::string *name = nullptr;
+    const std::string *metadata = nullptr;
+    std::vector<PooledPair> attributes; // sorted by key, like AttributeMap
+    ParticipantKind kind = ParticipantKind::Standard;
+    DisconnectReason reason = DisconnectReason::Unknown;
+  };
+
+  void assign(Record &record, const std::string &name,
+              const std::string &metadata, const AttributeMap &attributes);
+  void releaseStrings(Record &record) noexcept;
+
+  StringPool pool_;
+  std::unordered_map<std::string, Record> records_;
+};
+
+} // namespace detail
+} // namespace livekit
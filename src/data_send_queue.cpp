@@ -0,0 +1,226 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "data_send_queue.h"
+
+#include <exception>
+#include <utility>
+
+#include "log.h"
+#include "thread_util.h"
+
+namespace livekit {
+namespace detail {
+
+DataSendQueue::Ticket::~Ticket() {
+  if (!charged_) {
+    return;
+  }
+  if (auto queue = queue_.lock()) {
+    queue->release(size_);
+  }
+}
+
+DataSendQueue::DataSendQueue(const DataSendOptions &options)
+    : options_(options) {}
+
+DataSendQueue::~DataSendQueue() {
+  stop();
+  if (worker_.joinable()) {
+    // The sender thread held the last reference and is on its way out.
+    worker_.detach();
+  }
+}
+
+void DataSendQueue::configure(const DataSendOptions &options) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+  }
+  cv_.notify_all();
+}
+
+void DataSendQueue::setChannelThreshold(std::size_t bytes) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    channel_threshold_ = bytes;
+  }
+  cv_.notify_all();
+}
+
+std::shared_ptr<DataSendQueue::Ticket>
+DataSendQueue::ticket(std::size_t size) {
+  return std::shared_ptr<Ticket>(new Ticket(weak_from_this(), size));
+}
+
+std::size_t DataSendQueue::limitLocked() const noexcept {
+  if (options_.max_buffered_bytes > 0) {
+    return options_.max_buffered_bytes;
+  }
+  return channel_threshold_ > 0 ? channel_threshold_
+                                : kDefaultDataSendBufferBytes;
+}
+
+bool DataSendQueue::fitsLocked(DataPriority priority,
+                               std::size_t size) const noexcept {
+  if (buffered_ == 0) {
+    return true;
+  }
+  std::size_t limit = limitLocked();
+  if (priority == DataPriority::kBulk) {
+    const unsigned share = options_.bulk_share_percent > 100
+                               ? 100
+                               : options_.bulk_share_percent;
+    limit = limit / 100 * share;
+  }
+  return buffered_ + size <= limit;
+}
+
+std::deque<DataSendQueue::Entry> *DataSendQueue::readyLocked() {
+  for (std::size_t i = 0; i < queues_.size(); ++i) {
+    if (queues_[i].empty()) {
+      continue;
+    }
+    // Strict priority: a waiting class holds back every class below it.
+    const Entry &head = queues_[i].front();
+    return fitsLocked(static_cast<DataPriority>(i), head.payload.size())
+               ? &queues_[i]
+               : nullptr;
+  }
+  return nullptr;
+}
+
+void DataSendQueue::chargeLocked(Ticket &ticket) {
+  ticket.charged_ = true;
+  buffered_ += ticket.size_;
+  ++sent_;
+}
+
+void DataSendQueue::release(std::size_t size) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffered_ -= size;
+  }
+  cv_.notify_all();
+}
+
+void DataSendQueue::submit(DataPriority priority,
+                           const std::shared_ptr<Ticket> &ticket,
+                           const std::uint8_t *data, std::size_t size,
+                           SendFn send, AbandonFn abandon) {
+  const auto index = static_cast<std::size_t>(priority);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // A packet the sender thread has popped but not sent yet is ahead of
+    // every new one; sending inline past it would reorder the stream.
+    bool ahead = sending_;
+    for (std::size_t i = 0; i <= index; ++i) {
+      ahead = ahead || !queues_[i].empty();
+    }
+    if (!stopped_ && (ahead || !fitsLocked(priority, size))) {
+      Entry entry;
+      entry.ticket = ticket;
+      entry.payload.assign(data, data + size);
+      entry.send = std::move(send);
+      entry.abandon = std::move(abandon);
+      queues_[index].push_back(std::move(entry));
+      queued_bytes_ += size;
+      ++delayed_;
+      if (!worker_.joinable()) {
+        // The sender keeps the queue alive until stop(), so a ticket it
+        // releases is never the queue's last reference.
+        worker_ = std::thread([self = shared_from_this()] {
+          registerThread(ThreadRole::kBackground, "lk-data-send");
+          self->run();
+        });
+      }
+      lock.unlock();
+      cv_.notify_all();
+      return;
+    }
+    chargeLocked(*ticket);
+  }
+  send(data, size);
+}
+
+void DataSendQueue::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    std::deque<Entry> *ready = nullptr;
+    cv_.wait(lock, [&] { return stopped_ || (ready = readyLocked()); });
+    if (stopped_) {
+      return;
+    }
+    Entry entry = std::move(ready->front());
+    ready->pop_front();
+    queued_bytes_ -= entry.payload.size();
+    chargeLocked(*entry.ticket);
+    sending_ = true;
+    lock.unlock();
+    try {
+      entry.send(entry.payload.data(), entry.payload.size());
+    } catch (const std::exception &e) {
+      LK_LOG_WARN("livekit::data", "queued reliable send failed: %s",
+                  e.what());
+    }
+    // Drop the ticket reference before taking the lock again: if the send
+    // already completed this releases the budget, which locks.
+    entry = Entry{};
+    lock.lock();
+    sending_ = false;
+  }
+}
+
+void DataSendQueue::stop() {
+  std::array<std::deque<Entry>, 3> abandoned;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+    abandoned.swap(queues_);
+    queued_bytes_ = 0;
+  }
+  cv_.notify_all();
+  if (worker_.joinable() && worker_.get_id() != std::this_thread::get_id()) {
+    worker_.join();
+  }
+  for (auto &queue : abandoned) {
+    for (auto &entry : queue) {
+      if (entry.abandon) {
+        entry.abandon();
+      }
+    }
+  }
+}
+
+DataSendStats DataSendQueue::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  DataSendStats stats;
+  stats.buffered_bytes = buffered_;
+  stats.limit_bytes = limitLocked();
+  for (const auto &queue : queues_) {
+    stats.queued_packets += queue.size();
+  }
+  stats.queued_bytes = queued_bytes_;
+  stats.packets_sent = sent_;
+  stats.packets_delayed = delayed_;
+  return stats;
+}
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/data_stream.h"
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+// Send budget and priority queue for the reliable data of one
+// LocalParticipant (see DataSendOptions).
+//
+// A packet's completion is registered with the FFI before it is submitted
+// and captures the packet's Ticket, so the bytes stay charged until the
+// completion runs or is cancelled, whichever thread that happens on. A
+// packet that fits is sent on the submitting thread; others are copied and
+// sent, in priority order, by a sender thread started on first use.
+class DataSendQueue : public std::enable_shared_from_this<DataSendQueue> {
+public:
+  // Keeps a sent packet's bytes charged until destroyed.
+  class Ticket {
+  public:
+    ~Ticket();
+
+  private:
+    friend class DataSendQueue;
+    Ticket(std::weak_ptr<DataSendQueue> queue, std::size_t size)
+        : queue_(std::move(queue)), size_(size) {}
+
+    std::weak_ptr<DataSendQueue> queue_;
+    std::size_t size_;
+    bool charged_ = false;
+  };
+
+  // Hands a packet, whose completion is already registered, to the FFI.
+  // On failure it cancels that completion and throws.
+  using SendFn = std::function<void(const std::uint8_t *, std::size_t)>;
+  // Cancels the completion of a packet that will never be sent.
+  using AbandonFn = std::function<void()>;
+
+  explicit DataSendQueue(const DataSendOptions &options);
+  ~DataSendQueue();
+
+  DataSendQueue(const DataSendQueue &) = delete;
+  DataSendQueue &operator=(const DataSendQueue &) = delete;
+
+  void configure(const DataSendOptions &options);
+  // Reliable channel's buffered-amount-low threshold, as reported by the
+  // room; used when DataSendOptions::max_buffered_bytes is 0.
+  void setChannelThreshold(std::size_t bytes);
+
+  std::shared_ptr<Ticket> ticket(std::size_t size);
+
+  // Send on the calling thread if the packet fits the budget and nothing of
+  // equal or higher priority is waiting (a send failure propagates);
+  // otherwise copy the payload and queue it. After stop() every packet is
+  // sent right away.
+  void submit(DataPriority priority, const std::shared_ptr<Ticket> &ticket,
+              const std::uint8_t *data, std::size_t size, SendFn send,
+              AbandonFn abandon);
+
+  // Abandon everything still queued and join the sender thread.
+  void stop();
+
+  DataSendStats stats() const;
+
+private:
+  struct Entry {
+    std::shared_ptr<Ticket> ticket;
+    std::vector<std::uint8_t> payload;
+    SendFn send;
+    AbandonFn abandon;
+  };
+
+  std::size_t limitLocked() const noexcept;
+  bool fitsLocked(DataPriority priority, std::size_t size) const noexcept;
+  // Class whose head can be sent now, or nullptr.
+  std::deque<Entry> *readyLocked();
+  void chargeLocked(Ticket &ticket);
+  void release(std::size_t size);
+  void run();
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  DataSendOptions options_;
+  std::size_t channel_threshold_ = 0;
+  std::size_t buffered_ = 0;
+  std::size_t queued_bytes_ = 0;
+  std::uint64_t sent_ = 0;
+  std::uint64_t delayed_ = 0;
+  std::array<std::deque<Entry>, 3> queues_; // by DataPriority
+  bool stopped_ = false;
+  // Set by run() from popping an entry until its send returns; submit()
+  // queues behind it instead of sending inline.
+  bool sending_ = false;
+  std::thread worker_;
+};
+
+} // namespace detail
+} // namespace livekit
@@ -2,71 +2,28 @@
 
 #include <algorithm>
 #include <chrono>
-#include <random>
+#include <cstring>
 #include <stdexcept>
 
 #include "ffi_client.h"
 #include "livekit/local_participant.h"
+#include "log.h"
+#include "random_id.h"
 #include "room.pb.h"
+#include "sdk_metrics.h"
+#include "stream_budget.h"
+#include "thread_util.h"
+#include "utf8_chunk.h"
 
 namespace livekit {
 
-namespace {
-
-std::string generateRandomId(std::size_t bytes = 16) {
-  static thread_local std::mt19937_64 rng{std::random_device{}()};
-  std::uniform_int_distribution<int> dist(0, 255);
-
-  std::string out;
-  out.reserve(bytes * 2);
-  const char *hex = "0123456789abcdef";
-  for (std::size_t i = 0; i < bytes; ++i) {
-    int v = dist(rng);
-    out.push_back(hex[(v >> 4) & 0xF]);
-    out.push_back(hex[v & 0xF]);
-  }
-  return out;
-}
+using Admission = detail::StreamBudget::Admission;
+using detail::utf8ChunkEnd;
 
-// Split UTF-8 string into chunks of at most max_bytes, not breaking codepoints.
-std::vector<std::string> splitUtf8(const std::string &s,
-                                   std::size_t max_bytes) {
-  std::vector<std::string> result;
-  if (s.empty())
-    return result;
-
-  std::size_t i = 0;
-  const std::size_t n = s.size();
-
-  while (i < n) {
-    std::size_t end = std::min(i + max_bytes, n);
-
-    // If end points into a UTF-8 continuation byte, walk back to a lead byte.
-    // NOTE: end is an index into the string; ensure end < n before indexing.
-    while (end > i && end < n &&
-           (static_cast<unsigned char>(s[end]) & 0xC0) == 0x80) {
-      --end;
-    }
-    // If end==n, we may still have landed on a continuation byte due to min().
-    while (end > i && end == n &&
-           (static_cast<unsigned char>(s[end - 1]) & 0xC0) == 0x80) {
-      // Walk back until we hit a lead byte boundary.
-      // This isn't perfect but is consistent with your earlier intent.
-      --end;
-      // If we backed up too far, fall through to fallback.
-    }
-
-    if (end == i) {
-      // Fallback: avoid infinite loop if bytes are pathological.
-      end = std::min(i + max_bytes, n);
-    }
-
-    result.emplace_back(s.substr(i, end - i));
-    i = end;
-  }
+namespace {
 
-  return result;
-}
+// Upper bound on the buffer pre-reserved from a stream's announced size.
+constexpr std::size_t kMaxReserveBytes = 64 * 1024 * 1024;
 
 void fillBaseInfo(BaseStreamInfo &dst, const std::string &stream_id,
                   const std::string &mime_type, const std::string &topic,
@@ -89,14 +46,87 @@ void fillBaseInfo(BaseStreamInfo &dst, const std::string &stream_id,
 
 TextStreamReader::TextStreamReader(const TextStreamInfo &info) : info_(info) {}
 
+TextStreamReader::~TextStreamReader() {
+  if (budget_) {
+    budget_->release(memory_bytes_.load());
+  }
+}
+
+void TextStreamReader::attachBudget(
+    std::shared_ptr<detail::StreamBudget> budget) {
+  budget_ = std::move(budget);
+}
+
 void TextStreamReader::onChunkUpdate(const std::string &text) {
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (closed_)
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (closed_)
+    return;
+  detail::SdkMetrics::instance().data_stream_bytes_received.add(text.size());
+  if (!spill_) {
+    Admission admission = Admission::kAdmit;
+    if (budget_) {
+      // May wait for the consumer, so it must not hold our mutex.
+      lock.unlock();
+      admission = budget_->admit(text.size(), memory_bytes_);
+      lock.lock();
+    }
+    if (closed_) {
+      if (budget_ && admission == Admission::kAdmit)
+        budget_->release(text.size());
+      return;
+    }
+    if (admission == Admission::kDrop ||
+        (admission == Admission::kSpill && !spillLocked())) {
+      dropLocked();
+      lock.unlock();
+      cv_.notify_all();
       return;
-    queue_.push_back(text);
+    }
+    if (admission == Admission::kAdmit) {
+      queue_.push_back(text);
+      memory_bytes_ += text.size();
+      lock.unlock();
+      cv_.notify_one();
+      return;
+    }
+  }
+  if (spill_->append(text.data(), text.size())) {
+    spilled_sizes_.push_back(text.size());
+  } else {
+    dropLocked();
+  }
+  lock.unlock();
+  cv_.notify_all();
+}
+
+bool TextStreamReader::spillLocked() {
+  try {
+    spill_ = std::make_unique<detail::SpillFile>(
+        budget_->options().spill_directory);
+  } catch (const std::exception &) {
+    return false;
+  }
+  for (const auto &chunk : queue_) {
+    if (!spill_->append(chunk.data(), chunk.size()))
+      return false;
+    spilled_sizes_.push_back(chunk.size());
+  }
+  queue_.clear();
+  budget_->release(memory_bytes_.exchange(0));
+  budget_->noteSpilled();
+  return true;
+}
+
+void TextStreamReader::dropLocked() {
+  dropped_ = true;
+  closed_ = true;
+  queue_.clear();
+  spill_.reset();
+  spilled_sizes_.clear();
+  if (budget_) {
+    budget_->release(memory_bytes_.exchange(0));
+    budget_->noteDropped();
   }
-  cv_.notify_one();
 }
 
 void TextStreamReader::onStreamClose(
@@ -113,11 +143,22 @@ void TextStreamReader::onStreamClose(
 
 bool TextStreamReader::readNext(std::string &out) {
   std::unique_lock<std::mutex> lock(mutex_);
-  cv_.wait(lock, [this] { return !queue_.empty() || closed_; });
+  cv_.wait(lock, [this] {
+    return !queue_.empty() || !spilled_sizes_.empty() || closed_;
+  });
 
   if (!queue_.empty()) {
     out = std::move(queue_.front());
     queue_.pop_front();
+    memory_bytes_ -= out.size();
+    if (budget_)
+      budget_->release(out.size());
+    return true;
+  }
+  if (!spilled_sizes_.empty()) {
+    out.resize(spilled_sizes_.front());
+    spilled_sizes_.pop_front();
+    out.resize(spill_->read(&out[0], out.size()));
     return true;
   }
   return false; // closed_ and empty
@@ -131,16 +172,127 @@ std::string TextStreamReader::readAll() {
   return result;
 }
 
-ByteStreamReader::ByteStreamReader(const ByteStreamInfo &info) : info_(info) {}
+bool TextStreamReader::dropped() const noexcept { return dropped_.load(); }
 
-void ByteStreamReader::onChunkUpdate(const std::vector<std::uint8_t> &bytes) {
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (closed_)
+ByteStreamReader::ByteStreamReader(const ByteStreamInfo &info) : info_(info) {
+  if (info_.size) {
+    // Trust the announced size only up to a point; a larger stream simply
+    // grows the buffer as chunks arrive.
+    buffer_.reserve(std::min(*info_.size, kMaxReserveBytes));
+  }
+}
+
+ByteStreamReader::~ByteStreamReader() {
+  if (budget_) {
+    budget_->release(memory_bytes_.load());
+  }
+}
+
+void ByteStreamReader::attachBudget(
+    std::shared_ptr<detail::StreamBudget> budget) {
+  budget_ = std::move(budget);
+}
+
+void ByteStreamReader::onChunkUpdate(const std::uint8_t *data,
+                                     std::size_t size) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (closed_)
+    return;
+  bytes_received_ += size;
+  detail::SdkMetrics::instance().data_stream_bytes_received.add(size);
+  if (sink_) {
+    if (!sink_failed_ && std::fwrite(data, 1, size, sink_.get()) != size) {
+      sink_failed_ = true;
+    }
+    return;
+  }
+  if (size == 0)
+    return;
+  if (!spill_) {
+    Admission admission = Admission::kAdmit;
+    if (budget_) {
+      // May wait for the consumer, so it must not hold our mutex.
+      lock.unlock();
+      admission = budget_->admit(size, memory_bytes_);
+      lock.lock();
+    }
+    if (closed_ || sink_) {
+      // Dropped, or a file sink was installed while we waited.
+      if (budget_ && admission == Admission::kAdmit)
+        budget_->release(size);
+      if (sink_ && !sink_failed_ &&
+          std::fwrite(data, 1, size, sink_.get()) != size) {
+        sink_failed_ = true;
+      }
+      return;
+    }
+    if (admission == Admission::kDrop ||
+        (admission == Admission::kSpill && !spillLocked())) {
+      dropLocked();
+      lock.unlock();
+      cv_.notify_all();
       return;
-    queue_.push_back(bytes);
+    }
+    if (admission == Admission::kAdmit) {
+      compactLocked();
+      buffer_.insert(buffer_.end(), data, data + size);
+      chunk_sizes_.push_back(size);
+      memory_bytes_ += size;
+      lock.unlock();
+      cv_.notify_one();
+      return;
+    }
+  }
+  if (spill_->append(data, size)) {
+    chunk_sizes_.push_back(size);
+  } else {
+    dropLocked();
+  }
+  lock.unlock();
+  cv_.notify_all();
+}
+
+bool ByteStreamReader::spillLocked() {
+  try {
+    spill_ = std::make_unique<detail::SpillFile>(
+        budget_->options().spill_directory);
+  } catch (const std::exception &) {
+    return false;
+  }
+  // chunk_sizes_ stays valid: the file continues exactly where the
+  // in-memory bytes left off.
+  const std::size_t pending = buffer_.size() - read_offset_;
+  if (pending > 0 && !spill_->append(buffer_.data() + read_offset_, pending))
+    return false;
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  read_offset_ = 0;
+  budget_->release(memory_bytes_.exchange(0));
+  budget_->noteSpilled();
+  return true;
+}
+
+void ByteStreamReader::dropLocked() {
+  dropped_ = true;
+  closed_ = true;
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  read_offset_ = 0;
+  chunk_sizes_.clear();
+  spill_.reset();
+  if (budget_) {
+    budget_->release(memory_bytes_.exchange(0));
+    budget_->noteDropped();
   }
-  cv_.notify_one();
+}
+
+void ByteStreamReader::consumedLocked(std::size_t n) {
+  if (spill_)
+    return;
+  read_offset_ += n;
+  memory_bytes_ -= n;
+  if (budget_)
+    budget_->release(n);
 }
 
 void ByteStreamReader::onStreamClose(
@@ -151,22 +303,146 @@ void ByteStreamReader::onStreamClose(
       info_.attributes[kv.first] = kv.second;
     }
     closed_ = true;
+    if (sink_ && std::fclose(sink_.release()) != 0) {
+      sink_failed_ = true;
+    }
   }
   cv_.notify_all();
 }
 
+void ByteStreamReader::compactLocked() {
+  if (read_offset_ == buffer_.size()) {
+    buffer_.clear();
+    read_offset_ = 0;
+  } else if (read_offset_ > kStreamChunkSize * 4 &&
+             read_offset_ > buffer_.size() / 2) {
+    buffer_.erase(buffer_.begin(),
+                  buffer_.begin() + static_cast<std::ptrdiff_t>(read_offset_));
+    read_offset_ = 0;
+  }
+}
+
 bool ByteStreamReader::readNext(std::vector<std::uint8_t> &out) {
   std::unique_lock<std::mutex> lock(mutex_);
-  cv_.wait(lock, [this] { return !queue_.empty() || closed_; });
-
-  if (!queue_.empty()) {
-    out = std::move(queue_.front());
-    queue_.pop_front();
+  cv_.wait(lock, [this] { return !chunk_sizes_.empty() || closed_; });
+
+  if (!chunk_sizes_.empty()) {
+    const std::size_t n = chunk_sizes_.front();
+    chunk_sizes_.pop_front();
+    if (spill_) {
+      out.resize(n);
+      out.resize(spill_->read(out.data(), n));
+    } else {
+      const std::uint8_t *first = buffer_.data() + read_offset_;
+      out.assign(first, first + n);
+    }
+    consumedLocked(n);
     return true;
   }
   return false;
 }
 
+std::size_t ByteStreamReader::readInto(std::uint8_t *dest,
+                                       std::size_t capacity) {
+  if (capacity > 0 && dest == nullptr)
+    throw std::invalid_argument("ByteStreamReader::readInto: null dest");
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return !chunk_sizes_.empty() || closed_; });
+
+  std::size_t copied = 0;
+  while (copied < capacity && !chunk_sizes_.empty()) {
+    std::size_t &front = chunk_sizes_.front();
+    std::size_t n = std::min(front, capacity - copied);
+    if (spill_) {
+      n = spill_->read(dest + copied, n);
+      if (n == 0) {
+        break; // I/O error; report what we have.
+      }
+    } else {
+      std::memcpy(dest + copied, buffer_.data() + read_offset_, n);
+    }
+    consumedLocked(n);
+    copied += n;
+    front -= n;
+    if (front == 0)
+      chunk_sizes_.pop_front();
+  }
+  return copied;
+}
+
+std::vector<std::uint8_t> ByteStreamReader::readAll() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return closed_; });
+
+  std::vector<std::uint8_t> out;
+  if (spill_) {
+    out.resize(static_cast<std::size_t>(spill_->pending()));
+    out.resize(spill_->read(out.data(), out.size()));
+    spill_.reset();
+  } else if (read_offset_ == 0) {
+    out.swap(buffer_);
+  } else {
+    out.assign(buffer_.begin() + static_cast<std::ptrdiff_t>(read_offset_),
+               buffer_.end());
+    buffer_.clear();
+  }
+  read_offset_ = 0;
+  chunk_sizes_.clear();
+  if (budget_)
+    budget_->release(memory_bytes_.exchange(0));
+  return out;
+}
+
+void ByteStreamReader::setFileSink(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (sink_)
+    throw std::runtime_error("ByteStreamReader: file sink already set");
+  std::unique_ptr<std::FILE, int (*)(std::FILE *)> file(
+      std::fopen(path.c_str(), "wb"), &std::fclose);
+  if (!file)
+    throw std::runtime_error("ByteStreamReader: cannot open " + path);
+
+  const std::size_t pending = buffer_.size() - read_offset_;
+  if (pending > 0 && std::fwrite(buffer_.data() + read_offset_, 1, pending,
+                                 file.get()) != pending) {
+    sink_failed_ = true;
+  }
+  if (spill_) {
+    std::uint8_t block[64 * 1024];
+    while (std::size_t n = spill_->read(block, sizeof(block))) {
+      if (std::fwrite(block, 1, n, file.get()) != n) {
+        sink_failed_ = true;
+        break;
+      }
+    }
+    spill_.reset();
+  }
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  read_offset_ = 0;
+  chunk_sizes_.clear();
+  if (budget_)
+    budget_->release(memory_bytes_.exchange(0));
+
+  if (closed_) {
+    if (std::fclose(file.release()) != 0)
+      sink_failed_ = true;
+  } else {
+    sink_ = std::move(file);
+  }
+  cv_.notify_all();
+}
+
+std::uint64_t ByteStreamReader::waitForClose() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return closed_; });
+  if (sink_failed_)
+    throw std::runtime_error("ByteStreamReader: writing file sink failed");
+  return bytes_received_;
+}
+
+bool ByteStreamReader::dropped() const noexcept { return dropped_.load(); }
+
 // =====================================================================
 // Writer implementation (uses your future-based FfiClient)
 // =====================================================================
@@ -225,21 +501,52 @@ void BaseStreamWriter::ensureHeaderSent() {
   header_sent_ = true;
 }
 
-void BaseStreamWriter::sendChunk(const std::vector<std::uint8_t> &content) {
+void BaseStreamWriter::sendChunk(const std::uint8_t *data, std::size_t size) {
   if (closed_)
     throw std::runtime_error("Cannot send chunk after stream is closed");
 
   ensureHeaderSent();
+  // Make room in the window (and surface any earlier failure).
+  drainInFlight(max_in_flight_ - 1);
 
-  proto::DataStream::Chunk chunk;
-  chunk.set_stream_id(stream_id_);
-  chunk.set_chunk_index(next_chunk_index_++); // ✅ uses the new member
-  chunk.set_content(content.data(), content.size());
+  in_flight_.push_back(local_participant_.sendStreamChunk(
+      stream_id_, next_chunk_index_++, data, size, destination_identities_,
+      sender_identity_, priority_));
+  detail::SdkMetrics::instance().data_stream_bytes_sent.add(size);
+}
 
-  FfiClient::instance()
-      .sendStreamChunkAsync(local_participant_.ffiHandleId(), chunk,
-                            destination_identities_, sender_identity_)
-      .get();
+void BaseStreamWriter::drainInFlight(std::size_t keep) {
+  while (!in_flight_.empty()) {
+    auto &front = in_flight_.front();
+    if (in_flight_.size() <= keep) {
+      if (front.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+        break;
+      }
+    }
+    try {
+      front.get();
+    } catch (...) {
+      if (!chunk_error_) {
+        chunk_error_ = std::current_exception();
+      }
+    }
+    in_flight_.pop_front();
+  }
+  if (chunk_error_) {
+    std::rethrow_exception(chunk_error_);
+  }
+}
+
+void BaseStreamWriter::setMaxInFlightChunks(std::size_t max_in_flight) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  max_in_flight_ = max_in_flight == 0 ? 1 : max_in_flight;
+}
+
+void BaseStreamWriter::flush() {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  flushPending();
+  drainInFlight(0);
 }
 
 void BaseStreamWriter::sendTrailer(
@@ -264,9 +571,29 @@ void BaseStreamWriter::sendTrailer(
 void BaseStreamWriter::close(
     const std::string &reason,
     const std::map<std::string, std::string> &attributes) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
   if (closed_)
     throw std::runtime_error("Stream already closed");
-  closed_ = true;
+  try {
+    flushPending();
+    closed_ = true;
+    // Only the tail of the window is left to wait for here.
+    drainInFlight(0);
+  } catch (const std::exception &e) {
+    closed_ = true;
+    // Still end the stream, so the receiver is not left waiting for chunks
+    // that will never come; the reason tells it why the data is short.
+    const std::string error = std::string("chunk send failed: ") + e.what();
+    try {
+      sendTrailer(reason.empty() ? error : reason + " (" + error + ")",
+                  attributes);
+    } catch (const std::exception &trailer_error) {
+      LK_LOG_WARN("livekit::data_stream",
+                  "stream %s: trailer after failed chunk not sent: %s",
+                  stream_id_.c_str(), trailer_error.what());
+    }
+    throw;
+  }
   sendTrailer(reason, attributes);
 }
 
@@ -287,16 +614,124 @@ TextStreamWriter::TextStreamWriter(
                total_size_, attributes_);
 }
 
+TextStreamWriter::~TextStreamWriter() {
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    stop_coalescing_ = true;
+  }
+  coalesce_cv_.notify_all();
+  if (coalesce_thread_.joinable()) {
+    coalesce_thread_.join();
+  }
+  // Best effort: send text still held back so it is not silently lost.
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  if (closed_ || pending_.empty() || coalesce_error_)
+    return;
+  try {
+    sendPendingLocked();
+  } catch (const std::exception &e) {
+    LK_LOG_WARN("livekit::data_stream",
+                "stream %s: sending held-back text on destruction failed: %s",
+                stream_id_.c_str(), e.what());
+  }
+}
+
 void TextStreamWriter::write(const std::string &text) {
   std::lock_guard<std::mutex> lock(write_mutex_);
   if (closed_)
     throw std::runtime_error("Cannot write to closed TextStreamWriter");
+  if (coalesce_error_)
+    std::rethrow_exception(coalesce_error_);
+
+  if (coalesce_delay_.count() > 0) {
+    if (pending_.empty()) {
+      deadline_ = std::chrono::steady_clock::now() + coalesce_delay_;
+      coalesce_cv_.notify_one();
+    }
+    pending_ += text;
+    // Send whole frames as soon as they are full; keep the remainder.
+    std::size_t begin = 0;
+    while (pending_.size() - begin >= coalesce_bytes_) {
+      const std::size_t end =
+          utf8ChunkEnd(pending_.data(), begin, pending_.size(),
+                       coalesce_bytes_);
+      sendChunk(reinterpret_cast<const std::uint8_t *>(pending_.data()) +
+                    begin,
+                end - begin);
+      begin = end;
+    }
+    pending_.erase(0, begin);
+    return;
+  }
+
+  // Each chunk is a view into `text`, copied once into the request.
+  const char *data = text.data();
+  const auto *bytes = reinterpret_cast<const std::uint8_t *>(data);
+  std::size_t begin = 0;
+  while (begin < text.size()) {
+    const std::size_t end =
+        utf8ChunkEnd(data, begin, text.size(), kStreamChunkSize);
+    sendChunk(bytes + begin, end - begin);
+    begin = end;
+  }
+}
+
+void TextStreamWriter::setCoalescing(std::chrono::milliseconds max_delay,
+                                     std::size_t max_bytes) {
+  std::unique_lock<std::mutex> lock(write_mutex_);
+  coalesce_bytes_ = std::min(std::max<std::size_t>(max_bytes, 1),
+                             kStreamChunkSize);
+  coalesce_delay_ = std::max(max_delay, std::chrono::milliseconds(0));
+  if (coalesce_delay_.count() == 0) {
+    if (!closed_)
+      sendPendingLocked();
+    return;
+  }
+  if (!coalesce_thread_.joinable()) {
+    coalesce_thread_ = std::thread([this] {
+      detail::registerThread(ThreadRole::kBackground, "lk-data-stream");
+      coalesceLoop();
+    });
+  }
+  coalesce_cv_.notify_one();
+}
 
-  for (const auto &chunk_str : splitUtf8(text, kStreamChunkSize)) {
-    const auto *p = reinterpret_cast<const std::uint8_t *>(chunk_str.data());
-    std::vector<std::uint8_t> bytes(p, p + chunk_str.size());
-    std::cout << "sending chunk " << std::endl;
-    sendChunk(bytes);
+void TextStreamWriter::flushPending() {
+  if (coalesce_error_)
+    std::rethrow_exception(coalesce_error_);
+  sendPendingLocked();
+}
+
+void TextStreamWriter::sendPendingLocked() {
+  const auto *bytes = reinterpret_cast<const std::uint8_t *>(pending_.data());
+  std::size_t begin = 0;
+  while (begin < pending_.size()) {
+    const std::size_t end =
+        utf8ChunkEnd(pending_.data(), begin, pending_.size(), kStreamChunkSize);
+    sendChunk(bytes + begin, end - begin);
+    begin = end;
+  }
+  pending_.clear();
+}
+
+void TextStreamWriter::coalesceLoop() {
+  std::unique_lock<std::mutex> lock(write_mutex_);
+  while (!stop_coalescing_) {
+    if (pending_.empty() || closed_) {
+      coalesce_cv_.wait(lock);
+      continue;
+    }
+    if (std::chrono::steady_clock::now() < deadline_) {
+      coalesce_cv_.wait_until(lock, deadline_);
+      continue;
+    }
+    try {
+      sendPendingLocked();
+    } catch (...) {
+      pending_.clear();
+      if (!coalesce_error_)
+        coalesce_error_ = std::current_exception();
+    }
   }
 }
 
@@ -312,6 +747,7 @@ ByteStreamWriter::ByteStreamWriter(
                        total_size, mime_type, destination_identities,
                        sender_identity) {
   kind_ = StreamKind::kByte;
+  priority_ = DataPriority::kBulk;
   byte_name_ = name;
   fillBaseInfo(info_, stream_id_, mime_type_, topic_, timestamp_ms_,
                total_size_, attributes_);
@@ -319,17 +755,22 @@ ByteStreamWriter::ByteStreamWriter(
 }
 
 void ByteStreamWriter::write(const std::vector<std::uint8_t> &data) {
+  write(data.data(), data.size());
+}
+
+void ByteStreamWriter::write(const std::uint8_t *data, std::size_t size) {
   std::lock_guard<std::mutex> lock(write_mutex_);
   if (closed_)
     throw std::runtime_error("Cannot write to closed ByteStreamWriter");
+  if (size > 0 && data == nullptr)
+    throw std::invalid_argument("ByteStreamWriter::write: null data");
 
+  // Each chunk is a slice of the caller's buffer; no intermediate copies.
   std::size_t offset = 0;
-  while (offset < data.size()) {
+  while (offset < size) {
     const std::size_t n =
-        std::min<std::size_t>(kStreamChunkSize, data.size() - offset);
-    std::vector<std::uint8_t> chunk(data.begin() + offset,
-                                    data.begin() + offset + n);
-    sendChunk(chunk);
+        std::min<std::size_t>(kStreamChunkSize, size - offset);
+    sendChunk(data + offset, n);
     offset += n;
   }
 }
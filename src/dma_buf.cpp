@@ -0,0 +1,111 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dma_buf.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/dma-buf.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace livekit {
+namespace detail {
+
+#if defined(__linux__)
+
+namespace {
+
+[[noreturn]] void fail(NativeVideoBuffer &buffer, const char *what) {
+  const std::string reason = std::strerror(errno);
+  if (buffer.release) {
+    buffer.release();
+  }
+  throw std::runtime_error(std::string("mapDmaBuf: ") + what + ": " + reason);
+}
+
+void syncDmaBuf(int fd, std::uint64_t flags) noexcept {
+  dma_buf_sync sync{};
+  sync.flags = flags | DMA_BUF_SYNC_READ;
+  // Retry on signals; other errors only cost coherency on exotic exporters.
+  while (ioctl(fd, DMA_BUF_IOCTL_SYNC, &sync) == -1 && errno == EINTR) {
+  }
+}
+
+} // namespace
+
+VideoFrame mapDmaBuf(NativeVideoBuffer &&buffer) {
+  const int fd = static_cast<int>(buffer.handle);
+  std::size_t size = buffer.size;
+  if (size == 0) {
+    const off_t end = lseek(fd, 0, SEEK_END);
+    if (end <= 0) {
+      fail(buffer, "cannot size dma-buf");
+    }
+    size = static_cast<std::size_t>(end);
+  }
+
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    fail(buffer, "mmap failed");
+  }
+  syncDmaBuf(fd, DMA_BUF_SYNC_START);
+
+  const auto base = reinterpret_cast<std::uintptr_t>(addr);
+  std::vector<VideoPlaneInfo> planes;
+  planes.reserve(buffer.planes.size());
+  for (const auto &plane : buffer.planes) {
+    const std::uint64_t offset = plane.offset < size ? plane.offset : size;
+    const std::uint64_t available =
+        std::min<std::uint64_t>(size - offset, UINT32_MAX);
+    planes.push_back({base + static_cast<std::uintptr_t>(offset), plane.stride,
+                      static_cast<std::uint32_t>(available)});
+  }
+
+  // wrapExternal() runs the release even when it rejects the planes.
+  return VideoFrame::wrapExternal(
+      buffer.width, buffer.height, buffer.layout, std::move(planes),
+      [fd, addr, size, release = std::move(buffer.release)] {
+        syncDmaBuf(fd, DMA_BUF_SYNC_END);
+        munmap(addr, size);
+        if (release) {
+          release();
+        }
+      });
+}
+
+#else
+
+VideoFrame mapDmaBuf(NativeVideoBuffer &&buffer) {
+  if (buffer.release) {
+    buffer.release();
+  }
+  throw std::runtime_error("mapDmaBuf: DMA-BUF is only available on Linux");
+}
+
+#endif
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/native_video_buffer.h"
+
+namespace livekit {
+namespace detail {
+
+// Default NativeBufferMapper for NativeBufferKind::kDmaBuf: mmaps the fd
+// read-only, brackets CPU access with DMA_BUF_IOCTL_SYNC and wraps the
+// planes in place with VideoFrame::wrapExternal(). The frame's release
+// ends the sync, unmaps, then calls buffer.release.
+//
+// Throws std::runtime_error if mapping fails or on platforms without
+// DMA-BUF; buffer.release has run by then. The mapping is read-only.
+VideoFrame mapDmaBuf(NativeVideoBuffer &&buffer);
+
+} // namespace detail
+} // namespace livekit
@@ -16,16 +16,48 @@
 
 #include "livekit/e2ee.h"
 
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 
 #include "e2ee.pb.h"
+#include "e2ee_internal.h"
 #include "ffi.pb.h"
+#include "ffi_arena.h"
 #include "ffi_client.h"
 #include "livekit/ffi_handle.h"
+#include "livekit/room_event_types.h"
+#include "thread_util.h"
 
 namespace livekit {
 
+namespace detail {
+
+// State of E2EEManager's key rotation scheduler; the worker thread only
+// runs between startKeyRotation() and stopKeyRotation().
+struct KeyRotation {
+  using Clock = std::chrono::steady_clock;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  KeyRotationOptions options;
+  KeyRotationStats stats;
+  bool running = false;
+  bool stopping = false;
+  bool rotate_requested = false;
+  bool activate_requested = false;
+  Clock::time_point next_rotation;
+  std::int64_t next_epoch = 0; // epoch that starts at next_rotation
+  Clock::time_point activate_at;
+  std::thread worker;
+};
+
+} // namespace detail
+
 namespace {
 
 std::string bytesToString(const std::vector<std::uint8_t> &v) {
@@ -36,6 +68,113 @@ std::vector<std::uint8_t> stringToBytes(const std::string &s) {
   return std::vector<std::uint8_t>(s.begin(), s.end());
 }
 
+template <typename Fn> bool runLogged(const char *what, Fn &&fn) {
+  try {
+    fn();
+    return true;
+  } catch (const std::exception &e) {
+    std::cerr << "E2EE key rotation: " << what << " failed: " << e.what()
+              << std::endl;
+    return false;
+  }
+}
+
+// Periodic rotations start at multiples of `interval` on the wall clock,
+// not at a per-process offset, so participants agree on when and into
+// which slot they rotate. Sets next_rotation (as a steady deadline) and
+// next_epoch to the upcoming boundary.
+void scheduleNextEpoch(detail::KeyRotation &r) {
+  using namespace std::chrono;
+  const auto interval = r.options.interval;
+  const auto wall = duration_cast<milliseconds>(
+      system_clock::now().time_since_epoch());
+  r.next_epoch = wall / interval + 1;
+  r.next_rotation =
+      detail::KeyRotation::Clock::now() + (interval * r.next_epoch - wall);
+}
+
+void installKey(E2EEManager::KeyProvider &keys,
+                const KeyRotationOptions &options, int active, int slot,
+                std::optional<std::int64_t> epoch) {
+  if (epoch && options.epoch_key) {
+    keys.setSharedKey(options.epoch_key(*epoch), slot);
+    return;
+  }
+  if (options.next_key) {
+    keys.setSharedKey(options.next_key(slot), slot);
+    return;
+  }
+  keys.setSharedKey(keys.exportSharedKey(active), slot);
+  (void)keys.ratchetSharedKey(slot);
+}
+
+// Install the next key, wait activation_delay (or activatePendingKey()),
+// switch every cryptor to it; repeat at every epoch boundary (see
+// scheduleNextEpoch()) or on rotateKeyNow().
+void runKeyRotation(E2EEManager &manager, detail::KeyRotation &r) {
+  using Clock = detail::KeyRotation::Clock;
+  std::unique_lock<std::mutex> lock(r.mutex);
+  while (!r.stopping) {
+    const auto now = Clock::now();
+    const bool periodic = r.options.interval.count() > 0;
+    if (r.stats.pending_key_index) {
+      if (!r.activate_requested && now < r.activate_at) {
+        r.cv.wait_until(lock, r.activate_at);
+        continue;
+      }
+      r.activate_requested = false;
+      const int slot = *r.stats.pending_key_index;
+      lock.unlock();
+      const bool ok =
+          runLogged("activation", [&] { manager.setAllKeyIndex(slot); });
+      lock.lock();
+      r.stats.pending_key_index.reset();
+      if (ok) {
+        r.stats.active_key_index = slot;
+        ++r.stats.rotations;
+        r.stats.failures_since_rotation = 0;
+      } else {
+        ++r.stats.errors;
+      }
+      continue;
+    }
+
+    if (!r.rotate_requested && !(periodic && now >= r.next_rotation)) {
+      if (periodic) {
+        r.cv.wait_until(lock, r.next_rotation);
+      } else {
+        r.cv.wait(lock);
+      }
+      continue;
+    }
+    // An epoch boundary takes the epoch's slot; rotateKeyNow() the next one
+    // (see nextRotationSlot()).
+    // The epoch is taken from the clock, not next_epoch, in case this
+    // boundary was reached late (e.g. behind a long activation_delay).
+    std::optional<std::int64_t> epoch;
+    if (periodic && now >= r.next_rotation) {
+      scheduleNextEpoch(r);
+      epoch = r.next_epoch - 1;
+    }
+    r.rotate_requested = false;
+    const int active = r.stats.active_key_index;
+    const int slot =
+        detail::nextRotationSlot(epoch, active, r.options.key_slots);
+    const KeyRotationOptions options = r.options;
+    lock.unlock();
+    const bool ok = runLogged("key install", [&] {
+      installKey(*manager.keyProvider(), options, active, slot, epoch);
+    });
+    lock.lock();
+    if (ok) {
+      r.stats.pending_key_index = slot;
+      r.activate_at = Clock::now() + options.activation_delay;
+    } else {
+      ++r.stats.errors;
+    }
+  }
+}
+
 } // namespace
 
 // ============================================================================
@@ -114,6 +253,34 @@ E2EEManager::KeyProvider::ratchetKey(const std::string &participant_identity,
   return stringToBytes(resp.e2ee().ratchet_key().new_key());
 }
 
+void E2EEManager::KeyProvider::setKeys(
+    const std::unordered_map<std::string, std::vector<std::uint8_t>> &keys,
+    int key_index) {
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
+  detail::sendSetKeyRequests(
+      req, room_handle_, keys, key_index,
+      [&](const std::string &, const proto::FfiRequest &r) {
+        (void)FfiClient::instance().sendRequest(r, arena);
+      });
+}
+
+std::unordered_map<std::string, std::vector<std::uint8_t>>
+E2EEManager::KeyProvider::ratchetKeys(
+    const std::vector<std::string> &participant_identities, int key_index) {
+  std::unordered_map<std::string, std::vector<std::uint8_t>> out;
+  out.reserve(participant_identities.size());
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
+  detail::sendRatchetKeyRequests(
+      req, room_handle_, participant_identities, key_index,
+      [&](const std::string &identity, const proto::FfiRequest &r) {
+        const auto &resp = FfiClient::instance().sendRequest(r, arena);
+        out[identity] = stringToBytes(resp.e2ee().ratchet_key().new_key());
+      });
+  return out;
+}
+
 // ============================================================================
 // FrameCryptor
 // ============================================================================
@@ -138,6 +305,11 @@ void E2EEManager::FrameCryptor::setEnabled(bool enabled) {
       participant_identity_);
   req.mutable_e2ee()->mutable_cryptor_set_enabled()->set_enabled(enabled);
   FfiClient::instance().sendRequest(req);
+  enabled_ = enabled;
+  if (cache_) {
+    cache_->update(participant_identity_,
+                   [enabled](auto &entry) { entry.enabled = enabled; });
+  }
 }
 
 void E2EEManager::FrameCryptor::setKeyIndex(int key_index) {
@@ -147,6 +319,11 @@ void E2EEManager::FrameCryptor::setKeyIndex(int key_index) {
       participant_identity_);
   req.mutable_e2ee()->mutable_cryptor_set_key_index()->set_key_index(key_index);
   FfiClient::instance().sendRequest(req);
+  key_index_ = key_index;
+  if (cache_) {
+    cache_->update(participant_identity_,
+                   [key_index](auto &entry) { entry.key_index = key_index; });
+  }
 }
 
 // ============================================================================
@@ -157,7 +334,11 @@ E2EEManager::E2EEManager(std::uint64_t room_handle, const E2EEOptions &options)
     : room_handle_(room_handle),
       enabled_(true), // or false, depending on your desired default behavior
       options_(options),
-      key_provider_(room_handle, options.key_provider_options) {}
+      key_provider_(room_handle, options.key_provider_options),
+      cryptors_(std::make_shared<detail::FrameCryptorCache>()),
+      rotation_(std::make_unique<detail::KeyRotation>()) {}
+
+E2EEManager::~E2EEManager() { stopKeyRotation(); }
 
 bool E2EEManager::enabled() const { return enabled_; }
 
@@ -174,17 +355,172 @@ const E2EEManager::KeyProvider *E2EEManager::keyProvider() const {
 }
 
 std::vector<E2EEManager::FrameCryptor> E2EEManager::frameCryptors() const {
-  proto::FfiRequest req;
-  req.mutable_e2ee()->set_room_handle(room_handle_);
-  auto resp = FfiClient::instance().sendRequest(req);
+  std::vector<detail::FrameCryptorCache::Entry> entries;
+  std::uint64_t generation = 0;
+  if (!cryptors_->load(entries, generation)) {
+    FfiArenaScope arena;
+    auto &req = *arena.create<proto::FfiRequest>();
+    req.mutable_e2ee()->set_room_handle(room_handle_);
+    req.mutable_e2ee()->mutable_manager_get_frame_cryptors();
+    const auto &resp = FfiClient::instance().sendRequest(req, arena);
+    const auto &list =
+        resp.e2ee().manager_get_frame_cryptors().frame_cryptors();
+    entries.reserve(static_cast<std::size_t>(list.size()));
+    for (const auto &fc : list) {
+      entries.push_back({fc.participant_identity(), fc.key_index(),
+                         fc.enabled()});
+    }
+    cryptors_->store(entries, generation);
+  }
+
   std::vector<E2EEManager::FrameCryptor> out;
-  const auto &list = resp.e2ee().manager_get_frame_cryptors().frame_cryptors();
-  out.reserve(static_cast<std::size_t>(list.size()));
-  for (const auto &fc : list) {
-    out.emplace_back(room_handle_, fc.participant_identity(), fc.key_index(),
-                     fc.enabled());
+  out.reserve(entries.size());
+  for (auto &entry : entries) {
+    out.emplace_back(room_handle_, std::move(entry.identity), entry.key_index,
+                     entry.enabled);
+    out.back().cache_ = cryptors_;
   }
   return out;
 }
 
+namespace {
+
+std::vector<std::string>
+identitiesOf(const std::vector<E2EEManager::FrameCryptor> &cryptors) {
+  std::vector<std::string> identities;
+  identities.reserve(cryptors.size());
+  for (const auto &cryptor : cryptors) {
+    identities.push_back(cryptor.participantIdentity());
+  }
+  return identities;
+}
+
+} // namespace
+
+void E2EEManager::setAllEnabled(bool enabled) {
+  const auto identities = identitiesOf(frameCryptors());
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
+  detail::sendCryptorSetEnabledRequests(
+      req, room_handle_, identities, enabled,
+      [&](const std::string &, const proto::FfiRequest &r) {
+        (void)FfiClient::instance().sendRequest(r, arena);
+      });
+  cryptors_->updateAll([enabled](auto &entry) { entry.enabled = enabled; });
+}
+
+void E2EEManager::setAllKeyIndex(int key_index) {
+  const auto identities = identitiesOf(frameCryptors());
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
+  detail::sendCryptorSetKeyIndexRequests(
+      req, room_handle_, identities, key_index,
+      [&](const std::string &, const proto::FfiRequest &r) {
+        (void)FfiClient::instance().sendRequest(r, arena);
+      });
+  cryptors_->updateAll(
+      [key_index](auto &entry) { entry.key_index = key_index; });
+}
+
+std::unordered_map<std::string, std::vector<std::uint8_t>>
+E2EEManager::ratchetAll(int key_index) {
+  return key_provider_.ratchetKeys(identitiesOf(frameCryptors()), key_index);
+}
+
+void E2EEManager::invalidateFrameCryptors() { cryptors_->invalidate(); }
+
+void E2EEManager::startKeyRotation(const KeyRotationOptions &options) {
+  if (options.key_slots < 2 || options.key_slots > kKeyRingSize) {
+    throw std::invalid_argument(
+        "E2EEManager::startKeyRotation: key_slots must be 2..16");
+  }
+  auto &r = *rotation_;
+  std::lock_guard<std::mutex> g(r.mutex);
+  if (r.running) {
+    throw std::runtime_error(
+        "E2EEManager::startKeyRotation: already running");
+  }
+  r.options = options;
+  r.running = true;
+  r.stopping = false;
+  r.rotate_requested = false;
+  r.activate_requested = false;
+  r.stats.active_key_index %= options.key_slots;
+  if (options.interval.count() > 0) {
+    scheduleNextEpoch(r);
+  }
+  r.worker = std::thread([this] {
+    detail::registerThread(ThreadRole::kBackground, "lk-e2ee-keys");
+    runKeyRotation(*this, *rotation_);
+  });
+}
+
+void E2EEManager::stopKeyRotation() {
+  auto &r = *rotation_;
+  std::thread worker;
+  {
+    std::lock_guard<std::mutex> g(r.mutex);
+    if (!r.running) {
+      return;
+    }
+    r.stopping = true;
+    worker = std::move(r.worker);
+  }
+  r.cv.notify_all();
+  if (worker.joinable()) {
+    worker.join();
+  }
+  std::lock_guard<std::mutex> g(r.mutex);
+  r.running = false;
+  r.stats.pending_key_index.reset();
+}
+
+void E2EEManager::rotateKeyNow() {
+  auto &r = *rotation_;
+  {
+    std::lock_guard<std::mutex> g(r.mutex);
+    if (!r.running) {
+      throw std::runtime_error(
+          "E2EEManager::rotateKeyNow: key rotation is not running");
+    }
+    if (r.stats.pending_key_index) {
+      return;
+    }
+    r.rotate_requested = true;
+  }
+  r.cv.notify_all();
+}
+
+void E2EEManager::activatePendingKey() {
+  auto &r = *rotation_;
+  {
+    std::lock_guard<std::mutex> g(r.mutex);
+    if (!r.stats.pending_key_index) {
+      return;
+    }
+    r.activate_requested = true;
+  }
+  r.cv.notify_all();
+}
+
+KeyRotationStats E2EEManager::keyRotationStats() const {
+  std::lock_guard<std::mutex> g(rotation_->mutex);
+  return rotation_->stats;
+}
+
+void E2EEManager::recordEncryptionState(EncryptionState state) {
+  if (state != EncryptionState::DecryptionFailed &&
+      state != EncryptionState::MissingKey) {
+    return;
+  }
+  std::lock_guard<std::mutex> g(rotation_->mutex);
+  auto &stats = rotation_->stats;
+  if (state == EncryptionState::DecryptionFailed) {
+    ++stats.decryption_failures;
+  } else {
+    ++stats.missing_key;
+  }
+  ++stats.failures_since_rotation;
+}
+
 } // namespace livekit
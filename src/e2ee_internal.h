@@ -0,0 +1,181 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "e2ee.pb.h"
+#include "ffi.pb.h"
+#include "room.pb.h"
+
+namespace livekit {
+namespace detail {
+
+// E2EEManager::frameCryptors() as of the last fetch. Room invalidates it on
+// events that add or remove cryptors; the setters update it in place.
+struct FrameCryptorCache {
+  struct Entry {
+    std::string identity;
+    int key_index = 0;
+    bool enabled = false;
+  };
+
+  std::mutex mutex;
+  std::vector<Entry> entries;
+  bool valid = false;
+  // Bumped by invalidate(), so a fetch that raced with it is not stored.
+  std::uint64_t generation = 0;
+
+  void invalidate() {
+    std::lock_guard<std::mutex> g(mutex);
+    valid = false;
+    ++generation;
+  }
+
+  // Copies the entries into `out` if they are valid; either way `fetch`
+  // receives the generation to hand back to store().
+  bool load(std::vector<Entry> &out, std::uint64_t &fetch) {
+    std::lock_guard<std::mutex> g(mutex);
+    if (valid) {
+      out = entries;
+    }
+    fetch = generation;
+    return valid;
+  }
+
+  // Keeps a fresh fetch unless invalidate() ran since its load().
+  void store(const std::vector<Entry> &fetched, std::uint64_t fetch) {
+    std::lock_guard<std::mutex> g(mutex);
+    if (generation == fetch) {
+      entries = fetched;
+      valid = true;
+    }
+  }
+
+  template <typename Fn> void update(const std::string &identity, Fn &&fn) {
+    std::lock_guard<std::mutex> g(mutex);
+    for (auto &entry : entries) {
+      if (entry.identity == identity) {
+        fn(entry);
+      }
+    }
+  }
+
+  template <typename Fn> void updateAll(Fn &&fn) {
+    std::lock_guard<std::mutex> g(mutex);
+    for (auto &entry : entries) {
+      fn(entry);
+    }
+  }
+};
+
+// Room events after which E2EEManager::frameCryptors() must be refetched.
+inline bool changesFrameCryptors(proto::RoomEvent::MessageCase kind) {
+  switch (kind) {
+  case proto::RoomEvent::kParticipantConnected:
+  case proto::RoomEvent::kParticipantDisconnected:
+  case proto::RoomEvent::kLocalTrackPublished:
+  case proto::RoomEvent::kLocalTrackUnpublished:
+  case proto::RoomEvent::kTrackSubscribed:
+  case proto::RoomEvent::kTrackUnsubscribed:
+  case proto::RoomEvent::kE2EeStateChanged:
+  case proto::RoomEvent::kReconnected:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// The bulk E2EE operations issue one request per participant. Each fills
+// `req` once for the room and only swaps the per-participant fields before
+// every send(identity, req).
+template <typename Send>
+void sendSetKeyRequests(
+    proto::FfiRequest &req, std::uint64_t room_handle,
+    const std::unordered_map<std::string, std::vector<std::uint8_t>> &keys,
+    int key_index, Send &&send) {
+  req.mutable_e2ee()->set_room_handle(room_handle);
+  auto *msg = req.mutable_e2ee()->mutable_set_key();
+  msg->set_key_index(key_index);
+  for (const auto &entry : keys) {
+    msg->set_participant_identity(entry.first);
+    msg->set_key(reinterpret_cast<const char *>(entry.second.data()),
+                 entry.second.size());
+    send(entry.first, req);
+  }
+}
+
+template <typename Send>
+void sendRatchetKeyRequests(proto::FfiRequest &req, std::uint64_t room_handle,
+                            const std::vector<std::string> &identities,
+                            int key_index, Send &&send) {
+  req.mutable_e2ee()->set_room_handle(room_handle);
+  auto *msg = req.mutable_e2ee()->mutable_ratchet_key();
+  msg->set_key_index(key_index);
+  for (const auto &identity : identities) {
+    msg->set_participant_identity(identity);
+    send(identity, req);
+  }
+}
+
+template <typename Send>
+void sendCryptorSetEnabledRequests(proto::FfiRequest &req,
+                                   std::uint64_t room_handle,
+                                   const std::vector<std::string> &identities,
+                                   bool enabled, Send &&send) {
+  req.mutable_e2ee()->set_room_handle(room_handle);
+  auto *msg = req.mutable_e2ee()->mutable_cryptor_set_enabled();
+  msg->set_enabled(enabled);
+  for (const auto &identity : identities) {
+    msg->set_participant_identity(identity);
+    send(identity, req);
+  }
+}
+
+template <typename Send>
+void sendCryptorSetKeyIndexRequests(proto::FfiRequest &req,
+                                    std::uint64_t room_handle,
+                                    const std::vector<std::string> &identities,
+                                    int key_index, Send &&send) {
+  req.mutable_e2ee()->set_room_handle(room_handle);
+  auto *msg = req.mutable_e2ee()->mutable_cryptor_set_key_index();
+  msg->set_key_index(key_index);
+  for (const auto &identity : identities) {
+    msg->set_participant_identity(identity);
+    send(identity, req);
+  }
+}
+
+// Slot a key rotation installs its key into: the epoch's slot for a
+// periodic rotation, otherwise the one after `active`. Never `active`
+// itself, which senders keep encrypting with until the new key activates;
+// an epoch landing on it (e.g. the first epoch after start-up) takes the
+// next slot instead.
+inline int nextRotationSlot(std::optional<std::int64_t> epoch, int active,
+                            int key_slots) {
+  const int slot = epoch ? static_cast<int>(*epoch % key_slots)
+                         : (active + 1) % key_slots;
+  return slot == active ? (slot + 1) % key_slots : slot;
+}
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_dispatcher.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <utility>
+
+#include "ffi_arena.h"
+#include "ffi_wire.h"
+#include "log.h"
+#include "thread_util.h"
+
+namespace livekit {
+
+namespace {
+
+// Set on dispatch worker threads, so a listener that triggers another
+// dispatch onto its own full queue handles it inline instead of waiting on
+// itself.
+thread_local const EventDispatcher *tls_dispatch_owner = nullptr;
+
+} // namespace
+
+EventDispatchOptions EventDispatchOptions::manyRooms() {
+  EventDispatchOptions options;
+  options.mode = EventDispatchMode::kShardedPool;
+  const int cores = static_cast<int>(std::thread::hardware_concurrency());
+  options.pool_threads = std::clamp(cores, 2, 16);
+  return options;
+}
+
+EventDispatcher::EventDispatcher(const EventDispatchOptions &options,
+                                 Sink sink, ShardKeyFn shard_key)
+    : mode_(options.mode),
+      capacity_(std::max<std::size_t>(1, options.queue_capacity)),
+      sink_(std::move(sink)), shard_key_(std::move(shard_key)) {
+  std::size_t threads = 0;
+  if (mode_ == EventDispatchMode::kDedicatedThread) {
+    threads = 1;
+  } else if (mode_ == EventDispatchMode::kShardedPool) {
+    threads = static_cast<std::size_t>(std::max(1, options.pool_threads));
+  }
+  shard_workers_ = threads;
+  if (threads > 0 && options.dedicated_audio_thread) {
+    ++threads;
+  }
+  workers_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  if (threads > shard_workers_) {
+    audio_worker_ = workers_.back().get();
+  }
+  for (std::size_t i = 0; i < workers_.size(); ++i) {
+    Worker *w = workers_[i].get();
+    w->thread = std::thread([this, w, i] {
+      if (w == audio_worker_) {
+        detail::registerThread(ThreadRole::kAudio, "lk-dispatch-aud");
+      } else {
+        const std::string name = "lk-dispatch-" + std::to_string(i);
+        detail::registerThread(ThreadRole::kEventDispatch, name.c_str());
+      }
+      run(*w);
+    });
+  }
+}
+
+EventDispatcher::~EventDispatcher() { stop(); }
+
+void EventDispatcher::dispatch(const std::uint8_t *buf, std::size_t len) {
+  if (workers_.empty()) {
+    FfiArenaScope arena;
+    auto *event = arena.create<proto::FfiEvent>();
+    event->ParseFromArray(buf, static_cast<int>(len));
+    invokeSink(*event);
+    return;
+  }
+
+  Item item;
+  Worker *worker = workers_.front().get();
+  if (mode_ == EventDispatchMode::kDedicatedThread) {
+    // Defer parsing to the worker; the callback thread only copies bytes.
+    item.raw.assign(reinterpret_cast<const char *>(buf), len);
+    detail::WireField field;
+    if (audio_worker_ && detail::peekFirstField(buf, len, field) &&
+        field.number == proto::FfiEvent::kAudioStreamEventFieldNumber) {
+      worker = audio_worker_;
+    }
+  } else {
+    item.event.ParseFromArray(buf, static_cast<int>(len));
+    item.parsed = true;
+    if (audio_worker_ &&
+        item.event.message_case() == proto::FfiEvent::kAudioStreamEvent) {
+      worker = audio_worker_;
+    } else {
+      worker = workers_[shard_key_(item.event) % shard_workers_].get();
+    }
+  }
+  enqueue(*worker, std::move(item));
+}
+
+void EventDispatcher::enqueue(Worker &worker, Item &&item) {
+  std::unique_lock<std::mutex> lock(worker.mutex);
+  if (worker.queue.size() >= capacity_ && !worker.stopping) {
+    if (tls_dispatch_owner == this) {
+      lock.unlock();
+      deliver(item);
+      return;
+    }
+    worker.not_full.wait(lock, [&] {
+      return worker.queue.size() < capacity_ || worker.stopping;
+    });
+  }
+  if (worker.stopping) {
+    lock.unlock();
+    deliver(item);
+    return;
+  }
+  worker.queue.push_back(std::move(item));
+  lock.unlock();
+  worker.not_empty.notify_one();
+}
+
+void EventDispatcher::run(Worker &worker) {
+  tls_dispatch_owner = this;
+  std::deque<Item> batch;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(worker.mutex);
+      worker.not_empty.wait(
+          lock, [&] { return !worker.queue.empty() || worker.stopping; });
+      if (worker.queue.empty()) {
+        break; // stopping and drained
+      }
+      batch.swap(worker.queue);
+    }
+    worker.not_full.notify_all();
+    for (auto &item : batch) {
+      deliver(item);
+    }
+    batch.clear();
+  }
+}
+
+void EventDispatcher::deliver(Item &item) const {
+  if (item.parsed) {
+    invokeSink(item.event);
+    return;
+  }
+  FfiArenaScope arena;
+  auto *event = arena.create<proto::FfiEvent>();
+  event->ParseFromString(item.raw);
+  invokeSink(*event);
+}
+
+void EventDispatcher::invokeSink(const proto::FfiEvent &event) const {
+  try {
+    sink_(event);
+  } catch (const std::exception &e) {
+    LK_LOG_ERROR("livekit::event_dispatcher", "listener threw: %s", e.what());
+  } catch (...) {
+    LK_LOG_ERROR("livekit::event_dispatcher",
+                 "listener threw unknown exception");
+  }
+}
+
+bool EventDispatcher::onWorkerThread() const noexcept {
+  return tls_dispatch_owner == this;
+}
+
+void EventDispatcher::stop() {
+  for (auto &worker : workers_) {
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->stopping = true;
+    }
+    worker->not_empty.notify_all();
+    worker->not_full.notify_all();
+  }
+  for (auto &worker : workers_) {
+    if (!worker->thread.joinable()) {
+      continue;
+    }
+    if (worker->thread.get_id() == std::this_thread::get_id()) {
+      // stop() called from a listener; the worker exits once drained.
+      worker->thread.detach();
+    } else {
+      worker->thread.join();
+    }
+  }
+}
+
+} // namespace livekit
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ffi.pb.h"
+#include "livekit/event_dispatch.h"
+
+namespace livekit {
+
+// Moves FFI event handling off the Rust callback thread.
+//
+// dispatch() is called from the Rust callback thread(s) with the serialized
+// FfiEvent. Depending on the mode, the event is handled inline, queued raw
+// for a single worker to parse, or parsed and queued to the worker that owns
+// its shard key. Each worker has a bounded queue (multiple producers, one
+// consumer); a full queue blocks the producer rather than dropping events.
+class EventDispatcher {
+public:
+  using Sink = std::function<void(const proto::FfiEvent &)>;
+  using ShardKeyFn = std::function<std::uint64_t(const proto::FfiEvent &)>;
+
+  EventDispatcher(const EventDispatchOptions &options, Sink sink,
+                  ShardKeyFn shard_key);
+  ~EventDispatcher();
+
+  EventDispatcher(const EventDispatcher &) = delete;
+  EventDispatcher &operator=(const EventDispatcher &) = delete;
+
+  void dispatch(const std::uint8_t *buf, std::size_t len);
+
+  // Deliver everything already queued, then join the workers. Later
+  // dispatch() calls run inline. Idempotent.
+  void stop();
+
+  EventDispatchMode mode() const noexcept { return mode_; }
+
+  // True when called from one of this dispatcher's worker threads.
+  bool onWorkerThread() const noexcept;
+
+private:
+  struct Item {
+    std::string raw; // serialized event, parsed on delivery (kDedicatedThread)
+    proto::FfiEvent event; // pre-parsed event (kShardedPool)
+    bool parsed = false;
+  };
+  struct Worker {
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<Item> queue;
+    bool stopping = false;
+    std::thread thread;
+  };
+
+  void enqueue(Worker &worker, Item &&item);
+  void run(Worker &worker);
+  void deliver(Item &item) const;
+  void invokeSink(const proto::FfiEvent &event) const;
+
+  EventDispatchMode mode_;
+  std::size_t capacity_;
+  Sink sink_;
+  ShardKeyFn shard_key_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Workers handling everything but audio; the audio worker, if any, is
+  // the last entry of workers_.
+  std::size_t shard_workers_ = 0;
+  Worker *audio_worker_ = nullptr;
+};
+
+} // namespace livekit
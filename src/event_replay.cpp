@@ -0,0 +1,214 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/event_replay.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "event_replay.h"
+#include "ffi.pb.h"
+#include "ffi_client.h"
+#include "room.pb.h"
+
+namespace livekit {
+namespace detail {
+
+std::atomic<bool> g_event_recording{false};
+
+} // namespace detail
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// File layout: the magic, then one record per event: u64 nanoseconds since
+// recording started, u32 payload size, the serialized FfiEvent. Integers
+// are little-endian.
+constexpr char kMagic[8] = {'L', 'K', 'E', 'V', 'R', 'E', 'C', '1'};
+constexpr std::size_t kRecordHeaderSize = 12;
+
+class Recorder {
+public:
+  void start(const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+      throw std::runtime_error("startEventRecording: already recording");
+    }
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+      throw std::runtime_error("startEventRecording: cannot open " + path);
+    }
+    if (std::fwrite(kMagic, sizeof(kMagic), 1, file) != 1) {
+      std::fclose(file);
+      throw std::runtime_error("startEventRecording: cannot write " + path);
+    }
+    file_ = file;
+    started_ = Clock::now();
+    events_ = 0;
+    detail::g_event_recording.store(true, std::memory_order_relaxed);
+  }
+
+  std::uint64_t stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    detail::g_event_recording.store(false, std::memory_order_relaxed);
+    if (!file_) {
+      return 0;
+    }
+    std::fclose(file_);
+    file_ = nullptr;
+    return events_;
+  }
+
+  bool active() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_ != nullptr;
+  }
+
+  void record(const std::uint8_t *buf, std::size_t len) noexcept {
+    const auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+      return;
+    }
+    const auto offset = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - started_)
+            .count());
+    std::uint8_t header[kRecordHeaderSize];
+    for (int i = 0; i < 8; ++i) {
+      header[i] = static_cast<std::uint8_t>(offset >> (8 * i));
+    }
+    const auto size = static_cast<std::uint32_t>(len);
+    for (int i = 0; i < 4; ++i) {
+      header[8 + i] = static_cast<std::uint8_t>(size >> (8 * i));
+    }
+    std::fwrite(header, sizeof(header), 1, file_);
+    std::fwrite(buf, 1, len, file_);
+    ++events_;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::FILE *file_ = nullptr;
+  Clock::time_point started_;
+  std::uint64_t events_ = 0;
+};
+
+Recorder &recorder() {
+  static Recorder instance;
+  return instance;
+}
+
+// Reads the next record into `payload`; false at a clean end of file.
+bool readRecord(std::FILE *file, std::uint64_t &offset_ns,
+                std::vector<std::uint8_t> &payload) {
+  std::uint8_t header[kRecordHeaderSize];
+  const std::size_t got = std::fread(header, 1, sizeof(header), file);
+  if (got == 0) {
+    return false;
+  }
+  if (got != sizeof(header)) {
+    throw std::runtime_error("replayEvents: truncated recording");
+  }
+  offset_ns = 0;
+  for (int i = 0; i < 8; ++i) {
+    offset_ns |= static_cast<std::uint64_t>(header[i]) << (8 * i);
+  }
+  std::uint32_t size = 0;
+  for (int i = 0; i < 4; ++i) {
+    size |= static_cast<std::uint32_t>(header[8 + i]) << (8 * i);
+  }
+  payload.resize(size);
+  if (size != 0 && std::fread(payload.data(), 1, size, file) != size) {
+    throw std::runtime_error("replayEvents: truncated recording");
+  }
+  return true;
+}
+
+} // namespace
+
+namespace detail {
+
+void recordFfiEvent(const std::uint8_t *buf, std::size_t len) noexcept {
+  recorder().record(buf, len);
+}
+
+} // namespace detail
+
+void startEventRecording(const std::string &path) { recorder().start(path); }
+
+std::uint64_t stopEventRecording() { return recorder().stop(); }
+
+bool eventRecordingActive() { return recorder().active(); }
+
+EventReplayResult replayEvents(const std::string &path,
+                               const EventReplayOptions &options) {
+  std::unique_ptr<std::FILE, int (*)(std::FILE *)> file(
+      std::fopen(path.c_str(), "rb"), &std::fclose);
+  if (!file) {
+    throw std::runtime_error("replayEvents: cannot open " + path);
+  }
+  char magic[sizeof(kMagic)];
+  if (std::fread(magic, sizeof(magic), 1, file.get()) != 1 ||
+      std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("replayEvents: not an event recording: " + path);
+  }
+
+  auto &client = FfiClient::instance();
+  EventReplayResult result;
+  proto::FfiEvent event;
+  std::vector<std::uint8_t> payload;
+  std::uint64_t offset_ns = 0;
+  const auto started = Clock::now();
+  while (readRecord(file.get(), offset_ns, payload)) {
+    if (options.speed > 0.0) {
+      std::this_thread::sleep_until(
+          started + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double, std::nano>(
+                            static_cast<double>(offset_ns) / options.speed)));
+    }
+    if (!event.ParseFromArray(payload.data(),
+                              static_cast<int>(payload.size()))) {
+      throw std::runtime_error("replayEvents: corrupt event in " + path);
+    }
+    result.bytes += payload.size();
+    result.recorded = std::chrono::nanoseconds(offset_ns);
+
+    if (event.message_case() == proto::FfiEvent::kConnect && options.room &&
+        !result.room_attached) {
+      result.room_attached =
+          detail::EventReplayAccess::attach(*options.room, event.connect());
+      ++result.events;
+      continue;
+    }
+    if (client.replayEvent(event)) {
+      ++result.events;
+    } else {
+      ++result.skipped;
+    }
+  }
+  result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now() - started);
+  return result;
+}
+
+} // namespace livekit
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace livekit {
+class Room;
+namespace proto {
+class ConnectCallback;
+} // namespace proto
+
+namespace detail {
+
+extern std::atomic<bool> g_event_recording;
+
+// LivekitFfiCallback checks this before touching the recorder.
+inline bool eventRecordingOn() noexcept {
+  return g_event_recording.load(std::memory_order_relaxed);
+}
+
+// Appends one raw FfiEvent to the open recording; safe from any thread.
+void recordFfiEvent(const std::uint8_t *buf, std::size_t len) noexcept;
+
+// Room's replay hook, kept off the public API.
+struct EventReplayAccess {
+  static bool attach(Room &room, const proto::ConnectCallback &cb);
+};
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <google/protobuf/arena.h>
+
+namespace livekit {
+
+// Scoped access to a per-thread protobuf arena for short-lived FFI messages
+// (parsed events, requests and responses on per-frame paths).
+//
+// The arena starts with a thread-local block, and Reset() keeps that block,
+// so steady-state traffic that fits in it performs no heap allocation at
+// all. Scopes nest: a listener that issues a request while handling an
+// event shares the arena, and it is only reset when the outermost scope on
+// the thread exits. Messages created through a scope must not outlive it.
+class FfiArenaScope {
+public:
+  FfiArenaScope() { ++state().depth; }
+  ~FfiArenaScope() {
+    State &s = state();
+    if (--s.depth == 0) {
+      s.arena.Reset();
+    }
+  }
+
+  FfiArenaScope(const FfiArenaScope &) = delete;
+  FfiArenaScope &operator=(const FfiArenaScope &) = delete;
+
+  google::protobuf::Arena *arena() { return &state().arena; }
+
+  template <typename Message> Message *create() {
+    return google::protobuf::Arena::CreateMessage<Message>(arena());
+  }
+
+private:
+  static constexpr std::size_t kInitialBlockSize = 32 * 1024;
+
+  struct State {
+    alignas(8) char block[kInitialBlockSize];
+    google::protobuf::Arena arena{block, sizeof(block)};
+    int depth = 0;
+  };
+
+  static State &state() {
+    thread_local State s;
+    return s;
+  }
+};
+
+} // namespace livekit
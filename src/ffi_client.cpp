@@ -14,21 +14,35 @@
  * limitations under the License.
  */
 
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <climits>
 #include <iostream>
+#include <mutex>
+#include <vector>
 
 #include "e2ee.pb.h"
 #include "ffi.pb.h"
+#include "event_dispatcher.h"
+#include "event_replay.h"
+#include "ffi_arena.h"
 #include "ffi_client.h"
+#include "livekit/async_operation.h"
 #include "livekit/build.h"
 #include "livekit/e2ee.h"
 #include "livekit/ffi_handle.h"
+#include "livekit/local_participant.h"
 #include "livekit/room.h"
 #include "livekit/rpc_error.h"
 #include "livekit/track.h"
 #include "livekit_ffi.h"
+#include "log.h"
 #include "room.pb.h"
 #include "room_proto_converter.h"
+#include "rpc_envelope.h"
+#include "rpc_metrics.h"
+#include "sdk_metrics.h"
 
 namespace livekit {
 
@@ -131,12 +145,40 @@ std::optional<FfiClient::AsyncId> ExtractAsyncId(const proto::FfiEvent &event) {
   }
 }
 
+// Returns the FFI handle that owns a handle-routed event, or nullopt for
+// events that are only delivered to broadcast listeners.
+std::optional<std::uint64_t>
+ExtractRoutingHandle(const proto::FfiEvent &event) {
+  using E = proto::FfiEvent;
+  switch (event.message_case()) {
+  case E::kRoomEvent:
+    return event.room_event().room_handle();
+  case E::kAudioStreamEvent:
+    return event.audio_stream_event().stream_handle();
+  case E::kVideoStreamEvent:
+    return event.video_stream_event().stream_handle();
+  case E::kRpcMethodInvocation:
+    return event.rpc_method_invocation().local_participant_handle();
+  case E::kByteStreamReaderEvent:
+    return event.byte_stream_reader_event().reader_handle();
+  case E::kTextStreamReaderEvent:
+    return event.text_stream_reader_event().reader_handle();
+  default:
+    return std::nullopt;
+  }
+}
+
 } // namespace
 
+FfiClient::FfiClient() = default;
+
 FfiClient::~FfiClient() {
   assert(!initialized_.load() &&
          "LiveKit SDK was not shut down before process exit. "
          "Call livekit::shutdown().");
+  if (init_thread_.joinable()) {
+    init_thread_.join();
+  }
 }
 
 void FfiClient::shutdown() noexcept {
@@ -144,19 +186,64 @@ void FfiClient::shutdown() noexcept {
     return;
   }
   initialized_.store(false, std::memory_order_release);
+  // A background initialize must have returned before the FFI is disposed.
+  if (init_thread_.joinable()) {
+    init_thread_.join();
+  }
+  // Drain queued events while the FFI is still usable; anything the Rust
+  // side emits during dispose is then handled inline.
+  if (dispatcher_) {
+    dispatcher_->stop();
+  }
   livekit_ffi_dispose();
+  if (dispatcher_ && dispatcher_->onWorkerThread()) {
+    // Called from an event handler: the detached worker still unwinds
+    // through the dispatcher, so it must outlive this call.
+    (void)dispatcher_.release();
+  }
+  dispatcher_.reset();
 }
 
-bool FfiClient::initialize(bool capture_logs) {
+bool FfiClient::initialize(bool capture_logs,
+                           const EventDispatchOptions &dispatch,
+                           bool background) {
   if (isInitialized()) {
     return false;
   }
   initialized_.store(true, std::memory_order_release);
-  livekit_ffi_initialize(&LivekitFfiCallback, capture_logs,
-                         LIVEKIT_BUILD_FLAVOR, LIVEKIT_BUILD_VERSION_FULL);
+  dispatcher_ = std::make_unique<EventDispatcher>(
+      dispatch, [this](const proto::FfiEvent &event) { PushEvent(event); },
+      [this](const proto::FfiEvent &event) { return shardKey(event); });
+  if (!background) {
+    livekit_ffi_initialize(&LivekitFfiCallback, capture_logs,
+                           LIVEKIT_BUILD_FLAVOR, LIVEKIT_BUILD_VERSION_FULL);
+    return true;
+  }
+  // Runtime start-up (tokio, WebRTC factory threads) dominates cold start;
+  // the caller can build rooms, sources and options in the meantime.
+  ffi_starting_.store(true, std::memory_order_release);
+  init_thread_ = std::thread([this, capture_logs] {
+    livekit_ffi_initialize(&LivekitFfiCallback, capture_logs,
+                           LIVEKIT_BUILD_FLAVOR, LIVEKIT_BUILD_VERSION_FULL);
+    {
+      std::lock_guard<std::mutex> lock(ready_mutex_);
+      ffi_starting_.store(false, std::memory_order_release);
+    }
+    ready_cv_.notify_all();
+  });
   return true;
 }
 
+void FfiClient::waitUntilReady() const {
+  if (!ffi_starting_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(ready_mutex_);
+  ready_cv_.wait(lock, [this] {
+    return !ffi_starting_.load(std::memory_order_acquire);
+  });
+}
+
 bool FfiClient::isInitialized() const noexcept {
   return initialized_.load(std::memory_order_acquire);
 }
@@ -165,82 +252,325 @@ FfiClient::ListenerId
 FfiClient::AddListener(const FfiClient::Listener &listener) {
   std::lock_guard<std::mutex> guard(lock_);
   FfiClient::ListenerId id = next_listener_id++;
-  listeners_[id] = listener;
+  listeners_[id] = std::make_shared<const Listener>(listener);
+  rebuildBroadcastSnapshotLocked();
   return id;
 }
 
+FfiClient::ListenerId
+FfiClient::AddHandleListener(proto::FfiEvent::MessageCase kind,
+                             std::uint64_t handle,
+                             const FfiClient::Listener &listener,
+                             std::uint64_t shard_handle) {
+  std::unique_lock<std::mutex> guard(lock_);
+  HandleKey key{kind, handle};
+  if (handle_listeners_.count(key) != 0) {
+    throw std::runtime_error(
+        "FfiClient::AddHandleListener: a listener is already registered for "
+        "this handle");
+  }
+  FfiClient::ListenerId id = next_listener_id++;
+  std::vector<proto::FfiEvent> held;
+  auto held_it = held_events_.find(key);
+  if (held_it != held_events_.end()) {
+    held = std::move(held_it->second);
+    held_events_.erase(held_it);
+  }
+  auto routed = std::make_shared<const RoutedListener>(
+      listener, std::move(held), shard_handle);
+  handle_listeners_.emplace(key, routed);
+  handle_listener_keys_.emplace(id, key);
+  guard.unlock();
+  routed->drainBacklog();
+  return id;
+}
+
+FfiClient::HandleEventHold::HandleEventHold(FfiClient &client,
+                                            proto::FfiEvent::MessageCase kind)
+    : client_(client), kind_(kind) {
+  std::lock_guard<std::mutex> guard(client_.lock_);
+  ++client_.held_kinds_[static_cast<int>(kind_)];
+}
+
+FfiClient::HandleEventHold::~HandleEventHold() {
+  client_.releaseHandleEvents(kind_);
+}
+
+FfiClient::HandleEventHold
+FfiClient::holdHandleEvents(proto::FfiEvent::MessageCase kind) {
+  return HandleEventHold(*this, kind);
+}
+
+void FfiClient::releaseHandleEvents(proto::FfiEvent::MessageCase kind) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto it = held_kinds_.find(static_cast<int>(kind));
+  if (it == held_kinds_.end() || --it->second > 0) {
+    return;
+  }
+  held_kinds_.erase(it);
+  for (auto held = held_events_.begin(); held != held_events_.end();) {
+    if (held->first.kind == kind) {
+      held = held_events_.erase(held);
+    } else {
+      ++held;
+    }
+  }
+}
+
+FfiClient::RoutedListener::RoutedListener(Listener listener,
+                                          std::vector<proto::FfiEvent> held,
+                                          std::uint64_t shard_handle)
+    : fn(std::move(listener)), shard(shard_handle), backlog(std::move(held)),
+      has_backlog(!backlog.empty()) {}
+
+void FfiClient::RoutedListener::drainBacklog() const {
+  if (!has_backlog.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(backlog_mutex);
+  deliverBacklogLocked();
+}
+
+void FfiClient::RoutedListener::deliver(const proto::FfiEvent &event) const {
+  if (has_backlog.load(std::memory_order_acquire)) {
+    // Hold the backlog lock for this event too, so it cannot overtake the
+    // held events AddHandleListener() may be delivering right now.
+    std::lock_guard<std::mutex> guard(backlog_mutex);
+    deliverBacklogLocked();
+    fn(event);
+    return;
+  }
+  fn(event);
+}
+
+void FfiClient::RoutedListener::deliverBacklogLocked() const {
+  for (const auto &held : backlog) {
+    fn(held);
+  }
+  backlog.clear();
+  has_backlog.store(false, std::memory_order_release);
+}
+
 void FfiClient::RemoveListener(ListenerId id) {
   std::lock_guard<std::mutex> guard(lock_);
-  listeners_.erase(id);
+  auto it = handle_listener_keys_.find(id);
+  if (it != handle_listener_keys_.end()) {
+    handle_listeners_.erase(it->second);
+    handle_listener_keys_.erase(it);
+    return;
+  }
+  if (listeners_.erase(id) != 0) {
+    rebuildBroadcastSnapshotLocked();
+  }
+}
+
+void FfiClient::rebuildBroadcastSnapshotLocked() {
+  if (listeners_.empty()) {
+    broadcast_snapshot_.reset();
+    return;
+  }
+  auto snapshot = std::make_shared<ListenerList>();
+  snapshot->reserve(listeners_.size());
+  for (const auto &kv : listeners_) {
+    snapshot->push_back(kv.second);
+  }
+  broadcast_snapshot_ = std::move(snapshot);
+}
+
+std::uint64_t FfiClient::shardKey(const proto::FfiEvent &event) const {
+  // Per-handle FIFO: everything owned by one room/stream/reader lands on the
+  // same worker. Async completions spread by request id.
+  if (auto handle = ExtractRoutingHandle(event)) {
+    // RPC invocations are keyed by local participant but handled by the
+    // room, which must not see them concurrently with its own events (its
+    // EOS tears the local participant down).
+    if (event.message_case() == proto::FfiEvent::kRpcMethodInvocation) {
+      std::lock_guard<std::mutex> guard(lock_);
+      auto it =
+          handle_listeners_.find(HandleKey{event.message_case(), *handle});
+      if (it != handle_listeners_.end() && it->second->shard != 0) {
+        return it->second->shard;
+      }
+    }
+    return *handle;
+  }
+  if (auto async_id = ExtractAsyncId(event)) {
+    return *async_id;
+  }
+  return 0;
 }
 
 proto::FfiResponse
 FfiClient::sendRequest(const proto::FfiRequest &request) const {
-  std::string bytes;
-  if (!request.SerializeToString(&bytes) || bytes.empty()) {
+  proto::FfiResponse response;
+  sendRequestInto(request, response);
+  return response;
+}
+
+const proto::FfiResponse &
+FfiClient::sendRequest(const proto::FfiRequest &request,
+                       FfiArenaScope &arena) const {
+  auto *response = arena.create<proto::FfiResponse>();
+  sendRequestInto(request, *response);
+  return *response;
+}
+
+void FfiClient::sendRequestInto(const proto::FfiRequest &request,
+                                proto::FfiResponse &response) const {
+  waitUntilReady();
+  const std::size_t size = request.ByteSizeLong();
+  if (size == 0 || size > static_cast<std::size_t>(INT_MAX)) {
     throw std::runtime_error("failed to serialize FfiRequest");
   }
+
+  // Small fixed-shape requests (capture_video_frame, apm_process_stream,
+  // clear_audio_buffer, ...) serialize into the stack; larger ones reuse a
+  // per-thread buffer. A nested call on the same thread (a listener
+  // issuing a request while the outer one is still in flight) falls back to
+  // a private allocation.
+  std::array<std::uint8_t, kInlineRequestBytes> inline_buf;
+  thread_local std::vector<std::uint8_t> tls_buf;
+  thread_local bool tls_buf_busy = false;
+  std::vector<std::uint8_t> nested_buf;
+  std::uint8_t *bytes = inline_buf.data();
+  bool owns_tls = false;
+  if (size > inline_buf.size()) {
+    std::vector<std::uint8_t> *buf = &nested_buf;
+    if (!tls_buf_busy) {
+      buf = &tls_buf;
+      tls_buf_busy = true;
+      owns_tls = true;
+    }
+    if (buf->size() < size) {
+      buf->resize(size);
+    }
+    bytes = buf->data();
+  }
+  struct TlsRelease {
+    bool active;
+    ~TlsRelease() {
+      if (active) {
+        // Don't keep an unusually large request's buffer around forever.
+        if (tls_buf.capacity() > kMaxRetainedRequestBytes) {
+          std::vector<std::uint8_t>().swap(tls_buf);
+        }
+        tls_buf_busy = false;
+      }
+    }
+  } tls_release{owns_tls};
+
+  // ByteSizeLong() above cached the sizes for this call.
+  request.SerializeWithCachedSizesToArray(bytes);
+
   const uint8_t *resp_ptr = nullptr;
   size_t resp_len = 0;
-  FfiHandleId handle =
-      livekit_ffi_request(reinterpret_cast<const uint8_t *>(bytes.data()),
-                          bytes.size(), &resp_ptr, &resp_len);
+  const bool timed = detail::metricsOn();
+  const auto started = timed ? std::chrono::steady_clock::now()
+                             : std::chrono::steady_clock::time_point{};
+  FfiHandleId handle = livekit_ffi_request(bytes, size, &resp_ptr, &resp_len);
+  if (timed) {
+    auto &metrics = detail::SdkMetrics::instance();
+    metrics.ffi_requests.add();
+    metrics.ffi_request_latency.record(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started));
+  }
   if (handle == INVALID_HANDLE) {
     throw std::runtime_error(
         "failed to send request, received an invalid handle");
   }
 
   // Ensure we drop the handle exactly once on all paths
-  FfiHandle handle_guard(static_cast<uintptr_t>(handle));
+  FfiHandle handle_guard(static_cast<uintptr_t>(handle),
+                         FfiHandle::Disposal::kDeferrable);
   if (!resp_ptr || resp_len == 0) {
     throw std::runtime_error("FFI returned empty response bytes");
   }
 
-  proto::FfiResponse response;
   if (!response.ParseFromArray(resp_ptr, static_cast<int>(resp_len))) {
     throw std::runtime_error("failed to parse FfiResponse");
   }
-  return response;
 }
 
 void FfiClient::PushEvent(const proto::FfiEvent &event) const {
+  // Complete pending future if this event is a callback with async_id. The
+  // completion slab has its own per-shard locks, so this does not touch lock_.
   std::unique_ptr<PendingBase> to_complete;
-  std::vector<Listener> listeners_copy;
+  if (auto async_id = ExtractAsyncId(event)) {
+    to_complete = takePending(*async_id, event.message_case());
+  }
+
+  RoutedListenerPtr routed;
+  std::shared_ptr<const ListenerList> broadcast;
   {
     std::lock_guard<std::mutex> guard(lock_);
 
-    // Complete pending future if this event is a callback with async_id
-    if (auto async_id = ExtractAsyncId(event)) {
-      auto it = pending_by_id_.find(*async_id);
-      if (it != pending_by_id_.end() && it->second &&
-          it->second->matches(event)) {
-        to_complete = std::move(it->second);
-        pending_by_id_.erase(it);
+    // Route to the single listener owning this event's handle, if any;
+    // failing that, keep it for the listener a holdHandleEvents() caller
+    // is about to add.
+    if (!handle_listeners_.empty() || !held_kinds_.empty()) {
+      if (auto handle = ExtractRoutingHandle(event)) {
+        HandleKey key{event.message_case(), *handle};
+        auto it = handle_listeners_.find(key);
+        if (it != handle_listeners_.end()) {
+          routed = it->second;
+        } else if (held_kinds_.count(static_cast<int>(key.kind)) != 0) {
+          auto &held = held_events_[key];
+          if (held.size() < kMaxHeldEventsPerHandle) {
+            held.push_back(event);
+          }
+        }
       }
     }
 
-    // Snapshot listeners
-    listeners_copy.reserve(listeners_.size());
-    for (const auto &kv : listeners_) {
-      listeners_copy.push_back(kv.second);
-    }
+    // Snapshot broadcast listeners (no per-event copy of the list itself)
+    broadcast = broadcast_snapshot_;
   }
   // Run handler outside lock
   if (to_complete) {
     to_complete->complete(event);
+    if (to_complete->resume) {
+      to_complete->resume(to_complete->resume_ctx);
+    }
   }
 
   // Notify listeners outside lock
-  for (auto &listener : listeners_copy) {
-    listener(event);
+  if (routed) {
+    routed->deliver(event);
+  }
+  if (broadcast) {
+    for (const auto &listener : *broadcast) {
+      (*listener)(event);
+    }
+  }
+}
+
+bool FfiClient::replayEvent(const proto::FfiEvent &event) const {
+  if (ExtractAsyncId(event)) {
+    return false;
   }
+  PushEvent(event);
+  return true;
 }
 
 void LivekitFfiCallback(const uint8_t *buf, size_t len) {
-  proto::FfiEvent event;
-  event.ParseFromArray(buf, len);
+  if (detail::eventRecordingOn()) {
+    detail::recordFfiEvent(buf, len);
+  }
+  // Log batches go to the log pipeline, never through event dispatch.
+  if (detail::consumeFfiLogEvent(buf, len)) {
+    return;
+  }
+  auto &client = FfiClient::instance();
+  if (client.dispatcher_) {
+    client.dispatcher_->dispatch(buf, len);
+    return;
+  }
+  FfiArenaScope arena;
+  auto *event = arena.create<proto::FfiEvent>();
+  event->ParseFromArray(buf, static_cast<int>(len));
 
-  FfiClient::instance().PushEvent(event);
+  client.PushEvent(*event);
 }
 
 FfiClient::AsyncId FfiClient::generateAsyncId() {
@@ -248,64 +578,191 @@ FfiClient::AsyncId FfiClient::generateAsyncId() {
 }
 
 bool FfiClient::cancelPendingByAsyncId(AsyncId async_id) {
-  std::unique_ptr<PendingBase> to_cancel;
-  {
-    std::lock_guard<std::mutex> guard(lock_);
-    auto it = pending_by_id_.find(async_id);
-    if (it != pending_by_id_.end()) {
-      to_cancel = std::move(it->second);
-      pending_by_id_.erase(it);
-    }
-  }
+  auto to_cancel = takePending(async_id, proto::FfiEvent::MESSAGE_NOT_SET);
   if (to_cancel) {
     to_cancel->cancel();
+    if (to_cancel->resume) {
+      to_cancel->resume(to_cancel->resume_ctx);
+    }
     return true;
   }
   return false;
 }
 
-template <typename T>
-std::future<T> FfiClient::registerAsync(
-    AsyncId async_id, std::function<bool(const proto::FfiEvent &)> match,
-    std::function<void(const proto::FfiEvent &, std::promise<T> &)> handler) {
-  auto pending = std::make_unique<Pending<T>>();
-  pending->async_id = async_id;
-  auto fut = pending->promise.get_future();
-  pending->match = std::move(match);
-  pending->handler = std::move(handler);
+bool FfiClient::setContinuation(AsyncId async_id, void (*resume)(void *),
+                                void *ctx) {
+  auto &shard = pending_shards_[async_id % kPendingShards];
+  auto &slot = shard.slots[(async_id / kPendingShards) % kSlotsPerShard];
+  std::lock_guard<std::mutex> guard(shard.mutex);
+  PendingBase *pending = nullptr;
+  if (slot.async_id == async_id && slot.pending) {
+    pending = slot.pending.get();
+  } else {
+    auto it = shard.overflow.find(async_id);
+    if (it != shard.overflow.end()) {
+      pending = it->second.get();
+    }
+  }
+  if (!pending) {
+    return false;
+  }
+  pending->resume = resume;
+  pending->resume_ctx = ctx;
+  return true;
+}
+
+namespace detail {
+
+bool setAsyncContinuation(std::uint64_t async_id, void (*resume)(void *),
+                          void *ctx) {
+  return FfiClient::instance().setContinuation(async_id, resume, ctx);
+}
+
+} // namespace detail
+
+namespace {
+
+// Free list of fixed-size blocks backing FfiClient::PendingBase. Every
+// in-flight request allocates one Pending<T, Handler>; recycling the blocks
+// keeps steady-state request traffic off the global allocator.
+constexpr std::size_t kPendingBlockSize = 256;
+constexpr std::size_t kMaxPooledPendingBlocks = 1024;
+
+struct PendingBlockPool {
+  std::mutex mutex;
+  std::vector<void *> free;
+};
+
+PendingBlockPool &pendingBlockPool() {
+  // Leaked so blocks released during static destruction stay valid.
+  static auto *pool = new PendingBlockPool();
+  return *pool;
+}
+
+} // namespace
+
+void *FfiClient::PendingBase::operator new(std::size_t size) {
+  if (size > kPendingBlockSize) {
+    return ::operator new(size);
+  }
+  auto &pool = pendingBlockPool();
   {
-    std::lock_guard<std::mutex> guard(lock_);
-    pending_by_id_.emplace(async_id, std::move(pending));
+    std::lock_guard<std::mutex> guard(pool.mutex);
+    if (!pool.free.empty()) {
+      void *block = pool.free.back();
+      pool.free.pop_back();
+      return block;
+    }
   }
+  return ::operator new(kPendingBlockSize);
+}
+
+void FfiClient::PendingBase::operator delete(void *ptr,
+                                             std::size_t size) noexcept {
+  if (!ptr) {
+    return;
+  }
+  if (size <= kPendingBlockSize) {
+    auto &pool = pendingBlockPool();
+    std::lock_guard<std::mutex> guard(pool.mutex);
+    if (pool.free.size() < kMaxPooledPendingBlocks) {
+      try {
+        pool.free.push_back(ptr);
+        return;
+      } catch (...) {
+        // fall through and release the block
+      }
+    }
+  }
+  ::operator delete(ptr);
+}
+
+void FfiClient::insertPending(std::unique_ptr<PendingBase> pending) {
+  const AsyncId async_id = pending->async_id;
+  auto &shard = pending_shards_[async_id % kPendingShards];
+  auto &slot = shard.slots[(async_id / kPendingShards) % kSlotsPerShard];
+  std::lock_guard<std::mutex> guard(shard.mutex);
+  if (!slot.pending) {
+    slot.async_id = async_id;
+    slot.pending = std::move(pending);
+  } else {
+    shard.overflow.emplace(async_id, std::move(pending));
+  }
+}
+
+std::size_t FfiClient::pendingAsyncCount() const {
+  std::size_t n = 0;
+  for (auto &shard : pending_shards_) {
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    for (const auto &slot : shard.slots) {
+      n += slot.pending ? 1 : 0;
+    }
+    n += shard.overflow.size();
+  }
+  return n;
+}
+
+std::size_t FfiClient::listenerCount() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return listeners_.size() + handle_listeners_.size();
+}
+
+std::unique_ptr<FfiClient::PendingBase>
+FfiClient::takePending(AsyncId async_id,
+                       proto::FfiEvent::MessageCase kind) const {
+  auto accepts = [kind](const std::unique_ptr<PendingBase> &pending) {
+    return pending && (kind == proto::FfiEvent::MESSAGE_NOT_SET ||
+                       pending->kind == kind);
+  };
+  auto &shard = pending_shards_[async_id % kPendingShards];
+  auto &slot = shard.slots[(async_id / kPendingShards) % kSlotsPerShard];
+  std::lock_guard<std::mutex> guard(shard.mutex);
+  if (slot.async_id == async_id && accepts(slot.pending)) {
+    return std::move(slot.pending);
+  }
+  if (shard.overflow.empty()) {
+    return nullptr;
+  }
+  auto it = shard.overflow.find(async_id);
+  if (it == shard.overflow.end() || !accepts(it->second)) {
+    return nullptr;
+  }
+  auto pending = std::move(it->second);
+  shard.overflow.erase(it);
+  return pending;
+}
+
+template <typename T, typename Handler>
+std::future<T> FfiClient::registerAsync(AsyncId async_id,
+                                        proto::FfiEvent::MessageCase kind,
+                                        Handler handler) {
+  auto pending = std::make_unique<Pending<T, Handler>>(std::move(handler));
+  pending->async_id = async_id;
+  pending->kind = kind;
+  auto fut = pending->promise.get_future();
+  insertPending(std::move(pending));
   return fut;
 }
 
 // Room APIs Implementation
-std::future<proto::ConnectCallback>
+std::future<ConnectResult>
 FfiClient::connectAsync(const std::string &url, const std::string &token,
-                        const RoomOptions &options) {
+                        const RoomOptions &options, ConnectHandler on_connect,
+                        AsyncId *async_id_out) {
 
   // Generate client-side async_id first
   const AsyncId async_id = generateAsyncId();
 
   // Register the async handler BEFORE sending the request
-  auto fut = registerAsync<proto::ConnectCallback>(
-      async_id,
-      // match lambda: is this the connect event with our async_id?
-      [async_id](const proto::FfiEvent &event) {
-        return event.has_connect() && event.connect().async_id() == async_id;
-      },
-      // handler lambda: fill the promise with RoomInfo or an exception
-      [](const proto::FfiEvent &event,
-         std::promise<proto::ConnectCallback> &pr) {
-        const auto &connectCb = event.connect();
-        if (!connectCb.error().empty()) {
-          pr.set_exception(
-              std::make_exception_ptr(std::runtime_error(connectCb.error())));
-          return;
+  auto fut = registerAsync<ConnectResult>(
+      async_id, proto::FfiEvent::kConnect,
+      [on_connect = std::move(on_connect)](
+          const proto::FfiEvent &event, std::promise<ConnectResult> &pr) {
+        try {
+          pr.set_value(on_connect(event.connect()));
+        } catch (...) {
+          pr.set_exception(std::current_exception());
         }
-
-        pr.set_value(connectCb);
       });
 
   // Build and send the request
@@ -386,6 +843,17 @@ FfiClient::connectAsync(const std::string &url, const std::string &token,
     }
   }
 
+  if (options.fast_resume) {
+    // Continual gathering keeps candidate pairs current across network
+    // changes, so an ICE restart has a working pair to move to right away.
+    auto *rtc = opts->mutable_rtc_config();
+    if (!options.rtc_config.has_value()) {
+      rtc->set_ice_transport_type(proto::IceTransportType::TRANSPORT_ALL);
+    }
+    rtc->set_continual_gathering_policy(
+        proto::ContinualGatheringPolicy::GATHER_CONTINUALLY);
+  }
+
   try {
     proto::FfiResponse resp = sendRequest(req);
     if (!resp.has_connect()) {
@@ -395,27 +863,26 @@ FfiClient::connectAsync(const std::string &url, const std::string &token,
     cancelPendingByAsyncId(async_id);
     throw;
   }
+  if (async_id_out) {
+    *async_id_out = async_id;
+  }
 
   return fut;
 }
 
 // Track APIs Implementation
 std::future<std::vector<RtcStats>>
-FfiClient::getTrackStatsAsync(uintptr_t track_handle) {
+FfiClient::getTrackStatsAsync(uintptr_t track_handle, RtcStatsTypeMask types) {
   // Generate client-side async_id first
   const AsyncId async_id = generateAsyncId();
 
   // Register the async handler BEFORE sending the request
   auto fut = registerAsync<std::vector<RtcStats>>(
       async_id,
-      // match
-      [async_id](const proto::FfiEvent &event) {
-        return event.has_get_stats() &&
-               event.get_stats().async_id() == async_id;
-      },
+      proto::FfiEvent::kGetStats,
       // handler
-      [](const proto::FfiEvent &event,
-         std::promise<std::vector<RtcStats>> &pr) {
+      [types](const proto::FfiEvent &event,
+              std::promise<std::vector<RtcStats>> &pr) {
         const auto &gs = event.get_stats();
 
         if (!gs.error().empty()) {
@@ -427,7 +894,9 @@ FfiClient::getTrackStatsAsync(uintptr_t track_handle) {
         std::vector<RtcStats> stats_vec;
         stats_vec.reserve(gs.stats_size());
         for (const auto &ps : gs.stats()) {
-          stats_vec.push_back(fromProto(ps));
+          if (rtcStatsSelected(ps, types)) {
+            stats_vec.push_back(fromProto(ps));
+          }
         }
         pr.set_value(std::move(stats_vec));
       });
@@ -451,6 +920,56 @@ FfiClient::getTrackStatsAsync(uintptr_t track_handle) {
   return fut;
 }
 
+std::future<SessionStats>
+FfiClient::getSessionStatsAsync(std::uint64_t room_handle,
+                                RtcStatsTypeMask types,
+                                AsyncId *async_id_out) {
+  const AsyncId async_id = generateAsyncId();
+
+  auto fut = registerAsync<SessionStats>(
+      async_id, proto::FfiEvent::kGetSessionStats,
+      [types](const proto::FfiEvent &event, std::promise<SessionStats> &pr) {
+        const auto &cb = event.get_session_stats();
+        if (cb.has_error()) {
+          pr.set_exception(
+              std::make_exception_ptr(std::runtime_error(cb.error())));
+          return;
+        }
+        SessionStats out;
+        for (const auto &ps : cb.result().publisher_stats()) {
+          if (rtcStatsSelected(ps, types)) {
+            appendSessionStats(fromProto(ps), out.publisher);
+          }
+        }
+        for (const auto &ps : cb.result().subscriber_stats()) {
+          if (rtcStatsSelected(ps, types)) {
+            appendSessionStats(fromProto(ps), out.subscriber);
+          }
+        }
+        pr.set_value(std::move(out));
+      });
+
+  proto::FfiRequest req;
+  auto *msg = req.mutable_get_session_stats();
+  msg->set_room_handle(room_handle);
+  msg->set_request_async_id(async_id);
+
+  try {
+    proto::FfiResponse resp = sendRequest(req);
+    if (!resp.has_get_session_stats()) {
+      logAndThrow("FfiResponse missing get_session_stats");
+    }
+  } catch (...) {
+    cancelPendingByAsyncId(async_id);
+    throw;
+  }
+
+  if (async_id_out) {
+    *async_id_out = async_id;
+  }
+  return fut;
+}
+
 // Participant APIs Implementation
 std::future<proto::OwnedTrackPublication>
 FfiClient::publishTrackAsync(std::uint64_t local_participant_handle,
@@ -463,10 +982,7 @@ FfiClient::publishTrackAsync(std::uint64_t local_participant_handle,
   auto fut = registerAsync<proto::OwnedTrackPublication>(
       async_id,
       // Match: is this our PublishTrackCallback?
-      [async_id](const proto::FfiEvent &event) {
-        return event.has_publish_track() &&
-               event.publish_track().async_id() == async_id;
-      },
+      proto::FfiEvent::kPublishTrack,
       // Handler: resolve with publication or throw error
       [](const proto::FfiEvent &event,
          std::promise<proto::OwnedTrackPublication> &pr) {
@@ -521,10 +1037,7 @@ FfiClient::unpublishTrackAsync(std::uint64_t local_participant_handle,
   // Register the async handler BEFORE sending the request
   auto fut = registerAsync<void>(
       async_id,
-      [async_id](const proto::FfiEvent &event) {
-        return event.has_unpublish_track() &&
-               event.unpublish_track().async_id() == async_id;
-      },
+      proto::FfiEvent::kUnpublishTrack,
       [](const proto::FfiEvent &event, std::promise<void> &pr) {
         const auto &cb = event.unpublish_track();
         if (cb.has_error() && !cb.error().empty()) {
@@ -560,18 +1073,28 @@ std::future<void> FfiClient::publishDataAsync(
     std::uint64_t local_participant_handle, const std::uint8_t *data_ptr,
     std::uint64_t data_len, bool reliable,
     const std::vector<std::string> &destination_identities,
-    const std::string &topic) {
+    const std::string &topic, AsyncId *async_id_out) {
+  AsyncId async_id = 0;
+  auto fut = expectPublishData(&async_id);
+  sendPublishData(local_participant_handle, data_ptr, data_len, reliable,
+                  destination_identities, topic, async_id);
+  if (async_id_out) {
+    *async_id_out = async_id;
+  }
+  return fut;
+}
+
+std::future<void> FfiClient::expectPublishData(AsyncId *async_id_out,
+                                               std::shared_ptr<void> hold) {
   // Generate client-side async_id first
   const AsyncId async_id = generateAsyncId();
+  *async_id_out = async_id;
 
   // Register the async handler BEFORE sending the request
-  auto fut = registerAsync<void>(
-      async_id,
-      [async_id](const proto::FfiEvent &event) {
-        return event.has_publish_data() &&
-               event.publish_data().async_id() == async_id;
-      },
-      [](const proto::FfiEvent &event, std::promise<void> &pr) {
+  return registerAsync<void>(
+      async_id, proto::FfiEvent::kPublishData,
+      [hold = std::move(hold)](const proto::FfiEvent &event,
+                               std::promise<void> &pr) {
         const auto &cb = event.publish_data();
         if (cb.has_error() && !cb.error().empty()) {
           pr.set_exception(
@@ -580,7 +1103,13 @@ std::future<void> FfiClient::publishDataAsync(
         }
         pr.set_value();
       });
+}
 
+void FfiClient::sendPublishData(
+    std::uint64_t local_participant_handle, const std::uint8_t *data_ptr,
+    std::uint64_t data_len, bool reliable,
+    const std::vector<std::string> &destination_identities,
+    const std::string &topic, AsyncId async_id) {
   // Build and send the request
   proto::FfiRequest req;
   auto *msg = req.mutable_publish_data();
@@ -603,8 +1132,70 @@ std::future<void> FfiClient::publishDataAsync(
     cancelPendingByAsyncId(async_id);
     throw;
   }
+}
 
-  return fut;
+void FfiClient::publishDataBatch(
+    std::uint64_t local_participant_handle, const DataPacketView *packets,
+    std::size_t count, bool reliable,
+    const std::vector<std::string> &destination_identities,
+    std::vector<std::future<void>> *acks, const AsyncId *async_ids) {
+  // The FFI has no multi-packet request; what is shared across the batch is
+  // the request message (built once, only the payload fields change) and
+  // its arena.
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
+  auto *msg = req.mutable_publish_data();
+  msg->set_local_participant_handle(local_participant_handle);
+  msg->set_reliable(reliable);
+  for (const auto &id : destination_identities) {
+    msg->add_destination_identities(id);
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const DataPacketView &packet = packets[i];
+    if (packet.size == 0) {
+      if (async_ids) {
+        cancelPendingByAsyncId(async_ids[i]);
+      }
+      continue;
+    }
+    // The FFI echoes the async id in its completion; untracked ids are
+    // ignored by PushEvent.
+    const AsyncId async_id = async_ids ? async_ids[i] : generateAsyncId();
+    if (acks && !async_ids) {
+      acks->push_back(registerAsync<void>(
+          async_id, proto::FfiEvent::kPublishData,
+          [](const proto::FfiEvent &event, std::promise<void> &pr) {
+            const auto &cb = event.publish_data();
+            if (cb.has_error() && !cb.error().empty()) {
+              pr.set_exception(
+                  std::make_exception_ptr(std::runtime_error(cb.error())));
+              return;
+            }
+            pr.set_value();
+          }));
+    }
+    msg->set_data_ptr(reinterpret_cast<std::uint64_t>(packet.data));
+    msg->set_data_len(packet.size);
+    msg->set_topic(packet.topic);
+    msg->set_request_async_id(async_id);
+
+    try {
+      const proto::FfiResponse &resp = sendRequest(req, arena);
+      if (!resp.has_publish_data()) {
+        logAndThrow("FfiResponse missing publish_data");
+      }
+    } catch (...) {
+      if (async_ids) {
+        for (std::size_t j = i; j < count; ++j) {
+          cancelPendingByAsyncId(async_ids[j]);
+        }
+      } else if (acks) {
+        cancelPendingByAsyncId(async_id);
+      }
+      throw;
+    }
+  }
 }
 
 std::future<void> FfiClient::publishSipDtmfAsync(
@@ -617,10 +1208,7 @@ std::future<void> FfiClient::publishSipDtmfAsync(
   // Register the async handler BEFORE sending the request
   auto fut = registerAsync<void>(
       async_id,
-      [async_id](const proto::FfiEvent &event) {
-        return event.has_publish_sip_dtmf() &&
-               event.publish_sip_dtmf().async_id() == async_id;
-      },
+      proto::FfiEvent::kPublishSipDtmf,
       [](const proto::FfiEvent &event, std::promise<void> &pr) {
         const auto &cb = event.publish_sip_dtmf();
         if (cb.has_error() && !cb.error().empty()) {
@@ -655,6 +1243,55 @@ std::future<void> FfiClient::publishSipDtmfAsync(
   return fut;
 }
 
+std::future<void> FfiClient::publishTranscriptionAsync(
+    std::uint64_t local_participant_handle,
+    const std::string &participant_identity, const std::string &track_sid,
+    const std::vector<TranscriptionSegment> &segments) {
+  const AsyncId async_id = generateAsyncId();
+
+  auto fut = registerAsync<void>(
+      async_id, proto::FfiEvent::kPublishTranscription,
+      [](const proto::FfiEvent &event, std::promise<void> &pr) {
+        const auto &cb = event.publish_transcription();
+        if (cb.has_error() && !cb.error().empty()) {
+          pr.set_exception(
+              std::make_exception_ptr(std::runtime_error(cb.error())));
+          return;
+        }
+        pr.set_value();
+      });
+
+  // A batch can carry many segments; build it in the arena.
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
+  auto *msg = req.mutable_publish_transcription();
+  msg->set_local_participant_handle(local_participant_handle);
+  msg->set_participant_identity(participant_identity);
+  msg->set_track_id(track_sid);
+  msg->set_request_async_id(async_id);
+  for (const auto &segment : segments) {
+    auto *out = msg->add_segments();
+    out->set_id(segment.id);
+    out->set_text(segment.text);
+    out->set_start_time(segment.start_time);
+    out->set_end_time(segment.end_time);
+    out->set_final(segment.is_final);
+    out->set_language(segment.language);
+  }
+
+  try {
+    const proto::FfiResponse &resp = sendRequest(req, arena);
+    if (!resp.has_publish_transcription()) {
+      logAndThrow("FfiResponse missing publish_transcription");
+    }
+  } catch (...) {
+    cancelPendingByAsyncId(async_id);
+    throw;
+  }
+
+  return fut;
+}
+
 std::future<void>
 FfiClient::setLocalMetadataAsync(std::uint64_t local_participant_handle,
                                  const std::string &metadata) {
@@ -664,10 +1301,7 @@ FfiClient::setLocalMetadataAsync(std::uint64_t local_participant_handle,
   // Register the async handler BEFORE sending the request
   auto fut = registerAsync<void>(
       async_id,
-      [async_id](const proto::FfiEvent &event) {
-        return event.has_set_local_metadata() &&
-               event.set_local_metadata().async_id() == async_id;
-      },
+      proto::FfiEvent::kSetLocalMetadata,
       [](const proto::FfiEvent &event, std::promise<void> &pr) {
         const auto &cb = event.set_local_metadata();
         if (cb.has_error() && !cb.error().empty()) {
@@ -707,11 +1341,7 @@ FfiClient::captureAudioFrameAsync(std::uint64_t source_handle,
   // Register the async handler BEFORE sending the request
   auto fut = registerAsync<void>(
       async_id,
-      // match predicate
-      [async_id](const proto::FfiEvent &event) {
-        return event.has_capture_audio_frame() &&
-               event.capture_audio_frame().async_id() == async_id;
-      },
+      proto::FfiEvent::kCaptureAudioFrame,
       // completion handler
       [](const proto::FfiEvent &event, std::promise<void> &pr) {
         const auto &cb = event.capture_audio_frame();
@@ -748,28 +1378,49 @@ FfiClient::performRpcAsync(std::uint64_t local_participant_handle,
                            const std::string &destination_identity,
                            const std::string &method,
                            const std::string &payload,
-                           std::optional<std::uint32_t> response_timeout_ms) {
+                           std::optional<std::uint32_t> response_timeout_ms,
+                           AsyncId *async_id_out) {
   // Generate client-side async_id first
   const AsyncId async_id = generateAsyncId();
 
   // Register the async handler BEFORE sending the request
+  const auto started = std::chrono::steady_clock::now();
   auto fut = registerAsync<std::string>(
       async_id,
-      // match predicate
-      [async_id](const proto::FfiEvent &event) {
-        return event.has_perform_rpc() &&
-               event.perform_rpc().async_id() == async_id;
-      },
-      [](const proto::FfiEvent &event, std::promise<std::string> &pr) {
+      proto::FfiEvent::kPerformRpc,
+      [method, started](const proto::FfiEvent &event,
+                        std::promise<std::string> &pr) {
         const auto &cb = event.perform_rpc();
+        auto record = [&](std::uint32_t error_code) {
+          if (!detail::metricsOn())
+            return;
+          detail::RpcMetricsRegistry::instance().recordOutgoing(
+              method,
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - started),
+              error_code);
+        };
 
         if (cb.has_error()) {
           // RpcError is a proto message; convert to C++ RpcError and throw
-          pr.set_exception(
-              std::make_exception_ptr(RpcError::fromProto(cb.error())));
+          RpcError err = RpcError::fromProto(cb.error());
+          record(err.code());
+          pr.set_exception(std::make_exception_ptr(std::move(err)));
           return;
         }
-        pr.set_value(cb.payload());
+        // Replies to binary / compressed calls come back in an envelope.
+        std::string body;
+        try {
+          if (!detail::decodeRpcPayload(cb.payload(), nullptr, &body)) {
+            body = cb.payload();
+          }
+        } catch (const RpcError &err) {
+          record(err.code());
+          pr.set_exception(std::make_exception_ptr(err));
+          return;
+        }
+        record(0);
+        pr.set_value(std::move(body));
       });
 
   // Build and send the request
@@ -794,6 +1445,9 @@ FfiClient::performRpcAsync(std::uint64_t local_participant_handle,
     throw;
   }
 
+  if (async_id_out) {
+    *async_id_out = async_id;
+  }
   return fut;
 }
 
@@ -808,10 +1462,7 @@ std::future<void> FfiClient::sendStreamHeaderAsync(
   // Register the async handler BEFORE sending the request
   auto fut = registerAsync<void>(
       async_id,
-      [async_id](const proto::FfiEvent &e) {
-        return e.has_send_stream_header() &&
-               e.send_stream_header().async_id() == async_id;
-      },
+      proto::FfiEvent::kSendStreamHeader,
       [](const proto::FfiEvent &e, std::promise<void> &pr) {
         const auto &cb = e.send_stream_header();
         if (!cb.error().empty()) {
@@ -847,21 +1498,28 @@ std::future<void> FfiClient::sendStreamHeaderAsync(
 }
 
 std::future<void> FfiClient::sendStreamChunkAsync(
-    std::uint64_t local_participant_handle,
-    const proto::DataStream::Chunk &chunk,
+    std::uint64_t local_participant_handle, const std::string &stream_id,
+    std::uint64_t chunk_index, const std::uint8_t *content, std::size_t size,
     const std::vector<std::string> &destination_identities,
     const std::string &sender_identity) {
+  AsyncId async_id = 0;
+  auto fut = expectStreamChunk(&async_id);
+  sendStreamChunk(local_participant_handle, stream_id, chunk_index, content,
+                  size, destination_identities, sender_identity, async_id);
+  return fut;
+}
+
+std::future<void> FfiClient::expectStreamChunk(AsyncId *async_id_out,
+                                               std::shared_ptr<void> hold) {
   // Generate client-side async_id first
   const AsyncId async_id = generateAsyncId();
+  *async_id_out = async_id;
 
   // Register the async handler BEFORE sending the request
-  auto fut = registerAsync<void>(
-      async_id,
-      [async_id](const proto::FfiEvent &e) {
-        return e.has_send_stream_chunk() &&
-               e.send_stream_chunk().async_id() == async_id;
-      },
-      [](const proto::FfiEvent &e, std::promise<void> &pr) {
+  return registerAsync<void>(
+      async_id, proto::FfiEvent::kSendStreamChunk,
+      [hold = std::move(hold)](const proto::FfiEvent &e,
+                               std::promise<void> &pr) {
         const auto &cb = e.send_stream_chunk();
         if (!cb.error().empty()) {
           pr.set_exception(
@@ -870,12 +1528,23 @@ std::future<void> FfiClient::sendStreamChunkAsync(
         }
         pr.set_value();
       });
+}
 
-  // Build and send the request
-  proto::FfiRequest req;
+void FfiClient::sendStreamChunk(
+    std::uint64_t local_participant_handle, const std::string &stream_id,
+    std::uint64_t chunk_index, const std::uint8_t *content, std::size_t size,
+    const std::vector<std::string> &destination_identities,
+    const std::string &sender_identity, AsyncId async_id) {
+  // Build and send the request. The content is copied once, from the
+  // caller's buffer into the arena-backed request.
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
   auto *msg = req.mutable_send_stream_chunk();
   msg->set_local_participant_handle(local_participant_handle);
-  *msg->mutable_chunk() = chunk;
+  auto *chunk = msg->mutable_chunk();
+  chunk->set_stream_id(stream_id);
+  chunk->set_chunk_index(chunk_index);
+  chunk->set_content(content, size);
   msg->set_sender_identity(sender_identity);
   msg->set_request_async_id(async_id);
   for (const auto &id : destination_identities) {
@@ -883,7 +1552,7 @@ std::future<void> FfiClient::sendStreamChunkAsync(
   }
 
   try {
-    proto::FfiResponse resp = sendRequest(req);
+    const proto::FfiResponse &resp = sendRequest(req, arena);
     if (!resp.has_send_stream_chunk()) {
       logAndThrow("FfiResponse missing send_stream_chunk");
     }
@@ -891,8 +1560,6 @@ std::future<void> FfiClient::sendStreamChunkAsync(
     cancelPendingByAsyncId(async_id);
     throw;
   }
-
-  return fut;
 }
 
 std::future<void>
@@ -905,10 +1572,7 @@ FfiClient::sendStreamTrailerAsync(std::uint64_t local_participant_handle,
   // Register the async handler BEFORE sending the request
   auto fut = registerAsync<void>(
       async_id,
-      [async_id](const proto::FfiEvent &e) {
-        return e.has_send_stream_trailer() &&
-               e.send_stream_trailer().async_id() == async_id;
-      },
+      proto::FfiEvent::kSendStreamTrailer,
       [](const proto::FfiEvent &e, std::promise<void> &pr) {
         const auto &cb = e.send_stream_trailer();
         if (!cb.error().empty()) {
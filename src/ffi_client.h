@@ -17,15 +17,21 @@
 #ifndef LIVEKIT_FFI_CLIENT_H
 #define LIVEKIT_FFI_CLIENT_H
 
+#include <array>
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <future>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
+#include "ffi.pb.h"
+#include "livekit/event_dispatch.h"
 #include "livekit/stats.h"
 #include "room.pb.h"
 
@@ -34,7 +40,6 @@ namespace livekit {
 namespace proto {
 class AudioFrameBufferInfo;
 class ConnectCallback;
-class FfiEvent;
 class FfiResponse;
 class FfiRequest;
 class OwnedTrackPublication;
@@ -42,8 +47,13 @@ class DataStream;
 
 } // namespace proto
 
+class EventDispatcher;
+class FfiArenaScope;
+struct DataPacketView;
+struct ConnectResult;
 struct RoomOptions;
 struct TrackPublishOptions;
+struct TranscriptionSegment;
 
 using FfiCallbackFn = void (*)(const uint8_t *, size_t);
 extern "C" void livekit_ffi_initialize(FfiCallbackFn cb, bool capture_logs,
@@ -73,8 +83,14 @@ public:
     return instance;
   }
 
-  // Must be called before any other FFI usage
-  bool initialize(bool capture_logs);
+  // Must be called before any other FFI usage. With `background`,
+  // livekit_ffi_initialize runs on a helper thread and this returns
+  // immediately; requests issued meanwhile block until it has finished.
+  bool initialize(bool capture_logs, const EventDispatchOptions &dispatch = {},
+                  bool background = false);
+
+  // Blocks until a background initialize() has finished (no-op otherwise).
+  void waitUntilReady() const;
 
   // Called only once. After calling shutdown(), no further calls into FfiClient
   // are valid.
@@ -82,16 +98,78 @@ public:
 
   bool isInitialized() const noexcept;
 
+  // Broadcast listener: invoked for every FFI event.
   ListenerId AddListener(const Listener &listener);
+
+  // Handle-routed listener: invoked only for events of the given kind whose
+  // owning handle (stream handle, room handle, local participant handle, ...)
+  // equals `handle`. Dispatch is a single hash lookup, so per-object listeners
+  // (AudioStream, VideoStream, Room) should prefer this over AddListener.
+  // At most one listener may be registered per (kind, handle) pair.
+  // A non-zero `shard_handle` names the handle whose events these must stay
+  // ordered with under a dispatch pool, for events keyed by a handle other
+  // than their owner's (RPC invocations, keyed by local participant, belong
+  // to the room).
+  ListenerId AddHandleListener(proto::FfiEvent::MessageCase kind,
+                               std::uint64_t handle, const Listener &listener,
+                               std::uint64_t shard_handle = 0);
+
+  // Removes a listener registered with either AddListener or
+  // AddHandleListener.
   void RemoveListener(ListenerId id);
 
+  // While alive, handle-routed events of one kind that arrive before any
+  // listener for their handle are held instead of dropped, and handed to
+  // the listener AddHandleListener() registers for that handle, in order,
+  // ahead of newer events. Keep one across the request creating the handle
+  // and the AddHandleListener() call; held events nobody claimed are
+  // dropped once the last hold for the kind goes away.
+  class HandleEventHold {
+  public:
+    HandleEventHold(const HandleEventHold &) = delete;
+    HandleEventHold &operator=(const HandleEventHold &) = delete;
+    ~HandleEventHold();
+
+  private:
+    friend class FfiClient;
+    HandleEventHold(FfiClient &client, proto::FfiEvent::MessageCase kind);
+
+    FfiClient &client_;
+    proto::FfiEvent::MessageCase kind_;
+  };
+  HandleEventHold holdHandleEvents(proto::FfiEvent::MessageCase kind);
+
+  // Dispatches a recorded event to the listeners as the FFI callback would
+  // (see replayEvents()). Replies carrying an async_id are not delivered,
+  // since no pending request of this process belongs to them; returns
+  // false for those.
+  bool replayEvent(const proto::FfiEvent &event) const;
+
+  // Scrape-time counts for metricsToOpenMetrics(); these walk the tables
+  // under their locks rather than being maintained per operation.
+  std::size_t pendingAsyncCount() const;
+  std::size_t listenerCount() const;
+
   // Room APIs
-  std::future<proto::ConnectCallback> connectAsync(const std::string &url,
-                                                   const std::string &token,
-                                                   const RoomOptions &options);
+  // `on_connect` runs on the FFI event thread with the connect callback,
+  // failed or not, and produces the value the future is satisfied with, so
+  // a continuation on the operation sees everything it set up.
+  using ConnectHandler =
+      std::function<ConnectResult(const proto::ConnectCallback &)>;
+  std::future<ConnectResult> connectAsync(const std::string &url,
+                                          const std::string &token,
+                                          const RoomOptions &options,
+                                          ConnectHandler on_connect,
+                                          AsyncId *async_id_out = nullptr);
 
   // Track APIs
-  std::future<std::vector<RtcStats>> getTrackStatsAsync(uintptr_t track_handle);
+  std::future<std::vector<RtcStats>>
+  getTrackStatsAsync(uintptr_t track_handle,
+                     RtcStatsTypeMask types = kAllRtcStatsTypes);
+  std::future<SessionStats>
+  getSessionStatsAsync(std::uint64_t room_handle,
+                       RtcStatsTypeMask types = kSessionStatsTypes,
+                       AsyncId *async_id_out = nullptr);
 
   // Participant APIs
   std::future<proto::OwnedTrackPublication>
@@ -106,12 +184,42 @@ public:
                    const std::uint8_t *data_ptr, std::uint64_t data_len,
                    bool reliable,
                    const std::vector<std::string> &destination_identities,
-                   const std::string &topic);
+                   const std::string &topic, AsyncId *async_id_out = nullptr);
+  // Publish `count` packets back to back through one reused, arena-backed
+  // request. With `acks`, one future per packet is appended to it; without,
+  // completions are not tracked at all (fire-and-forget) and FFI errors
+  // reported later are dropped. With `async_ids` instead, packet i carries
+  // async_ids[i], whose completion the caller registered beforehand through
+  // expectPublishData(); a failed send cancels every completion not sent
+  // yet and rethrows. Payloads are copied before this returns.
+  void publishDataBatch(std::uint64_t local_participant_handle,
+                        const DataPacketView *packets, std::size_t count,
+                        bool reliable,
+                        const std::vector<std::string> &destination_identities,
+                        std::vector<std::future<void>> *acks,
+                        const AsyncId *async_ids = nullptr);
+  // Two-phase publish_data, for sends that may wait in a queue first.
+  // expectPublishData() registers the completion and reports the async id
+  // the later sendPublishData() must carry; the handler keeps `hold` alive
+  // until the operation completes or is cancelled. A failed send cancels
+  // the completion and rethrows.
+  std::future<void> expectPublishData(AsyncId *async_id_out,
+                                      std::shared_ptr<void> hold = nullptr);
+  void sendPublishData(std::uint64_t local_participant_handle,
+                       const std::uint8_t *data_ptr, std::uint64_t data_len,
+                       bool reliable,
+                       const std::vector<std::string> &destination_identities,
+                       const std::string &topic, AsyncId async_id);
   std::future<void>
   publishSipDtmfAsync(std::uint64_t local_participant_handle,
                       std::uint32_t code, const std::string &digit,
                       const std::vector<std::string> &destination_identities);
   std::future<void>
+  publishTranscriptionAsync(std::uint64_t local_participant_handle,
+                            const std::string &participant_identity,
+                            const std::string &track_sid,
+                            const std::vector<TranscriptionSegment> &segments);
+  std::future<void>
   setLocalMetadataAsync(std::uint64_t local_participant_handle,
                         const std::string &metadata);
   std::future<void>
@@ -121,7 +229,8 @@ public:
       std::uint64_t local_participant_handle,
       const std::string &destination_identity, const std::string &method,
       const std::string &payload,
-      std::optional<std::uint32_t> response_timeout_ms = std::nullopt);
+      std::optional<std::uint32_t> response_timeout_ms = std::nullopt,
+      AsyncId *async_id_out = nullptr);
 
   // Data stream functionalities
   std::future<void>
@@ -129,40 +238,75 @@ public:
                         const proto::DataStream::Header &header,
                         const std::vector<std::string> &destination_identities,
                         const std::string &sender_identity);
+  // Chunk content is copied straight from `content` into the request, so
+  // callers can pass slices of a larger buffer or a file mapping.
   std::future<void>
   sendStreamChunkAsync(std::uint64_t local_participant_handle,
-                       const proto::DataStream::Chunk &chunk,
+                       const std::string &stream_id, std::uint64_t chunk_index,
+                       const std::uint8_t *content, std::size_t size,
                        const std::vector<std::string> &destination_identities,
                        const std::string &sender_identity);
+  // Two-phase sendStreamChunkAsync(), as for publish_data above.
+  std::future<void>
+  expectStreamChunk(AsyncId *async_id_out,
+                    std::shared_ptr<void> hold = nullptr);
+  void sendStreamChunk(std::uint64_t local_participant_handle,
+                       const std::string &stream_id, std::uint64_t chunk_index,
+                       const std::uint8_t *content, std::size_t size,
+                       const std::vector<std::string> &destination_identities,
+                       const std::string &sender_identity, AsyncId async_id);
   std::future<void>
   sendStreamTrailerAsync(std::uint64_t local_participant_handle,
                          const proto::DataStream::Trailer &trailer,
                          const std::string &sender_identity);
 
+  // Run resume(ctx) on the FFI event thread once the operation registered
+  // under async_id completes or is cancelled. Returns false if it is no
+  // longer pending. Async methods report their id through `async_id_out`.
+  bool setContinuation(AsyncId async_id, void (*resume)(void *), void *ctx);
+
+  // Cancel a pending async operation by its async_id. Returns true if found and
+  // removed.
+  bool cancelPendingByAsyncId(AsyncId async_id);
+
   // Generic function for sending a request to the Rust FFI.
   // Note: For asynchronous requests, use the dedicated async functions instead
   // of sendRequest.
   proto::FfiResponse sendRequest(const proto::FfiRequest &request) const;
 
+  // Same as above, but parses the response into the calling thread's
+  // reusable arena. The returned reference is valid while `arena` lives.
+  // Prefer this on per-frame paths that only inspect the response.
+  const proto::FfiResponse &sendRequest(const proto::FfiRequest &request,
+                                        FfiArenaScope &arena) const;
+
 private:
-  FfiClient() = default;
+  FfiClient();
 
-  // Base class for type-erased pending ops
+  // Base class for type-erased pending ops. Instances are carved from a
+  // fixed-size block pool (see operator new) rather than the general heap.
   struct PendingBase {
     AsyncId async_id = 0; // Client-generated async ID for cancellation
+    // Callback kind expected for async_id; other kinds never complete it.
+    proto::FfiEvent::MessageCase kind = proto::FfiEvent::MESSAGE_NOT_SET;
+    // Optional continuation run after complete()/cancel(), e.g. to resume a
+    // coroutine awaiting this operation.
+    void (*resume)(void *) = nullptr;
+    void *resume_ctx = nullptr;
     virtual ~PendingBase() = default;
-    virtual bool matches(const proto::FfiEvent &event) const = 0;
     virtual void complete(const proto::FfiEvent &event) = 0;
     virtual void cancel() = 0; // Cancel the pending operation
+
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size) noexcept;
   };
-  template <typename T> struct Pending : PendingBase {
+  // The completion handler is stored by value, so registering an operation
+  // costs one pooled block plus the promise's shared state.
+  template <typename T, typename Handler> struct Pending : PendingBase {
     std::promise<T> promise;
-    std::function<bool(const proto::FfiEvent &)> match;
-    std::function<void(const proto::FfiEvent &, std::promise<T> &)> handler;
+    Handler handler;
 
-    bool matches(const proto::FfiEvent &event) const override {
-      return match && match(event);
-    }
+    explicit Pending(Handler h) : handler(std::move(h)) {}
 
     void complete(const proto::FfiEvent &event) override {
       handler(event, promise);
@@ -178,28 +322,118 @@ private:
     }
   };
 
-  template <typename T>
-  std::future<T> registerAsync(
-      AsyncId async_id, std::function<bool(const proto::FfiEvent &)> match,
-      std::function<void(const proto::FfiEvent &, std::promise<T> &)> handler);
+  template <typename T, typename Handler>
+  std::future<T> registerAsync(AsyncId async_id,
+                               proto::FfiEvent::MessageCase kind,
+                               Handler handler);
 
   // Generate a unique client-side async ID for request correlation
   AsyncId generateAsyncId();
 
-  // Cancel a pending async operation by its async_id. Returns true if found and
-  // removed.
-  bool cancelPendingByAsyncId(AsyncId async_id);
-
-  std::unordered_map<ListenerId, Listener> listeners_;
+  // Key for handle-routed listeners: (event kind, owning FFI handle).
+  struct HandleKey {
+    proto::FfiEvent::MessageCase kind;
+    std::uint64_t handle;
+    bool operator==(const HandleKey &other) const noexcept {
+      return kind == other.kind && handle == other.handle;
+    }
+  };
+  struct HandleKeyHash {
+    std::size_t operator()(const HandleKey &key) const noexcept {
+      return std::hash<std::uint64_t>{}(key.handle) ^
+             (static_cast<std::size_t>(key.kind) << 1);
+    }
+  };
+  using ListenerPtr = std::shared_ptr<const Listener>;
+  using ListenerList = std::vector<ListenerPtr>;
+
+  // A handle-routed listener plus the events held for its handle before it
+  // was registered. Whichever of AddHandleListener() and PushEvent() gets
+  // there first delivers the backlog, under `backlog_mutex`, so held events
+  // still precede newer ones; once it is empty delivery takes no lock.
+  struct RoutedListener {
+    RoutedListener(Listener fn, std::vector<proto::FfiEvent> held,
+                   std::uint64_t shard);
+    void deliver(const proto::FfiEvent &event) const;
+    void drainBacklog() const;
+    void deliverBacklogLocked() const;
+
+    Listener fn;
+    std::uint64_t shard;
+    mutable std::mutex backlog_mutex;
+    mutable std::vector<proto::FfiEvent> backlog;
+    mutable std::atomic<bool> has_backlog;
+  };
+  using RoutedListenerPtr = std::shared_ptr<const RoutedListener>;
+
+  // Bounds what a hold keeps per handle; later events are dropped, as they
+  // would have been without a hold.
+  static constexpr std::size_t kMaxHeldEventsPerHandle = 64;
+
+  void rebuildBroadcastSnapshotLocked();
+  void releaseHandleEvents(proto::FfiEvent::MessageCase kind);
+  // Dispatcher shard for an event: its routing handle, or the shard_handle
+  // its listener was registered with; else its async id.
+  std::uint64_t shardKey(const proto::FfiEvent &event) const;
+
+  std::unordered_map<ListenerId, ListenerPtr> listeners_;
+  // Copy-on-write snapshot of listeners_, rebuilt on add/remove so PushEvent
+  // only has to copy a single shared_ptr per event.
+  std::shared_ptr<const ListenerList> broadcast_snapshot_;
+  std::unordered_map<HandleKey, RoutedListenerPtr, HandleKeyHash>
+      handle_listeners_;
+  std::unordered_map<ListenerId, HandleKey> handle_listener_keys_;
+  // Live holdHandleEvents() count per event kind, and what they hold.
+  std::unordered_map<int, int> held_kinds_;
+  mutable std::unordered_map<HandleKey, std::vector<proto::FfiEvent>,
+                             HandleKeyHash>
+      held_events_;
   std::atomic<ListenerId> next_listener_id{1};
   mutable std::mutex lock_;
-  mutable std::unordered_map<AsyncId, std::unique_ptr<PendingBase>>
-      pending_by_id_;
+
+  // Completion slab for in-flight async operations, sharded by async_id so
+  // registration and completion do not contend on lock_. Async ids are
+  // handed out sequentially, so each id maps to a fixed slot; an id whose
+  // slot is still held by a much older operation goes to the shard's
+  // overflow map instead.
+  static constexpr std::size_t kPendingShards = 16;
+  static constexpr std::size_t kSlotsPerShard = 256;
+  struct PendingSlot {
+    AsyncId async_id = 0;
+    std::unique_ptr<PendingBase> pending;
+  };
+  struct PendingShard {
+    std::mutex mutex;
+    std::array<PendingSlot, kSlotsPerShard> slots;
+    std::unordered_map<AsyncId, std::unique_ptr<PendingBase>> overflow;
+  };
+  void insertPending(std::unique_ptr<PendingBase> pending);
+  // Removes and returns the operation for async_id if it expects `kind`
+  // (or any kind if MESSAGE_NOT_SET).
+  std::unique_ptr<PendingBase>
+  takePending(AsyncId async_id, proto::FfiEvent::MessageCase kind) const;
+  mutable std::array<PendingShard, kPendingShards> pending_shards_;
   std::atomic<AsyncId> next_async_id_{1};
 
+  // Requests up to this size are serialized on the stack; larger ones use a
+  // per-thread buffer that is retained up to kMaxRetainedRequestBytes.
+  static constexpr std::size_t kInlineRequestBytes = 512;
+  static constexpr std::size_t kMaxRetainedRequestBytes = 1 << 20;
+  void sendRequestInto(const proto::FfiRequest &request,
+                       proto::FfiResponse &response) const;
   void PushEvent(const proto::FfiEvent &event) const;
   friend void LivekitFfiCallback(const uint8_t *buf, size_t len);
+  // Set before livekit_ffi_initialize and torn down after
+  // livekit_ffi_dispose, so the callback thread never sees it change.
+  std::unique_ptr<EventDispatcher> dispatcher_;
   std::atomic<bool> initialized_{false};
+  // Background initialize(): true while init_thread_ is inside
+  // livekit_ffi_initialize. Checked on every request, so it is an atomic
+  // with the condition variable only touched on the slow path.
+  std::atomic<bool> ffi_starting_{false};
+  mutable std::mutex ready_mutex_;
+  mutable std::condition_variable ready_cv_;
+  std::thread init_thread_;
 };
 } // namespace livekit
 
@@ -15,31 +15,60 @@
  */
 
 #include "livekit/ffi_handle.h"
+#include "handle_disposer.h"
 #include "livekit_ffi.h"
+#include "sdk_metrics.h"
 
 namespace livekit {
 
-FfiHandle::FfiHandle(uintptr_t h) noexcept : handle_(h) {}
+FfiHandle::FfiHandle(uintptr_t h) noexcept : handle_(h) { track(); }
+
+FfiHandle::FfiHandle(uintptr_t h, Disposal disposal) noexcept
+    : handle_(h), disposal_(disposal) {
+  track();
+}
+
+FfiHandle::FfiHandle(uintptr_t h, ResourceKind kind,
+                     Disposal disposal) noexcept
+    : handle_(h), disposal_(disposal), kind_(kind) {
+  track();
+}
 
 FfiHandle::~FfiHandle() { reset(); }
 
-FfiHandle::FfiHandle(FfiHandle &&other) noexcept : handle_(other.release()) {}
+// Moves hand the count over with the handle.
+FfiHandle::FfiHandle(FfiHandle &&other) noexcept
+    : handle_(other.handle_), disposal_(other.disposal_), kind_(other.kind_),
+      tracked_(other.tracked_) {
+  other.handle_ = 0;
+  other.tracked_ = false;
+}
 
 FfiHandle &FfiHandle::operator=(FfiHandle &&other) noexcept {
   if (this != &other) {
-    reset(other.release());
+    reset();
+    handle_ = other.handle_;
+    disposal_ = other.disposal_;
+    kind_ = other.kind_;
+    tracked_ = other.tracked_;
+    other.handle_ = 0;
+    other.tracked_ = false;
   }
   return *this;
 }
 
 void FfiHandle::reset(uintptr_t new_handle) noexcept {
-  if (handle_) {
+  untrack();
+  if (handle_ && !(disposal_ == Disposal::kDeferrable &&
+                   detail::HandleDisposer::instance().defer(handle_))) {
     livekit_ffi_drop_handle(handle_);
   }
   handle_ = new_handle;
+  track();
 }
 
 uintptr_t FfiHandle::release() noexcept {
+  untrack();
   uintptr_t old = handle_;
   handle_ = 0;
   return old;
@@ -49,4 +78,18 @@ bool FfiHandle::valid() const noexcept { return handle_ != 0; }
 
 uintptr_t FfiHandle::get() const noexcept { return handle_; }
 
+void FfiHandle::track() noexcept {
+  if (handle_ && detail::metricsOn()) {
+    detail::SdkMetrics::instance().resources.onHandleCreated(kind_);
+    tracked_ = true;
+  }
+}
+
+void FfiHandle::untrack() noexcept {
+  if (tracked_) {
+    detail::SdkMetrics::instance().resources.onHandleDropped(kind_);
+    tracked_ = false;
+  }
+}
+
 } // namespace livekit
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace livekit {
+namespace detail {
+
+// Just enough of the protobuf wire format to classify a serialized FfiEvent
+// without parsing it: the event is a single oneof, so its first tag names
+// the member that is set.
+
+inline bool readWireVarint(const std::uint8_t *&p, const std::uint8_t *end,
+                           std::uint64_t &out) noexcept {
+  out = 0;
+  for (int shift = 0; p < end && shift < 64; shift += 7) {
+    const std::uint8_t byte = *p++;
+    out |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+struct WireField {
+  int number = 0;
+  const std::uint8_t *data = nullptr;
+  std::size_t size = 0;
+};
+
+// First field of `buf` if it is length-delimited (every FfiEvent member is
+// a message), with its payload bounds checked against `len`.
+inline bool peekFirstField(const std::uint8_t *buf, std::size_t len,
+                           WireField &field) noexcept {
+  const std::uint8_t *p = buf;
+  const std::uint8_t *end = buf + len;
+  std::uint64_t tag = 0;
+  std::uint64_t size = 0;
+  if (!readWireVarint(p, end, tag) || (tag & 7) != 2 ||
+      !readWireVarint(p, end, size) ||
+      size > static_cast<std::uint64_t>(end - p)) {
+    return false;
+  }
+  field.number = static_cast<int>(tag >> 3);
+  field.data = p;
+  field.size = static_cast<std::size_t>(size);
+  return true;
+}
+
+} // namespace detail
+} // namespace livekit
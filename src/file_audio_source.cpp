@@ -0,0 +1,292 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/file_audio_source.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "livekit/audio_frame.h"
+#include "livekit/audio_source.h"
+#include "mapped_file.h"
+#include "thread_util.h"
+
+namespace livekit {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kChunkMs = 10;
+// Played pages are released in steps of this many bytes.
+constexpr std::size_t kReleaseStep = 1 << 20;
+// Falling further behind than this (a stalled capture) restarts the pacing
+// clock instead of bursting to catch up.
+constexpr auto kMaxLag = std::chrono::milliseconds(200);
+
+std::uint16_t readU16(const std::uint8_t *p) {
+  return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+std::uint32_t readU32(const std::uint8_t *p) {
+  return static_cast<std::uint32_t>(p[0]) |
+         (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) |
+         (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+struct PcmLayout {
+  std::size_t offset = 0;
+  std::size_t size = 0;
+  int sample_rate = 0;
+  int num_channels = 0;
+};
+
+// Locates the fmt and data chunks of a RIFF/WAVE file.
+PcmLayout parseWav(const std::uint8_t *data, std::size_t size) {
+  PcmLayout layout;
+  bool have_fmt = false;
+  std::size_t pos = 12;
+  while (pos + 8 <= size) {
+    const std::uint8_t *chunk = data + pos;
+    const std::uint32_t chunk_size = readU32(chunk + 4);
+    const std::size_t body = pos + 8;
+    if (std::memcmp(chunk, "fmt ", 4) == 0) {
+      if (chunk_size < 16 || body + 16 > size) {
+        throw std::runtime_error("FileAudioSource: truncated fmt chunk");
+      }
+      const std::uint16_t format = readU16(data + body);
+      const std::uint16_t bits = readU16(data + body + 14);
+      // 1 = PCM, 0xFFFE = WAVE_FORMAT_EXTENSIBLE (checked by bit depth).
+      if ((format != 1 && format != 0xFFFE) || bits != 16) {
+        throw std::runtime_error("FileAudioSource: only 16-bit PCM WAV is "
+                                 "supported");
+      }
+      layout.num_channels = readU16(data + body + 2);
+      layout.sample_rate = static_cast<int>(readU32(data + body + 4));
+      have_fmt = true;
+    } else if (std::memcmp(chunk, "data", 4) == 0) {
+      if (!have_fmt) {
+        throw std::runtime_error(
+            "FileAudioSource: data chunk appeared before fmt chunk");
+      }
+      layout.offset = body;
+      // Streamed WAVs may carry a placeholder size; trust the file.
+      layout.size = std::min<std::size_t>(chunk_size, size - body);
+      return layout;
+    }
+    // Chunks are padded to an even size.
+    pos = body + chunk_size + (chunk_size & 1);
+  }
+  throw std::runtime_error("FileAudioSource: no data chunk in WAV file");
+}
+
+} // namespace
+
+FileAudioSource::FileAudioSource(const std::string &path)
+    : FileAudioSource(path, Options{}) {}
+
+FileAudioSource::FileAudioSource(const std::string &path,
+                                 const Options &options)
+    : FileAudioSource(path, nullptr, options) {}
+
+FileAudioSource::FileAudioSource(const std::string &path,
+                                 std::shared_ptr<AudioSource> source)
+    : FileAudioSource(path, std::move(source), Options{}) {}
+
+FileAudioSource::FileAudioSource(const std::string &path,
+                                 std::shared_ptr<AudioSource> source,
+                                 const Options &options)
+    : file_(std::make_unique<detail::MappedFile>(path)), options_(options),
+      source_(std::move(source)) {
+  const std::uint8_t *data = file_->data();
+  const std::size_t size = file_->size();
+  PcmLayout layout;
+  if (size >= 12 && std::memcmp(data, "RIFF", 4) == 0 &&
+      std::memcmp(data + 8, "WAVE", 4) == 0) {
+    layout = parseWav(data, size);
+  } else {
+    layout.size = size;
+    layout.sample_rate = options.raw_sample_rate;
+    layout.num_channels = options.raw_num_channels;
+  }
+  if (layout.sample_rate <= 0 || layout.num_channels <= 0) {
+    throw std::invalid_argument(
+        "FileAudioSource: sample rate and channel count must be positive");
+  }
+  if (layout.sample_rate % (1000 / kChunkMs) != 0) {
+    throw std::invalid_argument(
+        "FileAudioSource: sample rate must be a multiple of 100 Hz");
+  }
+  sample_rate_ = layout.sample_rate;
+  num_channels_ = layout.num_channels;
+  data_offset_ = layout.offset;
+  released_ = layout.offset;
+  samples_ = reinterpret_cast<const std::int16_t *>(data + layout.offset);
+  total_frames_ = layout.size / (sizeof(std::int16_t) * num_channels_);
+  if (!source_) {
+    source_ = std::make_shared<AudioSource>(sample_rate_, num_channels_);
+  } else if (source_->sample_rate() != sample_rate_ ||
+             source_->num_channels() != num_channels_) {
+    throw std::invalid_argument(
+        "FileAudioSource: source format does not match the file");
+  }
+}
+
+FileAudioSource::~FileAudioSource() { stop(); }
+
+std::chrono::microseconds FileAudioSource::duration() const noexcept {
+  return std::chrono::microseconds(total_frames_ * 1'000'000 /
+                                   static_cast<std::uint64_t>(sample_rate_));
+}
+
+std::chrono::microseconds FileAudioSource::position() const noexcept {
+  return std::chrono::microseconds(playhead_.load() * 1'000'000 /
+                                   static_cast<std::uint64_t>(sample_rate_));
+}
+
+void FileAudioSource::seek(std::chrono::microseconds position) {
+  const auto us = std::max<std::int64_t>(position.count(), 0);
+  const auto frame = static_cast<std::uint64_t>(us) *
+                     static_cast<std::uint64_t>(sample_rate_) / 1'000'000;
+  seek_to_.store(static_cast<std::int64_t>(std::min(frame, total_frames_)));
+}
+
+int FileAudioSource::readFrame(AudioFrame &frame) {
+  if (frame.num_channels() != num_channels_) {
+    throw std::invalid_argument(
+        "FileAudioSource::readFrame: channel count does not match the file");
+  }
+  std::uint64_t head = playhead_.load();
+  const std::int64_t target = seek_to_.exchange(-1);
+  if (target >= 0) {
+    head = static_cast<std::uint64_t>(target);
+    released_ = data_offset_ + head * num_channels_ * sizeof(std::int16_t);
+  }
+
+  std::int16_t *dst = frame.data().data();
+  const auto wanted = static_cast<std::uint64_t>(frame.samples_per_channel());
+  std::uint64_t done = 0;
+  int from_file = 0;
+  while (done < wanted) {
+    if (head >= total_frames_) {
+      if (!options_.loop || total_frames_ == 0) {
+        break;
+      }
+      // Hand back the tail before wrapping around.
+      file_->release(released_, file_->size() - released_);
+      head = 0;
+      released_ = data_offset_;
+    }
+    const std::uint64_t n = std::min(wanted - done, total_frames_ - head);
+    std::memcpy(dst + done * num_channels_, samples_ + head * num_channels_,
+                n * num_channels_ * sizeof(std::int16_t));
+    head += n;
+    done += n;
+    from_file += static_cast<int>(n);
+  }
+  if (done < wanted) {
+    std::memset(dst + done * num_channels_, 0,
+                (wanted - done) * num_channels_ * sizeof(std::int16_t));
+  }
+  playhead_.store(head);
+
+  const std::size_t offset =
+      data_offset_ + head * num_channels_ * sizeof(std::int16_t);
+  if (offset >= released_ + kReleaseStep) {
+    file_->release(released_, offset - released_);
+    released_ = offset;
+  }
+  return from_file;
+}
+
+void FileAudioSource::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (thread_.joinable()) {
+    if (playing_.load()) {
+      return;
+    }
+    // Playback ended by itself; reap the thread before restarting.
+    thread_.join();
+  }
+  stop_requested_ = false;
+  playing_.store(true);
+  thread_ = std::thread([this] {
+    detail::registerThread(ThreadRole::kAudio, "lk-file-audio");
+    run();
+  });
+}
+
+void FileAudioSource::stop() {
+  std::thread thread;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_requested_ = true;
+    thread = std::move(thread_);
+  }
+  cv_.notify_all();
+  if (thread.joinable()) {
+    // stop() from on_end runs on the playback thread itself.
+    if (thread.get_id() == std::this_thread::get_id()) {
+      thread.detach();
+    } else {
+      thread.join();
+    }
+  }
+  playing_.store(false);
+}
+
+void FileAudioSource::run() {
+  const int chunk = sample_rate_ * kChunkMs / 1000;
+  const auto interval = std::chrono::milliseconds(kChunkMs);
+  auto anchor = Clock::now();
+  std::int64_t sent = 0;
+  bool ended = false;
+  for (;;) {
+    AudioFrame frame = source_->acquireFrame(chunk);
+    const int read = readFrame(frame);
+    ended = read == 0;
+    if (!ended) {
+      try {
+        source_->captureFrame(frame);
+      } catch (const std::exception &) {
+        // The source is gone (e.g. SDK shut down); nothing more to play.
+        ended = true;
+      }
+    }
+    if (ended) {
+      break;
+    }
+    ++sent;
+    auto due = anchor + sent * interval;
+    const auto now = Clock::now();
+    if (now - due > kMaxLag) {
+      anchor = now - sent * interval;
+      due = now;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (cv_.wait_until(lock, due, [this] { return stop_requested_; })) {
+      return;
+    }
+  }
+  playing_.store(false);
+  if (options_.on_end) {
+    options_.on_end();
+  }
+}
+
+} // namespace livekit
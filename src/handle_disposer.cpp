@@ -0,0 +1,121 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "handle_disposer.h"
+
+#include <utility>
+
+#include "livekit_ffi.h"
+#include "thread_util.h"
+
+namespace livekit {
+namespace detail {
+
+HandleDisposer &HandleDisposer::instance() {
+  static HandleDisposer disposer;
+  return disposer;
+}
+
+HandleDisposer::~HandleDisposer() { stop(); }
+
+void HandleDisposer::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (thread_.joinable()) {
+    return;
+  }
+  stopping_ = false;
+  pending_.reserve(kBatchLimit);
+  thread_ = std::thread([this] {
+    detail::registerThread(ThreadRole::kBackground, "lk-disposer");
+    run();
+  });
+  running_.store(true, std::memory_order_release);
+}
+
+void HandleDisposer::stop() {
+  std::thread thread;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!thread_.joinable()) {
+      return;
+    }
+    // New handles go straight to the FFI from here on; run() drains the
+    // rest before exiting.
+    running_.store(false, std::memory_order_release);
+    stopping_ = true;
+    thread = std::move(thread_);
+  }
+  cv_.notify_all();
+  thread.join();
+}
+
+bool HandleDisposer::defer(std::uintptr_t handle) noexcept {
+  if (!running_.load(std::memory_order_acquire)) {
+    return false; // the common case when disabled: no lock
+  }
+  bool wake = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_ || !running_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    try {
+      pending_.push_back(handle);
+    } catch (...) {
+      return false;
+    }
+    // One wakeup per batch: when the queue starts filling, and when it is
+    // worth draining early.
+    wake = pending_.size() == 1 || pending_.size() == kBatchLimit;
+  }
+  deferred_.fetch_add(1, std::memory_order_relaxed);
+  if (wake) {
+    cv_.notify_one();
+  }
+  return true;
+}
+
+void HandleDisposer::run() {
+  std::vector<std::uintptr_t> batch;
+  batch.reserve(kBatchLimit);
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+    if (!stopping_) {
+      // Let more handles gather unless the batch is already full.
+      cv_.wait_for(lock, kBatchWindow, [this] {
+        return stopping_ || pending_.size() >= kBatchLimit;
+      });
+    }
+    batch.swap(pending_);
+    const bool done = stopping_;
+    lock.unlock();
+    for (std::uintptr_t handle : batch) {
+      livekit_ffi_drop_handle(handle);
+    }
+    if (!batch.empty()) {
+      batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+    batch.clear();
+    lock.lock();
+    if (done && pending_.empty()) {
+      return;
+    }
+  }
+}
+
+} // namespace detail
+} // namespace livekit
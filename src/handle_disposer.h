@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+// Background disposal of FfiHandle::Disposal::kDeferrable handles (frame,
+// data and response buffers), enabled by
+// InitializeOptions::deferred_handle_disposal. Releasing a buffer then
+// costs a push under a short lock on the FFI callback or consumer thread;
+// the disposer thread drops whatever has gathered, at most every
+// kBatchWindow, in one pass.
+class HandleDisposer {
+public:
+  static constexpr std::size_t kBatchLimit = 256;
+  static constexpr std::chrono::milliseconds kBatchWindow{2};
+
+  static HandleDisposer &instance();
+
+  ~HandleDisposer();
+
+  // Idempotent.
+  void start();
+  // Drops everything still queued and joins the thread. Handles released
+  // afterwards are dropped immediately.
+  void stop();
+
+  bool running() const noexcept {
+    return running_.load(std::memory_order_acquire);
+  }
+
+  // Queue `handle` for disposal. False if the disposer is not running or
+  // the queue cannot grow; the caller then drops it itself.
+  bool defer(std::uintptr_t handle) noexcept;
+
+  std::uint64_t deferredCount() const noexcept {
+    return deferred_.load(std::memory_order_relaxed);
+  }
+  std::uint64_t batchCount() const noexcept {
+    return batches_.load(std::memory_order_relaxed);
+  }
+
+private:
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::uintptr_t> pending_;
+  bool stopping_{false};
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+
+  std::atomic<std::uint64_t> deferred_{0};
+  std::atomic<std::uint64_t> batches_{0};
+};
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the “License”);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "latency_trace.h"
+
+#include <functional>
+#include <thread>
+
+namespace livekit {
+namespace detail {
+
+std::atomic<bool> g_latency_tracing{false};
+
+namespace {
+
+std::int64_t sinceEpochUs(TraceClock::time_point t) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             t.time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+const char *traceStageName(TraceStage stage) noexcept {
+  switch (stage) {
+  case TraceStage::kCapture:
+    return "capture";
+  case TraceStage::kCaptureQueue:
+    return "capture_queue";
+  case TraceStage::kReceiveConvert:
+    return "receive_convert";
+  case TraceStage::kReceiveQueue:
+    return "receive_queue";
+  case TraceStage::kReceiveTotal:
+    return "receive_total";
+  }
+  return "unknown";
+}
+
+LatencyTracer::LatencyTracer() : spans_(kMaxSpans) {}
+
+LatencyTracer &LatencyTracer::instance() {
+  static LatencyTracer tracer;
+  return tracer;
+}
+
+void LatencyTracer::record(TraceMedia media, TraceStage stage,
+                           TraceClock::time_point begin,
+                           TraceClock::time_point end,
+                           std::int64_t frame_timestamp_us) noexcept {
+  const auto duration =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+  const auto i = static_cast<std::size_t>(stage);
+  (media == TraceMedia::kAudio ? audio_ : video_)[i].record(duration);
+
+  const Span span{sinceEpochUs(begin), duration.count(), frame_timestamp_us,
+                  static_cast<std::uint32_t>(
+                      std::hash<std::thread::id>{}(std::this_thread::get_id())),
+                  media, stage};
+  std::lock_guard<std::mutex> lock(mutex_);
+  spans_[next_] = span;
+  next_ = (next_ + 1) % kMaxSpans;
+  if (count_ < kMaxSpans) {
+    ++count_;
+  }
+}
+
+LatencyTraceReport LatencyTracer::report() const {
+  LatencyTraceReport out;
+  for (std::size_t i = 0; i < kTraceStageCount; ++i) {
+    out.audio[i] = audio_[i].snapshot();
+    out.video[i] = video_[i].snapshot();
+  }
+  return out;
+}
+
+std::string LatencyTracer::toChromeJson() const {
+  std::vector<Span> spans;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Oldest first, starting count_ slots behind the write position.
+    spans.reserve(count_);
+    std::size_t i = (next_ + kMaxSpans - count_) % kMaxSpans;
+    for (std::size_t n = 0; n < count_; ++n) {
+      spans.push_back(spans_[i]);
+      i = (i + 1) % kMaxSpans;
+    }
+  }
+
+  std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  out.reserve(out.size() + spans.size() * 160);
+  bool first = true;
+  for (const auto &span : spans) {
+    if (!first) {
+      out += ',';
+    }
+    first = false;
+    out += "{\"name\":\"";
+    out += span.media == TraceMedia::kAudio ? "audio." : "video.";
+    out += traceStageName(span.stage);
+    out += "\",\"cat\":\"livekit\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+    out += std::to_string(span.thread);
+    out += ",\"ts\":";
+    out += std::to_string(span.begin_us);
+    out += ",\"dur\":";
+    out += std::to_string(span.duration_us);
+    if (span.frame_timestamp_us != 0) {
+      out += ",\"args\":{\"frame_timestamp_us\":";
+      out += std::to_string(span.frame_timestamp_us);
+      out += '}';
+    }
+    out += '}';
+  }
+  out += "]}";
+  return out;
+}
+
+void LatencyTracer::reset() {
+  for (std::size_t i = 0; i < kTraceStageCount; ++i) {
+    audio_[i].reset();
+    video_[i].reset();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  next_ = 0;
+  count_ = 0;
+}
+
+} // namespace detail
+
+void setLatencyTracingEnabled(bool enabled) {
+  detail::g_latency_tracing.store(enabled, std::memory_order_relaxed);
+}
+
+bool latencyTracingEnabled() { return detail::tracingOn(); }
+
+LatencyTraceReport latencyTraceReport() {
+  return detail::LatencyTracer::instance().report();
+}
+
+std::string latencyTraceToChromeJson() {
+  return detail::LatencyTracer::instance().toChromeJson();
+}
+
+void resetLatencyTrace() { detail::LatencyTracer::instance().reset(); }
+
+} // namespace livekit
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the “License”);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/latency_trace.h"
+#include "rpc_metrics.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+extern std::atomic<bool> g_latency_tracing;
+
+// Trace points check this before reading the clock.
+inline bool tracingOn() noexcept {
+  return g_latency_tracing.load(std::memory_order_relaxed);
+}
+
+using TraceClock = std::chrono::steady_clock;
+
+// "capture", "receive_queue", ...: the label used in every export.
+const char *traceStageName(TraceStage stage) noexcept;
+
+// Process-wide sink for trace spans: per-stage histograms plus a ring of the
+// most recent spans for the Chrome trace export.
+class LatencyTracer {
+public:
+  static constexpr std::size_t kMaxSpans = 16384;
+
+  static LatencyTracer &instance();
+
+  // `frame_timestamp_us` is the frame's capture timestamp, 0 if unknown.
+  // Never allocates: the span ring is sized once, up front.
+  void record(TraceMedia media, TraceStage stage, TraceClock::time_point begin,
+              TraceClock::time_point end,
+              std::int64_t frame_timestamp_us = 0) noexcept;
+
+  LatencyTraceReport report() const;
+  std::string toChromeJson() const;
+  void reset();
+
+private:
+  LatencyTracer();
+
+  struct Span {
+    std::int64_t begin_us;
+    std::int64_t duration_us;
+    std::int64_t frame_timestamp_us;
+    std::uint32_t thread;
+    TraceMedia media;
+    TraceStage stage;
+  };
+
+  LatencyHistogram audio_[kTraceStageCount];
+  LatencyHistogram video_[kTraceStageCount];
+
+  mutable std::mutex mutex_;
+  std::vector<Span> spans_; // kMaxSpans slots, written as a ring
+  std::size_t next_ = 0;    // slot the next span goes to
+  std::size_t count_ = 0;   // slots holding a span, up to kMaxSpans
+};
+
+// Times one stage from construction to destruction, if tracing was on at
+// construction.
+class TraceSpan {
+public:
+  TraceSpan(TraceMedia media, TraceStage stage,
+            std::int64_t frame_timestamp_us = 0) noexcept
+      : media_(media), stage_(stage), frame_timestamp_us_(frame_timestamp_us),
+        active_(tracingOn()) {
+    if (active_) {
+      begin_ = TraceClock::now();
+    }
+  }
+  ~TraceSpan() {
+    if (active_) {
+      LatencyTracer::instance().record(media_, stage_, begin_,
+                                       TraceClock::now(), frame_timestamp_us_);
+    }
+  }
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+  TraceMedia media_;
+  TraceStage stage_;
+  std::int64_t frame_timestamp_us_;
+  bool active_;
+  TraceClock::time_point begin_{};
+};
+
+} // namespace detail
+} // namespace livekit
@@ -16,17 +16,238 @@
 
 #include "livekit/livekit.h"
 #include "ffi_client.h"
+#include "handle_disposer.h"
+#include "log.h"
+
+#include <cstdlib>
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#endif
 
 namespace livekit {
 
+namespace {
+
+// A prewarm worker and the flag it sets as its last step, so finished
+// workers can be joined without blocking.
+struct PrewarmWorker {
+  std::thread thread;
+  std::shared_ptr<std::atomic<bool>> finished;
+};
+
+std::mutex g_prewarm_mutex;
+std::vector<PrewarmWorker> g_prewarm_threads;
+
+struct HostPort {
+  std::string host;
+  std::string port;
+};
+
+// "wss://host:port/path" -> {host, port}; the port defaults by scheme.
+HostPort splitUrl(const std::string &url) {
+  HostPort out;
+  std::string rest = url;
+  bool secure = true;
+  const auto scheme_end = rest.find("://");
+  if (scheme_end != std::string::npos) {
+    const std::string scheme = rest.substr(0, scheme_end);
+    secure = scheme != "ws" && scheme != "http";
+    rest = rest.substr(scheme_end + 3);
+  }
+  rest = rest.substr(0, rest.find_first_of("/?#"));
+  if (!rest.empty() && rest.front() == '[') {
+    // IPv6 literal: [addr]:port
+    const auto close = rest.find(']');
+    out.host = rest.substr(1, close == std::string::npos ? close : close - 1);
+    if (close != std::string::npos && close + 1 < rest.size() &&
+        rest[close + 1] == ':') {
+      out.port = rest.substr(close + 2);
+    }
+  } else {
+    const auto colon = rest.rfind(':');
+    out.host = rest.substr(0, colon);
+    if (colon != std::string::npos) {
+      out.port = rest.substr(colon + 1);
+    }
+  }
+  if (out.port.empty()) {
+    out.port = secure ? "443" : "80";
+  }
+  return out;
+}
+
+void resolveHost(const std::string &url) {
+  const HostPort target = splitUrl(url);
+  if (target.host.empty()) {
+    std::cerr << "livekit::prewarm: no host in url " << url << std::endl;
+    return;
+  }
+#ifdef _WIN32
+  WSADATA wsa;
+  if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+    return;
+  }
+#endif
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *result = nullptr;
+  const int rc = getaddrinfo(target.host.c_str(), target.port.c_str(), &hints,
+                             &result);
+  if (rc != 0) {
+    std::cerr << "livekit::prewarm: could not resolve " << target.host
+              << std::endl;
+  } else {
+    freeaddrinfo(result);
+  }
+#ifdef _WIN32
+  WSACleanup();
+#endif
+}
+
+// The WebRTC peer-connection factory and its signaling/worker threads are
+// created on first use; a throwaway track forces that now.
+void warmMediaEngine() {
+  auto source = std::make_shared<VideoSource>(16, 16);
+  auto track =
+      LocalVideoTrack::createLocalVideoTrack("livekit-prewarm", source);
+}
+
+void runPrewarm(const std::string &url) {
+  if (!url.empty()) {
+    resolveHost(url);
+  }
+  try {
+    warmMediaEngine();
+  } catch (const std::exception &e) {
+    std::cerr << "livekit::prewarm: media warm-up failed: " << e.what()
+              << std::endl;
+  }
+}
+
+void joinPrewarmThreads() {
+  std::vector<PrewarmWorker> workers;
+  {
+    std::lock_guard<std::mutex> lock(g_prewarm_mutex);
+    workers.swap(g_prewarm_threads);
+  }
+  for (auto &w : workers) {
+    if (w.thread.joinable()) {
+      w.thread.join();
+    }
+  }
+}
+
+// Join workers that are done so repeated prewarm() calls do not pile up
+// threads until shutdown(). Requires g_prewarm_mutex.
+void reapFinishedPrewarmThreadsLocked() {
+  auto it = g_prewarm_threads.begin();
+  while (it != g_prewarm_threads.end()) {
+    if (it->finished->load(std::memory_order_acquire)) {
+      it->thread.join();
+      it = g_prewarm_threads.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+// The Rust logger reads RUST_LOG once, when the FFI initializes, and drops
+// filtered records before they are serialized. An explicit RUST_LOG in the
+// environment wins.
+void pushLogFilterToFfi(const LogOptions &options) {
+  if (std::getenv("RUST_LOG") != nullptr) {
+    return;
+  }
+  const std::string filter = detail::rustLogFilter(options);
+#ifdef _WIN32
+  _putenv_s("RUST_LOG", filter.c_str());
+#else
+  setenv("RUST_LOG", filter.c_str(), /*overwrite=*/0);
+#endif
+}
+
+} // namespace
+
 bool initialize(LogSink log_sink) {
+  return initialize(log_sink, EventDispatchOptions{});
+}
+
+bool initialize(LogSink log_sink, const EventDispatchOptions &dispatch) {
+  InitializeOptions options;
+  options.log_sink = log_sink;
+  options.dispatch = dispatch;
+  return initialize(options);
+}
+
+bool initialize(const InitializeOptions &options) {
   auto &ffi_client = FfiClient::instance();
-  return ffi_client.initialize(log_sink == LogSink::kCallback);
+  if (ffi_client.isInitialized()) {
+    return false;
+  }
+  if (options.logging) {
+    configureLogging(*options.logging);
+    if (options.log_sink == LogSink::kCallback &&
+        options.logging->push_down_to_ffi) {
+      pushLogFilterToFfi(*options.logging);
+    }
+  }
+  configureThreads(options.threads);
+  detail::startLogging();
+  if (!ffi_client.initialize(options.log_sink == LogSink::kCallback,
+                             options.dispatch, options.background)) {
+    return false;
+  }
+  if (options.deferred_handle_disposal) {
+    detail::HandleDisposer::instance().start();
+  }
+  if (options.prewarm_media) {
+    (void)prewarm(std::string());
+  }
+  return true;
+}
+
+std::future<void> prewarm(const std::string &url) {
+  if (!FfiClient::instance().isInitialized()) {
+    throw std::runtime_error("livekit::prewarm: SDK is not initialized");
+  }
+  auto done = std::make_shared<std::promise<void>>();
+  std::future<void> future = done->get_future();
+  auto finished = std::make_shared<std::atomic<bool>>(false);
+  std::thread worker([url, done, finished] {
+    runPrewarm(url);
+    done->set_value();
+    finished->store(true, std::memory_order_release);
+  });
+  std::lock_guard<std::mutex> lock(g_prewarm_mutex);
+  reapFinishedPrewarmThreadsLocked();
+  g_prewarm_threads.push_back({std::move(worker), std::move(finished)});
+  return future;
 }
 
 void shutdown() {
+  // A prewarm still talking to the FFI must finish before it is disposed.
+  joinPrewarmThreads();
+  // Queued buffers are dropped while the FFI is still up.
+  detail::HandleDisposer::instance().stop();
   auto &ffi_client = FfiClient::instance();
   ffi_client.shutdown();
+  // Last, so records the FFI emits while disposing are still written.
+  detail::stopLogging();
 }
 
-} // namespace livekit
\ No newline at end of file
+} // namespace livekit
@@ -40,7 +40,8 @@ std::shared_ptr<LocalAudioTrack> LocalAudioTrack::createLocalAudioTrack(
 
   proto::FfiResponse resp = FfiClient::instance().sendRequest(req);
   const proto::OwnedTrack &owned = resp.create_audio_track().track();
-  FfiHandle handle(static_cast<uintptr_t>(owned.handle().id()));
+  FfiHandle handle(static_cast<uintptr_t>(owned.handle().id()),
+                   ResourceKind::kTrack);
   return std::shared_ptr<LocalAudioTrack>(
       new LocalAudioTrack(std::move(handle), owned));
 }
@@ -21,15 +21,27 @@
 #include "livekit/room_delegate.h"
 #include "livekit/track.h"
 
+#include "data_send_queue.h"
 #include "ffi.pb.h"
 #include "ffi_client.h"
+#include "mapped_file.h"
 #include "participant.pb.h"
+#include "random_id.h"
 #include "room.pb.h"
 #include "room_proto_converter.h"
+#include "rpc_envelope.h"
+#include "rpc_metrics.h"
+#include "sdk_metrics.h"
+#include "task_pool.h"
 #include "track.pb.h"
 #include "track_proto_converter.h"
+#include "transcription_batcher.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <iostream>
+#include <optional>
 #include <stdexcept>
 
 namespace livekit {
@@ -37,36 +49,408 @@ namespace livekit {
 using proto::FfiRequest;
 using proto::FfiResponse;
 
+namespace {
+
+// Consumed mapping ranges are handed back to the OS in steps of this size.
+constexpr std::size_t kFileReleaseStep = 1 << 20; // 1 MiB
+
+std::string fileNameOf(const std::string &path) {
+  const auto pos = path.find_last_of("/\\");
+  return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+} // namespace
+
 LocalParticipant::LocalParticipant(
     FfiHandle handle, std::string sid, std::string name, std::string identity,
-    std::string metadata,
-    std::unordered_map<std::string, std::string> attributes,
-    ParticipantKind kind, DisconnectReason reason)
+    std::string metadata, AttributeMap attributes, ParticipantKind kind,
+    DisconnectReason reason)
     : Participant(std::move(handle), std::move(sid), std::move(name),
                   std::move(identity), std::move(metadata),
-                  std::move(attributes), kind, reason) {}
+                  std::move(attributes), kind, reason),
+      track_publications_(std::make_shared<const PublicationMap>()),
+      send_queue_(
+          std::make_shared<detail::DataSendQueue>(DataSendOptions{})),
+      transcriptions_(std::make_unique<detail::TranscriptionBatcher>(
+          [handle = static_cast<std::uint64_t>(ffiHandleId())](
+              const std::string &identity, const std::string &track_sid,
+              const std::vector<TranscriptionSegment> &segments) {
+            return FfiClient::instance().publishTranscriptionAsync(
+                handle, identity, track_sid, segments);
+          },
+          TranscriptionOptions{})) {}
+
+LocalParticipant::~LocalParticipant() {
+  send_queue_->stop();
+  transcriptions_->stop();
+}
+
+std::shared_ptr<const LocalParticipant::PublicationMap>
+LocalParticipant::trackPublicationsSnapshot() const {
+  return std::atomic_load(&track_publications_);
+}
+
+std::shared_ptr<LocalTrackPublication>
+LocalParticipant::trackPublication(const std::string &sid) const {
+  const auto snapshot = trackPublicationsSnapshot();
+  auto it = snapshot->find(sid);
+  return it == snapshot->end() ? nullptr : it->second;
+}
+
+void LocalParticipant::storePublication(
+    std::shared_ptr<LocalTrackPublication> publication) {
+  std::lock_guard<std::mutex> g(publications_write_mutex_);
+  auto next = std::make_shared<PublicationMap>(*track_publications_);
+  const std::string sid = publication->sid();
+  (*next)[sid] = std::move(publication);
+  std::atomic_store(&track_publications_,
+                    std::shared_ptr<const PublicationMap>(std::move(next)));
+}
+
+void LocalParticipant::erasePublication(const std::string &sid) {
+  std::lock_guard<std::mutex> g(publications_write_mutex_);
+  if (track_publications_->find(sid) == track_publications_->end()) {
+    return;
+  }
+  auto next = std::make_shared<PublicationMap>(*track_publications_);
+  next->erase(sid);
+  std::atomic_store(&track_publications_,
+                    std::shared_ptr<const PublicationMap>(std::move(next)));
+}
 
 void LocalParticipant::publishData(
     const std::vector<std::uint8_t> &payload, bool reliable,
     const std::vector<std::string> &destination_identities,
-    const std::string &topic) {
+    const std::string &topic, DataPriority priority) {
   if (payload.empty()) {
     return;
   }
+  // Use async FFI API and block until completion.
+  publishDataAsync(payload, reliable, destination_identities, topic, priority)
+      .get();
+}
 
+void LocalParticipant::publishData(
+    const std::uint8_t *data, std::size_t size, bool reliable,
+    const std::vector<std::string> &destination_identities,
+    const std::string &topic, DataPriority priority) {
+  if (size == 0) {
+    return;
+  }
+  if (data == nullptr) {
+    throw std::invalid_argument("LocalParticipant::publishData: null data");
+  }
   auto handle_id = ffiHandleId();
   if (handle_id == 0) {
     throw std::runtime_error(
         "LocalParticipant::publishData: invalid FFI handle");
   }
+  if (reliable) {
+    publishReliable(static_cast<std::uint64_t>(handle_id), data, size,
+                    destination_identities, topic, priority, nullptr)
+        .get();
+    return;
+  }
+  FfiClient::instance()
+      .publishDataAsync(static_cast<std::uint64_t>(handle_id), data,
+                        static_cast<std::uint64_t>(size), false,
+                        destination_identities, topic)
+      .get();
+}
 
-  // Use async FFI API and block until completion.
-  auto fut = FfiClient::instance().publishDataAsync(
-      static_cast<std::uint64_t>(handle_id), payload.data(),
-      static_cast<std::uint64_t>(payload.size()), reliable,
-      destination_identities, topic);
+void LocalParticipant::publishLossyData(
+    const std::uint8_t *data, std::size_t size,
+    const std::vector<std::string> &destination_identities,
+    const std::string &topic) {
+  if (size == 0) {
+    return;
+  }
+  if (data == nullptr) {
+    throw std::invalid_argument(
+        "LocalParticipant::publishLossyData: null data");
+  }
+  const DataPacketView packet{data, size, topic};
+  publishDataBatch({packet}, /*reliable=*/false, destination_identities);
+}
 
-  fut.get();
+void LocalParticipant::publishDataBatch(
+    const std::vector<DataPacketView> &packets, bool reliable,
+    const std::vector<std::string> &destination_identities,
+    DataPriority priority) {
+  if (packets.empty()) {
+    return;
+  }
+  for (const auto &packet : packets) {
+    if (packet.size > 0 && packet.data == nullptr) {
+      throw std::invalid_argument(
+          "LocalParticipant::publishDataBatch: null data");
+    }
+  }
+  auto handle_id = ffiHandleId();
+  if (handle_id == 0) {
+    throw std::runtime_error(
+        "LocalParticipant::publishDataBatch: invalid FFI handle");
+  }
+  const auto handle = static_cast<std::uint64_t>(handle_id);
+
+  if (!reliable) {
+    FfiClient::instance().publishDataBatch(handle, packets.data(),
+                                           packets.size(), false,
+                                           destination_identities, nullptr);
+    return;
+  }
+
+  // The send queue admits, orders and copies one contiguous payload per
+  // entry, so the batch is joined and takes a single ticket and entry; the
+  // sender splits it back into packets for one publishDataBatch() pass.
+  std::vector<std::uint8_t> joined;
+  std::vector<std::size_t> sizes;
+  std::vector<std::string> topics;
+  for (const auto &packet : packets) {
+    if (packet.size == 0) {
+      continue;
+    }
+    joined.insert(joined.end(), packet.data, packet.data + packet.size);
+    sizes.push_back(packet.size);
+    topics.push_back(packet.topic);
+  }
+  if (sizes.empty()) {
+    return;
+  }
+
+  auto &client = FfiClient::instance();
+  auto ticket = send_queue_->ticket(joined.size());
+  std::vector<FfiClient::AsyncId> async_ids(sizes.size());
+  std::vector<std::future<void>> acks;
+  acks.reserve(sizes.size());
+  for (auto &async_id : async_ids) {
+    acks.push_back(client.expectPublishData(&async_id, ticket));
+  }
+
+  std::exception_ptr error;
+  try {
+    send_queue_->submit(
+        priority, ticket, joined.data(), joined.size(),
+        [handle, destination_identities, sizes, topics = std::move(topics),
+         async_ids](const std::uint8_t *bytes, std::size_t) {
+          std::vector<DataPacketView> views;
+          views.reserve(sizes.size());
+          for (std::size_t i = 0; i < sizes.size(); ++i) {
+            views.push_back({bytes, sizes[i], topics[i]});
+            bytes += sizes[i];
+          }
+          FfiClient::instance().publishDataBatch(
+              handle, views.data(), views.size(), true,
+              destination_identities, nullptr, async_ids.data());
+        },
+        [async_ids] {
+          for (const auto async_id : async_ids) {
+            FfiClient::instance().cancelPendingByAsyncId(async_id);
+          }
+        });
+  } catch (...) {
+    error = std::current_exception();
+  }
+  // Wait for everything that was sent, even after a failure, so no
+  // completion outlives the call.
+  for (auto &ack : acks) {
+    try {
+      ack.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+AsyncOperation<void> LocalParticipant::publishDataAsync(
+    const std::vector<std::uint8_t> &payload, bool reliable,
+    const std::vector<std::string> &destination_identities,
+    const std::string &topic, DataPriority priority) {
+  if (payload.empty()) {
+    std::promise<void> done;
+    done.set_value();
+    return AsyncOperation<void>(done.get_future(), 0);
+  }
+
+  auto handle_id = ffiHandleId();
+  if (handle_id == 0) {
+    throw std::runtime_error(
+        "LocalParticipant::publishData: invalid FFI handle");
+  }
+
+  FfiClient::AsyncId async_id = 0;
+  std::future<void> fut;
+  if (reliable) {
+    fut = publishReliable(static_cast<std::uint64_t>(handle_id),
+                          payload.data(), payload.size(),
+                          destination_identities, topic, priority, &async_id);
+  } else {
+    fut = FfiClient::instance().publishDataAsync(
+        static_cast<std::uint64_t>(handle_id), payload.data(),
+        static_cast<std::uint64_t>(payload.size()), false,
+        destination_identities, topic, &async_id);
+  }
+  return AsyncOperation<void>(std::move(fut), async_id);
+}
+
+std::future<void> LocalParticipant::publishReliable(
+    std::uint64_t handle, const std::uint8_t *data, std::size_t size,
+    const std::vector<std::string> &destination_identities,
+    const std::string &topic, DataPriority priority,
+    std::uint64_t *async_id_out) {
+  auto &client = FfiClient::instance();
+  auto ticket = send_queue_->ticket(size);
+  FfiClient::AsyncId async_id = 0;
+  auto fut = client.expectPublishData(&async_id, ticket);
+  send_queue_->submit(
+      priority, ticket, data, size,
+      [handle, destination_identities, topic,
+       async_id](const std::uint8_t *bytes, std::size_t n) {
+        FfiClient::instance().sendPublishData(handle, bytes, n, true,
+                                              destination_identities, topic,
+                                              async_id);
+      },
+      [async_id] { FfiClient::instance().cancelPendingByAsyncId(async_id); });
+  if (async_id_out) {
+    *async_id_out = async_id;
+  }
+  return fut;
+}
+
+std::future<void> LocalParticipant::sendStreamChunk(
+    const std::string &stream_id, std::uint64_t chunk_index,
+    const std::uint8_t *data, std::size_t size,
+    const std::vector<std::string> &destination_identities,
+    const std::string &sender_identity, DataPriority priority) {
+  const auto handle = static_cast<std::uint64_t>(ffiHandleId());
+  auto ticket = send_queue_->ticket(size);
+  FfiClient::AsyncId async_id = 0;
+  auto fut = FfiClient::instance().expectStreamChunk(&async_id, ticket);
+  send_queue_->submit(
+      priority, ticket, data, size,
+      [handle, stream_id, chunk_index, destination_identities, sender_identity,
+       async_id](const std::uint8_t *bytes, std::size_t n) {
+        FfiClient::instance().sendStreamChunk(
+            handle, stream_id, chunk_index, bytes, n, destination_identities,
+            sender_identity, async_id);
+      },
+      [async_id] { FfiClient::instance().cancelPendingByAsyncId(async_id); });
+  return fut;
+}
+
+void LocalParticipant::setDataSendOptions(const DataSendOptions &options) {
+  send_queue_->configure(options);
+}
+
+DataSendStats LocalParticipant::dataSendStats() const {
+  return send_queue_->stats();
+}
+
+void LocalParticipant::onDataChannelThreshold(DataPacketKind kind,
+                                              std::uint64_t threshold) {
+  if (kind == DataPacketKind::Reliable) {
+    send_queue_->setChannelThreshold(static_cast<std::size_t>(threshold));
+  }
+}
+
+std::vector<ByteStreamInfo>
+LocalParticipant::sendFile(const std::string &path,
+                           const SendFileOptions &options) {
+  detail::MappedFile file(path);
+  const std::size_t total = file.size();
+  const std::size_t chunks = (total + kStreamChunkSize - 1) / kStreamChunkSize;
+
+  // Chunk-aligned contiguous slices; never more stripes than chunks.
+  std::size_t stripes = std::max<std::size_t>(1, options.num_streams);
+  stripes = std::min(stripes, std::max<std::size_t>(1, chunks));
+  const std::size_t chunks_per_stripe =
+      std::max<std::size_t>(1, (chunks + stripes - 1) / stripes);
+  const std::size_t stripe_bytes = chunks_per_stripe * kStreamChunkSize;
+  if (chunks > 0) {
+    stripes = (chunks + chunks_per_stripe - 1) / chunks_per_stripe;
+  }
+
+  const std::string name =
+      options.name.empty() ? fileNameOf(path) : options.name;
+  const std::string transfer_id = stripes > 1 ? generateRandomId() : "";
+
+  struct Stripe {
+    std::unique_ptr<ByteStreamWriter> writer;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t offset;   // next byte to send
+    std::size_t released; // bytes handed back to the OS
+  };
+  std::vector<Stripe> active;
+  active.reserve(stripes);
+  for (std::size_t i = 0; i < stripes; ++i) {
+    const std::size_t begin = std::min(total, i * stripe_bytes);
+    const std::size_t end = std::min(total, begin + stripe_bytes);
+    auto attributes = options.attributes;
+    if (stripes > 1) {
+      attributes[kStripeTransferIdAttribute] = transfer_id;
+      attributes[kStripeIndexAttribute] = std::to_string(i);
+      attributes[kStripeCountAttribute] = std::to_string(stripes);
+      attributes[kStripeOffsetAttribute] = std::to_string(begin);
+      attributes[kStripeTotalSizeAttribute] = std::to_string(total);
+    }
+    auto writer = std::make_unique<ByteStreamWriter>(
+        *this, name, options.topic, attributes, /*stream_id=*/"",
+        end - begin, options.mime_type, options.destination_identities);
+    writer->setMaxInFlightChunks(options.max_in_flight_chunks);
+    active.push_back(Stripe{std::move(writer), begin, end, begin, begin});
+  }
+
+  try {
+    // Round-robin one chunk per stream so every window stays busy from a
+    // single thread. write() returns once the chunk has been copied into its
+    // request, so the pages behind each cursor can be dropped right away.
+    bool pending = true;
+    while (pending) {
+      pending = false;
+      for (auto &stripe : active) {
+        if (stripe.offset >= stripe.end) {
+          continue;
+        }
+        const std::size_t n =
+            std::min(kStreamChunkSize, stripe.end - stripe.offset);
+        stripe.writer->write(file.data() + stripe.offset, n);
+        stripe.offset += n;
+        if (stripe.offset - stripe.released >= kFileReleaseStep ||
+            stripe.offset == stripe.end) {
+          file.release(stripe.released, stripe.offset - stripe.released);
+          stripe.released = stripe.offset;
+        }
+        pending = pending || stripe.offset < stripe.end;
+      }
+    }
+    for (auto &stripe : active) {
+      stripe.writer->close();
+    }
+  } catch (...) {
+    for (auto &stripe : active) {
+      if (!stripe.writer->isClosed()) {
+        try {
+          stripe.writer->close("sendFile failed");
+        } catch (...) {
+          // Already reporting the first failure.
+        }
+      }
+    }
+    throw;
+  }
+
+  std::vector<ByteStreamInfo> infos;
+  infos.reserve(active.size());
+  for (const auto &stripe : active) {
+    infos.push_back(stripe.writer->info());
+  }
+  return infos;
 }
 
 void LocalParticipant::publishDtmf(int code, const std::string &digit) {
@@ -85,6 +469,30 @@ void LocalParticipant::publishDtmf(int code, const std::string &digit) {
   fut.get();
 }
 
+void LocalParticipant::publishTranscription(
+    const std::string &track_sid,
+    const std::vector<TranscriptionSegment> &segments,
+    const std::string &participant_identity) {
+  if (ffiHandleId() == 0) {
+    throw std::runtime_error(
+        "LocalParticipant::publishTranscription: invalid FFI handle");
+  }
+  transcriptions_->publish(
+      participant_identity.empty() ? identity() : participant_identity,
+      track_sid, segments);
+}
+
+void LocalParticipant::flushTranscriptions() { transcriptions_->flush(); }
+
+void LocalParticipant::setTranscriptionOptions(
+    const TranscriptionOptions &options) {
+  transcriptions_->configure(options);
+}
+
+TranscriptionStats LocalParticipant::transcriptionStats() const {
+  return transcriptions_->stats();
+}
+
 void LocalParticipant::setMetadata(const std::string &metadata) {
   auto handle_id = ffiHandleId();
   if (handle_id == 0) {
@@ -113,8 +521,7 @@ void LocalParticipant::setName(const std::string &name) {
   (void)FfiClient::instance().sendRequest(req);
 }
 
-void LocalParticipant::setAttributes(
-    const std::unordered_map<std::string, std::string> &attributes) {
+void LocalParticipant::setAttributes(const AttributeMap &attributes) {
   auto handle_id = ffiHandleId();
   if (handle_id == 0) {
     throw std::runtime_error(
@@ -135,6 +542,45 @@ void LocalParticipant::setAttributes(
   (void)FfiClient::instance().sendRequest(req);
 }
 
+void LocalParticipant::updateAttributes(
+    const AttributeMap &changed, const std::vector<std::string> &removed) {
+  if (changed.empty() && removed.empty()) {
+    return;
+  }
+  auto handle_id = ffiHandleId();
+  if (handle_id == 0) {
+    throw std::runtime_error(
+        "LocalParticipant::updateAttributes: invalid FFI handle");
+  }
+
+  // The server merges SetLocalAttributes into the current set and treats an
+  // empty value as a delete, so a delta is just a shorter request.
+  FfiRequest req;
+  auto *msg = req.mutable_set_local_attributes();
+  msg->set_local_participant_handle(static_cast<std::uint64_t>(handle_id));
+
+  for (const auto &kv : changed) {
+    if (kv.first.empty() || kv.second.empty()) {
+      throw std::invalid_argument("LocalParticipant::updateAttributes: empty "
+                                  "key or value in changed attributes");
+    }
+    auto *entry = msg->add_attributes();
+    entry->set_key(kv.first);
+    entry->set_value(kv.second);
+  }
+  for (const auto &key : removed) {
+    if (key.empty() || changed.contains(key)) {
+      throw std::invalid_argument("LocalParticipant::updateAttributes: "
+                                  "removed key is empty or also changed");
+    }
+    auto *entry = msg->add_attributes();
+    entry->set_key(key);
+    entry->set_value(std::string());
+  }
+
+  (void)FfiClient::instance().sendRequest(req);
+}
+
 // ----------------------------------------------------------------------------
 // Subscription permissions
 // ----------------------------------------------------------------------------
@@ -197,8 +643,7 @@ LocalParticipant::publishTrack(const std::shared_ptr<Track> &track,
   auto publication = std::make_shared<LocalTrackPublication>(owned_pub);
 
   // Cache in local map by track SID.
-  const std::string sid = publication->sid();
-  track_publications_[sid] = publication;
+  storePublication(publication);
 
   return publication;
 }
@@ -220,10 +665,130 @@ void LocalParticipant::unpublishTrack(const std::string &track_sid) {
 
   fut.get();
 
-  track_publications_.erase(track_sid);
+  erasePublication(track_sid);
+}
+
+std::vector<TrackPublishResult> LocalParticipant::publishTracks(
+    const std::vector<std::pair<std::shared_ptr<Track>, TrackPublishOptions>>
+        &tracks) {
+  for (const auto &entry : tracks) {
+    if (!entry.first) {
+      throw std::invalid_argument(
+          "LocalParticipant::publishTracks: track is null");
+    }
+  }
+  auto participant_handle = ffiHandleId();
+  if (participant_handle == 0) {
+    throw std::runtime_error(
+        "LocalParticipant::publishTracks: invalid participant FFI handle");
+  }
+
+  // Issue every request first; each future resolves independently.
+  std::vector<TrackPublishResult> results(tracks.size());
+  std::vector<std::future<proto::OwnedTrackPublication>> futures(
+      tracks.size());
+  for (std::size_t i = 0; i < tracks.size(); ++i) {
+    auto track_handle = tracks[i].first->ffi_handle_id();
+    if (track_handle == 0) {
+      results[i].error = "invalid track FFI handle";
+      continue;
+    }
+    try {
+      futures[i] = FfiClient::instance().publishTrackAsync(
+          static_cast<std::uint64_t>(participant_handle),
+          static_cast<std::uint64_t>(track_handle), tracks[i].second);
+    } catch (const std::exception &e) {
+      results[i].error = e.what();
+    }
+  }
+
+  for (std::size_t i = 0; i < tracks.size(); ++i) {
+    if (!futures[i].valid()) {
+      continue;
+    }
+    try {
+      auto publication =
+          std::make_shared<LocalTrackPublication>(futures[i].get());
+      storePublication(publication);
+      results[i].publication = std::move(publication);
+    } catch (const std::exception &e) {
+      results[i].error = e.what();
+    }
+  }
+  return results;
+}
+
+std::vector<TrackUnpublishResult>
+LocalParticipant::unpublishTracks(const std::vector<std::string> &track_sids) {
+  auto handle_id = ffiHandleId();
+  if (handle_id == 0) {
+    throw std::runtime_error(
+        "LocalParticipant::unpublishTracks: invalid FFI handle");
+  }
+
+  std::vector<TrackUnpublishResult> results(track_sids.size());
+  std::vector<std::future<void>> futures(track_sids.size());
+  for (std::size_t i = 0; i < track_sids.size(); ++i) {
+    results[i].track_sid = track_sids[i];
+    if (track_sids[i].empty()) {
+      results[i].error = "empty track SID";
+      continue;
+    }
+    try {
+      futures[i] = FfiClient::instance().unpublishTrackAsync(
+          static_cast<std::uint64_t>(handle_id), track_sids[i],
+          /*stop_on_unpublish=*/true);
+    } catch (const std::exception &e) {
+      results[i].error = e.what();
+    }
+  }
+
+  for (std::size_t i = 0; i < track_sids.size(); ++i) {
+    if (!futures[i].valid()) {
+      continue;
+    }
+    try {
+      futures[i].get();
+      erasePublication(track_sids[i]);
+    } catch (const std::exception &e) {
+      results[i].error = e.what();
+    }
+  }
+  return results;
+}
+
+std::string LocalParticipant::performRpc(
+    const std::string &destination_identity, const std::string &method,
+    const std::string &payload, std::optional<double> response_timeout) {
+  return performRpcAsync(destination_identity, method, payload,
+                         response_timeout)
+      .get();
 }
 
 std::string LocalParticipant::performRpc(
+    const std::string &destination_identity, const std::string &method,
+    const std::string &payload, const RpcCallOptions &options) {
+  return performRpcAsync(destination_identity, method, payload, options)
+      .get();
+}
+
+AsyncOperation<std::string> LocalParticipant::performRpcAsync(
+    const std::string &destination_identity, const std::string &method,
+    const std::string &payload, const RpcCallOptions &options) {
+  detail::RpcPayloadMode mode;
+  mode.binary = options.binary;
+  mode.compression = options.compression;
+  if (mode.plain()) {
+    return performRpcAsync(destination_identity, method, payload,
+                           options.response_timeout);
+  }
+  // Replies are decoded by FfiClient, which recognizes the envelope.
+  return performRpcAsync(destination_identity, method,
+                         detail::encodeRpcPayload(payload, mode),
+                         options.response_timeout);
+}
+
+AsyncOperation<std::string> LocalParticipant::performRpcAsync(
     const std::string &destination_identity, const std::string &method,
     const std::string &payload, std::optional<double> response_timeout) {
   auto handle_id = ffiHandleId();
@@ -239,21 +804,155 @@ std::string LocalParticipant::performRpc(
     has_timeout = true;
   }
 
+  FfiClient::AsyncId async_id = 0;
   auto fut = FfiClient::instance().performRpcAsync(
       static_cast<std::uint64_t>(handle_id), destination_identity, method,
       payload,
-      has_timeout ? std::optional<std::uint32_t>(timeout_ms) : std::nullopt);
-  return fut.get();
+      has_timeout ? std::optional<std::uint32_t>(timeout_ms) : std::nullopt,
+      &async_id);
+  return AsyncOperation<std::string>(std::move(fut), async_id);
+}
+
+std::vector<RpcCallResult>
+LocalParticipant::performRpcMany(const std::vector<std::string> &destinations,
+                                 const std::string &method,
+                                 const std::string &payload,
+                                 const RpcManyOptions &options) {
+  if (ffiHandleId() == 0) {
+    throw std::runtime_error(
+        "LocalParticipant::performRpcMany: invalid FFI handle");
+  }
+  using Clock = std::chrono::steady_clock;
+  const std::size_t count = destinations.size();
+  const bool has_deadline = options.deadline.has_value();
+  const Clock::time_point deadline =
+      has_deadline ? Clock::now() + *options.deadline : Clock::time_point{};
+
+  // Shared with the completion callbacks, which may outlive this call when
+  // the deadline expires first.
+  struct Batch {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<RpcCallResult> results;
+    std::vector<AsyncOperation<std::string>> ops;
+    std::vector<bool> finished;
+    std::size_t done = 0;
+    std::size_t in_flight = 0;
+    bool abandoned = false;
+  };
+  auto batch = std::make_shared<Batch>();
+  batch->results.resize(count);
+  batch->ops.resize(count);
+  batch->finished.assign(count, false);
+  for (std::size_t i = 0; i < count; ++i) {
+    batch->results[i].destination_identity = destinations[i];
+  }
+
+  auto finish = [](Batch &b, std::size_t i, std::string reply,
+                   std::optional<RpcError> error) {
+    if (b.abandoned || b.finished[i]) {
+      return;
+    }
+    b.finished[i] = true;
+    b.results[i].payload = std::move(reply);
+    b.results[i].error = std::move(error);
+    ++b.done;
+    b.cv.notify_all();
+  };
+
+  RpcCallOptions call;
+  call.binary = options.binary;
+  call.compression = options.compression;
+
+  std::size_t next = 0;
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  while (batch->done < count) {
+    while (next < count && (options.max_concurrency == 0 ||
+                            batch->in_flight < options.max_concurrency)) {
+      call.response_timeout = options.response_timeout;
+      if (has_deadline) {
+        const double remaining =
+            std::chrono::duration<double>(deadline - Clock::now()).count();
+        if (remaining <= 0.0) {
+          break;
+        }
+        call.response_timeout = call.response_timeout
+                                    ? std::min(*call.response_timeout,
+                                               remaining)
+                                    : remaining;
+      }
+      const std::size_t i = next++;
+      ++batch->in_flight;
+      lock.unlock();
+      try {
+        batch->ops[i] = performRpcAsync(destinations[i], method, payload, call);
+        batch->ops[i].onComplete([batch, i, finish] {
+          std::string reply;
+          std::optional<RpcError> error;
+          try {
+            reply = batch->ops[i].get();
+          } catch (const RpcError &e) {
+            error = e;
+          } catch (const std::exception &e) {
+            error = RpcError(RpcError::ErrorCode::SEND_FAILED, e.what());
+          }
+          std::lock_guard<std::mutex> guard(batch->mutex);
+          --batch->in_flight;
+          finish(*batch, i, std::move(reply), std::move(error));
+        });
+        lock.lock();
+      } catch (const std::exception &e) {
+        lock.lock();
+        --batch->in_flight;
+        finish(*batch, i, {},
+               RpcError(RpcError::ErrorCode::SEND_FAILED, e.what()));
+      }
+    }
+    if (batch->done == count) {
+      break;
+    }
+    const std::size_t seen = batch->done;
+    auto progressed = [&] { return batch->done != seen; };
+    if (!has_deadline) {
+      batch->cv.wait(lock, progressed);
+    } else if (!batch->cv.wait_until(lock, deadline, progressed)) {
+      for (std::size_t i = 0; i < count; ++i) {
+        finish(*batch, i, {},
+               RpcError::builtIn(RpcError::ErrorCode::RESPONSE_TIMEOUT));
+      }
+      batch->abandoned = true;
+    }
+  }
+  return batch->results;
 }
 
 void LocalParticipant::registerRpcMethod(const std::string &method_name,
-                                         RpcHandler handler) {
+                                         RpcHandler handler,
+                                         const RpcMethodOptions &options) {
+  registerRpcMethodAsync(
+      method_name,
+      [handler = std::move(handler)](const RpcInvocationData &data,
+                                     RpcResponder responder) {
+        responder.respond(handler(data));
+      },
+      options);
+}
+
+void LocalParticipant::registerRpcMethodAsync(const std::string &method_name,
+                                              AsyncRpcHandler handler,
+                                              const RpcMethodOptions &options) {
   auto handle_id = ffiHandleId();
   if (handle_id == 0) {
     throw std::runtime_error(
         "LocalParticipant::registerRpcMethod: invalid FFI handle");
   }
-  rpc_handlers_[method_name] = std::move(handler);
+  auto entry = std::make_shared<RpcMethod>();
+  entry->handler = std::move(handler);
+  entry->max_concurrency = options.max_concurrency;
+  {
+    std::lock_guard<std::mutex> lock(rpc_state_->mutex);
+    rpc_state_->methods[method_name] = std::move(entry);
+  }
   FfiRequest req;
   auto *msg = req.mutable_register_rpc_method();
   msg->set_local_participant_handle(static_cast<std::uint64_t>(handle_id));
@@ -268,7 +967,10 @@ void LocalParticipant::unregisterRpcMethod(const std::string &method_name) {
     throw std::runtime_error(
         "LocalParticipant::unregisterRpcMethod: invalid FFI handle");
   }
-  rpc_handlers_.erase(method_name);
+  {
+    std::lock_guard<std::mutex> lock(rpc_state_->mutex);
+    rpc_state_->methods.erase(method_name);
+  }
   FfiRequest req;
   auto *msg = req.mutable_unregister_rpc_method();
   msg->set_local_participant_handle(static_cast<std::uint64_t>(handle_id));
@@ -277,8 +979,40 @@ void LocalParticipant::unregisterRpcMethod(const std::string &method_name) {
   (void)FfiClient::instance().sendRequest(req);
 }
 
+void LocalParticipant::setRpcExecutor(RpcExecutor executor) {
+  std::unique_ptr<detail::TaskPool> old_pool;
+  {
+    std::unique_lock<std::mutex> lock(rpc_state_->mutex);
+    rpc_state_->executor = std::move(executor);
+    rpc_state_->cv.wait(lock, [this] { return rpc_state_->dispatching == 0; });
+    old_pool = std::move(rpc_pool_);
+  }
+  // Runs whatever the old pool still had queued, then joins it.
+  old_pool.reset();
+}
+
+void LocalParticipant::setRpcWorkerThreads(std::size_t threads) {
+  if (threads == 0) {
+    setRpcExecutor(nullptr);
+    return;
+  }
+  auto pool = std::make_unique<detail::TaskPool>(threads);
+  detail::TaskPool *raw = pool.get();
+  setRpcExecutor(
+      [raw](std::function<void()> task) { raw->post(std::move(task)); });
+  std::lock_guard<std::mutex> lock(rpc_state_->mutex);
+  rpc_pool_ = std::move(pool);
+}
+
 void LocalParticipant::shutdown() {
+  // Packets still waiting for budget are abandoned (their senders see the
+  // operation cancelled); waiting transcriptions are sent out.
+  send_queue_->stop();
+  transcriptions_->stop();
+
   // Mark as shutting down and wait for all active invocations to complete
+  std::vector<std::string> methods;
+  std::unique_ptr<detail::TaskPool> pool;
   {
     std::unique_lock<std::mutex> lock(rpc_state_->mutex);
     rpc_state_->shutting_down = true;
@@ -288,24 +1022,34 @@ void LocalParticipant::shutdown() {
     rpc_state_->cv.wait_for(lock, std::chrono::seconds(5), [this] {
       return rpc_state_->active_invocations == 0;
     });
+    for (const auto &pair : rpc_state_->methods) {
+      methods.push_back(pair.first);
+    }
+    rpc_state_->methods.clear();
+    // Anything still queued now runs inline and, seeing shutting_down,
+    // skips its handler.
+    rpc_state_->executor = nullptr;
+    rpc_state_->cv.wait(lock, [this] { return rpc_state_->dispatching == 0; });
+    pool = std::move(rpc_pool_);
   }
+  // Joins the pool; a handler still running past the timeout is waited for
+  // here rather than left referencing a destroyed pool.
+  pool.reset();
 
   auto handle_id = ffiHandleId();
   // If handle is invalid, just clear local handlers - FFI cleanup not possible
   if (handle_id == 0) {
-    rpc_handlers_.clear();
     return;
   }
 
-  // Unregister all RPC methods with FFI and clear local handlers
-  for (const auto &pair : rpc_handlers_) {
+  // Unregister all RPC methods with FFI
+  for (const auto &method : methods) {
     FfiRequest req;
     auto *msg = req.mutable_unregister_rpc_method();
     msg->set_local_participant_handle(static_cast<std::uint64_t>(handle_id));
-    msg->set_method(pair.first);
+    msg->set_method(method);
     (void)FfiClient::instance().sendRequest(req);
   }
-  rpc_handlers_.clear();
 }
 
 void LocalParticipant::handleRpcMethodInvocation(
@@ -314,8 +1058,14 @@ void LocalParticipant::handleRpcMethodInvocation(
     const std::string &payload, double response_timeout_sec) {
   // Capture shared state so it outlives LocalParticipant if needed
   auto state = rpc_state_;
+  std::shared_ptr<RpcMethod> entry;
+  RpcExecutor executor;
+  const auto handle = static_cast<std::uint64_t>(ffiHandleId());
+  RpcInvocationData params{request_id, caller_identity, payload,
+                           response_timeout_sec};
 
   // Track this invocation and check if we're shutting down
+  std::function<void()> task;
   {
     std::lock_guard<std::mutex> lock(state->mutex);
     if (state->shutting_down) {
@@ -323,47 +1073,245 @@ void LocalParticipant::handleRpcMethodInvocation(
       return;
     }
     state->active_invocations++;
-  }
-
-  // RAII guard to decrement counter and notify on exit.
-  // Captures shared_ptr to state so mutex stays valid even if
-  // LocalParticipant is destroyed during handler execution.
-  struct InvocationGuard {
-    std::shared_ptr<RpcInvocationState> state;
-    ~InvocationGuard() {
-      std::lock_guard<std::mutex> lock(state->mutex);
-      state->active_invocations--;
-      if (state->active_invocations == 0) {
-        state->cv.notify_all();
+    auto it = state->methods.find(method);
+    if (it != state->methods.end()) {
+      entry = it->second;
+    }
+    task = [state, entry, method, received = std::chrono::steady_clock::now(),
+            handle, invocation_id, params = std::move(params)] {
+      runRpcInvocation(state, entry, method, received, handle, invocation_id,
+                       params);
+    };
+    if (entry) {
+      if (entry->max_concurrency > 0 &&
+          entry->running >= entry->max_concurrency) {
+        entry->waiting.push_back(std::move(task));
+        return;
       }
+      entry->running++;
+    }
+    executor = state->executor;
+    if (executor) {
+      state->dispatching++;
     }
-  } guard{state};
+  }
+  dispatchRpcTask(state, executor, std::move(task));
+}
 
-  std::optional<RpcError> response_error;
-  std::optional<std::string> response_payload;
-  RpcInvocationData params{request_id, caller_identity, payload,
-                           response_timeout_sec};
-  auto it = rpc_handlers_.find(method);
-  if (it == rpc_handlers_.end()) {
-    // No handler registered → built-in UNSUPPORTED_METHOD
-    response_error = RpcError::builtIn(RpcError::ErrorCode::UNSUPPORTED_METHOD);
-  } else {
+void LocalParticipant::dispatchRpcTask(
+    const std::shared_ptr<RpcInvocationState> &state,
+    const RpcExecutor &executor, std::function<void()> task) {
+  if (!executor) {
+    task();
+    return;
+  }
+  // The caller counted this call in `dispatching` while copying `executor`.
+  // A copy is handed over so the invocation can still run (and answer the
+  // caller) inline if the executor refuses it.
+  bool accepted = true;
+  try {
+    executor(task);
+  } catch (const std::exception &e) {
+    std::cerr << "RPC executor threw, running handler inline: " << e.what()
+              << std::endl;
+    accepted = false;
+  } catch (...) {
+    accepted = false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->dispatching--;
+    state->cv.notify_all();
+  }
+  if (!accepted) {
+    task();
+  }
+}
+
+struct RpcResponder::Completion {
+  using Finish = std::function<void(const std::optional<RpcError> &,
+                                    const std::optional<std::string> &)>;
+
+  explicit Completion(Finish f) : finish(std::move(f)) {}
+  ~Completion() {
+    complete(RpcError::builtIn(RpcError::ErrorCode::APPLICATION_ERROR,
+                               "handler did not respond"),
+             std::nullopt);
+  }
+
+  void complete(const std::optional<RpcError> &error,
+                const std::optional<std::string> &payload) noexcept {
+    if (done.exchange(true)) {
+      return;
+    }
     try {
-      // Invoke user handler: may return payload or throw RpcError
-      response_payload = it->second(params);
-    } catch (const RpcError &err) {
-      // Handler explicitly signalled an RPC error: forward as-is
-      response_error = err;
-    } catch (const std::exception &ex) {
-      // Any other exception: wrap as built-in APPLICATION_ERROR
-      response_error =
-          RpcError::builtIn(RpcError::ErrorCode::APPLICATION_ERROR, ex.what());
+      finish(error, payload);
+    } catch (const std::exception &e) {
+      std::cerr << "RPC response failed: " << e.what() << std::endl;
     } catch (...) {
-      response_error = RpcError::builtIn(RpcError::ErrorCode::APPLICATION_ERROR,
-                                         "unknown error");
+      std::cerr << "RPC response failed" << std::endl;
     }
   }
 
+  Finish finish;
+  std::atomic<bool> done{false};
+};
+
+void RpcResponder::respond(std::optional<std::string> payload) {
+  if (completion_) {
+    completion_->complete(std::nullopt, payload);
+  }
+}
+
+void RpcResponder::fail(const RpcError &error) {
+  if (completion_) {
+    completion_->complete(error, std::nullopt);
+  }
+}
+
+bool RpcResponder::responded() const noexcept {
+  return completion_ && completion_->done.load();
+}
+
+void LocalParticipant::runRpcInvocation(
+    const std::shared_ptr<RpcInvocationState> &state,
+    const std::shared_ptr<RpcMethod> &method, const std::string &method_name,
+    std::chrono::steady_clock::time_point received,
+    std::uint64_t participant_handle, std::uint64_t invocation_id,
+    const RpcInvocationData &params) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  const auto started = std::chrono::steady_clock::now();
+  auto record = [method_name, started,
+                 queueing = duration_cast<microseconds>(started - received)](
+                    const std::optional<RpcError> &error) {
+    if (!detail::metricsOn())
+      return;
+    detail::RpcMetricsRegistry::instance().recordIncoming(
+        method_name, queueing,
+        duration_cast<microseconds>(std::chrono::steady_clock::now() -
+                                    started),
+        error ? error->code() : 0);
+  };
+
+  bool shutting_down;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    shutting_down = state->shutting_down;
+  }
+  if (!shutting_down && !method) {
+    record(RpcError::builtIn(RpcError::ErrorCode::UNSUPPORTED_METHOD));
+  }
+  if (shutting_down || !method) {
+    // No handler registered → built-in UNSUPPORTED_METHOD
+    finishRpcInvocation(
+        state, method, participant_handle, invocation_id,
+        RpcError::builtIn(RpcError::ErrorCode::UNSUPPORTED_METHOD),
+        std::nullopt);
+    return;
+  }
+
+  // Unwrap binary / compressed payloads; the reply goes back the same way.
+  RpcInvocationData data = params;
+  detail::RpcPayloadMode mode;
+  try {
+    std::string body;
+    if (detail::decodeRpcPayload(params.payload, &mode, &body)) {
+      data.payload = std::move(body);
+      data.binary = mode.binary;
+      data.compression = mode.compression;
+    }
+  } catch (const RpcError &err) {
+    record(err);
+    finishRpcInvocation(state, method, participant_handle, invocation_id, err,
+                        std::nullopt);
+    return;
+  }
+
+  // The completion captures shared_ptr to state so the mutex stays valid
+  // even if LocalParticipant is destroyed before the handler answers.
+  auto completion = std::make_shared<RpcResponder::Completion>(
+      [state, method, participant_handle, invocation_id, mode,
+       record](const std::optional<RpcError> &error,
+               const std::optional<std::string> &payload) {
+        record(error);
+        if (!payload || mode.plain()) {
+          finishRpcInvocation(state, method, participant_handle,
+                              invocation_id, error, payload);
+          return;
+        }
+        std::optional<RpcError> encode_error;
+        std::optional<std::string> wire;
+        try {
+          wire = detail::encodeRpcPayload(*payload, mode);
+        } catch (const RpcError &e) {
+          encode_error = e;
+        } catch (const std::exception &e) {
+          encode_error = RpcError(RpcError::ErrorCode::APPLICATION_ERROR,
+                                  std::string("RPC reply encoding failed: ") +
+                                      e.what());
+        }
+        finishRpcInvocation(state, method, participant_handle, invocation_id,
+                            encode_error, wire);
+      });
+  try {
+    // Invoke user handler: may answer now, later, or throw RpcError
+    method->handler(data, RpcResponder(completion));
+  } catch (const RpcError &err) {
+    // Handler explicitly signalled an RPC error: forward as-is
+    completion->complete(err, std::nullopt);
+  } catch (const std::exception &ex) {
+    // Any other exception: wrap as built-in APPLICATION_ERROR
+    completion->complete(
+        RpcError::builtIn(RpcError::ErrorCode::APPLICATION_ERROR, ex.what()),
+        std::nullopt);
+  } catch (...) {
+    completion->complete(
+        RpcError::builtIn(RpcError::ErrorCode::APPLICATION_ERROR,
+                          "unknown error"),
+        std::nullopt);
+  }
+}
+
+void LocalParticipant::finishRpcInvocation(
+    const std::shared_ptr<RpcInvocationState> &state,
+    const std::shared_ptr<RpcMethod> &method, std::uint64_t participant_handle,
+    std::uint64_t invocation_id, const std::optional<RpcError> &error,
+    const std::optional<std::string> &payload) {
+  // RAII guard: release the method's concurrency slot (starting the next
+  // waiting invocation, if any) and decrement the counter on exit, even if
+  // sending the response throws.
+  struct InvocationGuard {
+    const std::shared_ptr<RpcInvocationState> &state;
+    const std::shared_ptr<RpcMethod> &method;
+    ~InvocationGuard() {
+      std::function<void()> next;
+      RpcExecutor executor;
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (method) {
+          method->running--;
+          if (!method->waiting.empty()) {
+            next = std::move(method->waiting.front());
+            method->waiting.pop_front();
+            method->running++;
+            executor = state->executor;
+            if (executor) {
+              state->dispatching++;
+            }
+          }
+        }
+        state->active_invocations--;
+        if (state->active_invocations == 0) {
+          state->cv.notify_all();
+        }
+      }
+      if (next) {
+        dispatchRpcTask(state, executor, std::move(next));
+      }
+    }
+  } guard{state, method};
+
   // Check again if shutdown started during handler execution
   {
     std::lock_guard<std::mutex> lock(state->mutex);
@@ -375,25 +1323,21 @@ void LocalParticipant::handleRpcMethodInvocation(
 
   FfiRequest req;
   auto *msg = req.mutable_rpc_method_invocation_response();
-  msg->set_local_participant_handle(ffiHandleId());
+  msg->set_local_participant_handle(participant_handle);
   msg->set_invocation_id(invocation_id);
-  if (response_error.has_value()) {
+  if (error.has_value()) {
     auto *err_proto = msg->mutable_error();
-    err_proto->CopyFrom(response_error->toProto());
+    err_proto->CopyFrom(error->toProto());
   }
-  if (response_payload.has_value()) {
-    msg->set_payload(*response_payload);
+  if (payload.has_value()) {
+    msg->set_payload(*payload);
   }
   FfiClient::instance().sendRequest(req);
 }
 
 std::shared_ptr<TrackPublication>
 LocalParticipant::findTrackPublication(const std::string &sid) const {
-  auto it = track_publications_.find(sid);
-  if (it == track_publications_.end()) {
-    return nullptr;
-  }
-  return std::static_pointer_cast<TrackPublication>(it->second);
+  return std::static_pointer_cast<TrackPublication>(trackPublication(sid));
 }
 
 } // namespace livekit
@@ -24,7 +24,8 @@ namespace livekit {
 LocalTrackPublication::LocalTrackPublication(
     const proto::OwnedTrackPublication &owned)
     : TrackPublication(
-          FfiHandle(owned.handle().id()), owned.info().sid(),
+          FfiHandle(owned.handle().id(), ResourceKind::kTrackPublication),
+          owned.info().sid(),
           owned.info().name(), fromProto(owned.info().kind()),
           fromProto(owned.info().source()), owned.info().simulcasted(),
           owned.info().width(), owned.info().height(), owned.info().mime_type(),
@@ -40,7 +40,8 @@ std::shared_ptr<LocalVideoTrack> LocalVideoTrack::createLocalVideoTrack(
 
   proto::FfiResponse resp = FfiClient::instance().sendRequest(req);
   const proto::OwnedTrack &owned = resp.create_video_track().track();
-  FfiHandle handle(static_cast<uintptr_t>(owned.handle().id()));
+  FfiHandle handle(static_cast<uintptr_t>(owned.handle().id()),
+                   ResourceKind::kTrack);
   return std::shared_ptr<LocalVideoTrack>(
       new LocalVideoTrack(std::move(handle), owned));
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/logging.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LK_PRINTF_FORMAT(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define LK_PRINTF_FORMAT(fmt, args)
+#endif
+
+namespace livekit {
+namespace detail {
+
+// Most verbose level any filter lets through; call sites test this before
+// formatting anything.
+extern std::atomic<int> g_log_max_level;
+
+inline bool logEnabled(LogLevel level) noexcept {
+  return static_cast<int>(level) <=
+         g_log_max_level.load(std::memory_order_relaxed);
+}
+
+// Formats into a queue slot; never blocks or allocates. Before the pipeline
+// has started (or after shutdown) the record goes straight to stderr.
+void logWrite(LogLevel level, const char *target, const char *file, int line,
+              const char *fmt, ...) noexcept LK_PRINTF_FORMAT(5, 6);
+
+// Records forwarded by the Rust logger (LogSink::kCallback).
+void logWriteFfi(LogLevel level, std::string_view target,
+                 std::string_view file, std::uint32_t line,
+                 std::string_view message) noexcept;
+
+// Handles the raw FFI event if it is a log batch: only the batch is parsed
+// and the event never reaches the listeners. Returns false for any other
+// event.
+bool consumeFfiLogEvent(const std::uint8_t *buf, std::size_t len);
+
+// RUST_LOG value matching `options`, e.g. "info,livekit::rtc_engine=debug".
+std::string rustLogFilter(const LogOptions &options);
+
+// Start the logging thread (idempotent); stopLogging() writes out what is
+// queued and joins it.
+void startLogging();
+void stopLogging();
+
+} // namespace detail
+} // namespace livekit
+
+#define LK_LOG(level, target, ...)                                             \
+  do {                                                                         \
+    if (::livekit::detail::logEnabled(level)) {                                \
+      ::livekit::detail::logWrite(level, target, __FILE__, __LINE__,           \
+                                  __VA_ARGS__);                                \
+    }                                                                          \
+  } while (0)
+
+#define LK_LOG_ERROR(target, ...)                                              \
+  LK_LOG(::livekit::LogLevel::kError, target, __VA_ARGS__)
+#define LK_LOG_WARN(target, ...)                                               \
+  LK_LOG(::livekit::LogLevel::kWarn, target, __VA_ARGS__)
+#define LK_LOG_INFO(target, ...)                                               \
+  LK_LOG(::livekit::LogLevel::kInfo, target, __VA_ARGS__)
+#define LK_LOG_DEBUG(target, ...)                                              \
+  LK_LOG(::livekit::LogLevel::kDebug, target, __VA_ARGS__)
@@ -0,0 +1,576 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ffi.pb.h"
+#include "ffi_wire.h"
+#include "thread_util.h"
+
+namespace livekit {
+namespace detail {
+
+std::atomic<int> g_log_max_level{static_cast<int>(LogLevel::kInfo)};
+
+namespace {
+
+constexpr std::size_t kTargetBytes = 64;
+constexpr std::size_t kFileBytes = 96;
+constexpr std::size_t kMessageBytes = 512;
+// The logging thread polls at this interval when idle, so producers never
+// have to take a lock to wake it.
+constexpr auto kIdlePoll = std::chrono::milliseconds(5);
+
+struct LogSlot {
+  std::atomic<std::size_t> seq{0};
+  LogLevel level = LogLevel::kInfo;
+  bool from_ffi = false;
+  std::uint32_t line = 0;
+  std::int64_t time_us = 0;
+  std::uint16_t target_len = 0;
+  std::uint16_t file_len = 0;
+  std::uint16_t message_len = 0;
+  char target[kTargetBytes];
+  char file[kFileBytes];
+  char message[kMessageBytes];
+};
+
+std::uint16_t copyTruncated(char *dst, std::size_t capacity,
+                            std::string_view src) noexcept {
+  const std::size_t n = std::min(capacity, src.size());
+  if (n != 0) {
+    std::memcpy(dst, src.data(), n);
+  }
+  return static_cast<std::uint16_t>(n);
+}
+
+std::string_view baseName(std::string_view path) noexcept {
+  const auto pos = path.find_last_of("/\\");
+  return pos == std::string_view::npos ? path : path.substr(pos + 1);
+}
+
+void fillHeader(LogSlot &slot, LogLevel level, std::string_view target,
+                std::string_view file, std::uint32_t line,
+                bool from_ffi) noexcept {
+  slot.level = level;
+  slot.from_ffi = from_ffi;
+  slot.line = line;
+  slot.time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::system_clock::now().time_since_epoch())
+                     .count();
+  slot.target_len = copyTruncated(slot.target, kTargetBytes, target);
+  slot.file_len = copyTruncated(slot.file, kFileBytes, baseName(file));
+}
+
+void formatMessage(LogSlot &slot, const char *fmt, std::va_list args) noexcept {
+  const int n = std::vsnprintf(slot.message, kMessageBytes, fmt, args);
+  slot.message_len = static_cast<std::uint16_t>(
+      n < 0 ? 0 : std::min<std::size_t>(n, kMessageBytes - 1));
+}
+
+LogRecord toRecord(const LogSlot &slot) {
+  LogRecord record;
+  record.level = slot.level;
+  record.target = std::string_view(slot.target, slot.target_len);
+  record.message = std::string_view(slot.message, slot.message_len);
+  record.file = std::string_view(slot.file, slot.file_len);
+  record.line = slot.line;
+  record.from_ffi = slot.from_ffi;
+  record.time = std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::microseconds(slot.time_us)));
+  return record;
+}
+
+const char *levelName(LogLevel level) noexcept {
+  switch (level) {
+  case LogLevel::kOff:
+    return "off";
+  case LogLevel::kError:
+    return "error";
+  case LogLevel::kWarn:
+    return "warn";
+  case LogLevel::kInfo:
+    return "info";
+  case LogLevel::kDebug:
+    return "debug";
+  case LogLevel::kTrace:
+    return "trace";
+  }
+  return "info";
+}
+
+void writeConsole(const LogRecord &record) noexcept {
+  char line[kMessageBytes + kTargetBytes + kFileBytes + 64];
+  int n;
+  if (record.file.empty()) {
+    n = std::snprintf(line, sizeof(line), "[livekit %s %.*s] %.*s\n",
+                      levelName(record.level),
+                      static_cast<int>(record.target.size()),
+                      record.target.data(),
+                      static_cast<int>(record.message.size()),
+                      record.message.data());
+  } else {
+    n = std::snprintf(line, sizeof(line), "[livekit %s %.*s] %.*s (%.*s:%u)\n",
+                      levelName(record.level),
+                      static_cast<int>(record.target.size()),
+                      record.target.data(),
+                      static_cast<int>(record.message.size()),
+                      record.message.data(),
+                      static_cast<int>(record.file.size()),
+                      record.file.data(), record.line);
+  }
+  if (n > 0) {
+    std::fwrite(line, 1, std::min<std::size_t>(n, sizeof(line) - 1), stderr);
+  }
+}
+
+// Bounded multi-producer queue of fixed slots (Vyukov's sequence scheme);
+// the logging thread is the only consumer.
+class LogQueue {
+public:
+  explicit LogQueue(std::size_t capacity) {
+    std::size_t n = 2;
+    while (n < capacity) {
+      n <<= 1;
+    }
+    slots_.reset(new LogSlot[n]);
+    mask_ = n - 1;
+    for (std::size_t i = 0; i < n; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Reserve a slot, or nullptr if the queue is full.
+  LogSlot *claim(std::size_t &pos) noexcept {
+    pos = enqueue_.load(std::memory_order_relaxed);
+    for (;;) {
+      LogSlot &slot = slots_[pos & mask_];
+      const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        if (enqueue_.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+          return &slot;
+        }
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = enqueue_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void publish(LogSlot &slot, std::size_t pos) noexcept {
+    slot.seq.store(pos + 1, std::memory_order_release);
+  }
+
+  // Consumer side.
+  LogSlot *front() noexcept {
+    LogSlot &slot = slots_[dequeue_ & mask_];
+    return slot.seq.load(std::memory_order_acquire) == dequeue_ + 1 ? &slot
+                                                                    : nullptr;
+  }
+
+  void pop() noexcept {
+    slots_[dequeue_ & mask_].seq.store(dequeue_ + mask_ + 1,
+                                       std::memory_order_release);
+    ++dequeue_;
+    consumed_.store(dequeue_, std::memory_order_release);
+  }
+
+  std::size_t claimed() const noexcept {
+    return enqueue_.load(std::memory_order_acquire);
+  }
+  std::size_t consumed() const noexcept {
+    return consumed_.load(std::memory_order_acquire);
+  }
+
+private:
+  std::unique_ptr<LogSlot[]> slots_;
+  std::size_t mask_{0};
+  std::atomic<std::size_t> enqueue_{0};
+  std::atomic<std::size_t> consumed_{0};
+  std::size_t dequeue_{0}; // consumer-owned
+};
+
+// Producers reach the queue through this pointer only; it is cleared while
+// the logging thread is not running. The queue itself lives as long as the
+// Logger, so a producer that loaded it just before a stop stays safe.
+std::atomic<LogQueue *> g_active_queue{nullptr};
+std::atomic<std::uint64_t> g_written{0};
+std::atomic<std::uint64_t> g_dropped{0};
+std::atomic<std::uint64_t> g_filtered{0};
+
+struct LogConfig {
+  LogOptions options;
+
+  LogLevel levelFor(std::string_view target) const noexcept {
+    LogLevel level = options.level;
+    std::size_t best = 0;
+    for (const auto &t : options.targets) {
+      if (t.first.size() >= best && target.substr(0, t.first.size()) ==
+                                        std::string_view(t.first)) {
+        best = t.first.size();
+        level = t.second;
+      }
+    }
+    return level;
+  }
+
+  bool passes(const LogRecord &record) const noexcept {
+    return static_cast<int>(record.level) <=
+           static_cast<int>(levelFor(record.target));
+  }
+};
+
+using OutputList = std::vector<std::pair<int, LogOutput>>;
+
+class Logger {
+public:
+  // Never destroyed: records may still be written from static destructors.
+  static Logger &instance() {
+    static Logger *logger = new Logger();
+    return *logger;
+  }
+
+  void configure(const LogOptions &options) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    apply(options);
+  }
+
+  void setLevel(LogLevel level) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LogOptions options = config_->options;
+    options.level = level;
+    apply(options);
+  }
+
+  LogOptions options() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_->options;
+  }
+
+  int addOutput(LogOutput output) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto outputs = std::make_shared<OutputList>(*outputs_);
+    const int id = next_output_id_++;
+    outputs->emplace_back(id, std::move(output));
+    outputs_ = std::move(outputs);
+    return id;
+  }
+
+  void removeOutput(int id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto outputs = std::make_shared<OutputList>(*outputs_);
+    outputs->erase(std::remove_if(outputs->begin(), outputs->end(),
+                                  [id](const OutputList::value_type &o) {
+                                    return o.first == id;
+                                  }),
+                   outputs->end());
+    outputs_ = std::move(outputs);
+    // A pass in progress may still hold the old list; once it ends the
+    // output is never called again. Later passes already use the new list,
+    // so only that one pass has to finish, even if the next starts at once.
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id() &&
+        draining_) {
+      const std::uint64_t seen = passes_done_;
+      cv_.wait(lock, [&] { return passes_done_ != seen; });
+    }
+  }
+
+  void start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (thread_.joinable()) {
+      return;
+    }
+    if (!queue_) {
+      // queue_capacity only takes effect here, the first time logging
+      // starts: producers may still hold the queue after a stop.
+      queue_ = std::make_unique<LogQueue>(config_->options.queue_capacity);
+    }
+    stop_ = false;
+    thread_ = std::thread([this] {
+      detail::registerThread(ThreadRole::kBackground, "lk-log");
+      run();
+    });
+    g_active_queue.store(queue_.get(), std::memory_order_release);
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!thread_.joinable()) {
+        return;
+      }
+      g_active_queue.store(nullptr, std::memory_order_release);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.get_id() == std::this_thread::get_id()) {
+      thread_.detach();
+      return;
+    }
+    thread_.join();
+  }
+
+  void flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!thread_.joinable() || thread_.get_id() == std::this_thread::get_id()) {
+      return;
+    }
+    const std::size_t target = queue_->claimed();
+    wake_ = true;
+    cv_.notify_all();
+    cv_.wait(lock, [&] { return queue_->consumed() >= target || stop_; });
+  }
+
+  // Used while the logging thread is not running: filter and print inline.
+  void writeNow(const LogSlot &slot) {
+    std::shared_ptr<const LogConfig> config;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      config = config_;
+    }
+    const LogRecord record = toRecord(slot);
+    if (!config->passes(record)) {
+      g_filtered.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    if (config->options.console) {
+      writeConsole(record);
+    }
+    g_written.fetch_add(1, std::memory_order_relaxed);
+  }
+
+private:
+  Logger()
+      : config_(std::make_shared<LogConfig>()),
+        outputs_(std::make_shared<OutputList>()) {}
+
+  // Caller holds mutex_.
+  void apply(const LogOptions &options) {
+    auto config = std::make_shared<LogConfig>();
+    config->options = options;
+    int max_level = static_cast<int>(options.level);
+    for (const auto &t : options.targets) {
+      max_level = std::max(max_level, static_cast<int>(t.second));
+    }
+    config_ = std::move(config);
+    g_log_max_level.store(max_level, std::memory_order_relaxed);
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      auto config = config_;
+      auto outputs = outputs_;
+      draining_ = true;
+      lock.unlock();
+      const bool drained_any = drain(*config, *outputs);
+      outputs.reset();
+      lock.lock();
+      draining_ = false;
+      ++passes_done_;
+      cv_.notify_all(); // flush() and removeOutput() waiters
+      if (stop_ && !drained_any) {
+        break;
+      }
+      if (!drained_any && !stop_) {
+        cv_.wait_for(lock, kIdlePoll, [this] { return wake_ || stop_; });
+      }
+      wake_ = false;
+    }
+  }
+
+  bool drain(const LogConfig &config, const OutputList &outputs) {
+    bool any = false;
+    while (LogSlot *slot = queue_->front()) {
+      any = true;
+      const LogRecord record = toRecord(*slot);
+      if (config.passes(record)) {
+        if (config.options.console) {
+          writeConsole(record);
+        }
+        for (const auto &output : outputs) {
+          try {
+            output.second(record);
+          } catch (...) {
+            // A failing output must not take the logging thread down.
+          }
+        }
+        g_written.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        g_filtered.fetch_add(1, std::memory_order_relaxed);
+      }
+      queue_->pop();
+    }
+    return any;
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::shared_ptr<const LogConfig> config_;
+  std::shared_ptr<const OutputList> outputs_;
+  int next_output_id_{1};
+  std::unique_ptr<LogQueue> queue_;
+  std::thread thread_;
+  bool stop_{false};
+  bool wake_{false};
+  bool draining_{false};
+  std::uint64_t passes_done_{0}; // drain passes finished, for removeOutput()
+};
+
+template <typename Fill> void emit(Fill &&fill) noexcept {
+  LogQueue *queue = g_active_queue.load(std::memory_order_acquire);
+  if (!queue) {
+    LogSlot slot;
+    fill(slot);
+    try {
+      Logger::instance().writeNow(slot);
+    } catch (...) {
+    }
+    return;
+  }
+  std::size_t pos = 0;
+  LogSlot *slot = queue->claim(pos);
+  if (!slot) {
+    g_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  fill(*slot);
+  queue->publish(*slot, pos);
+}
+
+LogLevel fromProto(proto::LogLevel level) noexcept {
+  switch (level) {
+  case proto::LOG_ERROR:
+    return LogLevel::kError;
+  case proto::LOG_WARN:
+    return LogLevel::kWarn;
+  case proto::LOG_INFO:
+    return LogLevel::kInfo;
+  case proto::LOG_DEBUG:
+    return LogLevel::kDebug;
+  case proto::LOG_TRACE:
+  default:
+    return LogLevel::kTrace;
+  }
+}
+
+} // namespace
+
+void logWrite(LogLevel level, const char *target, const char *file, int line,
+              const char *fmt, ...) noexcept {
+  std::va_list args;
+  va_start(args, fmt);
+  emit([&](LogSlot &slot) {
+    fillHeader(slot, level, target ? target : "livekit", file ? file : "",
+               line > 0 ? static_cast<std::uint32_t>(line) : 0, false);
+    formatMessage(slot, fmt, args);
+  });
+  va_end(args);
+}
+
+void logWriteFfi(LogLevel level, std::string_view target,
+                 std::string_view file, std::uint32_t line,
+                 std::string_view message) noexcept {
+  emit([&](LogSlot &slot) {
+    fillHeader(slot, level, target, file, line, true);
+    slot.message_len = copyTruncated(slot.message, kMessageBytes, message);
+  });
+}
+
+bool consumeFfiLogEvent(const std::uint8_t *buf, std::size_t len) {
+  // Peeking at the first tag spares log batches the full FfiEvent parse and
+  // the listener broadcast.
+  WireField field;
+  if (!peekFirstField(buf, len, field) ||
+      field.number != proto::FfiEvent::kLogsFieldNumber) {
+    return false;
+  }
+  proto::LogBatch batch;
+  if (!batch.ParseFromArray(field.data, static_cast<int>(field.size))) {
+    return true;
+  }
+  for (const auto &record : batch.records()) {
+    const LogLevel level = fromProto(record.level());
+    if (logEnabled(level)) {
+      logWriteFfi(level, record.target(), record.file(), record.line(),
+                  record.message());
+    }
+  }
+  return true;
+}
+
+std::string rustLogFilter(const LogOptions &options) {
+  std::string filter = levelName(options.level);
+  for (const auto &t : options.targets) {
+    filter += ',';
+    filter += t.first;
+    filter += '=';
+    filter += levelName(t.second);
+  }
+  return filter;
+}
+
+void startLogging() { Logger::instance().start(); }
+
+void stopLogging() { Logger::instance().stop(); }
+
+} // namespace detail
+
+void configureLogging(const LogOptions &options) {
+  detail::Logger::instance().configure(options);
+  detail::startLogging();
+}
+
+void setLogLevel(LogLevel level) { detail::Logger::instance().setLevel(level); }
+
+LogLevel logLevel() { return detail::Logger::instance().options().level; }
+
+int addLogOutput(LogOutput output) {
+  const int id = detail::Logger::instance().addOutput(std::move(output));
+  detail::startLogging();
+  return id;
+}
+
+void removeLogOutput(int id) { detail::Logger::instance().removeOutput(id); }
+
+void flushLogs() { detail::Logger::instance().flush(); }
+
+LogStats logStats() {
+  LogStats stats;
+  stats.written = detail::g_written.load(std::memory_order_relaxed);
+  stats.dropped = detail::g_dropped.load(std::memory_order_relaxed);
+  stats.filtered = detail::g_filtered.load(std::memory_order_relaxed);
+  return stats;
+}
+
+} // namespace livekit
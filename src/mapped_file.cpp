@@ -0,0 +1,163 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_file.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+std::size_t pageSize() {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<std::size_t>(info.dwPageSize);
+#else
+  static const std::size_t size =
+      static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return size;
+#endif
+}
+
+} // namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &path) {
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("MappedFile: cannot open " + path);
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw std::runtime_error("MappedFile: cannot stat " + path);
+  }
+  file_ = file;
+  size_ = static_cast<std::size_t>(size.QuadPart);
+  if (size_ == 0) {
+    return;
+  }
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+                       : nullptr;
+  if (!view) {
+    if (mapping) {
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    throw std::runtime_error("MappedFile: cannot map " + path);
+  }
+  mapping_ = mapping;
+  data_ = static_cast<const std::uint8_t *>(view);
+}
+
+MappedFile::~MappedFile() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_) {
+    CloseHandle(static_cast<HANDLE>(mapping_));
+  }
+  if (file_) {
+    CloseHandle(static_cast<HANDLE>(file_));
+  }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &path) {
+  fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0) {
+    throw std::runtime_error("MappedFile: cannot open " + path + ": " +
+                             std::strerror(errno));
+  }
+  struct stat st;
+  if (::fstat(fd_, &st) != 0) {
+    const int err = errno;
+    ::close(fd_);
+    throw std::runtime_error("MappedFile: cannot stat " + path + ": " +
+                             std::strerror(err));
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ == 0) {
+    return;
+  }
+  void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (addr == MAP_FAILED) {
+    const int err = errno;
+    ::close(fd_);
+    throw std::runtime_error("MappedFile: cannot map " + path + ": " +
+                             std::strerror(err));
+  }
+  ::madvise(addr, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const std::uint8_t *>(addr);
+}
+
+MappedFile::~MappedFile() {
+  if (data_) {
+    ::munmap(const_cast<std::uint8_t *>(data_), size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+#endif
+
+void MappedFile::release(std::size_t offset, std::size_t length) noexcept {
+  if (!data_ || offset >= size_) {
+    return;
+  }
+  const std::size_t page = pageSize();
+  std::size_t begin = (offset + page - 1) / page * page;
+  std::size_t end = offset + length;
+  // The final partial page may be released too: nothing follows it.
+  end = end >= size_ ? size_ : end / page * page;
+  if (end <= begin) {
+    return;
+  }
+  auto *addr = const_cast<std::uint8_t *>(data_) + begin;
+#ifdef _WIN32
+  // Unlocking pages that are not locked evicts them from the working set.
+  VirtualUnlock(addr, end - begin);
+#else
+  ::madvise(addr, end - begin, MADV_DONTNEED);
+#endif
+}
+
+} // namespace detail
+} // namespace livekit
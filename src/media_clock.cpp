@@ -0,0 +1,358 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/media_clock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rpc_metrics.h"
+#include "thread_util.h"
+
+namespace livekit {
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Catch-up limit for pacers that do not skip missed ticks.
+constexpr std::chrono::milliseconds kMaxLag{200};
+
+Clock::time_point deadlineOf(Clock::time_point start,
+                             std::chrono::nanoseconds period,
+                             std::uint64_t tick) {
+  return start + period * static_cast<std::int64_t>(tick);
+}
+
+// If tick `tick` is too late to run at `now`, move it to the newest tick
+// already due and return how many were skipped.
+std::uint64_t skipLate(Clock::time_point start, std::chrono::nanoseconds period,
+                       bool skip_missed, Clock::time_point now,
+                       std::uint64_t &tick) {
+  const auto limit = skip_missed
+                         ? period
+                         : std::max<std::chrono::nanoseconds>(period, kMaxLag);
+  if (now - deadlineOf(start, period, tick) <= limit) {
+    return 0;
+  }
+  const auto current = static_cast<std::uint64_t>((now - start) / period);
+  const std::uint64_t skipped = current - tick;
+  tick = current;
+  return skipped;
+}
+
+std::chrono::microseconds toMicros(Clock::duration d) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(d);
+}
+
+} // namespace
+
+// ============================================================================
+// MediaClock
+// ============================================================================
+
+struct MediaClock::Pacer::Entry {
+  Entry(std::chrono::nanoseconds p, TickCallback cb, const PacerOptions &o,
+        std::weak_ptr<MediaClock::Impl> c)
+      : period(p), options(o), callback(std::move(cb)), clock(std::move(c)),
+        start(Clock::now()) {}
+
+  const std::chrono::nanoseconds period;
+  const PacerOptions options;
+  TickCallback callback; // cleared once stopped and not running
+  const std::weak_ptr<MediaClock::Impl> clock;
+  const Clock::time_point start;
+  std::uint64_t tick{0}; // next tick to run; clock thread only
+
+  std::atomic<bool> stopped{false};
+  std::atomic<std::uint64_t> ticks{0};
+  std::atomic<std::uint64_t> missed{0};
+  detail::LatencyHistogram lateness;
+};
+
+struct MediaClock::Impl {
+  using Entry = Pacer::Entry;
+
+  struct Node {
+    Clock::time_point deadline;
+    std::uint64_t seq; // FIFO among equal deadlines
+    std::shared_ptr<Entry> entry;
+  };
+
+  static bool later(const Node &a, const Node &b) {
+    return a.deadline != b.deadline ? a.deadline > b.deadline : a.seq > b.seq;
+  }
+
+  void start() {
+    thread = std::thread([this] {
+      detail::registerThread(ThreadRole::kMediaClock, "lk-media-clock");
+      run();
+    });
+  }
+
+  void shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake_cv.notify_all();
+    if (thread.joinable()) {
+      thread.join();
+    }
+    // Released after unlocking, in case a callback's captures use the clock.
+    std::vector<Node> orphans;
+    std::vector<TickCallback> callbacks;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      orphans.swap(heap);
+      for (auto &node : orphans) {
+        node.entry->stopped.store(true, std::memory_order_release);
+        callbacks.push_back(std::move(node.entry->callback));
+      }
+      active = 0;
+    }
+  }
+
+  void add(std::shared_ptr<Entry> entry) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (stopping) {
+        throw std::runtime_error("MediaClock: clock is shutting down");
+      }
+      push(Node{entry->start, 0, std::move(entry)});
+      ++active;
+    }
+    wake_cv.notify_all();
+  }
+
+  void stop(const std::shared_ptr<Entry> &entry) {
+    TickCallback callback;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if (entry->stopped.exchange(true, std::memory_order_acq_rel)) {
+        return;
+      }
+      --active;
+      if (running == entry.get()) {
+        if (std::this_thread::get_id() == thread.get_id()) {
+          return; // the loop releases the callback once it returns
+        }
+        done_cv.wait(lock, [&] { return running != entry.get(); });
+      }
+      callback = std::move(entry->callback);
+    }
+    wake_cv.notify_all(); // the node can go early
+  }
+
+  void push(Node node) {
+    node.seq = next_seq++;
+    heap.push_back(std::move(node));
+    std::push_heap(heap.begin(), heap.end(), later);
+  }
+
+  Node pop() {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    Node node = std::move(heap.back());
+    heap.pop_back();
+    return node;
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+      if (heap.empty()) {
+        wake_cv.wait(lock);
+        continue;
+      }
+      if (heap.front().entry->stopped.load(std::memory_order_acquire)) {
+        pop();
+        continue;
+      }
+      const Clock::time_point deadline = heap.front().deadline;
+      if (Clock::now() < deadline) {
+        wake_cv.wait_until(lock, deadline);
+        continue;
+      }
+      Node node = pop();
+      Entry &e = *node.entry;
+      running = &e;
+      lock.unlock();
+
+      const Clock::time_point now = Clock::now();
+      const std::uint64_t skipped =
+          skipLate(e.start, e.period, e.options.skip_missed, now, e.tick);
+      if (skipped > 0) {
+        e.missed.fetch_add(skipped, std::memory_order_relaxed);
+      }
+      e.lateness.record(toMicros(now - deadlineOf(e.start, e.period, e.tick)));
+      try {
+        e.callback(e.tick);
+      } catch (...) {
+        // A throwing callback must not take the clock down with it.
+      }
+      e.ticks.fetch_add(1, std::memory_order_relaxed);
+      ++e.tick;
+
+      TickCallback released;
+      lock.lock();
+      running = nullptr;
+      if (e.stopped.load(std::memory_order_acquire)) {
+        released = std::move(e.callback);
+      } else {
+        node.deadline = deadlineOf(e.start, e.period, e.tick);
+        push(std::move(node));
+      }
+      done_cv.notify_all();
+      if (released) {
+        lock.unlock();
+        released = nullptr;
+        lock.lock();
+      }
+    }
+  }
+
+  mutable std::mutex mutex;
+  std::condition_variable wake_cv;
+  std::condition_variable done_cv;
+  std::vector<Node> heap;
+  std::uint64_t next_seq{0};
+  std::size_t active{0};
+  const Entry *running{nullptr};
+  bool stopping{false};
+  std::thread thread;
+};
+
+MediaClock::Pacer::~Pacer() { stop(); }
+
+MediaClock::Pacer &
+MediaClock::Pacer::operator=(Pacer &&other) noexcept {
+  if (this != &other) {
+    stop();
+    entry_ = std::move(other.entry_);
+  }
+  return *this;
+}
+
+void MediaClock::Pacer::stop() {
+  if (!entry_) {
+    return;
+  }
+  if (auto clock = entry_->clock.lock()) {
+    clock->stop(entry_);
+  }
+}
+
+bool MediaClock::Pacer::active() const noexcept {
+  return entry_ && !entry_->stopped.load(std::memory_order_acquire);
+}
+
+PacerStats MediaClock::Pacer::stats() const {
+  PacerStats stats;
+  if (entry_) {
+    stats.ticks = entry_->ticks.load(std::memory_order_relaxed);
+    stats.missed_ticks = entry_->missed.load(std::memory_order_relaxed);
+    stats.lateness = entry_->lateness.snapshot();
+  }
+  return stats;
+}
+
+MediaClock::MediaClock() : impl_(std::make_shared<Impl>()) { impl_->start(); }
+
+MediaClock::~MediaClock() { impl_->shutdown(); }
+
+MediaClock &MediaClock::shared() {
+  static MediaClock clock;
+  return clock;
+}
+
+MediaClock::Pacer MediaClock::schedule(std::chrono::nanoseconds period,
+                                       TickCallback callback) {
+  return schedule(period, std::move(callback), PacerOptions{});
+}
+
+MediaClock::Pacer MediaClock::schedule(std::chrono::nanoseconds period,
+                                       TickCallback callback,
+                                       const PacerOptions &options) {
+  if (period.count() <= 0) {
+    throw std::invalid_argument("MediaClock::schedule: period must be > 0");
+  }
+  if (!callback) {
+    throw std::invalid_argument("MediaClock::schedule: empty callback");
+  }
+  Pacer pacer;
+  pacer.entry_ = std::make_shared<Pacer::Entry>(period, std::move(callback),
+                                                options, impl_);
+  impl_->add(pacer.entry_);
+  return pacer;
+}
+
+std::size_t MediaClock::activePacers() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  return impl_->active;
+}
+
+std::chrono::nanoseconds MediaClock::framePeriod(double fps) {
+  if (!(fps > 0.0)) {
+    throw std::invalid_argument("MediaClock::framePeriod: fps must be > 0");
+  }
+  return std::chrono::nanoseconds(std::llround(1e9 / fps));
+}
+
+// ============================================================================
+// FramePacer
+// ============================================================================
+
+FramePacer::FramePacer(std::chrono::nanoseconds period, bool skip_missed)
+    : period_(period), skip_missed_(skip_missed), start_(Clock::now()),
+      lateness_(std::make_unique<detail::LatencyHistogram>()) {
+  if (period.count() <= 0) {
+    throw std::invalid_argument("FramePacer: period must be > 0");
+  }
+}
+
+FramePacer::~FramePacer() = default;
+
+std::uint64_t FramePacer::wait() {
+  ++tick_;
+  std::this_thread::sleep_until(deadlineOf(start_, period_, tick_));
+  const Clock::time_point now = Clock::now();
+  missed_ += skipLate(start_, period_, skip_missed_, now, tick_);
+  lateness_->record(toMicros(now - deadlineOf(start_, period_, tick_)));
+  ++ticks_;
+  return tick_;
+}
+
+void FramePacer::reset() {
+  start_ = Clock::now();
+  tick_ = 0;
+}
+
+PacerStats FramePacer::stats() const {
+  PacerStats stats;
+  stats.ticks = ticks_;
+  stats.missed_ticks = missed_;
+  stats.lateness = lateness_->snapshot();
+  return stats;
+}
+
+} // namespace livekit
@@ -0,0 +1,554 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/media_recorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "livekit/audio_frame.h"
+#include "livekit/video_frame.h"
+#include "spsc_ring.h"
+#include "thread_util.h"
+
+namespace livekit {
+
+namespace {
+
+constexpr std::size_t kWriteAlignment = 4096;
+
+// Accumulates output in one page-aligned buffer and writes it to an
+// unbuffered FILE only when it is full (or on flush()), so the file sees a
+// few large writes instead of one per frame. Used by the I/O thread only.
+class AlignedFileWriter {
+public:
+  AlignedFileWriter(const std::string &path, std::size_t buffer_bytes) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+      throw std::runtime_error("MediaRecorder: cannot open " + path);
+    }
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+    const std::size_t bytes = std::max(buffer_bytes, kWriteAlignment);
+    capacity_ = (bytes + kWriteAlignment - 1) / kWriteAlignment *
+                kWriteAlignment;
+    buffer_ = static_cast<std::uint8_t *>(
+        ::operator new(capacity_, std::align_val_t(kWriteAlignment)));
+  }
+
+  ~AlignedFileWriter() {
+    close();
+    ::operator delete(buffer_, std::align_val_t(kWriteAlignment));
+  }
+
+  AlignedFileWriter(const AlignedFileWriter &) = delete;
+  AlignedFileWriter &operator=(const AlignedFileWriter &) = delete;
+
+  void append(const void *data, std::size_t len) {
+    const auto *src = static_cast<const std::uint8_t *>(data);
+    appended_ += len;
+    while (len > 0) {
+      const std::size_t n = std::min(len, capacity_ - used_);
+      std::memcpy(buffer_ + used_, src, n);
+      used_ += n;
+      src += n;
+      len -= n;
+      if (used_ == capacity_) {
+        flush();
+      }
+    }
+  }
+
+  void flush() {
+    if (used_ == 0) {
+      return;
+    }
+    if (file_ && !failed_) {
+      if (std::fwrite(buffer_, 1, used_, file_) == used_) {
+        written_.fetch_add(used_, std::memory_order_relaxed);
+      } else {
+        fail();
+      }
+    }
+    used_ = 0;
+  }
+
+  // Overwrite `len` bytes at `offset`, which must already be flushed.
+  void patch(long offset, const void *data, std::size_t len) {
+    if (!file_ || failed_) {
+      return;
+    }
+    if (std::fseek(file_, offset, SEEK_SET) != 0 ||
+        std::fwrite(data, 1, len, file_) != len) {
+      fail();
+    }
+    std::fseek(file_, 0, SEEK_END);
+  }
+
+  void close() {
+    if (!file_) {
+      return;
+    }
+    flush();
+    if (std::fclose(file_) != 0 && !failed_) {
+      fail();
+    }
+    file_ = nullptr;
+  }
+
+  // Bytes passed to append(), written or not.
+  std::uint64_t appended() const noexcept { return appended_; }
+
+  std::uint64_t written() const noexcept {
+    return written_.load(std::memory_order_relaxed);
+  }
+  std::uint64_t errors() const noexcept {
+    return errors_.load(std::memory_order_relaxed);
+  }
+
+private:
+  void fail() {
+    failed_ = true;
+    errors_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::FILE *file_{nullptr};
+  std::uint8_t *buffer_{nullptr};
+  std::size_t capacity_{0};
+  std::size_t used_{0};
+  std::uint64_t appended_{0};
+  bool failed_{false};
+  std::atomic<std::uint64_t> written_{0};
+  std::atomic<std::uint64_t> errors_{0};
+};
+
+void putLe16(std::uint8_t *p, std::uint16_t v) {
+  p[0] = static_cast<std::uint8_t>(v);
+  p[1] = static_cast<std::uint8_t>(v >> 8);
+}
+
+void putLe32(std::uint8_t *p, std::uint32_t v) {
+  putLe16(p, static_cast<std::uint16_t>(v));
+  putLe16(p + 2, static_cast<std::uint16_t>(v >> 16));
+}
+
+std::uint32_t clampU32(std::uint64_t v) {
+  return static_cast<std::uint32_t>(std::min<std::uint64_t>(v, 0xFFFFFFFFu));
+}
+
+// Queue bookkeeping shared by both recorders. push() runs on the producer,
+// run() on the I/O thread.
+template <typename Item> struct RecorderQueue {
+  RecorderQueue(const std::string &path, std::size_t queue_frames,
+                std::size_t write_buffer_bytes)
+      : writer(path, write_buffer_bytes),
+        ring(queue_frames == 0 ? 1 : queue_frames) {}
+
+  bool push(Item &&item) {
+    if (ring.closed() || ring.size() >= ring.capacity()) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    ring.push(std::move(item));
+    const std::size_t depth = ring.size();
+    if (depth > max_depth.load(std::memory_order_relaxed)) {
+      max_depth.store(depth, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  MediaRecorderStats stats() const {
+    MediaRecorderStats s;
+    s.frames_written = written_frames.load(std::memory_order_relaxed);
+    s.frames_dropped = dropped.load(std::memory_order_relaxed);
+    s.bytes_written = writer.written();
+    s.write_errors = writer.errors();
+    s.queue_depth = ring.size();
+    s.max_queue_depth = max_depth.load(std::memory_order_relaxed);
+    return s;
+  }
+
+  AlignedFileWriter writer;
+  detail::SpscRing<Item> ring;
+  std::atomic<std::uint64_t> written_frames{0};
+  std::atomic<std::uint64_t> dropped{0};
+  std::atomic<std::size_t> max_depth{0};
+  std::thread worker;
+  std::once_flag closed;
+};
+
+} // namespace
+
+// ============================================================================
+// AudioRecorder
+// ============================================================================
+
+namespace {
+
+// Either a native view (from a stream) or an owned frame (from the app).
+struct AudioItem {
+  AudioFrameView view;
+  AudioFrame frame;
+
+  const std::int16_t *data() const noexcept {
+    return view.valid() ? view.data() : frame.data().data();
+  }
+  std::size_t total_samples() const noexcept {
+    return view.valid() ? view.total_samples() : frame.total_samples();
+  }
+  int sample_rate() const noexcept {
+    return view.valid() ? view.sample_rate() : frame.sample_rate();
+  }
+  int num_channels() const noexcept {
+    return view.valid() ? view.num_channels() : frame.num_channels();
+  }
+};
+
+constexpr std::size_t kWavHeaderBytes = 44;
+
+} // namespace
+
+struct AudioRecorder::Impl : RecorderQueue<AudioItem> {
+  Impl(const std::string &path, const Options &options)
+      : RecorderQueue(path, options.queue_frames, options.write_buffer_bytes) {
+    worker = std::thread([this] {
+      detail::registerThread(ThreadRole::kBackground, "lk-rec-audio");
+      run();
+    });
+  }
+
+  void run() {
+    AudioItem item;
+    while (ring.pop(item)) {
+      write(item);
+      item = AudioItem{}; // release the native buffer now
+    }
+    if (sample_rate_ != 0) {
+      writer.flush();
+      std::uint8_t sizes[4];
+      const std::uint64_t data_bytes = writer.appended() - kWavHeaderBytes;
+      putLe32(sizes, clampU32(data_bytes + kWavHeaderBytes - 8));
+      writer.patch(4, sizes, 4);
+      putLe32(sizes, clampU32(data_bytes));
+      writer.patch(40, sizes, 4);
+    }
+    writer.close();
+  }
+
+  void write(const AudioItem &item) {
+    if (item.total_samples() == 0) {
+      return;
+    }
+    if (sample_rate_ == 0) {
+      sample_rate_ = item.sample_rate();
+      num_channels_ = item.num_channels();
+      writeHeader();
+    } else if (item.sample_rate() != sample_rate_ ||
+               item.num_channels() != num_channels_) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    writer.append(item.data(), item.total_samples() * sizeof(std::int16_t));
+    written_frames.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Sizes are left at 0 and patched once the recording ends.
+  void writeHeader() {
+    const auto rate = static_cast<std::uint32_t>(sample_rate_);
+    const auto channels = static_cast<std::uint16_t>(num_channels_);
+    std::uint8_t h[kWavHeaderBytes] = {};
+    std::memcpy(h, "RIFF", 4);
+    std::memcpy(h + 8, "WAVEfmt ", 8);
+    putLe32(h + 16, 16);
+    putLe16(h + 20, 1); // PCM
+    putLe16(h + 22, channels);
+    putLe32(h + 24, rate);
+    putLe32(h + 28, rate * channels * 2);
+    putLe16(h + 32, static_cast<std::uint16_t>(channels * 2));
+    putLe16(h + 34, 16);
+    std::memcpy(h + 36, "data", 4);
+    writer.append(h, sizeof(h));
+  }
+
+  // I/O thread only.
+  int sample_rate_{0};
+  int num_channels_{0};
+};
+
+AudioRecorder::AudioRecorder(const std::string &path)
+    : AudioRecorder(path, Options{}) {}
+
+AudioRecorder::AudioRecorder(const std::string &path, const Options &options)
+    : impl_(std::make_shared<Impl>(path, options)) {}
+
+AudioRecorder::~AudioRecorder() { close(); }
+
+AudioStream::Options AudioRecorder::streamOptions() const {
+  AudioStream::Options options;
+  // The callbacks keep the queue alive, so a stream outliving the recorder
+  // only drops its frames.
+  std::shared_ptr<Impl> impl = impl_;
+  options.on_frame = [impl](AudioFrameViewEvent &&ev) {
+    AudioItem item;
+    item.view = std::move(ev.frame);
+    impl->push(std::move(item));
+  };
+  options.on_eos = [impl] { impl->ring.close(); };
+  return options;
+}
+
+std::shared_ptr<AudioStream>
+AudioRecorder::attach(const std::shared_ptr<Track> &track) {
+  return AudioStream::fromTrack(track, streamOptions());
+}
+
+bool AudioRecorder::push(AudioFrameView &&frame) {
+  AudioItem item;
+  item.view = std::move(frame);
+  return impl_->push(std::move(item));
+}
+
+bool AudioRecorder::push(AudioFrame &&frame) {
+  AudioItem item;
+  item.frame = std::move(frame);
+  return impl_->push(std::move(item));
+}
+
+void AudioRecorder::close() {
+  std::call_once(impl_->closed, [this] {
+    impl_->ring.close();
+    impl_->worker.join();
+  });
+}
+
+MediaRecorderStats AudioRecorder::stats() const { return impl_->stats(); }
+
+// ============================================================================
+// VideoRecorder
+// ============================================================================
+
+namespace {
+
+struct VideoItem {
+  VideoFrame frame;
+  std::int64_t timestamp_us{0};
+};
+
+// Longest gap filled by repeating the previous frame.
+constexpr std::int64_t kMaxGapSeconds = 10;
+
+} // namespace
+
+struct VideoRecorder::Impl : RecorderQueue<VideoItem> {
+  Impl(const std::string &path, const Options &opts)
+      : RecorderQueue(path, opts.queue_frames, opts.write_buffer_bytes),
+        options(opts), width_(opts.width), height_(opts.height) {
+    worker = std::thread([this] {
+      detail::registerThread(ThreadRole::kBackground, "lk-rec-video");
+      run();
+    });
+  }
+
+  void run() {
+    VideoItem item;
+    while (ring.pop(item)) {
+      if (options.constant_frame_rate) {
+        place(std::move(item));
+      } else {
+        write(item.frame, 1);
+      }
+      item = VideoItem{};
+    }
+    if (have_last_) {
+      write(last_.frame, 1);
+      last_ = VideoItem{};
+    }
+    writer.close();
+  }
+
+  // Constant frame rate: a frame is written once its successor shows how
+  // many slots it covers.
+  void place(VideoItem &&item) {
+    if (!have_last_) {
+      base_us_ = item.timestamp_us;
+      last_ = std::move(item);
+      have_last_ = true;
+      return;
+    }
+    const std::int64_t slot = slotOf(item.timestamp_us);
+    std::int64_t repeats = slot - slots_written_;
+    if (repeats > kMaxGapSeconds * options.fps) {
+      // Shift the grid so the new frame follows right after this one.
+      base_us_ += (repeats - 1) * 1000000 / options.fps;
+      repeats = 1;
+    }
+    if (repeats > 0) {
+      write(last_.frame, repeats);
+      slots_written_ += repeats;
+    }
+    last_ = std::move(item);
+  }
+
+  std::int64_t slotOf(std::int64_t timestamp_us) const {
+    const double seconds = static_cast<double>(timestamp_us - base_us_) / 1e6;
+    return std::llround(seconds * options.fps);
+  }
+
+  void write(const VideoFrame &frame, std::int64_t copies) {
+    if (frame.width() <= 0 || frame.height() <= 0) {
+      return;
+    }
+    const VideoFrame *i420 = toOutput(frame);
+    if (!i420) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    const VideoPlanes planes = i420->planes();
+    if (planes.size() < 3) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    for (std::int64_t i = 0; i < copies; ++i) {
+      static constexpr char kFrame[] = "FRAME\n";
+      writer.append(kFrame, sizeof(kFrame) - 1);
+      for (std::size_t p = 0; p < 3; ++p) {
+        const int w = p == 0 ? width_ : (width_ + 1) / 2;
+        const int h = p == 0 ? height_ : (height_ + 1) / 2;
+        const auto *row = reinterpret_cast<const std::uint8_t *>(
+            planes[p].data_ptr);
+        for (int y = 0; y < h; ++y, row += planes[p].stride) {
+          writer.append(row, static_cast<std::size_t>(w));
+        }
+      }
+    }
+    written_frames.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // `frame` itself if it is already I420 at the output size, otherwise
+  // the converted and/or scaled copy in scratch_. Null on failure.
+  const VideoFrame *toOutput(const VideoFrame &frame) {
+    if (width_ == 0 || height_ == 0) {
+      width_ = frame.width();
+      height_ = frame.height();
+    }
+    if (!header_written_) {
+      char header[96];
+      const int n = std::snprintf(header, sizeof(header),
+                                  "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",
+                                  width_, height_, options.fps);
+      writer.append(header, static_cast<std::size_t>(n));
+      header_written_ = true;
+    }
+    const bool same_size =
+        frame.width() == width_ && frame.height() == height_;
+    if (frame.type() == VideoBufferType::I420 && same_size) {
+      return &frame;
+    }
+    try {
+      if (scratch_.width() != width_ || scratch_.height() != height_) {
+        scratch_ = VideoFrame::create(width_, height_, VideoBufferType::I420);
+      }
+      if (frame.type() == VideoBufferType::I420) {
+        frame.scaleInto(scratch_);
+      } else if (same_size) {
+        frame.convertInto(scratch_);
+      } else {
+        frame.convert(VideoBufferType::I420).scaleInto(scratch_);
+      }
+      return &scratch_;
+    } catch (const std::exception &) {
+      return nullptr;
+    }
+  }
+
+  const Options options;
+
+  // I/O thread only.
+  int width_;
+  int height_;
+  bool header_written_{false};
+  VideoFrame scratch_;
+  VideoItem last_;
+  bool have_last_{false};
+  std::int64_t base_us_{0};
+  std::int64_t slots_written_{0};
+};
+
+VideoRecorder::VideoRecorder(const std::string &path)
+    : VideoRecorder(path, Options{}) {}
+
+VideoRecorder::VideoRecorder(const std::string &path, const Options &options) {
+  if (options.width < 0 || options.height < 0 ||
+      (options.width == 0) != (options.height == 0)) {
+    throw std::invalid_argument(
+        "VideoRecorder: width and height must both be set or both be 0");
+  }
+  if (options.fps <= 0) {
+    throw std::invalid_argument("VideoRecorder: fps must be positive");
+  }
+  impl_ = std::make_shared<Impl>(path, options);
+}
+
+VideoRecorder::~VideoRecorder() { close(); }
+
+VideoStream::Options VideoRecorder::streamOptions() const {
+  VideoStream::Options options;
+  options.format = VideoBufferType::I420;
+  options.zero_copy = true;
+  std::shared_ptr<Impl> impl = impl_;
+  options.on_frame = [impl](VideoFrameEvent &&ev) {
+    VideoItem item;
+    item.frame = std::move(ev.frame);
+    item.timestamp_us = ev.timestamp_us;
+    impl->push(std::move(item));
+  };
+  options.on_eos = [impl] { impl->ring.close(); };
+  return options;
+}
+
+std::shared_ptr<VideoStream>
+VideoRecorder::attach(const std::shared_ptr<Track> &track) {
+  return VideoStream::fromTrack(track, streamOptions());
+}
+
+bool VideoRecorder::push(VideoFrameEvent &&event) {
+  return push(std::move(event.frame), event.timestamp_us);
+}
+
+bool VideoRecorder::push(VideoFrame &&frame, std::int64_t timestamp_us) {
+  VideoItem item;
+  item.frame = std::move(frame);
+  item.timestamp_us = timestamp_us;
+  return impl_->push(std::move(item));
+}
+
+void VideoRecorder::close() {
+  std::call_once(impl_->closed, [this] {
+    impl_->ring.close();
+    impl_->worker.join();
+  });
+}
+
+MediaRecorderStats VideoRecorder::stats() const { return impl_->stats(); }
+
+} // namespace livekit
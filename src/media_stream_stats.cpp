@@ -0,0 +1,37 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "media_stream_stats.h"
+
+namespace livekit {
+namespace detail {
+
+MediaStreamStats
+MediaStreamStatsRecorder::snapshot(std::size_t depth,
+                                   std::uint64_t ring_dropped) const {
+  MediaStreamStats stats;
+  stats.frames_received = received_.load(std::memory_order_relaxed);
+  stats.frames_delivered = delivered_.load(std::memory_order_relaxed);
+  stats.frames_dropped =
+      evicted_.load(std::memory_order_relaxed) + ring_dropped;
+  stats.queue_depth = depth;
+  stats.max_queue_depth = max_depth_.load(std::memory_order_relaxed);
+  stats.queue_time = queue_time_.snapshot();
+  return stats;
+}
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/stream_stats.h"
+#include "rpc_metrics.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace livekit {
+namespace detail {
+
+// Counters behind AudioStream::stats() / VideoStream::stats(). The producer
+// (FFI event thread) and readers update it without locks.
+class MediaStreamStatsRecorder {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  void onReceived() noexcept {
+    received_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Producer only: `depth` is the queue depth right after a push.
+  void onQueued(std::size_t depth) noexcept {
+    if (depth > max_depth_.load(std::memory_order_relaxed)) {
+      max_depth_.store(depth, std::memory_order_relaxed);
+    }
+  }
+
+  void onEvicted() noexcept {
+    evicted_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Push mode: delivered without queueing.
+  void onDelivered() noexcept {
+    delivered_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void onDelivered(Clock::time_point enqueued, Clock::time_point now) noexcept {
+    delivered_.fetch_add(1, std::memory_order_relaxed);
+    queue_time_.record(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - enqueued));
+  }
+
+  // `ring_dropped` is SpscRing::dropped(), or 0 for the deque.
+  MediaStreamStats snapshot(std::size_t depth,
+                            std::uint64_t ring_dropped) const;
+
+private:
+  std::atomic<std::uint64_t> received_{0};
+  std::atomic<std::uint64_t> delivered_{0};
+  std::atomic<std::uint64_t> evicted_{0};
+  std::atomic<std::size_t> max_depth_{0};
+  LatencyHistogram queue_time_;
+};
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/metrics.h"
+
+#include "ffi_client.h"
+#include "latency_trace.h"
+#include "rpc_metrics.h"
+#include "sdk_metrics.h"
+
+namespace livekit {
+
+void setMetricsEnabled(bool enabled) {
+  detail::g_metrics_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool metricsEnabled() { return detail::metricsOn(); }
+
+std::string metricsToOpenMetrics() {
+  auto &client = FfiClient::instance();
+  detail::ScrapeGauges gauges;
+  gauges.pending_async_operations = client.pendingAsyncCount();
+  gauges.listeners = client.listenerCount();
+  gauges.threads = threadCpuStats();
+  const LatencyTraceReport trace = latencyTraceReport();
+  return detail::renderOpenMetrics(detail::SdkMetrics::instance(),
+                                   rpcMetrics(), gauges, &trace);
+}
+
+void resetMetrics() {
+  detail::SdkMetrics::instance().reset();
+  resetRpcMetrics();
+}
+
+} // namespace livekit
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <string>
+
+namespace livekit {
+
+// Random lowercase hex id of `bytes` bytes, used for stream and transfer ids.
+inline std::string generateRandomId(std::size_t bytes = 16) {
+  static thread_local std::mt19937_64 rng{std::random_device{}()};
+  std::uniform_int_distribution<int> dist(0, 255);
+
+  std::string out;
+  out.reserve(bytes * 2);
+  const char *hex = "0123456789abcdef";
+  for (std::size_t i = 0; i < bytes; ++i) {
+    int v = dist(rng);
+    out.push_back(hex[(v >> 4) & 0xF]);
+    out.push_back(hex[v & 0xF]);
+  }
+  return out;
+}
+
+} // namespace livekit
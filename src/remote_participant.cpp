@@ -16,6 +16,7 @@
 
 #include "livekit/remote_participant.h"
 
+#include <atomic>
 #include <ostream>
 #include <sstream>
 #include <utility>
@@ -26,13 +27,45 @@ namespace livekit {
 
 RemoteParticipant::RemoteParticipant(
     FfiHandle handle, std::string sid, std::string name, std::string identity,
-    std::string metadata,
-    std::unordered_map<std::string, std::string> attributes,
-    ParticipantKind kind, DisconnectReason reason)
+    std::string metadata, AttributeMap attributes, ParticipantKind kind,
+    DisconnectReason reason)
     : Participant(std::move(handle), std::move(sid), std::move(name),
                   std::move(identity), std::move(metadata),
                   std::move(attributes), kind, reason),
-      track_publications_() {}
+      track_publications_(std::make_shared<const PublicationMap>()) {}
+
+std::shared_ptr<const RemoteParticipant::PublicationMap>
+RemoteParticipant::trackPublicationsSnapshot() const {
+  return std::atomic_load(&track_publications_);
+}
+
+std::shared_ptr<RemoteTrackPublication>
+RemoteParticipant::trackPublication(const std::string &sid) const {
+  const auto snapshot = trackPublicationsSnapshot();
+  auto it = snapshot->find(sid);
+  return it == snapshot->end() ? nullptr : it->second;
+}
+
+void RemoteParticipant::storePublication(
+    std::shared_ptr<RemoteTrackPublication> publication) {
+  std::lock_guard<std::mutex> g(publications_write_mutex_);
+  auto next = std::make_shared<PublicationMap>(*track_publications_);
+  const std::string sid = publication->sid();
+  next->emplace(sid, std::move(publication));
+  std::atomic_store(&track_publications_,
+                    std::shared_ptr<const PublicationMap>(std::move(next)));
+}
+
+void RemoteParticipant::erasePublication(const std::string &sid) {
+  std::lock_guard<std::mutex> g(publications_write_mutex_);
+  if (track_publications_->find(sid) == track_publications_->end()) {
+    return;
+  }
+  auto next = std::make_shared<PublicationMap>(*track_publications_);
+  next->erase(sid);
+  std::atomic_store(&track_publications_,
+                    std::shared_ptr<const PublicationMap>(std::move(next)));
+}
 
 std::string RemoteParticipant::to_string() const {
   std::ostringstream oss;
@@ -49,11 +82,7 @@ std::ostream &operator<<(std::ostream &os,
 
 std::shared_ptr<TrackPublication>
 RemoteParticipant::findTrackPublication(const std::string &sid) const {
-  auto it = track_publications_.find(sid);
-  if (it == track_publications_.end()) {
-    return nullptr;
-  }
-  return std::static_pointer_cast<TrackPublication>(it->second);
+  return trackPublication(sid);
 }
 
 } // namespace livekit
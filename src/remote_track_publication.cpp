@@ -16,6 +16,10 @@
 
 #include "livekit/remote_track_publication.h"
 
+#include <stdexcept>
+#include <string>
+
+#include "adaptive_stream.h"
 #include "ffi.pb.h"
 #include "ffi_client.h"
 #include "livekit/track.h"
@@ -26,7 +30,8 @@ namespace livekit {
 RemoteTrackPublication::RemoteTrackPublication(
     const proto::OwnedTrackPublication &owned)
     : TrackPublication(
-          FfiHandle(owned.handle().id()), owned.info().sid(),
+          FfiHandle(owned.handle().id(), ResourceKind::kTrackPublication),
+          owned.info().sid(),
           owned.info().name(), fromProto(owned.info().kind()),
           fromProto(owned.info().source()), owned.info().simulcasted(),
           owned.info().width(), owned.info().height(), owned.info().mime_type(),
@@ -39,11 +44,15 @@ std::shared_ptr<Track> RemoteTrackPublication::track() const noexcept {
   return std::static_pointer_cast<Track>(base);
 }
 
-void RemoteTrackPublication::setSubscribed(bool subscribed) {
+void RemoteTrackPublication::requireHandle(const char *what) const {
   if (ffiHandleId() == 0) {
-    throw std::runtime_error(
-        "RemoteTrackPublication::setSubscribed: invalid FFI handle");
+    throw std::runtime_error(std::string("RemoteTrackPublication::") + what +
+                             ": invalid FFI handle");
   }
+}
+
+void RemoteTrackPublication::setSubscribed(bool subscribed) {
+  requireHandle("setSubscribed");
 
   proto::FfiRequest req;
   auto *msg = req.mutable_set_subscribed();
@@ -58,4 +67,27 @@ void RemoteTrackPublication::setSubscribed(bool subscribed) {
   subscribed_ = subscribed;
 }
 
+void RemoteTrackPublication::setEnabled(bool enabled) {
+  requireHandle("setEnabled");
+
+  FfiClient::instance().sendRequest(enableRemoteTrackPublicationRequest(
+      static_cast<std::uint64_t>(ffiHandleId()), enabled));
+
+  enabled_ = enabled;
+}
+
+void RemoteTrackPublication::setVideoDimensions(std::uint32_t width,
+                                                std::uint32_t height) {
+  requireHandle("setVideoDimensions");
+
+  FfiClient::instance().sendRequest(remoteTrackPublicationDimensionRequest(
+      static_cast<std::uint64_t>(ffiHandleId()), width, height));
+}
+
+void RemoteTrackPublication::setVideoQuality(VideoQuality quality) {
+  const auto dimensions =
+      detail::videoQualityDimensions(quality, width(), height());
+  setVideoDimensions(dimensions.first, dimensions.second);
+}
+
 } // namespace livekit
@@ -25,7 +25,8 @@
 namespace livekit {
 
 RemoteVideoTrack::RemoteVideoTrack(const proto::OwnedTrack &track)
-    : Track(FfiHandle{static_cast<uintptr_t>(track.handle().id())},
+    : Track(FfiHandle{static_cast<uintptr_t>(track.handle().id()),
+                      ResourceKind::kTrack},
             track.info().sid(), track.info().name(),
             fromProto(track.info().kind()),
             fromProto(track.info().stream_state()), track.info().muted(),
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/resources.h"
+
+#include "sdk_metrics.h"
+
+namespace livekit {
+
+const char *resourceKindName(ResourceKind kind) noexcept {
+  switch (kind) {
+  case ResourceKind::kRoom:
+    return "room";
+  case ResourceKind::kParticipant:
+    return "participant";
+  case ResourceKind::kTrack:
+    return "track";
+  case ResourceKind::kTrackPublication:
+    return "track_publication";
+  case ResourceKind::kAudioSource:
+    return "audio_source";
+  case ResourceKind::kVideoSource:
+    return "video_source";
+  case ResourceKind::kAudioStream:
+    return "audio_stream";
+  case ResourceKind::kVideoStream:
+    return "video_stream";
+  case ResourceKind::kAudioBuffer:
+    return "audio_buffer";
+  case ResourceKind::kVideoBuffer:
+    return "video_buffer";
+  case ResourceKind::kDataBuffer:
+    return "data_buffer";
+  case ResourceKind::kAudioProcessor:
+    return "audio_processor";
+  case ResourceKind::kOther:
+  default:
+    return "other";
+  }
+}
+
+ResourceSnapshot resourceSnapshot() {
+  const auto &sdk = detail::SdkMetrics::instance();
+  ResourceSnapshot snap;
+  for (std::size_t i = 0; i < kResourceKindCount; ++i) {
+    snap.live_handles[i] =
+        sdk.resources.live_handles[i].load(std::memory_order_relaxed);
+  }
+  snap.audio_stream_bytes =
+      sdk.audio.queued_bytes.load(std::memory_order_relaxed);
+  snap.video_stream_bytes =
+      sdk.video.queued_bytes.load(std::memory_order_relaxed);
+  snap.stream_reader_bytes =
+      sdk.resources.stream_reader_bytes.load(std::memory_order_relaxed);
+  return snap;
+}
+
+} // namespace livekit
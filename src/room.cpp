@@ -28,15 +28,25 @@
 #include "livekit/room_event_types.h"
 #include "livekit/video_stream.h"
 
+#include "compact_participants.h"
+#include "e2ee_internal.h"
+#include "event_replay.h"
 #include "ffi.pb.h"
 #include "ffi_client.h"
 #include "livekit_ffi.h"
 #include "room.pb.h"
 #include "room_proto_converter.h"
+#include "sdk_metrics.h"
 #include "track.pb.h"
+#include "stream_budget.h"
+#include "stream_dispatcher.h"
 #include "track_proto_converter.h"
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <unordered_map>
 
 namespace livekit {
 
@@ -48,32 +58,101 @@ using proto::FfiResponse;
 
 namespace {
 
-std::shared_ptr<livekit::RemoteParticipant>
-createRemoteParticipant(const proto::OwnedParticipant &owned) {
-  const auto &pinfo = owned.info();
-  std::unordered_map<std::string, std::string> attrs;
-  attrs.reserve(pinfo.attributes_size());
-  for (const auto &kv : pinfo.attributes()) {
-    attrs.emplace(kv.first, kv.second);
+// Protobuf maps iterate in unspecified order; AttributeMap sorts once.
+template <typename ProtoMap>
+livekit::AttributeMap attributesFromProto(const ProtoMap &src) {
+  livekit::AttributeMap::container_type entries;
+  entries.reserve(src.size());
+  for (const auto &kv : src) {
+    entries.emplace_back(kv.first, kv.second);
   }
-  auto kind = livekit::fromProto(pinfo.kind());
-  auto reason = livekit::toDisconnectReason(pinfo.disconnect_reason());
-  livekit::FfiHandle handle(static_cast<uintptr_t>(owned.handle().id()));
+  return livekit::AttributeMap(std::move(entries));
+}
+
+livekit::detail::ParticipantFields
+participantFields(const proto::OwnedParticipant &owned) {
+  const auto &pinfo = owned.info();
+  livekit::detail::ParticipantFields fields;
+  fields.handle =
+      livekit::FfiHandle(static_cast<uintptr_t>(owned.handle().id()),
+                         livekit::ResourceKind::kParticipant);
+  fields.sid = pinfo.sid();
+  fields.identity = pinfo.identity();
+  fields.name = pinfo.name();
+  fields.metadata = pinfo.metadata();
+  fields.attributes = attributesFromProto(pinfo.attributes());
+  fields.kind = livekit::fromProto(pinfo.kind());
+  fields.reason = livekit::toDisconnectReason(pinfo.disconnect_reason());
+  return fields;
+}
+
+std::shared_ptr<livekit::RemoteParticipant>
+createRemoteParticipant(livekit::detail::ParticipantFields fields) {
   return std::make_shared<livekit::RemoteParticipant>(
-      std::move(handle), pinfo.sid(), pinfo.name(), pinfo.identity(),
-      pinfo.metadata(), std::move(attrs), kind, reason);
+      std::move(fields.handle), std::move(fields.sid), std::move(fields.name),
+      std::move(fields.identity), std::move(fields.metadata),
+      std::move(fields.attributes), fields.kind, fields.reason);
+}
+
+// RoomOptions::fast_resume: rtc_config of the last successful connect per
+// server URL. Bounded, since a process may talk to many servers.
+constexpr std::size_t kMaxCachedRtcConfigs = 64;
+std::mutex g_rtc_cache_mutex;
+std::unordered_map<std::string, RtcConfig> g_rtc_cache;
+
+std::optional<RtcConfig> cachedRtcConfig(const std::string &url) {
+  std::lock_guard<std::mutex> g(g_rtc_cache_mutex);
+  auto it = g_rtc_cache.find(url);
+  if (it == g_rtc_cache.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void rememberRtcConfig(const std::string &url, const RtcConfig &config) {
+  std::lock_guard<std::mutex> g(g_rtc_cache_mutex);
+  if (g_rtc_cache.size() >= kMaxCachedRtcConfigs &&
+      g_rtc_cache.find(url) == g_rtc_cache.end()) {
+    g_rtc_cache.clear();
+  }
+  g_rtc_cache[url] = config;
+}
+
+// Leaked so rooms destroyed during static destruction can still release it.
+const std::shared_ptr<const RemoteParticipantSnapshot> &emptySnapshot() {
+  static const auto *empty =
+      new std::shared_ptr<const RemoteParticipantSnapshot>(
+          std::make_shared<const RemoteParticipantSnapshot>());
+  return *empty;
 }
 
 } // namespace
-Room::Room() {}
+
+Room::Room()
+    : participants_snapshot_(emptySnapshot()),
+      stream_dispatcher_(std::make_unique<detail::StreamDispatcher>()) {}
 
 Room::~Room() {
+  {
+    // A pending connectAsync() completion would set up this room; after
+    // livekit::shutdown() it never arrives.
+    std::unique_lock<std::mutex> g(connect_mutex_);
+    while (connect_pending_ && FfiClient::instance().isInitialized()) {
+      connect_cv_.wait_for(g, std::chrono::milliseconds(50));
+    }
+  }
   int listener_to_remove = 0;
+  int rpc_listener_to_remove = 0;
   std::unique_ptr<LocalParticipant> local_participant_to_cleanup;
   {
     std::lock_guard<std::mutex> g(lock_);
     listener_to_remove = listener_id_;
     listener_id_ = 0;
+    rpc_listener_to_remove = rpc_listener_id_;
+    rpc_listener_id_ = 0;
+  }
+  {
+    std::lock_guard<std::mutex> g(participants_lock_);
     // Move local participant out for cleanup outside the lock
     local_participant_to_cleanup = std::move(local_participant_);
   }
@@ -88,32 +167,111 @@ Room::~Room() {
   if (listener_to_remove != 0) {
     FfiClient::instance().RemoveListener(listener_to_remove);
   }
+  if (rpc_listener_to_remove != 0) {
+    FfiClient::instance().RemoveListener(rpc_listener_to_remove);
+  }
+
+  // With the listener gone no more stream events arrive; streams still open
+  // end as dropped, and callbacks queued on the built-in pool finish before
+  // the room is gone.
+  stream_dispatcher_.reset();
 
   // local_participant_to_cleanup is destroyed here after listener is removed
 }
 
 void Room::setDelegate(RoomDelegate *delegate) {
-  std::lock_guard<std::mutex> g(lock_);
-  delegate_ = delegate;
+  // Publish the mask before the delegate so OnEvent never pairs a new
+  // delegate with the previous delegate's mask.
+  delegate_.store(nullptr);
+  delegate_events_.store(delegate ? delegate->interestedEvents() : 0);
+  delegate_.store(delegate);
 }
 
 bool Room::Connect(const std::string &url, const std::string &token,
                    const RoomOptions &options) {
+  return connectAsync(url, token, options).get().connected;
+}
+
+AsyncOperation<ConnectResult> Room::connectAsync(const std::string &url,
+                                                 const std::string &token,
+                                                 const RoomOptions &options) {
+  const auto started = std::chrono::steady_clock::now();
+  beginConnect(started);
+
+  RoomOptions effective = options;
+  if (options.fast_resume && !effective.rtc_config) {
+    effective.rtc_config = cachedRtcConfig(url);
+  }
+
+  FfiClient::AsyncId async_id = 0;
+  std::future<ConnectResult> fut;
+  try {
+    fut = FfiClient::instance().connectAsync(
+        url, token, effective,
+        [this, url, effective](const ConnectCallback &cb) {
+          ConnectResult result = finishConnect(cb, effective);
+          if (result.connected && effective.fast_resume &&
+              effective.rtc_config) {
+            rememberRtcConfig(url, *effective.rtc_config);
+          }
+          return result;
+        },
+        &async_id);
+  } catch (const std::exception &e) {
+    // The request never reached the FFI, so no callback will follow.
+    std::cerr << "Room::Connect failed: " << e.what() << std::endl;
+    ConnectResult result;
+    result.error = e.what();
+    result.timing.request =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started);
+    result.timing.total = result.timing.request;
+    {
+      std::lock_guard<std::mutex> g(lock_);
+      connection_state_ = ConnectionState::Disconnected;
+      connect_timing_ = result.timing;
+    }
+    endConnect();
+    std::promise<ConnectResult> failed;
+    failed.set_value(std::move(result));
+    return AsyncOperation<ConnectResult>(failed.get_future(), 0);
+  }
+  connect_sent_ns_.store(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+  return AsyncOperation<ConnectResult>(std::move(fut), async_id);
+}
+
+ConnectResult Room::finishConnect(const ConnectCallback &connectCb,
+                                  const RoomOptions &options) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using Clock = std::chrono::steady_clock;
+  const auto joined = Clock::now();
+  Clock::time_point started;
   {
     std::lock_guard<std::mutex> g(lock_);
-    if (connection_state_ != ConnectionState::Disconnected) {
-      throw std::runtime_error("already connected");
-    }
-    connection_state_ = ConnectionState::Reconnecting;
+    started = connect_started_;
   }
-  auto fut = FfiClient::instance().connectAsync(url, token, options);
+  // If the callback beat connectAsync() to recording the send time, the
+  // whole wait counts as request time.
+  const std::int64_t sent_ns = connect_sent_ns_.load();
+  const auto sent =
+      sent_ns != 0 ? Clock::time_point(duration_cast<Clock::duration>(
+                         std::chrono::nanoseconds(sent_ns)))
+                   : joined;
+
+  ConnectResult result;
+  result.timing.request = duration_cast<microseconds>(sent - started);
+  result.timing.join = duration_cast<microseconds>(joined - sent);
   try {
-    auto connectCb =
-        fut.get(); // fut will throw if it fails to connect to the room
-
+    if (!connectCb.error().empty()) {
+      throw std::runtime_error(connectCb.error());
+    }
     const auto &owned_room = connectCb.result().room();
-    auto new_room_handle =
-        std::make_shared<FfiHandle>(owned_room.handle().id());
+    auto new_room_handle = std::make_shared<FfiHandle>(
+        owned_room.handle().id(), ResourceKind::kRoom);
     auto new_room_info = fromProto(owned_room.info());
 
     // Setup local particpant
@@ -122,37 +280,44 @@ bool Room::Connect(const std::string &url, const std::string &token,
       const auto &owned_local = connectCb.result().local_participant();
       const auto &pinfo = owned_local.info();
 
-      // Build attributes map
-      std::unordered_map<std::string, std::string> attrs;
-      for (const auto &kv : pinfo.attributes()) {
-        attrs.emplace(kv.first, kv.second);
-      }
+      auto attrs = attributesFromProto(pinfo.attributes());
 
       auto kind = fromProto(pinfo.kind());
       auto reason = toDisconnectReason(pinfo.disconnect_reason());
 
       // Participant base stores a weak_ptr<FfiHandle>, so share the room handle
       FfiHandle participant_handle(
-          static_cast<uintptr_t>(owned_local.handle().id()));
+          static_cast<uintptr_t>(owned_local.handle().id()),
+          ResourceKind::kParticipant);
       new_local_participant = std::make_unique<LocalParticipant>(
           std::move(participant_handle), pinfo.sid(), pinfo.name(),
           pinfo.identity(), pinfo.metadata(), std::move(attrs), kind, reason);
+      new_local_participant->setDataSendOptions(options.data_send);
     }
     // Setup remote participants
     std::unordered_map<std::string, std::shared_ptr<RemoteParticipant>>
         new_remote_participants;
+    std::unique_ptr<detail::CompactParticipantStore> new_compact_participants;
+    if (options.lazy_participants) {
+      new_compact_participants =
+          std::make_unique<detail::CompactParticipantStore>();
+    }
     {
       const auto &participants = connectCb.result().participants();
-      std::lock_guard<std::mutex> g(lock_);
       for (const auto &pt : participants) {
         const auto &owned = pt.participant();
-        auto rp = createRemoteParticipant(owned);
+        // Publishers are materialized right away; their publications need a
+        // participant to live on.
+        if (new_compact_participants && pt.publications_size() == 0) {
+          new_compact_participants->insert(participantFields(owned));
+          continue;
+        }
+        auto rp = createRemoteParticipant(participantFields(owned));
         // Add the initial remote participant tracks
         for (const auto &owned_publication_info : pt.publications()) {
           auto publication =
               std::make_shared<RemoteTrackPublication>(owned_publication_info);
-          rp->mutableTrackPublications().emplace(publication->sid(),
-                                                 std::move(publication));
+          rp->storePublication(std::move(publication));
         }
 
         new_remote_participants.emplace(rp->identity(), std::move(rp));
@@ -162,69 +327,206 @@ bool Room::Connect(const std::string &url, const std::string &token,
     // Setup e2eeManager
     std::unique_ptr<E2EEManager> new_e2ee_manager;
     if (options.encryption) {
-      std::cout << "creating E2eeManager " << std::endl;
-      e2ee_manager_ = std::unique_ptr<E2EEManager>(
-          new E2EEManager(room_handle_->get(), options.encryption.value()));
+      new_e2ee_manager = std::unique_ptr<E2EEManager>(new E2EEManager(
+          new_room_handle->get(), options.encryption.value()));
     }
 
-    // Publish all state atomically under lock
+    // Publish all state before any listener is installed. The state is
+    // marked Connected last, once participants and streams are in place.
+    {
+      std::lock_guard<std::mutex> g(participants_lock_);
+      local_participant_ = std::move(new_local_participant);
+      remote_participants_ = std::move(new_remote_participants);
+      compact_participants_ = std::move(new_compact_participants);
+      lazy_participants_.store(options.lazy_participants);
+      publishParticipantsLocked();
+    }
+    {
+      std::lock_guard<std::mutex> g(streams_lock_);
+      stream_budget_ =
+          std::make_shared<detail::StreamBudget>(options.stream_buffer);
+    }
     {
       std::lock_guard<std::mutex> g(lock_);
       room_handle_ = std::move(new_room_handle);
+      room_handle_id_.store(static_cast<std::uint64_t>(room_handle_->get()));
       room_info_ = std::move(new_room_info);
-      local_participant_ = std::move(new_local_participant);
-      remote_participants_ = std::move(new_remote_participants);
       e2ee_manager_ = std::move(new_e2ee_manager);
       connection_state_ = ConnectionState::Connected;
     }
 
-    // Install listener (Room is fully initialized)
-    auto listenerId = FfiClient::instance().AddListener(
+    // Install listeners (Room is fully initialized). FfiClient routes room
+    // events by room handle and RPC invocations by local participant handle,
+    // so this room only sees its own events. RPC invocations are dispatched
+    // in order with the room's events, so the EOS handler never releases
+    // the local participant while an invocation is still using it.
+    const auto room_handle_id =
+        static_cast<std::uint64_t>(owned_room.handle().id());
+    auto listenerId = FfiClient::instance().AddHandleListener(
+        FfiEvent::kRoomEvent, room_handle_id,
         std::bind(&Room::OnEvent, this, std::placeholders::_1));
+    auto rpcListenerId = FfiClient::instance().AddHandleListener(
+        FfiEvent::kRpcMethodInvocation,
+        static_cast<std::uint64_t>(
+            connectCb.result().local_participant().handle().id()),
+        std::bind(&Room::OnEvent, this, std::placeholders::_1),
+        room_handle_id);
     {
       std::lock_guard<std::mutex> g(lock_);
       listener_id_ = listenerId;
+      rpc_listener_id_ = rpcListenerId;
     }
 
-    return true;
+    result.connected = true;
   } catch (const std::exception &e) {
     // On error, set the connection_state_ to Disconnected
-    connection_state_ = ConnectionState::Disconnected;
+    {
+      std::lock_guard<std::mutex> g(lock_);
+      connection_state_ = ConnectionState::Disconnected;
+    }
     std::cerr << "Room::Connect failed: " << e.what() << std::endl;
-    return false;
+    result.error = e.what();
+  }
+  const auto done = Clock::now();
+  result.timing.setup = duration_cast<microseconds>(done - joined);
+  result.timing.total = duration_cast<microseconds>(done - started);
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    connect_timing_ = result.timing;
+  }
+  first_track_pending_.store(result.connected);
+  endConnect();
+  return result;
+}
+
+void Room::beginConnect(std::chrono::steady_clock::time_point started) {
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    if (connection_state_ != ConnectionState::Disconnected) {
+      throw std::runtime_error("already connected");
+    }
+    connection_state_ = ConnectionState::Reconnecting;
+    connect_timing_ = ConnectTiming{};
+    connect_started_ = started;
+    reconnect_stats_ = ReconnectStats{};
+  }
+  first_track_pending_.store(false);
+  connect_sent_ns_.store(0);
+  {
+    std::lock_guard<std::mutex> g(connect_mutex_);
+    connect_pending_ = true;
   }
 }
 
+void Room::endConnect() {
+  {
+    std::lock_guard<std::mutex> g(connect_mutex_);
+    connect_pending_ = false;
+  }
+  connect_cv_.notify_all();
+}
+
+bool detail::EventReplayAccess::attach(Room &room,
+                                      const ConnectCallback &cb) {
+  // The recording's handle ids are adopted as is; see
+  // EventReplayOptions::room.
+  room.beginConnect(std::chrono::steady_clock::now());
+  return room.finishConnect(cb, RoomOptions{}).connected;
+}
+
+ConnectTiming Room::connectTiming() const {
+  std::lock_guard<std::mutex> g(lock_);
+  return connect_timing_;
+}
+
+ReconnectStats Room::reconnectStats() const {
+  std::lock_guard<std::mutex> g(lock_);
+  return reconnect_stats_;
+}
+
 RoomInfoData Room::room_info() const {
   std::lock_guard<std::mutex> g(lock_);
   return room_info_;
 }
 
 LocalParticipant *Room::localParticipant() const {
-  std::lock_guard<std::mutex> g(lock_);
+  std::lock_guard<std::mutex> g(participants_lock_);
   return local_participant_.get();
 }
 
+RemoteParticipant *
+RemoteParticipantSnapshot::find(const std::string &identity) const {
+  auto it = by_identity.find(identity);
+  return it == by_identity.end() ? nullptr : it->second.get();
+}
+
 RemoteParticipant *Room::remoteParticipant(const std::string &identity) const {
-  std::lock_guard<std::mutex> g(lock_);
+  if (RemoteParticipant *rp = remoteParticipantsSnapshot()->find(identity)) {
+    return rp;
+  }
+  if (!lazy_participants_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  // Materializing does not change the set of participants the room reports.
+  std::lock_guard<std::mutex> g(participants_lock_);
+  return const_cast<Room *>(this)->findRemoteLocked(identity);
+}
+
+std::size_t Room::remoteParticipantCount() const {
+  std::lock_guard<std::mutex> g(participants_lock_);
+  return remote_participants_.size() +
+         (compact_participants_ ? compact_participants_->size() : 0);
+}
+
+RemoteParticipant *Room::findRemoteLocked(const std::string &identity) {
   auto it = remote_participants_.find(identity);
-  return it == remote_participants_.end() ? nullptr : it->second.get();
+  if (it != remote_participants_.end()) {
+    return it->second.get();
+  }
+  if (!compact_participants_) {
+    return nullptr;
+  }
+  auto fields = compact_participants_->take(identity);
+  if (!fields) {
+    return nullptr;
+  }
+  auto rp = createRemoteParticipant(std::move(*fields));
+  RemoteParticipant *raw = rp.get();
+  remote_participants_.emplace(identity, std::move(rp));
+  publishParticipantsLocked();
+  return raw;
 }
 
 std::vector<std::shared_ptr<RemoteParticipant>>
 Room::remoteParticipants() const {
-  std::lock_guard<std::mutex> guard(lock_);
-  std::vector<std::shared_ptr<RemoteParticipant>> out;
-  out.reserve(remote_participants_.size());
+  return remoteParticipantsSnapshot()->participants;
+}
+
+std::shared_ptr<const RemoteParticipantSnapshot>
+Room::remoteParticipantsSnapshot() const {
+  return std::atomic_load(&participants_snapshot_);
+}
+
+void Room::publishParticipantsLocked() {
+  auto next = std::make_shared<RemoteParticipantSnapshot>();
+  next->by_identity = remote_participants_;
+  next->participants.reserve(remote_participants_.size());
   for (const auto &kv : remote_participants_) {
-    out.push_back(kv.second);
+    next->participants.push_back(kv.second);
   }
-  return out;
+  next->version = participants_snapshot_->version + 1;
+  std::atomic_store(&participants_snapshot_,
+                    std::shared_ptr<const RemoteParticipantSnapshot>(
+                        std::move(next)));
 }
 
 void Room::registerTextStreamHandler(const std::string &topic,
                                      TextStreamHandler handler) {
-  std::lock_guard<std::mutex> g(lock_);
+  std::lock_guard<std::mutex> g(handlers_lock_);
+  if (text_stream_callbacks_.count(topic) != 0) {
+    throw std::runtime_error("text stream callbacks for topic '" + topic +
+                             "' already set");
+  }
   auto [it, inserted] =
       text_stream_handlers_.emplace(topic, std::move(handler));
   if (!inserted) {
@@ -234,13 +536,17 @@ void Room::registerTextStreamHandler(const std::string &topic,
 }
 
 void Room::unregisterTextStreamHandler(const std::string &topic) {
-  std::lock_guard<std::mutex> g(lock_);
+  std::lock_guard<std::mutex> g(handlers_lock_);
   text_stream_handlers_.erase(topic);
 }
 
 void Room::registerByteStreamHandler(const std::string &topic,
                                      ByteStreamHandler handler) {
-  std::lock_guard<std::mutex> g(lock_);
+  std::lock_guard<std::mutex> g(handlers_lock_);
+  if (byte_stream_callbacks_.count(topic) != 0) {
+    throw std::runtime_error("byte stream callbacks for topic '" + topic +
+                             "' already set");
+  }
   auto [it, inserted] =
       byte_stream_handlers_.emplace(topic, std::move(handler));
   if (!inserted) {
@@ -250,19 +556,95 @@ void Room::registerByteStreamHandler(const std::string &topic,
 }
 
 void Room::unregisterByteStreamHandler(const std::string &topic) {
-  std::lock_guard<std::mutex> g(lock_);
+  std::lock_guard<std::mutex> g(handlers_lock_);
   byte_stream_handlers_.erase(topic);
 }
 
-void Room::OnEvent(const FfiEvent &event) {
-  // Take a snapshot of the delegate under lock, but do NOT call it under the
-  // lock.
-  RoomDelegate *delegate_snapshot = nullptr;
+void Room::registerTextStreamCallbacks(const std::string &topic,
+                                       TextStreamOpenHandler handler) {
+  std::lock_guard<std::mutex> g(handlers_lock_);
+  if (text_stream_handlers_.count(topic) != 0 ||
+      !text_stream_callbacks_.emplace(topic, std::move(handler)).second) {
+    throw std::runtime_error("text stream handler for topic '" + topic +
+                             "' already set");
+  }
+}
+
+void Room::unregisterTextStreamCallbacks(const std::string &topic) {
+  std::lock_guard<std::mutex> g(handlers_lock_);
+  text_stream_callbacks_.erase(topic);
+}
 
+void Room::registerByteStreamCallbacks(const std::string &topic,
+                                       ByteStreamOpenHandler handler) {
+  std::lock_guard<std::mutex> g(handlers_lock_);
+  if (byte_stream_handlers_.count(topic) != 0 ||
+      !byte_stream_callbacks_.emplace(topic, std::move(handler)).second) {
+    throw std::runtime_error("byte stream handler for topic '" + topic +
+                             "' already set");
+  }
+}
+
+void Room::unregisterByteStreamCallbacks(const std::string &topic) {
+  std::lock_guard<std::mutex> g(handlers_lock_);
+  byte_stream_callbacks_.erase(topic);
+}
+
+void Room::setStreamCallbackExecutor(StreamExecutor executor) {
+  stream_dispatcher_->setExecutor(std::move(executor));
+}
+
+void Room::setStreamCallbackThreads(std::size_t threads) {
+  stream_dispatcher_->setWorkerThreads(threads);
+}
+
+void Room::registerDataPacketHandler(const std::string &topic,
+                                     DataPacketHandler handler) {
+  std::lock_guard<std::mutex> g(handlers_lock_);
+  auto [it, inserted] = data_packet_handlers_.emplace(
+      topic, std::make_shared<const DataPacketHandler>(std::move(handler)));
+  if (!inserted) {
+    throw std::runtime_error("data packet handler for topic '" + topic +
+                             "' already set");
+  }
+}
+
+void Room::unregisterDataPacketHandler(const std::string &topic) {
+  std::lock_guard<std::mutex> g(handlers_lock_);
+  data_packet_handlers_.erase(topic);
+}
+
+StreamBufferStats Room::streamBufferStats() const {
+  std::lock_guard<std::mutex> guard(streams_lock_);
+  return stream_budget_ ? stream_budget_->stats() : StreamBufferStats{};
+}
+
+AsyncOperation<SessionStats>
+Room::getSessionStatsAsync(RtcStatsTypeMask types) const {
+  std::uint64_t handle = 0;
   {
     std::lock_guard<std::mutex> guard(lock_);
-    delegate_snapshot = delegate_;
+    if (room_handle_) {
+      handle = static_cast<std::uint64_t>(room_handle_->get());
+    }
+  }
+  if (handle == 0) {
+    throw std::runtime_error("Room::getSessionStatsAsync: not connected");
   }
+  FfiClient::AsyncId async_id = 0;
+  auto fut =
+      FfiClient::instance().getSessionStatsAsync(handle, types, &async_id);
+  return AsyncOperation<SessionStats>(std::move(fut), async_id);
+}
+
+void Room::OnEvent(const FfiEvent &event) {
+  // Snapshot the delegate once; it is never called under a lock.
+  RoomDelegate *delegate_snapshot = delegate_.load();
+  const RoomEventMask interest =
+      delegate_snapshot ? delegate_events_.load() : 0;
+  auto wants = [interest](RoomEventType type) {
+    return (interest & static_cast<RoomEventMask>(type)) != 0;
+  };
 
   // First, handle RPC method invocations (not part of RoomEvent).
   if (event.message_case() == FfiEvent::kRpcMethodInvocation) {
@@ -270,7 +652,7 @@ void Room::OnEvent(const FfiEvent &event) {
 
     LocalParticipant *lp = nullptr;
     {
-      std::lock_guard<std::mutex> guard(lock_);
+      std::lock_guard<std::mutex> guard(participants_lock_);
       if (!local_participant_) {
         return;
       }
@@ -298,45 +680,61 @@ void Room::OnEvent(const FfiEvent &event) {
     const proto::RoomEvent &re = event.room_event();
 
     // Check if this event is for our room handle
-    {
+    const std::uint64_t room_handle = room_handle_id_.load();
+    if (room_handle == 0 || re.room_handle() != room_handle) {
+      return;
+    }
+    if (detail::changesFrameCryptors(re.message_case())) {
       std::lock_guard<std::mutex> guard(lock_);
-      if (!room_handle_ ||
-          re.room_handle() != static_cast<std::uint64_t>(room_handle_->get())) {
-        return;
+      if (e2ee_manager_) {
+        e2ee_manager_->invalidateFrameCryptors();
+        if (re.has_e2ee_state_changed()) {
+          e2ee_manager_->recordEncryptionState(static_cast<EncryptionState>(
+              re.e2ee_state_changed().state()));
+        }
       }
     }
 
     switch (re.message_case()) {
     case proto::RoomEvent::kParticipantConnected: {
       std::shared_ptr<RemoteParticipant> new_participant;
+      ParticipantConnectedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &owned = re.participant_connected().info();
-        // createRemoteParticipant takes proto::OwnedParticipant
-        new_participant = createRemoteParticipant(owned);
-        remote_participants_.emplace(new_participant->identity(),
-                                     new_participant);
+        ev.identity = owned.info().identity();
+        if (compact_participants_) {
+          // Stays compact until something asks for it; no snapshot rebuild.
+          compact_participants_->insert(participantFields(owned));
+        } else {
+          new_participant = createRemoteParticipant(participantFields(owned));
+          remote_participants_.emplace(new_participant->identity(),
+                                       new_participant);
+          publishParticipantsLocked();
+        }
       }
-      ParticipantConnectedEvent ev;
       ev.participant = new_participant.get();
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kParticipantConnected)) {
         delegate_snapshot->onParticipantConnected(*this, ev);
       }
       break;
     }
     case proto::RoomEvent::kParticipantDisconnected: {
       std::shared_ptr<RemoteParticipant> removed;
-      DisconnectReason reason = DisconnectReason::Unknown;
+      bool removed_compact = false;
+      const auto &pd = re.participant_disconnected();
+      const std::string &identity = pd.participant_identity();
+      DisconnectReason reason = toDisconnectReason(pd.disconnect_reason());
       {
-        std::lock_guard<std::mutex> guard(lock_);
-        const auto &pd = re.participant_disconnected();
-        const std::string &identity = pd.participant_identity();
-        reason = toDisconnectReason(pd.disconnect_reason());
-
+        std::lock_guard<std::mutex> guard(participants_lock_);
         auto it = remote_participants_.find(identity);
         if (it != remote_participants_.end()) {
           removed = it->second;
           remote_participants_.erase(it);
+          publishParticipantsLocked();
+        } else if (compact_participants_ &&
+                   compact_participants_->erase(identity)) {
+          removed_compact = true;
         } else {
           // We saw a disconnect event for a participant we don't track
           // internally. This can happen on races or if we never created a
@@ -345,11 +743,12 @@ void Room::OnEvent(const FfiEvent &event) {
                     << identity << std::endl;
         }
       }
-      if (removed) {
+      if (removed || removed_compact) {
         ParticipantDisconnectedEvent ev;
         ev.participant = removed.get();
+        ev.identity = identity;
         ev.reason = reason;
-        if (delegate_snapshot) {
+        if (wants(RoomEventType::kParticipantDisconnected)) {
           delegate_snapshot->onParticipantDisconnected(*this, ev);
         }
       }
@@ -358,7 +757,7 @@ void Room::OnEvent(const FfiEvent &event) {
     case proto::RoomEvent::kLocalTrackPublished: {
       LocalTrackPublishedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         if (!local_participant_) {
           std::cerr << "kLocalTrackPublished: local_participant_ is nullptr"
                     << std::endl;
@@ -366,17 +765,15 @@ void Room::OnEvent(const FfiEvent &event) {
         }
         const auto &ltp = re.local_track_published();
         const std::string &sid = ltp.track_sid();
-        auto &pubs = local_participant_->trackPublications();
-        auto it = pubs.find(sid);
-        if (it == pubs.end()) {
+        ev.publication = local_participant_->trackPublication(sid);
+        if (!ev.publication) {
           std::cerr << "local_track_published for unknown sid: " << sid
                     << std::endl;
           break;
         }
-        ev.publication = it->second;
         ev.track = ev.publication ? ev.publication->track() : nullptr;
       }
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kLocalTrackPublished)) {
         delegate_snapshot->onLocalTrackPublished(*this, ev);
       }
       break;
@@ -384,7 +781,7 @@ void Room::OnEvent(const FfiEvent &event) {
     case proto::RoomEvent::kLocalTrackUnpublished: {
       LocalTrackUnpublishedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         if (!local_participant_) {
           std::cerr << "kLocalTrackPublished: local_participant_ is nullptr"
                     << std::endl;
@@ -392,16 +789,14 @@ void Room::OnEvent(const FfiEvent &event) {
         }
         const auto &ltu = re.local_track_unpublished();
         const std::string &pub_sid = ltu.publication_sid();
-        auto &pubs = local_participant_->trackPublications();
-        auto it = pubs.find(pub_sid);
-        if (it == pubs.end()) {
+        ev.publication = local_participant_->trackPublication(pub_sid);
+        if (!ev.publication) {
           std::cerr << "local_track_unpublished for unknown publication sid: "
                     << pub_sid << std::endl;
           break;
         }
-        ev.publication = it->second;
       }
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kLocalTrackUnpublished)) {
         delegate_snapshot->onLocalTrackUnpublished(*this, ev);
       }
       break;
@@ -409,24 +804,22 @@ void Room::OnEvent(const FfiEvent &event) {
     case proto::RoomEvent::kLocalTrackSubscribed: {
       LocalTrackSubscribedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         if (!local_participant_) {
           break;
         }
         const auto &lts = re.local_track_subscribed();
         const std::string &sid = lts.track_sid();
-        auto &pubs = local_participant_->trackPublications();
-        auto it = pubs.find(sid);
-        if (it == pubs.end()) {
+        auto publication = local_participant_->trackPublication(sid);
+        if (!publication) {
           std::cerr << "local_track_subscribed for unknown sid: " << sid
                     << std::endl;
           break;
         }
-        auto publication = it->second;
         ev.track = publication ? publication->track() : nullptr;
       }
 
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kLocalTrackSubscribed)) {
         delegate_snapshot->onLocalTrackSubscribed(*this, ev);
       }
       break;
@@ -434,18 +827,15 @@ void Room::OnEvent(const FfiEvent &event) {
     case proto::RoomEvent::kTrackPublished: {
       TrackPublishedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &tp = re.track_published();
         const std::string &identity = tp.participant_identity();
-        auto it = remote_participants_.find(identity);
-        if (it != remote_participants_.end()) {
-          RemoteParticipant *rparticipant = it->second.get();
+        if (RemoteParticipant *rparticipant = findRemoteLocked(identity)) {
           const auto &owned_publication = tp.publication();
           auto rpublication =
               std::make_shared<RemoteTrackPublication>(owned_publication);
           // Store it on the participant, keyed by SID
-          rparticipant->mutableTrackPublications().emplace(
-              rpublication->sid(), std::move(rpublication));
+          rparticipant->storePublication(rpublication);
           ev.participant = rparticipant;
           ev.publication = rpublication;
         } else {
@@ -456,7 +846,7 @@ void Room::OnEvent(const FfiEvent &event) {
           break;
         }
       }
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kTrackPublished)) {
         delegate_snapshot->onTrackPublished(*this, ev);
       }
       break;
@@ -464,30 +854,28 @@ void Room::OnEvent(const FfiEvent &event) {
     case proto::RoomEvent::kTrackUnpublished: {
       TrackUnpublishedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &tu = re.track_unpublished();
         const std::string &identity = tu.participant_identity();
         const std::string &pub_sid = tu.publication_sid();
-        auto pit = remote_participants_.find(identity);
-        if (pit == remote_participants_.end()) {
+        RemoteParticipant *rparticipant = findRemoteLocked(identity);
+        if (!rparticipant) {
           std::cerr << "track_unpublished for unknown participant: " << identity
                     << std::endl;
           break;
         }
-        RemoteParticipant *rparticipant = pit->second.get();
-        auto &pubs = rparticipant->mutableTrackPublications();
-        auto it = pubs.find(pub_sid);
-        if (it == pubs.end()) {
+        auto publication = rparticipant->trackPublication(pub_sid);
+        if (!publication) {
           std::cerr << "track_unpublished for unknown publication sid "
                     << pub_sid << " (participant " << identity << ")\n";
           break;
         }
         ev.participant = rparticipant;
-        ev.publication = it->second;
-        pubs.erase(it);
+        ev.publication = publication;
+        rparticipant->erasePublication(pub_sid);
       }
 
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kTrackUnpublished)) {
         delegate_snapshot->onTrackUnpublished(*this, ev);
       }
       break;
@@ -501,25 +889,22 @@ void Room::OnEvent(const FfiEvent &event) {
       RemoteParticipant *rparticipant = nullptr;
       std::shared_ptr<Track> remote_track;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         // Find participant
-        auto pit = remote_participants_.find(identity);
-        if (pit == remote_participants_.end()) {
+        rparticipant = findRemoteLocked(identity);
+        if (!rparticipant) {
           std::cerr << "track_subscribed for unknown participant: " << identity
                     << "\n";
           break;
         }
-        rparticipant = pit->second.get();
         // Find existing publication by track SID (from track_published)
-        auto &pubs = rparticipant->mutableTrackPublications();
-        auto pubIt = pubs.find(track_info.sid());
-        if (pubIt == pubs.end()) {
+        rpublication = rparticipant->trackPublication(track_info.sid());
+        if (!rpublication) {
           std::cerr << "track_subscribed for unknown publication sid "
                     << track_info.sid() << " (participant " << identity
                     << ")\n";
           break;
         }
-        rpublication = pubIt->second;
 
         // Create RemoteVideoTrack / RemoteAudioTrack
         if (track_info.kind() == proto::TrackKind::KIND_VIDEO) {
@@ -536,12 +921,19 @@ void Room::OnEvent(const FfiEvent &event) {
         rpublication->setSubscribed(true);
       }
 
+      if (first_track_pending_.exchange(false)) {
+        std::lock_guard<std::mutex> guard(lock_);
+        connect_timing_.first_track_subscribed =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - connect_started_);
+      }
+
       // Emit remote track_subscribed-style callback
       TrackSubscribedEvent ev;
       ev.track = remote_track;
       ev.publication = rpublication;
       ev.participant = rparticipant;
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kTrackSubscribed)) {
         delegate_snapshot->onTrackSubscribed(*this, ev);
       }
       break;
@@ -549,25 +941,22 @@ void Room::OnEvent(const FfiEvent &event) {
     case proto::RoomEvent::kTrackUnsubscribed: {
       TrackUnsubscribedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &tu = re.track_unsubscribed();
         const std::string &identity = tu.participant_identity();
         const std::string &track_sid = tu.track_sid();
-        auto pit = remote_participants_.find(identity);
-        if (pit == remote_participants_.end()) {
+        RemoteParticipant *rparticipant = findRemoteLocked(identity);
+        if (!rparticipant) {
           std::cerr << "track_unsubscribed for unknown participant: "
                     << identity << "\n";
           break;
         }
-        RemoteParticipant *rparticipant = pit->second.get();
-        auto &pubs = rparticipant->mutableTrackPublications();
-        auto pubIt = pubs.find(track_sid);
-        if (pubIt == pubs.end()) {
+        auto publication = rparticipant->trackPublication(track_sid);
+        if (!publication) {
           std::cerr << "track_unsubscribed for unknown publication sid "
                     << track_sid << " (participant " << identity << ")\n";
           break;
         }
-        auto publication = pubIt->second;
         auto track = publication->track();
         publication->setTrack(nullptr);
         publication->setSubscribed(false);
@@ -576,37 +965,38 @@ void Room::OnEvent(const FfiEvent &event) {
         ev.track = track;
       }
 
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kTrackUnsubscribed)) {
         delegate_snapshot->onTrackUnsubscribed(*this, ev);
       }
       break;
     }
     case proto::RoomEvent::kTrackSubscriptionFailed: {
+      if (!wants(RoomEventType::kTrackSubscriptionFailed)) {
+        break;
+      }
       TrackSubscriptionFailedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &tsf = re.track_subscription_failed();
         const std::string &identity = tsf.participant_identity();
-        auto pit = remote_participants_.find(identity);
-        if (pit == remote_participants_.end()) {
+        RemoteParticipant *rparticipant = findRemoteLocked(identity);
+        if (!rparticipant) {
           std::cerr << "track_subscription_failed for unknown participant: "
                     << identity << "\n";
           break;
         }
-        ev.participant = pit->second.get();
+        ev.participant = rparticipant;
         ev.track_sid = tsf.track_sid();
         ev.error = tsf.error();
       }
-      if (delegate_snapshot) {
-        delegate_snapshot->onTrackSubscriptionFailed(*this, ev);
-      }
+      delegate_snapshot->onTrackSubscriptionFailed(*this, ev);
       break;
     }
     case proto::RoomEvent::kTrackMuted: {
       TrackMutedEvent ev;
       bool success = false;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &tm = re.track_muted();
         const std::string &identity = tm.participant_identity();
         const std::string &sid = tm.track_sid();
@@ -614,10 +1004,7 @@ void Room::OnEvent(const FfiEvent &event) {
         if (local_participant_ && local_participant_->identity() == identity) {
           participant = local_participant_.get();
         } else {
-          auto pit = remote_participants_.find(identity);
-          if (pit != remote_participants_.end()) {
-            participant = pit->second.get();
-          }
+          participant = findRemoteLocked(identity);
         }
         if (!participant) {
           std::cerr << "track_muted for unknown participant: " << identity
@@ -638,7 +1025,7 @@ void Room::OnEvent(const FfiEvent &event) {
           success = true;
         }
       }
-      if (success && delegate_snapshot) {
+      if (success && wants(RoomEventType::kTrackMuted)) {
         delegate_snapshot->onTrackMuted(*this, ev);
       }
       break;
@@ -647,7 +1034,7 @@ void Room::OnEvent(const FfiEvent &event) {
       TrackUnmutedEvent ev;
       bool success = false;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &tu = re.track_unmuted();
         const std::string &identity = tu.participant_identity();
         const std::string &sid = tu.track_sid();
@@ -655,10 +1042,7 @@ void Room::OnEvent(const FfiEvent &event) {
         if (local_participant_ && local_participant_->identity() == identity) {
           participant = local_participant_.get();
         } else {
-          auto pit = remote_participants_.find(identity);
-          if (pit != remote_participants_.end()) {
-            participant = pit->second.get();
-          }
+          participant = findRemoteLocked(identity);
         }
         if (!participant) {
           std::cerr << "track_unmuted for unknown participant: " << identity
@@ -684,15 +1068,18 @@ void Room::OnEvent(const FfiEvent &event) {
         ev.publication = pub;
       }
 
-      if (success && delegate_snapshot) {
+      if (success && wants(RoomEventType::kTrackUnmuted)) {
         delegate_snapshot->onTrackUnmuted(*this, ev);
       }
       break;
     }
     case proto::RoomEvent::kActiveSpeakersChanged: {
+      if (!wants(RoomEventType::kActiveSpeakersChanged)) {
+        break;
+      }
       ActiveSpeakersChangedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &asc = re.active_speakers_changed();
         for (const auto &identity : asc.participant_identities()) {
           Participant *participant = nullptr;
@@ -700,19 +1087,14 @@ void Room::OnEvent(const FfiEvent &event) {
               local_participant_->identity() == identity) {
             participant = local_participant_.get();
           } else {
-            auto pit = remote_participants_.find(identity);
-            if (pit != remote_participants_.end()) {
-              participant = pit->second.get();
-            }
+            participant = findRemoteLocked(identity);
           }
           if (participant) {
             ev.speakers.push_back(participant);
           }
         }
       }
-      if (delegate_snapshot) {
-        delegate_snapshot->onActiveSpeakersChanged(*this, ev);
-      }
+      delegate_snapshot->onActiveSpeakersChanged(*this, ev);
       break;
     }
     case proto::RoomEvent::kRoomMetadataChanged: {
@@ -724,7 +1106,7 @@ void Room::OnEvent(const FfiEvent &event) {
         ev.old_metadata = old_metadata;
         ev.new_metadata = room_info_.metadata;
       }
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kRoomMetadataChanged)) {
         delegate_snapshot->onRoomMetadataChanged(*this, ev);
       }
       break;
@@ -736,7 +1118,7 @@ void Room::OnEvent(const FfiEvent &event) {
         room_info_.sid = re.room_sid_changed().sid();
         ev.sid = room_info_.sid.value_or(std::string{});
       }
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kRoomSidChanged)) {
         delegate_snapshot->onRoomSidChanged(*this, ev);
       }
       break;
@@ -744,17 +1126,14 @@ void Room::OnEvent(const FfiEvent &event) {
     case proto::RoomEvent::kParticipantMetadataChanged: {
       ParticipantMetadataChangedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &pm = re.participant_metadata_changed();
         const std::string &identity = pm.participant_identity();
         Participant *participant = nullptr;
         if (local_participant_ && local_participant_->identity() == identity) {
           participant = local_participant_.get();
         } else {
-          auto it = remote_participants_.find(identity);
-          if (it != remote_participants_.end()) {
-            participant = it->second.get();
-          }
+          participant = findRemoteLocked(identity);
         }
         if (!participant) {
           std::cerr << "participant_metadata_changed for unknown participant: "
@@ -768,7 +1147,7 @@ void Room::OnEvent(const FfiEvent &event) {
         ev.new_metadata = participant->metadata();
       }
 
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kParticipantMetadataChanged)) {
         delegate_snapshot->onParticipantMetadataChanged(*this, ev);
       }
       break;
@@ -776,17 +1155,14 @@ void Room::OnEvent(const FfiEvent &event) {
     case proto::RoomEvent::kParticipantNameChanged: {
       ParticipantNameChangedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &pn = re.participant_name_changed();
         const std::string &identity = pn.participant_identity();
         Participant *participant = nullptr;
         if (local_participant_ && local_participant_->identity() == identity) {
           participant = local_participant_.get();
         } else {
-          auto it = remote_participants_.find(identity);
-          if (it != remote_participants_.end()) {
-            participant = it->second.get();
-          }
+          participant = findRemoteLocked(identity);
         }
         if (!participant) {
           std::cerr << "participant_name_changed for unknown participant: "
@@ -799,7 +1175,7 @@ void Room::OnEvent(const FfiEvent &event) {
         ev.old_name = old_name;
         ev.new_name = participant->name();
       }
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kParticipantNameChanged)) {
         delegate_snapshot->onParticipantNameChanged(*this, ev);
       }
       break;
@@ -807,17 +1183,14 @@ void Room::OnEvent(const FfiEvent &event) {
     case proto::RoomEvent::kParticipantAttributesChanged: {
       ParticipantAttributesChangedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &pa = re.participant_attributes_changed();
         const std::string &identity = pa.participant_identity();
         Participant *participant = nullptr;
         if (local_participant_ && local_participant_->identity() == identity) {
           participant = local_participant_.get();
         } else {
-          auto it = remote_participants_.find(identity);
-          if (it != remote_participants_.end()) {
-            participant = it->second.get();
-          }
+          participant = findRemoteLocked(identity);
         }
         if (!participant) {
           std::cerr
@@ -825,38 +1198,62 @@ void Room::OnEvent(const FfiEvent &event) {
               << identity << "\n";
           break;
         }
-        // Build full attributes map
-        std::unordered_map<std::string, std::string> attrs;
-        for (const auto &entry : pa.attributes()) {
-          attrs.emplace(entry.key(), entry.value());
-        }
-        participant->set_attributes(attrs);
-
-        // Build changed_attributes map
+        // Apply only the delta; an empty value means the key was removed.
+        const bool notify = wants(RoomEventType::kParticipantAttributesChanged);
+        Participant &p = *participant;
         for (const auto &entry : pa.changed_attributes()) {
-          ev.changed_attributes.emplace_back(entry.key(), entry.value());
+          const bool removed = entry.value().empty();
+          if (removed) {
+            p.remove_attribute(entry.key());
+          } else {
+            p.set_attribute(entry.key(), entry.value());
+          }
+          if (notify) {
+            ev.changed_attributes.emplace_back(entry.key(), entry.value());
+            if (removed) {
+              ev.removed_attributes.push_back(entry.key());
+            }
+          }
+        }
+        // The event also carries the full set; rebuild from it only if the
+        // delta left us out of step (e.g. an event was missed).
+        const AttributeMap &current = p.attributes();
+        bool in_step = current.size() ==
+                       static_cast<std::size_t>(pa.attributes_size());
+        for (int i = 0; in_step && i < pa.attributes_size(); ++i) {
+          const auto &entry = pa.attributes(i);
+          auto it = current.find(entry.key());
+          in_step = it != current.end() && it->second == entry.value();
+        }
+        if (!in_step) {
+          AttributeMap::container_type entries;
+          entries.reserve(pa.attributes_size());
+          for (const auto &entry : pa.attributes()) {
+            entries.emplace_back(entry.key(), entry.value());
+          }
+          p.set_attributes(AttributeMap(std::move(entries)));
         }
         ev.participant = participant;
       }
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kParticipantAttributesChanged)) {
         delegate_snapshot->onParticipantAttributesChanged(*this, ev);
       }
       break;
     }
     case proto::RoomEvent::kParticipantEncryptionStatusChanged: {
+      if (!wants(RoomEventType::kParticipantEncryptionStatusChanged)) {
+        break;
+      }
       ParticipantEncryptionStatusChangedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &pe = re.participant_encryption_status_changed();
         const std::string &identity = pe.participant_identity();
         Participant *participant = nullptr;
         if (local_participant_ && local_participant_->identity() == identity) {
           participant = local_participant_.get();
         } else {
-          auto it = remote_participants_.find(identity);
-          if (it != remote_participants_.end()) {
-            participant = it->second.get();
-          }
+          participant = findRemoteLocked(identity);
         }
         if (!participant) {
           std::cerr << "participant_encryption_status_changed for unknown "
@@ -868,15 +1265,16 @@ void Room::OnEvent(const FfiEvent &event) {
         ev.is_encrypted = pe.is_encrypted();
       }
 
-      if (delegate_snapshot) {
-        delegate_snapshot->onParticipantEncryptionStatusChanged(*this, ev);
-      }
+      delegate_snapshot->onParticipantEncryptionStatusChanged(*this, ev);
       break;
     }
     case proto::RoomEvent::kConnectionQualityChanged: {
+      if (!wants(RoomEventType::kConnectionQualityChanged)) {
+        break;
+      }
       ConnectionQualityChangedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &cq = re.connection_quality_changed();
         const std::string &identity = cq.participant_identity();
         Participant *participant = nullptr;
@@ -889,17 +1287,19 @@ void Room::OnEvent(const FfiEvent &event) {
           }
         }
         if (!participant) {
-          std::cerr << "connection_quality_changed for unknown participant: "
-                    << identity << "\n";
+          // Quality updates alone do not materialize a compact participant.
+          if (!compact_participants_ ||
+              !compact_participants_->contains(identity)) {
+            std::cerr << "connection_quality_changed for unknown participant: "
+                      << identity << "\n";
+          }
           break;
         }
         ev.participant = participant;
         ev.quality = static_cast<ConnectionQuality>(cq.quality());
       }
 
-      if (delegate_snapshot) {
-        delegate_snapshot->onConnectionQualityChanged(*this, ev);
-      }
+      delegate_snapshot->onConnectionQualityChanged(*this, ev);
       break;
     }
 
@@ -908,20 +1308,44 @@ void Room::OnEvent(const FfiEvent &event) {
     // ------------------------------------------------------------------------
     case proto::RoomEvent::kDataPacketReceived: {
       const auto &dp = re.data_packet_received();
+      const auto which_val = dp.value_case();
       RemoteParticipant *rp = nullptr;
+      std::shared_ptr<const DataPacketHandler> packet_handler;
+      bool route_by_topic = false;
+      rp = remoteParticipant(dp.participant_identity());
       {
-        std::lock_guard<std::mutex> guard(lock_);
-        auto it = remote_participants_.find(dp.participant_identity());
-        if (it != remote_participants_.end()) {
-          rp = it->second.get();
+        std::lock_guard<std::mutex> guard(handlers_lock_);
+        if (which_val == proto::DataPacketReceived::kUser &&
+            !data_packet_handlers_.empty()) {
+          route_by_topic = true;
+          auto hit = data_packet_handlers_.find(dp.user().topic());
+          if (hit != data_packet_handlers_.end()) {
+            packet_handler = hit->second;
+          }
         }
       }
-      const auto which_val = dp.value_case();
-      if (which_val == proto::DataPacketReceived::kUser && delegate_snapshot) {
-        UserDataPacketEvent ev = userDataPacketFromProto(dp, rp);
-        delegate_snapshot->onUserPacketReceived(*this, ev);
+      if (which_val == proto::DataPacketReceived::kUser) {
+        // The payload buffer belongs to us; release it once delivered.
+        const auto &owned = dp.user().data();
+        FfiHandle buffer_handle(static_cast<uintptr_t>(owned.handle().id()),
+                                ResourceKind::kDataBuffer,
+                                FfiHandle::Disposal::kDeferrable);
+        if (packet_handler) {
+          UserDataPacketView view;
+          view.data = reinterpret_cast<const std::uint8_t *>(
+              owned.data().data_ptr());
+          view.size = static_cast<std::size_t>(owned.data().data_len());
+          view.kind = static_cast<DataPacketKind>(dp.kind());
+          view.participant = rp;
+          view.topic = dp.user().topic();
+          (*packet_handler)(view);
+        } else if (!route_by_topic &&
+                   wants(RoomEventType::kUserPacketReceived)) {
+          UserDataPacketEvent ev = userDataPacketFromProto(dp, rp);
+          delegate_snapshot->onUserPacketReceived(*this, ev);
+        }
       } else if (which_val == proto::DataPacketReceived::kSipDtmf &&
-                 delegate_snapshot) {
+                 wants(RoomEventType::kSipDtmfReceived)) {
         SipDtmfReceivedEvent ev = sipDtmfFromProto(dp, rp);
         delegate_snapshot->onSipDtmfReceived(*this, ev);
       }
@@ -932,20 +1356,20 @@ void Room::OnEvent(const FfiEvent &event) {
     // E2EE state
     // ------------------------------------------------------------------------
     case proto::RoomEvent::kE2EeStateChanged: {
+      if (!wants(RoomEventType::kE2eeStateChanged)) {
+        break;
+      }
       E2eeStateChangedEvent ev;
       {
         std::cerr << "e2ee_state_changed for participant: " << std::endl;
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &es = re.e2ee_state_changed();
         const std::string &identity = es.participant_identity();
         Participant *participant = nullptr;
         if (local_participant_ && local_participant_->identity() == identity) {
           participant = local_participant_.get();
         } else {
-          auto it = remote_participants_.find(identity);
-          if (it != remote_participants_.end()) {
-            participant = it->second.get();
-          }
+          participant = findRemoteLocked(identity);
         }
         if (!participant) {
           std::cerr << "e2ee_state_changed for unknown participant: "
@@ -956,9 +1380,7 @@ void Room::OnEvent(const FfiEvent &event) {
         ev.participant = participant;
         ev.state = static_cast<EncryptionState>(es.state());
       }
-      if (delegate_snapshot) {
-        delegate_snapshot->onE2eeStateChanged(*this, ev);
-      }
+      delegate_snapshot->onE2eeStateChanged(*this, ev);
       break;
     }
 
@@ -967,6 +1389,9 @@ void Room::OnEvent(const FfiEvent &event) {
       // ------------------------------------------------------------------------
 
     case proto::RoomEvent::kConnectionStateChanged: {
+      if (!wants(RoomEventType::kConnectionStateChanged)) {
+        break;
+      }
       ConnectionStateChangedEvent ev;
       {
         std::lock_guard<std::mutex> guard(lock_);
@@ -978,42 +1403,79 @@ void Room::OnEvent(const FfiEvent &event) {
                   << (int)connection_state_ << std::endl;
         ev.state = static_cast<ConnectionState>(cs.state());
       }
-      if (delegate_snapshot) {
-        delegate_snapshot->onConnectionStateChanged(*this, ev);
-      }
+      delegate_snapshot->onConnectionStateChanged(*this, ev);
       break;
     }
     case proto::RoomEvent::kDisconnected: {
+      {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (reconnect_stats_.reconnecting) {
+          reconnect_stats_.reconnecting = false;
+          ++reconnect_stats_.failed;
+          reconnect_stats_.total +=
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - reconnect_started_);
+          detail::SdkMetrics::instance().reconnect_failures.add();
+        }
+      }
       DisconnectedEvent ev;
       ev.reason = toDisconnectReason(re.disconnected().reason());
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kDisconnected)) {
         delegate_snapshot->onDisconnected(*this, ev);
       }
       break;
     }
     case proto::RoomEvent::kReconnecting: {
+      {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (!reconnect_stats_.reconnecting) {
+          reconnect_stats_.reconnecting = true;
+          ++reconnect_stats_.attempts;
+          reconnect_started_ = std::chrono::steady_clock::now();
+        }
+      }
       ReconnectingEvent ev;
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kReconnecting)) {
         delegate_snapshot->onReconnecting(*this, ev);
       }
       break;
     }
     case proto::RoomEvent::kReconnected: {
       ReconnectedEvent ev;
-      if (delegate_snapshot) {
+      {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (reconnect_stats_.reconnecting) {
+          ev.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - reconnect_started_);
+          reconnect_stats_.reconnecting = false;
+          ++reconnect_stats_.completed;
+          reconnect_stats_.last = ev.duration;
+          reconnect_stats_.longest =
+              std::max(reconnect_stats_.longest, ev.duration);
+          reconnect_stats_.total += ev.duration;
+        }
+      }
+      auto &metrics = detail::SdkMetrics::instance();
+      metrics.reconnects.add();
+      if (detail::metricsOn()) {
+        metrics.reconnect_latency.record(ev.duration);
+      }
+      if (wants(RoomEventType::kReconnected)) {
         delegate_snapshot->onReconnected(*this, ev);
       }
       break;
     }
     case proto::RoomEvent::kEos: {
-      // Remove listener since no more events will come for this room
+      // Remove listeners since no more events will come for this room
       int listener_to_remove = 0;
+      int rpc_listener_to_remove = 0;
 
       // Move state out of lock scope before destroying to avoid holding lock
       // during potentially long destructors
       std::unique_ptr<LocalParticipant> old_local_participant;
       std::unordered_map<std::string, std::shared_ptr<RemoteParticipant>>
           old_remote_participants;
+      std::unique_ptr<detail::CompactParticipantStore> old_compact_participants;
       std::shared_ptr<FfiHandle> old_room_handle;
       std::unique_ptr<E2EEManager> old_e2ee_manager;
       std::unordered_map<std::string, std::shared_ptr<TextStreamReader>>
@@ -1025,28 +1487,45 @@ void Room::OnEvent(const FfiEvent &event) {
         std::lock_guard<std::mutex> guard(lock_);
         listener_to_remove = listener_id_;
         listener_id_ = 0;
+        rpc_listener_to_remove = rpc_listener_id_;
+        rpc_listener_id_ = 0;
 
         // Reset connection state
         connection_state_ = ConnectionState::Disconnected;
 
         // Move state out for cleanup outside lock
-        old_local_participant = std::move(local_participant_);
-        old_remote_participants = std::move(remote_participants_);
         old_room_handle = std::move(room_handle_);
+        room_handle_id_.store(0);
         old_e2ee_manager = std::move(e2ee_manager_);
+      }
+      {
+        std::lock_guard<std::mutex> guard(participants_lock_);
+        old_local_participant = std::move(local_participant_);
+        old_remote_participants = std::move(remote_participants_);
+        remote_participants_.clear();
+        old_compact_participants = std::move(compact_participants_);
+        lazy_participants_.store(false);
+        publishParticipantsLocked();
+      }
+      {
+        std::lock_guard<std::mutex> guard(streams_lock_);
         old_text_readers = std::move(text_stream_readers_);
         old_byte_readers = std::move(byte_stream_readers_);
       }
+      stream_dispatcher_->abortAll();
 
       // Remove listener outside lock
       if (listener_to_remove != 0) {
         FfiClient::instance().RemoveListener(listener_to_remove);
       }
+      if (rpc_listener_to_remove != 0) {
+        FfiClient::instance().RemoveListener(rpc_listener_to_remove);
+      }
 
       // Old state will be destroyed here when going out of scope
 
       RoomEosEvent ev;
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kRoomEos)) {
         delegate_snapshot->onRoomEos(*this, ev);
       }
       break;
@@ -1064,41 +1543,76 @@ void Room::OnEvent(const FfiEvent &event) {
       // callback
       TextStreamHandler text_cb;
       ByteStreamHandler byte_cb;
+      TextStreamOpenHandler text_open;
+      ByteStreamOpenHandler byte_open;
       std::shared_ptr<TextStreamReader> text_reader;
       std::shared_ptr<ByteStreamReader> byte_reader;
+      // Determine stream type from oneof in protobuf
+      // Adjust these names if your generated C++ uses different ones
+      const auto stream_type = header.content_header_case();
       {
-        std::lock_guard<std::mutex> guard(lock_);
-
-        // Determine stream type from oneof in protobuf
-        // Adjust these names if your generated C++ uses different ones
-        const auto stream_type = header.content_header_case();
+        std::lock_guard<std::mutex> guard(handlers_lock_);
         if (stream_type == proto::DataStream::Header::kTextHeader) {
           auto it = text_stream_handlers_.find(header.topic());
-          if (it == text_stream_handlers_.end()) {
-            // Ignore if no callback attached
-            break;
+          if (it != text_stream_handlers_.end()) {
+            text_cb = it->second;
+          } else {
+            auto cb = text_stream_callbacks_.find(header.topic());
+            if (cb == text_stream_callbacks_.end()) {
+              // Ignore if no callback attached
+              break;
+            }
+            text_open = cb->second;
           }
-          text_cb = it->second;
-
-          TextStreamInfo info = makeTextInfo(header);
-          text_reader = std::make_shared<TextStreamReader>(info);
-          text_stream_readers_[header.stream_id()] = text_reader;
-
         } else if (stream_type == proto::DataStream::Header::kByteHeader) {
           auto it = byte_stream_handlers_.find(header.topic());
-          if (it == byte_stream_handlers_.end()) {
-            break;
+          if (it != byte_stream_handlers_.end()) {
+            byte_cb = it->second;
+          } else {
+            auto cb = byte_stream_callbacks_.find(header.topic());
+            if (cb == byte_stream_callbacks_.end()) {
+              break;
+            }
+            byte_open = cb->second;
           }
-          byte_cb = it->second;
-          ByteStreamInfo info = makeByteInfo(header);
-          byte_reader = std::make_shared<ByteStreamReader>(info);
-          byte_stream_readers_[header.stream_id()] = byte_reader;
-
         } else {
           // unknown header type: ignore
           break;
         }
       }
+      if (text_open || byte_open) {
+        std::shared_ptr<detail::StreamBudget> budget;
+        {
+          std::lock_guard<std::mutex> guard(streams_lock_);
+          budget = stream_budget_;
+        }
+        // The open handler runs on the stream executor, like the callbacks
+        // it returns.
+        if (text_open) {
+          stream_dispatcher_->openText(makeTextInfo(header),
+                                       participant_identity,
+                                       std::move(text_open), std::move(budget));
+        } else {
+          stream_dispatcher_->openByte(makeByteInfo(header),
+                                       participant_identity,
+                                       std::move(byte_open), std::move(budget));
+        }
+        break;
+      }
+      {
+        std::lock_guard<std::mutex> guard(streams_lock_);
+        if (stream_type == proto::DataStream::Header::kTextHeader) {
+          TextStreamInfo info = makeTextInfo(header);
+          text_reader = std::make_shared<TextStreamReader>(info);
+          text_reader->attachBudget(stream_budget_);
+          text_stream_readers_[header.stream_id()] = text_reader;
+        } else {
+          ByteStreamInfo info = makeByteInfo(header);
+          byte_reader = std::make_shared<ByteStreamReader>(info);
+          byte_reader->attachBudget(stream_budget_);
+          byte_stream_readers_[header.stream_id()] = byte_reader;
+        }
+      }
 
       // Invoke user callback outside lock (very important)
       if (text_reader) {
@@ -1114,7 +1628,7 @@ void Room::OnEvent(const FfiEvent &event) {
       std::shared_ptr<TextStreamReader> text_reader;
       std::shared_ptr<ByteStreamReader> byte_reader;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(streams_lock_);
         auto itT = text_stream_readers_.find(chunk.stream_id());
         if (itT != text_stream_readers_.end()) {
           text_reader = itT->second;
@@ -1129,10 +1643,12 @@ void Room::OnEvent(const FfiEvent &event) {
         // chunk.content() is bytes; treat as UTF-8 string.
         text_reader->onChunkUpdate(chunk.content());
       } else if (byte_reader) {
-        // Convert string bytes -> vector<uint8_t>
+        // Appended straight from the event's bytes field.
         const std::string &s = chunk.content();
-        std::vector<std::uint8_t> bytes(s.begin(), s.end());
-        byte_reader->onChunkUpdate(bytes);
+        byte_reader->onChunkUpdate(
+            reinterpret_cast<const std::uint8_t *>(s.data()), s.size());
+      } else {
+        stream_dispatcher_->chunk(chunk.stream_id(), chunk.content());
       }
       break;
     }
@@ -1146,7 +1662,7 @@ void Room::OnEvent(const FfiEvent &event) {
         trailer_attrs.emplace(kv.first, kv.second);
       }
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(streams_lock_);
         auto itT = text_stream_readers_.find(trailer.stream_id());
         if (itT != text_stream_readers_.end()) {
           text_reader = itT->second;
@@ -1163,49 +1679,64 @@ void Room::OnEvent(const FfiEvent &event) {
         text_reader->onStreamClose(trailer_attrs);
       } else if (byte_reader) {
         byte_reader->onStreamClose(trailer_attrs);
+      } else {
+        stream_dispatcher_->close(trailer.stream_id(), trailer_attrs);
       }
       break;
     }
     case proto::RoomEvent::kDataChannelLowThresholdChanged: {
       auto ev = fromProto(re.data_channel_low_threshold_changed());
-      if (delegate_snapshot) {
-        delegate_snapshot->onDataChannelBufferedAmountLowThresholdChanged(*this,
-                                                                          ev);
+      {
+        // The reliable threshold sizes the local participant's send budget.
+        std::lock_guard<std::mutex> guard(participants_lock_);
+        if (local_participant_) {
+          local_participant_->onDataChannelThreshold(ev.kind, ev.threshold);
+        }
       }
+      if (!wants(
+              RoomEventType::kDataChannelBufferedAmountLowThresholdChanged)) {
+        break;
+      }
+      delegate_snapshot->onDataChannelBufferedAmountLowThresholdChanged(*this,
+                                                                        ev);
       break;
     }
     case proto::RoomEvent::kByteStreamOpened: {
-      auto ev = fromProto(re.byte_stream_opened());
-      if (delegate_snapshot) {
-        delegate_snapshot->onByteStreamOpened(*this, ev);
+      if (!wants(RoomEventType::kByteStreamOpened)) {
+        break;
       }
+      auto ev = fromProto(re.byte_stream_opened());
+      delegate_snapshot->onByteStreamOpened(*this, ev);
       break;
     }
     case proto::RoomEvent::kTextStreamOpened: {
-      auto ev = fromProto(re.text_stream_opened());
-      if (delegate_snapshot) {
-        delegate_snapshot->onTextStreamOpened(*this, ev);
+      if (!wants(RoomEventType::kTextStreamOpened)) {
+        break;
       }
+      auto ev = fromProto(re.text_stream_opened());
+      delegate_snapshot->onTextStreamOpened(*this, ev);
       break;
     }
     case proto::RoomEvent::kRoomUpdated: {
-      auto ev = roomUpdatedFromProto(re.room_updated());
-      if (delegate_snapshot) {
-        delegate_snapshot->onRoomUpdated(*this, ev);
+      if (!wants(RoomEventType::kRoomUpdated)) {
+        break;
       }
+      auto ev = roomUpdatedFromProto(re.room_updated());
+      delegate_snapshot->onRoomUpdated(*this, ev);
       break;
     }
     case proto::RoomEvent::kMoved: {
-      auto ev = roomMovedFromProto(re.moved());
-      if (delegate_snapshot) {
-        delegate_snapshot->onRoomMoved(*this, ev);
+      if (!wants(RoomEventType::kRoomMoved)) {
+        break;
       }
+      auto ev = roomMovedFromProto(re.moved());
+      delegate_snapshot->onRoomMoved(*this, ev);
       break;
     }
     case proto::RoomEvent::kParticipantsUpdated: {
       ParticipantsUpdatedEvent ev;
       {
-        std::lock_guard<std::mutex> guard(lock_);
+        std::lock_guard<std::mutex> guard(participants_lock_);
         const auto &pu = re.participants_updated();
         for (const auto &info : pu.participants()) {
           const std::string &identity = info.identity();
@@ -1218,6 +1749,14 @@ void Room::OnEvent(const FfiEvent &event) {
             auto it = remote_participants_.find(identity);
             if (it != remote_participants_.end()) {
               participant = it->second.get();
+            } else if (compact_participants_ &&
+                       compact_participants_->update(
+                           identity, info.name(), info.metadata(),
+                           attributesFromProto(info.attributes()),
+                           fromProto(info.kind()),
+                           toDisconnectReason(info.disconnect_reason()))) {
+              // Refreshed in place; only full objects are reported.
+              continue;
             }
           }
           if (!participant) {
@@ -1230,12 +1769,7 @@ void Room::OnEvent(const FfiEvent &event) {
           participant->set_name(info.name());
           participant->set_metadata(info.metadata());
 
-          std::unordered_map<std::string, std::string> attrs;
-          attrs.reserve(info.attributes_size());
-          for (const auto &kv : info.attributes()) {
-            attrs.emplace(kv.first, kv.second);
-          }
-          participant->set_attributes(std::move(attrs));
+          participant->set_attributes(attributesFromProto(info.attributes()));
           participant->set_kind(fromProto(info.kind()));
           participant->set_disconnect_reason(
               toDisconnectReason(info.disconnect_reason()));
@@ -1243,7 +1777,7 @@ void Room::OnEvent(const FfiEvent &event) {
           ev.participants.push_back(participant);
         }
       }
-      if (delegate_snapshot) {
+      if (wants(RoomEventType::kParticipantsUpdated)) {
         delegate_snapshot->onParticipantsUpdated(*this, ev);
       }
       break;
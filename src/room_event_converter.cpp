@@ -228,16 +228,14 @@ DataStreamTrailerData fromProto(const proto::DataStream_Trailer &src) {
 
 ParticipantConnectedEvent fromProto(const proto::ParticipantConnected &src) {
   ParticipantConnectedEvent ev;
-  // src.info() is OwnedParticipant; you can fill more fields once you inspect
-  // it. For now, leave metadata/name/identity as TODO.
-  // TODO: map src.info().info().identity(), name(), metadata(), etc.
+  ev.identity = src.info().info().identity();
   return ev;
 }
 
 ParticipantDisconnectedEvent
 fromProto(const proto::ParticipantDisconnected &src) {
   ParticipantDisconnectedEvent ev;
-  ev.participant_identity = src.participant_identity();
+  ev.identity = src.participant_identity();
   ev.reason = toDisconnectReason(src.disconnect_reason());
   return ev;
 }
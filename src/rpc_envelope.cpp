@@ -0,0 +1,228 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rpc_envelope.h"
+
+#include "livekit/rpc_error.h"
+
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+constexpr std::string_view kEnvelopeMagic = "\x1eLK1";
+
+constexpr char kBase64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct CompressionRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::shared_ptr<const RpcCompression>>
+      codecs;
+};
+
+CompressionRegistry &registry() {
+  static CompressionRegistry instance;
+  return instance;
+}
+
+[[noreturn]] void throwEnvelopeError(const std::string &what) {
+  throw RpcError(RpcError::ErrorCode::APPLICATION_ERROR, what);
+}
+
+} // namespace
+
+std::shared_ptr<const RpcCompression>
+findRpcCompression(const std::string &name) {
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  auto it = reg.codecs.find(name);
+  return it == reg.codecs.end() ? nullptr : it->second;
+}
+
+std::string base64Encode(std::string_view data) {
+  std::string out;
+  out.reserve((data.size() + 2) / 3 * 4);
+  std::size_t i = 0;
+  for (; i + 3 <= data.size(); i += 3) {
+    const auto v = static_cast<std::uint32_t>(
+        static_cast<unsigned char>(data[i]) << 16 |
+        static_cast<unsigned char>(data[i + 1]) << 8 |
+        static_cast<unsigned char>(data[i + 2]));
+    out += kBase64Alphabet[v >> 18 & 63];
+    out += kBase64Alphabet[v >> 12 & 63];
+    out += kBase64Alphabet[v >> 6 & 63];
+    out += kBase64Alphabet[v & 63];
+  }
+  const std::size_t rest = data.size() - i;
+  if (rest > 0) {
+    std::uint32_t v = static_cast<unsigned char>(data[i]) << 16;
+    if (rest == 2) {
+      v |= static_cast<unsigned char>(data[i + 1]) << 8;
+    }
+    out += kBase64Alphabet[v >> 18 & 63];
+    out += kBase64Alphabet[v >> 12 & 63];
+    out += rest == 2 ? kBase64Alphabet[v >> 6 & 63] : '=';
+    out += '=';
+  }
+  return out;
+}
+
+bool base64Decode(std::string_view text, std::string *out) {
+  if (text.size() % 4 != 0) {
+    return false;
+  }
+  out->clear();
+  out->reserve(text.size() / 4 * 3);
+  auto value = [](char c) -> int {
+    if (c >= 'A' && c <= 'Z') {
+      return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z') {
+      return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9') {
+      return c - '0' + 52;
+    }
+    if (c == '+') {
+      return 62;
+    }
+    if (c == '/') {
+      return 63;
+    }
+    return -1;
+  };
+  for (std::size_t i = 0; i < text.size(); i += 4) {
+    const bool last = i + 4 == text.size();
+    const int pad = last ? (text[i + 3] == '=') + (text[i + 2] == '=') : 0;
+    if (pad == 1 && text[i + 2] == '=') {
+      return false;
+    }
+    std::uint32_t v = 0;
+    for (int k = 0; k < 4; ++k) {
+      const int d = k >= 4 - pad ? 0 : value(text[i + k]);
+      if (d < 0) {
+        return false;
+      }
+      v = v << 6 | static_cast<std::uint32_t>(d);
+    }
+    out->push_back(static_cast<char>(v >> 16 & 0xff));
+    if (pad < 2) {
+      out->push_back(static_cast<char>(v >> 8 & 0xff));
+    }
+    if (pad < 1) {
+      out->push_back(static_cast<char>(v & 0xff));
+    }
+  }
+  return true;
+}
+
+std::string encodeRpcPayload(std::string body, const RpcPayloadMode &mode) {
+  if (mode.plain()) {
+    return body;
+  }
+  std::shared_ptr<const RpcCompression> codec;
+  if (!mode.compression.empty()) {
+    codec = findRpcCompression(mode.compression);
+    if (!codec) {
+      throwEnvelopeError("RPC compression codec not registered: " +
+                         mode.compression);
+    }
+  }
+  const bool compress = codec && body.size() >= codec->min_size;
+  if (compress) {
+    body = codec->compress(body);
+  }
+  std::string out(kEnvelopeMagic);
+  out += mode.binary ? 'b' : 't';
+  out += compress ? '1' : '0';
+  out += mode.compression;
+  out += '\n';
+  if (compress || mode.binary) {
+    out += base64Encode(body);
+  } else {
+    out += body;
+  }
+  return out;
+}
+
+bool decodeRpcPayload(std::string_view payload, RpcPayloadMode *mode,
+                      std::string *body) {
+  if (payload.substr(0, kEnvelopeMagic.size()) != kEnvelopeMagic) {
+    return false;
+  }
+  payload.remove_prefix(kEnvelopeMagic.size());
+  const auto newline = payload.find('\n');
+  if (payload.size() < 2 || newline == std::string_view::npos ||
+      newline < 2 || (payload[0] != 't' && payload[0] != 'b') ||
+      (payload[1] != '0' && payload[1] != '1')) {
+    throwEnvelopeError("malformed RPC payload envelope");
+  }
+  const bool binary = payload[0] == 'b';
+  const bool compressed = payload[1] == '1';
+  const std::string codec_name(payload.substr(2, newline - 2));
+  const std::string_view wire = payload.substr(newline + 1);
+
+  auto codec = codec_name.empty() ? nullptr : findRpcCompression(codec_name);
+  if (compressed && !codec) {
+    throwEnvelopeError("RPC compression codec not registered: " + codec_name);
+  }
+  if (compressed || binary) {
+    if (!base64Decode(wire, body)) {
+      throwEnvelopeError("malformed RPC payload envelope");
+    }
+  } else {
+    body->assign(wire);
+  }
+  if (compressed) {
+    try {
+      *body = codec->decompress(*body);
+    } catch (const std::exception &e) {
+      throwEnvelopeError(std::string("RPC payload decompression failed: ") +
+                         e.what());
+    }
+  }
+  if (mode) {
+    mode->binary = binary;
+    mode->compression = codec ? codec_name : std::string();
+  }
+  return true;
+}
+
+} // namespace detail
+
+void registerRpcCompression(RpcCompression codec) {
+  if (codec.name.empty() || !codec.compress || !codec.decompress) {
+    throw std::invalid_argument(
+        "registerRpcCompression: name, compress and decompress are required");
+  }
+  if (codec.name.find('\n') != std::string::npos) {
+    throw std::invalid_argument(
+        "registerRpcCompression: codec name must not contain a newline");
+  }
+  auto &reg = detail::registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  auto name = codec.name;
+  reg.codecs[name] = std::make_shared<const RpcCompression>(std::move(codec));
+}
+
+} // namespace livekit
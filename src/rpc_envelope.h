@@ -0,0 +1,65 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/rpc_payload.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace livekit {
+namespace detail {
+
+// How an RPC payload travels. Plain payloads (the default, and all payloads
+// from other SDKs) go out unchanged; anything else is wrapped in a small
+// envelope:
+//
+//   "\x1eLK1" <kind: 't'|'b'> <compressed: '0'|'1'> <codec> '\n' <body>
+//
+// The body is base64 when binary or compressed, since the FFI carries RPC
+// payloads as UTF-8 strings. <codec> names the codec the sender asks to be
+// used for the reply, even when this payload itself was too small to
+// compress.
+struct RpcPayloadMode {
+  bool binary = false;
+  std::string compression; // Empty: no compression.
+
+  bool plain() const noexcept { return !binary && compression.empty(); }
+};
+
+// Encode `body` for the wire according to `mode`. Throws RpcError
+// (APPLICATION_ERROR) if `mode` names an unregistered codec.
+std::string encodeRpcPayload(std::string body, const RpcPayloadMode &mode);
+
+// If `payload` is an envelope, decode it into `*body`, store its mode in
+// `*mode` (if non-null) and return true. Returns false for plain payloads.
+// Throws RpcError (APPLICATION_ERROR) for a malformed envelope or a
+// compressed body whose codec is not registered. A requested reply codec
+// that is not registered locally is dropped from `*mode` instead.
+bool decodeRpcPayload(std::string_view payload, RpcPayloadMode *mode,
+                      std::string *body);
+
+std::shared_ptr<const RpcCompression>
+findRpcCompression(const std::string &name);
+
+std::string base64Encode(std::string_view data);
+// Returns false on malformed input.
+bool base64Decode(std::string_view text, std::string *out);
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rpc_metrics.h"
+
+#include "livekit/rpc_error.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+std::size_t floorLog2(std::uint64_t v) noexcept {
+  std::size_t e = 0;
+  while (v >>= 1) {
+    ++e;
+  }
+  return e;
+}
+
+void atomicMin(std::atomic<std::uint64_t> &target, std::uint64_t v) noexcept {
+  std::uint64_t cur = target.load(std::memory_order_relaxed);
+  while (v < cur &&
+         !target.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+  }
+}
+
+void atomicMax(std::atomic<std::uint64_t> &target, std::uint64_t v) noexcept {
+  std::uint64_t cur = target.load(std::memory_order_relaxed);
+  while (v > cur &&
+         !target.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+  }
+}
+
+bool isTimeout(std::uint32_t code) {
+  using Code = RpcError::ErrorCode;
+  return code == static_cast<std::uint32_t>(Code::RESPONSE_TIMEOUT) ||
+         code == static_cast<std::uint32_t>(Code::CONNECTION_TIMEOUT);
+}
+
+} // namespace
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t us) noexcept {
+  if (us < kSubBuckets) {
+    return static_cast<std::size_t>(us);
+  }
+  const std::size_t e = floorLog2(us);
+  if (e > kMaxExponent) {
+    return kBucketCount - 1;
+  }
+  const std::size_t sub = (us >> (e - 4)) & (kSubBuckets - 1);
+  return kSubBuckets + (e - 4) * kSubBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index) noexcept {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  const std::size_t shift = (index - kSubBuckets) / kSubBuckets;
+  const std::uint64_t sub = (index - kSubBuckets) % kSubBuckets;
+  const std::uint64_t lower = (kSubBuckets + sub) << shift;
+  return lower + (std::uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::microseconds value) noexcept {
+  const auto us =
+      static_cast<std::uint64_t>(std::max<std::int64_t>(value.count(), 0));
+  buckets_[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_.fetch_add(us, std::memory_order_relaxed);
+  atomicMin(min_, us);
+  atomicMax(max_, us);
+}
+
+LatencySnapshot LatencyHistogram::snapshot() const {
+  LatencySnapshot out;
+  for (std::size_t i = 0; i < kBucketCount; ++i) {
+    const std::uint64_t n = buckets_[i].load(std::memory_order_relaxed);
+    if (n != 0) {
+      out.buckets.emplace_back(
+          std::chrono::microseconds(bucketUpperBound(i)), n);
+      out.count += n;
+    }
+  }
+  if (out.count == 0) {
+    return out;
+  }
+  // Read after the buckets so min/max cover every sample counted above.
+  out.min = std::chrono::microseconds(min_.load(std::memory_order_relaxed));
+  out.max = std::chrono::microseconds(max_.load(std::memory_order_relaxed));
+  out.total = std::chrono::microseconds(total_.load(std::memory_order_relaxed));
+  return out;
+}
+
+void LatencyHistogram::reset() noexcept {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  total_.store(0, std::memory_order_relaxed);
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+RpcMetricsRegistry &RpcMetricsRegistry::instance() {
+  static RpcMetricsRegistry registry;
+  return registry;
+}
+
+RpcMetricsRegistry::Entry &
+RpcMetricsRegistry::entry(Table &table, const std::string &method) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = table.find(method);
+  if (it == table.end()) {
+    if (table.size() >= kMaxMethods) {
+      it = table.find(kOverflowMethod);
+    }
+    if (it == table.end()) {
+      const bool overflow = table.size() >= kMaxMethods;
+      it = table
+               .emplace(overflow ? std::string(kOverflowMethod) : method,
+                        std::make_unique<Entry>())
+               .first;
+    }
+  }
+  // Entries are never erased, so the reference outlives the lock.
+  return *it->second;
+}
+
+void RpcMetricsRegistry::count(Entry &e, std::uint32_t error_code) {
+  e.calls.fetch_add(1, std::memory_order_relaxed);
+  if (error_code == 0) {
+    return;
+  }
+  if (isTimeout(error_code)) {
+    e.timeouts.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    e.errors.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void RpcMetricsRegistry::recordOutgoing(const std::string &method,
+                                        std::chrono::microseconds round_trip,
+                                        std::uint32_t error_code) {
+  Entry &e = entry(outgoing_, method);
+  count(e, error_code);
+  e.latency.record(round_trip);
+}
+
+void RpcMetricsRegistry::recordIncoming(const std::string &method,
+                                        std::chrono::microseconds queueing,
+                                        std::chrono::microseconds handler,
+                                        std::uint32_t error_code) {
+  Entry &e = entry(incoming_, method);
+  count(e, error_code);
+  e.latency.record(handler);
+  e.queueing.record(queueing);
+}
+
+RpcMetrics RpcMetricsRegistry::snapshot() const {
+  auto copy = [](const Table &table, bool with_queueing) {
+    std::vector<RpcMethodMetrics> out;
+    out.reserve(table.size());
+    for (const auto &pair : table) {
+      const Entry &e = *pair.second;
+      RpcMethodMetrics m;
+      m.method = pair.first;
+      m.calls = e.calls.load(std::memory_order_relaxed);
+      m.errors = e.errors.load(std::memory_order_relaxed);
+      m.timeouts = e.timeouts.load(std::memory_order_relaxed);
+      m.latency = e.latency.snapshot();
+      if (with_queueing) {
+        m.queueing = e.queueing.snapshot();
+      }
+      out.push_back(std::move(m));
+    }
+    std::sort(out.begin(), out.end(),
+              [](const RpcMethodMetrics &a, const RpcMethodMetrics &b) {
+                return a.method < b.method;
+              });
+    return out;
+  };
+  std::lock_guard<std::mutex> lock(mutex_);
+  RpcMetrics metrics;
+  metrics.outgoing = copy(outgoing_, false);
+  metrics.incoming = copy(incoming_, true);
+  return metrics;
+}
+
+void RpcMetricsRegistry::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Table *table : {&outgoing_, &incoming_}) {
+    for (auto &pair : *table) {
+      Entry &e = *pair.second;
+      e.calls.store(0, std::memory_order_relaxed);
+      e.errors.store(0, std::memory_order_relaxed);
+      e.timeouts.store(0, std::memory_order_relaxed);
+      e.latency.reset();
+      e.queueing.reset();
+    }
+  }
+}
+
+} // namespace detail
+
+std::chrono::microseconds LatencySnapshot::percentile(double q) const {
+  if (count == 0) {
+    return std::chrono::microseconds(0);
+  }
+  q = std::min(std::max(q, 0.0), 1.0);
+  const auto rank = std::max<std::uint64_t>(
+      1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))));
+  std::uint64_t seen = 0;
+  for (const auto &bucket : buckets) {
+    seen += bucket.second;
+    if (seen >= rank) {
+      return std::min(std::max(bucket.first, min), max);
+    }
+  }
+  return max;
+}
+
+std::chrono::microseconds LatencySnapshot::mean() const {
+  if (count == 0) {
+    return std::chrono::microseconds(0);
+  }
+  return std::chrono::microseconds(total.count() /
+                                   static_cast<std::int64_t>(count));
+}
+
+RpcMetrics rpcMetrics() {
+  return detail::RpcMetricsRegistry::instance().snapshot();
+}
+
+void resetRpcMetrics() { detail::RpcMetricsRegistry::instance().reset(); }
+
+} // namespace livekit
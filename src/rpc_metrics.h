@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/rpc_metrics.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace livekit {
+namespace detail {
+
+// Lock-free log-linear histogram of microsecond latencies: 16 exact buckets
+// below 16us, then 16 linear sub-buckets per power of two up to ~2^40us.
+class LatencyHistogram {
+public:
+  static constexpr std::size_t kSubBuckets = 16;
+  static constexpr std::size_t kMaxExponent = 40;
+  static constexpr std::size_t kBucketCount =
+      kSubBuckets + (kMaxExponent - 4 + 1) * kSubBuckets;
+
+  void record(std::chrono::microseconds value) noexcept;
+  LatencySnapshot snapshot() const;
+  void reset() noexcept;
+
+  static std::size_t bucketIndex(std::uint64_t us) noexcept;
+  static std::uint64_t bucketUpperBound(std::size_t index) noexcept;
+
+private:
+  std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{};
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::uint64_t> total_{0};
+  std::atomic<std::uint64_t> min_{UINT64_MAX};
+  std::atomic<std::uint64_t> max_{0};
+};
+
+// Process-wide per-method RPC counters, fed by FfiClient (outgoing) and
+// LocalParticipant (incoming).
+class RpcMetricsRegistry {
+public:
+  // Distinct method names tracked per direction; later names are folded
+  // into kOverflowMethod so remote callers cannot grow the table unbounded.
+  static constexpr std::size_t kMaxMethods = 256;
+  static constexpr const char *kOverflowMethod = "(other)";
+
+  static RpcMetricsRegistry &instance();
+
+  // `error_code` is the RpcError code, or 0 for success.
+  void recordOutgoing(const std::string &method,
+                      std::chrono::microseconds round_trip,
+                      std::uint32_t error_code);
+  void recordIncoming(const std::string &method,
+                      std::chrono::microseconds queueing,
+                      std::chrono::microseconds handler,
+                      std::uint32_t error_code);
+
+  RpcMetrics snapshot() const;
+  void reset();
+
+private:
+  struct Entry {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> errors{0};
+    std::atomic<std::uint64_t> timeouts{0};
+    LatencyHistogram latency;
+    LatencyHistogram queueing;
+  };
+  using Table = std::unordered_map<std::string, std::unique_ptr<Entry>>;
+
+  Entry &entry(Table &table, const std::string &method);
+  static void count(Entry &e, std::uint32_t error_code);
+
+  mutable std::mutex mutex_;
+  Table outgoing_;
+  Table incoming_;
+};
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,394 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sdk_metrics.h"
+
+#include "latency_trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+std::atomic<bool> g_metrics_enabled{false};
+
+namespace {
+
+// Exported histogram boundaries, in microseconds. The fine-grained buckets
+// are folded into these, so an `le` count is exact to within one fine bucket
+// (about 6%).
+constexpr std::uint64_t kLatencyBoundsUs[] = {
+    100,     250,     500,     1000,    2500,    5000,
+    10000,   25000,   50000,   100000,  250000,  500000,
+    1000000, 2500000, 5000000, 10000000};
+
+std::string escapeLabel(const std::string &value) {
+  std::string out;
+  out.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+    case '\\':
+      out += "\\\\";
+      break;
+    case '"':
+      out += "\\\"";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    default:
+      out += c;
+    }
+  }
+  return out;
+}
+
+const char *threadRoleName(ThreadRole role) {
+  switch (role) {
+  case ThreadRole::kEventDispatch:
+    return "event_dispatch";
+  case ThreadRole::kAudio:
+    return "audio";
+  case ThreadRole::kVideo:
+    return "video";
+  case ThreadRole::kMediaClock:
+    return "media_clock";
+  case ThreadRole::kBackground:
+  default:
+    return "background";
+  }
+}
+
+std::string formatSeconds(std::uint64_t us) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.6f", static_cast<double>(us) / 1e6);
+  return buf;
+}
+
+void family(std::string &out, const char *name, const char *type,
+            const char *help) {
+  out += "# TYPE ";
+  out += name;
+  out += ' ';
+  out += type;
+  out += "\n# HELP ";
+  out += name;
+  out += ' ';
+  out += help;
+  out += '\n';
+}
+
+void sample(std::string &out, const std::string &name,
+            const std::string &labels, const std::string &value) {
+  out += name;
+  if (!labels.empty()) {
+    out += '{';
+    out += labels;
+    out += '}';
+  }
+  out += ' ';
+  out += value;
+  out += '\n';
+}
+
+void sample(std::string &out, const std::string &name,
+            const std::string &labels, std::uint64_t value) {
+  sample(out, name, labels, std::to_string(value));
+}
+
+std::uint64_t nonNegative(const std::atomic<std::int64_t> &gauge) {
+  return static_cast<std::uint64_t>(
+      std::max<std::int64_t>(gauge.load(std::memory_order_relaxed), 0));
+}
+
+void histogram(std::string &out, const std::string &name,
+               const std::string &labels, const LatencySnapshot &snap) {
+  const std::string prefix = labels.empty() ? "" : labels + ",";
+  std::uint64_t cumulative = 0;
+  auto it = snap.buckets.begin();
+  for (std::uint64_t bound : kLatencyBoundsUs) {
+    for (; it != snap.buckets.end() &&
+           static_cast<std::uint64_t>(it->first.count()) <= bound;
+         ++it) {
+      cumulative += it->second;
+    }
+    sample(out, name + "_bucket",
+           prefix + "le=\"" + formatSeconds(bound) + "\"", cumulative);
+  }
+  sample(out, name + "_bucket", prefix + "le=\"+Inf\"", snap.count);
+  sample(out, name + "_count", labels, snap.count);
+  sample(out, name + "_sum", labels,
+         formatSeconds(static_cast<std::uint64_t>(snap.total.count())));
+}
+
+void rpcFamilies(std::string &out, const RpcMetrics &rpc) {
+  struct Direction {
+    const char *name;
+    const std::vector<RpcMethodMetrics> &methods;
+  };
+  const Direction directions[] = {{"outgoing", rpc.outgoing},
+                                  {"incoming", rpc.incoming}};
+  auto labels = [](const char *direction, const RpcMethodMetrics &m) {
+    return std::string("direction=\"") + direction + "\",method=\"" +
+           escapeLabel(m.method) + "\"";
+  };
+
+  family(out, "livekit_rpc_calls", "counter", "RPC calls by method.");
+  for (const auto &d : directions) {
+    for (const auto &m : d.methods) {
+      sample(out, "livekit_rpc_calls_total", labels(d.name, m), m.calls);
+    }
+  }
+  family(out, "livekit_rpc_errors", "counter",
+         "RPC calls answered with an error, excluding timeouts.");
+  for (const auto &d : directions) {
+    for (const auto &m : d.methods) {
+      sample(out, "livekit_rpc_errors_total", labels(d.name, m), m.errors);
+    }
+  }
+  family(out, "livekit_rpc_timeouts", "counter", "RPC calls that timed out.");
+  for (const auto &d : directions) {
+    for (const auto &m : d.methods) {
+      sample(out, "livekit_rpc_timeouts_total", labels(d.name, m),
+             m.timeouts);
+    }
+  }
+  family(out, "livekit_rpc_duration_seconds", "histogram",
+         "Outgoing round trip, or incoming handler time.");
+  for (const auto &d : directions) {
+    for (const auto &m : d.methods) {
+      histogram(out, "livekit_rpc_duration_seconds", labels(d.name, m),
+                m.latency);
+    }
+  }
+  family(out, "livekit_rpc_queueing_seconds", "histogram",
+         "Time incoming RPCs waited before their handler started.");
+  for (const auto &m : rpc.incoming) {
+    histogram(out, "livekit_rpc_queueing_seconds", labels("incoming", m),
+              m.queueing);
+  }
+}
+
+void traceFamily(std::string &out, const LatencyTraceReport &trace) {
+  const char *const kinds[] = {"audio", "video"};
+  const TraceMedia media[] = {TraceMedia::kAudio, TraceMedia::kVideo};
+  bool declared = false;
+  for (int m = 0; m < 2; ++m) {
+    for (std::size_t i = 0; i < kTraceStageCount; ++i) {
+      const auto stage = static_cast<TraceStage>(i);
+      const LatencySnapshot &snap = trace.at(media[m], stage);
+      if (snap.count == 0) {
+        continue;
+      }
+      if (!declared) {
+        family(out, "livekit_media_stage_duration_seconds", "histogram",
+               "Per-frame time spent in each SDK media stage (tracing).");
+        declared = true;
+      }
+      histogram(out, "livekit_media_stage_duration_seconds",
+                std::string("kind=\"") + kinds[m] + "\",stage=\"" +
+                    traceStageName(stage) + "\"",
+                snap);
+    }
+  }
+}
+
+} // namespace
+
+void StreamMetrics::observeDepth(std::size_t depth,
+                                 std::atomic<std::int64_t> &reported) noexcept {
+  if (!metricsOn()) {
+    return;
+  }
+  const auto now = static_cast<std::int64_t>(depth);
+  const auto prev = reported.exchange(now, std::memory_order_relaxed);
+  if (now != prev) {
+    queued_frames.fetch_add(now - prev, std::memory_order_relaxed);
+  }
+}
+
+void StreamMetrics::observeBytes(std::size_t bytes,
+                                 std::atomic<std::int64_t> &reported) noexcept {
+  if (!metricsOn()) {
+    return;
+  }
+  const auto now = static_cast<std::int64_t>(bytes);
+  const auto prev = reported.exchange(now, std::memory_order_relaxed);
+  if (now != prev) {
+    queued_bytes.fetch_add(now - prev, std::memory_order_relaxed);
+  }
+}
+
+void StreamMetrics::observeRingDrops(
+    std::uint64_t ring_dropped, std::atomic<std::uint64_t> &seen) noexcept {
+  if (!metricsOn()) {
+    return;
+  }
+  const auto prev = seen.exchange(ring_dropped, std::memory_order_relaxed);
+  if (ring_dropped > prev) {
+    frames_dropped.add(ring_dropped - prev);
+  }
+}
+
+void StreamMetrics::release(std::size_t discarded,
+                            std::atomic<std::int64_t> &reported) noexcept {
+  // Not gated: a depth reported while enabled must be withdrawn even if
+  // metrics have been switched off since.
+  const auto prev = reported.exchange(0, std::memory_order_relaxed);
+  if (prev != 0) {
+    queued_frames.fetch_sub(prev, std::memory_order_relaxed);
+  }
+  if (discarded > 0) {
+    frames_dropped.add(discarded);
+  }
+}
+
+void StreamMetrics::releaseBytes(
+    std::atomic<std::int64_t> &reported) noexcept {
+  const auto prev = reported.exchange(0, std::memory_order_relaxed);
+  if (prev != 0) {
+    queued_bytes.fetch_sub(prev, std::memory_order_relaxed);
+  }
+}
+
+void StreamMetrics::reset() noexcept {
+  frames_received.reset();
+  frames_dropped.reset();
+}
+
+SdkMetrics &SdkMetrics::instance() {
+  static SdkMetrics metrics;
+  return metrics;
+}
+
+void SdkMetrics::reset() noexcept {
+  audio.reset();
+  video.reset();
+  ffi_requests.reset();
+  ffi_request_latency.reset();
+  data_stream_bytes_sent.reset();
+  data_stream_bytes_received.reset();
+  reconnects.reset();
+  reconnect_failures.reset();
+  reconnect_latency.reset();
+}
+
+std::string renderOpenMetrics(const SdkMetrics &sdk, const RpcMetrics &rpc,
+                              const ScrapeGauges &gauges,
+                              const LatencyTraceReport *trace) {
+  std::string out;
+  out.reserve(4096);
+
+  const StreamMetrics *const streams[] = {&sdk.audio, &sdk.video};
+  const char *const kinds[] = {"kind=\"audio\"", "kind=\"video\""};
+  family(out, "livekit_stream_frames_received", "counter",
+         "Frames delivered by the FFI to audio/video streams.");
+  for (int i = 0; i < 2; ++i) {
+    sample(out, "livekit_stream_frames_received_total", kinds[i],
+           streams[i]->frames_received.value());
+  }
+  family(out, "livekit_stream_frames_dropped", "counter",
+         "Frames dropped by a full stream queue or discarded at close.");
+  for (int i = 0; i < 2; ++i) {
+    sample(out, "livekit_stream_frames_dropped_total", kinds[i],
+           streams[i]->frames_dropped.value());
+  }
+  family(out, "livekit_stream_queued_frames", "gauge",
+         "Frames waiting in stream queues, as of each stream's last frame.");
+  for (int i = 0; i < 2; ++i) {
+    const auto queued =
+        streams[i]->queued_frames.load(std::memory_order_relaxed);
+    sample(out, "livekit_stream_queued_frames", kinds[i],
+           static_cast<std::uint64_t>(std::max<std::int64_t>(queued, 0)));
+  }
+  family(out, "livekit_stream_queued_bytes", "gauge",
+         "Estimated bytes waiting in stream and data-stream reader queues.");
+  for (int i = 0; i < 2; ++i) {
+    sample(out, "livekit_stream_queued_bytes", kinds[i],
+           nonNegative(streams[i]->queued_bytes));
+  }
+  sample(out, "livekit_stream_queued_bytes", "kind=\"data\"",
+         nonNegative(sdk.resources.stream_reader_bytes));
+  family(out, "livekit_live_handles", "gauge",
+         "Live FFI handles by kind, counted while metrics are enabled.");
+  for (std::size_t i = 0; i < kResourceKindCount; ++i) {
+    sample(out, "livekit_live_handles",
+           std::string("kind=\"") +
+               resourceKindName(static_cast<ResourceKind>(i)) + "\"",
+           nonNegative(sdk.resources.live_handles[i]));
+  }
+
+  family(out, "livekit_ffi_requests", "counter",
+         "Synchronous requests sent to the FFI.");
+  sample(out, "livekit_ffi_requests_total", "", sdk.ffi_requests.value());
+  family(out, "livekit_ffi_request_duration_seconds", "histogram",
+         "Time spent inside synchronous FFI requests.");
+  histogram(out, "livekit_ffi_request_duration_seconds", "",
+            sdk.ffi_request_latency.snapshot());
+  family(out, "livekit_ffi_pending_async_operations", "gauge",
+         "Async FFI operations awaiting their callback.");
+  sample(out, "livekit_ffi_pending_async_operations", "",
+         gauges.pending_async_operations);
+  family(out, "livekit_ffi_listeners", "gauge",
+         "Registered FFI event listeners.");
+  sample(out, "livekit_ffi_listeners", "", gauges.listeners);
+
+  family(out, "livekit_data_stream_bytes_sent", "counter",
+         "Payload bytes written to outgoing data streams.");
+  sample(out, "livekit_data_stream_bytes_sent_total", "",
+         sdk.data_stream_bytes_sent.value());
+  family(out, "livekit_data_stream_bytes_received", "counter",
+         "Payload bytes received on incoming data streams.");
+  sample(out, "livekit_data_stream_bytes_received_total", "",
+         sdk.data_stream_bytes_received.value());
+
+  family(out, "livekit_room_reconnects", "counter",
+         "Room reconnects that completed.");
+  sample(out, "livekit_room_reconnects_total", "", sdk.reconnects.value());
+  family(out, "livekit_room_reconnect_failures", "counter",
+         "Room reconnects that ended in a disconnect.");
+  sample(out, "livekit_room_reconnect_failures_total", "",
+         sdk.reconnect_failures.value());
+  family(out, "livekit_room_reconnect_duration_seconds", "histogram",
+         "Time from Reconnecting to Reconnected.");
+  histogram(out, "livekit_room_reconnect_duration_seconds", "",
+            sdk.reconnect_latency.snapshot());
+
+  if (!gauges.threads.empty()) {
+    family(out, "livekit_thread_cpu_seconds", "counter",
+           "CPU time consumed by each live SDK thread.");
+    for (const auto &t : gauges.threads) {
+      sample(out, "livekit_thread_cpu_seconds_total",
+             "thread=\"" + escapeLabel(t.name) + "\",role=\"" +
+                 threadRoleName(t.role) + "\"",
+             formatSeconds(static_cast<std::uint64_t>(t.cpu_time.count())));
+    }
+  }
+
+  rpcFamilies(out, rpc);
+  if (trace) {
+    traceFamily(out, *trace);
+  }
+
+  out += "# EOF\n";
+  return out;
+}
+
+} // namespace detail
+} // namespace livekit
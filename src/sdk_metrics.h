@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/latency_trace.h"
+#include "livekit/resources.h"
+#include "livekit/thread_options.h"
+#include "rpc_metrics.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+extern std::atomic<bool> g_metrics_enabled;
+
+// Hot paths check this before touching any SDK metric.
+inline bool metricsOn() noexcept {
+  return g_metrics_enabled.load(std::memory_order_relaxed);
+}
+
+// Monotonic counter; add() is a no-op while metrics are disabled.
+class MetricCounter {
+public:
+  void add(std::uint64_t n = 1) noexcept {
+    if (metricsOn()) {
+      value_.fetch_add(n, std::memory_order_relaxed);
+    }
+  }
+  std::uint64_t value() const noexcept {
+    return value_.load(std::memory_order_relaxed);
+  }
+  void reset() noexcept { value_.store(0, std::memory_order_relaxed); }
+
+private:
+  std::atomic<std::uint64_t> value_{0};
+};
+
+// Frame accounting shared by every AudioStream (or every VideoStream).
+//
+// Only the producer side (pushFrame on the FFI event thread) reports, so the
+// consumer read paths stay untouched: queued_frames is the sum of each
+// stream's depth as of its last push, and frames still queued when a stream
+// is closed count as dropped.
+struct StreamMetrics {
+  MetricCounter frames_received;
+  MetricCounter frames_dropped;
+  std::atomic<std::int64_t> queued_frames{0};
+  // Estimated as depth times the size of the frame just pushed.
+  std::atomic<std::int64_t> queued_bytes{0};
+
+  // Re-report one stream's queue depth; `reported` is that stream's last
+  // reported depth.
+  void observeDepth(std::size_t depth,
+                    std::atomic<std::int64_t> &reported) noexcept;
+  // Same for queued_bytes, with `reported` that stream's last byte count.
+  void observeBytes(std::size_t bytes,
+                    std::atomic<std::int64_t> &reported) noexcept;
+  // Fold a ring's cumulative drop counter into frames_dropped; `seen` is
+  // the part already counted.
+  void observeRingDrops(std::uint64_t ring_dropped,
+                        std::atomic<std::uint64_t> &seen) noexcept;
+  // Stream closed with `discarded` frames still queued.
+  void release(std::size_t discarded,
+               std::atomic<std::int64_t> &reported) noexcept;
+  // Withdraw a closed stream's reported queued_bytes.
+  void releaseBytes(std::atomic<std::int64_t> &reported) noexcept;
+  void reset() noexcept;
+};
+
+// Live resources behind resourceSnapshot(). These mirror live objects, so
+// SdkMetrics::reset() leaves them alone.
+struct ResourceGauges {
+  std::array<std::atomic<std::int64_t>, kResourceKindCount> live_handles{};
+  // Bytes charged to any StreamBudget (reader queues and stream callbacks).
+  std::atomic<std::int64_t> stream_reader_bytes{0};
+
+  void onHandleCreated(ResourceKind kind) noexcept {
+    live_handles[static_cast<std::size_t>(kind)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void onHandleDropped(ResourceKind kind) noexcept {
+    live_handles[static_cast<std::size_t>(kind)].fetch_sub(
+        1, std::memory_order_relaxed);
+  }
+};
+
+// Process-wide SDK counters exported by metricsToOpenMetrics().
+struct SdkMetrics {
+  static SdkMetrics &instance();
+
+  StreamMetrics audio;
+  StreamMetrics video;
+
+  MetricCounter ffi_requests;
+  LatencyHistogram ffi_request_latency;
+
+  MetricCounter data_stream_bytes_sent;
+  MetricCounter data_stream_bytes_received;
+
+  // Room reconnects (kReconnecting -> kReconnected) and the ones that ended
+  // in a disconnect instead.
+  MetricCounter reconnects;
+  MetricCounter reconnect_failures;
+  LatencyHistogram reconnect_latency;
+
+  ResourceGauges resources;
+
+  void reset() noexcept;
+};
+
+// Values sampled at scrape time rather than maintained on hot paths.
+struct ScrapeGauges {
+  std::uint64_t pending_async_operations = 0;
+  std::uint64_t listeners = 0;
+  std::vector<ThreadCpuStats> threads;
+};
+
+// OpenMetrics text exposition of `sdk`, `rpc` and `gauges`, ending in
+// "# EOF". Stages of `trace` that hold samples are rendered as one
+// histogram family.
+std::string renderOpenMetrics(const SdkMetrics &sdk, const RpcMetrics &rpc,
+                              const ScrapeGauges &gauges,
+                              const LatencyTraceReport *trace = nullptr);
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,295 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/shared_frame_ring.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "livekit/audio_frame.h"
+#include "livekit/video_frame.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "livekit/frame_ring_abi.h"
+#endif
+
+namespace livekit {
+
+#ifndef _WIN32
+
+namespace {
+
+std::size_t alignUp(std::size_t n, std::size_t align) {
+  return (n + align - 1) / align * align;
+}
+
+lk_frame_ring_header *header(std::uint8_t *base) {
+  return reinterpret_cast<lk_frame_ring_header *>(base);
+}
+
+lk_frame_slot_header *slotAt(std::uint8_t *base, std::size_t slot_size,
+                             std::size_t slot_count, std::uint64_t index) {
+  return reinterpret_cast<lk_frame_slot_header *>(
+      base + LK_FRAME_RING_ALIGN + (index % slot_count) * slot_size);
+}
+
+[[noreturn]] void throwErrno(const std::string &what) {
+  throw std::runtime_error("SharedFrameRing: " + what + ": " +
+                           std::strerror(errno));
+}
+
+} // namespace
+
+SharedFrameRing::SharedFrameRing(Kind kind, const Options &options)
+    : kind_(kind), name_(options.name),
+      unlink_on_destroy_(options.unlink_on_destroy) {
+  if (options.slot_count == 0 || options.max_frame_bytes == 0) {
+    throw std::invalid_argument(
+        "SharedFrameRing: slot_count and max_frame_bytes must be non-zero");
+  }
+  slot_count_ = options.slot_count;
+  max_payload_ = options.max_frame_bytes;
+  slot_size_ = alignUp(LK_FRAME_SLOT_PAYLOAD_OFFSET + max_payload_,
+                       LK_FRAME_RING_ALIGN);
+  size_ = LK_FRAME_RING_ALIGN + slot_size_ * slot_count_;
+
+  if (name_.empty()) {
+#ifdef __linux__
+    fd_ = ::memfd_create("livekit-frame-ring", MFD_CLOEXEC);
+    if (fd_ < 0) {
+      throwErrno("memfd_create");
+    }
+#else
+    throw std::invalid_argument(
+        "SharedFrameRing: anonymous rings need memfd (Linux); set a name");
+#endif
+  } else {
+    fd_ = ::shm_open(name_.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (fd_ < 0) {
+      throwErrno("shm_open(" + name_ + ")");
+    }
+  }
+
+  auto fail = [this](const char *what) {
+    const int err = errno;
+    ::close(fd_);
+    if (!name_.empty()) {
+      ::shm_unlink(name_.c_str());
+    }
+    errno = err;
+    throwErrno(what);
+  };
+  if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+    fail("ftruncate");
+  }
+  void *mem =
+      ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (mem == MAP_FAILED) {
+    fail("mmap");
+  }
+  base_ = static_cast<std::uint8_t *>(mem);
+
+  // ftruncate zero-filled the object; the magic goes in last so a reader
+  // never sees a half-initialized header as valid.
+  lk_frame_ring_header *h = header(base_);
+  h->version = LK_FRAME_RING_VERSION;
+  h->kind = static_cast<std::uint32_t>(kind_);
+  h->slot_count = static_cast<std::uint32_t>(slot_count_);
+  h->slot_size = slot_size_;
+  h->max_payload = max_payload_;
+  h->producer_pid = static_cast<std::uint32_t>(::getpid());
+  __atomic_store_n(&h->magic, LK_FRAME_RING_MAGIC, __ATOMIC_RELEASE);
+}
+
+SharedFrameRing::~SharedFrameRing() {
+  close();
+  if (base_) {
+    ::munmap(base_, size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+  if (!name_.empty() && unlink_on_destroy_) {
+    ::shm_unlink(name_.c_str());
+  }
+}
+
+void *SharedFrameRing::beginWrite(std::size_t payload_size) noexcept {
+  if (closed_) {
+    return nullptr;
+  }
+  if (payload_size > max_payload_) {
+    too_large_.fetch_add(1, std::memory_order_relaxed);
+    __atomic_fetch_add(&header(base_)->dropped, 1, __ATOMIC_RELAXED);
+    return nullptr;
+  }
+  lk_frame_slot_header *slot =
+      slotAt(base_, slot_size_, slot_count_, next_index_);
+  // Seqlock write side: odd sequence, then the data, then even again.
+  const std::uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+  __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  slot->frame_index = next_index_;
+  slot->payload_size = static_cast<std::uint32_t>(payload_size);
+  return slot;
+}
+
+void SharedFrameRing::publish(void *slot_ptr) noexcept {
+  auto *slot = static_cast<lk_frame_slot_header *>(slot_ptr);
+  const std::uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+  __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELEASE);
+  ++next_index_;
+  __atomic_store_n(&header(base_)->write_index, next_index_, __ATOMIC_RELEASE);
+  written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool SharedFrameRing::write(const VideoFrame &frame, std::int64_t timestamp_us,
+                            VideoRotation rotation) {
+  if (kind_ != Kind::kVideo) {
+    return false;
+  }
+  const VideoPlanes planes = frame.planes();
+  if (planes.empty() || planes.size() > LK_FRAME_RING_MAX_PLANES) {
+    return false;
+  }
+  std::size_t total = 0;
+  for (const auto &plane : planes) {
+    total += plane.size;
+  }
+  void *slot_ptr = beginWrite(total);
+  if (!slot_ptr) {
+    return false;
+  }
+  auto *slot = static_cast<lk_frame_slot_header *>(slot_ptr);
+  slot->timestamp_us = timestamp_us;
+  slot->format = static_cast<std::uint32_t>(frame.type());
+  slot->width = static_cast<std::uint32_t>(frame.width());
+  slot->height = static_cast<std::uint32_t>(frame.height());
+  slot->rotation = static_cast<std::uint32_t>(rotation);
+  slot->plane_count = static_cast<std::uint32_t>(planes.size());
+  slot->sample_rate = slot->num_channels = slot->samples_per_channel = 0;
+  std::uint8_t *payload = reinterpret_cast<std::uint8_t *>(slot_ptr) +
+                          LK_FRAME_SLOT_PAYLOAD_OFFSET;
+  std::uint32_t offset = 0;
+  for (std::size_t i = 0; i < LK_FRAME_RING_MAX_PLANES; ++i) {
+    if (i >= planes.size()) {
+      slot->plane_offset[i] = slot->plane_stride[i] = 0;
+      continue;
+    }
+    slot->plane_offset[i] = offset;
+    slot->plane_stride[i] = planes[i].stride;
+    std::memcpy(payload + offset,
+                reinterpret_cast<const void *>(planes[i].data_ptr),
+                planes[i].size);
+    offset += planes[i].size;
+  }
+  publish(slot_ptr);
+  return true;
+}
+
+bool SharedFrameRing::writeAudio(const std::int16_t *samples,
+                                 int sample_rate, int num_channels,
+                                 int samples_per_channel,
+                                 std::int64_t timestamp_us) {
+  if (kind_ != Kind::kAudio) {
+    return false;
+  }
+  const std::size_t bytes = static_cast<std::size_t>(num_channels) *
+                            static_cast<std::size_t>(samples_per_channel) *
+                            sizeof(std::int16_t);
+  void *slot_ptr = beginWrite(bytes);
+  if (!slot_ptr) {
+    return false;
+  }
+  auto *slot = static_cast<lk_frame_slot_header *>(slot_ptr);
+  slot->timestamp_us = timestamp_us;
+  slot->format = 0;
+  slot->width = slot->height = slot->rotation = slot->plane_count = 0;
+  slot->sample_rate = static_cast<std::uint32_t>(sample_rate);
+  slot->num_channels = static_cast<std::uint32_t>(num_channels);
+  slot->samples_per_channel = static_cast<std::uint32_t>(samples_per_channel);
+  if (bytes != 0) {
+    std::memcpy(static_cast<std::uint8_t *>(slot_ptr) +
+                    LK_FRAME_SLOT_PAYLOAD_OFFSET,
+                samples, bytes);
+  }
+  publish(slot_ptr);
+  return true;
+}
+
+void SharedFrameRing::close() noexcept {
+  if (closed_ || !base_) {
+    return;
+  }
+  closed_ = true;
+  __atomic_store_n(&header(base_)->closed, 1u, __ATOMIC_RELEASE);
+}
+
+#else // _WIN32
+
+SharedFrameRing::SharedFrameRing(Kind kind, const Options &options)
+    : kind_(kind), name_(options.name),
+      unlink_on_destroy_(options.unlink_on_destroy) {
+  throw std::runtime_error(
+      "SharedFrameRing: shared-memory export is not supported on Windows");
+}
+
+SharedFrameRing::~SharedFrameRing() = default;
+
+void *SharedFrameRing::beginWrite(std::size_t) noexcept { return nullptr; }
+void SharedFrameRing::publish(void *) noexcept {}
+bool SharedFrameRing::writeAudio(const std::int16_t *, int, int, int,
+                                 std::int64_t) {
+  return false;
+}
+bool SharedFrameRing::write(const VideoFrame &, std::int64_t, VideoRotation) {
+  return false;
+}
+void SharedFrameRing::close() noexcept {}
+
+#endif // _WIN32
+
+bool SharedFrameRing::write(const AudioFrameView &frame,
+                            std::int64_t timestamp_us) {
+  if (!frame.data()) {
+    return false;
+  }
+  return writeAudio(frame.data(), frame.sample_rate(), frame.num_channels(),
+                    frame.samples_per_channel(), timestamp_us);
+}
+
+bool SharedFrameRing::write(const AudioFrame &frame,
+                            std::int64_t timestamp_us) {
+  return writeAudio(frame.data().data(), frame.sample_rate(),
+                    frame.num_channels(), frame.samples_per_channel(),
+                    timestamp_us);
+}
+
+SharedFrameRing::Stats SharedFrameRing::stats() const noexcept {
+  Stats stats;
+  stats.frames_written = written_.load(std::memory_order_relaxed);
+  stats.frames_too_large = too_large_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+} // namespace livekit
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+/**
+ * Fixed-capacity single-producer / single-consumer frame ring.
+ *
+ * The hot path (push/tryPop) takes no lock. The ring keeps drop-oldest
+ * semantics without letting the producer touch consumer-owned slots: it
+ * stores up to 2 * capacity items, and the consumer skips ahead so it only
+ * ever observes the newest `capacity` items. Only if the consumer falls a full
+ * 2 * capacity behind does the producer drop the incoming item.
+ *
+ * Waiting readers spin briefly and then park on a condition variable; the
+ * producer only touches the mutex when a reader is actually parked.
+ *
+ * Exactly one thread may call push() and exactly one thread may call
+ * tryPop()/pop() at any time.
+ */
+template <typename T> class SpscRing {
+public:
+  explicit SpscRing(std::size_t capacity)
+      : capacity_(capacity == 0 ? 1 : capacity), slots_(capacity_ * 2) {}
+
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  /// Producer side. Returns false if the item had to be dropped.
+  bool push(T &&item) {
+    const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    if (tail - head >= slots_.size()) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    slots_[tail % slots_.size()] = std::move(item);
+    tail_.store(tail + 1, std::memory_order_release);
+    wakeConsumer();
+    return true;
+  }
+
+  /// Consumer side, non-blocking.
+  bool tryPop(T &out) {
+    if (discard_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    std::uint64_t head = head_.load(std::memory_order_relaxed);
+    const std::uint64_t tail = tail_.load(std::memory_order_acquire);
+    if (head == tail) {
+      return false;
+    }
+    // Drop-oldest: discard anything older than the newest `capacity_` items.
+    if (tail - head > capacity_) {
+      const std::uint64_t skip_to = tail - capacity_;
+      dropped_.fetch_add(skip_to - head, std::memory_order_relaxed);
+      for (; head < skip_to; ++head) {
+        slots_[head % slots_.size()] = T{};
+      }
+    }
+    T &slot = slots_[head % slots_.size()];
+    out = std::move(slot);
+    slot = T{};
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Consumer side, blocking. Spins for `spin_iterations` and then parks until
+   * an item arrives or close() is called. Returns false once closed and
+   * drained.
+   */
+  bool pop(T &out, std::uint32_t spin_iterations = kDefaultSpinIterations) {
+    for (std::uint32_t i = 0; i < spin_iterations; ++i) {
+      if (tryPop(out)) {
+        return true;
+      }
+      if (closed_.load(std::memory_order_acquire)) {
+        return tryPop(out);
+      }
+      std::this_thread::yield();
+    }
+    for (;;) {
+      if (tryPop(out)) {
+        return true;
+      }
+      if (closed_.load(std::memory_order_acquire)) {
+        return tryPop(out);
+      }
+      park();
+    }
+  }
+
+  /// Like pop(), but gives up after `timeout`. Returns false on timeout or
+  /// once closed and drained.
+  template <class Rep, class Period>
+  bool popFor(T &out, const std::chrono::duration<Rep, Period> &timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+      if (tryPop(out)) {
+        return true;
+      }
+      if (closed_.load(std::memory_order_acquire)) {
+        return tryPop(out);
+      }
+      if (!parkUntil(deadline)) {
+        return tryPop(out);
+      }
+    }
+  }
+
+  /// Wake any parked consumer. Subsequent pops drain what is queued and then
+  /// fail, or fail immediately if `discard_pending` is set.
+  void close(bool discard_pending = false) {
+    if (discard_pending) {
+      discard_.store(true, std::memory_order_release);
+    }
+    closed_.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    park_cv_.notify_all();
+  }
+
+  bool closed() const noexcept {
+    return closed_.load(std::memory_order_acquire);
+  }
+
+  /// Approximate number of items a reader would currently see.
+  std::size_t size() const noexcept {
+    const std::uint64_t tail = tail_.load(std::memory_order_acquire);
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    const std::uint64_t n = tail - head;
+    return static_cast<std::size_t>(n > capacity_ ? capacity_ : n);
+  }
+
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  /// Total items dropped (by skip-ahead or a full ring) so far.
+  std::uint64_t dropped() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  static constexpr std::uint32_t kDefaultSpinIterations = 64;
+
+private:
+  bool empty() const noexcept {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+  void wakeConsumer() {
+    // Pairs with the fence in park(): either we see the reader parked, or the
+    // reader sees our tail update before it sleeps.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+      park_cv_.notify_one();
+    }
+  }
+
+  void park() {
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    parked_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    park_cv_.wait(lock, [this] {
+      return !empty() || closed_.load(std::memory_order_acquire);
+    });
+    parked_.store(false, std::memory_order_relaxed);
+  }
+
+  // Returns false if the deadline passed without an item or close().
+  bool parkUntil(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    parked_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool ready = park_cv_.wait_until(lock, deadline, [this] {
+      return !empty() || closed_.load(std::memory_order_acquire);
+    });
+    parked_.store(false, std::memory_order_relaxed);
+    return ready;
+  }
+
+  const std::size_t capacity_;
+  std::vector<T> slots_;
+
+  alignas(64) std::atomic<std::uint64_t> head_{0}; // consumer-owned
+  alignas(64) std::atomic<std::uint64_t> tail_{0}; // producer-owned
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> closed_{false};
+  std::atomic<bool> discard_{false};
+
+  std::atomic<bool> parked_{false};
+  std::mutex park_mutex_;
+  std::condition_variable park_cv_;
+};
+
+} // namespace detail
+} // namespace livekit
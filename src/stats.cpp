@@ -646,6 +646,99 @@ RtcStats fromProto(const proto::RtcStats &s) {
   }
 }
 
+bool rtcStatsSelected(const proto::RtcStats &s, RtcStatsTypeMask mask) {
+  using P = proto::RtcStats;
+  if (mask == kAllRtcStatsTypes) {
+    return true;
+  }
+  RtcStatsType type;
+  switch (s.stats_case()) {
+  case P::kCodec:
+    type = RtcStatsType::kCodec;
+    break;
+  case P::kInboundRtp:
+    type = RtcStatsType::kInboundRtp;
+    break;
+  case P::kOutboundRtp:
+    type = RtcStatsType::kOutboundRtp;
+    break;
+  case P::kRemoteInboundRtp:
+    type = RtcStatsType::kRemoteInboundRtp;
+    break;
+  case P::kRemoteOutboundRtp:
+    type = RtcStatsType::kRemoteOutboundRtp;
+    break;
+  case P::kMediaSource:
+    type = RtcStatsType::kMediaSource;
+    break;
+  case P::kMediaPlayout:
+    type = RtcStatsType::kMediaPlayout;
+    break;
+  case P::kPeerConnection:
+    type = RtcStatsType::kPeerConnection;
+    break;
+  case P::kDataChannel:
+    type = RtcStatsType::kDataChannel;
+    break;
+  case P::kTransport:
+    type = RtcStatsType::kTransport;
+    break;
+  case P::kCandidatePair:
+    type = RtcStatsType::kCandidatePair;
+    break;
+  case P::kLocalCandidate:
+    type = RtcStatsType::kLocalCandidate;
+    break;
+  case P::kRemoteCandidate:
+    type = RtcStatsType::kRemoteCandidate;
+    break;
+  case P::kCertificate:
+    type = RtcStatsType::kCertificate;
+    break;
+  case P::kStream:
+    type = RtcStatsType::kStream;
+    break;
+  default:
+    // Deprecated or unset entries are only kept when everything is asked
+    // for, matching the unfiltered behaviour.
+    return false;
+  }
+  return (mask & static_cast<RtcStatsTypeMask>(type)) != 0;
+}
+
+const RtcCandidatePairStats *
+PeerConnectionSessionStats::selectedCandidatePair() const {
+  for (const auto &transport : transports) {
+    const auto &id = transport.transport.selected_candidate_pair_id;
+    if (id.empty()) {
+      continue;
+    }
+    for (const auto &pair : candidate_pairs) {
+      if (pair.rtc.id == id) {
+        return &pair;
+      }
+    }
+  }
+  for (const auto &pair : candidate_pairs) {
+    if (pair.candidate_pair.nominated) {
+      return &pair;
+    }
+  }
+  return nullptr;
+}
+
+void appendSessionStats(RtcStats stats, PeerConnectionSessionStats &out) {
+  if (auto *pc = std::get_if<RtcPeerConnectionStats>(&stats.stats)) {
+    out.peer_connection = std::move(*pc);
+  } else if (auto *t = std::get_if<RtcTransportStats>(&stats.stats)) {
+    out.transports.push_back(std::move(*t));
+  } else if (auto *cp = std::get_if<RtcCandidatePairStats>(&stats.stats)) {
+    out.candidate_pairs.push_back(std::move(*cp));
+  } else {
+    out.other.push_back(std::move(stats));
+  }
+}
+
 std::vector<RtcStats> fromProto(const std::vector<proto::RtcStats> &src) {
   std::vector<RtcStats> out;
   out.reserve(src.size());
@@ -0,0 +1,237 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/stats_sampler.h"
+
+#include "livekit/local_participant.h"
+#include "livekit/local_track_publication.h"
+#include "livekit/remote_participant.h"
+#include "livekit/remote_track_publication.h"
+#include "livekit/room.h"
+#include "thread_util.h"
+
+#include <algorithm>
+#include <future>
+#include <iostream>
+#include <utility>
+
+namespace livekit {
+
+namespace detail {
+
+TrackStatsSummary
+TrackStatsAccumulator::update(const std::vector<RtcStats> &stats, bool local) {
+  TrackStatsSummary out;
+  out.local = local;
+
+  std::int64_t timestamp_ms = 0;
+  std::uint64_t bytes = 0;
+  std::uint64_t packets = 0;
+  std::int64_t lost = 0;
+  double jitter_sec = 0.0;
+  double fraction_lost = 0.0;
+  int fraction_reports = 0;
+  double rtt_sec = 0.0;
+  std::uint32_t largest_width = 0;
+  QualityLimitationReason limitation = QualityLimitationReason::None;
+
+  for (const auto &s : stats) {
+    if (const auto *o = std::get_if<RtcOutboundRtpStats>(&s.stats)) {
+      timestamp_ms = std::max(timestamp_ms, o->rtc.timestamp_ms);
+      bytes += o->sent.bytes_sent;
+      packets += o->sent.packets_sent;
+      out.frames_per_second =
+          std::max(out.frames_per_second, o->outbound.frames_per_second);
+      if (o->outbound.frame_width >= largest_width) {
+        largest_width = o->outbound.frame_width;
+        out.frame_width = o->outbound.frame_width;
+        out.frame_height = o->outbound.frame_height;
+        limitation = o->outbound.quality_limitation_reason;
+      }
+    } else if (const auto *ri =
+                   std::get_if<RtcRemoteInboundRtpStats>(&s.stats)) {
+      jitter_sec = std::max(jitter_sec, ri->received.jitter);
+      fraction_lost += ri->remote_inbound.fraction_lost;
+      ++fraction_reports;
+      rtt_sec = std::max(rtt_sec, ri->remote_inbound.round_trip_time);
+    } else if (const auto *in = std::get_if<RtcInboundRtpStats>(&s.stats)) {
+      timestamp_ms = std::max(timestamp_ms, in->rtc.timestamp_ms);
+      bytes += in->inbound.bytes_received;
+      packets += in->received.packets_received;
+      lost += in->received.packets_lost;
+      jitter_sec = std::max(jitter_sec, in->received.jitter);
+      out.frames_per_second =
+          std::max(out.frames_per_second, in->inbound.frames_per_second);
+      out.frame_width = std::max(out.frame_width, in->inbound.frame_width);
+      out.frame_height = std::max(out.frame_height, in->inbound.frame_height);
+    }
+  }
+
+  out.jitter_ms = jitter_sec * 1000.0;
+  out.round_trip_time_ms = rtt_sec * 1000.0;
+  out.quality_limitation = limitation;
+
+  // Counters only grow; a drop means the stream was renegotiated, so start
+  // over rather than report a negative rate.
+  const bool continuous = has_previous_ && timestamp_ms > timestamp_ms_ &&
+                          bytes >= bytes_ && packets >= packets_;
+  if (continuous) {
+    out.interval_sec = static_cast<double>(timestamp_ms - timestamp_ms_) /
+                       1000.0;
+    out.bitrate_bps =
+        static_cast<double>(bytes - bytes_) * 8.0 / out.interval_sec;
+    out.packets_per_sec =
+        static_cast<double>(packets - packets_) / out.interval_sec;
+    out.jitter_delta_ms = out.jitter_ms - jitter_ms_;
+    if (!local) {
+      const auto lost_delta = std::max<std::int64_t>(lost - lost_, 0);
+      const double expected =
+          static_cast<double>(packets - packets_) +
+          static_cast<double>(lost_delta);
+      out.packet_loss =
+          expected > 0.0 ? static_cast<double>(lost_delta) / expected : 0.0;
+    }
+  }
+  if (local && fraction_reports > 0) {
+    out.packet_loss = fraction_lost / fraction_reports;
+  }
+  out.quality_limitation_changed = has_previous_ && limitation != limitation_;
+
+  has_previous_ = true;
+  timestamp_ms_ = timestamp_ms;
+  bytes_ = bytes;
+  packets_ = packets;
+  lost_ = lost;
+  jitter_ms_ = out.jitter_ms;
+  limitation_ = limitation;
+  return out;
+}
+
+} // namespace detail
+
+StatsSampler::StatsSampler(Room &room, Options options, Callback callback)
+    : room_(room), options_(options), callback_(std::move(callback)) {}
+
+StatsSampler::~StatsSampler() { stop(); }
+
+void StatsSampler::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (thread_.joinable()) {
+    return;
+  }
+  stop_ = false;
+  thread_ = std::thread([this] {
+    detail::registerThread(ThreadRole::kBackground, "lk-stats");
+    run();
+  });
+}
+
+void StatsSampler::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+std::vector<TrackStatsSummary> StatsSampler::sampleOnce() {
+  struct Pending {
+    std::string identity;
+    std::shared_ptr<Track> track;
+    bool local;
+    std::future<std::vector<RtcStats>> stats;
+  };
+  constexpr RtcStatsTypeMask kLocalTypes =
+      RtcStatsType::kOutboundRtp | RtcStatsType::kRemoteInboundRtp;
+  constexpr RtcStatsTypeMask kRemoteTypes =
+      static_cast<RtcStatsTypeMask>(RtcStatsType::kInboundRtp);
+
+  // Issue every request first so the FFI round trips overlap.
+  std::vector<Pending> pending;
+  auto request = [&](const std::string &identity,
+                     const std::shared_ptr<Track> &track, bool local) {
+    if (!track) {
+      return;
+    }
+    try {
+      pending.push_back({identity, track, local,
+                         track->getStats(local ? kLocalTypes : kRemoteTypes)});
+    } catch (const std::exception &e) {
+      std::cerr << "StatsSampler: getStats failed: " << e.what() << std::endl;
+    }
+  };
+  if (options_.local_tracks) {
+    if (LocalParticipant *lp = room_.localParticipant()) {
+      for (const auto &pair : *lp->trackPublicationsSnapshot()) {
+        request(lp->identity(), pair.second->track(), true);
+      }
+    }
+  }
+  if (options_.remote_tracks) {
+    for (const auto &rp : room_.remoteParticipants()) {
+      for (const auto &pair : *rp->trackPublicationsSnapshot()) {
+        request(rp->identity(), pair.second->track(), false);
+      }
+    }
+  }
+
+  std::vector<TrackStatsSummary> summaries;
+  summaries.reserve(pending.size());
+  std::unordered_map<std::string, detail::TrackStatsAccumulator> seen;
+  for (auto &p : pending) {
+    std::vector<RtcStats> stats;
+    try {
+      stats = p.stats.get();
+    } catch (const std::exception &e) {
+      std::cerr << "StatsSampler: getStats failed: " << e.what() << std::endl;
+      continue;
+    }
+    auto node = tracks_.extract(p.track->sid());
+    detail::TrackStatsAccumulator acc =
+        node.empty() ? detail::TrackStatsAccumulator{} : node.mapped();
+    TrackStatsSummary summary = acc.update(stats, p.local);
+    summary.participant_identity = std::move(p.identity);
+    summary.track_sid = p.track->sid();
+    summary.kind = p.track->kind();
+    summaries.push_back(std::move(summary));
+    seen.emplace(p.track->sid(), acc);
+  }
+  // Tracks not seen this round are gone (or failed); drop their history.
+  tracks_ = std::move(seen);
+  return summaries;
+}
+
+void StatsSampler::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!cv_.wait_for(lock, options_.interval, [this] { return stop_; })) {
+    lock.unlock();
+    auto summaries = sampleOnce();
+    if (callback_) {
+      try {
+        callback_(summaries);
+      } catch (const std::exception &e) {
+        std::cerr << "StatsSampler: callback threw: " << e.what()
+                  << std::endl;
+      }
+    }
+    lock.lock();
+  }
+}
+
+} // namespace livekit
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stream_budget.h"
+
+#include "random_id.h"
+#include "sdk_metrics.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace livekit {
+namespace detail {
+
+StreamBudget::StreamBudget(StreamBufferOptions options)
+    : options_(std::move(options)) {}
+
+namespace {
+
+// Mirror of every budget's buffered_bytes, for resourceSnapshot().
+void reportBuffered(std::int64_t delta) {
+  SdkMetrics::instance().resources.stream_reader_bytes.fetch_add(
+      delta, std::memory_order_relaxed);
+}
+
+} // namespace
+
+StreamBudget::~StreamBudget() {
+  reportBuffered(-static_cast<std::int64_t>(stats_.buffered_bytes));
+}
+
+bool StreamBudget::fitsLocked(std::size_t n, std::size_t reader_bytes) const {
+  const bool reader_ok = options_.max_reader_bytes == 0 || reader_bytes == 0 ||
+                         reader_bytes + n <= options_.max_reader_bytes;
+  const bool room_ok = options_.max_room_bytes == 0 ||
+                       stats_.buffered_bytes == 0 ||
+                       stats_.buffered_bytes + n <= options_.max_room_bytes;
+  return reader_ok && room_ok;
+}
+
+StreamBudget::Admission
+StreamBudget::admit(std::size_t n,
+                    const std::atomic<std::size_t> &reader_bytes) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  bool fits = fitsLocked(n, reader_bytes.load(std::memory_order_acquire));
+  if (!fits) {
+    switch (options_.policy) {
+    case StreamOverflowPolicy::kDropStream:
+      return Admission::kDrop;
+    case StreamOverflowPolicy::kSpillToFile:
+      return Admission::kSpill;
+    case StreamOverflowPolicy::kBlock:
+      ++stats_.blocked_chunks;
+      fits = cv_.wait_for(lock, options_.block_timeout, [&] {
+        return fitsLocked(n, reader_bytes.load(std::memory_order_acquire));
+      });
+      if (!fits) {
+        return Admission::kDrop;
+      }
+      break;
+    }
+  }
+  stats_.buffered_bytes += n;
+  reportBuffered(static_cast<std::int64_t>(n));
+  stats_.peak_buffered_bytes =
+      std::max(stats_.peak_buffered_bytes, stats_.buffered_bytes);
+  return Admission::kAdmit;
+}
+
+void StreamBudget::release(std::size_t n) {
+  if (n == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    n = std::min(n, stats_.buffered_bytes);
+    stats_.buffered_bytes -= n;
+    reportBuffered(-static_cast<std::int64_t>(n));
+  }
+  cv_.notify_all();
+}
+
+void StreamBudget::noteDropped() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.dropped_streams;
+}
+
+void StreamBudget::noteSpilled() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.spilled_streams;
+}
+
+StreamBufferStats StreamBudget::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+SpillFile::SpillFile(const std::string &directory) {
+  if (directory.empty()) {
+    file_ = std::tmpfile();
+  } else {
+    path_ = directory + "/livekit-spill-" + generateRandomId(8);
+    file_ = std::fopen(path_.c_str(), "w+b");
+#ifndef _WIN32
+    // The open handle keeps the data; nothing is left behind on a crash.
+    if (file_) {
+      std::remove(path_.c_str());
+      path_.clear();
+    }
+#endif
+  }
+  if (!file_) {
+    throw std::runtime_error("SpillFile: cannot create spill file in " +
+                             (directory.empty() ? "temp dir" : directory));
+  }
+}
+
+SpillFile::~SpillFile() {
+  std::fclose(file_);
+  if (!path_.empty()) {
+    std::remove(path_.c_str());
+  }
+}
+
+bool SpillFile::seek(std::uint64_t offset) {
+#ifdef _WIN32
+  return _fseeki64(file_, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+  return fseeko(file_, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+bool SpillFile::append(const void *data, std::size_t size) {
+  // C stdio requires a seek between reads and writes on the same stream.
+  if (!seek(written_) || std::fwrite(data, 1, size, file_) != size) {
+    return false;
+  }
+  written_ += size;
+  return true;
+}
+
+std::size_t SpillFile::read(void *dest, std::size_t size) {
+  size = static_cast<std::size_t>(
+      std::min<std::uint64_t>(size, written_ - read_));
+  if (size == 0 || !seek(read_)) {
+    return 0;
+  }
+  const std::size_t n = std::fread(dest, 1, size, file_);
+  read_ += n;
+  return n;
+}
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/data_stream.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+namespace livekit {
+namespace detail {
+
+// Memory budget shared by all stream readers of one Room.
+//
+// Readers charge bytes before buffering a chunk in memory and release them
+// once the consumer has read them. Admission is decided against both the
+// reader's own limit and the room-wide limit; the configured policy decides
+// what happens when a chunk does not fit.
+class StreamBudget {
+public:
+  enum class Admission { kAdmit, kSpill, kDrop };
+
+  explicit StreamBudget(StreamBufferOptions options);
+  ~StreamBudget();
+
+  const StreamBufferOptions &options() const noexcept { return options_; }
+
+  // Charge `n` bytes for a reader that currently buffers `reader_bytes`.
+  // Called on the event thread, never with the reader's mutex held: under
+  // kBlock this waits for consumers to release() budget. A chunk is always
+  // admitted into an empty reader (or empty room), so a single chunk larger
+  // than a limit cannot wedge the stream.
+  Admission admit(std::size_t n, const std::atomic<std::size_t> &reader_bytes);
+
+  // Return bytes previously admitted.
+  void release(std::size_t n);
+
+  void noteDropped();
+  void noteSpilled();
+
+  StreamBufferStats stats() const;
+
+private:
+  bool fitsLocked(std::size_t n, std::size_t reader_bytes) const;
+
+  const StreamBufferOptions options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  StreamBufferStats stats_;
+};
+
+// Anonymous temporary file used by readers under kSpillToFile: appended at
+// the end, consumed sequentially from the front.
+class SpillFile {
+public:
+  // Throws std::runtime_error if the file cannot be created.
+  explicit SpillFile(const std::string &directory);
+  ~SpillFile();
+
+  SpillFile(const SpillFile &) = delete;
+  SpillFile &operator=(const SpillFile &) = delete;
+
+  // Returns false on I/O error.
+  bool append(const void *data, std::size_t size);
+
+  // Read up to `size` bytes from the read position; returns bytes read.
+  std::size_t read(void *dest, std::size_t size);
+
+  // Bytes appended but not yet read.
+  std::uint64_t pending() const noexcept { return written_ - read_; }
+
+private:
+  bool seek(std::uint64_t offset);
+
+  std::FILE *file_ = nullptr;
+  std::string path_; // Removed on close where it cannot be unlinked early.
+  std::uint64_t written_ = 0;
+  std::uint64_t read_ = 0;
+};
+
+} // namespace detail
+} // namespace livekit
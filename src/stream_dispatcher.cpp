@@ -0,0 +1,338 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stream_dispatcher.h"
+
+#include "log.h"
+#include "sdk_metrics.h"
+#include "stream_budget.h"
+#include "task_pool.h"
+
+#include <exception>
+#include <utility>
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+// Calls one drain task runs before yielding its worker.
+constexpr int kCallsPerTurn = 16;
+
+template <typename F> void guarded(const char *what, F &&f) noexcept {
+  try {
+    f();
+  } catch (const std::exception &e) {
+    LK_LOG_WARN("livekit::data_stream", "stream %s callback threw: %s", what,
+                e.what());
+  } catch (...) {
+    LK_LOG_WARN("livekit::data_stream",
+                "stream %s callback threw an unknown exception", what);
+  }
+}
+
+} // namespace
+
+struct StreamDispatcher::Shared {
+  std::mutex mutex;
+  std::condition_variable cv;
+  StreamExecutor executor; // Empty: run inline.
+  std::unique_ptr<TaskPool> pool;
+  // Calls into a copied executor still in progress; an executor is not
+  // released (nor its pool joined) while one is.
+  std::size_t posting = 0;
+};
+
+struct StreamDispatcher::Stream {
+  bool is_text = false;
+  TextStreamInfo text_info;
+  ByteStreamInfo byte_info;
+  std::string participant_identity;
+  TextStreamOpenHandler text_open;
+  ByteStreamOpenHandler byte_open;
+  std::shared_ptr<StreamBudget> budget;
+  // Bytes queued for on_chunk and charged to `budget`.
+  std::atomic<std::size_t> pending_bytes{0};
+
+  // Set by the open call; only touched on the strand.
+  TextStreamCallbacks text;
+  ByteStreamCallbacks bytes;
+
+  // Strand: calls not yet run, and whether a drain task is posted.
+  std::mutex mutex;
+  std::deque<std::function<void()>> calls;
+  bool scheduled = false;
+};
+
+StreamDispatcher::StreamDispatcher() : shared_(std::make_shared<Shared>()) {}
+
+StreamDispatcher::~StreamDispatcher() {
+  abortAll();
+  setExecutor(nullptr);
+}
+
+void StreamDispatcher::setExecutor(StreamExecutor executor) {
+  std::unique_ptr<TaskPool> old_pool;
+  {
+    std::unique_lock<std::mutex> lock(shared_->mutex);
+    shared_->executor = std::move(executor);
+    shared_->cv.wait(lock, [this] { return shared_->posting == 0; });
+    old_pool = std::move(shared_->pool);
+  }
+  // Runs whatever the old pool still had queued, then joins it. Drains that
+  // repost themselves go to the new executor.
+  old_pool.reset();
+}
+
+void StreamDispatcher::setWorkerThreads(std::size_t threads) {
+  if (threads == 0) {
+    setExecutor(nullptr);
+    return;
+  }
+  auto pool = std::make_unique<TaskPool>(threads);
+  TaskPool *raw = pool.get();
+  setExecutor(
+      [raw](std::function<void()> task) { raw->post(std::move(task)); });
+  std::lock_guard<std::mutex> lock(shared_->mutex);
+  shared_->pool = std::move(pool);
+}
+
+void StreamDispatcher::openText(const TextStreamInfo &info,
+                                const std::string &participant_identity,
+                                TextStreamOpenHandler handler,
+                                std::shared_ptr<StreamBudget> budget) {
+  auto stream = std::make_shared<Stream>();
+  stream->is_text = true;
+  stream->text_info = info;
+  stream->participant_identity = participant_identity;
+  stream->text_open = std::move(handler);
+  stream->budget = std::move(budget);
+  open(std::move(stream));
+}
+
+void StreamDispatcher::openByte(const ByteStreamInfo &info,
+                                const std::string &participant_identity,
+                                ByteStreamOpenHandler handler,
+                                std::shared_ptr<StreamBudget> budget) {
+  auto stream = std::make_shared<Stream>();
+  stream->byte_info = info;
+  stream->participant_identity = participant_identity;
+  stream->byte_open = std::move(handler);
+  stream->budget = std::move(budget);
+  open(std::move(stream));
+}
+
+void StreamDispatcher::open(std::shared_ptr<Stream> stream) {
+  const std::string &id = stream->is_text ? stream->text_info.stream_id
+                                          : stream->byte_info.stream_id;
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    streams_[id] = stream;
+  }
+  Stream *s = stream.get();
+  enqueue(shared_, stream, [s] {
+    guarded("open", [s] {
+      if (s->is_text && s->text_open) {
+        s->text = s->text_open(s->text_info, s->participant_identity);
+      } else if (!s->is_text && s->byte_open) {
+        s->bytes = s->byte_open(s->byte_info, s->participant_identity);
+      }
+    });
+    // The handler is not needed again; drop what it captured.
+    s->text_open = nullptr;
+    s->byte_open = nullptr;
+  });
+}
+
+bool StreamDispatcher::chunk(const std::string &stream_id,
+                             const std::string &content) {
+  std::shared_ptr<Stream> stream;
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+      return false;
+    }
+    stream = it->second;
+  }
+  SdkMetrics::instance().data_stream_bytes_received.add(content.size());
+
+  const std::size_t size = content.size();
+  bool charged = false;
+  if (stream->budget) {
+    // May wait for callbacks to catch up under kBlock.
+    const auto admission =
+        stream->budget->admit(size, stream->pending_bytes);
+    if (admission == StreamBudget::Admission::kDrop) {
+      stream->budget->noteDropped();
+      if (auto taken = take(stream_id)) {
+        finish(taken, {}, /*dropped=*/true);
+      }
+      return true;
+    }
+    charged = admission == StreamBudget::Admission::kAdmit;
+  }
+  if (charged) {
+    stream->pending_bytes += size;
+  }
+  Stream *s = stream.get();
+  enqueue(shared_, stream, [s, data = content, charged] {
+    guarded("chunk", [s, &data] {
+      if (s->is_text && s->text.on_chunk) {
+        s->text.on_chunk(data);
+      } else if (!s->is_text && s->bytes.on_chunk) {
+        s->bytes.on_chunk(reinterpret_cast<const std::uint8_t *>(data.data()),
+                          data.size());
+      }
+    });
+    if (charged) {
+      s->pending_bytes -= data.size();
+      s->budget->release(data.size());
+    }
+  });
+  return true;
+}
+
+bool StreamDispatcher::close(
+    const std::string &stream_id,
+    const std::map<std::string, std::string> &trailer_attrs) {
+  std::shared_ptr<Stream> stream = take(stream_id);
+  if (!stream) {
+    return false;
+  }
+  finish(stream, trailer_attrs, /*dropped=*/false);
+  return true;
+}
+
+void StreamDispatcher::abortAll() {
+  std::unordered_map<std::string, std::shared_ptr<Stream>> streams;
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    streams.swap(streams_);
+  }
+  for (auto &kv : streams) {
+    finish(kv.second, {}, /*dropped=*/true);
+  }
+}
+
+std::size_t StreamDispatcher::openStreams() const {
+  std::lock_guard<std::mutex> lock(streams_mutex_);
+  return streams_.size();
+}
+
+std::shared_ptr<StreamDispatcher::Stream>
+StreamDispatcher::take(const std::string &stream_id) {
+  std::lock_guard<std::mutex> lock(streams_mutex_);
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end()) {
+    return nullptr;
+  }
+  std::shared_ptr<Stream> stream = std::move(it->second);
+  streams_.erase(it);
+  return stream;
+}
+
+void StreamDispatcher::finish(
+    const std::shared_ptr<Stream> &stream,
+    const std::map<std::string, std::string> &trailer_attrs, bool dropped) {
+  Stream *s = stream.get();
+  enqueue(shared_, stream, [s, trailer_attrs, dropped] {
+    auto &attributes =
+        s->is_text ? s->text_info.attributes : s->byte_info.attributes;
+    for (const auto &kv : trailer_attrs) {
+      attributes[kv.first] = kv.second;
+    }
+    guarded("close", [s, dropped] {
+      if (s->is_text && s->text.on_close) {
+        s->text.on_close(s->text_info, dropped);
+      } else if (!s->is_text && s->bytes.on_close) {
+        s->bytes.on_close(s->byte_info, dropped);
+      }
+    });
+    // Release what the callbacks captured once the stream is over.
+    s->text = {};
+    s->bytes = {};
+  });
+}
+
+void StreamDispatcher::enqueue(const std::shared_ptr<Shared> &shared,
+                               const std::shared_ptr<Stream> &stream,
+                               std::function<void()> call) {
+  bool schedule = false;
+  {
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->calls.push_back(std::move(call));
+    schedule = !stream->scheduled;
+    stream->scheduled = true;
+  }
+  if (schedule) {
+    post(shared, [shared, stream] { drain(shared, stream); });
+  }
+}
+
+void StreamDispatcher::drain(const std::shared_ptr<Shared> &shared,
+                             const std::shared_ptr<Stream> &stream) {
+  for (int i = 0; i < kCallsPerTurn; ++i) {
+    std::function<void()> call;
+    {
+      std::lock_guard<std::mutex> lock(stream->mutex);
+      if (stream->calls.empty()) {
+        stream->scheduled = false;
+        return;
+      }
+      call = std::move(stream->calls.front());
+      stream->calls.pop_front();
+    }
+    call();
+  }
+  // Still busy: yield the worker to other streams.
+  post(shared, [shared, stream] { drain(shared, stream); });
+}
+
+void StreamDispatcher::post(const std::shared_ptr<Shared> &shared,
+                            std::function<void()> task) {
+  StreamExecutor executor;
+  {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    executor = shared->executor;
+    if (executor) {
+      ++shared->posting;
+    }
+  }
+  if (!executor) {
+    task();
+    return;
+  }
+  bool posted = true;
+  try {
+    executor(task);
+  } catch (const std::exception &e) {
+    LK_LOG_WARN("livekit::data_stream",
+                "stream executor threw, running inline: %s", e.what());
+    posted = false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    --shared->posting;
+  }
+  shared->cv.notify_all();
+  if (!posted) {
+    task();
+  }
+}
+
+} // namespace detail
+} // namespace livekit
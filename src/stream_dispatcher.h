@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/data_stream.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace livekit {
+namespace detail {
+
+class StreamBudget;
+class TaskPool;
+
+// Delivers callback-driven incoming streams (Room::registerText/
+// ByteStreamCallbacks) on an executor.
+//
+// Every stream is a strand: its open, chunk and close calls are queued in
+// order and drained by at most one executor task at a time, so any number
+// of streams share the executor's threads without per-stream locking in
+// user code. A drain task runs a bounded number of calls before posting
+// itself again, so one busy stream cannot monopolize a worker. Without an
+// executor, calls run inline on the thread delivering room events.
+//
+// Chunks waiting for their callback are charged to the room's
+// StreamBudget like reader buffers. A stream whose chunk is refused is
+// closed as dropped; the budget has no spill file here, so under
+// kSpillToFile such a chunk is queued uncharged instead.
+//
+// The open/chunk/close/abortAll side is called from one thread at a time
+// (the room's event thread).
+class StreamDispatcher {
+public:
+  StreamDispatcher();
+  // Waits for calls already posted to the built-in pool, if any; calls
+  // posted to a user executor may still run later.
+  ~StreamDispatcher();
+
+  StreamDispatcher(const StreamDispatcher &) = delete;
+  StreamDispatcher &operator=(const StreamDispatcher &) = delete;
+
+  // Replace the executor (empty: inline). Not to be called from a stream
+  // callback.
+  void setExecutor(StreamExecutor executor);
+  // Use a built-in pool of `threads` workers; 0 goes back to inline.
+  void setWorkerThreads(std::size_t threads);
+
+  void openText(const TextStreamInfo &info,
+                const std::string &participant_identity,
+                TextStreamOpenHandler handler,
+                std::shared_ptr<StreamBudget> budget);
+  void openByte(const ByteStreamInfo &info,
+                const std::string &participant_identity,
+                ByteStreamOpenHandler handler,
+                std::shared_ptr<StreamBudget> budget);
+
+  // False if `stream_id` is not an open callback stream.
+  bool chunk(const std::string &stream_id, const std::string &content);
+  bool close(const std::string &stream_id,
+             const std::map<std::string, std::string> &trailer_attrs);
+
+  // Close every open stream as dropped (room disconnected).
+  void abortAll();
+
+  std::size_t openStreams() const;
+
+private:
+  struct Shared;
+  struct Stream;
+
+  void open(std::shared_ptr<Stream> stream);
+  // Queue `call` on the stream's strand, scheduling a drain if none is
+  // pending.
+  static void enqueue(const std::shared_ptr<Shared> &shared,
+                      const std::shared_ptr<Stream> &stream,
+                      std::function<void()> call);
+  static void drain(const std::shared_ptr<Shared> &shared,
+                    const std::shared_ptr<Stream> &stream);
+  static void post(const std::shared_ptr<Shared> &shared,
+                   std::function<void()> task);
+  // Remove `stream_id` from streams_; null if it is not open.
+  std::shared_ptr<Stream> take(const std::string &stream_id);
+  // Queue the close call of a stream already taken out of streams_.
+  void finish(const std::shared_ptr<Stream> &stream,
+              const std::map<std::string, std::string> &trailer_attrs,
+              bool dropped);
+
+  // Executor state, shared with drain tasks that may outlive us.
+  std::shared_ptr<Shared> shared_;
+
+  mutable std::mutex streams_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Stream>> streams_;
+};
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+// Fixed-size pool of worker threads running posted tasks in FIFO order.
+//
+// Destruction runs every task still queued, then joins the workers. A task
+// posted once destruction has begun (e.g. by a running task) runs inline on
+// the posting thread, so nothing is silently dropped. The pool must not be
+// destroyed from one of its own tasks.
+class TaskPool {
+public:
+  using Task = std::function<void()>;
+
+  // `threads` is clamped to at least 1.
+  explicit TaskPool(std::size_t threads);
+  ~TaskPool();
+
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  void post(Task task);
+
+  std::size_t threadCount() const noexcept { return workers_.size(); }
+
+private:
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Task> tasks_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "adaptive_stream.h"
+#include "ffi.pb.h"
+#include "track_proto_converter.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace livekit {
+namespace test {
+
+using detail::RenderSizeReport;
+using detail::renderSizeReport;
+using detail::videoQualityDimensions;
+
+using Dimensions = std::pair<std::uint32_t, std::uint32_t>;
+
+TEST(AdaptiveStreamTest, QualityMapsToAFractionOfThePublishedSize) {
+  EXPECT_EQ(videoQualityDimensions(VideoQuality::QUALITY_LOW, 1920, 1080),
+            Dimensions(480, 270));
+  EXPECT_EQ(videoQualityDimensions(VideoQuality::QUALITY_MEDIUM, 1920, 1080),
+            Dimensions(960, 540));
+  EXPECT_EQ(videoQualityDimensions(VideoQuality::QUALITY_HIGH, 1920, 1080),
+            Dimensions(1920, 1080));
+}
+
+TEST(AdaptiveStreamTest, QualityAssumes720pWithoutPublishedSize) {
+  EXPECT_EQ(videoQualityDimensions(VideoQuality::QUALITY_LOW, 0, 0),
+            Dimensions(320, 180));
+  EXPECT_EQ(videoQualityDimensions(VideoQuality::QUALITY_MEDIUM, 0, 0),
+            Dimensions(640, 360));
+  EXPECT_EQ(videoQualityDimensions(VideoQuality::QUALITY_HIGH, 0, 0),
+            Dimensions(1280, 720));
+}
+
+TEST(AdaptiveStreamTest, EnableRequestTargetsThePublication) {
+  const proto::FfiRequest pause =
+      enableRemoteTrackPublicationRequest(42, false);
+  ASSERT_TRUE(pause.has_enable_remote_track_publication());
+  const auto &msg = pause.enable_remote_track_publication();
+  EXPECT_EQ(msg.track_publication_handle(), 42u);
+  EXPECT_FALSE(msg.enabled());
+
+  const proto::FfiRequest resume =
+      enableRemoteTrackPublicationRequest(42, true);
+  EXPECT_TRUE(resume.enable_remote_track_publication().enabled());
+}
+
+TEST(AdaptiveStreamTest, DimensionRequestCarriesTheSize) {
+  const proto::FfiRequest req =
+      remoteTrackPublicationDimensionRequest(7, 640, 360);
+  ASSERT_TRUE(req.has_update_remote_track_publication_dimension());
+  const auto &msg = req.update_remote_track_publication_dimension();
+  EXPECT_EQ(msg.track_publication_handle(), 7u);
+  EXPECT_EQ(msg.width(), 640u);
+  EXPECT_EQ(msg.height(), 360u);
+}
+
+TEST(AdaptiveStreamTest, FirstRenderSizeIsAlwaysReported) {
+  EXPECT_EQ(renderSizeReport(-1, -1, 640, 360), RenderSizeReport::kResize);
+  EXPECT_EQ(renderSizeReport(-1, -1, 0, 0), RenderSizeReport::kPause);
+}
+
+TEST(AdaptiveStreamTest, SmallResizesAreNotReported) {
+  // Within 1/8 of the reported edges.
+  EXPECT_EQ(renderSizeReport(640, 360, 700, 400), RenderSizeReport::kNone);
+  EXPECT_EQ(renderSizeReport(640, 360, 560, 315), RenderSizeReport::kNone);
+  // Either edge beyond it.
+  EXPECT_EQ(renderSizeReport(640, 360, 800, 360), RenderSizeReport::kResize);
+  EXPECT_EQ(renderSizeReport(640, 360, 640, 200), RenderSizeReport::kResize);
+}
+
+TEST(AdaptiveStreamTest, VisibilityChangesPauseAndResume) {
+  EXPECT_EQ(renderSizeReport(640, 360, 0, 0), RenderSizeReport::kPause);
+  EXPECT_EQ(renderSizeReport(640, 360, 640, 0), RenderSizeReport::kPause);
+  EXPECT_EQ(renderSizeReport(0, 0, 0, 0), RenderSizeReport::kNone);
+  EXPECT_EQ(renderSizeReport(0, 0, 640, 360), RenderSizeReport::kResize);
+}
+
+} // namespace test
+} // namespace livekit
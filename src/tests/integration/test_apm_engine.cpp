@@ -0,0 +1,170 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/apm_engine.h>
+#include <livekit/audio_frame.h>
+#include <livekit/livekit.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+class ApmEngineTest : public ::testing::Test {
+protected:
+  void SetUp() override { livekit::initialize(livekit::LogSink::kConsole); }
+
+  void TearDown() override { livekit::shutdown(); }
+
+  static AudioFrame frame10ms(int sample_rate = 48000, int num_channels = 1) {
+    AudioFrame frame =
+        AudioFrame::create(sample_rate, num_channels, sample_rate / 100);
+    for (std::size_t i = 0; i < frame.data().size(); ++i) {
+      frame.data()[i] = static_cast<std::int16_t>((i * 37) % 2000 - 1000);
+    }
+    return frame;
+  }
+
+  template <typename Pred> static bool waitFor(Pred pred) {
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!pred()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+};
+
+TEST_F(ApmEngineTest, ProcessesFramesFromManyStreams) {
+  ApmEngine::Options options;
+  options.threads = 2;
+  options.max_batch_frames = 4;
+  ApmEngine engine(options);
+  EXPECT_EQ(engine.threadCount(), 2u);
+
+  constexpr int kStreams = 8;
+  constexpr int kFrames = 20;
+  std::vector<std::atomic<int>> delivered(kStreams);
+  std::vector<std::unique_ptr<ApmStream>> streams;
+  for (int i = 0; i < kStreams; ++i) {
+    ApmEngine::StreamOptions stream_options;
+    stream_options.apm.noise_suppression = true;
+    stream_options.apm.echo_cancellation = true;
+    stream_options.on_processed = [&delivered, i](AudioFrame &frame) {
+      EXPECT_EQ(frame.samples_per_channel(), 480);
+      delivered[i].fetch_add(1);
+    };
+    streams.push_back(engine.addStream(std::move(stream_options)));
+  }
+  EXPECT_EQ(engine.streamCount(), static_cast<std::size_t>(kStreams));
+
+  for (int f = 0; f < kFrames; ++f) {
+    for (auto &stream : streams) {
+      stream->pushRender(frame10ms());
+      // A full queue only drops; retry until the workers catch up.
+      while (!stream->pushCapture(frame10ms())) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  for (int i = 0; i < kStreams; ++i) {
+    ASSERT_TRUE(waitFor([&] { return delivered[i].load() == kFrames; }))
+        << "stream " << i << " delivered " << delivered[i].load();
+    const ApmStreamStats stats = streams[i]->stats();
+    EXPECT_EQ(stats.processed_frames, static_cast<std::uint64_t>(kFrames));
+    EXPECT_EQ(stats.errors, 0u);
+    EXPECT_LE(stats.mean_latency, stats.max_latency);
+  }
+
+  streams.clear();
+  EXPECT_EQ(engine.streamCount(), 0u);
+}
+
+TEST_F(ApmEngineTest, RejectsFramesThatAreNot10ms) {
+  ApmEngine engine;
+  auto stream = engine.addStream({});
+  AudioFrame twenty_ms = AudioFrame::create(48000, 1, 960);
+  EXPECT_THROW(stream->pushCapture(std::move(twenty_ms)),
+               std::invalid_argument);
+  EXPECT_THROW(stream->pushRender(AudioFrame{}), std::invalid_argument);
+}
+
+TEST_F(ApmEngineTest, DropsFramesWhenTheQueueIsFull) {
+  ApmEngine::Options options;
+  options.threads = 1;
+  options.max_queued_frames = 2;
+  options.max_batch_frames = 1;
+  ApmEngine engine(options);
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool entered = false;
+  bool release = false;
+  ApmEngine::StreamOptions stream_options;
+  stream_options.on_processed = [&](AudioFrame &) {
+    std::unique_lock<std::mutex> lock(mutex);
+    entered = true;
+    cv.notify_all();
+    cv.wait(lock, [&] { return release; });
+  };
+  auto stream = engine.addStream(std::move(stream_options));
+
+  // The worker holds the first frame in the callback...
+  ASSERT_TRUE(stream->pushCapture(frame10ms()));
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+                            [&] { return entered; }));
+  }
+  // ...so two more fill the queue and the next one is rejected.
+  EXPECT_TRUE(stream->pushCapture(frame10ms()));
+  EXPECT_TRUE(stream->pushCapture(frame10ms()));
+  EXPECT_FALSE(stream->pushCapture(frame10ms()));
+  EXPECT_EQ(stream->stats().dropped_frames, 1u);
+  EXPECT_EQ(stream->stats().queued_frames, 2u);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  cv.notify_all();
+  ASSERT_TRUE(waitFor([&] { return stream->stats().processed_frames == 3; }));
+}
+
+TEST_F(ApmEngineTest, StreamsOutlivingTheEngineRejectFrames) {
+  std::unique_ptr<ApmStream> stream;
+  {
+    ApmEngine engine;
+    stream = engine.addStream({});
+  }
+  EXPECT_FALSE(stream->pushCapture(frame10ms()));
+  EXPECT_EQ(stream->stats().dropped_frames, 1u);
+}
+
+} // namespace test
+} // namespace livekit
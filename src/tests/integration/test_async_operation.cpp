@@ -0,0 +1,53 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/async_operation.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace livekit {
+namespace test {
+
+TEST(AsyncOperationTest, CompletedOperationRunsCallbackInline) {
+  std::promise<std::string> promise;
+  promise.set_value("pong");
+  // No request is pending under id 0, so the callback must run right away.
+  AsyncOperation<std::string> op(promise.get_future(), 0);
+  EXPECT_TRUE(op.ready());
+
+  std::string result;
+  op.onComplete([&] { result = op.get(); });
+  EXPECT_EQ(result, "pong");
+  EXPECT_FALSE(op.valid());
+}
+
+TEST(AsyncOperationTest, GetRethrowsError) {
+  std::promise<void> promise;
+  promise.set_exception(
+      std::make_exception_ptr(std::runtime_error("rpc failed")));
+  AsyncOperation<void> op(promise.get_future(), 0);
+  EXPECT_THROW(op.get(), std::runtime_error);
+}
+
+TEST(AsyncOperationTest, DefaultConstructedIsInvalid) {
+  AsyncOperation<int> op;
+  EXPECT_FALSE(op.valid());
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "livekit/attribute_map.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace livekit {
+namespace {
+
+TEST(AttributeMapTest, KeepsEntriesSortedByKey) {
+  AttributeMap attrs;
+  EXPECT_TRUE(attrs.set("zeta", "1"));
+  EXPECT_TRUE(attrs.set("alpha", "2"));
+  EXPECT_TRUE(attrs.set("mid", "3"));
+
+  std::vector<std::string> keys;
+  for (const auto &kv : attrs) {
+    keys.push_back(kv.first);
+  }
+  EXPECT_EQ(keys, (std::vector<std::string>{"alpha", "mid", "zeta"}));
+  EXPECT_EQ(attrs.at("mid"), "3");
+  EXPECT_THROW(attrs.at("missing"), std::out_of_range);
+}
+
+TEST(AttributeMapTest, SetReportsWhetherValueChanged) {
+  AttributeMap attrs{{"state", "idle"}};
+  EXPECT_FALSE(attrs.set("state", "idle"));
+  EXPECT_TRUE(attrs.set("state", "speaking"));
+  EXPECT_EQ(attrs.size(), 1u);
+  EXPECT_EQ(attrs.at("state"), "speaking");
+}
+
+TEST(AttributeMapTest, EraseRemovesOnlyPresentKeys) {
+  AttributeMap attrs{{"a", "1"}, {"b", "2"}};
+  EXPECT_TRUE(attrs.erase("a"));
+  EXPECT_FALSE(attrs.erase("a"));
+  EXPECT_FALSE(attrs.contains("a"));
+  EXPECT_EQ(attrs.count("b"), 1u);
+}
+
+TEST(AttributeMapTest, ConvertsToAndFromUnorderedMap) {
+  std::unordered_map<std::string, std::string> src{
+      {"x", "1"}, {"b", "2"}, {"m", "3"}};
+  AttributeMap attrs = src;
+  EXPECT_EQ(attrs.size(), 3u);
+  EXPECT_EQ(attrs.begin()->first, "b");
+  EXPECT_EQ(attrs.toUnorderedMap(), src);
+}
+
+TEST(AttributeMapTest, BindsToConstUnorderedMapReference) {
+  const AttributeMap attrs{{"k", "v"}};
+  // What callers of the old Participant::attributes() signature wrote.
+  const std::unordered_map<std::string, std::string> &legacy = attrs;
+  EXPECT_EQ(legacy.size(), 1u);
+  EXPECT_EQ(legacy.at("k"), "v");
+}
+
+TEST(AttributeMapTest, UnsortedEntriesKeepFirstDuplicate) {
+  AttributeMap attrs(AttributeMap::container_type{
+      {"k", "first"}, {"a", "1"}, {"k", "second"}});
+  EXPECT_EQ(attrs.size(), 2u);
+  EXPECT_EQ(attrs.at("k"), "first");
+  EXPECT_EQ(attrs, (AttributeMap{{"a", "1"}, {"k", "first"}}));
+}
+
+} // namespace
+} // namespace livekit
@@ -18,6 +18,10 @@
 #include <livekit/audio_frame.h>
 #include <livekit/livekit.h>
 
+#include <cmath>
+#include <iterator>
+#include <limits>
+
 namespace livekit {
 namespace test {
 
@@ -164,5 +168,104 @@ TEST_F(AudioFrameTest, InvalidDataSizeThrows) {
   EXPECT_THROW(AudioFrame(data, 48000, 2, 960), std::invalid_argument);
 }
 
+namespace {
+
+// 37 frames so both the vector loops and the scalar tails run.
+AudioFrame makeRamp(int num_channels) {
+  const int frames = 37;
+  std::vector<std::int16_t> data(static_cast<std::size_t>(frames) *
+                                 num_channels);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::int16_t>(static_cast<int>(i) * 1777 - 32768);
+  }
+  data[1] = INT16_MAX;
+  return AudioFrame(std::move(data), 48000, num_channels, frames);
+}
+
+} // namespace
+
+TEST_F(AudioFrameTest, FloatInterleavedRoundTrip) {
+  const AudioFrame frame = makeRamp(2);
+  const FloatAudioFrame f = FloatAudioFrame::fromFrame(frame);
+
+  EXPECT_EQ(f.layout(), AudioSampleLayout::kInterleaved);
+  EXPECT_EQ(f.num_channels(), 2);
+  EXPECT_EQ(f.samples_per_channel(), 37);
+  ASSERT_EQ(f.total_samples(), frame.total_samples());
+  for (std::size_t i = 0; i < f.total_samples(); ++i) {
+    EXPECT_FLOAT_EQ(f.data()[i], frame.data()[i] / 32768.0f) << i;
+  }
+  EXPECT_EQ(f.data()[0], -1.0f);
+  EXPECT_EQ(f.toFrame().data(), frame.data());
+}
+
+TEST_F(AudioFrameTest, FloatPlanarRoundTrip) {
+  for (int channels : {1, 2, 3}) {
+    const AudioFrame frame = makeRamp(channels);
+    const FloatAudioFrame f =
+        FloatAudioFrame::fromFrame(frame, AudioSampleLayout::kPlanar);
+    ASSERT_EQ(f.layout(), AudioSampleLayout::kPlanar);
+    for (int c = 0; c < channels; ++c) {
+      const float *plane = f.channel(c);
+      for (int s = 0; s < f.samples_per_channel(); ++s) {
+        EXPECT_FLOAT_EQ(plane[s],
+                        frame.data()[s * channels + c] / 32768.0f)
+            << channels << " channels, c=" << c << " s=" << s;
+      }
+    }
+    EXPECT_EQ(f.toFrame().data(), frame.data()) << channels << " channels";
+
+    AudioFramePool pool;
+    EXPECT_EQ(f.toFrame(pool).data(), frame.data()) << channels;
+  }
+}
+
+TEST_F(AudioFrameTest, FloatToInt16RoundsAndSaturates) {
+  const float inputs[] = {2.0f,
+                          -2.0f,
+                          1.0f,
+                          -1.0f,
+                          0.5f / 32768.0f,
+                          1.5f / 32768.0f,
+                          -1.5f / 32768.0f,
+                          std::numeric_limits<float>::quiet_NaN()};
+  const std::int16_t expected[] = {INT16_MAX, INT16_MIN, INT16_MAX, INT16_MIN,
+                                   0,         2,         -2,        INT16_MIN};
+  // Repeat the inputs so every SIMD path sees them as well as the tail.
+  std::vector<float> data;
+  for (int r = 0; r < 5; ++r) {
+    data.insert(data.end(), std::begin(inputs), std::end(inputs));
+  }
+  const int n = static_cast<int>(data.size());
+  const AudioFrame out = FloatAudioFrame(data, 16000, 1, n).toFrame();
+  ASSERT_EQ(out.total_samples(), data.size());
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    EXPECT_EQ(out.data()[i], expected[i % 8]) << i;
+  }
+
+  // Planar stereo takes a separate interleaving kernel.
+  const AudioFrame stereo =
+      FloatAudioFrame(data, 16000, 2, n / 2, AudioSampleLayout::kPlanar)
+          .toFrame();
+  for (int s = 0; s < n / 2; ++s) {
+    EXPECT_EQ(stereo.data()[2 * s], expected[s % 8]) << s;
+    EXPECT_EQ(stereo.data()[2 * s + 1], expected[(n / 2 + s) % 8]) << s;
+  }
+}
+
+TEST_F(AudioFrameTest, FloatFrameValidation) {
+  EXPECT_THROW(FloatAudioFrame(std::vector<float>(10), 48000, 2, 4),
+               std::invalid_argument);
+
+  FloatAudioFrame interleaved = FloatAudioFrame::create(48000, 2, 4);
+  EXPECT_THROW(interleaved.channel(0), std::invalid_argument);
+
+  FloatAudioFrame planar =
+      FloatAudioFrame::create(48000, 2, 4, AudioSampleLayout::kPlanar);
+  EXPECT_EQ(planar.channel(1), planar.data().data() + 4);
+  EXPECT_THROW(planar.channel(2), std::invalid_argument);
+  EXPECT_DOUBLE_EQ(planar.duration(), 4.0 / 48000.0);
+}
+
 } // namespace test
 } // namespace livekit
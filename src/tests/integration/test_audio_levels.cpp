@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "audio_levels.h"
+#include "audio_simd.h"
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+std::vector<std::int16_t> sine(int samples, double amplitude) {
+  std::vector<std::int16_t> out(static_cast<std::size_t>(samples));
+  for (int i = 0; i < samples; ++i) {
+    out[static_cast<std::size_t>(i)] = static_cast<std::int16_t>(
+        amplitude * 32767.0 * std::sin(2.0 * M_PI * 440.0 * i / 48000.0));
+  }
+  return out;
+}
+
+} // namespace
+
+TEST(AudioLevelsTest, SumSquaresMatchesScalar) {
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> dist(INT16_MIN, INT16_MAX);
+  // Odd length: vector body plus scalar tail, with full-scale extremes.
+  std::vector<std::int16_t> samples(1021);
+  for (auto &s : samples) {
+    s = static_cast<std::int16_t>(dist(rng));
+  }
+  samples[3] = INT16_MIN;
+  samples[4] = INT16_MIN;
+
+  std::uint64_t expected = 0;
+  for (const auto s : samples) {
+    expected += static_cast<std::uint64_t>(static_cast<std::int64_t>(s) * s);
+  }
+  std::uint64_t sum = 0;
+  int peak = 0;
+  detail::sumSquaresPeakInt16(samples.data(), samples.size(), sum, peak);
+  EXPECT_EQ(sum, expected);
+  EXPECT_EQ(peak, INT16_MAX);
+}
+
+TEST(AudioLevelsTest, MeasuresSineRmsAndPeak) {
+  const auto tone = sine(480, 0.5);
+  const AudioLevels levels = detail::measureLevels(tone.data(), tone.size());
+  EXPECT_NEAR(levels.rms, 0.5 / std::sqrt(2.0), 0.01);
+  EXPECT_NEAR(levels.peak, 0.5, 0.01);
+  EXPECT_FALSE(levels.voice);
+
+  const AudioLevels empty = detail::measureLevels(nullptr, 0);
+  EXPECT_EQ(empty.rms, 0.0f);
+  EXPECT_EQ(empty.peak, 0.0f);
+}
+
+TEST(AudioLevelsTest, VoiceDetectorHoldsThenReleases) {
+  detail::VoiceDetector vad(9.0f, 100);
+  const float quiet = 0.0005f; // about -66 dBFS
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_FALSE(vad.update(quiet, 10.0));
+  }
+  EXPECT_TRUE(vad.update(0.1f, 10.0)); // -20 dBFS speech
+  // Held for the 100 ms hangover, then released.
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_TRUE(vad.update(quiet, 10.0)) << i;
+  }
+  EXPECT_FALSE(vad.update(quiet, 10.0));
+}
+
+TEST(AudioLevelsTest, VoiceDetectorLearnsSteadyNoise) {
+  detail::VoiceDetector vad(9.0f, 0);
+  const float fan = 0.01f; // -40 dBFS, above the initial floor
+  EXPECT_TRUE(vad.update(fan, 10.0));
+  // The floor rises at 3 dB/s; after ~10 s the fan is background.
+  bool voice = true;
+  for (int i = 0; i < 1000; ++i) {
+    voice = vad.update(fan, 10.0);
+  }
+  EXPECT_FALSE(voice);
+  EXPECT_TRUE(vad.update(0.2f, 10.0)); // speech over the fan
+}
+
+} // namespace test
+} // namespace livekit
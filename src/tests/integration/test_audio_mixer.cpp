@@ -0,0 +1,137 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/audio_mixer.h>
+
+#include <vector>
+
+#include "audio_simd.h"
+
+namespace livekit {
+namespace test {
+
+TEST(AudioSimdTest, AddSaturatesBothWays) {
+  // 37 samples: exercises the vector body and the scalar tail.
+  std::vector<std::int16_t> dst(37, 30000);
+  std::vector<std::int16_t> src(37, 10000);
+  dst[36] = -30000;
+  src[36] = -10000;
+  dst[5] = 100;
+  src[5] = -50;
+
+  detail::addSaturateInt16(dst.data(), src.data(), dst.size());
+
+  EXPECT_EQ(dst[0], INT16_MAX);
+  EXPECT_EQ(dst[5], 50);
+  EXPECT_EQ(dst[35], INT16_MAX);
+  EXPECT_EQ(dst[36], INT16_MIN);
+}
+
+TEST(AudioMixerTest, SumsInputs) {
+  AudioMixer mixer;
+  const auto a = mixer.addInput();
+  const auto b = mixer.addInput();
+  const int spc = mixer.samplesPerChannel();
+  ASSERT_EQ(spc, 480);
+
+  mixer.pushFrame(a, AudioFrame(std::vector<std::int16_t>(spc, 100), 48000,
+                                1, spc));
+  mixer.pushFrame(b, AudioFrame(std::vector<std::int16_t>(spc, 23), 48000, 1,
+                                spc));
+
+  AudioFrame out = mixer.mix();
+  ASSERT_EQ(out.samples_per_channel(), spc);
+  EXPECT_EQ(out.data().front(), 123);
+  EXPECT_EQ(out.data().back(), 123);
+}
+
+TEST(AudioMixerTest, MissingSamplesAreSilent) {
+  AudioMixer mixer;
+  const auto a = mixer.addInput();
+  mixer.addInput(); // never fed
+  const int spc = mixer.samplesPerChannel();
+
+  // Half a tick from `a`; the rest of the output must be silence.
+  mixer.pushFrame(a, AudioFrame(std::vector<std::int16_t>(spc / 2, 7), 48000,
+                                1, spc / 2));
+  AudioFrame out = mixer.mix();
+  EXPECT_EQ(out.data()[0], 7);
+  EXPECT_EQ(out.data()[spc / 2 - 1], 7);
+  EXPECT_EQ(out.data()[spc / 2], 0);
+
+  AudioFrame silent = mixer.mix();
+  EXPECT_EQ(silent.data()[0], 0);
+}
+
+TEST(AudioMixerTest, SmallFramesAlignOnTicks) {
+  AudioMixer mixer;
+  const auto a = mixer.addInput();
+  const int spc = mixer.samplesPerChannel();
+
+  // Three 5 ms frames should yield one full tick plus a half tick.
+  for (int i = 1; i <= 3; ++i) {
+    mixer.pushFrame(a, AudioFrame(std::vector<std::int16_t>(spc / 2, i), 48000,
+                                  1, spc / 2));
+  }
+  AudioFrame first = mixer.mix();
+  EXPECT_EQ(first.data()[0], 1);
+  EXPECT_EQ(first.data()[spc - 1], 2);
+
+  AudioFrame second = mixer.mix();
+  EXPECT_EQ(second.data()[0], 3);
+  EXPECT_EQ(second.data()[spc - 1], 0);
+}
+
+TEST(AudioMixerTest, MismatchedFormatIsDropped) {
+  AudioMixer mixer;
+  const auto a = mixer.addInput();
+  mixer.pushFrame(a, AudioFrame(std::vector<std::int16_t>(160, 9), 16000, 1,
+                                160));
+  EXPECT_EQ(mixer.droppedFrames(), 1u);
+  EXPECT_EQ(mixer.mix().data()[0], 0);
+}
+
+TEST(AudioMixerTest, BufferedSamplesAreBounded) {
+  AudioMixer::Options opts;
+  opts.sample_rate = 1000;
+  opts.frame_duration_ms = 10; // 10 samples per tick
+  opts.max_buffered_ms = 20;   // keep at most 20 samples
+  AudioMixer mixer(opts);
+  const auto a = mixer.addInput();
+
+  for (int i = 1; i <= 4; ++i) {
+    mixer.pushFrame(a, AudioFrame(std::vector<std::int16_t>(10, i), 1000, 1,
+                                  10));
+  }
+  // Oldest two frames were dropped.
+  EXPECT_EQ(mixer.mix().data()[0], 3);
+  EXPECT_EQ(mixer.mix().data()[0], 4);
+}
+
+TEST(AudioMixerTest, RemovedInputStopsContributing) {
+  AudioMixer mixer;
+  const auto a = mixer.addInput();
+  const int spc = mixer.samplesPerChannel();
+  mixer.pushFrame(a, AudioFrame(std::vector<std::int16_t>(spc, 5), 48000, 1,
+                                spc));
+  mixer.removeInput(a);
+  EXPECT_EQ(mixer.inputCount(), 0u);
+  EXPECT_EQ(mixer.mix().data()[0], 0);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/audio_pipeline.h>
+#include <livekit/audio_source.h>
+#include <livekit/livekit.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+class AudioPipelineTest : public ::testing::Test {
+protected:
+  void SetUp() override { livekit::initialize(livekit::LogSink::kConsole); }
+
+  void TearDown() override { livekit::shutdown(); }
+};
+
+TEST_F(AudioPipelineTest, RejectsMismatchedSource) {
+  auto source = std::make_shared<AudioSource>(16000, 1);
+  EXPECT_THROW(AudioPipeline pipeline(source), std::invalid_argument);
+  EXPECT_THROW(AudioPipeline pipeline(nullptr), std::invalid_argument);
+}
+
+TEST_F(AudioPipelineTest, RenderPlayoutMixesManualInputs) {
+  auto source = std::make_shared<AudioSource>(48000, 1);
+  AudioPipeline pipeline(source);
+
+  auto id = pipeline.addPlayoutInput();
+  pipeline.pushPlayout(id, AudioFrame(std::vector<std::int16_t>(480, 100),
+                                      48000, 1, 480));
+  AudioFrame out = pipeline.renderPlayout();
+  EXPECT_EQ(out.samples_per_channel(), 480);
+  EXPECT_EQ(out.sample_rate(), 48000);
+
+  // Nothing queued: the next tick is still a full (silent) frame.
+  out = pipeline.renderPlayout();
+  EXPECT_EQ(out.samples_per_channel(), 480);
+}
+
+TEST_F(AudioPipelineTest, MeasuresStreamDelayFromTimestamps) {
+  using Clock = AudioPipeline::Clock;
+  auto source = std::make_shared<AudioSource>(48000, 1);
+  AudioPipeline pipeline(source);
+  EXPECT_LT(pipeline.streamDelayMs(), 0);
+
+  pipeline.renderPlayout(Clock::now() + std::chrono::milliseconds(30));
+  pipeline.captureFrame(AudioFrame::create(48000, 1, 480),
+                        Clock::now() - std::chrono::milliseconds(20));
+  EXPECT_NEAR(pipeline.streamDelayMs(), 50, 5);
+}
+
+TEST_F(AudioPipelineTest, CaptureCarriesPartialChunks) {
+  auto source = std::make_shared<AudioSource>(48000, 1);
+  AudioPipeline pipeline(source);
+  // 5ms does not complete a chunk, so nothing reaches the APM yet.
+  pipeline.captureFrame(AudioFrame::create(48000, 1, 240));
+  EXPECT_LT(pipeline.streamDelayMs(), 0);
+  pipeline.captureFrame(AudioFrame::create(48000, 1, 240));
+  EXPECT_GE(pipeline.streamDelayMs(), 0);
+}
+
+} // namespace test
+} // namespace livekit
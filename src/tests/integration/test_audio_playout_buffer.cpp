@@ -0,0 +1,269 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/audio_playout_buffer.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+// min == max pins the target delay so jitter estimation stays out of the way.
+AudioPlayoutBuffer::Options fixedDelay(int channels = 1, int delay_ms = 20) {
+  AudioPlayoutBuffer::Options o;
+  o.sample_rate = 48000;
+  o.num_channels = channels;
+  o.min_delay_ms = delay_ms;
+  o.max_delay_ms = delay_ms;
+  return o;
+}
+
+void pushConstant(AudioPlayoutBuffer &buffer, int frames, std::int16_t value,
+                  int channels = 1, int rate = 48000) {
+  std::vector<std::int16_t> samples(static_cast<std::size_t>(frames) *
+                                        channels,
+                                    value);
+  buffer.push(samples.data(), frames, rate, channels);
+}
+
+} // namespace
+
+TEST(AudioPlayoutBufferTest, WaitsForTargetDelayThenFadesIn) {
+  AudioPlayoutBuffer buffer(fixedDelay());
+  std::vector<std::int16_t> out(480, -1);
+
+  pushConstant(buffer, 480, 1000);
+  buffer.fill(out.data(), 480);
+  for (auto s : out) {
+    ASSERT_EQ(s, 0);
+  }
+  EXPECT_EQ(buffer.stats().frames_played, 0u);
+  EXPECT_EQ(buffer.stats().frames_concealed, 0u);
+
+  pushConstant(buffer, 480, 1000);
+  buffer.fill(out.data(), 480);
+  EXPECT_EQ(out.front(), 0);
+  EXPECT_LT(out[100], 1000);
+  EXPECT_EQ(out.back(), 1000);
+
+  const auto stats = buffer.stats();
+  EXPECT_EQ(stats.frames_played, 480u);
+  EXPECT_EQ(stats.buffered_frames, 480u);
+  EXPECT_EQ(stats.target_delay_ms, 20);
+  EXPECT_EQ(stats.underruns, 0u);
+}
+
+TEST(AudioPlayoutBufferTest, UnderrunRepeatsRecentAudioWithDecay) {
+  AudioPlayoutBuffer buffer(fixedDelay());
+  std::vector<std::int16_t> out(960);
+  pushConstant(buffer, 960, 1000);
+  buffer.fill(out.data(), 960);
+  ASSERT_EQ(buffer.stats().buffered_frames, 0u);
+
+  buffer.fill(out.data(), 480);
+  EXPECT_EQ(out.front(), 1000);
+  EXPECT_NEAR(out[479], 500, 5);
+  for (std::size_t i = 1; i < 480; ++i) {
+    ASSERT_LE(out[i], out[i - 1]);
+  }
+
+  // The repetition fades out into silence.
+  std::vector<std::int16_t> tail(4800, -1);
+  buffer.fill(tail.data(), 4800);
+  EXPECT_EQ(tail.back(), 0);
+
+  auto stats = buffer.stats();
+  EXPECT_EQ(stats.underruns, 1u);
+  EXPECT_EQ(stats.frames_concealed, 480u + 4800u);
+
+  // Playback waits for the target delay again before resuming.
+  pushConstant(buffer, 480, 1000);
+  buffer.fill(out.data(), 480);
+  EXPECT_EQ(out[479], 0);
+  pushConstant(buffer, 960, 1000);
+  buffer.fill(out.data(), 480);
+  EXPECT_EQ(out[479], 1000);
+  EXPECT_EQ(buffer.stats().underruns, 1u);
+}
+
+TEST(AudioPlayoutBufferTest, SpeedsUpWhenAboveTarget) {
+  AudioPlayoutBuffer buffer(fixedDelay());
+  std::vector<std::int16_t> out(480);
+  pushConstant(buffer, 1800, 1000);
+  buffer.fill(out.data(), 480);
+
+  const auto stats = buffer.stats();
+  EXPECT_EQ(stats.frames_played, 480u);
+  EXPECT_EQ(stats.frames_sped_up, 480u);
+  // 1% faster: 480 output frames consumed 484 input frames.
+  EXPECT_EQ(stats.buffered_frames, 1800u - 484u);
+}
+
+TEST(AudioPlayoutBufferTest, SlowsDownWhenBelowTarget) {
+  AudioPlayoutBuffer buffer(fixedDelay());
+  std::vector<std::int16_t> out(480);
+  pushConstant(buffer, 960, 1000);
+  buffer.fill(out.data(), 480);
+  ASSERT_EQ(buffer.stats().frames_slowed_down, 0u);
+
+  buffer.fill(out.data(), 480);
+  const auto stats = buffer.stats();
+  EXPECT_EQ(stats.frames_slowed_down, 480u);
+  EXPECT_EQ(stats.underruns, 0u);
+  EXPECT_EQ(stats.buffered_frames, 480u - 475u);
+  EXPECT_EQ(out.back(), 1000);
+}
+
+TEST(AudioPlayoutBufferTest, DropsAudioBeyondCapacity) {
+  auto options = fixedDelay();
+  options.capacity_ms = 100;
+  AudioPlayoutBuffer buffer(options);
+  pushConstant(buffer, 6000, 1);
+
+  const auto stats = buffer.stats();
+  EXPECT_EQ(stats.frames_pushed, 6000u);
+  EXPECT_EQ(stats.buffered_frames, 4800u);
+  EXPECT_EQ(stats.frames_dropped, 1200u);
+}
+
+TEST(AudioPlayoutBufferTest, RemixesChannelsAndResamples) {
+  AudioPlayoutBuffer stereo(fixedDelay(2));
+  pushConstant(stereo, 960, 700, 1);
+  std::vector<std::int16_t> out(2 * 480);
+  stereo.fill(out.data(), 480);
+  EXPECT_EQ(out[2 * 479], 700);
+  EXPECT_EQ(out[2 * 479 + 1], 700);
+
+  // No sensible mapping from 6 to 2 channels.
+  pushConstant(stereo, 480, 700, 6);
+  EXPECT_EQ(stereo.stats().frames_dropped, 480u);
+
+  AudioPlayoutBuffer resampled(fixedDelay());
+  for (int i = 0; i < 10; ++i) {
+    pushConstant(resampled, 441, 1000, 1, 44100);
+  }
+  const auto buffered = resampled.stats().buffered_frames;
+  EXPECT_GT(buffered, 4700u);
+  EXPECT_LE(buffered, 4800u);
+}
+
+TEST(AudioPlayoutBufferTest, RejectsInvalidOptions) {
+  auto options = fixedDelay();
+  options.min_delay_ms = 50;
+  options.max_delay_ms = 20;
+  EXPECT_THROW(AudioPlayoutBuffer{options}, std::invalid_argument);
+
+  options = fixedDelay();
+  options.capacity_ms = 20;
+  EXPECT_THROW(AudioPlayoutBuffer{options}, std::invalid_argument);
+
+  options = fixedDelay();
+  options.num_channels = 0;
+  EXPECT_THROW(AudioPlayoutBuffer{options}, std::invalid_argument);
+}
+
+TEST(AudioPlayoutBufferTest, ConcurrentProducerAndDevice) {
+  AudioPlayoutBuffer::Options options;
+  options.num_channels = 2;
+  AudioPlayoutBuffer buffer(options);
+
+  std::atomic<bool> done{false};
+  std::thread device([&] {
+    std::vector<std::int16_t> out(2 * 256);
+    while (!done.load()) {
+      buffer.fill(out.data(), 256);
+      std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+  });
+  for (int i = 0; i < 200; ++i) {
+    pushConstant(buffer, 480, 100, 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  done = true;
+  device.join();
+
+  const auto stats = buffer.stats();
+  EXPECT_EQ(stats.frames_pushed, 200u * 480u);
+  EXPECT_GT(stats.frames_played, 0u);
+  EXPECT_GE(stats.target_delay_ms, options.min_delay_ms);
+  EXPECT_LE(stats.target_delay_ms, options.max_delay_ms);
+}
+
+TEST(AudioCaptureAdapterTest, CutsDeviceBuffersIntoFrames) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<AudioFrame> frames;
+
+  AudioCaptureAdapter::Options options;
+  options.sample_rate = 48000;
+  options.num_channels = 1;
+  AudioCaptureAdapter adapter(
+      [&](const AudioFrame &frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames.push_back(frame);
+        cv.notify_all();
+      },
+      options);
+
+  // Odd device buffer sizes; the counter makes continuity checkable.
+  std::vector<std::int16_t> chunk(137);
+  std::int16_t next = 0;
+  int pushed = 0;
+  while (pushed < 4800) {
+    const int n = std::min<int>(137, 4800 - pushed);
+    for (int i = 0; i < n; ++i) {
+      chunk[i] = next++;
+    }
+    ASSERT_EQ(adapter.push(chunk.data(), n), n);
+    pushed += n;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+                          [&] { return frames.size() == 10; }));
+  std::int16_t expected = 0;
+  for (const auto &frame : frames) {
+    ASSERT_EQ(frame.samples_per_channel(), 480);
+    ASSERT_EQ(frame.sample_rate(), 48000);
+    for (auto s : frame.data()) {
+      ASSERT_EQ(s, expected++);
+    }
+  }
+  EXPECT_EQ(adapter.stats().frames_pushed, 4800u);
+  EXPECT_EQ(adapter.stats().frames_dropped, 0u);
+}
+
+TEST(AudioCaptureAdapterTest, RejectsMissingSink) {
+  EXPECT_THROW(AudioCaptureAdapter(AudioCaptureAdapter::FrameSink{},
+                                   AudioCaptureAdapter::Options{}),
+               std::invalid_argument);
+  EXPECT_THROW(AudioCaptureAdapter(std::shared_ptr<AudioSource>{},
+                                   AudioCaptureAdapter::Options{}),
+               std::invalid_argument);
+}
+
+} // namespace test
+} // namespace livekit
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <iostream>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -920,5 +921,68 @@ TEST_F(AudioProcessingModuleTest, AGCWithNoiseSuppressionCombined) {
       << "Combined AGC+NS should produce reasonable output";
 }
 
+// ============================================================================
+// Batch / streaming Tests
+// ============================================================================
+
+TEST_F(AudioProcessingModuleTest, ProcessStreamBatchMatchesSingleFrames) {
+  AudioProcessingModule::Options opts;
+  opts.high_pass_filter = true;
+  AudioProcessingModule single(opts);
+  AudioProcessingModule batched(opts);
+
+  std::vector<AudioFrame> frames;
+  for (int i = 0; i < 8; ++i) {
+    AudioFrame frame = create10msFrame(48000, 1);
+    fillWithNoise(frame, 5000.0, 100 + i);
+    frames.push_back(frame);
+  }
+  std::vector<AudioFrame> expected = frames;
+  for (auto &frame : expected) {
+    single.processStream(frame);
+  }
+
+  ASSERT_NO_THROW(batched.processStreamBatch(frames));
+  for (std::size_t i = 0; i < frames.size(); ++i) {
+    EXPECT_EQ(frames[i].data(), expected[i].data()) << "frame " << i;
+  }
+}
+
+TEST_F(AudioProcessingModuleTest, ProcessingStreamRechunksTo10ms) {
+  AudioProcessingModule::Options opts;
+  opts.noise_suppression = true;
+  AudioProcessingModule apm(opts);
+  AudioProcessingStream stream(apm, AudioProcessingStream::Direction::kForward,
+                               48000, 2);
+
+  // 7ms, then 7ms: the first call yields nothing, the second one chunk.
+  AudioFrame part = AudioFrame::create(48000, 2, 336);
+  fillWithSineWave(part, 440.0);
+  AudioFrame out = stream.process(part);
+  EXPECT_EQ(out.samples_per_channel(), 0);
+  EXPECT_EQ(stream.pendingSamplesPerChannel(), 336u);
+
+  out = stream.process(part);
+  EXPECT_EQ(out.samples_per_channel(), 480);
+  EXPECT_EQ(out.num_channels(), 2);
+  EXPECT_EQ(stream.pendingSamplesPerChannel(), 192u);
+
+  AudioFrame tail = stream.flush();
+  EXPECT_EQ(tail.samples_per_channel(), 192);
+  EXPECT_EQ(stream.pendingSamplesPerChannel(), 0u);
+}
+
+TEST_F(AudioProcessingModuleTest, ProcessingStreamRejectsMismatchedFormat) {
+  AudioProcessingModule apm;
+  AudioProcessingStream stream(apm, AudioProcessingStream::Direction::kReverse,
+                               48000, 1);
+  EXPECT_THROW(stream.process(AudioFrame::create(16000, 1, 160)),
+               std::invalid_argument);
+  EXPECT_THROW(AudioProcessingStream(apm,
+                                     AudioProcessingStream::Direction::kForward,
+                                     44101, 1),
+               std::invalid_argument);
+}
+
 } // namespace test
 } // namespace livekit
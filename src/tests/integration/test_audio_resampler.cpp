@@ -0,0 +1,124 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/audio_resampler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+AudioFrame sineFrame(int sample_rate, int samples, double freq,
+                     std::size_t offset, int channels = 1) {
+  std::vector<std::int16_t> data(static_cast<std::size_t>(samples) *
+                                 channels);
+  for (int i = 0; i < samples; ++i) {
+    const double t = static_cast<double>(offset + i) / sample_rate;
+    const auto v =
+        static_cast<std::int16_t>(10000.0 * std::sin(2.0 * kPi * freq * t));
+    for (int c = 0; c < channels; ++c) {
+      data[static_cast<std::size_t>(i) * channels + c] = v;
+    }
+  }
+  return AudioFrame(std::move(data), sample_rate, channels, samples);
+}
+
+} // namespace
+
+TEST(AudioResamplerTest, TenMsFramesStayTenMs) {
+  AudioResampler resampler(44100, 48000, 1);
+  int total = 0;
+  for (int i = 0; i < 100; ++i) {
+    AudioFrame out =
+        resampler.resample(sineFrame(44100, 441, 440.0, 441 * i));
+    EXPECT_EQ(out.sample_rate(), 48000);
+    EXPECT_NEAR(out.samples_per_channel(), 480, 1);
+    total += out.samples_per_channel();
+  }
+  EXPECT_NEAR(total, 48000, 1);
+}
+
+TEST(AudioResamplerTest, DownsamplePreservesDc) {
+  AudioResampler resampler(48000, 16000, 2);
+  AudioFrame out;
+  for (int i = 0; i < 5; ++i) {
+    out = resampler.resample(
+        AudioFrame(std::vector<std::int16_t>(960, 1234), 48000, 2, 480));
+  }
+  ASSERT_EQ(out.samples_per_channel(), 160);
+  for (std::int16_t s : out.data()) {
+    EXPECT_NEAR(s, 1234, 2);
+  }
+}
+
+TEST(AudioResamplerTest, PreservesSineAmplitude) {
+  AudioResampler resampler(16000, 48000, 1);
+  std::vector<std::int16_t> all;
+  for (int i = 0; i < 20; ++i) {
+    AudioFrame out = resampler.resample(sineFrame(16000, 160, 1000.0, 160 * i));
+    all.insert(all.end(), out.data().begin(), out.data().end());
+  }
+  // Skip the filter's start-up transient.
+  int peak = 0;
+  for (std::size_t i = 480; i < all.size(); ++i) {
+    peak = std::max(peak, std::abs(static_cast<int>(all[i])));
+  }
+  EXPECT_NEAR(peak, 10000, 300);
+}
+
+TEST(AudioResamplerTest, RejectsMismatchedFrames) {
+  AudioResampler resampler(48000, 16000, 1);
+  EXPECT_THROW(resampler.resample(AudioFrame::create(44100, 1, 441)),
+               std::invalid_argument);
+  EXPECT_THROW(resampler.resample(AudioFrame::create(48000, 2, 480)),
+               std::invalid_argument);
+  EXPECT_THROW(AudioResampler(0, 48000, 1), std::invalid_argument);
+}
+
+TEST(AudioResamplerTest, FlushDrainsTail) {
+  AudioResampler resampler(48000, 24000, 1);
+  resampler.resample(sineFrame(48000, 480, 440.0, 0));
+  AudioFrame tail = resampler.flush();
+  EXPECT_GT(tail.samples_per_channel(), 0);
+}
+
+TEST(AudioFrameRemixTest, StereoToMonoAverages) {
+  AudioFrame stereo({100, 300, -50, 50}, 48000, 2, 2);
+  AudioFrame mono = stereo.remix(1);
+  ASSERT_EQ(mono.num_channels(), 1);
+  ASSERT_EQ(mono.samples_per_channel(), 2);
+  EXPECT_EQ(mono.data()[0], 200);
+  EXPECT_EQ(mono.data()[1], 0);
+}
+
+TEST(AudioFrameRemixTest, MonoToStereoDuplicates) {
+  AudioFrame mono({7, -7}, 48000, 1, 2);
+  AudioFrame stereo = mono.remix(2);
+  ASSERT_EQ(stereo.num_channels(), 2);
+  EXPECT_EQ(stereo.data(), (std::vector<std::int16_t>{7, 7, -7, -7}));
+  EXPECT_THROW(mono.remix(0), std::invalid_argument);
+}
+
+} // namespace test
+} // namespace livekit
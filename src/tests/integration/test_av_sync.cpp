@@ -0,0 +1,174 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/audio_frame.h>
+#include <livekit/av_sync.h>
+#include <livekit/video_frame.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+constexpr std::int64_t kBase = 1000000000; // receive clock origin, us
+
+AudioFrameEvent audioAt(std::int64_t timestamp_us) {
+  AudioFrameEvent ev;
+  ev.frame = AudioFrame::create(48000, 1, 480);
+  ev.timestamp_us = timestamp_us;
+  return ev;
+}
+
+VideoFrameEvent videoAt(std::int64_t timestamp_us) {
+  return VideoFrameEvent{VideoFrame::create(4, 4, VideoBufferType::I420),
+                         timestamp_us, VideoRotation::VIDEO_ROTATION_0,
+                         std::nullopt};
+}
+
+struct Collector {
+  std::vector<AvSyncFrame> frames;
+  AvSync::Callback callback() {
+    return [this](AvSyncFrame &&f) { frames.push_back(std::move(f)); };
+  }
+};
+
+} // namespace
+
+TEST(AvSyncTest, PairsEachAudioFrameWithVideoDueAtItsTime) {
+  Collector out;
+  AvSync sync(out.callback());
+  // 30 fps video whose sender clock is 5 s behind the receive clock and
+  // which arrives 20 ms after being due; 10 ms audio, all pushed in
+  // arrival order.
+  const std::int64_t sender_offset = 5000000;
+  std::int64_t next_video = 0;
+  for (int i = 0; i < 30; ++i) {
+    const std::int64_t audio_time = kBase + i * 10000;
+    while (kBase + next_video * 33333 + 20000 <= audio_time) {
+      const std::int64_t due = kBase + next_video * 33333;
+      sync.pushVideo(videoAt(due - sender_offset), due + 20000);
+      ++next_video;
+    }
+    sync.pushAudio(audioAt(audio_time));
+  }
+  sync.close();
+
+  ASSERT_EQ(out.frames.size(), 30u);
+  for (std::size_t i = 0; i < out.frames.size(); ++i) {
+    const AvSyncFrame &f = out.frames[i];
+    EXPECT_EQ(f.audio.timestamp_us, kBase + static_cast<std::int64_t>(i) *
+                                                10000);
+    if (!f.video) {
+      // Audio from before the first video frame arrived.
+      EXPECT_LT(f.audio.timestamp_us, kBase + 20000) << i;
+      continue;
+    }
+    // Arrival offsets are all equal, so video time is arrival time; the
+    // paired frame is the newest one that has arrived by the audio time.
+    const std::int64_t video_arrival =
+        f.video->timestamp_us + sender_offset + 20000;
+    EXPECT_LE(video_arrival, f.audio.timestamp_us) << i;
+    EXPECT_GT(video_arrival + 33334, f.audio.timestamp_us) << i;
+    EXPECT_EQ(f.skew_us, f.audio.timestamp_us - video_arrival);
+    if (i > 0) {
+      EXPECT_EQ(f.video_changed, f.video != out.frames[i - 1].video) << i;
+    }
+  }
+  EXPECT_TRUE(out.frames[2].video_changed);
+  const AvSyncStats stats = sync.stats();
+  EXPECT_EQ(stats.audio_frames, 30u);
+  EXPECT_EQ(stats.video_dropped, 0u);
+}
+
+TEST(AvSyncTest, HoldsAudioUntilLaterVideoArrives) {
+  Collector out;
+  AvSync sync(out.callback());
+  sync.pushVideo(videoAt(0), kBase);
+  sync.pushAudio(audioAt(kBase + 10000));
+  sync.pushAudio(audioAt(kBase + 20000));
+  EXPECT_TRUE(out.frames.empty());
+
+  // The next video frame shows frame 0 was the right one for both.
+  sync.pushVideo(videoAt(33333), kBase + 33333);
+  ASSERT_EQ(out.frames.size(), 2u);
+  EXPECT_EQ(out.frames[0].video->timestamp_us, 0);
+  EXPECT_TRUE(out.frames[0].video_changed);
+  EXPECT_FALSE(out.frames[1].video_changed);
+  EXPECT_EQ(out.frames[1].skew_us, 20000);
+}
+
+TEST(AvSyncTest, MaxDelayBoundsTheAudioHold) {
+  Collector out;
+  AvSync::Options options;
+  options.max_delay = std::chrono::milliseconds(50);
+  AvSync sync(out.callback(), options);
+  // Audio only: frames leave once they are 50 ms old in audio time.
+  for (int i = 0; i <= 5; ++i) {
+    sync.pushAudio(audioAt(kBase + i * 10000));
+  }
+  ASSERT_EQ(out.frames.size(), 1u);
+  EXPECT_EQ(out.frames[0].video, nullptr);
+  EXPECT_EQ(sync.stats().audio_unsynced, 0u);
+
+  // Video that stalls: held audio is released unsynced.
+  sync.pushVideo(videoAt(0), kBase + 60000);
+  for (int i = 6; i < 20; ++i) {
+    sync.pushAudio(audioAt(kBase + i * 10000));
+  }
+  EXPECT_EQ(out.frames.size(), 15u);
+  EXPECT_GT(sync.stats().audio_unsynced, 0u);
+  EXPECT_NE(out.frames.back().video, nullptr);
+}
+
+TEST(AvSyncTest, VideoBufferIsBounded) {
+  Collector out;
+  AvSync::Options options;
+  options.max_video_frames = 4;
+  AvSync sync(out.callback(), options);
+  for (int i = 0; i < 10; ++i) {
+    sync.pushVideo(videoAt(i * 33333), kBase + i * 33333);
+  }
+  EXPECT_EQ(sync.stats().video_frames, 10u);
+  EXPECT_EQ(sync.stats().video_dropped, 6u);
+  sync.close();
+  EXPECT_EQ(sync.stats().video_dropped, 10u);
+  EXPECT_TRUE(out.frames.empty());
+}
+
+TEST(AvSyncTest, CloseDeliversHeldAudio) {
+  Collector out;
+  AvSync sync(out.callback());
+  sync.pushVideo(videoAt(0), kBase);
+  sync.pushAudio(audioAt(kBase + 10000));
+  EXPECT_TRUE(out.frames.empty());
+  sync.close();
+  ASSERT_EQ(out.frames.size(), 1u);
+  EXPECT_NE(out.frames[0].video, nullptr);
+  sync.pushAudio(audioAt(kBase + 20000));
+  EXPECT_EQ(out.frames.size(), 1u);
+}
+
+TEST(AvSyncTest, RejectsEmptyCallback) {
+  EXPECT_THROW(AvSync(nullptr), std::invalid_argument);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "compact_participants.h"
+
+#include <string>
+
+namespace livekit {
+namespace {
+
+using detail::CompactParticipantStore;
+using detail::ParticipantFields;
+using detail::StringPool;
+
+ParticipantFields listener(const std::string &identity,
+                           const std::string &name = "Guest") {
+  ParticipantFields fields;
+  fields.sid = "PA_" + identity;
+  fields.identity = identity;
+  fields.name = name;
+  fields.attributes = AttributeMap{{"role", "viewer"}, {"lang", "en"}};
+  fields.kind = ParticipantKind::Standard;
+  return fields;
+}
+
+TEST(StringPoolTest, SharesEqualStringsUntilLastRelease) {
+  StringPool pool;
+  const std::string *a = pool.acquire("viewer");
+  const std::string *b = pool.acquire("viewer");
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(pool.size(), 1u);
+
+  pool.release(a);
+  EXPECT_EQ(pool.size(), 1u);
+  EXPECT_EQ(*b, "viewer");
+  pool.release(b);
+  EXPECT_EQ(pool.size(), 0u);
+}
+
+TEST(CompactParticipantStoreTest, PoolsRepeatedStrings) {
+  CompactParticipantStore store;
+  for (int i = 0; i < 1000; ++i) {
+    store.insert(listener("user-" + std::to_string(i)));
+  }
+  EXPECT_EQ(store.size(), 1000u);
+  // "Guest", "" (metadata), and the two attribute pairs.
+  EXPECT_EQ(store.pooledStrings(), 6u);
+
+  store.clear();
+  EXPECT_EQ(store.size(), 0u);
+  EXPECT_EQ(store.pooledStrings(), 0u);
+}
+
+TEST(CompactParticipantStoreTest, TakeReturnsTheStoredFields) {
+  CompactParticipantStore store;
+  store.insert(listener("alice", "Alice"));
+  store.insert(listener("bob"));
+
+  auto fields = store.take("alice");
+  ASSERT_TRUE(fields.has_value());
+  EXPECT_EQ(fields->identity, "alice");
+  EXPECT_EQ(fields->sid, "PA_alice");
+  EXPECT_EQ(fields->name, "Alice");
+  EXPECT_EQ(fields->attributes.size(), 2u);
+  EXPECT_EQ(fields->attributes.at("role"), "viewer");
+  EXPECT_FALSE(store.contains("alice"));
+  EXPECT_FALSE(store.take("alice").has_value());
+
+  // Only bob's strings remain.
+  EXPECT_EQ(store.size(), 1u);
+  EXPECT_EQ(store.pooledStrings(), 6u);
+  EXPECT_TRUE(store.erase("bob"));
+  EXPECT_FALSE(store.erase("bob"));
+  EXPECT_EQ(store.pooledStrings(), 0u);
+}
+
+TEST(CompactParticipantStoreTest, UpdateReplacesMutableFields) {
+  CompactParticipantStore store;
+  store.insert(listener("alice"));
+
+  EXPECT_TRUE(store.update("alice", "Alice", "{\"hand\":true}",
+                           AttributeMap{{"role", "speaker"}},
+                           ParticipantKind::Agent, DisconnectReason::Unknown));
+  EXPECT_FALSE(store.update("nobody", "", "", AttributeMap{},
+                            ParticipantKind::Standard,
+                            DisconnectReason::Unknown));
+  // The old values were released.
+  EXPECT_EQ(store.pooledStrings(), 4u);
+
+  auto fields = store.take("alice");
+  ASSERT_TRUE(fields.has_value());
+  EXPECT_EQ(fields->name, "Alice");
+  EXPECT_EQ(fields->metadata, "{\"hand\":true}");
+  EXPECT_EQ(fields->attributes.size(), 1u);
+  EXPECT_EQ(fields->attributes.at("role"), "speaker");
+  EXPECT_EQ(fields->kind, ParticipantKind::Agent);
+}
+
+TEST(CompactParticipantStoreTest, InsertReplacesExistingRecord) {
+  CompactParticipantStore store;
+  store.insert(listener("alice", "First"));
+  store.insert(listener("alice", "Second"));
+  EXPECT_EQ(store.size(), 1u);
+
+  auto fields = store.take("alice");
+  ASSERT_TRUE(fields.has_value());
+  EXPECT_EQ(fields->name, "Second");
+  EXPECT_EQ(store.pooledStrings(), 0u);
+}
+
+} // namespace
+} // namespace livekit
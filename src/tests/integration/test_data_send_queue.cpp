@@ -0,0 +1,229 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "data_send_queue.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+using detail::DataSendQueue;
+
+namespace {
+
+// Records sent packets by their first byte, standing in for the FFI.
+class SendLog {
+public:
+  DataSendQueue::SendFn sender() {
+    return [this](const std::uint8_t *data, std::size_t) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      sent_.push_back(static_cast<char>(data[0]));
+      cv_.notify_all();
+    };
+  }
+
+  bool waitFor(std::size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::seconds(5),
+                        [&] { return sent_.size() >= count; });
+  }
+
+  std::string sent() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sent_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::string sent_;
+};
+
+DataSendOptions budget(std::size_t bytes, unsigned bulk_share = 75) {
+  DataSendOptions options;
+  options.max_buffered_bytes = bytes;
+  options.bulk_share_percent = bulk_share;
+  return options;
+}
+
+// Submits a packet of `size` bytes tagged `tag`; the returned ticket plays
+// the part of the FFI completion.
+std::shared_ptr<DataSendQueue::Ticket>
+submit(DataSendQueue &queue, SendLog &log, DataPriority priority, char tag,
+       std::size_t size, bool *abandoned = nullptr) {
+  std::vector<std::uint8_t> payload(size, static_cast<std::uint8_t>(tag));
+  auto ticket = queue.ticket(size);
+  queue.submit(priority, ticket, payload.data(), payload.size(), log.sender(),
+               [abandoned] {
+                 if (abandoned) {
+                   *abandoned = true;
+                 }
+               });
+  return ticket;
+}
+
+} // namespace
+
+TEST(DataSendQueueTest, SendsInlineWithinBudget) {
+  auto queue = std::make_shared<DataSendQueue>(budget(1000));
+  SendLog log;
+  auto a = submit(*queue, log, DataPriority::kControl, 'a', 400);
+  auto b = submit(*queue, log, DataPriority::kState, 'b', 400);
+  EXPECT_EQ(log.sent(), "ab");
+
+  DataSendStats stats = queue->stats();
+  EXPECT_EQ(stats.buffered_bytes, 800u);
+  EXPECT_EQ(stats.limit_bytes, 1000u);
+  EXPECT_EQ(stats.packets_sent, 2u);
+  EXPECT_EQ(stats.packets_delayed, 0u);
+
+  a.reset(); // acknowledged
+  EXPECT_EQ(queue->stats().buffered_bytes, 400u);
+  queue->stop();
+}
+
+TEST(DataSendQueueTest, QueuedPacketsGoOutByPriority) {
+  auto queue = std::make_shared<DataSendQueue>(budget(100));
+  SendLog log;
+  auto first = submit(*queue, log, DataPriority::kBulk, '0', 100);
+  auto bulk = submit(*queue, log, DataPriority::kBulk, 'a', 100);
+  auto state = submit(*queue, log, DataPriority::kState, 'b', 100);
+  auto control = submit(*queue, log, DataPriority::kControl, 'c', 100);
+  EXPECT_EQ(log.sent(), "0");
+  EXPECT_EQ(queue->stats().queued_packets, 3u);
+  EXPECT_EQ(queue->stats().queued_bytes, 300u);
+
+  // Each acknowledgement makes room for exactly one more packet.
+  first.reset();
+  ASSERT_TRUE(log.waitFor(2));
+  control.reset();
+  ASSERT_TRUE(log.waitFor(3));
+  state.reset();
+  ASSERT_TRUE(log.waitFor(4));
+  EXPECT_EQ(log.sent(), "0cba");
+
+  DataSendStats stats = queue->stats();
+  EXPECT_EQ(stats.packets_sent, 4u);
+  EXPECT_EQ(stats.packets_delayed, 3u);
+  EXPECT_EQ(stats.queued_packets, 0u);
+  queue->stop();
+}
+
+TEST(DataSendQueueTest, BulkLeavesHeadroomForOtherClasses) {
+  auto queue = std::make_shared<DataSendQueue>(budget(1000, 50));
+  SendLog log;
+  auto a = submit(*queue, log, DataPriority::kControl, 'a', 400);
+  auto bulk = submit(*queue, log, DataPriority::kBulk, 'b', 200);
+  auto state = submit(*queue, log, DataPriority::kState, 's', 200);
+  EXPECT_EQ(log.sent(), "as");
+  EXPECT_EQ(queue->stats().queued_packets, 1u);
+
+  a.reset();
+  ASSERT_TRUE(log.waitFor(3));
+  EXPECT_EQ(log.sent(), "asb");
+  queue->stop();
+}
+
+TEST(DataSendQueueTest, OversizedPacketIsSentWhenIdle) {
+  auto queue = std::make_shared<DataSendQueue>(budget(100));
+  SendLog log;
+  auto big = submit(*queue, log, DataPriority::kBulk, 'x', 5000);
+  EXPECT_EQ(log.sent(), "x");
+  queue->stop();
+}
+
+TEST(DataSendQueueTest, FollowsChannelThresholdUnlessConfigured) {
+  auto queue = std::make_shared<DataSendQueue>(DataSendOptions{});
+  EXPECT_EQ(queue->stats().limit_bytes, kDefaultDataSendBufferBytes);
+  queue->setChannelThreshold(4096);
+  EXPECT_EQ(queue->stats().limit_bytes, 4096u);
+  queue->configure(budget(777));
+  EXPECT_EQ(queue->stats().limit_bytes, 777u);
+  queue->stop();
+}
+
+TEST(DataSendQueueTest, InlineSendWaitsForQueuedSendInProgress) {
+  auto queue = std::make_shared<DataSendQueue>(budget(100));
+  SendLog log;
+  auto first = submit(*queue, log, DataPriority::kControl, 'a', 100);
+
+  // 'b' is queued; its send blocks until the gate opens, so the sender
+  // thread sits between popping it and handing it to the FFI.
+  std::mutex gate_mutex;
+  std::condition_variable gate_cv;
+  bool in_send = false;
+  bool open = false;
+  std::uint8_t b = 'b';
+  auto queued = queue->ticket(1);
+  queue->submit(
+      DataPriority::kControl, queued, &b, 1,
+      [&](const std::uint8_t *data, std::size_t size) {
+        {
+          std::unique_lock<std::mutex> lock(gate_mutex);
+          in_send = true;
+          gate_cv.notify_all();
+          gate_cv.wait(lock, [&] { return open; });
+        }
+        log.sender()(data, size);
+      },
+      [] {});
+  first.reset();
+  {
+    std::unique_lock<std::mutex> lock(gate_mutex);
+    ASSERT_TRUE(gate_cv.wait_for(lock, std::chrono::seconds(5),
+                                 [&] { return in_send; }));
+  }
+
+  // Fits the budget and every queue is empty, yet must not overtake 'b'.
+  auto late = submit(*queue, log, DataPriority::kControl, 'c', 1);
+  EXPECT_EQ(log.sent(), "a");
+  {
+    std::lock_guard<std::mutex> lock(gate_mutex);
+    open = true;
+  }
+  gate_cv.notify_all();
+  ASSERT_TRUE(log.waitFor(3));
+  EXPECT_EQ(log.sent(), "abc");
+  queue->stop();
+}
+
+TEST(DataSendQueueTest, StopAbandonsQueuedPackets) {
+  auto queue = std::make_shared<DataSendQueue>(budget(100));
+  SendLog log;
+  bool abandoned = false;
+  auto first = submit(*queue, log, DataPriority::kControl, 'a', 100);
+  auto waiting =
+      submit(*queue, log, DataPriority::kControl, 'b', 100, &abandoned);
+  queue->stop();
+  EXPECT_TRUE(abandoned);
+  EXPECT_EQ(log.sent(), "a");
+
+  // After stop() packets are no longer held back.
+  auto late = submit(*queue, log, DataPriority::kControl, 'c', 100);
+  EXPECT_EQ(log.sent(), "ac");
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dma_buf.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace livekit {
+namespace test {
+
+#if defined(__linux__)
+
+namespace {
+
+// A regular file stands in for a DMA-BUF: mmap works the same, and the
+// sync ioctl failing on it is deliberately ignored by mapDmaBuf().
+int openBufferFile(const std::vector<std::uint8_t> &contents) {
+  const std::string path = ::testing::TempDir() + "livekit_dma_buf_test.bin";
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd >= 0) {
+    unlink(path.c_str());
+    if (write(fd, contents.data(), contents.size()) !=
+        static_cast<ssize_t>(contents.size())) {
+      close(fd);
+      return -1;
+    }
+  }
+  return fd;
+}
+
+} // namespace
+
+TEST(DmaBufTest, MapsPlanesInPlace) {
+  // NV12 4x2 with 8-byte row pitch: Y rows at 0 and 8, UV row at 16.
+  std::vector<std::uint8_t> contents(24, 0);
+  for (int i = 0; i < 4; ++i) {
+    contents[i] = static_cast<std::uint8_t>(10 + i);
+    contents[8 + i] = static_cast<std::uint8_t>(20 + i);
+    contents[16 + i] = static_cast<std::uint8_t>(30 + i);
+  }
+  const int fd = openBufferFile(contents);
+  ASSERT_GE(fd, 0);
+
+  int released = 0;
+  NativeVideoBuffer buffer;
+  buffer.kind = NativeBufferKind::kDmaBuf;
+  buffer.handle = static_cast<std::uintptr_t>(fd);
+  buffer.width = 4;
+  buffer.height = 2;
+  buffer.layout = VideoBufferType::NV12;
+  buffer.planes = {{0, 8}, {16, 8}};
+  buffer.release = [&released] { ++released; };
+
+  {
+    VideoFrame frame = detail::mapDmaBuf(std::move(buffer));
+    EXPECT_TRUE(frame.isExternal());
+    const auto planes = frame.planeInfos();
+    ASSERT_EQ(planes.size(), 2u);
+    EXPECT_EQ(planes[0].stride, 8u);
+    const auto *y = reinterpret_cast<const std::uint8_t *>(planes[0].data_ptr);
+    const auto *uv = reinterpret_cast<const std::uint8_t *>(planes[1].data_ptr);
+    EXPECT_EQ(y[0], 10);
+    EXPECT_EQ(y[8 + 3], 23);
+    EXPECT_EQ(uv[1], 31);
+    EXPECT_EQ(released, 0);
+  }
+  EXPECT_EQ(released, 1);
+  close(fd);
+}
+
+TEST(DmaBufTest, ReleasesOnMapFailure) {
+  int released = 0;
+  NativeVideoBuffer buffer;
+  buffer.handle = static_cast<std::uintptr_t>(-1);
+  buffer.width = 4;
+  buffer.height = 2;
+  buffer.release = [&released] { ++released; };
+
+  EXPECT_THROW(detail::mapDmaBuf(std::move(buffer)), std::runtime_error);
+  EXPECT_EQ(released, 1);
+}
+
+#endif
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,218 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "e2ee_internal.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+using detail::FrameCryptorCache;
+using detail::nextRotationSlot;
+
+namespace {
+
+std::vector<FrameCryptorCache::Entry> threeCryptors() {
+  return {{"alice", 0, true}, {"bob", 0, true}, {"carol", 1, false}};
+}
+
+// What a bulk operation sent: (identity, request) per send() call.
+struct SentRequests {
+  std::vector<std::pair<std::string, proto::FfiRequest>> sent;
+
+  auto sender() {
+    return [this](const std::string &identity, const proto::FfiRequest &req) {
+      sent.emplace_back(identity, req);
+    };
+  }
+};
+
+const std::vector<std::string> kIdentities = {"alice", "bob", "carol"};
+
+} // namespace
+
+TEST(KeyRotationSlotTest, EpochPicksItsSlot) {
+  EXPECT_EQ(nextRotationSlot(std::int64_t{5}, 0, 4), 1);
+  EXPECT_EQ(nextRotationSlot(std::int64_t{6}, 1, 4), 2);
+  EXPECT_EQ(nextRotationSlot(std::int64_t{1000003}, 0, 16), 3);
+}
+
+TEST(KeyRotationSlotTest, EpochOnTheActiveSlotTakesTheNextOne) {
+  // First periodic rotation after start-up, still on slot 0.
+  EXPECT_EQ(nextRotationSlot(std::int64_t{8}, 0, 4), 1);
+  // Wraps around the ring.
+  EXPECT_EQ(nextRotationSlot(std::int64_t{7}, 3, 4), 0);
+  EXPECT_EQ(nextRotationSlot(std::int64_t{1}, 1, 2), 0);
+}
+
+TEST(KeyRotationSlotTest, ManualRotationTakesTheSlotAfterActive) {
+  EXPECT_EQ(nextRotationSlot(std::nullopt, 0, 4), 1);
+  EXPECT_EQ(nextRotationSlot(std::nullopt, 3, 4), 0);
+}
+
+TEST(FrameCryptorCacheTest, StartsInvalidAndKeepsAFetch) {
+  FrameCryptorCache cache;
+  std::vector<FrameCryptorCache::Entry> entries;
+  std::uint64_t generation = 0;
+  EXPECT_FALSE(cache.load(entries, generation));
+
+  cache.store(threeCryptors(), generation);
+  ASSERT_TRUE(cache.load(entries, generation));
+  ASSERT_EQ(entries.size(), 3u);
+  EXPECT_EQ(entries[2].identity, "carol");
+}
+
+TEST(FrameCryptorCacheTest, InvalidateDropsTheCachedList) {
+  FrameCryptorCache cache;
+  std::vector<FrameCryptorCache::Entry> entries;
+  std::uint64_t generation = 0;
+  cache.load(entries, generation);
+  cache.store(threeCryptors(), generation);
+
+  cache.invalidate();
+  entries.clear();
+  EXPECT_FALSE(cache.load(entries, generation));
+  EXPECT_TRUE(entries.empty());
+}
+
+TEST(FrameCryptorCacheTest, FetchRacingInvalidateIsNotStored) {
+  FrameCryptorCache cache;
+  std::vector<FrameCryptorCache::Entry> entries;
+  std::uint64_t generation = 0;
+  cache.load(entries, generation);
+  // A participant joins while the fetch is in flight.
+  cache.invalidate();
+  cache.store(threeCryptors(), generation);
+  EXPECT_FALSE(cache.load(entries, generation));
+
+  // The next fetch, started after the invalidation, is kept.
+  cache.store(threeCryptors(), generation);
+  EXPECT_TRUE(cache.load(entries, generation));
+}
+
+TEST(FrameCryptorCacheTest, ParticipantAndTrackChangesInvalidate) {
+  using E = proto::RoomEvent;
+  for (auto kind :
+       {E::kParticipantConnected, E::kParticipantDisconnected,
+        E::kLocalTrackPublished, E::kLocalTrackUnpublished,
+        E::kTrackSubscribed, E::kTrackUnsubscribed, E::kE2EeStateChanged,
+        E::kReconnected}) {
+    EXPECT_TRUE(detail::changesFrameCryptors(kind)) << kind;
+  }
+  for (auto kind : {E::kTrackMuted, E::kActiveSpeakersChanged,
+                    E::kParticipantAttributesChanged, E::kDataPacketReceived}) {
+    EXPECT_FALSE(detail::changesFrameCryptors(kind)) << kind;
+  }
+}
+
+TEST(FrameCryptorCacheTest, UpdatesApplyToCachedEntries) {
+  FrameCryptorCache cache;
+  std::vector<FrameCryptorCache::Entry> entries;
+  std::uint64_t generation = 0;
+  cache.load(entries, generation);
+  cache.store(threeCryptors(), generation);
+
+  cache.update("bob", [](auto &entry) { entry.key_index = 5; });
+  cache.updateAll([](auto &entry) { entry.enabled = false; });
+  ASSERT_TRUE(cache.load(entries, generation));
+  EXPECT_EQ(entries[0].key_index, 0);
+  EXPECT_EQ(entries[1].key_index, 5);
+  for (const auto &entry : entries) {
+    EXPECT_FALSE(entry.enabled) << entry.identity;
+  }
+}
+
+TEST(E2eeBulkRequestTest, SetKeysSendsOneRequestPerParticipant) {
+  const std::unordered_map<std::string, std::vector<std::uint8_t>> keys = {
+      {"alice", {1, 2}}, {"bob", {3}}};
+  proto::FfiRequest req;
+  SentRequests out;
+  detail::sendSetKeyRequests(req, 9, keys, 2, out.sender());
+
+  ASSERT_EQ(out.sent.size(), 2u);
+  for (const auto &sent : out.sent) {
+    const auto &e2ee = sent.second.e2ee();
+    EXPECT_EQ(e2ee.room_handle(), 9u);
+    ASSERT_TRUE(e2ee.has_set_key());
+    EXPECT_EQ(e2ee.set_key().participant_identity(), sent.first);
+    EXPECT_EQ(e2ee.set_key().key_index(), 2);
+    const auto &key = keys.at(sent.first);
+    EXPECT_EQ(e2ee.set_key().key(), std::string(key.begin(), key.end()));
+  }
+}
+
+TEST(E2eeBulkRequestTest, RatchetKeysCoversEveryParticipant) {
+  proto::FfiRequest req;
+  SentRequests out;
+  detail::sendRatchetKeyRequests(req, 9, kIdentities, 3, out.sender());
+
+  ASSERT_EQ(out.sent.size(), kIdentities.size());
+  for (std::size_t i = 0; i < kIdentities.size(); ++i) {
+    const auto &msg = out.sent[i].second.e2ee().ratchet_key();
+    EXPECT_EQ(out.sent[i].first, kIdentities[i]);
+    EXPECT_EQ(msg.participant_identity(), kIdentities[i]);
+    EXPECT_EQ(msg.key_index(), 3);
+  }
+}
+
+TEST(E2eeBulkRequestTest, SetAllEnabledCoversEveryCryptor) {
+  proto::FfiRequest req;
+  SentRequests out;
+  detail::sendCryptorSetEnabledRequests(req, 9, kIdentities, false,
+                                        out.sender());
+
+  ASSERT_EQ(out.sent.size(), kIdentities.size());
+  for (std::size_t i = 0; i < kIdentities.size(); ++i) {
+    const auto &e2ee = out.sent[i].second.e2ee();
+    EXPECT_EQ(e2ee.room_handle(), 9u);
+    ASSERT_TRUE(e2ee.has_cryptor_set_enabled());
+    EXPECT_EQ(e2ee.cryptor_set_enabled().participant_identity(),
+              kIdentities[i]);
+    EXPECT_FALSE(e2ee.cryptor_set_enabled().enabled());
+  }
+}
+
+TEST(E2eeBulkRequestTest, SetAllKeyIndexCoversEveryCryptor) {
+  proto::FfiRequest req;
+  SentRequests out;
+  detail::sendCryptorSetKeyIndexRequests(req, 9, kIdentities, 4, out.sender());
+
+  ASSERT_EQ(out.sent.size(), kIdentities.size());
+  for (std::size_t i = 0; i < kIdentities.size(); ++i) {
+    const auto &msg = out.sent[i].second.e2ee().cryptor_set_key_index();
+    EXPECT_EQ(msg.participant_identity(), kIdentities[i]);
+    EXPECT_EQ(msg.key_index(), 4);
+  }
+}
+
+TEST(E2eeBulkRequestTest, NoCryptorsSendsNothing) {
+  proto::FfiRequest req;
+  SentRequests out;
+  detail::sendCryptorSetEnabledRequests(req, 9, {}, true, out.sender());
+  detail::sendRatchetKeyRequests(req, 9, {}, 0, out.sender());
+  EXPECT_TRUE(out.sent.empty());
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "event_dispatcher.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+// Events are room events whose handle encodes shard * kPerShard + sequence,
+// so one field carries both the shard key and the delivery order.
+constexpr std::uint64_t kPerShard = 1000;
+
+std::string roomEvent(std::uint64_t handle) {
+  proto::FfiEvent event;
+  event.mutable_room_event()->set_room_handle(handle);
+  return event.SerializeAsString();
+}
+
+std::uint64_t shardOf(const proto::FfiEvent &event) {
+  return event.room_event().room_handle() / kPerShard;
+}
+
+struct Delivery {
+  std::uint64_t handle;
+  std::thread::id thread;
+};
+
+// Thread-safe record of what the dispatcher delivered, and where.
+class Recorder {
+public:
+  void add(const proto::FfiEvent &event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    deliveries_.push_back(
+        {event.room_event().room_handle(), std::this_thread::get_id()});
+  }
+
+  std::vector<Delivery> deliveries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return deliveries_;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<Delivery> deliveries_;
+};
+
+void dispatch(EventDispatcher &dispatcher, std::uint64_t handle) {
+  const std::string bytes = roomEvent(handle);
+  dispatcher.dispatch(reinterpret_cast<const std::uint8_t *>(bytes.data()),
+                      bytes.size());
+}
+
+EventDispatchOptions withMode(EventDispatchMode mode) {
+  EventDispatchOptions options;
+  options.mode = mode;
+  return options;
+}
+
+} // namespace
+
+TEST(EventDispatcherTest, InlineModeDeliversOnTheCallingThread) {
+  Recorder recorder;
+  EventDispatcher dispatcher(
+      withMode(EventDispatchMode::kInline),
+      [&](const proto::FfiEvent &event) { recorder.add(event); }, shardOf);
+  dispatch(dispatcher, 1);
+  dispatch(dispatcher, 2);
+
+  const auto seen = recorder.deliveries();
+  ASSERT_EQ(seen.size(), 2u);
+  EXPECT_EQ(seen[0].handle, 1u);
+  EXPECT_EQ(seen[1].handle, 2u);
+  EXPECT_EQ(seen[0].thread, std::this_thread::get_id());
+  EXPECT_FALSE(dispatcher.onWorkerThread());
+}
+
+TEST(EventDispatcherTest, DedicatedThreadKeepsGlobalOrder) {
+  Recorder recorder;
+  EventDispatcher dispatcher(
+      withMode(EventDispatchMode::kDedicatedThread),
+      [&](const proto::FfiEvent &event) { recorder.add(event); }, shardOf);
+  for (std::uint64_t i = 0; i < 200; ++i) {
+    // Alternate shards; a single worker must not reorder across them.
+    dispatch(dispatcher, (i % 2 + 1) * kPerShard + i);
+  }
+  dispatcher.stop();
+
+  const auto seen = recorder.deliveries();
+  ASSERT_EQ(seen.size(), 200u);
+  for (std::size_t i = 0; i < seen.size(); ++i) {
+    EXPECT_EQ(seen[i].handle % kPerShard, i);
+    EXPECT_EQ(seen[i].thread, seen[0].thread);
+  }
+  EXPECT_NE(seen[0].thread, std::this_thread::get_id());
+}
+
+TEST(EventDispatcherTest, ShardedPoolKeepsEachShardOnOneWorkerInOrder) {
+  EventDispatchOptions options = withMode(EventDispatchMode::kShardedPool);
+  options.pool_threads = 4;
+  Recorder recorder;
+  EventDispatcher dispatcher(
+      options, [&](const proto::FfiEvent &event) { recorder.add(event); },
+      shardOf);
+  for (std::uint64_t seq = 0; seq < 100; ++seq) {
+    for (std::uint64_t shard = 1; shard <= 4; ++shard) {
+      dispatch(dispatcher, shard * kPerShard + seq);
+    }
+  }
+  dispatcher.stop();
+
+  std::map<std::uint64_t, std::vector<Delivery>> by_shard;
+  for (const auto &delivery : recorder.deliveries()) {
+    by_shard[delivery.handle / kPerShard].push_back(delivery);
+  }
+  ASSERT_EQ(by_shard.size(), 4u);
+  std::set<std::thread::id> threads;
+  for (const auto &kv : by_shard) {
+    const auto &seen = kv.second;
+    ASSERT_EQ(seen.size(), 100u);
+    for (std::size_t i = 0; i < seen.size(); ++i) {
+      EXPECT_EQ(seen[i].handle % kPerShard, i);
+      EXPECT_EQ(seen[i].thread, seen[0].thread);
+    }
+    threads.insert(seen[0].thread);
+  }
+  // Shards 1-4 map to distinct workers of a four-thread pool.
+  EXPECT_EQ(threads.size(), 4u);
+}
+
+TEST(EventDispatcherTest, FullQueueFromWorkerDeliversInline) {
+  EventDispatchOptions options = withMode(EventDispatchMode::kDedicatedThread);
+  options.queue_capacity = 1;
+  Recorder recorder;
+  EventDispatcher *self = nullptr;
+  EventDispatcher dispatcher(
+      options,
+      [&](const proto::FfiEvent &event) {
+        recorder.add(event);
+        if (event.room_event().room_handle() == 1) {
+          // The first fits the (now empty) queue; the second would wait on
+          // this very worker, so it runs inline instead.
+          dispatch(*self, 2);
+          dispatch(*self, 3);
+        }
+      },
+      shardOf);
+  self = &dispatcher;
+  dispatch(dispatcher, 1);
+  // Stopping first would send the nested dispatches inline regardless.
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (recorder.deliveries().size() < 3 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  dispatcher.stop();
+
+  const auto seen = recorder.deliveries();
+  ASSERT_EQ(seen.size(), 3u);
+  EXPECT_EQ(seen[0].handle, 1u);
+  EXPECT_EQ(seen[1].handle, 3u);
+  EXPECT_EQ(seen[2].handle, 2u);
+  EXPECT_EQ(seen[1].thread, seen[0].thread);
+}
+
+TEST(EventDispatcherTest, StopDrainsQueuedEventsThenRunsInline) {
+  Recorder recorder;
+  EventDispatcher dispatcher(
+      withMode(EventDispatchMode::kDedicatedThread),
+      [&](const proto::FfiEvent &event) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        recorder.add(event);
+      },
+      shardOf);
+  for (std::uint64_t i = 0; i < 50; ++i) {
+    dispatch(dispatcher, i);
+  }
+  dispatcher.stop();
+  EXPECT_EQ(recorder.deliveries().size(), 50u);
+
+  dispatch(dispatcher, 50);
+  const auto seen = recorder.deliveries();
+  ASSERT_EQ(seen.size(), 51u);
+  EXPECT_EQ(seen.back().handle, 50u);
+  EXPECT_EQ(seen.back().thread, std::this_thread::get_id());
+}
+
+} // namespace test
+} // namespace livekit
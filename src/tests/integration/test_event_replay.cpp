@@ -0,0 +1,126 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "event_replay.h"
+#include "livekit/event_replay.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+std::string recordingPath() {
+  return ::testing::TempDir() + "livekit_event_replay_test.lkev";
+}
+
+// An empty payload parses as an FfiEvent with no message set, which the
+// dispatch path delivers to broadcast listeners only.
+void recordEmptyEvent() { detail::recordFfiEvent(nullptr, 0); }
+
+} // namespace
+
+TEST(EventReplayTest, RecordThenReplayRoundTrip) {
+  const std::string path = recordingPath();
+  startEventRecording(path);
+  EXPECT_TRUE(eventRecordingActive());
+  for (int i = 0; i < 3; ++i) {
+    recordEmptyEvent();
+  }
+  EXPECT_EQ(stopEventRecording(), 3u);
+  EXPECT_FALSE(eventRecordingActive());
+
+  // Events after stop are not recorded.
+  recordEmptyEvent();
+
+  EventReplayOptions options;
+  options.speed = 0.0;
+  const EventReplayResult result = replayEvents(path, options);
+  EXPECT_EQ(result.events, 3u);
+  EXPECT_EQ(result.skipped, 0u);
+  EXPECT_EQ(result.bytes, 0u);
+  EXPECT_FALSE(result.room_attached);
+}
+
+TEST(EventReplayTest, ReplayKeepsRecordedPacing) {
+  const std::string path = recordingPath();
+  startEventRecording(path);
+  recordEmptyEvent();
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  recordEmptyEvent();
+  stopEventRecording();
+
+  EventReplayOptions paced;
+  paced.speed = 1.0;
+  const EventReplayResult real_time = replayEvents(path, paced);
+  EXPECT_GE(real_time.recorded, std::chrono::milliseconds(60));
+  EXPECT_GE(real_time.elapsed, std::chrono::milliseconds(55));
+
+  paced.speed = 0.0;
+  const EventReplayResult flat_out = replayEvents(path, paced);
+  EXPECT_EQ(flat_out.events, 2u);
+  EXPECT_LT(flat_out.elapsed, real_time.elapsed);
+}
+
+TEST(EventReplayTest, RejectsFilesThatAreNotRecordings) {
+  const std::string path = recordingPath();
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "not a recording";
+  }
+  EXPECT_THROW(replayEvents(path), std::runtime_error);
+  EXPECT_THROW(replayEvents(path + ".missing"), std::runtime_error);
+}
+
+TEST(EventReplayTest, TruncatedRecordThrows) {
+  const std::string path = recordingPath();
+  startEventRecording(path);
+  const std::uint8_t payload[4] = {0, 0, 0, 0};
+  detail::recordFfiEvent(payload, sizeof(payload));
+  stopEventRecording();
+  // Cut the last payload byte.
+  std::string bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), {});
+  }
+  bytes.pop_back();
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << bytes;
+  }
+  EXPECT_THROW(replayEvents(path), std::runtime_error);
+}
+
+TEST(EventReplayTest, StartWhileRecordingThrows) {
+  const std::string path = recordingPath();
+  startEventRecording(path);
+  EXPECT_THROW(startEventRecording(path), std::runtime_error);
+  stopEventRecording();
+  EXPECT_EQ(stopEventRecording(), 0u);
+}
+
+} // namespace test
+} // namespace livekit
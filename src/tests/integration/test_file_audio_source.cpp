@@ -0,0 +1,200 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/audio_frame.h>
+#include <livekit/audio_source.h>
+#include <livekit/file_audio_source.h>
+#include <livekit/livekit.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+void putU16(std::ofstream &out, std::uint16_t v) {
+  const char bytes[2] = {static_cast<char>(v & 0xFF),
+                         static_cast<char>(v >> 8)};
+  out.write(bytes, 2);
+}
+
+void putU32(std::ofstream &out, std::uint32_t v) {
+  putU16(out, static_cast<std::uint16_t>(v & 0xFFFF));
+  putU16(out, static_cast<std::uint16_t>(v >> 16));
+}
+
+// Mono or stereo WAV whose sample i (interleaved) has the value i, with an
+// unknown chunk before fmt to exercise chunk skipping.
+std::string writeWav(const std::string &name, int sample_rate, int channels,
+                     int frames, std::uint16_t bits = 16) {
+  const std::string path = ::testing::TempDir() + name;
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  const std::uint32_t data_size = static_cast<std::uint32_t>(
+      frames * channels * static_cast<int>(sizeof(std::int16_t)));
+  out.write("RIFF", 4);
+  putU32(out, 4 + (8 + 3 + 1) + (8 + 16) + (8 + data_size));
+  out.write("WAVE", 4);
+  out.write("LIST", 4);
+  putU32(out, 3);
+  out.write("abc\0", 4); // odd size, padded
+  out.write("fmt ", 4);
+  putU32(out, 16);
+  putU16(out, 1);
+  putU16(out, static_cast<std::uint16_t>(channels));
+  putU32(out, static_cast<std::uint32_t>(sample_rate));
+  putU32(out, static_cast<std::uint32_t>(sample_rate * channels * 2));
+  putU16(out, static_cast<std::uint16_t>(channels * 2));
+  putU16(out, bits);
+  out.write("data", 4);
+  putU32(out, data_size);
+  for (int i = 0; i < frames * channels; ++i) {
+    putU16(out, static_cast<std::uint16_t>(i));
+  }
+  return path;
+}
+
+} // namespace
+
+class FileAudioSourceTest : public ::testing::Test {
+protected:
+  void SetUp() override { livekit::initialize(livekit::LogSink::kConsole); }
+
+  void TearDown() override { livekit::shutdown(); }
+};
+
+TEST_F(FileAudioSourceTest, ReadsWavInOrderThenSilence) {
+  const auto path = writeWav("fas_stereo.wav", 16000, 2, 250);
+  FileAudioSource file(path);
+  EXPECT_EQ(file.sample_rate(), 16000);
+  EXPECT_EQ(file.num_channels(), 2);
+  EXPECT_EQ(file.duration(), std::chrono::microseconds(15625));
+  ASSERT_NE(file.audioSource(), nullptr);
+
+  AudioFrame frame = AudioFrame::create(16000, 2, 160);
+  EXPECT_EQ(file.readFrame(frame), 160);
+  EXPECT_EQ(frame.data()[0], 0);
+  EXPECT_EQ(frame.data()[319], 319);
+
+  // 90 frames remain: the rest of this chunk is silent.
+  EXPECT_EQ(file.readFrame(frame), 90);
+  EXPECT_EQ(frame.data()[0], 320);
+  EXPECT_EQ(frame.data()[179], 499);
+  EXPECT_EQ(frame.data()[180], 0);
+  EXPECT_EQ(file.readFrame(frame), 0);
+  EXPECT_EQ(file.position(), file.duration());
+}
+
+TEST_F(FileAudioSourceTest, LoopsAndSeeks) {
+  const auto path = writeWav("fas_loop.wav", 8000, 1, 100);
+  FileAudioSource::Options options;
+  options.loop = true;
+  FileAudioSource file(path, options);
+
+  AudioFrame frame = AudioFrame::create(8000, 1, 80);
+  EXPECT_EQ(file.readFrame(frame), 80);
+  // Wraps after 20 more samples and keeps going from the start.
+  EXPECT_EQ(file.readFrame(frame), 80);
+  EXPECT_EQ(frame.data()[19], 99);
+  EXPECT_EQ(frame.data()[20], 0);
+  EXPECT_EQ(frame.data()[79], 59);
+
+  file.seek(std::chrono::milliseconds(5)); // sample 40
+  EXPECT_EQ(file.readFrame(frame), 80);
+  EXPECT_EQ(frame.data()[0], 40);
+
+  // Seeking past the end clamps, then wraps.
+  file.seek(std::chrono::seconds(10));
+  EXPECT_EQ(file.readFrame(frame), 80);
+  EXPECT_EQ(frame.data()[0], 0);
+}
+
+TEST_F(FileAudioSourceTest, ReadsRawPcmWithConfiguredFormat) {
+  const std::string path = ::testing::TempDir() + "fas_raw.pcm";
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    for (int i = 0; i < 480; ++i) {
+      const char bytes[2] = {static_cast<char>(7), 0};
+      out.write(bytes, 2);
+    }
+  }
+  FileAudioSource::Options options;
+  options.raw_sample_rate = 48000;
+  options.raw_num_channels = 1;
+  FileAudioSource file(path, options);
+  EXPECT_EQ(file.duration(), std::chrono::milliseconds(10));
+  AudioFrame frame = AudioFrame::create(48000, 1, 480);
+  EXPECT_EQ(file.readFrame(frame), 480);
+  EXPECT_EQ(frame.data()[479], 7);
+}
+
+TEST_F(FileAudioSourceTest, RejectsUnsupportedInput) {
+  EXPECT_THROW(FileAudioSource(writeWav("fas_8bit.wav", 8000, 1, 10, 8)),
+               std::runtime_error);
+  EXPECT_THROW(FileAudioSource(::testing::TempDir() + "fas_missing.wav"),
+               std::runtime_error);
+
+  const auto path = writeWav("fas_fmt.wav", 16000, 1, 10);
+  auto mismatched = std::make_shared<AudioSource>(48000, 1);
+  EXPECT_THROW(FileAudioSource(path, mismatched), std::invalid_argument);
+
+  FileAudioSource file(path);
+  AudioFrame stereo = AudioFrame::create(16000, 2, 160);
+  EXPECT_THROW(file.readFrame(stereo), std::invalid_argument);
+}
+
+TEST_F(FileAudioSourceTest, PlaysInRealTimeAndReportsEnd) {
+  // 100 ms of audio at 48 kHz.
+  const auto path = writeWav("fas_play.wav", 48000, 1, 4800);
+  std::atomic<bool> ended{false};
+  FileAudioSource::Options options;
+  options.on_end = [&ended] { ended = true; };
+  FileAudioSource file(path, options);
+
+  const auto started = std::chrono::steady_clock::now();
+  file.start();
+  EXPECT_TRUE(file.playing());
+  while (!ended && std::chrono::steady_clock::now() - started <
+                       std::chrono::seconds(2)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - started;
+  EXPECT_TRUE(ended);
+  EXPECT_FALSE(file.playing());
+  EXPECT_GE(elapsed, std::chrono::milliseconds(90));
+  EXPECT_EQ(file.position(), file.duration());
+
+  // Restart after a seek, then pause midway.
+  file.seek(std::chrono::microseconds(0));
+  file.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  file.stop();
+  EXPECT_FALSE(file.playing());
+  EXPECT_GT(file.position(), std::chrono::microseconds(0));
+  EXPECT_LT(file.position(), file.duration());
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/frame_pool.h>
+
+namespace livekit {
+namespace test {
+
+TEST(AudioFramePoolTest, AcquireHasRequestedShape) {
+  AudioFramePool pool;
+  AudioFrame frame = pool.acquire(48000, 2, 480);
+
+  EXPECT_EQ(frame.sample_rate(), 48000);
+  EXPECT_EQ(frame.num_channels(), 2);
+  EXPECT_EQ(frame.samples_per_channel(), 480);
+  EXPECT_EQ(frame.total_samples(), 960u);
+}
+
+TEST(AudioFramePoolTest, BufferIsRecycledOnDestruction) {
+  AudioFramePool pool;
+  const std::int16_t *first_ptr = nullptr;
+  {
+    AudioFrame frame = pool.acquire(48000, 1, 480);
+    first_ptr = frame.data().data();
+    EXPECT_EQ(pool.cachedBuffers(), 0u);
+  }
+  EXPECT_EQ(pool.cachedBuffers(), 1u);
+
+  AudioFrame again = pool.acquire(48000, 1, 480);
+  EXPECT_EQ(again.data().data(), first_ptr) << "Buffer should be reused";
+  EXPECT_EQ(pool.cachedBuffers(), 0u);
+}
+
+TEST(AudioFramePoolTest, BucketsAreKeyedBySize) {
+  AudioFramePool pool;
+  { AudioFrame frame = pool.acquire(48000, 1, 480); }
+  EXPECT_EQ(pool.cachedBuffers(), 1u);
+
+  // Different size must not take the cached 480-sample buffer.
+  AudioFrame other = pool.acquire(48000, 2, 480);
+  EXPECT_EQ(other.total_samples(), 960u);
+  EXPECT_EQ(pool.cachedBuffers(), 1u);
+}
+
+TEST(AudioFramePoolTest, BucketCapacityIsBounded) {
+  AudioFramePool pool(2);
+  {
+    AudioFrame a = pool.acquire(16000, 1, 160);
+    AudioFrame b = pool.acquire(16000, 1, 160);
+    AudioFrame c = pool.acquire(16000, 1, 160);
+  }
+  EXPECT_EQ(pool.cachedBuffers(), 2u);
+
+  pool.clear();
+  EXPECT_EQ(pool.cachedBuffers(), 0u);
+}
+
+TEST(AudioFramePoolTest, MoveAssignmentRecyclesPreviousBuffer) {
+  AudioFramePool pool;
+  AudioFrame frame = pool.acquire(48000, 1, 480);
+  frame = pool.acquire(48000, 1, 480);
+  EXPECT_EQ(pool.cachedBuffers(), 1u);
+}
+
+TEST(AudioFramePoolTest, FrameMayOutlivePool) {
+  AudioFrame frame;
+  {
+    AudioFramePool pool;
+    frame = pool.acquire(48000, 1, 480);
+  }
+  // Destroying the frame after the pool must simply free the buffer.
+  EXPECT_EQ(frame.total_samples(), 480u);
+}
+
+TEST(VideoFramePoolTest, AcquireHasFormatSize) {
+  VideoFramePool pool;
+  VideoFrame frame = pool.acquire(64, 48, VideoBufferType::I420);
+
+  EXPECT_EQ(frame.width(), 64);
+  EXPECT_EQ(frame.height(), 48);
+  EXPECT_EQ(frame.type(), VideoBufferType::I420);
+  EXPECT_EQ(frame.dataSize(), 64u * 48u + 2u * 32u * 24u);
+}
+
+TEST(VideoFramePoolTest, BufferIsRecycledOnDestruction) {
+  VideoFramePool pool;
+  const std::uint8_t *first_ptr = nullptr;
+  {
+    VideoFrame frame = pool.acquire(32, 32, VideoBufferType::RGBA);
+    first_ptr = frame.data();
+  }
+  EXPECT_EQ(pool.cachedBuffers(), 1u);
+
+  VideoFrame again = pool.acquire(32, 32, VideoBufferType::RGBA);
+  EXPECT_EQ(again.data(), first_ptr) << "Buffer should be reused";
+}
+
+TEST(VideoFramePoolTest, ToOwnedUsesPool) {
+  VideoFramePool pool;
+  VideoFrame src = VideoFrame::create(16, 16, VideoBufferType::RGBA);
+  src.data()[0] = 42;
+
+  {
+    VideoFrame copy = src.toOwned(pool);
+    EXPECT_EQ(copy.data()[0], 42);
+  }
+  EXPECT_EQ(pool.cachedBuffers(), 1u);
+}
+
+} // namespace test
+} // namespace livekit
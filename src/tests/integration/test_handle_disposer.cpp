@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/ffi_handle.h>
+
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "handle_disposer.h"
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+// Far above any id the FFI hands out, so dropping them is a no-op.
+constexpr std::uintptr_t kFakeHandle = std::uintptr_t{1} << 60;
+
+} // namespace
+
+class HandleDisposerTest : public ::testing::Test {
+protected:
+  void TearDown() override { detail::HandleDisposer::instance().stop(); }
+};
+
+TEST_F(HandleDisposerTest, DropsImmediatelyWhenNotRunning) {
+  auto &disposer = detail::HandleDisposer::instance();
+  ASSERT_FALSE(disposer.running());
+  const std::uint64_t before = disposer.deferredCount();
+  {
+    FfiHandle h(kFakeHandle, FfiHandle::Disposal::kDeferrable);
+  }
+  EXPECT_EQ(disposer.deferredCount(), before);
+  EXPECT_FALSE(disposer.defer(kFakeHandle));
+}
+
+TEST_F(HandleDisposerTest, DefersOnlyDeferrableHandlesInBatches) {
+  auto &disposer = detail::HandleDisposer::instance();
+  disposer.start();
+  disposer.start(); // idempotent
+  ASSERT_TRUE(disposer.running());
+  const std::uint64_t deferred = disposer.deferredCount();
+  const std::uint64_t batches = disposer.batchCount();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([t] {
+      for (std::uintptr_t i = 0; i < 500; ++i) {
+        FfiHandle h(kFakeHandle + t * 1000 + i,
+                    FfiHandle::Disposal::kDeferrable);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  {
+    FfiHandle immediate(kFakeHandle);
+  }
+  disposer.stop();
+  EXPECT_FALSE(disposer.running());
+
+  EXPECT_EQ(disposer.deferredCount() - deferred, 2000u);
+  const std::uint64_t used = disposer.batchCount() - batches;
+  EXPECT_GE(used, 1u);
+  EXPECT_LT(used, 2000u / 4);
+  EXPECT_FALSE(disposer.defer(kFakeHandle));
+}
+
+TEST_F(HandleDisposerTest, MovesKeepTheDisposalMode) {
+  auto &disposer = detail::HandleDisposer::instance();
+  disposer.start();
+  const std::uint64_t before = disposer.deferredCount();
+  {
+    FfiHandle a(kFakeHandle, FfiHandle::Disposal::kDeferrable);
+    FfiHandle b(std::move(a));
+    FfiHandle c;
+    c = std::move(b);
+    c.reset(kFakeHandle + 1); // the old one is deferred, the new one too
+  }
+  disposer.stop();
+  EXPECT_EQ(disposer.deferredCount() - before, 2u);
+}
+
+} // namespace test
+} // namespace livekit
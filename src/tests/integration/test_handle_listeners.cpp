@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ffi_client.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+constexpr auto kVideoEvent = proto::FfiEvent::kVideoStreamEvent;
+
+// An EOS event carries nothing but the stream handle routing looks at.
+proto::FfiEvent streamEvent(std::uint64_t handle) {
+  proto::FfiEvent event;
+  auto *vse = event.mutable_video_stream_event();
+  vse->set_stream_handle(handle);
+  vse->mutable_eos();
+  return event;
+}
+
+class HandleListenerTest : public ::testing::Test {
+protected:
+  FfiClient::ListenerId listen(std::uint64_t handle) {
+    return FfiClient::instance().AddHandleListener(
+        kVideoEvent, handle, [this](const proto::FfiEvent &event) {
+          seen_.push_back(event.video_stream_event().stream_handle());
+        });
+  }
+
+  void push(std::uint64_t handle) {
+    ASSERT_TRUE(FfiClient::instance().replayEvent(streamEvent(handle)));
+  }
+
+  std::vector<std::uint64_t> seen_;
+};
+
+} // namespace
+
+TEST_F(HandleListenerTest, EventsBeforeListenerAreDroppedWithoutHold) {
+  push(0xfeed0001);
+  const auto id = listen(0xfeed0001);
+  EXPECT_TRUE(seen_.empty());
+  push(0xfeed0001);
+  EXPECT_EQ(seen_.size(), 1u);
+  FfiClient::instance().RemoveListener(id);
+}
+
+TEST_F(HandleListenerTest, HeldEventsReachTheListenerAddedLater) {
+  FfiClient::ListenerId id = 0;
+  {
+    auto hold = FfiClient::instance().holdHandleEvents(kVideoEvent);
+    push(0xfeed0002);
+    push(0xfeed0002);
+    EXPECT_TRUE(seen_.empty());
+    id = listen(0xfeed0002);
+    EXPECT_EQ(seen_.size(), 2u);
+    push(0xfeed0002);
+  }
+  push(0xfeed0002);
+  EXPECT_EQ(seen_, (std::vector<std::uint64_t>(4, 0xfeed0002)));
+  FfiClient::instance().RemoveListener(id);
+}
+
+TEST_F(HandleListenerTest, UnclaimedEventsAreDroppedWithTheLastHold) {
+  {
+    auto outer = FfiClient::instance().holdHandleEvents(kVideoEvent);
+    {
+      auto inner = FfiClient::instance().holdHandleEvents(kVideoEvent);
+      push(0xfeed0003);
+    }
+    // `outer` still holds, so the event is still there to claim.
+    const auto id = listen(0xfeed0003);
+    EXPECT_EQ(seen_.size(), 1u);
+    FfiClient::instance().RemoveListener(id);
+    push(0xfeed0004);
+  }
+  const auto id = listen(0xfeed0004);
+  EXPECT_EQ(seen_.size(), 1u);
+  FfiClient::instance().RemoveListener(id);
+}
+
+TEST_F(HandleListenerTest, HoldKeepsABoundedBacklogPerHandle) {
+  FfiClient::ListenerId id = 0;
+  {
+    auto hold = FfiClient::instance().holdHandleEvents(kVideoEvent);
+    for (int i = 0; i < 1000; ++i) {
+      push(0xfeed0005);
+    }
+    id = listen(0xfeed0005);
+  }
+  EXPECT_GT(seen_.size(), 0u);
+  EXPECT_LT(seen_.size(), 1000u);
+  FfiClient::instance().RemoveListener(id);
+}
+
+} // namespace test
+} // namespace livekit
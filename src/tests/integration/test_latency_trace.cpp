@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "latency_trace.h"
+#include "sdk_metrics.h"
+
+#include <chrono>
+#include <string>
+
+namespace livekit {
+namespace test {
+
+using detail::LatencyTracer;
+using detail::TraceClock;
+
+class LatencyTraceTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    resetLatencyTrace();
+    setLatencyTracingEnabled(true);
+  }
+  void TearDown() override {
+    setLatencyTracingEnabled(false);
+    resetLatencyTrace();
+  }
+};
+
+TEST_F(LatencyTraceTest, SpansAreInertWhileDisabled) {
+  setLatencyTracingEnabled(false);
+  { detail::TraceSpan span(TraceMedia::kVideo, TraceStage::kCapture); }
+  EXPECT_EQ(latencyTraceReport().at(TraceMedia::kVideo, TraceStage::kCapture)
+                .count,
+            0u);
+
+  setLatencyTracingEnabled(true);
+  { detail::TraceSpan span(TraceMedia::kVideo, TraceStage::kCapture); }
+  EXPECT_EQ(latencyTraceReport().at(TraceMedia::kVideo, TraceStage::kCapture)
+                .count,
+            1u);
+}
+
+TEST_F(LatencyTraceTest, HistogramsPerMediaAndStage) {
+  auto &tracer = LatencyTracer::instance();
+  const auto t0 = TraceClock::now();
+  tracer.record(TraceMedia::kVideo, TraceStage::kReceiveQueue, t0,
+                t0 + std::chrono::milliseconds(4), 1000);
+  tracer.record(TraceMedia::kVideo, TraceStage::kReceiveQueue, t0,
+                t0 + std::chrono::milliseconds(8), 2000);
+  tracer.record(TraceMedia::kAudio, TraceStage::kReceiveTotal, t0,
+                t0 + std::chrono::milliseconds(1));
+
+  const LatencyTraceReport report = latencyTraceReport();
+  const auto &queue = report.at(TraceMedia::kVideo, TraceStage::kReceiveQueue);
+  EXPECT_EQ(queue.count, 2u);
+  EXPECT_EQ(queue.total, std::chrono::microseconds(12000));
+  EXPECT_EQ(report.at(TraceMedia::kAudio, TraceStage::kReceiveTotal).count,
+            1u);
+  EXPECT_EQ(report.at(TraceMedia::kAudio, TraceStage::kReceiveQueue).count,
+            0u);
+
+  const std::string text = detail::renderOpenMetrics(
+      detail::SdkMetrics::instance(), RpcMetrics{}, detail::ScrapeGauges{},
+      &report);
+  EXPECT_NE(text.find("livekit_media_stage_duration_seconds_count{kind="
+                      "\"video\",stage=\"receive_queue\"} 2\n"),
+            std::string::npos);
+  EXPECT_EQ(text.find("stage=\"capture\""), std::string::npos)
+      << "stages without samples are not rendered";
+}
+
+TEST_F(LatencyTraceTest, ChromeJsonHoldsRecentSpans) {
+  auto &tracer = LatencyTracer::instance();
+  const auto t0 = TraceClock::now();
+  for (std::size_t i = 0; i < LatencyTracer::kMaxSpans + 2; ++i) {
+    tracer.record(TraceMedia::kVideo, TraceStage::kCapture, t0,
+                  t0 + std::chrono::microseconds(10),
+                  static_cast<std::int64_t>(i + 1));
+  }
+  tracer.record(TraceMedia::kAudio, TraceStage::kCaptureQueue, t0,
+                t0 + std::chrono::microseconds(5));
+
+  const std::string json = latencyTraceToChromeJson();
+  EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0),
+            0u);
+  EXPECT_EQ(json.substr(json.size() - 2), "]}");
+  // The three oldest spans were overwritten.
+  EXPECT_EQ(json.find("\"frame_timestamp_us\":3}"), std::string::npos);
+  EXPECT_NE(json.find("\"frame_timestamp_us\":4}"), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"video.capture\",\"cat\":\"livekit\","
+                      "\"ph\":\"X\""),
+            std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"audio.capture_queue\""), std::string::npos);
+  EXPECT_NE(json.find("\"dur\":5}"), std::string::npos);
+
+  resetLatencyTrace();
+  EXPECT_EQ(latencyTraceToChromeJson(),
+            "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}");
+}
+
+} // namespace test
+} // namespace livekit
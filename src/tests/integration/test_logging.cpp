@@ -0,0 +1,140 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "livekit/logging.h"
+#include "log.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace {
+
+class LoggingTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    LogOptions options;
+    options.console = false;
+    configureLogging(options);
+    output_id_ = addLogOutput([this](const LogRecord &record) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      messages_.emplace_back(record.message);
+      targets_.emplace_back(record.target);
+    });
+  }
+
+  void TearDown() override {
+    flushLogs();
+    removeLogOutput(output_id_);
+  }
+
+  std::vector<std::string> messages() {
+    flushLogs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return messages_;
+  }
+
+  int output_id_ = 0;
+  std::mutex mutex_;
+  std::vector<std::string> messages_;
+  std::vector<std::string> targets_;
+};
+
+TEST_F(LoggingTest, DeliversFormattedRecordsAtOrAboveLevel) {
+  LK_LOG_WARN("livekit::test", "value=%d", 42);
+  LK_LOG_DEBUG("livekit::test", "hidden");
+  EXPECT_EQ(messages(), std::vector<std::string>{"value=42"});
+}
+
+TEST_F(LoggingTest, TargetOverrideUsesLongestPrefix) {
+  LogOptions options;
+  options.console = false;
+  options.level = LogLevel::kWarn;
+  options.targets = {{"livekit::rtc", LogLevel::kDebug},
+                     {"livekit::rtc::quiet", LogLevel::kError}};
+  configureLogging(options);
+
+  LK_LOG_DEBUG("livekit::rtc::engine", "engine");
+  LK_LOG_WARN("livekit::rtc::quiet", "quiet");
+  LK_LOG_INFO("livekit::other", "other");
+  LK_LOG_ERROR("livekit::rtc::quiet", "loud");
+  EXPECT_EQ(messages(), (std::vector<std::string>{"engine", "loud"}));
+}
+
+TEST_F(LoggingTest, SetLogLevelOff) {
+  setLogLevel(LogLevel::kOff);
+  EXPECT_EQ(logLevel(), LogLevel::kOff);
+  EXPECT_FALSE(detail::logEnabled(LogLevel::kError));
+  LK_LOG_ERROR("livekit::test", "nothing");
+  EXPECT_TRUE(messages().empty());
+}
+
+TEST_F(LoggingTest, ConcurrentProducersAreAllAccountedFor) {
+  const LogStats before = logStats();
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 500;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        LK_LOG_INFO("livekit::test", "t%d i%d", t, i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const auto received = messages().size();
+  const LogStats after = logStats();
+  EXPECT_EQ(received + (after.dropped - before.dropped),
+            static_cast<std::size_t>(kThreads * kPerThread));
+  EXPECT_GT(received, 0u);
+}
+
+TEST_F(LoggingTest, ThrowingOutputDoesNotStopPipeline) {
+  const int bad = addLogOutput(
+      [](const LogRecord &) { throw std::runtime_error("output failed"); });
+  LK_LOG_WARN("livekit::test", "first");
+  LK_LOG_WARN("livekit::test", "second");
+  EXPECT_EQ(messages(), (std::vector<std::string>{"first", "second"}));
+  removeLogOutput(bad);
+}
+
+TEST_F(LoggingTest, LongMessagesAreTruncated) {
+  const std::string long_text(2000, 'x');
+  LK_LOG_WARN("livekit::test", "%s", long_text.c_str());
+  const auto got = messages();
+  ASSERT_EQ(got.size(), 1u);
+  EXPECT_LT(got[0].size(), long_text.size());
+  EXPECT_EQ(got[0], std::string(got[0].size(), 'x'));
+}
+
+TEST(LoggingFilterTest, RustLogFilterListsTargets) {
+  LogOptions options;
+  options.level = LogLevel::kWarn;
+  options.targets = {{"livekit", LogLevel::kDebug},
+                     {"libwebrtc", LogLevel::kOff}};
+  EXPECT_EQ(detail::rustLogFilter(options),
+            "warn,livekit=debug,libwebrtc=off");
+}
+
+} // namespace
+} // namespace livekit
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mapped_file.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+std::string writeTempFile(const std::vector<char> &contents) {
+  const std::string path =
+      ::testing::TempDir() + "livekit_mapped_file_test.bin";
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  return path;
+}
+
+} // namespace
+
+TEST(MappedFileTest, MapsContentsAndSurvivesRelease) {
+  std::vector<char> contents(3 * 1024 * 1024 + 17);
+  for (std::size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<char>(i * 31);
+  }
+  const std::string path = writeTempFile(contents);
+  {
+    detail::MappedFile file(path);
+    ASSERT_EQ(file.size(), contents.size());
+    ASSERT_EQ(std::memcmp(file.data(), contents.data(), contents.size()), 0);
+
+    // Released ranges are re-read from the file on the next access.
+    file.release(0, file.size() / 2);
+    file.release(file.size() / 2, file.size());
+    EXPECT_EQ(std::memcmp(file.data(), contents.data(), contents.size()), 0);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, EmptyAndMissingFiles) {
+  const std::string path = writeTempFile({});
+  {
+    detail::MappedFile file(path);
+    EXPECT_EQ(file.size(), 0u);
+    EXPECT_EQ(file.data(), nullptr);
+    file.release(0, 100);
+  }
+  std::remove(path.c_str());
+  EXPECT_THROW(detail::MappedFile("/nonexistent/livekit/file"),
+               std::runtime_error);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/media_clock.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+TEST(MediaClockTest, TicksInOrderOnAbsoluteDeadlines) {
+  MediaClock clock;
+  std::mutex mutex;
+  std::vector<std::uint64_t> ticks;
+  std::vector<Clock::time_point> times;
+  const auto started = Clock::now();
+  auto pacer = clock.schedule(10ms, [&](std::uint64_t tick) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ticks.push_back(tick);
+    times.push_back(Clock::now());
+  });
+  std::this_thread::sleep_for(205ms);
+  pacer.stop();
+  EXPECT_FALSE(pacer.active());
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_GE(ticks.size(), 15u);
+  EXPECT_LE(ticks.size(), 22u);
+  for (std::size_t i = 0; i < ticks.size(); ++i) {
+    EXPECT_EQ(ticks[i], i);
+    // Never early.
+    EXPECT_GE(times[i] - started, 10ms * static_cast<int>(i));
+  }
+  // Stats stay readable after stop().
+  const PacerStats stats = pacer.stats();
+  EXPECT_EQ(stats.ticks, ticks.size());
+  EXPECT_EQ(stats.missed_ticks, 0u);
+  EXPECT_EQ(stats.lateness.count, ticks.size());
+}
+
+TEST(MediaClockTest, ManyPacersShareOneThread) {
+  MediaClock clock;
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::atomic<int> calls{0};
+  std::vector<MediaClock::Pacer> pacers;
+  for (int i = 0; i < 100; ++i) {
+    pacers.push_back(clock.schedule(5ms, [&](std::uint64_t) {
+      std::lock_guard<std::mutex> lock(mutex);
+      threads.insert(std::this_thread::get_id());
+      ++calls;
+    }));
+  }
+  EXPECT_EQ(clock.activePacers(), 100u);
+  std::this_thread::sleep_for(50ms);
+  const PacerStats stats = pacers.front().stats();
+  EXPECT_GE(stats.ticks, 1u);
+  EXPECT_EQ(stats.lateness.count, stats.ticks);
+  pacers.clear();
+  EXPECT_EQ(clock.activePacers(), 0u);
+
+  EXPECT_GE(calls.load(), 100 * 5);
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(threads.size(), 1u);
+  EXPECT_EQ(threads.count(std::this_thread::get_id()), 0u);
+}
+
+TEST(MediaClockTest, StopWaitsForRunningCallback) {
+  MediaClock clock;
+  std::atomic<bool> entered{false};
+  std::atomic<bool> finished{false};
+  auto pacer = clock.schedule(1s, [&](std::uint64_t) {
+    entered = true;
+    std::this_thread::sleep_for(50ms);
+    finished = true;
+  });
+  while (!entered) {
+    std::this_thread::yield();
+  }
+  pacer.stop();
+  EXPECT_TRUE(finished.load());
+}
+
+TEST(MediaClockTest, StopFromOwnCallback) {
+  MediaClock clock;
+  std::atomic<int> calls{0};
+  MediaClock::Pacer pacer;
+  std::atomic<bool> ready{false};
+  pacer = clock.schedule(2ms, [&](std::uint64_t tick) {
+    ++calls;
+    if (tick == 2 && ready) {
+      pacer.stop();
+    }
+  });
+  ready = true;
+  std::this_thread::sleep_for(60ms);
+  EXPECT_FALSE(pacer.active());
+  EXPECT_LE(calls.load(), 3);
+  EXPECT_EQ(clock.activePacers(), 0u);
+}
+
+TEST(MediaClockTest, SkipMissedJumpsAheadCatchUpDoesNot) {
+  MediaClock clock;
+  std::mutex mutex;
+  std::vector<std::uint64_t> skipping;
+  std::vector<std::uint64_t> catching_up;
+  auto stall = [](std::uint64_t tick) {
+    if (tick == 0) {
+      std::this_thread::sleep_for(55ms);
+    }
+  };
+  MediaClock::PacerOptions skip;
+  skip.skip_missed = true;
+  auto a = clock.schedule(
+      10ms,
+      [&](std::uint64_t tick) {
+        stall(tick);
+        std::lock_guard<std::mutex> lock(mutex);
+        skipping.push_back(tick);
+      },
+      skip);
+  std::this_thread::sleep_for(100ms);
+  const PacerStats skipped = a.stats();
+  a.stop();
+
+  auto b = clock.schedule(10ms, [&](std::uint64_t tick) {
+    stall(tick);
+    std::lock_guard<std::mutex> lock(mutex);
+    catching_up.push_back(tick);
+  });
+  std::this_thread::sleep_for(100ms);
+  const PacerStats caught_up = b.stats();
+  b.stop();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_GE(skipping.size(), 2u);
+  EXPECT_GE(skipping[1], 5u);
+  EXPECT_GE(skipped.missed_ticks, 4u);
+  ASSERT_GE(catching_up.size(), 6u);
+  for (std::size_t i = 0; i < catching_up.size(); ++i) {
+    EXPECT_EQ(catching_up[i], i);
+  }
+  EXPECT_EQ(caught_up.missed_ticks, 0u);
+}
+
+TEST(MediaClockTest, FramePacerHoldsTheRate) {
+  FramePacer pacer(5ms);
+  const auto started = Clock::now();
+  for (std::uint64_t i = 1; i <= 20; ++i) {
+    EXPECT_EQ(pacer.wait(), i);
+  }
+  const auto elapsed = Clock::now() - started;
+  EXPECT_GE(elapsed, 100ms);
+  EXPECT_LT(elapsed, 150ms);
+  EXPECT_EQ(pacer.stats().ticks, 20u);
+  EXPECT_EQ(pacer.stats().lateness.count, 20u);
+
+  // A stall longer than a period is skipped when asked to.
+  FramePacer skipping(5ms, /*skip_missed=*/true);
+  std::this_thread::sleep_for(23ms);
+  EXPECT_GE(skipping.wait(), 4u);
+  EXPECT_GE(skipping.stats().missed_ticks, 3u);
+}
+
+TEST(MediaClockTest, RejectsBadArguments) {
+  MediaClock clock;
+  EXPECT_THROW(clock.schedule(0ms, [](std::uint64_t) {}),
+               std::invalid_argument);
+  EXPECT_THROW(clock.schedule(10ms, nullptr), std::invalid_argument);
+  EXPECT_THROW(FramePacer(0ms), std::invalid_argument);
+  EXPECT_THROW(MediaClock::framePeriod(0), std::invalid_argument);
+  EXPECT_EQ(MediaClock::framePeriod(30), std::chrono::nanoseconds(33333333));
+}
+
+} // namespace test
+} // namespace livekit
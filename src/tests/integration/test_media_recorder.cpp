@@ -0,0 +1,221 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/audio_frame.h>
+#include <livekit/media_recorder.h>
+#include <livekit/video_frame.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+std::vector<std::uint8_t> readFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(in), {});
+}
+
+std::uint32_t getU32(const std::vector<std::uint8_t> &b, std::size_t at) {
+  return static_cast<std::uint32_t>(b[at]) |
+         static_cast<std::uint32_t>(b[at + 1]) << 8 |
+         static_cast<std::uint32_t>(b[at + 2]) << 16 |
+         static_cast<std::uint32_t>(b[at + 3]) << 24;
+}
+
+// 10 ms frame whose samples count up from `first`.
+AudioFrame rampFrame(int sample_rate, int channels, int first) {
+  const int spc = sample_rate / 100;
+  std::vector<std::int16_t> data(static_cast<std::size_t>(spc * channels));
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::int16_t>(first + static_cast<int>(i));
+  }
+  return AudioFrame(std::move(data), sample_rate, channels, spc);
+}
+
+VideoFrame filledI420(int width, int height, std::uint8_t luma) {
+  VideoFrame frame = VideoFrame::create(width, height, VideoBufferType::I420);
+  std::memset(frame.data(), luma, static_cast<std::size_t>(width * height));
+  return frame;
+}
+
+// Number of frames in a Y4M file and the header line.
+std::size_t countY4mFrames(const std::vector<std::uint8_t> &file,
+                           std::size_t frame_bytes, std::string *header) {
+  const auto *begin = reinterpret_cast<const char *>(file.data());
+  const std::string text(begin, file.size());
+  const std::size_t eol = text.find('\n');
+  if (eol == std::string::npos) {
+    return 0;
+  }
+  *header = text.substr(0, eol);
+  std::size_t at = eol + 1;
+  std::size_t frames = 0;
+  while (at < text.size()) {
+    if (text.compare(at, 6, "FRAME\n") != 0) {
+      ADD_FAILURE() << "missing FRAME marker at " << at;
+      return frames;
+    }
+    at += 6 + frame_bytes;
+    ++frames;
+  }
+  EXPECT_EQ(at, text.size());
+  return frames;
+}
+
+} // namespace
+
+TEST(MediaRecorderTest, AudioWritesWavWithPatchedSizes) {
+  const std::string path = ::testing::TempDir() + "rec_audio.wav";
+  {
+    AudioRecorder recorder(path);
+    for (int i = 0; i < 50; ++i) {
+      ASSERT_TRUE(recorder.push(rampFrame(48000, 2, i * 960)));
+    }
+    recorder.close();
+    const MediaRecorderStats stats = recorder.stats();
+    EXPECT_EQ(stats.frames_written, 50u);
+    EXPECT_EQ(stats.frames_dropped, 0u);
+    EXPECT_EQ(stats.write_errors, 0u);
+  }
+  const std::vector<std::uint8_t> file = readFile(path);
+  const std::uint32_t data_bytes = 50 * 960 * 2;
+  ASSERT_EQ(file.size(), 44u + data_bytes);
+  EXPECT_EQ(std::memcmp(file.data(), "RIFF", 4), 0);
+  EXPECT_EQ(getU32(file, 4), 36u + data_bytes);
+  EXPECT_EQ(std::memcmp(file.data() + 8, "WAVEfmt ", 8), 0);
+  EXPECT_EQ(getU32(file, 24), 48000u);
+  EXPECT_EQ(file[22], 2);
+  EXPECT_EQ(getU32(file, 40), data_bytes);
+
+  // Samples land in push order.
+  for (std::uint32_t i = 0; i < data_bytes / 2; i += 997) {
+    const auto v = static_cast<std::int16_t>(file[44 + 2 * i] |
+                                             file[45 + 2 * i] << 8);
+    EXPECT_EQ(v, static_cast<std::int16_t>(i));
+  }
+}
+
+TEST(MediaRecorderTest, AudioFormatChangeIsDropped) {
+  const std::string path = ::testing::TempDir() + "rec_format.wav";
+  AudioRecorder recorder(path);
+  recorder.push(rampFrame(16000, 1, 0));
+  recorder.push(rampFrame(48000, 1, 0));
+  recorder.push(rampFrame(16000, 1, 160));
+  recorder.close();
+  EXPECT_EQ(recorder.stats().frames_written, 2u);
+  EXPECT_EQ(recorder.stats().frames_dropped, 1u);
+  EXPECT_EQ(readFile(path).size(), 44u + 2 * 160 * 2);
+}
+
+TEST(MediaRecorderTest, FullQueueDropsInsteadOfBlocking) {
+  const std::string path = ::testing::TempDir() + "rec_queue.wav";
+  AudioRecorder::Options options;
+  options.queue_frames = 1;
+  AudioRecorder recorder(path, options);
+  int accepted = 0;
+  for (int i = 0; i < 2000; ++i) {
+    accepted += recorder.push(rampFrame(48000, 1, 0)) ? 1 : 0;
+  }
+  recorder.close();
+  EXPECT_FALSE(recorder.push(rampFrame(48000, 1, 0)));
+
+  const MediaRecorderStats stats = recorder.stats();
+  EXPECT_EQ(stats.frames_written, static_cast<std::uint64_t>(accepted));
+  EXPECT_EQ(stats.frames_written + stats.frames_dropped, 2001u);
+  EXPECT_LE(stats.max_queue_depth, 1u);
+  EXPECT_EQ(stats.bytes_written, 44u + stats.frames_written * 480 * 2);
+}
+
+TEST(MediaRecorderTest, VideoWritesOneFramePerSlot) {
+  const std::string path = ::testing::TempDir() + "rec_video.y4m";
+  VideoRecorder::Options options;
+  options.fps = 10;
+  VideoRecorder recorder(path, options);
+  // 100 ms apart: one slot each.
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(recorder.push(filledI420(16, 8, 10), i * 100000));
+  }
+  recorder.close();
+  EXPECT_EQ(recorder.stats().frames_written, 5u);
+
+  std::string header;
+  EXPECT_EQ(countY4mFrames(readFile(path), 16 * 8 * 3 / 2, &header), 5u);
+  EXPECT_EQ(header, "YUV4MPEG2 W16 H8 F10:1 Ip A1:1 C420jpeg");
+}
+
+TEST(MediaRecorderTest, VideoFillsGapsAndSupersedesWithinASlot) {
+  const std::string path = ::testing::TempDir() + "rec_cfr.y4m";
+  VideoRecorder::Options options;
+  options.fps = 10;
+  VideoRecorder recorder(path, options);
+  recorder.push(filledI420(4, 4, 1), 0);
+  recorder.push(filledI420(4, 4, 2), 300000); // frame 1 covers 3 slots
+  recorder.push(filledI420(4, 4, 3), 320000); // supersedes frame 2
+  recorder.push(filledI420(4, 4, 4), 400000);
+  recorder.close();
+
+  const std::vector<std::uint8_t> file = readFile(path);
+  std::string header;
+  ASSERT_EQ(countY4mFrames(file, 24, &header), 5u);
+  const std::size_t first = header.size() + 1 + 6;
+  const std::uint8_t expected[] = {1, 1, 1, 3, 4};
+  for (std::size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(file[first + i * (6 + 24)], expected[i]) << "slot " << i;
+  }
+  EXPECT_EQ(recorder.stats().frames_written, 3u);
+}
+
+TEST(MediaRecorderTest, VideoScalesAndConvertsToOutputSize) {
+  const std::string path = ::testing::TempDir() + "rec_scale.y4m";
+  VideoRecorder::Options options;
+  options.width = 8;
+  options.height = 4;
+  options.constant_frame_rate = false;
+  VideoRecorder recorder(path, options);
+  recorder.push(filledI420(16, 8, 200), 0);
+  recorder.push(VideoFrame::create(8, 4, VideoBufferType::RGBA), 1);
+  recorder.push(VideoFrame::create(32, 16, VideoBufferType::RGBA), 2);
+  recorder.close();
+
+  std::string header;
+  EXPECT_EQ(countY4mFrames(readFile(path), 8 * 4 * 3 / 2, &header), 3u);
+  EXPECT_EQ(header, "YUV4MPEG2 W8 H4 F30:1 Ip A1:1 C420jpeg");
+  EXPECT_EQ(recorder.stats().frames_written, 3u);
+}
+
+TEST(MediaRecorderTest, RejectsBadArguments) {
+  EXPECT_THROW(AudioRecorder("/nonexistent-dir/x.wav"), std::runtime_error);
+  VideoRecorder::Options options;
+  options.width = 640;
+  EXPECT_THROW(VideoRecorder(::testing::TempDir() + "bad.y4m", options),
+               std::invalid_argument);
+  options = VideoRecorder::Options{};
+  options.fps = 0;
+  EXPECT_THROW(VideoRecorder(::testing::TempDir() + "bad.y4m", options),
+               std::invalid_argument);
+}
+
+} // namespace test
+} // namespace livekit
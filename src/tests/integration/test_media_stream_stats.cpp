@@ -0,0 +1,65 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "media_stream_stats.h"
+
+#include <chrono>
+
+namespace livekit {
+namespace test {
+
+using detail::MediaStreamStatsRecorder;
+using Clock = MediaStreamStatsRecorder::Clock;
+
+TEST(MediaStreamStatsTest, CountsFramesThroughTheQueue) {
+  MediaStreamStatsRecorder recorder;
+  const auto t0 = Clock::now();
+
+  // Three frames into a capacity-2 queue: the first one is evicted.
+  for (std::size_t depth : {1u, 2u, 2u}) {
+    recorder.onReceived();
+    recorder.onQueued(depth);
+  }
+  recorder.onEvicted();
+  recorder.onDelivered(t0, t0 + std::chrono::milliseconds(5));
+  recorder.onDelivered(t0, t0 + std::chrono::milliseconds(20));
+
+  const MediaStreamStats stats = recorder.snapshot(0, 0);
+  EXPECT_EQ(stats.frames_received, 3u);
+  EXPECT_EQ(stats.frames_delivered, 2u);
+  EXPECT_EQ(stats.frames_dropped, 1u);
+  EXPECT_EQ(stats.max_queue_depth, 2u);
+  EXPECT_EQ(stats.queue_time.count, 2u);
+  EXPECT_NEAR(static_cast<double>(stats.queue_time.max.count()), 20000.0,
+              20000.0 / 16);
+}
+
+TEST(MediaStreamStatsTest, RingDropsAndPushModeDelivery) {
+  MediaStreamStatsRecorder recorder;
+  recorder.onReceived();
+  recorder.onDelivered();
+
+  const MediaStreamStats stats = recorder.snapshot(3, 7);
+  EXPECT_EQ(stats.frames_delivered, 1u);
+  EXPECT_EQ(stats.frames_dropped, 7u);
+  EXPECT_EQ(stats.queue_depth, 3u);
+  EXPECT_EQ(stats.queue_time.count, 0u);
+}
+
+} // namespace test
+} // namespace livekit
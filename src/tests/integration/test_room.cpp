@@ -17,6 +17,8 @@
 #include <gtest/gtest.h>
 #include <livekit/livekit.h>
 
+#include <thread>
+
 namespace livekit {
 namespace test {
 
@@ -44,6 +46,7 @@ TEST_F(RoomTest, RoomOptionsDefaults) {
       << "rtc_config should not have a value by default";
   EXPECT_FALSE(options.encryption.has_value())
       << "encryption should not have a value by default";
+  EXPECT_FALSE(options.fast_resume) << "fast_resume should default to false";
 }
 
 TEST_F(RoomTest, RtcConfigDefaults) {
@@ -97,6 +100,102 @@ TEST_F(RoomTest, RemoteParticipantLookupBeforeConnect) {
       << "Looking up participant before connect should return nullptr";
 }
 
+TEST_F(RoomTest, ParticipantSnapshotBeforeConnect) {
+  Room room;
+  auto snapshot = room.remoteParticipantsSnapshot();
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_TRUE(snapshot->participants.empty());
+  EXPECT_EQ(snapshot->find("nonexistent"), nullptr);
+  EXPECT_EQ(snapshot->version, 0u);
+  // Nothing changed, so the same snapshot is handed out again.
+  EXPECT_EQ(room.remoteParticipantsSnapshot(), snapshot);
+}
+
+TEST_F(RoomTest, UnconnectedRoomsAreCheap) {
+  // What one idle Room costs a process hosting thousands of them: the
+  // object itself, with the empty participant snapshot shared.
+  EXPECT_LE(sizeof(Room), 1024u);
+
+  std::vector<std::unique_ptr<Room>> rooms;
+  for (int i = 0; i < 1000; ++i) {
+    rooms.push_back(std::make_unique<Room>());
+  }
+  const auto shared = rooms.front()->remoteParticipantsSnapshot();
+  for (const auto &room : rooms) {
+    EXPECT_EQ(room->remoteParticipantsSnapshot(), shared);
+  }
+}
+
+TEST_F(RoomTest, ReconnectStatsBeforeConnect) {
+  Room room;
+  const ReconnectStats stats = room.reconnectStats();
+  EXPECT_EQ(stats.attempts, 0u);
+  EXPECT_EQ(stats.completed, 0u);
+  EXPECT_EQ(stats.failed, 0u);
+  EXPECT_EQ(stats.total.count(), 0);
+  EXPECT_FALSE(stats.reconnecting);
+}
+
+TEST_F(RoomTest, LocalPublicationsReadableFromAnyThread) {
+  LocalParticipant local(FfiHandle(0), "PA_local", "local", "local", "", {},
+                         ParticipantKind::Standard, DisconnectReason::Unknown);
+  const auto snapshot = local.trackPublicationsSnapshot();
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_TRUE(snapshot->empty());
+  EXPECT_EQ(local.trackPublication("TR_missing"), nullptr);
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&local, &snapshot] {
+      for (int n = 0; n < 1000; ++n) {
+        // Nothing was published, so every reader sees the same map.
+        EXPECT_EQ(local.trackPublicationsSnapshot(), snapshot);
+      }
+    });
+  }
+  for (auto &t : readers) {
+    t.join();
+  }
+
+  std::vector<std::pair<std::shared_ptr<Track>, TrackPublishOptions>> tracks;
+  tracks.emplace_back(nullptr, TrackPublishOptions{});
+  EXPECT_THROW(local.publishTracks(tracks), std::invalid_argument);
+  EXPECT_THROW(local.unpublishTracks({"TR_a"}), std::runtime_error);
+}
+
+TEST_F(RoomTest, SessionStatsRequireConnection) {
+  Room room;
+  EXPECT_THROW(room.getSessionStatsAsync(), std::runtime_error);
+}
+
+TEST_F(RoomTest, DelegateInterestMask) {
+  class ChatDelegate : public RoomDelegate {
+  public:
+    RoomEventMask interestedEvents() const override {
+      return RoomEventType::kParticipantConnected |
+             RoomEventType::kParticipantDisconnected |
+             RoomEventType::kUserPacketReceived;
+    }
+  };
+
+  RoomDelegate all;
+  EXPECT_EQ(all.interestedEvents(), kAllRoomEvents);
+
+  ChatDelegate chat;
+  const RoomEventMask mask = chat.interestedEvents();
+  EXPECT_NE(mask & static_cast<RoomEventMask>(
+                       RoomEventType::kUserPacketReceived),
+            0u);
+  EXPECT_EQ(mask & static_cast<RoomEventMask>(
+                       RoomEventType::kActiveSpeakersChanged),
+            0u);
+  EXPECT_EQ(mask & ~kAllRoomEvents, 0u);
+
+  Room room;
+  room.setDelegate(&chat);
+  room.setDelegate(nullptr);
+}
+
 // Server-dependent tests - require LIVEKIT_URL and LIVEKIT_TOKEN env vars
 class RoomServerTest : public ::testing::Test {
 protected:
@@ -138,6 +237,128 @@ TEST_F(RoomServerTest, ConnectToServer) {
   }
 }
 
+TEST_F(RoomServerTest, SessionStatsInOneCall) {
+  if (!server_available_) {
+    GTEST_SKIP() << "LIVEKIT_URL and LIVEKIT_TOKEN not set, skipping session "
+                    "stats test";
+  }
+
+  Room room;
+  RoomOptions options;
+  ASSERT_TRUE(room.Connect(server_url_, token_, options));
+
+  SessionStats stats = room.getSessionStatsAsync().get();
+  EXPECT_TRUE(stats.subscriber.peer_connection.has_value() ||
+              stats.publisher.peer_connection.has_value());
+  EXPECT_TRUE(stats.publisher.other.empty());
+  EXPECT_TRUE(stats.subscriber.other.empty());
+}
+
+TEST_F(RoomServerTest, ConnectWithFastResume) {
+  if (!server_available_) {
+    GTEST_SKIP() << "LIVEKIT_URL and LIVEKIT_TOKEN not set, skipping fast "
+                    "resume test";
+  }
+
+  Room room;
+  RoomOptions options;
+  options.fast_resume = true;
+  ASSERT_TRUE(room.Connect(server_url_, token_, options));
+  EXPECT_EQ(room.reconnectStats().attempts, 0u);
+}
+
+TEST_F(RoomServerTest, PublishTracksInOneBatch) {
+  if (!server_available_) {
+    GTEST_SKIP() << "LIVEKIT_URL and LIVEKIT_TOKEN not set, skipping bulk "
+                    "publish test";
+  }
+
+  Room room;
+  ASSERT_TRUE(room.Connect(server_url_, token_, {}));
+  LocalParticipant *local = room.localParticipant();
+  ASSERT_NE(local, nullptr);
+
+  std::vector<std::pair<std::shared_ptr<Track>, TrackPublishOptions>> tracks;
+  for (int i = 0; i < 3; ++i) {
+    auto source = std::make_shared<VideoSource>(320, 240);
+    TrackPublishOptions options;
+    options.source = TrackSource::SOURCE_CAMERA;
+    tracks.emplace_back(LocalVideoTrack::createLocalVideoTrack(
+                            "cam-" + std::to_string(i), source),
+                        options);
+  }
+  auto audio = std::make_shared<AudioSource>(48000, 1);
+  TrackPublishOptions mic;
+  mic.source = TrackSource::SOURCE_MICROPHONE;
+  tracks.emplace_back(LocalAudioTrack::createLocalAudioTrack("mic", audio),
+                      mic);
+
+  const auto results = local->publishTracks(tracks);
+  ASSERT_EQ(results.size(), tracks.size());
+  std::vector<std::string> sids;
+  for (const auto &result : results) {
+    ASSERT_TRUE(result.ok()) << result.error;
+    EXPECT_EQ(local->trackPublications().count(result.publication->sid()),
+              1u);
+    sids.push_back(result.publication->sid());
+  }
+
+  sids.push_back("TR_unknown");
+  const auto removed = local->unpublishTracks(sids);
+  ASSERT_EQ(removed.size(), sids.size());
+  for (std::size_t i = 0; i + 1 < removed.size(); ++i) {
+    EXPECT_TRUE(removed[i].ok()) << removed[i].error;
+    EXPECT_EQ(local->trackPublications().count(sids[i]), 0u);
+  }
+  EXPECT_EQ(removed.back().track_sid, "TR_unknown");
+}
+
+TEST_F(RoomServerTest, RotateSharedKeyWithoutGap) {
+  if (!server_available_) {
+    GTEST_SKIP() << "LIVEKIT_URL and LIVEKIT_TOKEN not set, skipping key "
+                    "rotation test";
+  }
+
+  RoomOptions options;
+  E2EEOptions e2ee;
+  e2ee.key_provider_options.shared_key =
+      std::vector<std::uint8_t>(32, std::uint8_t{7});
+  options.encryption = e2ee;
+  Room room;
+  ASSERT_TRUE(room.Connect(server_url_, token_, options));
+  E2EEManager *manager = room.e2eeManager();
+  ASSERT_NE(manager, nullptr);
+
+  EXPECT_THROW(manager->rotateKeyNow(), std::runtime_error);
+  KeyRotationOptions bad;
+  bad.key_slots = kKeyRingSize + 1;
+  EXPECT_THROW(manager->startKeyRotation(bad), std::invalid_argument);
+
+  KeyRotationOptions rotation;
+  rotation.activation_delay = std::chrono::hours(1);
+  manager->startKeyRotation(rotation);
+  manager->rotateKeyNow();
+  auto waitFor = [manager](auto done) {
+    for (int i = 0; i < 200 && !done(manager->keyRotationStats()); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return done(manager->keyRotationStats());
+  };
+  ASSERT_TRUE(waitFor([](const KeyRotationStats &s) {
+    return s.pending_key_index.has_value();
+  }));
+  EXPECT_EQ(*manager->keyRotationStats().pending_key_index, 1);
+  // The old key stays active until the pending one is activated.
+  EXPECT_EQ(manager->keyRotationStats().active_key_index, 0);
+
+  manager->activatePendingKey();
+  ASSERT_TRUE(waitFor(
+      [](const KeyRotationStats &s) { return s.rotations == 1; }));
+  EXPECT_EQ(manager->keyRotationStats().active_key_index, 1);
+  EXPECT_EQ(manager->keyRotationStats().errors, 0u);
+  manager->stopKeyRotation();
+}
+
 TEST_F(RoomServerTest, ConnectWithInvalidToken) {
   if (!server_available_) {
     GTEST_SKIP() << "LIVEKIT_URL not set, skipping invalid token test";
@@ -150,6 +371,37 @@ TEST_F(RoomServerTest, ConnectWithInvalidToken) {
   EXPECT_FALSE(connected) << "Should fail to connect with invalid token";
 }
 
+TEST_F(RoomServerTest, ConnectAsyncInParallel) {
+  if (!server_available_) {
+    GTEST_SKIP() << "LIVEKIT_URL and LIVEKIT_TOKEN not set, skipping "
+                    "parallel connect test";
+  }
+
+  constexpr int kRooms = 3;
+  std::vector<std::unique_ptr<Room>> rooms;
+  std::vector<AsyncOperation<ConnectResult>> ops;
+  for (int i = 0; i < kRooms; ++i) {
+    rooms.push_back(std::make_unique<Room>());
+    ops.push_back(rooms.back()->connectAsync(server_url_, token_, {}));
+  }
+  for (int i = 0; i < kRooms; ++i) {
+    ConnectResult result = ops[i].get();
+    // The same token may be refused for a second concurrent session.
+    if (!result.connected) {
+      EXPECT_FALSE(result.error.empty());
+      continue;
+    }
+    EXPECT_NE(rooms[i]->localParticipant(), nullptr);
+    const ConnectTiming &t = result.timing;
+    EXPECT_GT(t.join.count(), 0);
+    // Each phase is truncated to microseconds separately.
+    EXPECT_NEAR(static_cast<double>(t.total.count()),
+                static_cast<double>((t.request + t.join + t.setup).count()),
+                3.0);
+    EXPECT_EQ(rooms[i]->connectTiming().total, t.total);
+  }
+}
+
 TEST_F(RoomServerTest, ConnectWithInvalidUrl) {
   Room room;
   RoomOptions options;
@@ -158,5 +410,19 @@ TEST_F(RoomServerTest, ConnectWithInvalidUrl) {
   EXPECT_FALSE(connected) << "Should fail to connect to invalid URL";
 }
 
+TEST_F(RoomServerTest, ConnectAsyncReportsFailure) {
+  Room room;
+  ConnectResult result =
+      room.connectAsync("wss://invalid.example.com", "token", {}).get();
+  EXPECT_FALSE(result.connected);
+  EXPECT_FALSE(result.error.empty());
+  EXPECT_FALSE(result.timing.first_track_subscribed.has_value());
+  EXPECT_GE(result.timing.total, result.timing.join);
+  EXPECT_EQ(room.localParticipant(), nullptr);
+
+  // A failed attempt leaves the room free to connect again.
+  EXPECT_FALSE(room.Connect("wss://invalid.example.com", "token", {}));
+}
+
 } // namespace test
 } // namespace livekit
@@ -364,6 +364,129 @@ TEST_F(RpcIntegrationTest, ApplicationError) {
   receiver_room.reset();
 }
 
+// Test async handlers answering later from another thread
+TEST_F(RpcIntegrationTest, AsyncHandlerRespondsLater) {
+  if (!config_.available) {
+    GTEST_SKIP() << "LIVEKIT_URL, LIVEKIT_CALLER_TOKEN, and "
+                    "LIVEKIT_RECEIVER_TOKEN not set";
+  }
+
+  auto receiver_room = std::make_unique<Room>();
+  RoomOptions options;
+  options.auto_subscribe = true;
+
+  bool receiver_connected =
+      receiver_room->Connect(config_.url, config_.receiver_token, options);
+  ASSERT_TRUE(receiver_connected) << "Receiver failed to connect";
+
+  std::string receiver_identity = receiver_room->localParticipant()->identity();
+
+  std::mutex workers_mutex;
+  std::vector<std::thread> workers;
+  receiver_room->localParticipant()->registerRpcMethodAsync(
+      "deferred-echo",
+      [&](const RpcInvocationData &data, RpcResponder responder) {
+        std::lock_guard<std::mutex> lock(workers_mutex);
+        workers.emplace_back([payload = data.payload, responder]() mutable {
+          std::this_thread::sleep_for(200ms);
+          if (payload == "fail") {
+            responder.fail(RpcError(RpcError::ErrorCode::APPLICATION_ERROR,
+                                    "deferred failure"));
+          } else {
+            responder.respond("echo:" + payload);
+          }
+        });
+      });
+
+  auto caller_room = std::make_unique<Room>();
+  bool caller_connected =
+      caller_room->Connect(config_.url, config_.caller_token, options);
+  ASSERT_TRUE(caller_connected) << "Caller failed to connect";
+
+  bool receiver_visible =
+      waitForParticipant(caller_room.get(), receiver_identity, 10s);
+  ASSERT_TRUE(receiver_visible) << "Receiver not visible to caller";
+
+  // All calls are in flight at once; no handler thread is held meanwhile.
+  std::vector<AsyncOperation<std::string>> calls;
+  for (int i = 0; i < 5; ++i) {
+    calls.push_back(caller_room->localParticipant()->performRpcAsync(
+        receiver_identity, "deferred-echo", std::to_string(i), 10.0));
+  }
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(calls[i].get(), "echo:" + std::to_string(i));
+  }
+
+  try {
+    caller_room->localParticipant()->performRpc(receiver_identity,
+                                                "deferred-echo", "fail", 10.0);
+    FAIL() << "Expected RpcError from deferred failure";
+  } catch (const RpcError &e) {
+    EXPECT_EQ(static_cast<RpcError::ErrorCode>(e.code()),
+              RpcError::ErrorCode::APPLICATION_ERROR);
+  }
+
+  receiver_room->localParticipant()->unregisterRpcMethod("deferred-echo");
+  {
+    std::lock_guard<std::mutex> lock(workers_mutex);
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+  caller_room.reset();
+  receiver_room.reset();
+}
+
+// Test fan-out to several destinations, including one that does not exist
+TEST_F(RpcIntegrationTest, PerformRpcMany) {
+  if (!config_.available) {
+    GTEST_SKIP() << "LIVEKIT_URL, LIVEKIT_CALLER_TOKEN, and "
+                    "LIVEKIT_RECEIVER_TOKEN not set";
+  }
+
+  auto receiver_room = std::make_unique<Room>();
+  RoomOptions options;
+  options.auto_subscribe = true;
+
+  bool receiver_connected =
+      receiver_room->Connect(config_.url, config_.receiver_token, options);
+  ASSERT_TRUE(receiver_connected) << "Receiver failed to connect";
+
+  std::string receiver_identity = receiver_room->localParticipant()->identity();
+  receiver_room->localParticipant()->registerRpcMethod(
+      "fanout",
+      [](const RpcInvocationData &data) -> std::optional<std::string> {
+        return "ack:" + data.payload;
+      });
+
+  auto caller_room = std::make_unique<Room>();
+  bool caller_connected =
+      caller_room->Connect(config_.url, config_.caller_token, options);
+  ASSERT_TRUE(caller_connected) << "Caller failed to connect";
+
+  bool receiver_visible =
+      waitForParticipant(caller_room.get(), receiver_identity, 10s);
+  ASSERT_TRUE(receiver_visible) << "Receiver not visible to caller";
+
+  RpcManyOptions many;
+  many.max_concurrency = 2;
+  many.deadline = 15s;
+  auto results = caller_room->localParticipant()->performRpcMany(
+      {receiver_identity, "missing-participant", receiver_identity}, "fanout",
+      "go", many);
+
+  ASSERT_EQ(results.size(), 3u);
+  EXPECT_TRUE(results[0].ok());
+  EXPECT_EQ(results[0].payload, "ack:go");
+  EXPECT_FALSE(results[1].ok());
+  EXPECT_EQ(results[1].destination_identity, "missing-participant");
+  EXPECT_TRUE(results[2].ok());
+
+  receiver_room->localParticipant()->unregisterRpcMethod("fanout");
+  caller_room.reset();
+  receiver_room.reset();
+}
+
 // Test multiple concurrent RPC calls
 TEST_F(RpcIntegrationTest, ConcurrentRpcCalls) {
   if (!config_.available) {
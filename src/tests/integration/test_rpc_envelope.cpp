@@ -0,0 +1,117 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "livekit/rpc_error.h"
+#include "rpc_envelope.h"
+
+#include <string>
+
+namespace livekit {
+namespace test {
+
+using detail::RpcPayloadMode;
+
+namespace {
+
+// Toy run-length codec standing in for zstd/lz4.
+std::string rleCompress(std::string_view in) {
+  std::string out;
+  for (std::size_t i = 0; i < in.size();) {
+    std::size_t run = 1;
+    while (i + run < in.size() && in[i + run] == in[i] && run < 255) {
+      ++run;
+    }
+    out += static_cast<char>(run);
+    out += in[i];
+    i += run;
+  }
+  return out;
+}
+
+std::string rleDecompress(std::string_view in) {
+  std::string out;
+  for (std::size_t i = 0; i + 1 < in.size(); i += 2) {
+    out.append(static_cast<unsigned char>(in[i]), in[i + 1]);
+  }
+  return out;
+}
+
+} // namespace
+
+TEST(RpcEnvelopeTest, Base64RoundTrip) {
+  for (std::string s : {"", "f", "fo", "foo", "foob", "fooba", "foobar"}) {
+    std::string decoded;
+    ASSERT_TRUE(detail::base64Decode(detail::base64Encode(s), &decoded));
+    EXPECT_EQ(decoded, s);
+  }
+  EXPECT_EQ(detail::base64Encode("foobar"), "Zm9vYmFy");
+  EXPECT_EQ(detail::base64Encode("fo"), "Zm8=");
+  std::string out;
+  EXPECT_FALSE(detail::base64Decode("Zm8", &out));
+  EXPECT_FALSE(detail::base64Decode("Z=8=", &out));
+  EXPECT_FALSE(detail::base64Decode("Zm==Zm8=", &out));
+}
+
+TEST(RpcEnvelopeTest, PlainPayloadsPassThrough) {
+  EXPECT_EQ(detail::encodeRpcPayload("hello", {}), "hello");
+  std::string body;
+  EXPECT_FALSE(detail::decodeRpcPayload("hello", nullptr, &body));
+}
+
+TEST(RpcEnvelopeTest, BinaryAndCompressedRoundTrip) {
+  registerRpcCompression({"test-rle", rleCompress, rleDecompress, 16});
+
+  const std::string binary("\x00\xff\x10\x00", 4);
+  RpcPayloadMode mode;
+  mode.binary = true;
+  std::string body;
+  RpcPayloadMode seen;
+  ASSERT_TRUE(detail::decodeRpcPayload(detail::encodeRpcPayload(binary, mode),
+                                       &seen, &body));
+  EXPECT_EQ(body, binary);
+  EXPECT_TRUE(seen.binary);
+
+  const std::string text(1000, 'a');
+  mode = {};
+  mode.compression = "test-rle";
+  const std::string wire = detail::encodeRpcPayload(text, mode);
+  EXPECT_LT(wire.size(), 100u);
+  ASSERT_TRUE(detail::decodeRpcPayload(wire, &seen, &body));
+  EXPECT_EQ(body, text);
+  EXPECT_EQ(seen.compression, "test-rle");
+  EXPECT_FALSE(seen.binary);
+
+  // Too small to compress, but still asks for a compressed reply.
+  ASSERT_TRUE(detail::decodeRpcPayload(detail::encodeRpcPayload("hi", mode),
+                                       &seen, &body));
+  EXPECT_EQ(body, "hi");
+  EXPECT_EQ(seen.compression, "test-rle");
+}
+
+TEST(RpcEnvelopeTest, UnknownCodecIsAnRpcError) {
+  RpcPayloadMode mode;
+  mode.compression = "not-registered";
+  EXPECT_THROW(detail::encodeRpcPayload("x", mode), RpcError);
+  std::string body;
+  EXPECT_THROW(detail::decodeRpcPayload("\x1eLK1t1nope\nabcd", nullptr, &body),
+               RpcError);
+  EXPECT_THROW(detail::decodeRpcPayload("\x1eLK1", nullptr, &body), RpcError);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "livekit/rpc_error.h"
+#include "rpc_metrics.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+using detail::LatencyHistogram;
+using detail::RpcMetricsRegistry;
+using std::chrono::microseconds;
+
+TEST(RpcMetricsTest, BucketsBoundRelativeError) {
+  for (std::uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 1000ull, 123456ull,
+                          (1ull << 40) - 1}) {
+    const std::size_t i = LatencyHistogram::bucketIndex(v);
+    ASSERT_LT(i, LatencyHistogram::kBucketCount);
+    const std::uint64_t upper = LatencyHistogram::bucketUpperBound(i);
+    EXPECT_GE(upper, v);
+    EXPECT_LE(upper - v, v / 16 + 1) << v;
+    if (i > 0) {
+      EXPECT_LT(LatencyHistogram::bucketUpperBound(i - 1), v);
+    }
+  }
+}
+
+TEST(RpcMetricsTest, PercentilesFromConcurrentRecording) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.emplace_back([&histogram] {
+      for (int v = 1; v <= 1000; ++v) {
+        histogram.record(microseconds(v));
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  const LatencySnapshot snap = histogram.snapshot();
+  EXPECT_EQ(snap.count, 4000u);
+  EXPECT_EQ(snap.min, microseconds(1));
+  EXPECT_EQ(snap.max, microseconds(1000));
+  EXPECT_EQ(snap.mean(), microseconds(500));
+  EXPECT_NEAR(snap.percentile(0.5).count(), 500, 500 / 16 + 1);
+  EXPECT_NEAR(snap.percentile(0.99).count(), 990, 990 / 16 + 1);
+  EXPECT_EQ(snap.percentile(1.0), microseconds(1000));
+}
+
+TEST(RpcMetricsTest, RegistryCountsErrorsAndTimeouts) {
+  auto &registry = RpcMetricsRegistry::instance();
+  registry.reset();
+  const auto timeout =
+      static_cast<std::uint32_t>(RpcError::ErrorCode::RESPONSE_TIMEOUT);
+  const auto app =
+      static_cast<std::uint32_t>(RpcError::ErrorCode::APPLICATION_ERROR);
+  registry.recordOutgoing("metrics-test", microseconds(100), 0);
+  registry.recordOutgoing("metrics-test", microseconds(200), timeout);
+  registry.recordIncoming("metrics-test", microseconds(5), microseconds(50),
+                          app);
+
+  const RpcMetrics metrics = registry.snapshot();
+  auto find = [](const std::vector<RpcMethodMetrics> &all) {
+    for (const auto &m : all) {
+      if (m.method == "metrics-test") {
+        return m;
+      }
+    }
+    return RpcMethodMetrics{};
+  };
+  const RpcMethodMetrics out = find(metrics.outgoing);
+  EXPECT_EQ(out.calls, 2u);
+  EXPECT_EQ(out.timeouts, 1u);
+  EXPECT_EQ(out.errors, 0u);
+  EXPECT_EQ(out.latency.count, 2u);
+
+  const RpcMethodMetrics in = find(metrics.incoming);
+  EXPECT_EQ(in.calls, 1u);
+  EXPECT_EQ(in.errors, 1u);
+  EXPECT_EQ(in.queueing.max, microseconds(5));
+
+  registry.reset();
+  EXPECT_EQ(find(registry.snapshot().outgoing).calls, 0u);
+}
+
+} // namespace test
+} // namespace livekit
@@ -74,5 +74,43 @@ TEST_F(SDKInitializationTest, MultipleShutdowns) {
   EXPECT_NO_THROW(livekit::shutdown());
 }
 
+TEST_F(SDKInitializationTest, InitializeForManyRooms) {
+  const EventDispatchOptions options = EventDispatchOptions::manyRooms();
+  EXPECT_EQ(options.mode, EventDispatchMode::kShardedPool);
+  EXPECT_GE(options.pool_threads, 2);
+  EXPECT_LE(options.pool_threads, 16);
+
+  EXPECT_TRUE(livekit::initialize(livekit::LogSink::kConsole, options));
+}
+
+TEST_F(SDKInitializationTest, BackgroundInitializeWithPrewarm) {
+  InitializeOptions options;
+  options.background = true;
+  options.prewarm_media = true;
+  EXPECT_TRUE(livekit::initialize(options));
+  EXPECT_FALSE(livekit::initialize(options));
+
+  // Blocks until the background start-up is done, then works as usual.
+  Room room;
+  auto source = std::make_shared<VideoSource>(16, 16);
+  EXPECT_NE(LocalVideoTrack::createLocalVideoTrack("cam", source), nullptr);
+
+  // No network needed: an unresolvable host is only logged.
+  auto done = livekit::prewarm("wss://invalid.example.invalid:7880/rtc");
+  EXPECT_NO_THROW(done.get());
+}
+
+TEST_F(SDKInitializationTest, PrewarmRequiresInitialize) {
+  EXPECT_THROW(livekit::prewarm("wss://localhost:7880"), std::runtime_error);
+}
+
+TEST_F(SDKInitializationTest, ShutdownDuringBackgroundInitialize) {
+  InitializeOptions options;
+  options.background = true;
+  ASSERT_TRUE(livekit::initialize(options));
+  EXPECT_NO_THROW(livekit::shutdown());
+  EXPECT_TRUE(livekit::initialize(LogSink::kConsole));
+}
+
 } // namespace test
 } // namespace livekit
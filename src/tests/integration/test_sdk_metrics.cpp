@@ -0,0 +1,280 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <livekit/ffi_handle.h>
+#include <livekit/livekit.h>
+#include <livekit/resources.h>
+
+#include "sdk_metrics.h"
+#include "stream_budget.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace livekit {
+namespace test {
+
+using detail::g_metrics_enabled;
+using detail::SdkMetrics;
+using detail::StreamMetrics;
+
+namespace {
+
+// Far above any id the FFI hands out, so dropping them is a no-op.
+constexpr std::uintptr_t kFakeHandle = std::uintptr_t{1} << 60;
+
+std::int64_t liveHandles(ResourceKind kind) {
+  return resourceSnapshot().handles(kind);
+}
+
+template <typename Fn> bool waitUntil(Fn done) {
+  for (int i = 0; i < 200; ++i) {
+    if (done()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return done();
+}
+
+} // namespace
+
+class SdkMetricsTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    SdkMetrics::instance().reset();
+    g_metrics_enabled.store(true);
+  }
+  void TearDown() override {
+    g_metrics_enabled.store(false);
+    SdkMetrics::instance().reset();
+  }
+};
+
+TEST_F(SdkMetricsTest, CountersAreInertWhileDisabled) {
+  g_metrics_enabled.store(false);
+  detail::MetricCounter counter;
+  counter.add(5);
+  EXPECT_EQ(counter.value(), 0u);
+  g_metrics_enabled.store(true);
+  counter.add(5);
+  EXPECT_EQ(counter.value(), 5u);
+}
+
+TEST_F(SdkMetricsTest, StreamDepthAndDropsAcrossStreams) {
+  StreamMetrics m;
+  std::atomic<std::int64_t> depth_a{0}, depth_b{0};
+  std::atomic<std::uint64_t> ring_seen{0};
+
+  m.observeDepth(3, depth_a);
+  m.observeDepth(2, depth_b);
+  EXPECT_EQ(m.queued_frames.load(), 5);
+  m.observeDepth(1, depth_a);
+  EXPECT_EQ(m.queued_frames.load(), 3);
+
+  // Ring drop counters are cumulative; each drop is counted once.
+  m.observeRingDrops(4, ring_seen);
+  m.observeRingDrops(4, ring_seen);
+  m.observeRingDrops(6, ring_seen);
+  EXPECT_EQ(m.frames_dropped.value(), 6u);
+
+  // Closing withdraws the stream's depth and counts what it discarded,
+  // even once metrics are switched off.
+  g_metrics_enabled.store(false);
+  m.release(0, depth_a);
+  g_metrics_enabled.store(true);
+  m.release(2, depth_b);
+  EXPECT_EQ(m.queued_frames.load(), 0);
+  EXPECT_EQ(m.frames_dropped.value(), 8u);
+}
+
+TEST_F(SdkMetricsTest, StreamBytesFollowEachStreamsLastReport) {
+  StreamMetrics m;
+  std::atomic<std::int64_t> bytes_a{0}, bytes_b{0};
+  m.observeBytes(3000, bytes_a);
+  m.observeBytes(500, bytes_b);
+  EXPECT_EQ(m.queued_bytes.load(), 3500);
+  m.observeBytes(1000, bytes_a);
+  EXPECT_EQ(m.queued_bytes.load(), 1500);
+
+  g_metrics_enabled.store(false);
+  m.releaseBytes(bytes_a);
+  m.releaseBytes(bytes_b);
+  EXPECT_EQ(m.queued_bytes.load(), 0);
+}
+
+TEST_F(SdkMetricsTest, LiveHandlesCountedByKind) {
+  const std::int64_t rooms = liveHandles(ResourceKind::kRoom);
+  const std::int64_t tracks = liveHandles(ResourceKind::kTrack);
+  const std::int64_t other = liveHandles(ResourceKind::kOther);
+  {
+    FfiHandle room(kFakeHandle, ResourceKind::kRoom);
+    FfiHandle track(kFakeHandle + 1, ResourceKind::kTrack);
+    FfiHandle plain(kFakeHandle + 2);
+    FfiHandle empty(0, ResourceKind::kTrack);
+    EXPECT_EQ(liveHandles(ResourceKind::kRoom), rooms + 1);
+    EXPECT_EQ(liveHandles(ResourceKind::kTrack), tracks + 1);
+    EXPECT_EQ(liveHandles(ResourceKind::kOther), other + 1);
+
+    // Moves carry the count and the kind along.
+    FfiHandle moved(std::move(track));
+    EXPECT_EQ(moved.kind(), ResourceKind::kTrack);
+    EXPECT_EQ(liveHandles(ResourceKind::kTrack), tracks + 1);
+    empty = std::move(moved);
+    EXPECT_EQ(liveHandles(ResourceKind::kTrack), tracks + 1);
+
+    // reset() keeps the kind; release() hands the handle out of accounting.
+    room.reset(kFakeHandle + 3);
+    EXPECT_EQ(liveHandles(ResourceKind::kRoom), rooms + 1);
+    EXPECT_EQ(room.release(), kFakeHandle + 3);
+    EXPECT_EQ(liveHandles(ResourceKind::kRoom), rooms);
+  }
+  EXPECT_EQ(liveHandles(ResourceKind::kRoom), rooms);
+  EXPECT_EQ(liveHandles(ResourceKind::kTrack), tracks);
+  EXPECT_EQ(liveHandles(ResourceKind::kOther), other);
+}
+
+TEST_F(SdkMetricsTest, LiveHandlesStayBalancedAcrossToggles) {
+  const std::int64_t before = liveHandles(ResourceKind::kVideoBuffer);
+  g_metrics_enabled.store(false);
+  {
+    FfiHandle untracked(kFakeHandle, ResourceKind::kVideoBuffer);
+    g_metrics_enabled.store(true);
+    FfiHandle tracked(kFakeHandle + 1, ResourceKind::kVideoBuffer);
+    EXPECT_EQ(liveHandles(ResourceKind::kVideoBuffer), before + 1);
+    g_metrics_enabled.store(false);
+  }
+  EXPECT_EQ(liveHandles(ResourceKind::kVideoBuffer), before);
+}
+
+TEST_F(SdkMetricsTest, StreamBudgetsReportBufferedBytes) {
+  const std::int64_t before = resourceSnapshot().stream_reader_bytes;
+  std::atomic<std::size_t> reader_bytes{0};
+  {
+    detail::StreamBudget budget(StreamBufferOptions{});
+    ASSERT_EQ(budget.admit(100, reader_bytes),
+              detail::StreamBudget::Admission::kAdmit);
+    ASSERT_EQ(budget.admit(50, reader_bytes),
+              detail::StreamBudget::Admission::kAdmit);
+    EXPECT_EQ(resourceSnapshot().stream_reader_bytes, before + 150);
+    budget.release(40);
+    EXPECT_EQ(resourceSnapshot().stream_reader_bytes, before + 110);
+    // Over-release is clamped like buffered_bytes.
+    budget.release(1000);
+    EXPECT_EQ(resourceSnapshot().stream_reader_bytes, before);
+    ASSERT_EQ(budget.admit(70, reader_bytes),
+              detail::StreamBudget::Admission::kAdmit);
+  }
+  // Whatever a destroyed budget still held is withdrawn.
+  EXPECT_EQ(resourceSnapshot().stream_reader_bytes, before);
+}
+
+TEST_F(SdkMetricsTest, RendersOpenMetricsText) {
+  auto &sdk = SdkMetrics::instance();
+  sdk.audio.frames_received.add(10);
+  sdk.ffi_requests.add(2);
+  sdk.ffi_request_latency.record(std::chrono::microseconds(50));
+  sdk.ffi_request_latency.record(std::chrono::microseconds(2000));
+  sdk.data_stream_bytes_sent.add(1024);
+  sdk.reconnects.add();
+  sdk.reconnect_latency.record(std::chrono::milliseconds(300));
+
+  RpcMetrics rpc;
+  RpcMethodMetrics method;
+  method.method = "say\"hi\"";
+  method.calls = 3;
+  method.errors = 1;
+  rpc.outgoing.push_back(method);
+
+  detail::ScrapeGauges gauges;
+  gauges.pending_async_operations = 4;
+  gauges.listeners = 7;
+
+  const std::string text = detail::renderOpenMetrics(sdk, rpc, gauges);
+  auto has = [&text](const std::string &line) {
+    return text.find(line + "\n") != std::string::npos;
+  };
+  EXPECT_TRUE(has("# TYPE livekit_stream_frames_received counter"));
+  EXPECT_TRUE(has("livekit_stream_frames_received_total{kind=\"audio\"} 10"));
+  EXPECT_TRUE(has("livekit_stream_frames_received_total{kind=\"video\"} 0"));
+  EXPECT_TRUE(has("livekit_ffi_requests_total 2"));
+  EXPECT_TRUE(has("# TYPE livekit_live_handles gauge"));
+  EXPECT_TRUE(has("# TYPE livekit_stream_queued_bytes gauge"));
+  EXPECT_TRUE(
+      has("livekit_ffi_request_duration_seconds_bucket{le=\"0.000100\"} 1"));
+  EXPECT_TRUE(
+      has("livekit_ffi_request_duration_seconds_bucket{le=\"0.002500\"} 2"));
+  EXPECT_TRUE(
+      has("livekit_ffi_request_duration_seconds_bucket{le=\"+Inf\"} 2"));
+  EXPECT_TRUE(has("livekit_ffi_request_duration_seconds_count 2"));
+  EXPECT_TRUE(has("livekit_ffi_pending_async_operations 4"));
+  EXPECT_TRUE(has("livekit_ffi_listeners 7"));
+  EXPECT_TRUE(has("livekit_data_stream_bytes_sent_total 1024"));
+  EXPECT_TRUE(has("livekit_room_reconnects_total 1"));
+  EXPECT_TRUE(has("livekit_room_reconnect_failures_total 0"));
+  EXPECT_TRUE(has("livekit_room_reconnect_duration_seconds_count 1"));
+  EXPECT_TRUE(has("livekit_rpc_calls_total{direction=\"outgoing\","
+                  "method=\"say\\\"hi\\\"\"} 3"));
+  EXPECT_TRUE(has("livekit_rpc_errors_total{direction=\"outgoing\","
+                  "method=\"say\\\"hi\\\"\"} 1"));
+  EXPECT_EQ(text.substr(text.size() - 6), "# EOF\n");
+}
+
+class StreamMetricsFfiTest : public SdkMetricsTest {
+protected:
+  void SetUp() override {
+    SdkMetricsTest::SetUp();
+    livekit::initialize(livekit::LogSink::kConsole);
+  }
+  void TearDown() override {
+    livekit::shutdown();
+    SdkMetricsTest::TearDown();
+  }
+};
+
+TEST_F(StreamMetricsFfiTest, MoveAssignedVideoStreamKeepsQueuedBytes) {
+  auto &m = SdkMetrics::instance().video;
+  const std::int64_t baseline = m.queued_bytes.load();
+
+  auto source = std::make_shared<VideoSource>(64, 64);
+  auto track = LocalVideoTrack::createLocalVideoTrack("cam", source);
+  VideoStream::Options options;
+  options.capacity = 8;
+  auto from = VideoStream::fromTrack(track, options);
+  auto to = VideoStream::fromTrack(track, options);
+
+  const VideoFrame frame = VideoFrame::create(64, 64, VideoBufferType::RGBA);
+  ASSERT_TRUE(waitUntil([&] {
+    source->captureFrame(frame);
+    return m.queued_bytes.load() > baseline;
+  }));
+
+  // `to` takes over the queue and must withdraw its bytes when it closes.
+  *to = std::move(*from);
+  to.reset(); // Unregisters the listener `from` still backs.
+  from.reset();
+  EXPECT_EQ(m.queued_bytes.load(), baseline);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "livekit/audio_frame.h"
+#include "livekit/shared_frame_ring.h"
+#include "livekit/video_frame.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "livekit/frame_ring_abi.h"
+#endif
+
+namespace livekit {
+namespace test {
+
+#if !defined(_WIN32)
+
+namespace {
+
+// Read-only mapping, as a consumer process would make it.
+class ReaderMapping {
+public:
+  ReaderMapping(int fd, std::size_t size) : size_(size) {
+    void *mem = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mem != MAP_FAILED) {
+      ring_ = static_cast<const lk_frame_ring_header *>(mem);
+    }
+  }
+  ~ReaderMapping() {
+    if (ring_) {
+      munmap(const_cast<lk_frame_ring_header *>(ring_), size_);
+    }
+  }
+
+  const lk_frame_ring_header *ring() const { return ring_; }
+
+private:
+  const lk_frame_ring_header *ring_ = nullptr;
+  std::size_t size_;
+};
+
+SharedFrameRing::Options ringOptions(std::size_t slots, std::size_t bytes) {
+  SharedFrameRing::Options options;
+  options.slot_count = slots;
+  options.max_frame_bytes = bytes;
+#if !defined(__linux__)
+  options.name = "/lk-ring-test-" + std::to_string(getpid());
+#endif
+  return options;
+}
+
+} // namespace
+
+TEST(SharedFrameRingTest, RejectsEmptyGeometry) {
+  using Kind = SharedFrameRing::Kind;
+  EXPECT_THROW(SharedFrameRing(Kind::kVideo, ringOptions(0, 16)),
+               std::invalid_argument);
+  EXPECT_THROW(SharedFrameRing(Kind::kVideo, ringOptions(2, 0)),
+               std::invalid_argument);
+}
+
+TEST(SharedFrameRingTest, ExportsVideoPlanes) {
+  SharedFrameRing ring(SharedFrameRing::Kind::kVideo, ringOptions(2, 64 * 64));
+  VideoFrame frame = VideoFrame::create(8, 4, VideoBufferType::I420);
+  for (std::size_t i = 0; i < frame.dataSize(); ++i) {
+    frame.data()[i] = static_cast<std::uint8_t>(i);
+  }
+  ASSERT_TRUE(ring.write(frame, 1234, VideoRotation::VIDEO_ROTATION_90));
+
+  ReaderMapping reader(ring.fd(), ring.mappedSize());
+  const lk_frame_ring_header *header = reader.ring();
+  ASSERT_NE(header, nullptr);
+  ASSERT_TRUE(lk_frame_ring_valid(header, ring.mappedSize()));
+  EXPECT_EQ(header->kind, static_cast<std::uint32_t>(LK_FRAME_RING_VIDEO));
+  EXPECT_EQ(header->producer_pid, static_cast<std::uint32_t>(getpid()));
+  ASSERT_EQ(lk_frame_ring_write_index(header), 1u);
+
+  const lk_frame_slot_header *slot = lk_frame_ring_slot(header, 0);
+  const std::uint64_t seq = lk_frame_slot_begin(slot);
+  ASSERT_NE(seq, 0u);
+  EXPECT_EQ(slot->frame_index, 0u);
+  EXPECT_EQ(slot->timestamp_us, 1234);
+  EXPECT_EQ(slot->width, 8u);
+  EXPECT_EQ(slot->height, 4u);
+  EXPECT_EQ(slot->rotation, 90u);
+  EXPECT_EQ(slot->format, static_cast<std::uint32_t>(VideoBufferType::I420));
+
+  const auto planes = frame.planeInfos();
+  ASSERT_EQ(slot->plane_count, planes.size());
+  for (std::size_t i = 0; i < planes.size(); ++i) {
+    EXPECT_EQ(slot->plane_stride[i], planes[i].stride);
+    EXPECT_EQ(std::memcmp(lk_frame_slot_payload(slot) + slot->plane_offset[i],
+                          reinterpret_cast<const void *>(planes[i].data_ptr),
+                          planes[i].size),
+              0);
+  }
+  EXPECT_TRUE(lk_frame_slot_end(slot, seq));
+}
+
+TEST(SharedFrameRingTest, ExportsAudioAndWrapsAround) {
+  SharedFrameRing ring(SharedFrameRing::Kind::kAudio, ringOptions(2, 480 * 4));
+  for (int i = 0; i < 3; ++i) {
+    AudioFrame frame(std::vector<std::int16_t>(480 * 2,
+                                               static_cast<std::int16_t>(i)),
+                     48000, 2, 480);
+    ASSERT_TRUE(ring.write(frame, i * 10000));
+  }
+  EXPECT_EQ(ring.stats().frames_written, 3u);
+
+  ReaderMapping reader(ring.fd(), ring.mappedSize());
+  const lk_frame_ring_header *header = reader.ring();
+  ASSERT_NE(header, nullptr);
+  ASSERT_EQ(lk_frame_ring_write_index(header), 3u);
+
+  // Frame 0 was overwritten by frame 2, which shares its slot.
+  const lk_frame_slot_header *slot = lk_frame_ring_slot(header, 0);
+  EXPECT_EQ(slot->frame_index, 2u);
+  EXPECT_EQ(slot->timestamp_us, 20000);
+  EXPECT_EQ(slot->sample_rate, 48000u);
+  EXPECT_EQ(slot->num_channels, 2u);
+  EXPECT_EQ(slot->samples_per_channel, 480u);
+  ASSERT_EQ(slot->payload_size, 480u * 2 * sizeof(std::int16_t));
+  std::int16_t sample = 0;
+  std::memcpy(&sample, lk_frame_slot_payload(slot), sizeof(sample));
+  EXPECT_EQ(sample, 2);
+  EXPECT_EQ(lk_frame_ring_slot(header, 1)->frame_index, 1u);
+}
+
+TEST(SharedFrameRingTest, SkipsFramesThatDoNotFit) {
+  SharedFrameRing ring(SharedFrameRing::Kind::kAudio, ringOptions(2, 100));
+  AudioFrame frame(std::vector<std::int16_t>(960, 0), 48000, 2, 480);
+  EXPECT_FALSE(ring.write(frame, 0));
+  // Wrong kind is refused without being counted as too large.
+  EXPECT_FALSE(ring.write(VideoFrame::create(2, 2, VideoBufferType::RGBA), 0));
+  EXPECT_EQ(ring.stats().frames_written, 0u);
+  EXPECT_EQ(ring.stats().frames_too_large, 1u);
+
+  ReaderMapping reader(ring.fd(), ring.mappedSize());
+  ASSERT_NE(reader.ring(), nullptr);
+  EXPECT_EQ(reader.ring()->dropped, 1u);
+  EXPECT_EQ(lk_frame_ring_write_index(reader.ring()), 0u);
+}
+
+TEST(SharedFrameRingTest, NamedRingOpensByNameAndUnlinks) {
+  const std::string name = "/lk-ring-test-named-" + std::to_string(getpid());
+  {
+    SharedFrameRing::Options options = ringOptions(1, 64);
+    options.name = name;
+    SharedFrameRing ring(SharedFrameRing::Kind::kAudio, options);
+    ring.close();
+    EXPECT_FALSE(ring.write(AudioFrame(std::vector<std::int16_t>(2, 0),
+                                       48000, 1, 2),
+                            0));
+
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    ASSERT_GE(fd, 0);
+    {
+      ReaderMapping reader(fd, ring.mappedSize());
+      ASSERT_NE(reader.ring(), nullptr);
+      EXPECT_TRUE(lk_frame_ring_valid(reader.ring(), ring.mappedSize()));
+      EXPECT_EQ(reader.ring()->closed, 1u);
+    }
+    close(fd);
+  }
+  EXPECT_LT(shm_open(name.c_str(), O_RDONLY, 0), 0);
+}
+
+#endif // !_WIN32
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "spsc_ring.h"
+
+namespace livekit {
+namespace test {
+
+using detail::SpscRing;
+
+TEST(SpscRingTest, PushPopInOrder) {
+  SpscRing<int> ring(4);
+  EXPECT_TRUE(ring.push(1));
+  EXPECT_TRUE(ring.push(2));
+  EXPECT_EQ(ring.size(), 2u);
+
+  int v = 0;
+  ASSERT_TRUE(ring.tryPop(v));
+  EXPECT_EQ(v, 1);
+  ASSERT_TRUE(ring.tryPop(v));
+  EXPECT_EQ(v, 2);
+  EXPECT_FALSE(ring.tryPop(v));
+}
+
+TEST(SpscRingTest, DropsOldestWhenFull) {
+  SpscRing<int> ring(3);
+  for (int i = 0; i < 5; ++i) {
+    ring.push(int(i));
+  }
+  EXPECT_EQ(ring.size(), 3u);
+
+  int v = 0;
+  ASSERT_TRUE(ring.tryPop(v));
+  EXPECT_EQ(v, 2) << "Reader should only see the newest 3 items";
+  ASSERT_TRUE(ring.tryPop(v));
+  EXPECT_EQ(v, 3);
+  ASSERT_TRUE(ring.tryPop(v));
+  EXPECT_EQ(v, 4);
+  EXPECT_EQ(ring.dropped(), 2u);
+}
+
+TEST(SpscRingTest, CloseDrainsThenFails) {
+  SpscRing<int> ring(2);
+  ring.push(7);
+  ring.close();
+
+  int v = 0;
+  ASSERT_TRUE(ring.pop(v));
+  EXPECT_EQ(v, 7);
+  EXPECT_FALSE(ring.pop(v));
+}
+
+TEST(SpscRingTest, CloseWithDiscardFailsImmediately) {
+  SpscRing<int> ring(2);
+  ring.push(7);
+  ring.close(/*discard_pending=*/true);
+
+  int v = 0;
+  EXPECT_FALSE(ring.pop(v));
+}
+
+TEST(SpscRingTest, BlockingPopWakesOnPush) {
+  SpscRing<int> ring(8);
+  constexpr int kCount = 100000;
+
+  std::thread producer([&] {
+    for (int i = 0; i < kCount; ++i) {
+      while (!ring.push(int(i))) {
+        std::this_thread::yield();
+      }
+    }
+    ring.close();
+  });
+
+  // Items may be skipped under drop-oldest, but order must be preserved and
+  // the last item must always be delivered.
+  int last = -1;
+  int v = 0;
+  while (ring.pop(v)) {
+    EXPECT_GT(v, last);
+    last = v;
+  }
+  producer.join();
+  EXPECT_EQ(last, kCount - 1);
+}
+
+TEST(SpscRingTest, PopForTimesOutWhenEmpty) {
+  SpscRing<int> ring(2);
+  int v = 0;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(ring.popFor(v, std::chrono::milliseconds(20)));
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+}
+
+TEST(SpscRingTest, PopForWakesOnPush) {
+  SpscRing<int> ring(2);
+  std::thread producer([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ring.push(5);
+  });
+
+  int v = 0;
+  EXPECT_TRUE(ring.popFor(v, std::chrono::seconds(5)));
+  EXPECT_EQ(v, 5);
+  producer.join();
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <livekit/stats_sampler.h>
+
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+using detail::TrackStatsAccumulator;
+
+namespace {
+
+RtcStats inbound(std::int64_t ts_ms, std::uint64_t bytes,
+                 std::uint64_t packets, std::int64_t lost, double jitter_sec) {
+  RtcInboundRtpStats s{};
+  s.rtc.timestamp_ms = ts_ms;
+  s.inbound.bytes_received = bytes;
+  s.received.packets_received = packets;
+  s.received.packets_lost = lost;
+  s.received.jitter = jitter_sec;
+  s.inbound.frames_per_second = 30.0;
+  s.inbound.frame_width = 640;
+  s.inbound.frame_height = 360;
+  return RtcStats{s};
+}
+
+RtcStats outbound(std::int64_t ts_ms, std::uint64_t bytes, std::uint32_t width,
+                  QualityLimitationReason reason) {
+  RtcOutboundRtpStats s{};
+  s.rtc.timestamp_ms = ts_ms;
+  s.sent.bytes_sent = bytes;
+  s.sent.packets_sent = bytes / 1000;
+  s.outbound.frame_width = width;
+  s.outbound.frame_height = width * 9 / 16;
+  s.outbound.quality_limitation_reason = reason;
+  return RtcStats{s};
+}
+
+} // namespace
+
+TEST(StatsSamplerTest, InboundRatesFromDeltas) {
+  TrackStatsAccumulator acc;
+  auto first = acc.update({inbound(1000, 0, 0, 0, 0.010)}, false);
+  EXPECT_EQ(first.bitrate_bps, 0.0);
+  EXPECT_DOUBLE_EQ(first.jitter_ms, 10.0);
+
+  auto second = acc.update({inbound(2000, 125000, 90, 10, 0.015)}, false);
+  EXPECT_DOUBLE_EQ(second.interval_sec, 1.0);
+  EXPECT_DOUBLE_EQ(second.bitrate_bps, 1000000.0);
+  EXPECT_DOUBLE_EQ(second.packets_per_sec, 90.0);
+  EXPECT_DOUBLE_EQ(second.packet_loss, 0.1);
+  EXPECT_DOUBLE_EQ(second.jitter_delta_ms, 5.0);
+  EXPECT_EQ(second.frame_width, 640u);
+
+  // Counters reset (renegotiation): no negative rates.
+  auto reset = acc.update({inbound(3000, 10, 1, 0, 0.015)}, false);
+  EXPECT_EQ(reset.bitrate_bps, 0.0);
+}
+
+TEST(StatsSamplerTest, OutboundSumsLayersAndTracksLimitation) {
+  TrackStatsAccumulator acc;
+  using Q = QualityLimitationReason;
+  acc.update({outbound(0, 0, 320, Q::None), outbound(0, 0, 1280, Q::None)},
+             true);
+  auto s = acc.update({outbound(500, 10000, 320, Q::None),
+                       outbound(500, 52500, 1280, Q::Bandwidth)},
+                      true);
+  EXPECT_DOUBLE_EQ(s.bitrate_bps, 1000000.0);
+  EXPECT_EQ(s.frame_width, 1280u);
+  EXPECT_EQ(s.quality_limitation, Q::Bandwidth);
+  EXPECT_TRUE(s.quality_limitation_changed);
+
+  auto same = acc.update({outbound(1000, 20000, 320, Q::None),
+                          outbound(1000, 105000, 1280, Q::Bandwidth)},
+                         true);
+  EXPECT_FALSE(same.quality_limitation_changed);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "stream_budget.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace livekit {
+namespace test {
+
+using detail::StreamBudget;
+using Admission = StreamBudget::Admission;
+
+namespace {
+
+StreamBufferOptions limits(StreamOverflowPolicy policy, std::size_t reader,
+                           std::size_t room) {
+  StreamBufferOptions options;
+  options.policy = policy;
+  options.max_reader_bytes = reader;
+  options.max_room_bytes = room;
+  options.block_timeout = std::chrono::milliseconds(100);
+  return options;
+}
+
+} // namespace
+
+TEST(StreamBudgetTest, PolicyDecidesOverflow) {
+  std::atomic<std::size_t> reader{0};
+  StreamBudget drop(limits(StreamOverflowPolicy::kDropStream, 10, 0));
+  EXPECT_EQ(drop.admit(8, reader), Admission::kAdmit);
+  reader = 8;
+  EXPECT_EQ(drop.admit(8, reader), Admission::kDrop);
+
+  StreamBudget spill(limits(StreamOverflowPolicy::kSpillToFile, 10, 0));
+  EXPECT_EQ(spill.admit(8, reader), Admission::kSpill);
+
+  // An empty reader always takes one chunk, even an oversized one.
+  reader = 0;
+  EXPECT_EQ(drop.admit(100, reader), Admission::kAdmit);
+  EXPECT_EQ(drop.stats().buffered_bytes, 108u);
+  EXPECT_EQ(drop.stats().peak_buffered_bytes, 108u);
+}
+
+TEST(StreamBudgetTest, BlockWaitsForRoomRelease) {
+  std::atomic<std::size_t> a{0}, b{0};
+  StreamBudget budget(limits(StreamOverflowPolicy::kBlock, 0, 8));
+  ASSERT_EQ(budget.admit(8, a), Admission::kAdmit);
+  a = 8;
+
+  std::thread consumer([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    a = 0;
+    budget.release(8);
+  });
+  EXPECT_EQ(budget.admit(4, b), Admission::kAdmit);
+  consumer.join();
+  b = 4;
+
+  // Nobody drains now: the wait times out and the stream is dropped.
+  ASSERT_EQ(budget.admit(4, a), Admission::kAdmit);
+  a = 4;
+  EXPECT_EQ(budget.admit(4, b), Admission::kDrop);
+  EXPECT_EQ(budget.stats().blocked_chunks, 2u);
+}
+
+TEST(StreamBudgetTest, SpillFileReadsBackInOrder) {
+  detail::SpillFile file("");
+  ASSERT_TRUE(file.append("hello ", 6));
+  char head[3];
+  ASSERT_EQ(file.read(head, 3), 3u);
+  ASSERT_TRUE(file.append("world", 5));
+  EXPECT_EQ(file.pending(), 8u);
+
+  std::string rest(16, '\0');
+  rest.resize(file.read(&rest[0], rest.size()));
+  EXPECT_EQ(std::string(head, 3) + rest, "hello world");
+  EXPECT_EQ(file.pending(), 0u);
+}
+
+} // namespace test
+} // namespace livekit
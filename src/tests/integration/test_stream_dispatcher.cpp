@@ -0,0 +1,242 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "stream_budget.h"
+#include "stream_dispatcher.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+using detail::StreamBudget;
+using detail::StreamDispatcher;
+
+namespace {
+
+TextStreamInfo textInfo(const std::string &id) {
+  TextStreamInfo info;
+  info.stream_id = id;
+  info.topic = "chat";
+  info.attributes["from"] = "header";
+  return info;
+}
+
+// Executor that only runs tasks when the test says so.
+struct ManualExecutor {
+  std::deque<std::function<void()>> tasks;
+
+  StreamExecutor executor() {
+    return [this](std::function<void()> task) {
+      tasks.push_back(std::move(task));
+    };
+  }
+
+  void runAll() {
+    while (!tasks.empty()) {
+      auto task = std::move(tasks.front());
+      tasks.pop_front();
+      task();
+    }
+  }
+};
+
+} // namespace
+
+TEST(StreamDispatcherTest, InlineCallbacksSeeTheWholeStream) {
+  StreamDispatcher dispatcher;
+  std::vector<std::string> events;
+  dispatcher.openText(
+      textInfo("s1"), "alice",
+      [&](const TextStreamInfo &info, const std::string &identity) {
+        events.push_back("open " + info.stream_id + " " + identity);
+        TextStreamCallbacks callbacks;
+        callbacks.on_chunk = [&](const std::string &text) {
+          events.push_back("chunk " + text);
+        };
+        callbacks.on_close = [&](const TextStreamInfo &closed, bool dropped) {
+          events.push_back("close " + closed.attributes.at("from") + " " +
+                           closed.attributes.at("extra") +
+                           (dropped ? " dropped" : ""));
+        };
+        return callbacks;
+      },
+      nullptr);
+  EXPECT_EQ(dispatcher.openStreams(), 1u);
+  EXPECT_TRUE(dispatcher.chunk("s1", "hello "));
+  EXPECT_TRUE(dispatcher.chunk("s1", "world"));
+  EXPECT_FALSE(dispatcher.chunk("other", "ignored"));
+  EXPECT_TRUE(dispatcher.close("s1", {{"from", "trailer"}, {"extra", "x"}}));
+  EXPECT_FALSE(dispatcher.close("s1", {}));
+  EXPECT_EQ(dispatcher.openStreams(), 0u);
+
+  const std::vector<std::string> expected = {
+      "open s1 alice", "chunk hello ", "chunk world", "close trailer x"};
+  EXPECT_EQ(events, expected);
+}
+
+TEST(StreamDispatcherTest, PoolKeepsEachStreamInOrder) {
+  constexpr int kStreams = 200;
+  constexpr int kChunks = 40;
+
+  struct Seen {
+    std::atomic<bool> busy{false};
+    std::atomic<bool> overlapped{false};
+    int next = 0; // Only touched by this stream's callbacks.
+    bool in_order = true;
+    std::atomic<bool> closed{false};
+  };
+  std::vector<Seen> seen(kStreams);
+  std::atomic<int> closed{0};
+
+  StreamDispatcher dispatcher;
+  dispatcher.setWorkerThreads(4);
+  for (int i = 0; i < kStreams; ++i) {
+    ByteStreamInfo info;
+    info.stream_id = std::to_string(i);
+    dispatcher.openByte(
+        info, "bob",
+        [&seen, &closed, i](const ByteStreamInfo &, const std::string &) {
+          Seen *s = &seen[i];
+          ByteStreamCallbacks callbacks;
+          callbacks.on_chunk = [s](const std::uint8_t *data, std::size_t n) {
+            if (s->busy.exchange(true)) {
+              s->overlapped = true;
+            }
+            if (n != 1 || data[0] != static_cast<std::uint8_t>(s->next)) {
+              s->in_order = false;
+            }
+            ++s->next;
+            s->busy = false;
+          };
+          callbacks.on_close = [s, &closed](const ByteStreamInfo &, bool) {
+            s->closed = true;
+            closed.fetch_add(1);
+          };
+          return callbacks;
+        },
+        nullptr);
+  }
+  // Interleave the streams the way a busy room would.
+  for (int c = 0; c < kChunks; ++c) {
+    for (int i = 0; i < kStreams; ++i) {
+      ASSERT_TRUE(dispatcher.chunk(std::to_string(i),
+                                   std::string(1, static_cast<char>(c))));
+    }
+  }
+  for (int i = 0; i < kStreams; ++i) {
+    dispatcher.close(std::to_string(i), {});
+  }
+  // Joining the pool runs everything still queued.
+  dispatcher.setWorkerThreads(0);
+
+  EXPECT_EQ(closed.load(), kStreams);
+  for (const Seen &s : seen) {
+    EXPECT_FALSE(s.overlapped.load());
+    EXPECT_TRUE(s.in_order);
+    EXPECT_EQ(s.next, kChunks);
+    EXPECT_TRUE(s.closed.load());
+  }
+}
+
+TEST(StreamDispatcherTest, SlowCallbacksHitTheBudget) {
+  StreamBufferOptions limits;
+  limits.max_reader_bytes = 8;
+  limits.policy = StreamOverflowPolicy::kDropStream;
+  auto budget = std::make_shared<StreamBudget>(limits);
+
+  ManualExecutor manual;
+  StreamDispatcher dispatcher;
+  dispatcher.setExecutor(manual.executor());
+
+  std::string received;
+  int closes = 0;
+  bool was_dropped = false;
+  dispatcher.openText(
+      textInfo("s1"), "alice",
+      [&](const TextStreamInfo &, const std::string &) {
+        TextStreamCallbacks callbacks;
+        callbacks.on_chunk = [&](const std::string &t) { received += t; };
+        callbacks.on_close = [&](const TextStreamInfo &, bool dropped) {
+          ++closes;
+          was_dropped = dropped;
+        };
+        return callbacks;
+      },
+      budget);
+
+  // Nothing runs yet, so queued chunks stay charged.
+  EXPECT_TRUE(dispatcher.chunk("s1", "123456"));
+  EXPECT_EQ(budget->stats().buffered_bytes, 6u);
+  EXPECT_TRUE(dispatcher.chunk("s1", "789"));
+  EXPECT_EQ(dispatcher.openStreams(), 0u);
+  EXPECT_FALSE(dispatcher.chunk("s1", "late"));
+  EXPECT_FALSE(dispatcher.close("s1", {}));
+
+  manual.runAll();
+  EXPECT_EQ(received, "123456");
+  EXPECT_EQ(closes, 1);
+  EXPECT_TRUE(was_dropped);
+  EXPECT_EQ(budget->stats().buffered_bytes, 0u);
+  EXPECT_EQ(budget->stats().dropped_streams, 1u);
+  dispatcher.setExecutor(nullptr);
+}
+
+TEST(StreamDispatcherTest, ThrowingCallbacksAndAbortAreContained) {
+  StreamDispatcher dispatcher;
+  int closes = 0;
+  int dropped_closes = 0;
+  dispatcher.openText(
+      textInfo("bad"), "alice",
+      [](const TextStreamInfo &, const std::string &) -> TextStreamCallbacks {
+        throw std::runtime_error("no callbacks for you");
+      },
+      nullptr);
+  dispatcher.openText(
+      textInfo("good"), "alice",
+      [&](const TextStreamInfo &, const std::string &) {
+        TextStreamCallbacks callbacks;
+        callbacks.on_chunk = [](const std::string &) {
+          throw std::runtime_error("chunk failed");
+        };
+        callbacks.on_close = [&](const TextStreamInfo &, bool dropped) {
+          ++closes;
+          dropped_closes += dropped ? 1 : 0;
+        };
+        return callbacks;
+      },
+      nullptr);
+  EXPECT_TRUE(dispatcher.chunk("bad", "x"));
+  EXPECT_TRUE(dispatcher.chunk("good", "x"));
+  EXPECT_EQ(dispatcher.openStreams(), 2u);
+
+  dispatcher.abortAll();
+  EXPECT_EQ(dispatcher.openStreams(), 0u);
+  EXPECT_EQ(closes, 1);
+  EXPECT_EQ(dropped_closes, 1);
+}
+
+} // namespace test
+} // namespace livekit
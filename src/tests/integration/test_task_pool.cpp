@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "task_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+using detail::TaskPool;
+
+TEST(TaskPoolTest, SingleWorkerRunsInOrder) {
+  std::vector<int> order;
+  {
+    TaskPool pool(1);
+    EXPECT_EQ(pool.threadCount(), 1u);
+    for (int i = 0; i < 100; ++i) {
+      pool.post([&order, i] { order.push_back(i); });
+    }
+  }
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+}
+
+TEST(TaskPoolTest, SlowTaskDoesNotBlockOthers) {
+  std::atomic<bool> release{false};
+  std::atomic<int> done{0};
+  TaskPool pool(2);
+  pool.post([&] {
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  pool.post([&] { ++done; });
+
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (done == 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(done, 1);
+  release = true;
+}
+
+TEST(TaskPoolTest, DestructorDrainsAndSurvivesThrowingTasks) {
+  std::atomic<int> ran{0};
+  {
+    TaskPool pool(0); // clamped to one worker
+    pool.post([] { throw std::runtime_error("boom"); });
+    for (int i = 0; i < 10; ++i) {
+      pool.post([&] { ++ran; });
+    }
+  }
+  EXPECT_EQ(ran, 10);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "livekit/thread_options.h"
+#include "sdk_metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace livekit {
+namespace {
+
+const ThreadCpuStats *findThread(const std::vector<ThreadCpuStats> &stats,
+                                 const std::string &name) {
+  auto it = std::find_if(
+      stats.begin(), stats.end(),
+      [&](const ThreadCpuStats &s) { return s.name == name; });
+  return it == stats.end() ? nullptr : &*it;
+}
+
+TEST(ThreadOptionsTest, RegisteredThreadReportsCpuTimeUntilExit) {
+  std::atomic<bool> registered{false};
+  std::atomic<bool> done{false};
+  std::thread worker([&] {
+    EXPECT_TRUE(applyThreadRole(ThreadRole::kAudio, "lk-test-audio"));
+    registered = true;
+    // Burn some CPU so the clock visibly advances.
+    const auto until =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(30);
+    volatile std::uint64_t sink = 0;
+    while (std::chrono::steady_clock::now() < until) {
+      sink = sink + 1;
+    }
+    while (!done) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  while (!registered) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+
+  const auto stats = threadCpuStats();
+  const ThreadCpuStats *entry = findThread(stats, "lk-test-audio");
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->role, ThreadRole::kAudio);
+  EXPECT_TRUE(entry->placement_error.empty());
+#if defined(__linux__) || defined(_WIN32) || defined(__APPLE__)
+  EXPECT_GT(entry->cpu_time.count(), 0);
+#endif
+
+  done = true;
+  worker.join();
+  EXPECT_EQ(findThread(threadCpuStats(), "lk-test-audio"), nullptr);
+}
+
+TEST(ThreadOptionsTest, PlacementFailuresAreReportedNotThrown) {
+  ThreadOptions options;
+  options.audio.priority = ThreadPriority::kRealtime;
+  configureThreads(options);
+  std::thread worker([] {
+    // Without real-time privileges this fails; either way it must not throw
+    // and the result must match the recorded error.
+    const bool ok = applyThreadRole(ThreadRole::kAudio, "lk-test-rt");
+    const ThreadCpuStats *entry = findThread(threadCpuStats(), "lk-test-rt");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(ok, entry->placement_error.empty());
+  });
+  worker.join();
+  configureThreads(ThreadOptions{});
+}
+
+#if defined(__linux__)
+TEST(ThreadOptionsTest, PinsThreadToConfiguredCpu) {
+  ThreadOptions options;
+  options.media_clock.cpus = {0};
+  configureThreads(options);
+  std::thread worker([] {
+    EXPECT_TRUE(applyThreadRole(ThreadRole::kMediaClock, "lk-test-pin"));
+    EXPECT_EQ(sched_getcpu(), 0);
+  });
+  worker.join();
+  configureThreads(ThreadOptions{});
+}
+#endif
+
+TEST(ThreadOptionsTest, CpuTimeIsExportedAsOpenMetrics) {
+  detail::SdkMetrics sdk;
+  RpcMetrics rpc;
+  detail::ScrapeGauges gauges;
+  ThreadCpuStats t;
+  t.name = "lk-dispatch-0";
+  t.role = ThreadRole::kEventDispatch;
+  t.cpu_time = std::chrono::microseconds(1500000);
+  gauges.threads.push_back(t);
+  const std::string text = detail::renderOpenMetrics(sdk, rpc, gauges);
+  EXPECT_NE(text.find("livekit_thread_cpu_seconds_total{thread=\"lk-dispatch-"
+                      "0\",role=\"event_dispatch\"} 1.500000"),
+            std::string::npos);
+}
+
+} // namespace
+} // namespace livekit
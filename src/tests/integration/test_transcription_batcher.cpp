@@ -0,0 +1,236 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "transcription_batcher.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+using detail::TranscriptionBatcher;
+
+namespace {
+
+struct SentBatch {
+  std::string identity;
+  std::string track_sid;
+  std::vector<TranscriptionSegment> segments;
+};
+
+// Records requests, standing in for the FFI; every request completes at
+// once, failing while `fail` is set.
+class SendLog {
+public:
+  TranscriptionBatcher::SendFn sender() {
+    return [this](const std::string &identity, const std::string &track,
+                  const std::vector<TranscriptionSegment> &segments) {
+      std::promise<void> done;
+      std::lock_guard<std::mutex> lock(mutex_);
+      sent_.push_back(SentBatch{identity, track, segments});
+      if (fail) {
+        done.set_exception(
+            std::make_exception_ptr(std::runtime_error("rejected")));
+      } else {
+        done.set_value();
+      }
+      cv_.notify_all();
+      return done.get_future();
+    };
+  }
+
+  bool waitFor(std::size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::seconds(5),
+                        [&] { return sent_.size() >= count; });
+  }
+
+  std::vector<SentBatch> sent() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sent_;
+  }
+
+  bool fail = false;
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<SentBatch> sent_;
+};
+
+TranscriptionSegment segment(const std::string &id, const std::string &text,
+                             bool is_final = false) {
+  TranscriptionSegment s;
+  s.id = id;
+  s.text = text;
+  s.is_final = is_final;
+  s.language = "en";
+  return s;
+}
+
+TranscriptionOptions window(std::chrono::milliseconds ms) {
+  TranscriptionOptions options;
+  options.batch_window = ms;
+  return options;
+}
+
+} // namespace
+
+TEST(TranscriptionBatcherTest, CoalescesInterimUpdatesWithinWindow) {
+  SendLog log;
+  TranscriptionBatcher batcher(log.sender(),
+                               window(std::chrono::milliseconds(50)));
+  for (int i = 0; i < 10; ++i) {
+    batcher.publish("alice", "TR_1", {segment("s1", std::to_string(i))});
+  }
+  ASSERT_TRUE(log.waitFor(1));
+
+  const auto sent = log.sent();
+  ASSERT_EQ(sent.size(), 1u);
+  EXPECT_EQ(sent[0].identity, "alice");
+  EXPECT_EQ(sent[0].track_sid, "TR_1");
+  ASSERT_EQ(sent[0].segments.size(), 1u);
+  EXPECT_EQ(sent[0].segments[0].text, "9");
+
+  const auto stats = batcher.stats();
+  EXPECT_EQ(stats.segments_submitted, 10u);
+  EXPECT_EQ(stats.segments_coalesced, 9u);
+  EXPECT_EQ(stats.batches_sent, 1u);
+}
+
+TEST(TranscriptionBatcherTest, FinalSegmentIsSentWithoutWaiting) {
+  SendLog log;
+  TranscriptionBatcher batcher(log.sender(), window(std::chrono::hours(1)));
+  batcher.publish("alice", "TR_1", {segment("s1", "hel")});
+  batcher.publish("alice", "TR_1",
+                  {segment("s1", "hello", true), segment("s2", "wor")});
+  ASSERT_TRUE(log.waitFor(1));
+
+  const auto sent = log.sent();
+  ASSERT_EQ(sent[0].segments.size(), 2u);
+  EXPECT_EQ(sent[0].segments[0].text, "hello");
+  EXPECT_TRUE(sent[0].segments[0].is_final);
+  EXPECT_EQ(sent[0].segments[1].text, "wor");
+}
+
+TEST(TranscriptionBatcherTest, StaleInterimDoesNotReplaceFinal) {
+  SendLog log;
+  TranscriptionBatcher batcher(log.sender(), window(std::chrono::hours(1)));
+  batcher.publish("alice", "TR_1",
+                  {segment("s1", "done", true), segment("s1", "don")});
+  ASSERT_TRUE(log.waitFor(1));
+  const auto sent = log.sent();
+  ASSERT_EQ(sent[0].segments.size(), 1u);
+  EXPECT_EQ(sent[0].segments[0].text, "done");
+  EXPECT_TRUE(sent[0].segments[0].is_final);
+}
+
+TEST(TranscriptionBatcherTest, BatchesPerParticipantAndTrack) {
+  SendLog log;
+  TranscriptionBatcher batcher(log.sender(), window(std::chrono::hours(1)));
+  batcher.publish("alice", "TR_1", {segment("a", "1")});
+  batcher.publish("alice", "TR_2", {segment("a", "2")});
+  batcher.publish("bob", "TR_1", {segment("a", "3")});
+  batcher.publish("alice", "TR_1", {segment("b", "4")});
+  batcher.flush();
+
+  const auto sent = log.sent();
+  ASSERT_EQ(sent.size(), 3u);
+  for (const auto &batch : sent) {
+    if (batch.identity == "alice" && batch.track_sid == "TR_1") {
+      ASSERT_EQ(batch.segments.size(), 2u);
+      EXPECT_EQ(batch.segments[0].id, "a");
+      EXPECT_EQ(batch.segments[1].id, "b");
+    } else {
+      EXPECT_EQ(batch.segments.size(), 1u);
+    }
+  }
+  EXPECT_EQ(batcher.stats().segments_coalesced, 0u);
+}
+
+TEST(TranscriptionBatcherTest, FullBatchIsSentEarly) {
+  SendLog log;
+  auto options = window(std::chrono::hours(1));
+  options.max_batch_segments = 3;
+  TranscriptionBatcher batcher(log.sender(), options);
+  batcher.publish("alice", "TR_1", {segment("a", "1"), segment("b", "2")});
+  batcher.publish("alice", "TR_1", {segment("c", "3")});
+  ASSERT_TRUE(log.waitFor(1));
+  EXPECT_EQ(log.sent()[0].segments.size(), 3u);
+}
+
+TEST(TranscriptionBatcherTest, FlushReportsFailedRequests) {
+  SendLog log;
+  log.fail = true;
+  TranscriptionBatcher batcher(log.sender(), window(std::chrono::hours(1)));
+  batcher.publish("alice", "TR_1", {segment("a", "1")});
+  EXPECT_THROW(batcher.flush(), std::runtime_error);
+  EXPECT_EQ(batcher.stats().send_failures, 1u);
+
+  // The failure was reported once; nothing is left to flush.
+  EXPECT_NO_THROW(batcher.flush());
+}
+
+TEST(TranscriptionBatcherTest, RejectsMissingIds) {
+  SendLog log;
+  TranscriptionBatcher batcher(log.sender(), TranscriptionOptions{});
+  EXPECT_THROW(batcher.publish("alice", "", {segment("a", "1")}),
+               std::invalid_argument);
+  EXPECT_THROW(batcher.publish("alice", "TR_1", {segment("", "1")}),
+               std::invalid_argument);
+  EXPECT_EQ(batcher.stats().segments_submitted, 0u);
+}
+
+TEST(TranscriptionBatcherTest, StopSendsWaitingAndLaterDirectly) {
+  SendLog log;
+  TranscriptionBatcher batcher(log.sender(), window(std::chrono::hours(1)));
+  batcher.publish("alice", "TR_1", {segment("a", "1")});
+  batcher.publish("bob", "TR_2", {segment("b", "1")});
+  batcher.stop();
+  auto sent = log.sent();
+  ASSERT_EQ(sent.size(), 2u);
+  EXPECT_EQ(sent[0].identity, "alice");
+  EXPECT_EQ(sent[1].identity, "bob");
+  EXPECT_EQ(batcher.stats().batches_sent, 2u);
+
+  batcher.publish("alice", "TR_1", {segment("a", "2")});
+  sent = log.sent();
+  ASSERT_EQ(sent.size(), 3u);
+  EXPECT_EQ(sent[2].segments[0].text, "2");
+}
+
+TEST(TranscriptionBatcherTest, StopLogsAFailedFinalSend) {
+  TranscriptionBatcher throwing(
+      [](const std::string &, const std::string &,
+         const std::vector<TranscriptionSegment> &) -> std::future<void> {
+        throw std::runtime_error("room gone");
+      },
+      window(std::chrono::hours(1)));
+  throwing.publish("alice", "TR_1", {segment("a", "1")});
+  EXPECT_NO_THROW(throwing.stop());
+  EXPECT_EQ(throwing.stats().send_failures, 1u);
+}
+
+} // namespace test
+} // namespace livekit
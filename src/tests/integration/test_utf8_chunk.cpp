@@ -0,0 +1,106 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "utf8_chunk.h"
+
+namespace livekit {
+namespace test {
+
+using detail::utf8ChunkEnd;
+
+namespace {
+
+std::size_t chunkEnd(const std::string &s, std::size_t begin,
+                     std::size_t max_bytes) {
+  return utf8ChunkEnd(s.data(), begin, s.size(), max_bytes);
+}
+
+} // namespace
+
+TEST(Utf8ChunkTest, PureAsciiCutsAtLimit) {
+  const std::string s = "hello world";
+  EXPECT_EQ(chunkEnd(s, 0, 4), 4u);
+  EXPECT_EQ(chunkEnd(s, 4, 4), 8u);
+  EXPECT_EQ(chunkEnd(s, 8, 4), s.size()) << "Tail shorter than the limit";
+  EXPECT_EQ(chunkEnd(s, 0, 100), s.size());
+}
+
+TEST(Utf8ChunkTest, TwoByteSequenceStraddlingLimit) {
+  const std::string s = "a\xC3\xA9z"; // a é z
+  EXPECT_EQ(chunkEnd(s, 0, 2), 1u) << "Must not split C3 A9";
+  EXPECT_EQ(chunkEnd(s, 0, 3), 3u);
+}
+
+TEST(Utf8ChunkTest, ThreeByteSequenceStraddlingLimit) {
+  const std::string s = "ab\xE2\x82\xAC"; // a b €
+  EXPECT_EQ(chunkEnd(s, 0, 3), 2u);
+  EXPECT_EQ(chunkEnd(s, 0, 4), 2u);
+  EXPECT_EQ(chunkEnd(s, 2, 3), s.size());
+}
+
+TEST(Utf8ChunkTest, FourByteSequenceStraddlingLimit) {
+  const std::string s = "a\xF0\x9F\x98\x80" "b"; // a 😀 b
+  EXPECT_EQ(chunkEnd(s, 0, 2), 1u);
+  EXPECT_EQ(chunkEnd(s, 0, 3), 1u);
+  EXPECT_EQ(chunkEnd(s, 0, 4), 1u);
+  EXPECT_EQ(chunkEnd(s, 0, 5), 5u);
+  EXPECT_EQ(chunkEnd(s, 1, 4), 5u);
+}
+
+TEST(Utf8ChunkTest, LimitSmallerThanOneCodePointHardCuts) {
+  const std::string s = "\xE2\x82\xAC\xE2\x82\xAC"; // €€
+  // No boundary fits in two bytes; the chunker still makes progress.
+  EXPECT_EQ(chunkEnd(s, 0, 2), 2u);
+  EXPECT_EQ(chunkEnd(s, 0, 1), 1u);
+}
+
+TEST(Utf8ChunkTest, InvalidOrTruncatedLeadBytes) {
+  // Only continuation bytes: no boundary exists, hard cut at the limit.
+  const std::string stray = "\x80\x80\x80\x80";
+  EXPECT_EQ(chunkEnd(stray, 0, 2), 2u);
+
+  // Truncated lead byte followed by ASCII is cut like any other byte.
+  const std::string truncated = "a\xE2" "bc";
+  EXPECT_EQ(chunkEnd(truncated, 0, 2), 2u);
+
+  // Truncated sequence at the end of input is returned whole.
+  const std::string tail = "ab\xE2\x82";
+  EXPECT_EQ(chunkEnd(tail, 0, 16), tail.size());
+}
+
+TEST(Utf8ChunkTest, ChunksReassembleWithoutSplittingCodePoints) {
+  const std::string s = "x\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80y";
+  std::string joined;
+  std::size_t begin = 0;
+  while (begin < s.size()) {
+    const std::size_t end = chunkEnd(s, begin, 4);
+    ASSERT_GT(end, begin);
+    ASSERT_LE(end - begin, 4u);
+    if (end < s.size()) {
+      EXPECT_NE(static_cast<unsigned char>(s[end]) & 0xC0, 0x80);
+    }
+    joined.append(s, begin, end - begin);
+    begin = end;
+  }
+  EXPECT_EQ(joined, s);
+}
+
+} // namespace test
+} // namespace livekit
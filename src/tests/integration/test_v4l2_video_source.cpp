@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/v4l2_video_source.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace livekit {
+namespace test {
+
+TEST(V4L2VideoSourceTest, MissingDeviceThrows) {
+  V4L2VideoSource::Options options;
+  options.device = "/nonexistent/video99";
+  try {
+    V4L2VideoSource camera(options);
+    FAIL() << "expected std::runtime_error";
+  } catch (const std::runtime_error &e) {
+    EXPECT_NE(std::string(e.what()).find("V4L2VideoSource"),
+              std::string::npos);
+  }
+}
+
+#if defined(__linux__)
+TEST(V4L2VideoSourceTest, NonCaptureDeviceThrows) {
+  V4L2VideoSource::Options options;
+  options.device = "/dev/null";
+  try {
+    V4L2VideoSource camera(options);
+    FAIL() << "expected std::runtime_error";
+  } catch (const std::runtime_error &e) {
+    EXPECT_NE(std::string(e.what()).find("not a V4L2 device"),
+              std::string::npos);
+  }
+}
+#endif
+
+TEST(V4L2VideoSourceTest, NullSourceIsRejected) {
+  EXPECT_THROW(V4L2VideoSource(nullptr, V4L2VideoSource::Options{}),
+               std::invalid_argument);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/video_compositor.h>
+
+#include "video_scale.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+VideoFrame solidRgba(int w, int h, std::uint8_t r, std::uint8_t g,
+                     std::uint8_t b) {
+  VideoFrame frame = VideoFrame::create(w, h, VideoBufferType::RGBA);
+  for (int i = 0; i < w * h; ++i) {
+    std::uint8_t *px = frame.data() + i * 4;
+    px[0] = r;
+    px[1] = g;
+    px[2] = b;
+    px[3] = 255;
+  }
+  return frame;
+}
+
+const std::uint8_t *rgbaAt(const VideoFrame &frame, int x, int y) {
+  return frame.data() + (static_cast<std::size_t>(y) * frame.width() + x) * 4;
+}
+
+VideoCompositor::Options manualOptions(int w, int h, VideoBufferType type) {
+  VideoCompositor::Options options;
+  options.width = w;
+  options.height = h;
+  options.format = type;
+  options.fps = 0;
+  options.threads = 1;
+  return options;
+}
+
+} // namespace
+
+TEST(VideoCompositorTest, LetterboxesIntoTheGrid) {
+  auto options = manualOptions(8, 4, VideoBufferType::RGBA);
+  options.background = {10, 20, 30};
+  VideoCompositor compositor(options);
+  const int id = compositor.addInput();
+  compositor.pushFrame(id, solidRgba(4, 4, 250, 0, 0));
+
+  VideoFrame canvas = compositor.composeFrame();
+  ASSERT_EQ(canvas.width(), 8);
+  ASSERT_EQ(canvas.type(), VideoBufferType::RGBA);
+  for (int y = 0; y < 4; ++y) {
+    for (int x = 0; x < 8; ++x) {
+      const bool inside = x >= 2 && x < 6;
+      EXPECT_EQ(rgbaAt(canvas, x, y)[0], inside ? 250 : 10) << x << "," << y;
+      EXPECT_EQ(rgbaAt(canvas, x, y)[2], inside ? 0 : 30) << x << "," << y;
+    }
+  }
+  EXPECT_EQ(compositor.stats().frames_composed, 1u);
+}
+
+TEST(VideoCompositorTest, RowBandsMatchSingleThreadedOutput) {
+  auto single = manualOptions(160, 90, VideoBufferType::I420);
+  single.keep_aspect = false;
+  auto banded = single;
+  banded.threads = 4;
+  VideoCompositor a(single);
+  VideoCompositor b(banded);
+
+  // Five inputs make a 3x2 grid with uneven slots and a hole.
+  for (int i = 0; i < 5; ++i) {
+    VideoFrame src = VideoFrame::create(64 + i * 10, 48, VideoBufferType::RGBA);
+    for (std::size_t k = 0; k < src.dataSize(); ++k) {
+      src.data()[k] = static_cast<std::uint8_t>(k * 7 + i * 31);
+    }
+    const int ia = a.addInput();
+    const int ib = b.addInput();
+    a.pushFrame(ia, src.toOwned());
+    b.pushFrame(ib, std::move(src));
+  }
+  EXPECT_EQ(a.stats().converted_frames, 5u);
+
+  VideoFrame fa = a.composeFrame();
+  VideoFrame fb = b.composeFrame();
+  ASSERT_EQ(fa.dataSize(), fb.dataSize());
+  EXPECT_EQ(std::memcmp(fa.data(), fb.data(), fa.dataSize()), 0);
+}
+
+TEST(VideoCompositorTest, BlendsTilesInZOrder) {
+  auto options = manualOptions(40, 4, VideoBufferType::RGBA);
+  options.keep_aspect = false;
+  options.threads = 2;
+  VideoCompositor compositor(options);
+
+  VideoCompositor::InputOptions top;
+  top.rect = VideoCompositorRect{0, 0, 37, 4};
+  top.z_order = 1;
+  top.opacity = 0.5f;
+  VideoCompositor::InputOptions bottom;
+  bottom.rect = VideoCompositorRect{0, 0, 40, 4};
+  // Added first but drawn second would hide the blend; z decides.
+  const int t = compositor.addInput(top);
+  const int b = compositor.addInput(bottom);
+  compositor.pushFrame(t, solidRgba(8, 8, 200, 100, 0));
+  compositor.pushFrame(b, solidRgba(8, 8, 100, 100, 100));
+
+  VideoFrame canvas = compositor.composeFrame();
+  for (int x = 0; x < 40; ++x) {
+    const std::uint8_t *px = rgbaAt(canvas, x, 3);
+    if (x < 37) {
+      // (200 * 128 + 100 * 128 + 128) >> 8, SIMD body and scalar tail alike.
+      EXPECT_EQ(px[0], 150) << x;
+      EXPECT_EQ(px[2], 50) << x;
+    } else {
+      EXPECT_EQ(px[0], 100) << x;
+    }
+  }
+
+  VideoCompositor::InputOptions hidden = top;
+  hidden.opacity = 0.0f;
+  compositor.updateInput(t, hidden);
+  canvas = compositor.composeFrame();
+  EXPECT_EQ(rgbaAt(canvas, 0, 0)[0], 100);
+}
+
+TEST(VideoCompositorTest, RowRangesComposeToTheWholeScale) {
+  VideoFrame src = VideoFrame::create(97, 61, VideoBufferType::I420);
+  for (std::size_t k = 0; k < src.dataSize(); ++k) {
+    src.data()[k] = static_cast<std::uint8_t>(k * 13);
+  }
+  VideoFrame whole = VideoFrame::create(40, 30, VideoBufferType::I420);
+  VideoFrame banded = VideoFrame::create(40, 30, VideoBufferType::I420);
+  ASSERT_TRUE(detail::scaleNative(src, whole));
+  ASSERT_TRUE(detail::scaleNativeRows(src, banded, 0, 12));
+  ASSERT_TRUE(detail::scaleNativeRows(src, banded, 12, 30));
+  EXPECT_EQ(std::memcmp(whole.data(), banded.data(), whole.dataSize()), 0);
+  EXPECT_FALSE(detail::scaleNativeRows(src, banded, 10, 10));
+  EXPECT_FALSE(detail::scaleNativeRows(src, banded, 0, 31));
+}
+
+TEST(VideoCompositorTest, TicksAtTheFrameRate) {
+  VideoCompositor::Options options;
+  options.width = 64;
+  options.height = 36;
+  options.fps = 100;
+  options.threads = 2;
+  std::atomic<int> frames{0};
+  options.on_frame = [&](const VideoFrame &frame, std::int64_t) {
+    EXPECT_EQ(frame.width(), 64);
+    frames.fetch_add(1);
+  };
+  {
+    VideoCompositor compositor(options);
+    compositor.pushFrame(compositor.addInput(),
+                         VideoFrame::create(16, 16, VideoBufferType::I420));
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  }
+  EXPECT_GE(frames.load(), 3);
+}
+
+TEST(VideoCompositorTest, RejectsBadArguments) {
+  EXPECT_THROW(VideoCompositor(manualOptions(64, 64, VideoBufferType::NV12)),
+               std::invalid_argument);
+  EXPECT_THROW(VideoCompositor(manualOptions(1, 64, VideoBufferType::I420)),
+               std::invalid_argument);
+
+  VideoCompositor compositor(manualOptions(64, 64, VideoBufferType::I420));
+  EXPECT_THROW(compositor.pushFrame(
+                   42, VideoFrame::create(2, 2, VideoBufferType::I420)),
+               std::invalid_argument);
+  EXPECT_THROW(compositor.updateInput(42, {}), std::invalid_argument);
+  const int id = compositor.addInput();
+  EXPECT_EQ(compositor.inputCount(), 1u);
+  compositor.removeInput(id);
+  compositor.removeInput(id);
+  EXPECT_EQ(compositor.inputCount(), 0u);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/frame_pool.h>
+#include <livekit/video_frame.h>
+
+#include "video_convert.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+int clamp255(int v) { return v < 0 ? 0 : (v > 255 ? 255 : v); }
+
+// Reference BT.601 limited-range conversion for one pixel.
+void referenceRgb(int y, int u, int v, int &r, int &g, int &b) {
+  const int c = y - 16, d = u - 128, e = v - 128;
+  r = clamp255((298 * c + 409 * e + 128) >> 8);
+  g = clamp255((298 * c - 100 * d - 208 * e + 128) >> 8);
+  b = clamp255((298 * c + 516 * d + 128) >> 8);
+}
+
+VideoFrame randomI420(int w, int h, unsigned seed) {
+  VideoFrame frame = VideoFrame::create(w, h, VideoBufferType::I420);
+  std::mt19937 rng(seed);
+  for (std::size_t i = 0; i < frame.dataSize(); ++i) {
+    frame.data()[i] = static_cast<std::uint8_t>(rng());
+  }
+  return frame;
+}
+
+} // namespace
+
+TEST(VideoConvertTest, I420ToRgbaMatchesReference) {
+  // Odd width exercises both the SIMD body and the scalar tail.
+  const int w = 37, h = 5;
+  VideoFrame src = randomI420(w, h, 1);
+  VideoFrame rgba = src.convert(VideoBufferType::RGBA);
+  ASSERT_EQ(rgba.type(), VideoBufferType::RGBA);
+
+  const auto planes = src.planeInfos();
+  const auto *yp = reinterpret_cast<const std::uint8_t *>(planes[0].data_ptr);
+  const auto *up = reinterpret_cast<const std::uint8_t *>(planes[1].data_ptr);
+  const auto *vp = reinterpret_cast<const std::uint8_t *>(planes[2].data_ptr);
+  for (int y = 0; y < h; ++y) {
+    for (int x = 0; x < w; ++x) {
+      const int ci = (y / 2) * static_cast<int>(planes[1].stride) + x / 2;
+      int r, g, b;
+      referenceRgb(yp[y * w + x], up[ci], vp[ci], r, g, b);
+      const std::uint8_t *px = rgba.data() + (y * w + x) * 4;
+      ASSERT_EQ(px[0], r) << "x=" << x << " y=" << y;
+      ASSERT_EQ(px[1], g) << "x=" << x << " y=" << y;
+      ASSERT_EQ(px[2], b) << "x=" << x << " y=" << y;
+      ASSERT_EQ(px[3], 255);
+    }
+  }
+}
+
+TEST(VideoConvertTest, Nv12MatchesI420) {
+  const int w = 24, h = 4;
+  VideoFrame i420 = randomI420(w, h, 2);
+  VideoFrame nv12 = VideoFrame::create(w, h, VideoBufferType::NV12);
+
+  // Build the NV12 copy by hand: same Y, interleaved U/V.
+  const auto src = i420.planeInfos();
+  const auto dst = nv12.planeInfos();
+  std::memcpy(reinterpret_cast<void *>(dst[0].data_ptr),
+              reinterpret_cast<const void *>(src[0].data_ptr), src[0].size);
+  auto *uv = reinterpret_cast<std::uint8_t *>(dst[1].data_ptr);
+  const auto *u = reinterpret_cast<const std::uint8_t *>(src[1].data_ptr);
+  const auto *v = reinterpret_cast<const std::uint8_t *>(src[2].data_ptr);
+  for (std::uint32_t i = 0; i < src[1].size; ++i) {
+    uv[2 * i] = u[i];
+    uv[2 * i + 1] = v[i];
+  }
+
+  VideoFrame a = i420.convert(VideoBufferType::BGRA);
+  VideoFrame b = nv12.convert(VideoBufferType::BGRA);
+  ASSERT_EQ(a.dataSize(), b.dataSize());
+  EXPECT_EQ(std::memcmp(a.data(), b.data(), a.dataSize()), 0);
+}
+
+TEST(VideoConvertTest, RgbRoundTripIsClose) {
+  const int w = 16, h = 16;
+  VideoFrame rgba = VideoFrame::create(w, h, VideoBufferType::RGBA);
+  for (int i = 0; i < w * h; ++i) {
+    std::uint8_t *px = rgba.data() + i * 4;
+    px[0] = 200;
+    px[1] = 40;
+    px[2] = 90;
+    px[3] = 255;
+  }
+  VideoFrame i420 = rgba.convert(VideoBufferType::I420);
+  VideoFrame back = i420.convert(VideoBufferType::RGBA);
+  for (int i = 0; i < w * h; ++i) {
+    const std::uint8_t *px = back.data() + i * 4;
+    EXPECT_NEAR(px[0], 200, 3);
+    EXPECT_NEAR(px[1], 40, 3);
+    EXPECT_NEAR(px[2], 90, 3);
+  }
+}
+
+TEST(VideoConvertTest, SwizzleAndFlip) {
+  VideoFrame rgba = VideoFrame::create(1, 2, VideoBufferType::RGBA);
+  const std::uint8_t top[4] = {1, 2, 3, 4};
+  const std::uint8_t bottom[4] = {5, 6, 7, 8};
+  std::memcpy(rgba.data(), top, 4);
+  std::memcpy(rgba.data() + 4, bottom, 4);
+
+  VideoFrame bgra = rgba.convert(VideoBufferType::BGRA, /*flip_y=*/true);
+  const std::uint8_t expected[8] = {7, 6, 5, 8, 3, 2, 1, 4};
+  EXPECT_EQ(std::memcmp(bgra.data(), expected, 8), 0);
+
+  VideoFrame flipped = rgba.convert(VideoBufferType::RGBA, /*flip_y=*/true);
+  EXPECT_EQ(std::memcmp(flipped.data(), bottom, 4), 0);
+  EXPECT_EQ(std::memcmp(flipped.data() + 4, top, 4), 0);
+}
+
+TEST(VideoConvertTest, ConvertIntoReusesDestination) {
+  VideoFramePool pool;
+  VideoFrame src = randomI420(32, 32, 3);
+  VideoFrame dst = pool.acquire(32, 32, VideoBufferType::ARGB);
+  const std::uint8_t *before = dst.data();
+
+  src.convertInto(dst);
+  EXPECT_EQ(dst.data(), before);
+
+  VideoFrame expected = src.convert(VideoBufferType::ARGB);
+  EXPECT_EQ(std::memcmp(dst.data(), expected.data(), dst.dataSize()), 0);
+}
+
+TEST(VideoConvertTest, ConvertIntoRejectsMismatchedSize) {
+  VideoFrame src = VideoFrame::create(16, 16, VideoBufferType::I420);
+  VideoFrame dst = VideoFrame::create(8, 8, VideoBufferType::RGBA);
+  EXPECT_THROW(src.convertInto(dst), std::invalid_argument);
+}
+
+TEST(VideoConvertTest, YuyvToI422Deinterleaves) {
+  // 37 pixels: two SIMD steps, scalar pairs, and a half-used last pair.
+  const int w = 37, h = 3;
+  const int stride = 2 * (w + 1) + 6; // padded rows, as from a driver
+  std::vector<std::uint8_t> yuyv(static_cast<std::size_t>(stride) * h);
+  std::mt19937 rng(7);
+  for (auto &b : yuyv) {
+    b = static_cast<std::uint8_t>(rng());
+  }
+
+  VideoFrame dst = VideoFrame::create(w, h, VideoBufferType::I422);
+  ASSERT_TRUE(detail::yuyvToI422(yuyv.data(), stride, dst));
+  const auto planes = dst.planeInfos();
+  ASSERT_EQ(planes.size(), 3u);
+  auto at = [&](int plane, int x, int y) {
+    return reinterpret_cast<const std::uint8_t *>(
+        planes[plane].data_ptr)[y * planes[plane].stride + x];
+  };
+  for (int y = 0; y < h; ++y) {
+    const std::uint8_t *row = yuyv.data() + y * stride;
+    for (int x = 0; x < w; ++x) {
+      ASSERT_EQ(at(0, x, y), row[2 * x]) << "Y at " << x << "," << y;
+    }
+    for (int x = 0; x < (w + 1) / 2; ++x) {
+      ASSERT_EQ(at(1, x, y), row[4 * x + 1]) << "U at " << x << "," << y;
+      ASSERT_EQ(at(2, x, y), row[4 * x + 3]) << "V at " << x << "," << y;
+    }
+  }
+
+  VideoFrame wrong = VideoFrame::create(w, h, VideoBufferType::I420);
+  EXPECT_FALSE(detail::yuyvToI422(yuyv.data(), stride, wrong));
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/frame_pool.h>
+#include <livekit/video_frame.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+// A 3x2 RGBA image with 4 bytes of padding per row, as a capture card
+// might deliver it.
+constexpr int kWidth = 3, kHeight = 2, kStride = kWidth * 4 + 4;
+
+std::vector<std::uint8_t> paddedRgba() {
+  std::vector<std::uint8_t> memory(kStride * kHeight, 0xEE);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth * 4; ++x) {
+      memory[y * kStride + x] = static_cast<std::uint8_t>(y * 100 + x);
+    }
+  }
+  return memory;
+}
+
+VideoPlaneInfo plane(const std::vector<std::uint8_t> &memory,
+                     std::uint32_t stride) {
+  return {reinterpret_cast<std::uintptr_t>(memory.data()), stride,
+          static_cast<std::uint32_t>(memory.size())};
+}
+
+} // namespace
+
+TEST(VideoFrameTest, ExternalPlanesKeepTheirStride) {
+  auto memory = paddedRgba();
+  VideoFrame frame = VideoFrame::wrapExternal(
+      kWidth, kHeight, VideoBufferType::RGBA, {plane(memory, kStride)});
+  EXPECT_TRUE(frame.isExternal());
+  EXPECT_FALSE(frame.isNative());
+  EXPECT_EQ(frame.data(), memory.data());
+
+  const auto planes = frame.planeInfos();
+  ASSERT_EQ(planes.size(), 1u);
+  EXPECT_EQ(planes[0].stride, static_cast<std::uint32_t>(kStride));
+}
+
+TEST(VideoFrameTest, ExternalFrameToOwnedDropsPadding) {
+  auto memory = paddedRgba();
+  VideoFrame frame = VideoFrame::wrapExternal(
+      kWidth, kHeight, VideoBufferType::RGBA, {plane(memory, kStride)});
+
+  for (int pass = 0; pass < 2; ++pass) {
+    VideoFramePool pool;
+    VideoFrame owned = pass == 0 ? frame.toOwned() : frame.toOwned(pool);
+    EXPECT_FALSE(owned.isExternal());
+    ASSERT_EQ(owned.dataSize(), std::size_t{kWidth * 4 * kHeight});
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth * 4; ++x) {
+        EXPECT_EQ(owned.data()[y * kWidth * 4 + x], y * 100 + x);
+      }
+    }
+  }
+}
+
+TEST(VideoFrameTest, ExternalReleaseRunsOnceAfterMoves) {
+  auto memory = paddedRgba();
+  int released = 0;
+  {
+    VideoFrame frame = VideoFrame::wrapExternal(
+        kWidth, kHeight, VideoBufferType::RGBA, {plane(memory, kStride)},
+        [&released] { ++released; });
+    VideoFrame moved = std::move(frame);
+    VideoFrame assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(released, 0);
+  }
+  EXPECT_EQ(released, 1);
+}
+
+TEST(VideoFrameTest, ExternalPlanesAreValidated) {
+  auto memory = paddedRgba();
+  int released = 0;
+  auto count = [&released] { ++released; };
+  // Stride shorter than a row.
+  EXPECT_THROW(VideoFrame::wrapExternal(kWidth, kHeight, VideoBufferType::RGBA,
+                                        {plane(memory, kWidth * 4 - 1)}, count),
+               std::invalid_argument);
+  // I420 needs three planes.
+  EXPECT_THROW(VideoFrame::wrapExternal(kWidth, kHeight, VideoBufferType::I420,
+                                        {plane(memory, kStride)}, count),
+               std::invalid_argument);
+  // The caller's release still runs when the frame is rejected.
+  EXPECT_EQ(released, 2);
+}
+
+// Layouts are constant expressions, so kernels can size their plane arrays
+// at compile time.
+using Nv12 = VideoFormatTraits<VideoBufferType::NV12>;
+static_assert(Nv12::kNumPlanes == 2, "NV12 has Y and UV planes");
+static_assert(Nv12::plane<1>().bytes_per_sample == 2, "UV is interleaved");
+static_assert(Nv12::bufferSize(5, 3) == 5 * 3 + 3 * 2 * 2, "odd sizes");
+static_assert(VideoFormatTraits<VideoBufferType::I420A>::kNumPlanes == 4,
+              "I420A carries alpha");
+static_assert(videoFormatLayout(VideoBufferType::I010).bufferSize(2, 2) ==
+                  2 * 2 * 2 + 2 * 2,
+              "I010 stores 16-bit samples");
+
+TEST(VideoFrameTest, PlanesMatchPlaneInfosForEveryFormat) {
+  const VideoBufferType types[] = {
+      VideoBufferType::RGBA, VideoBufferType::RGB24, VideoBufferType::I420,
+      VideoBufferType::I420A, VideoBufferType::I422, VideoBufferType::I444,
+      VideoBufferType::I010, VideoBufferType::NV12};
+  for (VideoBufferType type : types) {
+    VideoFrame frame = VideoFrame::create(7, 5, type);
+    const VideoPlanes planes = frame.planes();
+    const std::vector<VideoPlaneInfo> infos = frame.planeInfos();
+    ASSERT_EQ(planes.size(), infos.size());
+    ASSERT_EQ(planes.size(), videoFormatLayout(type).num_planes);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < planes.size(); ++i) {
+      EXPECT_EQ(planes[i].data_ptr, infos[i].data_ptr);
+      EXPECT_EQ(planes[i].stride, infos[i].stride);
+      EXPECT_EQ(planes[i].size, infos[i].size);
+      EXPECT_EQ(planes[i].data_ptr,
+                reinterpret_cast<std::uintptr_t>(frame.data()) + total);
+      total += planes[i].size;
+    }
+    EXPECT_EQ(total, frame.dataSize());
+  }
+}
+
+TEST(VideoFrameTest, TypedFrameViewsOwnedPlanes) {
+  VideoFrame frame = VideoFrame::create(5, 3, VideoBufferType::NV12);
+  TypedVideoFrame<VideoBufferType::NV12> nv12(frame);
+  const auto &y = nv12.plane<0>();
+  const auto &uv = nv12.plane<1>();
+  EXPECT_EQ(y.data, frame.data());
+  EXPECT_EQ(y.stride, 5u);
+  EXPECT_EQ(y.rows, 3u);
+  EXPECT_EQ(uv.data, frame.data() + 15);
+  EXPECT_EQ(uv.width, 3u);
+  EXPECT_EQ(uv.stride, 6u);
+  EXPECT_EQ(uv.rows, 2u);
+  uv.row(1)[0] = 42;
+  EXPECT_EQ(frame.data()[15 + 6], 42);
+
+  EXPECT_THROW(TypedVideoFrame<VideoBufferType::I420>{frame},
+               std::invalid_argument);
+}
+
+TEST(VideoFrameTest, TypedFrameKeepsExternalStrides) {
+  auto memory = paddedRgba();
+  const VideoFrame frame = VideoFrame::wrapExternal(
+      kWidth, kHeight, VideoBufferType::RGBA, {plane(memory, kStride)});
+  ConstTypedVideoFrame<VideoBufferType::RGBA> rgba(frame);
+  const auto &p = rgba.plane<0>();
+  EXPECT_EQ(p.stride, static_cast<std::uint32_t>(kStride));
+  EXPECT_EQ(p.width, static_cast<std::uint32_t>(kWidth));
+  EXPECT_EQ(p.row(1)[2], 102);
+}
+
+} // namespace test
+} // namespace livekit
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/video_frame.h>
+
+#include "video_marker.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <stdexcept>
+
+namespace livekit {
+namespace test {
+
+namespace {
+
+VideoFrameMetadata sampleTag() {
+  VideoFrameMetadata tag;
+  tag.id = 0x0123456789ABCDEFull;
+  tag.capture_wallclock_us = 1760000000123456;
+  return tag;
+}
+
+void expectTag(const std::optional<VideoFrameMetadata> &read) {
+  ASSERT_TRUE(read.has_value());
+  EXPECT_EQ(read->id, sampleTag().id);
+  EXPECT_EQ(read->capture_wallclock_us, sampleTag().capture_wallclock_us);
+}
+
+} // namespace
+
+TEST(VideoMarkerTest, RoundTripsInEveryMarkableFormat) {
+  const VideoBufferType types[] = {
+      VideoBufferType::RGBA, VideoBufferType::BGRA, VideoBufferType::ARGB,
+      VideoBufferType::ABGR, VideoBufferType::RGB24, VideoBufferType::I420,
+      VideoBufferType::I420A, VideoBufferType::I422, VideoBufferType::I444,
+      VideoBufferType::NV12};
+  for (const auto type : types) {
+    SCOPED_TRACE(static_cast<int>(type));
+    VideoFrame frame = VideoFrame::create(320, 180, type);
+    ASSERT_TRUE(detail::canMarkFrame(frame));
+    EXPECT_FALSE(detail::readFrameMarker(frame).has_value());
+    detail::writeFrameMarker(frame, sampleTag());
+    expectTag(detail::readFrameMarker(frame));
+  }
+}
+
+TEST(VideoMarkerTest, SurvivesNoiseAndScaling) {
+  VideoFrame frame = VideoFrame::create(1280, 720, VideoBufferType::I420);
+  detail::writeFrameMarker(frame, sampleTag());
+
+  // Perturb luma the way a lossy codec might.
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> noise(-60, 60);
+  auto *y = reinterpret_cast<std::uint8_t *>(frame.planeInfos()[0].data_ptr);
+  for (std::size_t i = 0; i < frame.planeInfos()[0].size; ++i) {
+    y[i] = static_cast<std::uint8_t>(
+        std::min(255, std::max(0, y[i] + noise(rng))));
+  }
+  expectTag(detail::readFrameMarker(frame));
+
+  // A lower simulcast layer, then the subscriber's RGBA conversion.
+  VideoFrame small = VideoFrame::create(320, 180, VideoBufferType::I420);
+  frame.scaleInto(small);
+  expectTag(detail::readFrameMarker(small));
+  VideoFrame rgba = VideoFrame::create(320, 180, VideoBufferType::RGBA);
+  small.convertInto(rgba);
+  expectTag(detail::readFrameMarker(rgba));
+}
+
+TEST(VideoMarkerTest, RejectsCorruptedTag) {
+  VideoFrame frame = VideoFrame::create(320, 180, VideoBufferType::RGBA);
+  detail::writeFrameMarker(frame, sampleTag());
+  // Invert one payload cell: row 1, column 3 (8px cells at this width).
+  const auto plane = frame.planeInfos()[0];
+  for (int yy = 8; yy < 16; ++yy) {
+    auto *row = reinterpret_cast<std::uint8_t *>(plane.data_ptr) +
+                static_cast<std::size_t>(yy) * plane.stride;
+    for (int xx = 24; xx < 32; ++xx) {
+      row[xx * 4 + 1] = static_cast<std::uint8_t>(255 - row[xx * 4 + 1]);
+    }
+  }
+  EXPECT_FALSE(detail::readFrameMarker(frame).has_value());
+}
+
+TEST(VideoMarkerTest, RejectsUnsupportedFrames) {
+  VideoFrame tiny = VideoFrame::create(64, 64, VideoBufferType::I420);
+  EXPECT_FALSE(detail::canMarkFrame(tiny));
+  EXPECT_THROW(detail::writeFrameMarker(tiny, sampleTag()),
+               std::invalid_argument);
+
+  VideoFrame hdr = VideoFrame::create(320, 180, VideoBufferType::I010);
+  EXPECT_FALSE(detail::canMarkFrame(hdr));
+  EXPECT_THROW(detail::writeFrameMarker(hdr, sampleTag()),
+               std::invalid_argument);
+  EXPECT_FALSE(detail::readFrameMarker(hdr).has_value());
+}
+
+} // namespace test
+} // namespace livekit
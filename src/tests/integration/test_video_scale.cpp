@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/frame_pool.h>
+#include <livekit/video_frame.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace livekit {
+namespace test {
+
+TEST(VideoScaleTest, RgbaBoxDownscaleAveragesBlocks) {
+  VideoFrame src = VideoFrame::create(4, 4, VideoBufferType::RGBA);
+  for (std::size_t i = 0; i < src.dataSize(); ++i) {
+    src.data()[i] = static_cast<std::uint8_t>(i);
+  }
+  VideoFrame dst = VideoFrame::create(2, 2, VideoBufferType::RGBA);
+  src.scaleInto(dst);
+
+  // Each output pixel is the rounded mean of a 2x2 source block.
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 2; ++x) {
+      for (int c = 0; c < 4; ++c) {
+        auto at = [&](int sx, int sy) {
+          return static_cast<int>(src.data()[(sy * 4 + sx) * 4 + c]);
+        };
+        const int sum = at(2 * x, 2 * y) + at(2 * x + 1, 2 * y) +
+                        at(2 * x, 2 * y + 1) + at(2 * x + 1, 2 * y + 1);
+        EXPECT_EQ(dst.data()[(y * 2 + x) * 4 + c], (sum + 2) / 4);
+      }
+    }
+  }
+}
+
+TEST(VideoScaleTest, I420ScalesEachPlaneOnItsOwnGrid) {
+  // Wide enough for the SIMD row accumulation plus a scalar tail.
+  const int w = 1280, h = 720;
+  VideoFrame src = VideoFrame::create(w, h, VideoBufferType::I420);
+  const auto sp = src.planeInfos();
+  const std::uint8_t fill[3] = {200, 60, 140};
+  for (std::size_t p = 0; p < 3; ++p) {
+    auto *d = reinterpret_cast<std::uint8_t *>(sp[p].data_ptr);
+    std::fill(d, d + sp[p].size, fill[p]);
+  }
+
+  VideoFramePool pool;
+  VideoFrame dst = pool.acquire(320, 180, VideoBufferType::I420);
+  src.scaleInto(dst);
+
+  const auto dp = dst.planeInfos();
+  ASSERT_EQ(dp.size(), 3u);
+  EXPECT_EQ(dp[0].size, 320u * 180u);
+  EXPECT_EQ(dp[1].size, 160u * 90u);
+  for (std::size_t p = 0; p < 3; ++p) {
+    const auto *d = reinterpret_cast<const std::uint8_t *>(dp[p].data_ptr);
+    for (std::uint32_t i = 0; i < dp[p].size; ++i) {
+      ASSERT_EQ(d[i], fill[p]) << "plane " << p << " byte " << i;
+    }
+  }
+}
+
+TEST(VideoScaleTest, UpscaleRepeatsPixels) {
+  VideoFrame src = VideoFrame::create(2, 1, VideoBufferType::RGB24);
+  for (std::size_t i = 0; i < src.dataSize(); ++i) {
+    src.data()[i] = static_cast<std::uint8_t>(10 * (i + 1));
+  }
+  VideoFrame dst = VideoFrame::create(4, 2, VideoBufferType::RGB24);
+  src.scaleInto(dst);
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 4; ++x) {
+      for (int c = 0; c < 3; ++c) {
+        EXPECT_EQ(dst.data()[(y * 4 + x) * 3 + c], src.data()[(x / 2) * 3 + c]);
+      }
+    }
+  }
+}
+
+TEST(VideoScaleTest, RejectsMismatchedFormat) {
+  VideoFrame src = VideoFrame::create(8, 8, VideoBufferType::RGBA);
+  VideoFrame dst = VideoFrame::create(4, 4, VideoBufferType::I420);
+  EXPECT_THROW(src.scaleInto(dst), std::invalid_argument);
+}
+
+} // namespace test
+} // namespace livekit
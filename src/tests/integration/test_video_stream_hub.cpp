@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <livekit/frame_pool.h>
+#include <livekit/video_stream_hub.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace test {
+
+TEST(SharedVideoFrameTest, SourceFormatIsServedWithoutCopy) {
+  SharedVideoFrame shared(VideoFrame::create(16, 8, VideoBufferType::I420),
+                          1234, VideoRotation::VIDEO_ROTATION_90);
+  EXPECT_EQ(shared.as(VideoBufferType::I420), shared.source());
+  EXPECT_EQ(shared.timestampUs(), 1234);
+  EXPECT_EQ(shared.rotation(), VideoRotation::VIDEO_ROTATION_90);
+}
+
+TEST(SharedVideoFrameTest, EachFormatIsConvertedOnce) {
+  auto pool = std::make_shared<VideoFramePool>();
+  SharedVideoFrame shared(VideoFrame::create(16, 8, VideoBufferType::I420), 0,
+                          VideoRotation::VIDEO_ROTATION_0, pool);
+
+  auto rgba = shared.as(VideoBufferType::RGBA);
+  ASSERT_NE(rgba, nullptr);
+  EXPECT_EQ(rgba->type(), VideoBufferType::RGBA);
+  EXPECT_EQ(rgba->width(), 16);
+  EXPECT_EQ(rgba->height(), 8);
+  EXPECT_EQ(shared.as(VideoBufferType::RGBA), rgba);
+
+  auto bgra = shared.as(VideoBufferType::BGRA);
+  EXPECT_NE(bgra, rgba);
+  EXPECT_EQ(bgra->type(), VideoBufferType::BGRA);
+}
+
+TEST(SharedVideoFrameTest, ConcurrentReadersShareOneConversion) {
+  SharedVideoFrame shared(VideoFrame::create(64, 32, VideoBufferType::I420),
+                          0, VideoRotation::VIDEO_ROTATION_0);
+  constexpr int kReaders = 8;
+  std::vector<std::shared_ptr<const VideoFrame>> results(kReaders);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kReaders; ++i) {
+    threads.emplace_back(
+        [&, i] { results[i] = shared.as(VideoBufferType::RGBA); });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (const auto &frame : results) {
+    EXPECT_EQ(frame, results[0]);
+  }
+}
+
+} // namespace test
+} // namespace livekit
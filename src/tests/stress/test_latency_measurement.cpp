@@ -118,6 +118,54 @@ TEST_F(LatencyMeasurementTest, ConnectionTime) {
   EXPECT_GT(stats.count(), 0) << "At least one connection should succeed";
 }
 
+// =============================================================================
+// Test 1b: Async Connection Time Breakdown
+// =============================================================================
+TEST_F(LatencyMeasurementTest, AsyncConnectionTimeBreakdown) {
+  skipIfNotConfigured();
+
+  std::cout << "\n=== Async Connection Time Breakdown Test ===" << std::endl;
+  std::cout << "Iterations: " << config_.test_iterations << std::endl;
+
+  LatencyStats stats;
+  LatencyStats join_stats;
+  LatencyStats setup_stats;
+  RoomOptions options;
+  options.auto_subscribe = true;
+
+  auto ms = [](std::chrono::microseconds us) { return us.count() / 1000.0; };
+  for (int i = 0; i < config_.test_iterations; ++i) {
+    auto room = std::make_unique<Room>();
+
+    ConnectResult result =
+        room->connectAsync(config_.url, config_.caller_token, options).get();
+
+    if (result.connected) {
+      const ConnectTiming &t = result.timing;
+      stats.addMeasurement(ms(t.total));
+      join_stats.addMeasurement(ms(t.join));
+      setup_stats.addMeasurement(ms(t.setup));
+      std::cout << "  Iteration " << (i + 1) << ": " << std::fixed
+                << std::setprecision(2) << ms(t.total)
+                << " ms (request " << ms(t.request) << ", join "
+                << ms(t.join) << ", setup " << ms(t.setup) << ")"
+                << std::endl;
+    } else {
+      std::cout << "  Iteration " << (i + 1)
+                << ": FAILED to connect: " << result.error << std::endl;
+    }
+
+    // Small delay between iterations to allow cleanup
+    std::this_thread::sleep_for(500ms);
+  }
+
+  stats.printStats("Async Connection Time Statistics");
+  join_stats.printStats("Join (signal + ICE + DTLS) Time Statistics");
+  setup_stats.printStats("SDK Setup Time Statistics");
+
+  EXPECT_GT(stats.count(), 0) << "At least one connection should succeed";
+}
+
 // =============================================================================
 // Test 2: Audio Latency Measurement using Energy Detection
 // =============================================================================
@@ -19,12 +19,42 @@
 #include <gtest/gtest.h>
 #include <livekit/livekit.h>
 #include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 
 namespace livekit {
 namespace test {
 
+namespace {
+
+// Wait briefly for handles released on background threads (event dispatch,
+// deferred disposal) to settle, then require every live handle count and
+// queued byte gauge to be back at `baseline`.
+void expectResourcesAtBaseline(const ResourceSnapshot &baseline) {
+  auto matches = [&baseline](const ResourceSnapshot &now) {
+    return now.live_handles == baseline.live_handles &&
+           now.totalBytes() == baseline.totalBytes();
+  };
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  ResourceSnapshot now = resourceSnapshot();
+  while (!matches(now) && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    now = resourceSnapshot();
+  }
+  for (std::size_t i = 0; i < kResourceKindCount; ++i) {
+    EXPECT_EQ(now.live_handles[i], baseline.live_handles[i])
+        << "live " << resourceKindName(static_cast<ResourceKind>(i))
+        << " handles";
+  }
+  EXPECT_EQ(now.audio_stream_bytes, baseline.audio_stream_bytes);
+  EXPECT_EQ(now.video_stream_bytes, baseline.video_stream_bytes);
+  EXPECT_EQ(now.stream_reader_bytes, baseline.stream_reader_bytes);
+}
+
+} // namespace
+
 class RoomStressTest : public ::testing::Test {
 protected:
   void SetUp() override { livekit::initialize(livekit::LogSink::kConsole); }
@@ -184,6 +214,33 @@ TEST_F(RoomStressTest, StreamHandlerRegistrationStress) {
             << " stream handlers in " << duration.count() << "ms" << std::endl;
 }
 
+// Stress test: sources, tracks and rooms created and dropped in cycles leave
+// no live handle behind
+TEST_F(RoomStressTest, ResourcesReturnToBaselineAfterCycles) {
+  setMetricsEnabled(true);
+  const ResourceSnapshot baseline = resourceSnapshot();
+  const int num_cycles = 50;
+
+  for (int i = 0; i < num_cycles; ++i) {
+    Room room;
+    room.registerTextStreamCallbacks(
+        "topic", [](const TextStreamInfo &, const std::string &) {
+          return TextStreamCallbacks{};
+        });
+    auto audio_source = std::make_shared<AudioSource>(48000, 1);
+    auto video_source = std::make_shared<VideoSource>(320, 240);
+    auto audio_track =
+        LocalAudioTrack::createLocalAudioTrack("mic", audio_source);
+    auto video_track =
+        LocalVideoTrack::createLocalVideoTrack("cam", video_source);
+    ASSERT_EQ(resourceSnapshot().handles(ResourceKind::kTrack),
+              baseline.handles(ResourceKind::kTrack) + 2);
+  }
+
+  expectResourcesAtBaseline(baseline);
+  setMetricsEnabled(false);
+}
+
 // Server-dependent stress tests
 class RoomServerStressTest : public ::testing::Test {
 protected:
@@ -236,5 +293,35 @@ TEST_F(RoomServerStressTest, RepeatedConnectDisconnect) {
             << std::endl;
 }
 
+TEST_F(RoomServerStressTest, ResourcesReturnToBaselineAfterConnectCycles) {
+  if (!server_available_) {
+    GTEST_SKIP()
+        << "LIVEKIT_URL and LIVEKIT_TOKEN not set, skipping server stress test";
+  }
+
+  setMetricsEnabled(true);
+  const ResourceSnapshot baseline = resourceSnapshot();
+  const int num_iterations = 10;
+
+  for (int i = 0; i < num_iterations; ++i) {
+    Room room;
+    RoomOptions options;
+    ASSERT_TRUE(room.Connect(server_url_, token_, options));
+    EXPECT_EQ(resourceSnapshot().handles(ResourceKind::kRoom),
+              baseline.handles(ResourceKind::kRoom) + 1);
+
+    auto source = std::make_shared<AudioSource>(48000, 1);
+    auto track = LocalAudioTrack::createLocalAudioTrack("mic", source);
+    auto publication =
+        room.localParticipant()->publishTrack(track, TrackPublishOptions{});
+    ASSERT_NE(publication, nullptr);
+    room.localParticipant()->unpublishTrack(publication->sid());
+    // Room disconnects when it goes out of scope
+  }
+
+  expectResourcesAtBaseline(baseline);
+  setMetricsEnabled(false);
+}
+
 } // namespace test
 } // namespace livekit
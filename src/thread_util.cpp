@@ -0,0 +1,370 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_util.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <pthread/qos.h>
+#endif
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+using std::chrono::microseconds;
+
+struct ThreadEntry {
+  std::string name;
+  ThreadRole role = ThreadRole::kBackground;
+  std::string placement_error;
+#if defined(_WIN32)
+  HANDLE handle = nullptr;
+#elif defined(__APPLE__)
+  mach_port_t port = MACH_PORT_NULL;
+#elif defined(__linux__)
+  clockid_t clock{};
+  bool has_clock = false;
+#endif
+};
+
+void appendError(std::string &errors, const char *what, int err) {
+  if (!errors.empty()) {
+    errors += "; ";
+  }
+  errors += what;
+  if (err != 0) {
+    errors += ": ";
+    errors += std::strerror(err);
+  }
+}
+
+const ThreadPlacement &placementFor(const ThreadOptions &options,
+                                    ThreadRole role) {
+  switch (role) {
+  case ThreadRole::kEventDispatch:
+    return options.event_dispatch;
+  case ThreadRole::kAudio:
+    return options.audio;
+  case ThreadRole::kVideo:
+    return options.video;
+  case ThreadRole::kMediaClock:
+    return options.media_clock;
+  case ThreadRole::kBackground:
+  default:
+    return options.background;
+  }
+}
+
+void setName(const std::string &name, std::string &errors) {
+#if defined(__linux__)
+  // The kernel limit is 16 bytes including the terminator.
+  const std::string truncated = name.substr(0, 15);
+  if (int err = pthread_setname_np(pthread_self(), truncated.c_str())) {
+    appendError(errors, "pthread_setname_np", err);
+  }
+#elif defined(__APPLE__)
+  if (int err = pthread_setname_np(name.c_str())) {
+    appendError(errors, "pthread_setname_np", err);
+  }
+#elif defined(_WIN32)
+  const std::wstring wide(name.begin(), name.end());
+  if (FAILED(SetThreadDescription(GetCurrentThread(), wide.c_str()))) {
+    appendError(errors, "SetThreadDescription", 0);
+  }
+#else
+  (void)name;
+  (void)errors;
+#endif
+}
+
+void setAffinity(const std::vector<int> &cpus, std::string &errors) {
+  if (cpus.empty()) {
+    return;
+  }
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  if (int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set)) {
+    appendError(errors, "pthread_setaffinity_np", err);
+  }
+#elif defined(_WIN32)
+  DWORD_PTR mask = 0;
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < static_cast<int>(sizeof(mask) * 8)) {
+      mask |= static_cast<DWORD_PTR>(1) << cpu;
+    }
+  }
+  if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+    appendError(errors, "SetThreadAffinityMask", 0);
+  }
+#else
+  appendError(errors, "CPU affinity is not supported on this platform", 0);
+#endif
+}
+
+void setPriority(const ThreadPlacement &placement, std::string &errors) {
+  switch (placement.priority) {
+  case ThreadPriority::kDefault:
+    return;
+  case ThreadPriority::kElevated: {
+#if defined(__linux__)
+    // Linux applies nice values per thread (by tid).
+    const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, -10) != 0) {
+      appendError(errors, "setpriority", errno);
+    }
+#elif defined(__APPLE__)
+    if (int err = pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE,
+                                                0)) {
+      appendError(errors, "pthread_set_qos_class_self_np", err);
+    }
+#elif defined(_WIN32)
+    if (!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST)) {
+      appendError(errors, "SetThreadPriority", 0);
+    }
+#endif
+    return;
+  }
+  case ThreadPriority::kRealtime: {
+#if defined(_WIN32)
+    if (!SetThreadPriority(GetCurrentThread(),
+                           THREAD_PRIORITY_TIME_CRITICAL)) {
+      appendError(errors, "SetThreadPriority", 0);
+    }
+#else
+    sched_param param{};
+    param.sched_priority = std::clamp(placement.realtime_priority,
+                                      sched_get_priority_min(SCHED_FIFO),
+                                      sched_get_priority_max(SCHED_FIFO));
+    if (int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param)) {
+      appendError(errors, "pthread_setschedparam(SCHED_FIFO)", err);
+    }
+#endif
+    return;
+  }
+  }
+}
+
+void openCpuClock(ThreadEntry &entry) {
+#if defined(_WIN32)
+  entry.handle = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE,
+                            GetCurrentThreadId());
+#elif defined(__APPLE__)
+  entry.port = pthread_mach_thread_np(pthread_self());
+#elif defined(__linux__)
+  entry.has_clock = pthread_getcpuclockid(pthread_self(), &entry.clock) == 0;
+#else
+  (void)entry;
+#endif
+}
+
+void closeCpuClock(ThreadEntry &entry) {
+#if defined(_WIN32)
+  if (entry.handle) {
+    CloseHandle(entry.handle);
+    entry.handle = nullptr;
+  }
+#else
+  (void)entry;
+#endif
+}
+
+// Safe from any thread while `entry` is registered: its thread has not
+// exited yet, because it deregisters first.
+microseconds cpuTime(const ThreadEntry &entry) {
+#if defined(_WIN32)
+  FILETIME created, exited, kernel, user;
+  if (!entry.handle ||
+      !GetThreadTimes(entry.handle, &created, &exited, &kernel, &user)) {
+    return microseconds(0);
+  }
+  auto ticks = [](const FILETIME &t) {
+    return (static_cast<std::uint64_t>(t.dwHighDateTime) << 32) |
+           t.dwLowDateTime;
+  };
+  // FILETIME counts 100 ns intervals.
+  return microseconds((ticks(kernel) + ticks(user)) / 10);
+#elif defined(__APPLE__)
+  thread_basic_info_data_t info;
+  mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+  if (thread_info(entry.port, THREAD_BASIC_INFO,
+                  reinterpret_cast<thread_info_t>(&info),
+                  &count) != KERN_SUCCESS) {
+    return microseconds(0);
+  }
+  return microseconds(
+      (static_cast<std::int64_t>(info.user_time.seconds) +
+       info.system_time.seconds) *
+          1000000 +
+      info.user_time.microseconds + info.system_time.microseconds);
+#elif defined(__linux__)
+  timespec ts{};
+  if (!entry.has_clock || clock_gettime(entry.clock, &ts) != 0) {
+    return microseconds(0);
+  }
+  return microseconds(static_cast<std::int64_t>(ts.tv_sec) * 1000000 +
+                      ts.tv_nsec / 1000);
+#else
+  (void)entry;
+  return microseconds(0);
+#endif
+}
+
+class ThreadRegistry {
+public:
+  // Never destroyed: thread-exit hooks may run during static destruction.
+  static ThreadRegistry &instance() {
+    static ThreadRegistry *registry = new ThreadRegistry();
+    return *registry;
+  }
+
+  void configure(const ThreadOptions &options) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+  }
+
+  ThreadOptions options() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return options_;
+  }
+
+  void add(ThreadEntry *entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.push_back(entry);
+  }
+
+  void remove(ThreadEntry *entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(std::remove(entries_.begin(), entries_.end(), entry),
+                   entries_.end());
+  }
+
+  std::vector<ThreadCpuStats> stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ThreadCpuStats> out;
+    out.reserve(entries_.size());
+    for (const ThreadEntry *entry : entries_) {
+      ThreadCpuStats s;
+      s.name = entry->name;
+      s.role = entry->role;
+      s.cpu_time = cpuTime(*entry);
+      s.placement_error = entry->placement_error;
+      out.push_back(std::move(s));
+    }
+    return out;
+  }
+
+private:
+  ThreadRegistry() = default;
+
+  mutable std::mutex mutex_;
+  ThreadOptions options_;
+  std::vector<ThreadEntry *> entries_;
+};
+
+// Lives as long as its thread; deregisters on thread exit.
+struct ThreadSlot {
+  ThreadEntry entry;
+  bool registered = false;
+
+  ~ThreadSlot() {
+    if (registered) {
+      ThreadRegistry::instance().remove(&entry);
+      closeCpuClock(entry);
+    }
+  }
+};
+
+thread_local ThreadSlot tls_thread;
+
+bool applyRole(ThreadRole role, const std::string &name) {
+  auto &registry = ThreadRegistry::instance();
+  const ThreadOptions options = registry.options();
+  const ThreadPlacement &placement = placementFor(options, role);
+
+  std::string errors;
+  if (options.name_threads && !name.empty()) {
+    setName(name, errors);
+  }
+  setAffinity(placement.cpus, errors);
+  setPriority(placement, errors);
+
+  ThreadSlot &slot = tls_thread;
+  if (slot.registered) {
+    registry.remove(&slot.entry);
+  } else {
+    openCpuClock(slot.entry);
+    slot.registered = true;
+  }
+  slot.entry.name = name;
+  slot.entry.role = role;
+  slot.entry.placement_error = errors;
+  registry.add(&slot.entry);
+  return errors.empty();
+}
+
+} // namespace
+
+void registerThread(ThreadRole role, const char *name) noexcept {
+  try {
+    (void)applyRole(role, name ? name : "");
+  } catch (...) {
+    // Thread set-up is best effort; the thread runs unregistered.
+  }
+}
+
+} // namespace detail
+
+void configureThreads(const ThreadOptions &options) {
+  detail::ThreadRegistry::instance().configure(options);
+}
+
+bool applyThreadRole(ThreadRole role, const std::string &name) {
+  return detail::applyRole(role, name);
+}
+
+std::vector<ThreadCpuStats> threadCpuStats() {
+  return detail::ThreadRegistry::instance().stats();
+}
+
+} // namespace livekit
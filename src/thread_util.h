@@ -0,0 +1,30 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/thread_options.h"
+
+namespace livekit {
+namespace detail {
+
+// First call on every SDK-owned thread: names it, applies the placement
+// configured for `role` and registers it for threadCpuStats() until the
+// thread exits. Never throws; failures are reported through the stats.
+void registerThread(ThreadRole role, const char *name) noexcept;
+
+} // namespace detail
+} // namespace livekit
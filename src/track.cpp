@@ -40,6 +40,11 @@ void Track::setPublicationFields(std::optional<TrackSource> source,
 }
 
 std::future<std::vector<RtcStats>> Track::getStats() const {
+  return getStats(kAllRtcStatsTypes);
+}
+
+std::future<std::vector<RtcStats>>
+Track::getStats(RtcStatsTypeMask types) const {
   auto id = ffi_handle_id();
   if (!id) {
     // make a ready future with an empty vector
@@ -49,7 +54,7 @@ std::future<std::vector<RtcStats>> Track::getStats() const {
   }
 
   // just forward the future from FfiClient
-  return FfiClient::instance().getTrackStatsAsync(id);
+  return FfiClient::instance().getTrackStatsAsync(id, types);
 }
 
 } // namespace livekit
\ No newline at end of file
@@ -141,4 +141,26 @@ ParticipantKind fromProto(proto::ParticipantKind in) {
   }
 }
 
+proto::FfiRequest
+enableRemoteTrackPublicationRequest(std::uint64_t publication_handle,
+                                    bool enabled) {
+  proto::FfiRequest req;
+  auto *msg = req.mutable_enable_remote_track_publication();
+  msg->set_track_publication_handle(publication_handle);
+  msg->set_enabled(enabled);
+  return req;
+}
+
+proto::FfiRequest
+remoteTrackPublicationDimensionRequest(std::uint64_t publication_handle,
+                                       std::uint32_t width,
+                                       std::uint32_t height) {
+  proto::FfiRequest req;
+  auto *msg = req.mutable_update_remote_track_publication_dimension();
+  msg->set_track_publication_handle(publication_handle);
+  msg->set_width(width);
+  msg->set_height(height);
+  return req;
+}
+
 } // namespace livekit
\ No newline at end of file
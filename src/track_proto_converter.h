@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <cstdint>
+
+#include "ffi.pb.h"
 #include "livekit/participant.h"
 #include "livekit/track.h"
 #include "livekit/track_publication.h"
@@ -35,4 +38,14 @@ proto::ParticipantTrackPermission toProto(const ParticipantTrackPermission &in);
 ParticipantTrackPermission
 fromProto(const proto::ParticipantTrackPermission &in);
 
+// Remote publication requests (RemoteTrackPublication::setEnabled() and
+// setVideoDimensions())
+proto::FfiRequest
+enableRemoteTrackPublicationRequest(std::uint64_t publication_handle,
+                                    bool enabled);
+proto::FfiRequest
+remoteTrackPublicationDimensionRequest(std::uint64_t publication_handle,
+                                       std::uint32_t width,
+                                       std::uint32_t height);
+
 } // namespace livekit
\ No newline at end of file
@@ -0,0 +1,267 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transcription_batcher.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "log.h"
+#include "thread_util.h"
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+// While acknowledgements are outstanding the idle sender wakes this often to
+// collect them, so failures are logged without waiting for more traffic.
+constexpr auto kReapInterval = std::chrono::milliseconds(100);
+
+} // namespace
+
+TranscriptionBatcher::TranscriptionBatcher(SendFn send,
+                                           const TranscriptionOptions &options)
+    : send_(std::move(send)), options_(options) {}
+
+TranscriptionBatcher::~TranscriptionBatcher() { stop(); }
+
+void TranscriptionBatcher::configure(const TranscriptionOptions &options) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+  }
+  cv_.notify_all();
+}
+
+void TranscriptionBatcher::publish(
+    const std::string &participant_identity, const std::string &track_sid,
+    const std::vector<TranscriptionSegment> &segments) {
+  if (track_sid.empty()) {
+    throw std::invalid_argument(
+        "publishTranscription: track SID must not be empty");
+  }
+  for (const auto &segment : segments) {
+    if (segment.id.empty()) {
+      throw std::invalid_argument(
+          "publishTranscription: segment ID must not be empty");
+    }
+  }
+  if (segments.empty()) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  stats_.segments_submitted += segments.size();
+  if (stopped_) {
+    ++stats_.batches_sent;
+    lock.unlock();
+    send_(participant_identity, track_sid, segments).get();
+    return;
+  }
+
+  const auto now = Clock::now();
+  auto inserted = batches_.try_emplace(Key(participant_identity, track_sid));
+  Batch &batch = inserted.first->second;
+  if (inserted.second) {
+    batch.due = now + options_.batch_window;
+  }
+  bool due_now = false;
+  for (const auto &segment : segments) {
+    auto found = batch.index.find(segment.id);
+    if (found == batch.index.end()) {
+      batch.index.emplace(segment.id, batch.segments.size());
+      batch.segments.push_back(segment);
+    } else {
+      TranscriptionSegment &waiting = batch.segments[found->second];
+      ++stats_.segments_coalesced;
+      // A segment that went final stays final; late interim updates to it
+      // are stale.
+      if (!waiting.is_final || segment.is_final) {
+        waiting = segment;
+      }
+    }
+    due_now = due_now || segment.is_final;
+  }
+  if (due_now || batch.segments.size() >= options_.max_batch_segments) {
+    batch.due = now;
+  }
+
+  if (!worker_.joinable()) {
+    worker_ = std::thread([this] {
+      registerThread(ThreadRole::kBackground, "lk-transcribe");
+      run();
+    });
+  }
+  lock.unlock();
+  cv_.notify_all();
+}
+
+std::map<TranscriptionBatcher::Key, TranscriptionBatcher::Batch>::iterator
+TranscriptionBatcher::dueLocked(Clock::time_point now,
+                                Clock::time_point *next) {
+  auto earliest = batches_.end();
+  for (auto it = batches_.begin(); it != batches_.end(); ++it) {
+    if (earliest == batches_.end() || it->second.due < earliest->second.due) {
+      earliest = it;
+    }
+  }
+  if (earliest == batches_.end()) {
+    *next = Clock::time_point::max();
+    return earliest;
+  }
+  if (earliest->second.due > now) {
+    *next = earliest->second.due;
+    return batches_.end();
+  }
+  return earliest;
+}
+
+void TranscriptionBatcher::reapLocked() {
+  auto keep = in_flight_.begin();
+  for (auto &fut : in_flight_) {
+    if (fut.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      *keep++ = std::move(fut);
+      continue;
+    }
+    try {
+      fut.get();
+    } catch (...) {
+      failedLocked(std::current_exception());
+    }
+  }
+  in_flight_.erase(keep, in_flight_.end());
+}
+
+void TranscriptionBatcher::failedLocked(std::exception_ptr error) {
+  ++stats_.send_failures;
+  try {
+    std::rethrow_exception(error);
+  } catch (const std::exception &e) {
+    LK_LOG_WARN("livekit::transcription", "publish failed: %s", e.what());
+  } catch (...) {
+    LK_LOG_WARN("livekit::transcription", "publish failed");
+  }
+  if (!unreported_) {
+    unreported_ = std::move(error);
+  }
+}
+
+void TranscriptionBatcher::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopped_) {
+    reapLocked();
+    Clock::time_point next;
+    auto due = dueLocked(Clock::now(), &next);
+    if (due == batches_.end()) {
+      if (!in_flight_.empty()) {
+        next = std::min(next, Clock::now() + kReapInterval);
+      }
+      if (next == Clock::time_point::max()) {
+        cv_.wait(lock);
+      } else {
+        cv_.wait_until(lock, next);
+      }
+      continue;
+    }
+
+    const Key key = due->first;
+    std::vector<TranscriptionSegment> segments =
+        std::move(due->second.segments);
+    batches_.erase(due);
+    ++stats_.batches_sent;
+    sending_ = true;
+    lock.unlock();
+    std::future<void> fut;
+    std::exception_ptr error;
+    try {
+      fut = send_(key.first, key.second, segments);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    sending_ = false;
+    if (error) {
+      failedLocked(std::move(error));
+    } else {
+      in_flight_.push_back(std::move(fut));
+    }
+    cv_.notify_all();
+  }
+}
+
+void TranscriptionBatcher::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto now = Clock::now();
+  for (auto &entry : batches_) {
+    entry.second.due = std::min(entry.second.due, now);
+  }
+  cv_.notify_all();
+  cv_.wait(lock,
+           [this] { return stopped_ || (batches_.empty() && !sending_); });
+  std::vector<std::future<void>> pending;
+  pending.swap(in_flight_);
+  lock.unlock();
+  for (auto &fut : pending) {
+    fut.wait();
+  }
+  lock.lock();
+  // Back in in_flight_, all ready: reaping records any failure.
+  for (auto &fut : pending) {
+    in_flight_.push_back(std::move(fut));
+  }
+  reapLocked();
+  if (unreported_) {
+    std::rethrow_exception(std::exchange(unreported_, nullptr));
+  }
+}
+
+void TranscriptionBatcher::stop() {
+  std::map<Key, Batch> waiting;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+    waiting.swap(batches_);
+    stats_.batches_sent += waiting.size();
+  }
+  cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  // Best effort, after the sender's last request so a track stays in order;
+  // acknowledgements are not waited for.
+  for (const auto &entry : waiting) {
+    try {
+      (void)send_(entry.first.first, entry.first.second,
+                  entry.second.segments);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      failedLocked(std::current_exception());
+    }
+  }
+}
+
+TranscriptionStats TranscriptionBatcher::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+} // namespace detail
+} // namespace livekit
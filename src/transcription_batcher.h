@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/room_event_types.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+// Coalescing publisher behind LocalParticipant::publishTranscription().
+//
+// Segments are collected per (participant identity, track) batch. An update
+// to a segment that is still waiting replaces it in place, so a recognizer
+// revising its interim text 20 times a second costs one request per batch
+// window rather than one per revision. A batch is due when its window has
+// elapsed, it holds a final segment or it reaches max_batch_segments.
+//
+// Batches are sent one after another by a sender thread started on first
+// use, which keeps requests for a track in order; acknowledgements are
+// collected without blocking the sender.
+class TranscriptionBatcher {
+public:
+  // Issues one request and returns its completion. May throw.
+  using SendFn = std::function<std::future<void>(
+      const std::string &participant_identity, const std::string &track_sid,
+      const std::vector<TranscriptionSegment> &segments)>;
+
+  TranscriptionBatcher(SendFn send, const TranscriptionOptions &options);
+  ~TranscriptionBatcher();
+
+  TranscriptionBatcher(const TranscriptionBatcher &) = delete;
+  TranscriptionBatcher &operator=(const TranscriptionBatcher &) = delete;
+
+  void configure(const TranscriptionOptions &options);
+
+  // Throws std::invalid_argument on an empty track SID or segment ID. After
+  // stop() the segments are sent on the calling thread, which waits for the
+  // acknowledgement.
+  void publish(const std::string &participant_identity,
+               const std::string &track_sid,
+               const std::vector<TranscriptionSegment> &segments);
+
+  // Send every waiting batch and wait until all requests so far have been
+  // acknowledged. Rethrows the first failure since the previous flush().
+  void flush();
+
+  // Join the sender thread, then send the batches still waiting on the
+  // calling thread without waiting for their acknowledgements.
+  void stop();
+
+  TranscriptionStats stats() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+  using Key = std::pair<std::string, std::string>; // identity, track SID
+
+  struct Batch {
+    std::vector<TranscriptionSegment> segments; // first-arrival order
+    std::unordered_map<std::string, std::size_t> index; // by segment ID
+    Clock::time_point due;
+  };
+
+  // Batch that is due at `now`, or batches_.end(); `next` receives the
+  // earliest deadline of the others.
+  std::map<Key, Batch>::iterator dueLocked(Clock::time_point now,
+                                           Clock::time_point *next);
+  // Take finished acknowledgements off in_flight_; failures are logged and
+  // the first is kept for flush().
+  void reapLocked();
+  void failedLocked(std::exception_ptr error);
+  void run();
+
+  const SendFn send_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  TranscriptionOptions options_;
+  std::map<Key, Batch> batches_;
+  std::vector<std::future<void>> in_flight_;
+  bool sending_ = false;
+  bool stopped_ = false;
+  std::exception_ptr unreported_;
+  TranscriptionStats stats_;
+  std::thread worker_;
+};
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace livekit {
+namespace detail {
+
+// End of the next chunk of s[begin, size): at most max_bytes long and not
+// splitting a UTF-8 code point. Falls back to a hard cut if no boundary is
+// found within max_bytes (malformed input).
+inline std::size_t utf8ChunkEnd(const char *s, std::size_t begin,
+                                std::size_t size, std::size_t max_bytes) {
+  const std::size_t limit = std::min(begin + max_bytes, size);
+  if (limit == size)
+    return size;
+  std::size_t end = limit;
+  // s[end] starts the next chunk, so it must not be a continuation byte.
+  while (end > begin && (static_cast<unsigned char>(s[end]) & 0xC0) == 0x80)
+    --end;
+  return end == begin ? limit : end;
+}
+
+} // namespace detail
+} // namespace livekit
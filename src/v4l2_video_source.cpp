@@ -0,0 +1,581 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/v4l2_video_source.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "livekit/frame_pool.h"
+#include "livekit/native_video_buffer.h"
+#include "livekit/video_frame.h"
+#include "livekit/video_source.h"
+#include "log.h"
+#include "thread_util.h"
+#include "video_convert.h"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+#endif
+
+namespace livekit {
+
+#if defined(__linux__)
+
+namespace {
+
+int xioctl(int fd, unsigned long request, void *arg) {
+  int r;
+  do {
+    r = ioctl(fd, request, arg);
+  } while (r == -1 && errno == EINTR);
+  return r;
+}
+
+[[noreturn]] void reject(const std::string &device, const std::string &what) {
+  throw std::runtime_error("V4L2VideoSource: " + device + ": " + what);
+}
+
+[[noreturn]] void fail(const std::string &device, const char *what) {
+  reject(device, std::string(what) + ": " + std::strerror(errno));
+}
+
+std::uint32_t toFourcc(V4L2PixelFormat format) noexcept {
+  switch (format) {
+  case V4L2PixelFormat::kNV12:
+    return V4L2_PIX_FMT_NV12;
+  case V4L2PixelFormat::kYUV420:
+    return V4L2_PIX_FMT_YUV420;
+  case V4L2PixelFormat::kYUYV:
+    return V4L2_PIX_FMT_YUYV;
+  case V4L2PixelFormat::kAuto:
+  default:
+    return 0;
+  }
+}
+
+// kAuto for anything we cannot stream.
+V4L2PixelFormat fromFourcc(std::uint32_t fourcc) noexcept {
+  switch (fourcc) {
+  case V4L2_PIX_FMT_NV12:
+    return V4L2PixelFormat::kNV12;
+  case V4L2_PIX_FMT_YUV420:
+    return V4L2PixelFormat::kYUV420;
+  case V4L2_PIX_FMT_YUYV:
+    return V4L2PixelFormat::kYUYV;
+  default:
+    return V4L2PixelFormat::kAuto;
+  }
+}
+
+// The enum order is the preference order: formats the FFI takes in place
+// come before YUYV.
+V4L2PixelFormat pickFormat(int fd, const std::string &device) {
+  V4L2PixelFormat best = V4L2PixelFormat::kAuto;
+  v4l2_fmtdesc desc{};
+  desc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  for (; xioctl(fd, VIDIOC_ENUM_FMT, &desc) == 0; ++desc.index) {
+    const V4L2PixelFormat format = fromFourcc(desc.pixelformat);
+    if (format != V4L2PixelFormat::kAuto &&
+        (best == V4L2PixelFormat::kAuto || format < best)) {
+      best = format;
+    }
+  }
+  if (best == V4L2PixelFormat::kAuto) {
+    reject(device, "offers none of NV12, YUV420, YUYV");
+  }
+  return best;
+}
+
+std::int64_t timestampUs(const v4l2_buffer &buf) {
+  // CLOCK_MONOTONIC is steady_clock on Linux, so both cases share a base.
+  if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) ==
+      V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+    return static_cast<std::int64_t>(buf.timestamp.tv_sec) * 1000000 +
+           buf.timestamp.tv_usec;
+  }
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+struct V4L2VideoSource::Device {
+  struct Buffer {
+    void *addr = MAP_FAILED;
+    std::size_t length = 0;
+    int dmabuf_fd = -1;
+    bool queued = false;
+  };
+
+  explicit Device(const Options &opts) : options(opts) {
+    try {
+      open();
+    } catch (...) {
+      close();
+      throw;
+    }
+  }
+
+  ~Device() { close(); }
+
+  void open() {
+    const std::string &name = options.device;
+    fd = ::open(name.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd == -1) {
+      fail(name, "cannot open");
+    }
+
+    v4l2_capability cap{};
+    if (xioctl(fd, VIDIOC_QUERYCAP, &cap) == -1) {
+      fail(name, "not a V4L2 device");
+    }
+    const std::uint32_t caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS)
+                                   ? cap.device_caps
+                                   : cap.capabilities;
+    if (!(caps & V4L2_CAP_VIDEO_CAPTURE)) {
+      reject(name, "not a single-planar video capture device");
+    }
+    if (!(caps & V4L2_CAP_STREAMING)) {
+      reject(name, "does not support streaming I/O");
+    }
+
+    const V4L2PixelFormat wanted = options.format == V4L2PixelFormat::kAuto
+                                       ? pickFormat(fd, name)
+                                       : options.format;
+    v4l2_format fmt{};
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.fmt.pix.width = static_cast<std::uint32_t>(options.width);
+    fmt.fmt.pix.height = static_cast<std::uint32_t>(options.height);
+    fmt.fmt.pix.pixelformat = toFourcc(wanted);
+    fmt.fmt.pix.field = V4L2_FIELD_NONE;
+    if (xioctl(fd, VIDIOC_S_FMT, &fmt) == -1) {
+      fail(name, "VIDIOC_S_FMT failed");
+    }
+    // Drivers substitute what they cannot do rather than failing.
+    format = fromFourcc(fmt.fmt.pix.pixelformat);
+    if (format == V4L2PixelFormat::kAuto ||
+        (options.format != V4L2PixelFormat::kAuto &&
+         format != options.format)) {
+      reject(name, "requested pixel format is not supported");
+    }
+    width = static_cast<int>(fmt.fmt.pix.width);
+    height = static_cast<int>(fmt.fmt.pix.height);
+    const std::uint32_t row = format == V4L2PixelFormat::kYUYV
+                                  ? 2 * ((fmt.fmt.pix.width + 1) & ~1u)
+                                  : fmt.fmt.pix.width;
+    stride = fmt.fmt.pix.bytesperline != 0 ? fmt.fmt.pix.bytesperline : row;
+    if (width <= 0 || height <= 0 || stride < row ||
+        (format == V4L2PixelFormat::kYUV420 && stride % 2 != 0)) {
+      reject(name, "driver reported an unusable buffer layout");
+    }
+
+    if (options.fps > 0) {
+      v4l2_streamparm parm{};
+      parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      if (xioctl(fd, VIDIOC_G_PARM, &parm) == 0 &&
+          (parm.parm.capture.capability & V4L2_CAP_TIMEPERFRAME)) {
+        parm.parm.capture.timeperframe.numerator = 1;
+        parm.parm.capture.timeperframe.denominator =
+            static_cast<std::uint32_t>(options.fps);
+        // Best effort: the driver keeps its own rate if it refuses.
+        (void)xioctl(fd, VIDIOC_S_PARM, &parm);
+      }
+    }
+
+    v4l2_requestbuffers req{};
+    req.count = options.buffer_count < 2 ? 2 : options.buffer_count;
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(fd, VIDIOC_REQBUFS, &req) == -1) {
+      fail(name, "VIDIOC_REQBUFS failed");
+    }
+    if (req.count < 2) {
+      reject(name, "insufficient buffer memory");
+    }
+    buffers.resize(req.count);
+    for (std::uint32_t i = 0; i < req.count; ++i) {
+      v4l2_buffer buf{};
+      buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      buf.memory = V4L2_MEMORY_MMAP;
+      buf.index = i;
+      if (xioctl(fd, VIDIOC_QUERYBUF, &buf) == -1) {
+        fail(name, "VIDIOC_QUERYBUF failed");
+      }
+      Buffer &b = buffers[i];
+      b.length = buf.length;
+      b.addr = mmap(nullptr, buf.length, PROT_READ, MAP_SHARED, fd,
+                    static_cast<off_t>(buf.m.offset));
+      if (b.addr == MAP_FAILED) {
+        fail(name, "mmap failed");
+      }
+      if (b.length < frameBytes()) {
+        reject(name, "streaming buffers are smaller than one frame");
+      }
+      if (options.export_dmabuf) {
+        v4l2_exportbuffer exp{};
+        exp.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        exp.index = i;
+        exp.flags = O_RDONLY | O_CLOEXEC;
+        if (xioctl(fd, VIDIOC_EXPBUF, &exp) == -1) {
+          fail(name, "VIDIOC_EXPBUF failed");
+        }
+        b.dmabuf_fd = exp.fd;
+      }
+    }
+
+    wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (wake_fd == -1 || epoll_fd == -1) {
+      fail(name, "cannot create the capture poller");
+    }
+    for (int watched : {fd, wake_fd}) {
+      epoll_event ev{};
+      ev.events = EPOLLIN;
+      ev.data.fd = watched;
+      if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, watched, &ev) == -1) {
+        fail(name, "epoll_ctl failed");
+      }
+    }
+  }
+
+  void close() noexcept {
+    if (fd != -1 && streaming) {
+      stopStreaming();
+    }
+    for (Buffer &b : buffers) {
+      if (b.addr != MAP_FAILED) {
+        munmap(b.addr, b.length);
+      }
+      if (b.dmabuf_fd != -1) {
+        ::close(b.dmabuf_fd);
+      }
+    }
+    buffers.clear();
+    for (int *owned : {&epoll_fd, &wake_fd, &fd}) {
+      if (*owned != -1) {
+        ::close(*owned);
+        *owned = -1;
+      }
+    }
+  }
+
+  // Bytes of one frame in the layout planes() describes.
+  std::size_t frameBytes() const noexcept {
+    const std::size_t h = static_cast<std::size_t>(height);
+    switch (format) {
+    case V4L2PixelFormat::kNV12:
+    case V4L2PixelFormat::kYUV420:
+      return stride * h + stride * ((h + 1) / 2);
+    default:
+      return stride * h;
+    }
+  }
+
+  VideoBufferType layout() const noexcept {
+    return format == V4L2PixelFormat::kNV12 ? VideoBufferType::NV12
+                                            : VideoBufferType::I420;
+  }
+
+  // Offsets and strides of the planes within a buffer, in planeInfos()
+  // order. V4L2 single-planar formats place the chroma planes right after
+  // luma, with a stride derived from bytesperline.
+  std::vector<NativeVideoPlane> planeLayout() const {
+    const std::uint64_t luma =
+        static_cast<std::uint64_t>(stride) * static_cast<unsigned>(height);
+    if (format == V4L2PixelFormat::kNV12) {
+      return {{0, stride}, {luma, stride}};
+    }
+    const std::uint32_t chroma_stride = stride / 2;
+    const std::uint64_t chroma =
+        static_cast<std::uint64_t>(chroma_stride) *
+        static_cast<unsigned>((height + 1) / 2);
+    return {{0, stride}, {luma, chroma_stride}, {luma + chroma, chroma_stride}};
+  }
+
+  bool queue(std::uint32_t index) noexcept {
+    Buffer &b = buffers[index];
+    if (b.queued) {
+      return true;
+    }
+    v4l2_buffer buf{};
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = index;
+    b.queued = xioctl(fd, VIDIOC_QBUF, &buf) == 0;
+    return b.queued;
+  }
+
+  void startStreaming() {
+    for (std::uint32_t i = 0; i < buffers.size(); ++i) {
+      if (!queue(i)) {
+        fail(options.device, "VIDIOC_QBUF failed");
+      }
+    }
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(fd, VIDIOC_STREAMON, &type) == -1) {
+      fail(options.device, "VIDIOC_STREAMON failed");
+    }
+    streaming = true;
+  }
+
+  // Also returns every buffer to the application side.
+  void stopStreaming() noexcept {
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    (void)xioctl(fd, VIDIOC_STREAMOFF, &type);
+    for (Buffer &b : buffers) {
+      b.queued = false;
+    }
+    std::uint64_t pending = 0;
+    (void)!read(wake_fd, &pending, sizeof(pending));
+    streaming = false;
+  }
+
+  void wake() noexcept {
+    const std::uint64_t one = 1;
+    (void)!write(wake_fd, &one, sizeof(one));
+  }
+
+  // Capture thread body; returns once woken, or on a device error.
+  void run(VideoSource &source) {
+    epoll_event events[2];
+    for (;;) {
+      const int n = epoll_wait(epoll_fd, events, 2, -1);
+      if (n == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        reportError("epoll_wait failed");
+        return;
+      }
+      bool ready = false;
+      for (int i = 0; i < n; ++i) {
+        if (events[i].data.fd == wake_fd) {
+          return;
+        }
+        ready = true;
+      }
+      if (!ready) {
+        continue;
+      }
+
+      // Drain everything that is ready and send only the newest frame.
+      v4l2_buffer newest{};
+      bool have = false;
+      bool error = false;
+      for (;;) {
+        v4l2_buffer buf{};
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(fd, VIDIOC_DQBUF, &buf) == -1) {
+          error = errno != EAGAIN;
+          break;
+        }
+        buffers[buf.index].queued = false;
+        if (have) {
+          queue(newest.index);
+          skipped.fetch_add(1, std::memory_order_relaxed);
+        }
+        newest = buf;
+        have = true;
+      }
+      if (have) {
+        deliver(source, newest);
+      }
+      if (error) {
+        reportError("VIDIOC_DQBUF failed");
+        return;
+      }
+    }
+  }
+
+  void deliver(VideoSource &source, const v4l2_buffer &buf) {
+    const std::uint32_t index = buf.index;
+    if (buf.flags & V4L2_BUF_FLAG_ERROR) {
+      failed.fetch_add(1, std::memory_order_relaxed);
+      queue(index);
+      return;
+    }
+    const std::int64_t timestamp_us = timestampUs(buf);
+    const Buffer &b = buffers[index];
+    auto requeue = [this, index] { queue(index); };
+    try {
+      if (format == V4L2PixelFormat::kYUYV) {
+        VideoFrame frame = pool.acquire(width, height, VideoBufferType::I422);
+        detail::yuyvToI422(static_cast<const std::uint8_t *>(b.addr),
+                           static_cast<int>(stride), frame);
+        // The camera already refills this buffer while the FFI encodes.
+        requeue();
+        source.captureFrame(frame, timestamp_us);
+      } else if (options.export_dmabuf) {
+        NativeVideoBuffer native;
+        native.kind = NativeBufferKind::kDmaBuf;
+        native.handle = static_cast<std::uintptr_t>(b.dmabuf_fd);
+        native.width = width;
+        native.height = height;
+        native.layout = layout();
+        native.planes = planeLayout();
+        native.size = b.length;
+        native.release = requeue;
+        source.captureNativeFrame(std::move(native), timestamp_us);
+      } else {
+        const auto base = reinterpret_cast<std::uintptr_t>(b.addr);
+        std::vector<VideoPlaneInfo> planes;
+        for (const NativeVideoPlane &p : planeLayout()) {
+          planes.push_back(
+              {base + static_cast<std::uintptr_t>(p.offset), p.stride,
+               static_cast<std::uint32_t>(b.length - p.offset)});
+        }
+        const VideoFrame frame = VideoFrame::wrapExternal(
+            width, height, layout(), std::move(planes), requeue);
+        source.captureFrame(frame, timestamp_us);
+      }
+      captured.fetch_add(1, std::memory_order_relaxed);
+    } catch (const std::exception &e) {
+      failed.fetch_add(1, std::memory_order_relaxed);
+      LK_LOG_WARN("livekit::v4l2", "%s: frame not captured: %s",
+                  options.device.c_str(), e.what());
+    }
+    // Capture is synchronous, so nothing reads the buffer any more; this
+    // covers a mapper that dropped the release.
+    requeue();
+  }
+
+  void reportError(const char *what) {
+    const std::string message =
+        options.device + ": " + what + ": " + std::strerror(errno);
+    LK_LOG_ERROR("livekit::v4l2", "capture stopped: %s", message.c_str());
+    if (options.on_error) {
+      options.on_error(message);
+    }
+  }
+
+  const Options options;
+  int fd = -1;
+  int wake_fd = -1;
+  int epoll_fd = -1;
+  bool streaming = false;
+  std::vector<Buffer> buffers;
+
+  int width = 0;
+  int height = 0;
+  std::uint32_t stride = 0; // bytesperline of the first plane
+  V4L2PixelFormat format = V4L2PixelFormat::kAuto;
+
+  VideoFramePool pool{2}; // YUYV conversion targets
+  std::atomic<std::uint64_t> captured{0};
+  std::atomic<std::uint64_t> skipped{0};
+  std::atomic<std::uint64_t> failed{0};
+};
+
+#else
+
+struct V4L2VideoSource::Device {
+  explicit Device(const Options &) {
+    throw std::runtime_error(
+        "V4L2VideoSource: V4L2 is only available on Linux");
+  }
+  void startStreaming() {}
+  void stopStreaming() noexcept {}
+  void wake() noexcept {}
+  void run(VideoSource &) {}
+
+  bool streaming = false;
+  int width = 0;
+  int height = 0;
+  V4L2PixelFormat format = V4L2PixelFormat::kAuto;
+  std::atomic<std::uint64_t> captured{0};
+  std::atomic<std::uint64_t> skipped{0};
+  std::atomic<std::uint64_t> failed{0};
+};
+
+#endif
+
+V4L2VideoSource::V4L2VideoSource(const Options &options)
+    : device_(std::make_unique<Device>(options)) {
+  source_ = std::make_shared<VideoSource>(device_->width, device_->height);
+}
+
+V4L2VideoSource::V4L2VideoSource(std::shared_ptr<VideoSource> source,
+                                 const Options &options)
+    : source_(std::move(source)) {
+  if (!source_) {
+    throw std::invalid_argument("V4L2VideoSource: source is null");
+  }
+  device_ = std::make_unique<Device>(options);
+}
+
+V4L2VideoSource::~V4L2VideoSource() { stop(); }
+
+int V4L2VideoSource::width() const noexcept { return device_->width; }
+
+int V4L2VideoSource::height() const noexcept { return device_->height; }
+
+V4L2PixelFormat V4L2VideoSource::format() const noexcept {
+  return device_->format;
+}
+
+void V4L2VideoSource::start() {
+  if (capturing_.load()) {
+    return;
+  }
+  // Reap a capture thread that stopped on a device error.
+  stop();
+  device_->startStreaming();
+  capturing_.store(true);
+  thread_ = std::thread([this] {
+    detail::registerThread(ThreadRole::kVideo, "lk-v4l2");
+    run();
+  });
+}
+
+void V4L2VideoSource::stop() {
+  if (thread_.joinable()) {
+    device_->wake();
+    thread_.join();
+  }
+  if (device_->streaming) {
+    device_->stopStreaming();
+  }
+  capturing_.store(false);
+}
+
+void V4L2VideoSource::run() {
+  device_->run(*source_);
+  capturing_.store(false);
+}
+
+V4L2CaptureStats V4L2VideoSource::stats() const noexcept {
+  V4L2CaptureStats out;
+  out.frames_captured = device_->captured.load(std::memory_order_relaxed);
+  out.frames_skipped = device_->skipped.load(std::memory_order_relaxed);
+  out.frames_failed = device_->failed.load(std::memory_order_relaxed);
+  return out;
+}
+
+} // namespace livekit
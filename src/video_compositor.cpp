@@ -0,0 +1,600 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/video_compositor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "livekit/video_source.h"
+#include "livekit/video_stream.h"
+#include "log.h"
+#include "task_pool.h"
+#include "thread_util.h"
+#include "video_scale.h"
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIVEKIT_VIDEO_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LIVEKIT_VIDEO_SIMD_NEON 1
+#endif
+
+namespace livekit {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kMaxThreads = 8;
+
+bool isCanvasFormat(VideoBufferType type) noexcept {
+  return type == VideoBufferType::I420 || type == VideoBufferType::RGBA ||
+         type == VideoBufferType::BGRA;
+}
+
+// dst = (src * a + dst * (256 - a) + 128) >> 8 for `n` bytes, a in [0, 256].
+// The 16-bit lanes peak at 255 * 256 + 128, so nothing overflows.
+void blendRow(std::uint8_t *dst, const std::uint8_t *src, std::size_t n,
+              unsigned a) noexcept {
+  std::size_t i = 0;
+#if defined(LIVEKIT_VIDEO_SIMD_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i wa = _mm_set1_epi16(static_cast<short>(a));
+  const __m128i wb = _mm_set1_epi16(static_cast<short>(256 - a));
+  const __m128i half = _mm_set1_epi16(128);
+  for (; i + 16 <= n; i += 16) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const __m128i d =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+    const __m128i lo = _mm_srli_epi16(
+        _mm_add_epi16(
+            _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), wa),
+                          _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), wb)),
+            half),
+        8);
+    const __m128i hi = _mm_srli_epi16(
+        _mm_add_epi16(
+            _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), wa),
+                          _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), wb)),
+            half),
+        8);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_packus_epi16(lo, hi));
+  }
+#elif defined(LIVEKIT_VIDEO_SIMD_NEON)
+  const uint16x8_t wa = vdupq_n_u16(static_cast<std::uint16_t>(a));
+  const uint16x8_t wb = vdupq_n_u16(static_cast<std::uint16_t>(256 - a));
+  for (; i + 16 <= n; i += 16) {
+    const uint8x16_t s = vld1q_u8(src + i);
+    const uint8x16_t d = vld1q_u8(dst + i);
+    const uint16x8_t lo = vmlaq_u16(vmulq_u16(vmovl_u8(vget_low_u8(s)), wa),
+                                    vmovl_u8(vget_low_u8(d)), wb);
+    const uint16x8_t hi = vmlaq_u16(vmulq_u16(vmovl_u8(vget_high_u8(s)), wa),
+                                    vmovl_u8(vget_high_u8(d)), wb);
+    vst1q_u8(dst + i, vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = static_cast<std::uint8_t>(
+        (src[i] * a + dst[i] * (256 - a) + 128) >> 8);
+  }
+}
+
+// Fill `rows` rows of `row_bytes` with the repeating `pixel` of `channels`
+// bytes.
+void fillRows(std::uint8_t *dst, std::size_t stride, int rows,
+              std::size_t row_bytes, const std::uint8_t *pixel,
+              int channels) noexcept {
+  if (rows <= 0) {
+    return;
+  }
+  if (channels == 1) {
+    for (int y = 0; y < rows; ++y) {
+      std::memset(dst + y * stride, pixel[0], row_bytes);
+    }
+    return;
+  }
+  // Build the first row, then copy it.
+  for (std::size_t x = 0; x + channels <= row_bytes; x += channels) {
+    std::memcpy(dst + x, pixel, static_cast<std::size_t>(channels));
+  }
+  for (int y = 1; y < rows; ++y) {
+    std::memcpy(dst + y * stride, dst, row_bytes);
+  }
+}
+
+// Non-owning frame over the `rect` part of `canvas`.
+VideoFrame regionOf(const VideoFrame &canvas, const VideoCompositorRect &rect) {
+  const VideoFormatLayout layout = videoFormatLayout(canvas.type());
+  const VideoPlanes planes = canvas.planes();
+  std::vector<VideoPlaneInfo> region(layout.num_planes);
+  for (std::size_t i = 0; i < layout.num_planes; ++i) {
+    const VideoPlaneFormat &format = layout.planes[i];
+    const std::size_t stride = planes[i].stride;
+    const std::size_t offset =
+        (static_cast<std::size_t>(rect.y) >> format.log2_subsample_y) *
+            stride +
+        (static_cast<std::size_t>(rect.x) >> format.log2_subsample_x) *
+            format.bytes_per_sample;
+    region[i].data_ptr = planes[i].data_ptr + offset;
+    region[i].stride = planes[i].stride;
+    region[i].size = static_cast<std::uint32_t>(
+        stride * (format.rows(rect.height) - 1) +
+        format.rowBytes(rect.width));
+  }
+  return VideoFrame::wrapExternal(rect.width, rect.height, canvas.type(),
+                                  std::move(region));
+}
+
+// Counts finished band jobs so the tick thread can wait for all of them.
+class BandLatch {
+public:
+  explicit BandLatch(std::size_t count) : remaining_(count) {}
+
+  void done() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--remaining_ == 0) {
+      cv_.notify_all();
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return remaining_ == 0; });
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::size_t remaining_;
+};
+
+} // namespace
+
+struct VideoCompositor::Input {
+  int id = 0;
+  std::shared_ptr<VideoStream> stream; // Null for push inputs.
+  InputOptions options;
+  // Newest frame, in the canvas format.
+  std::shared_ptr<const VideoFrame> frame;
+};
+
+struct VideoCompositor::Tile {
+  std::shared_ptr<const VideoFrame> frame;
+  VideoCompositorRect rect; // Where the frame lands, even-aligned for I420.
+  int z_order = 0;
+  int order = 0;
+  unsigned alpha = 256; // Opacity in 1/256.
+  // Scale target: a view over the canvas, or scratch space to blend from.
+  VideoFrame target;
+};
+
+VideoCompositor::VideoCompositor(const Options &options) : options_(options) {
+  if (!isCanvasFormat(options_.format)) {
+    throw std::invalid_argument(
+        "VideoCompositor: canvas format must be I420, RGBA or BGRA");
+  }
+  if (options_.format == VideoBufferType::I420) {
+    options_.width &= ~1;
+    options_.height &= ~1;
+  }
+  if (options_.width < 2 || options_.height < 2) {
+    throw std::invalid_argument("VideoCompositor: canvas is too small");
+  }
+  std::size_t threads = options_.threads;
+  if (threads == 0) {
+    threads = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1,
+                                      kMaxThreads);
+  }
+  if (threads > 1) {
+    // Two bands per thread even out tiles of uneven cost.
+    band_count_ = std::min<std::size_t>(
+        threads * 2, static_cast<std::size_t>(options_.height / 2));
+    workers_ = std::make_unique<detail::TaskPool>(threads - 1);
+  }
+  if (options_.fps > 0) {
+    thread_ = std::thread([this] {
+      detail::registerThread(ThreadRole::kVideo, "lk-compositor");
+      run();
+    });
+  }
+}
+
+VideoCompositor::~VideoCompositor() {
+  stopping_.store(true);
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+int VideoCompositor::addInput(std::shared_ptr<VideoStream> stream,
+                              const InputOptions &options) {
+  if (!stream) {
+    throw std::invalid_argument("VideoCompositor::addInput: null stream");
+  }
+  auto input = std::make_shared<Input>();
+  input->stream = std::move(stream);
+  input->options = options;
+  std::lock_guard<std::mutex> lock(mutex_);
+  input->id = next_input_id_++;
+  inputs_.push_back(input);
+  return input->id;
+}
+
+int VideoCompositor::addInput(const InputOptions &options) {
+  auto input = std::make_shared<Input>();
+  input->options = options;
+  std::lock_guard<std::mutex> lock(mutex_);
+  input->id = next_input_id_++;
+  inputs_.push_back(input);
+  return input->id;
+}
+
+void VideoCompositor::pushFrame(int id, VideoFrame frame) {
+  const bool convert = frame.type() != options_.format;
+  auto shared = std::make_shared<const VideoFrame>(
+      convert ? frame.convert(options_.format) : std::move(frame));
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &input : inputs_) {
+    if (input->id == id && !input->stream) {
+      input->frame = std::move(shared);
+      stats_.converted_frames += convert ? 1 : 0;
+      return;
+    }
+  }
+  throw std::invalid_argument("VideoCompositor::pushFrame: unknown input");
+}
+
+void VideoCompositor::updateInput(int id, const InputOptions &options) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &input : inputs_) {
+    if (input->id == id) {
+      input->options = options;
+      return;
+    }
+  }
+  throw std::invalid_argument("VideoCompositor::updateInput: unknown input");
+}
+
+void VideoCompositor::removeInput(int id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  inputs_.erase(std::remove_if(inputs_.begin(), inputs_.end(),
+                               [id](const std::shared_ptr<Input> &input) {
+                                 return input->id == id;
+                               }),
+                inputs_.end());
+}
+
+std::size_t VideoCompositor::inputCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return inputs_.size();
+}
+
+VideoCompositorStats VideoCompositor::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+std::vector<VideoCompositor::Tile> VideoCompositor::collectTiles() {
+  std::vector<std::shared_ptr<Input>> inputs;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inputs = inputs_;
+  }
+
+  // Read streams outside the lock; only the newest frame is kept.
+  std::vector<int> ended;
+  std::uint64_t converted = 0;
+  for (const auto &input : inputs) {
+    if (!input->stream) {
+      continue;
+    }
+    VideoFrameEvent ev;
+    bool fresh = false;
+    while (input->stream->tryRead(ev)) {
+      fresh = true;
+    }
+    if (!fresh) {
+      if (input->stream->isEnded()) {
+        ended.push_back(input->id);
+      }
+      continue;
+    }
+    std::shared_ptr<const VideoFrame> frame;
+    try {
+      if (ev.frame.type() == options_.format) {
+        frame = std::make_shared<const VideoFrame>(std::move(ev.frame));
+      } else {
+        frame = std::make_shared<const VideoFrame>(
+            ev.frame.convert(options_.format));
+        ++converted;
+      }
+    } catch (const std::exception &e) {
+      LK_LOG_WARN("livekit::video_compositor",
+                  "input %d: frame dropped, conversion failed: %s", input->id,
+                  e.what());
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    input->frame = std::move(frame);
+  }
+
+  std::vector<Tile> tiles;
+  std::size_t grid_inputs = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.converted_frames += converted;
+    for (int id : ended) {
+      inputs_.erase(std::remove_if(inputs_.begin(), inputs_.end(),
+                                   [id](const std::shared_ptr<Input> &input) {
+                                     return input->id == id;
+                                   }),
+                    inputs_.end());
+    }
+    inputs = inputs_;
+    for (const auto &input : inputs) {
+      grid_inputs += input->options.rect ? 0 : 1;
+    }
+    tiles.reserve(inputs.size());
+    for (const auto &input : inputs) {
+      Tile tile;
+      tile.frame = input->frame;
+      tile.z_order = input->options.z_order;
+      tile.order = input->id;
+      tile.alpha = static_cast<unsigned>(std::lround(
+          std::clamp(input->options.opacity, 0.0f, 1.0f) * 256.0f));
+      if (input->options.rect) {
+        tile.rect = *input->options.rect;
+      }
+      tiles.push_back(std::move(tile));
+    }
+  }
+
+  // Grid slots for inputs without a fixed rect, in insertion order.
+  const int w = options_.width;
+  const int h = options_.height;
+  const int cols = grid_inputs == 0
+                       ? 1
+                       : static_cast<int>(std::ceil(
+                             std::sqrt(static_cast<double>(grid_inputs))));
+  const int rows =
+      static_cast<int>((grid_inputs + static_cast<std::size_t>(cols) - 1) /
+                       static_cast<std::size_t>(cols));
+  int slot = 0;
+  for (std::size_t i = 0; i < tiles.size(); ++i) {
+    if (inputs[i]->options.rect) {
+      continue;
+    }
+    const int col = slot % cols;
+    const int row = slot / cols;
+    ++slot;
+    Tile &tile = tiles[i];
+    tile.rect.x = col * w / cols;
+    tile.rect.y = row * h / rows;
+    tile.rect.width = (col + 1) * w / cols - tile.rect.x;
+    tile.rect.height = (row + 1) * h / rows - tile.rect.y;
+  }
+
+  const bool even = options_.format == VideoBufferType::I420;
+  std::vector<Tile> placed;
+  placed.reserve(tiles.size());
+  for (Tile &tile : tiles) {
+    if (!tile.frame || tile.alpha == 0 || tile.frame->width() <= 0 ||
+        tile.frame->height() <= 0) {
+      continue;
+    }
+    VideoCompositorRect &r = tile.rect;
+    if (options_.keep_aspect) {
+      const std::int64_t fw = tile.frame->width();
+      const std::int64_t fh = tile.frame->height();
+      int fit_w = r.width;
+      int fit_h = r.height;
+      if (fw * r.height > fh * r.width) {
+        fit_h = static_cast<int>(fh * r.width / fw);
+      } else {
+        fit_w = static_cast<int>(fw * r.height / fh);
+      }
+      r.x += (r.width - fit_w) / 2;
+      r.y += (r.height - fit_h) / 2;
+      r.width = fit_w;
+      r.height = fit_h;
+    }
+    // Clip to the canvas.
+    const int x0 = std::max(r.x, 0);
+    const int y0 = std::max(r.y, 0);
+    const int x1 = std::min(r.x + r.width, w);
+    const int y1 = std::min(r.y + r.height, h);
+    r = VideoCompositorRect{x0, y0, x1 - x0, y1 - y0};
+    if (even) {
+      // Chroma samples cover 2x2 pixels; keep tiles on that grid.
+      r.x &= ~1;
+      r.y &= ~1;
+      r.width &= ~1;
+      r.height &= ~1;
+    }
+    if (r.width <= 0 || r.height <= 0) {
+      continue;
+    }
+    placed.push_back(std::move(tile));
+  }
+  std::stable_sort(placed.begin(), placed.end(),
+                   [](const Tile &a, const Tile &b) {
+                     return a.z_order != b.z_order ? a.z_order < b.z_order
+                                                   : a.order < b.order;
+                   });
+  return placed;
+}
+
+void VideoCompositor::composeBand(const VideoFrame &canvas,
+                                  std::vector<Tile> &tiles, int row_begin,
+                                  int row_end) const {
+  const VideoFormatLayout layout = videoFormatLayout(canvas.type());
+  const VideoPlanes planes = canvas.planes();
+  const auto &rgb = options_.background;
+
+  // Background.
+  std::array<std::array<std::uint8_t, 4>, 3> colour{};
+  if (canvas.type() == VideoBufferType::I420) {
+    const int r = rgb[0], g = rgb[1], b = rgb[2];
+    // BT.601 limited range, as in the native RGB -> YUV conversion.
+    colour[0][0] = static_cast<std::uint8_t>(
+        ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    colour[1][0] = static_cast<std::uint8_t>(
+        ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+    colour[2][0] = static_cast<std::uint8_t>(
+        ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+  } else if (canvas.type() == VideoBufferType::RGBA) {
+    colour[0] = {rgb[0], rgb[1], rgb[2], 255};
+  } else {
+    colour[0] = {rgb[2], rgb[1], rgb[0], 255};
+  }
+  for (std::size_t i = 0; i < layout.num_planes; ++i) {
+    const VideoPlaneFormat &format = layout.planes[i];
+    const int y0 = static_cast<int>(format.rows(row_begin));
+    const int y1 = static_cast<int>(format.rows(row_end));
+    auto *base = reinterpret_cast<std::uint8_t *>(planes[i].data_ptr);
+    fillRows(base + static_cast<std::size_t>(y0) * planes[i].stride,
+             planes[i].stride, y1 - y0, format.rowBytes(canvas.width()),
+             colour[i].data(), format.bytes_per_sample);
+  }
+
+  // Tiles, bottom first.
+  for (Tile &tile : tiles) {
+    const int a = std::max(row_begin, tile.rect.y) - tile.rect.y;
+    const int b = std::min(row_end, tile.rect.y + tile.rect.height) -
+                  tile.rect.y;
+    if (a >= b) {
+      continue;
+    }
+    // Bands write disjoint rows of the shared target.
+    if (!detail::scaleNativeRows(*tile.frame, tile.target, a, b)) {
+      continue;
+    }
+    if (tile.alpha >= 256) {
+      continue; // Scaled straight into the canvas.
+    }
+    const VideoPlanes src = tile.target.planes();
+    for (std::size_t i = 0; i < layout.num_planes; ++i) {
+      const VideoPlaneFormat &format = layout.planes[i];
+      const std::size_t offset =
+          static_cast<std::size_t>(tile.rect.x >> format.log2_subsample_x) *
+          format.bytes_per_sample;
+      const int y0 = static_cast<int>(format.rows(a));
+      const int y1 = static_cast<int>(format.rows(b));
+      const int top = tile.rect.y >> format.log2_subsample_y;
+      const std::size_t row_bytes = format.rowBytes(tile.rect.width);
+      auto *dst = reinterpret_cast<std::uint8_t *>(planes[i].data_ptr);
+      const auto *s = reinterpret_cast<const std::uint8_t *>(src[i].data_ptr);
+      for (int y = y0; y < y1; ++y) {
+        blendRow(dst + static_cast<std::size_t>(top + y) * planes[i].stride +
+                     offset,
+                 s + static_cast<std::size_t>(y) * src[i].stride, row_bytes,
+                 tile.alpha);
+      }
+    }
+  }
+}
+
+VideoFrame VideoCompositor::composeFrame() {
+  const auto started = Clock::now();
+  std::vector<Tile> tiles = collectTiles();
+  VideoFrame canvas =
+      pool_.acquire(options_.width, options_.height, options_.format);
+  for (Tile &tile : tiles) {
+    tile.target = tile.alpha >= 256
+                      ? regionOf(canvas, tile.rect)
+                      : pool_.acquire(tile.rect.width, tile.rect.height,
+                                      options_.format);
+  }
+
+  // Even band edges keep I420 chroma rows inside one band.
+  const std::size_t bands = band_count_;
+  const int band_rows =
+      ((options_.height + static_cast<int>(bands) - 1) /
+           static_cast<int>(bands) +
+       1) &
+      ~1;
+  auto band = [&](std::size_t i) {
+    const int begin = static_cast<int>(i) * band_rows;
+    const int end = std::min(options_.height, begin + band_rows);
+    if (begin < end) {
+      composeBand(canvas, tiles, begin, end);
+    }
+  };
+  if (!workers_ || bands <= 1) {
+    band(0);
+  } else {
+    BandLatch latch(bands - 1);
+    for (std::size_t i = 1; i < bands; ++i) {
+      workers_->post([&band, &latch, i] {
+        struct Done {
+          BandLatch &latch;
+          ~Done() { latch.done(); }
+        } done{latch};
+        band(i);
+      });
+    }
+    band(0);
+    latch.wait();
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      Clock::now() - started);
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.frames_composed;
+  stats_.last_compose_time = elapsed;
+  return canvas;
+}
+
+void VideoCompositor::run() {
+  FramePacer pacer(MediaClock::framePeriod(options_.fps),
+                   /*skip_missed=*/true);
+  const auto start = Clock::now();
+  while (!stopping_.load()) {
+    VideoFrame frame = composeFrame();
+    const std::int64_t timestamp_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                              start)
+            .count();
+    try {
+      if (options_.on_frame) {
+        options_.on_frame(frame, timestamp_us);
+      }
+      if (options_.source) {
+        // The pooled buffer goes back to the pool once the FFI is done.
+        (void)options_.source->captureFrameAsync(std::move(frame),
+                                                 timestamp_us);
+      }
+    } catch (const std::exception &e) {
+      LK_LOG_WARN("livekit::video_compositor", "frame delivery failed: %s",
+                  e.what());
+    }
+    pacer.wait();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.missed_ticks = pacer.stats().missed_ticks;
+  }
+}
+
+} // namespace livekit
@@ -0,0 +1,529 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "video_convert.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIVEKIT_VIDEO_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LIVEKIT_VIDEO_SIMD_NEON 1
+#endif
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+// Byte offsets of each channel within a 4-byte pixel (memory order).
+struct RgbOrder {
+  int r, g, b, a;
+};
+
+bool rgbOrder(VideoBufferType type, RgbOrder &out) noexcept {
+  switch (type) {
+  case VideoBufferType::RGBA:
+    out = {0, 1, 2, 3};
+    return true;
+  case VideoBufferType::BGRA:
+    out = {2, 1, 0, 3};
+    return true;
+  case VideoBufferType::ARGB:
+    out = {1, 2, 3, 0};
+    return true;
+  case VideoBufferType::ABGR:
+    out = {3, 2, 1, 0};
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool isYuv420(VideoBufferType type) noexcept {
+  return type == VideoBufferType::I420 || type == VideoBufferType::NV12;
+}
+
+std::uint8_t clamp255(int v) noexcept {
+  return static_cast<std::uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// A 4:2:0 image: Y plane plus either separate U/V planes (I420, step 1) or
+// one interleaved UV plane (NV12, step 2, v = u + 1).
+struct Yuv420 {
+  std::uint8_t *y;
+  std::uint8_t *u;
+  std::uint8_t *v;
+  int y_stride;
+  int uv_stride;
+  int uv_step;
+};
+
+bool yuv420Planes(const VideoFrame &frame, Yuv420 &out) {
+  const VideoPlanes planes = frame.planes();
+  auto ptr = [&](std::size_t i) {
+    return reinterpret_cast<std::uint8_t *>(planes[i].data_ptr);
+  };
+  if (frame.type() == VideoBufferType::I420 && planes.size() >= 3) {
+    out.y = ptr(0);
+    out.u = ptr(1);
+    out.v = ptr(2);
+    out.y_stride = static_cast<int>(planes[0].stride);
+    out.uv_stride = static_cast<int>(planes[1].stride);
+    out.uv_step = 1;
+    // Separate U and V planes must share a stride for the row loops.
+    return planes[1].stride == planes[2].stride;
+  }
+  if (frame.type() == VideoBufferType::NV12 && planes.size() >= 2) {
+    out.y = ptr(0);
+    out.u = ptr(1);
+    out.v = ptr(1) + 1;
+    out.y_stride = static_cast<int>(planes[0].stride);
+    out.uv_stride = static_cast<int>(planes[1].stride);
+    out.uv_step = 2;
+    return true;
+  }
+  return false;
+}
+
+bool packedPlane(const VideoFrame &frame, std::uint8_t *&data, int &stride) {
+  const VideoPlanes planes = frame.planes();
+  if (planes.empty()) {
+    return false;
+  }
+  data = reinterpret_cast<std::uint8_t *>(planes[0].data_ptr);
+  stride = static_cast<int>(planes[0].stride);
+  return true;
+}
+
+// ---- YUV -> RGB (BT.601 limited range, 8-bit fixed point) -----------------
+//
+//   c = Y - 16, d = U - 128, e = V - 128
+//   R = (298c + 409e + 128) >> 8
+//   G = (298c - 100d - 208e + 128) >> 8
+//   B = (298c + 516d + 128) >> 8
+//
+// The SIMD paths compute exactly the same integers as the scalar one.
+
+inline void yuvPixelToRgb(int y, int u, int v, std::uint8_t *px,
+                          const RgbOrder &o) noexcept {
+  const int c = y - 16;
+  const int d = u - 128;
+  const int e = v - 128;
+  px[o.r] = clamp255((298 * c + 409 * e + 128) >> 8);
+  px[o.g] = clamp255((298 * c - 100 * d - 208 * e + 128) >> 8);
+  px[o.b] = clamp255((298 * c + 516 * d + 128) >> 8);
+  px[o.a] = 255;
+}
+
+#if defined(LIVEKIT_VIDEO_SIMD_SSE2)
+
+// 8 pixels: c, d, e are int16 lanes (d/e already duplicated per pixel pair).
+inline void yuv8ToRgbSse2(__m128i c, __m128i d, __m128i e, std::uint8_t *dst,
+                          const RgbOrder &o) noexcept {
+  const __m128i k_ce = _mm_setr_epi16(298, 409, 298, 409, 298, 409, 298, 409);
+  const __m128i k_cd_g =
+      _mm_setr_epi16(298, -100, 298, -100, 298, -100, 298, -100);
+  const __m128i k_e1_g =
+      _mm_setr_epi16(-208, 128, -208, 128, -208, 128, -208, 128);
+  const __m128i k_cd_b = _mm_setr_epi16(298, 516, 298, 516, 298, 516, 298, 516);
+  const __m128i round = _mm_set1_epi32(128);
+  const __m128i ones = _mm_set1_epi16(1);
+
+  const __m128i ce_lo = _mm_unpacklo_epi16(c, e);
+  const __m128i ce_hi = _mm_unpackhi_epi16(c, e);
+  const __m128i cd_lo = _mm_unpacklo_epi16(c, d);
+  const __m128i cd_hi = _mm_unpackhi_epi16(c, d);
+  const __m128i e1_lo = _mm_unpacklo_epi16(e, ones);
+  const __m128i e1_hi = _mm_unpackhi_epi16(e, ones);
+
+  const __m128i r = _mm_packs_epi32(
+      _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(ce_lo, k_ce), round), 8),
+      _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(ce_hi, k_ce), round), 8));
+  const __m128i g = _mm_packs_epi32(
+      _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(cd_lo, k_cd_g),
+                                   _mm_madd_epi16(e1_lo, k_e1_g)),
+                     8),
+      _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(cd_hi, k_cd_g),
+                                   _mm_madd_epi16(e1_hi, k_e1_g)),
+                     8));
+  const __m128i b = _mm_packs_epi32(
+      _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(cd_lo, k_cd_b), round), 8),
+      _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(cd_hi, k_cd_b), round), 8));
+
+  __m128i slot[4];
+  slot[o.r] = _mm_packus_epi16(r, r);
+  slot[o.g] = _mm_packus_epi16(g, g);
+  slot[o.b] = _mm_packus_epi16(b, b);
+  slot[o.a] = _mm_set1_epi8(static_cast<char>(0xFF));
+
+  const __m128i p01 = _mm_unpacklo_epi8(slot[0], slot[1]);
+  const __m128i p23 = _mm_unpacklo_epi8(slot[2], slot[3]);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                   _mm_unpacklo_epi16(p01, p23));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 16),
+                   _mm_unpackhi_epi16(p01, p23));
+}
+
+#elif defined(LIVEKIT_VIDEO_SIMD_NEON)
+
+inline int16x8_t neonChannel(int16x8_t a, int16_t ka, int16x8_t b,
+                             int16_t kb) noexcept {
+  int32x4_t lo = vmull_n_s16(vget_low_s16(a), ka);
+  int32x4_t hi = vmull_n_s16(vget_high_s16(a), ka);
+  lo = vmlal_n_s16(lo, vget_low_s16(b), kb);
+  hi = vmlal_n_s16(hi, vget_high_s16(b), kb);
+  // Rounding shift adds the same +128 as the scalar formula.
+  return vcombine_s16(vrshrn_n_s32(lo, 8), vrshrn_n_s32(hi, 8));
+}
+
+inline void yuv8ToRgbNeon(int16x8_t c, int16x8_t d, int16x8_t e,
+                          std::uint8_t *dst, const RgbOrder &o) noexcept {
+  int32x4_t g_lo = vmull_n_s16(vget_low_s16(c), 298);
+  int32x4_t g_hi = vmull_n_s16(vget_high_s16(c), 298);
+  g_lo = vmlal_n_s16(g_lo, vget_low_s16(d), -100);
+  g_hi = vmlal_n_s16(g_hi, vget_high_s16(d), -100);
+  g_lo = vmlal_n_s16(g_lo, vget_low_s16(e), -208);
+  g_hi = vmlal_n_s16(g_hi, vget_high_s16(e), -208);
+
+  uint8x8x4_t px;
+  px.val[o.r] = vqmovun_s16(neonChannel(c, 298, e, 409));
+  px.val[o.g] =
+      vqmovun_s16(vcombine_s16(vrshrn_n_s32(g_lo, 8), vrshrn_n_s32(g_hi, 8)));
+  px.val[o.b] = vqmovun_s16(neonChannel(c, 298, d, 516));
+  px.val[o.a] = vdup_n_u8(255);
+  vst4_u8(dst, px);
+}
+
+#endif
+
+void yuvRowToRgb(const std::uint8_t *y, const std::uint8_t *u,
+                 const std::uint8_t *v, int uv_step, std::uint8_t *dst,
+                 int width, const RgbOrder &o) noexcept {
+  int x = 0;
+#if defined(LIVEKIT_VIDEO_SIMD_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i k16 = _mm_set1_epi16(16);
+  const __m128i k128 = _mm_set1_epi16(128);
+  for (; x + 8 <= width; x += 8) {
+    const __m128i yv = _mm_unpacklo_epi8(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + x)), zero);
+    __m128i uv16, vv16;
+    if (uv_step == 1) {
+      std::int32_t u4, v4;
+      std::memcpy(&u4, u + x / 2, 4);
+      std::memcpy(&v4, v + x / 2, 4);
+      const __m128i u8 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(u4), zero);
+      const __m128i v8 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v4), zero);
+      uv16 = _mm_unpacklo_epi16(u8, u8);
+      vv16 = _mm_unpacklo_epi16(v8, v8);
+    } else {
+      // NV12: 4 interleaved UV pairs -> split and duplicate per pixel pair.
+      const __m128i pairs = _mm_unpacklo_epi8(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + x)), zero);
+      const __m128i us = _mm_and_si128(pairs, _mm_set1_epi32(0xFFFF));
+      const __m128i vs = _mm_srli_epi32(pairs, 16);
+      uv16 = _mm_or_si128(us, _mm_slli_epi32(us, 16));
+      vv16 = _mm_or_si128(vs, _mm_slli_epi32(vs, 16));
+    }
+    yuv8ToRgbSse2(_mm_sub_epi16(yv, k16), _mm_sub_epi16(uv16, k128),
+                  _mm_sub_epi16(vv16, k128), dst + x * 4, o);
+  }
+#elif defined(LIVEKIT_VIDEO_SIMD_NEON)
+  for (; x + 8 <= width; x += 8) {
+    const int16x8_t c =
+        vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y + x))),
+                  vdupq_n_s16(16));
+    uint8x8_t u8, v8;
+    if (uv_step == 1) {
+      const uint8x8_t us = vld1_u8(u + x / 2); // 4 used, 8 loaded
+      const uint8x8_t vs = vld1_u8(v + x / 2);
+      u8 = vzip_u8(us, us).val[0];
+      v8 = vzip_u8(vs, vs).val[0];
+    } else {
+      const uint8x8x2_t uv = vld2_u8(u + x); // 4 used pairs of 8 loaded
+      u8 = vzip_u8(uv.val[0], uv.val[0]).val[0];
+      v8 = vzip_u8(uv.val[1], uv.val[1]).val[0];
+    }
+    const int16x8_t d =
+        vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u8)), vdupq_n_s16(128));
+    const int16x8_t e =
+        vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v8)), vdupq_n_s16(128));
+    yuv8ToRgbNeon(c, d, e, dst + x * 4, o);
+  }
+#endif
+  for (; x < width; ++x) {
+    const int ci = (x / 2) * uv_step;
+    yuvPixelToRgb(y[x], u[ci], v[ci], dst + x * 4, o);
+  }
+}
+
+bool yuvToRgb(const VideoFrame &src, VideoFrame &dst, bool flip_y) {
+  Yuv420 in;
+  RgbOrder o;
+  std::uint8_t *out = nullptr;
+  int out_stride = 0;
+  if (!yuv420Planes(src, in) || !rgbOrder(dst.type(), o) ||
+      !packedPlane(dst, out, out_stride)) {
+    return false;
+  }
+#if defined(LIVEKIT_VIDEO_SIMD_NEON)
+  // The NEON loads read 8 chroma bytes for 4 pixels; keep them in bounds by
+  // leaving the last chroma block of each row to the scalar tail.
+  const int simd_width = std::max(0, src.width() - 16);
+#else
+  const int simd_width = src.width();
+#endif
+  const int h = src.height();
+  for (int row = 0; row < h; ++row) {
+    const int sy = flip_y ? h - 1 - row : row;
+    const std::uint8_t *y =
+        in.y + static_cast<std::ptrdiff_t>(sy) * in.y_stride;
+    const std::ptrdiff_t uv_off =
+        static_cast<std::ptrdiff_t>(sy / 2) * in.uv_stride;
+    std::uint8_t *d = out + static_cast<std::ptrdiff_t>(row) * out_stride;
+    const int head = simd_width & ~7;
+    yuvRowToRgb(y, in.u + uv_off, in.v + uv_off, in.uv_step, d, head, o);
+    for (int x = head; x < src.width(); ++x) {
+      const int ci = (x / 2) * in.uv_step;
+      yuvPixelToRgb(y[x], in.u[uv_off + ci], in.v[uv_off + ci], d + x * 4, o);
+    }
+  }
+  return true;
+}
+
+// ---- RGB -> YUV ------------------------------------------------------------
+//
+//   Y = ((66R + 129G + 25B + 128) >> 8) + 16
+//   U = ((-38R - 74G + 112B + 128) >> 8) + 128
+//   V = ((112R - 94G - 18B + 128) >> 8) + 128
+//
+// Chroma is computed from the average of each 2x2 block. This direction runs
+// on capture (once per published frame) and is left as scalar code that the
+// compiler can auto-vectorize.
+
+inline std::uint8_t rgbToY(int r, int g, int b) noexcept {
+  return static_cast<std::uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) +
+                                   16);
+}
+
+bool rgbToYuv(const VideoFrame &src, VideoFrame &dst, bool flip_y) {
+  RgbOrder o;
+  std::uint8_t *in = nullptr;
+  int in_stride = 0;
+  Yuv420 out;
+  if (!rgbOrder(src.type(), o) || !packedPlane(src, in, in_stride) ||
+      !yuv420Planes(dst, out)) {
+    return false;
+  }
+  const int w = src.width();
+  const int h = src.height();
+  auto srcRow = [&](int row) {
+    const int sy = flip_y ? h - 1 - row : row;
+    return static_cast<const std::uint8_t *>(in) +
+           static_cast<std::ptrdiff_t>(sy) * in_stride;
+  };
+
+  for (int row = 0; row < h; ++row) {
+    const std::uint8_t *s = srcRow(row);
+    std::uint8_t *y = out.y + static_cast<std::ptrdiff_t>(row) * out.y_stride;
+    for (int x = 0; x < w; ++x) {
+      const std::uint8_t *px = s + x * 4;
+      y[x] = rgbToY(px[o.r], px[o.g], px[o.b]);
+    }
+  }
+
+  for (int row = 0; row < h; row += 2) {
+    const std::uint8_t *s0 = srcRow(row);
+    const std::uint8_t *s1 = srcRow(std::min(row + 1, h - 1));
+    const std::ptrdiff_t uv_off =
+        static_cast<std::ptrdiff_t>(row / 2) * out.uv_stride;
+    for (int x = 0; x < w; x += 2) {
+      const int x1 = std::min(x + 1, w - 1);
+      const std::uint8_t *p[4] = {s0 + x * 4, s0 + x1 * 4, s1 + x * 4,
+                                  s1 + x1 * 4};
+      int r = 0, g = 0, b = 0;
+      for (const std::uint8_t *px : p) {
+        r += px[o.r];
+        g += px[o.g];
+        b += px[o.b];
+      }
+      r = (r + 2) >> 2;
+      g = (g + 2) >> 2;
+      b = (b + 2) >> 2;
+      const std::ptrdiff_t ci = uv_off + (x / 2) * out.uv_step;
+      out.u[ci] = clamp255(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+      out.v[ci] = clamp255(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+  }
+  return true;
+}
+
+// ---- Packed swizzle / same-format copy --------------------------------------
+
+bool swizzle(const VideoFrame &src, VideoFrame &dst, bool flip_y) {
+  RgbOrder si, di;
+  std::uint8_t *in = nullptr;
+  std::uint8_t *out = nullptr;
+  int in_stride = 0;
+  int out_stride = 0;
+  if (!rgbOrder(src.type(), si) || !rgbOrder(dst.type(), di) ||
+      !packedPlane(src, in, in_stride) || !packedPlane(dst, out, out_stride)) {
+    return false;
+  }
+  const int w = src.width();
+  const int h = src.height();
+  for (int row = 0; row < h; ++row) {
+    const int sy = flip_y ? h - 1 - row : row;
+    const std::uint8_t *s = in + static_cast<std::ptrdiff_t>(sy) * in_stride;
+    std::uint8_t *d = out + static_cast<std::ptrdiff_t>(row) * out_stride;
+    for (int x = 0; x < w; ++x) {
+      const std::uint8_t *sp = s + x * 4;
+      std::uint8_t *dp = d + x * 4;
+      dp[di.r] = sp[si.r];
+      dp[di.g] = sp[si.g];
+      dp[di.b] = sp[si.b];
+      dp[di.a] = sp[si.a];
+    }
+  }
+  return true;
+}
+
+bool copyPlanes(const VideoFrame &src, VideoFrame &dst, bool flip_y) {
+  const VideoPlanes sp = src.planes();
+  const VideoPlanes dp = dst.planes();
+  if (sp.empty() || sp.size() != dp.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < sp.size(); ++i) {
+    if (sp[i].stride == 0 || dp[i].stride == 0) {
+      return false;
+    }
+    const std::uint32_t rows =
+        std::min(sp[i].size / sp[i].stride, dp[i].size / dp[i].stride);
+    const std::uint32_t row_bytes = std::min(sp[i].stride, dp[i].stride);
+    const auto *s = reinterpret_cast<const std::uint8_t *>(sp[i].data_ptr);
+    auto *d = reinterpret_cast<std::uint8_t *>(dp[i].data_ptr);
+    for (std::uint32_t row = 0; row < rows; ++row) {
+      const std::uint32_t sr = flip_y ? rows - 1 - row : row;
+      std::memcpy(d + static_cast<std::size_t>(row) * dp[i].stride,
+                  s + static_cast<std::size_t>(sr) * sp[i].stride, row_bytes);
+    }
+  }
+  return true;
+}
+
+// ---- YUYV -> I422 ----------------------------------------------------------
+
+void yuyvRowToI422(const std::uint8_t *src, std::uint8_t *y, std::uint8_t *u,
+                   std::uint8_t *v, int width) {
+  int x = 0;
+#if LIVEKIT_VIDEO_SIMD_SSE2
+  // 16 pixels (32 bytes) per step: even bytes are luma, odd bytes U/V.
+  const __m128i low = _mm_set1_epi16(0x00ff);
+  for (; x + 16 <= width; x += 16) {
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * x));
+    const __m128i b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * x + 16));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(y + x),
+        _mm_packus_epi16(_mm_and_si128(a, low), _mm_and_si128(b, low)));
+    const __m128i uv =
+        _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+    const __m128i zero = _mm_setzero_si128();
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(u + x / 2),
+                     _mm_packus_epi16(_mm_and_si128(uv, low), zero));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(v + x / 2),
+                     _mm_packus_epi16(_mm_srli_epi16(uv, 8), zero));
+  }
+#elif LIVEKIT_VIDEO_SIMD_NEON
+  for (; x + 16 <= width; x += 16) {
+    const uint8x8x4_t px = vld4_u8(src + 2 * x); // Y0 U Y1 V
+    vst2_u8(y + x, uint8x8x2_t{{px.val[0], px.val[2]}});
+    vst1_u8(u + x / 2, px.val[1]);
+    vst1_u8(v + x / 2, px.val[3]);
+  }
+#endif
+  for (; x + 2 <= width; x += 2) {
+    const std::uint8_t *p = src + 2 * x;
+    y[x] = p[0];
+    y[x + 1] = p[2];
+    u[x / 2] = p[1];
+    v[x / 2] = p[3];
+  }
+  if (x < width) {
+    // Odd width: the last pair is only half used.
+    const std::uint8_t *p = src + 2 * x;
+    y[x] = p[0];
+    u[x / 2] = p[1];
+    v[x / 2] = p[3];
+  }
+}
+
+} // namespace
+
+bool canConvertNative(VideoBufferType src, VideoBufferType dst) noexcept {
+  RgbOrder o;
+  const bool src_rgb = rgbOrder(src, o);
+  const bool dst_rgb = rgbOrder(dst, o);
+  return src == dst || (isYuv420(src) && dst_rgb) ||
+         (src_rgb && isYuv420(dst)) || (src_rgb && dst_rgb);
+}
+
+bool convertNative(const VideoFrame &src, VideoFrame &dst, bool flip_y) {
+  if (!canConvertNative(src.type(), dst.type()) ||
+      src.width() != dst.width() || src.height() != dst.height()) {
+    return false;
+  }
+  if (src.type() == dst.type()) {
+    return copyPlanes(src, dst, flip_y);
+  }
+  if (isYuv420(src.type())) {
+    return yuvToRgb(src, dst, flip_y);
+  }
+  if (isYuv420(dst.type())) {
+    return rgbToYuv(src, dst, flip_y);
+  }
+  return swizzle(src, dst, flip_y);
+}
+
+bool yuyvToI422(const std::uint8_t *src, int stride, VideoFrame &dst) {
+  const VideoPlanes planes = dst.planes();
+  if (dst.type() != VideoBufferType::I422 || planes.size() < 3) {
+    return false;
+  }
+  auto ptr = [&](std::size_t i) {
+    return reinterpret_cast<std::uint8_t *>(planes[i].data_ptr);
+  };
+  for (int row = 0; row < dst.height(); ++row) {
+    yuyvRowToI422(src + static_cast<std::size_t>(row) * stride,
+                  ptr(0) + static_cast<std::size_t>(row) * planes[0].stride,
+                  ptr(1) + static_cast<std::size_t>(row) * planes[1].stride,
+                  ptr(2) + static_cast<std::size_t>(row) * planes[2].stride,
+                  dst.width());
+  }
+  return true;
+}
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/video_frame.h"
+
+namespace livekit {
+namespace detail {
+
+// In-process pixel format conversion, used by VideoFrame::convert() and
+// convertInto() before falling back to the FFI `video_convert` request.
+//
+// Natively supported pairs:
+//   - I420 / NV12               -> RGBA / BGRA / ARGB / ABGR
+//   - RGBA / BGRA / ARGB / ABGR -> I420 / NV12
+//   - RGBA / BGRA / ARGB / ABGR -> RGBA / BGRA / ARGB / ABGR (swizzle)
+//   - any format -> the same format (plane copy, e.g. for flip_y)
+//
+// YUV uses BT.601 limited range, matching the FFI path.
+bool canConvertNative(VideoBufferType src, VideoBufferType dst) noexcept;
+
+// Write `src`, vertically flipped if `flip_y`, into `dst` (same dimensions,
+// format = dst.type()). Returns false, leaving `dst` untouched, if the pair
+// is not supported natively.
+bool convertNative(const VideoFrame &src, VideoFrame &dst, bool flip_y);
+
+// De-interleave packed 4:2:2 YUYV rows, `stride` bytes apart, as delivered
+// by V4L2 / UVC cameras, into `dst` (I422, same dimensions). The FFI has no
+// packed 4:2:2 type, so this is the one pass such a source needs. Returns
+// false, leaving `dst` untouched, if `dst` is not I422.
+bool yuyvToI422(const std::uint8_t *src, int stride, VideoFrame &dst);
+
+} // namespace detail
+} // namespace livekit
@@ -1,12 +1,18 @@
 #include "livekit/video_frame.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <iostream>
+#include <cstring>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "livekit/ffi_handle.h"
+#include "livekit/frame_pool.h"
+#include "log.h"
+#include "video_convert.h"
+#include "video_scale.h"
 #include "video_utils.h"
 
 namespace livekit {
@@ -18,243 +24,34 @@ std::size_t computeBufferSize(int width, int height, VideoBufferType type) {
     throw std::invalid_argument(
         "VideoFrame: width and height must be positive");
   }
-
-  const auto w = static_cast<std::size_t>(width);
-  const auto h = static_cast<std::size_t>(height);
-  switch (type) {
-  case VideoBufferType::ARGB:
-  case VideoBufferType::ABGR:
-  case VideoBufferType::RGBA:
-  case VideoBufferType::BGRA:
-    // 4 bytes per pixel
-    return w * h * 4;
-
-  case VideoBufferType::RGB24:
-    // 3 bytes per pixel
-    return w * h * 3;
-
-  case VideoBufferType::I444:
-    // Y, U, V all full resolution
-    return w * h * 3;
-
-  case VideoBufferType::I420:
-  case VideoBufferType::NV12:
-  case VideoBufferType::I010: {
-    // Y full, U and V subsampled 2x2
-    const std::size_t chroma_w = (w + 1) / 2;
-    const std::size_t chroma_h = (h + 1) / 2;
-    if (type == VideoBufferType::I420) {
-      // Y (1 byte) + U (1 byte) + V (1 byte)
-      return w * h + chroma_w * chroma_h * 2;
-    } else if (type == VideoBufferType::NV12) {
-      // Y (1 byte), UV interleaved (2 bytes per chroma sample)
-      return w * h + chroma_w * chroma_h * 2;
-    } else { // I010, 16 bits per sample in memory
-      // Y: 2 bytes per sample, U & V: 2 bytes per sample
-      return w * h * 2 + chroma_w * chroma_h * 4;
-    }
-  }
-
-  case VideoBufferType::I420A: {
-    // Y full, U & V 2x2, plus alpha full res
-    const std::size_t chroma_w = (w + 1) / 2;
-    const std::size_t chroma_h = (h + 1) / 2;
-    // Y + A are full resolution, U + V subsampled
-    return w * h * 2 + chroma_w * chroma_h * 2;
-  }
-
-  case VideoBufferType::I422: {
-    // Y full, U & V subsampled horizontally only
-    const std::size_t chroma_w = (w + 1) / 2;
-    return w * h + chroma_w * h * 2;
-  }
-
-  default:
+  const VideoFormatLayout layout = videoFormatLayout(type);
+  if (layout.num_planes == 0) {
     throw std::runtime_error("VideoFrame: unsupported VideoBufferType");
   }
+  return layout.bufferSize(width, height);
 }
 
-// Compute plane layout for (base_ptr, width, height, type)
-std::vector<VideoPlaneInfo>
-computePlaneInfos(uintptr_t base, int width, int height, VideoBufferType type) {
-  std::vector<VideoPlaneInfo> planes;
+// Compute the packed plane layout for (base_ptr, width, height, type).
+VideoPlanes computePlanes(uintptr_t base, int width, int height,
+                          VideoBufferType type) {
+  VideoPlanes planes;
   if (!base || width <= 0 || height <= 0) {
-    std::cerr << "[VideoFrame] Warning: invalid planeInfos input (ptr="
-              << base << ", w=" << width << ", h=" << height << ")\n";
+    LK_LOG_WARN("livekit::video_frame",
+                "invalid planeInfos input (ptr=%ju, w=%d, h=%d)",
+                static_cast<std::uintmax_t>(base), width, height);
     return planes;
   }
-  const auto w = static_cast<uint32_t>(width);
-  const auto h = static_cast<uint32_t>(height);
-  auto pushPlane = [&](uintptr_t ptr, uint32_t stride, uint32_t size) {
-    VideoPlaneInfo info;
+  // Unknown formats have no planes.
+  const VideoFormatLayout layout = videoFormatLayout(type);
+  uintptr_t ptr = base;
+  for (std::size_t i = 0; i < layout.num_planes; ++i) {
+    VideoPlaneInfo &info = planes[i];
     info.data_ptr = ptr;
-    info.stride = stride;
-    info.size = size;
-    planes.push_back(info);
-  };
-
-  switch (type) {
-  case VideoBufferType::ARGB:
-  case VideoBufferType::ABGR:
-  case VideoBufferType::RGBA:
-  case VideoBufferType::BGRA: {
-    const uint32_t stride = w * 4;
-    const uint32_t size = stride * h;
-    pushPlane(base, stride, size);
-    break;
-  }
-
-  case VideoBufferType::RGB24: {
-    const uint32_t stride = w * 3;
-    const uint32_t size = stride * h;
-    pushPlane(base, stride, size);
-    break;
-  }
-
-  case VideoBufferType::I420: {
-    const uint32_t chroma_w = (w + 1) / 2;
-    const uint32_t chroma_h = (h + 1) / 2;
-
-    // Y
-    const uint32_t y_stride = w;
-    const uint32_t y_size = w * h;
-    uintptr_t y_ptr = base;
-    pushPlane(y_ptr, y_stride, y_size);
-
-    // U
-    const uint32_t u_stride = chroma_w;
-    const uint32_t u_size = chroma_w * chroma_h;
-    uintptr_t u_ptr = y_ptr + y_size;
-    pushPlane(u_ptr, u_stride, u_size);
-
-    // V
-    const uint32_t v_stride = chroma_w;
-    const uint32_t v_size = chroma_w * chroma_h;
-    uintptr_t v_ptr = u_ptr + u_size;
-    pushPlane(v_ptr, v_stride, v_size);
-    break;
-  }
-
-  case VideoBufferType::I420A: {
-    const uint32_t chroma_w = (w + 1) / 2;
-    const uint32_t chroma_h = (h + 1) / 2;
-
-    // Y
-    const uint32_t y_stride = w;
-    const uint32_t y_size = w * h;
-    uintptr_t y_ptr = base;
-    pushPlane(y_ptr, y_stride, y_size);
-
-    // U
-    const uint32_t u_stride = chroma_w;
-    const uint32_t u_size = chroma_w * chroma_h;
-    uintptr_t u_ptr = y_ptr + y_size;
-    pushPlane(u_ptr, u_stride, u_size);
-
-    // V
-    const uint32_t v_stride = chroma_w;
-    const uint32_t v_size = chroma_w * chroma_h;
-    uintptr_t v_ptr = u_ptr + u_size;
-    pushPlane(v_ptr, v_stride, v_size);
-
-    // A (full res)
-    const uint32_t a_stride = w;
-    const uint32_t a_size = w * h;
-    uintptr_t a_ptr = v_ptr + v_size;
-    pushPlane(a_ptr, a_stride, a_size);
-    break;
-  }
-
-  case VideoBufferType::I422: {
-    const uint32_t chroma_w = (w + 1) / 2;
-
-    // Y
-    const uint32_t y_stride = w;
-    const uint32_t y_size = w * h;
-    uintptr_t y_ptr = base;
-    pushPlane(y_ptr, y_stride, y_size);
-
-    // U
-    const uint32_t u_stride = chroma_w;
-    const uint32_t u_size = chroma_w * h;
-    uintptr_t u_ptr = y_ptr + y_size;
-    pushPlane(u_ptr, u_stride, u_size);
-
-    // V
-    const uint32_t v_stride = chroma_w;
-    const uint32_t v_size = chroma_w * h;
-    uintptr_t v_ptr = u_ptr + u_size;
-    pushPlane(v_ptr, v_stride, v_size);
-    break;
-  }
-
-  case VideoBufferType::I444: {
-    // All planes full-res
-    const uint32_t y_stride = w;
-    const uint32_t y_size = w * h;
-    uintptr_t y_ptr = base;
-    pushPlane(y_ptr, y_stride, y_size);
-
-    const uint32_t u_stride = w;
-    const uint32_t u_size = w * h;
-    uintptr_t u_ptr = y_ptr + y_size;
-    pushPlane(u_ptr, u_stride, u_size);
-
-    const uint32_t v_stride = w;
-    const uint32_t v_size = w * h;
-    uintptr_t v_ptr = u_ptr + u_size;
-    pushPlane(v_ptr, v_stride, v_size);
-    break;
-  }
-
-  case VideoBufferType::I010: {
-    // 16-bit per sample
-    const uint32_t chroma_w = (w + 1) / 2;
-    const uint32_t chroma_h = (h + 1) / 2;
-
-    // Y
-    const uint32_t y_stride = w * 2;
-    const uint32_t y_size = w * h * 2;
-    uintptr_t y_ptr = base;
-    pushPlane(y_ptr, y_stride, y_size);
-
-    // U
-    const uint32_t u_stride = chroma_w * 2;
-    const uint32_t u_size = chroma_w * chroma_h * 2;
-    uintptr_t u_ptr = y_ptr + y_size;
-    pushPlane(u_ptr, u_stride, u_size);
-
-    // V
-    const uint32_t v_stride = chroma_w * 2;
-    const uint32_t v_size = chroma_w * chroma_h * 2;
-    uintptr_t v_ptr = u_ptr + u_size;
-    pushPlane(v_ptr, v_stride, v_size);
-    break;
+    info.stride = layout.planes[i].rowBytes(width);
+    info.size = static_cast<std::uint32_t>(layout.planeSize(i, width, height));
+    ptr += info.size;
   }
-
-  case VideoBufferType::NV12: {
-    const uint32_t chroma_w = (w + 1) / 2;
-    const uint32_t chroma_h = (h + 1) / 2;
-
-    // Y
-    const uint32_t y_stride = w;
-    const uint32_t y_size = w * h;
-    uintptr_t y_ptr = base;
-    pushPlane(y_ptr, y_stride, y_size);
-
-    // UV interleaved
-    const uint32_t uv_stride = chroma_w * 2;
-    const uint32_t uv_size = chroma_w * chroma_h * 2;
-    uintptr_t uv_ptr = y_ptr + y_size;
-    pushPlane(uv_ptr, uv_stride, uv_size);
-    break;
-  }
-
-  default:
-    // Unknown or unsupported -> no planes
-    break;
-  }
-
+  planes.count = layout.num_planes;
   return planes;
 }
 
@@ -277,19 +74,118 @@ VideoFrame::VideoFrame(int width, int height, VideoBufferType type,
   }
 }
 
+VideoFrame::~VideoFrame() {
+  if (auto pool = pool_.lock()) {
+    pool->recycle(std::move(data_));
+  }
+}
+
+VideoFrame &VideoFrame::operator=(VideoFrame &&other) noexcept {
+  if (this != &other) {
+    if (auto pool = pool_.lock()) {
+      pool->recycle(std::move(data_));
+    }
+    width_ = other.width_;
+    height_ = other.height_;
+    type_ = other.type_;
+    data_ = std::move(other.data_);
+    native_handle_ = std::move(other.native_handle_);
+    external_release_ = std::move(other.external_release_);
+    native_planes_ = std::move(other.native_planes_);
+    native_data_ = other.native_data_;
+    native_size_ = other.native_size_;
+    pool_ = std::move(other.pool_);
+    other.native_data_ = nullptr;
+    other.native_size_ = 0;
+  }
+  return *this;
+}
+
 VideoFrame VideoFrame::create(int width, int height, VideoBufferType type) {
   const std::size_t size = computeBufferSize(width, height, type);
   std::vector<std::uint8_t> buffer(size, 0);
   return VideoFrame(width, height, type, std::move(buffer));
 }
 
+VideoFrame VideoFrame::wrapExternal(int width, int height, VideoBufferType type,
+                                    std::vector<VideoPlaneInfo> planes,
+                                    std::function<void()> release) {
+  VideoFrame frame;
+  // Own the release first so it runs even if validation throws.
+  frame.external_release_ = std::shared_ptr<std::function<void()>>(
+      new std::function<void()>(std::move(release)),
+      [](std::function<void()> *callback) {
+        if (*callback) {
+          (*callback)();
+        }
+        delete callback;
+      });
+  frame.width_ = width;
+  frame.height_ = height;
+  frame.type_ = type;
+
+  computeBufferSize(width, height, type); // validates size and type
+  if (planes.empty() || planes.front().data_ptr == 0) {
+    throw std::invalid_argument("VideoFrame::wrapExternal: no plane data");
+  }
+  const VideoPlanes packed =
+      computePlanes(planes.front().data_ptr, width, height, type);
+  if (packed.size() != planes.size()) {
+    throw std::invalid_argument(
+        "VideoFrame::wrapExternal: wrong plane count for the format");
+  }
+  for (std::size_t i = 0; i < planes.size(); ++i) {
+    const std::uint64_t rows = packed[i].size / packed[i].stride;
+    const std::uint64_t needed =
+        static_cast<std::uint64_t>(planes[i].stride) * (rows - 1) +
+        packed[i].stride;
+    if (planes[i].data_ptr == 0 || planes[i].stride < packed[i].stride ||
+        planes[i].size < needed) {
+      throw std::invalid_argument(
+          "VideoFrame::wrapExternal: plane " + std::to_string(i) +
+          " is too small for the format and size");
+    }
+  }
+  VideoPlanes adopted;
+  std::copy(planes.begin(), planes.end(), adopted.plane.begin());
+  adopted.count = planes.size();
+  frame.adoptPlanes(adopted);
+  return frame;
+}
+
+void VideoFrame::adoptPlanes(const VideoPlanes &planes) {
+  native_planes_ = planes;
+  const VideoPlaneInfo &first = native_planes_[0];
+  native_data_ = reinterpret_cast<std::uint8_t *>(first.data_ptr);
+
+  // data()/dataSize() cover the whole frame only when planes are contiguous.
+  std::size_t extent = 0;
+  bool contiguous = true;
+  for (const auto &plane : native_planes_) {
+    if (plane.data_ptr != first.data_ptr + extent) {
+      contiguous = false;
+      break;
+    }
+    extent += plane.size;
+  }
+  native_size_ = contiguous ? extent : first.size;
+}
+
 std::vector<VideoPlaneInfo> VideoFrame::planeInfos() const {
+  const VideoPlanes p = planes();
+  return std::vector<VideoPlaneInfo>(p.begin(), p.end());
+}
+
+VideoPlanes VideoFrame::planes() const noexcept {
+  if (borrowed()) {
+    return native_planes_;
+  }
   if (data_.empty()) {
     return {};
   }
 
   uintptr_t base = reinterpret_cast<uintptr_t>(data_.data());
-  return computePlaneInfos(base, width_, height_, type_);
+  return computePlanes(base, width_, height_, type_);
 }
 
 VideoFrame VideoFrame::convert(VideoBufferType dst, bool flip_y) const {
@@ -297,11 +193,17 @@ VideoFrame VideoFrame::convert(VideoBufferType dst, bool flip_y) const {
   // We still return a *new* VideoFrame, never `*this`, so copy-ctor
   // being deleted is not a problem.
   if (dst == type_ && !flip_y) {
-    std::cerr << "KVideoFrame::convert Warning: converting to the same format"
-              << std::endl;
+    LK_LOG_DEBUG("livekit::video_frame",
+                 "VideoFrame::convert: converting to the same format");
     // copy pixel data
-    std::vector<std::uint8_t> buf = data_;
-    return VideoFrame(width_, height_, type_, std::move(buf));
+    return toOwned();
+  }
+
+  if (detail::canConvertNative(type_, dst)) {
+    VideoFrame out = create(width_, height_, dst);
+    if (detail::convertNative(*this, out, flip_y)) {
+      return out;
+    }
   }
 
   // General path: delegate to the FFI-based conversion helper.
@@ -309,57 +211,185 @@ VideoFrame VideoFrame::convert(VideoBufferType dst, bool flip_y) const {
   return convertViaFfi(*this, dst, flip_y);
 }
 
+void VideoFrame::convertInto(VideoFrame &dst, bool flip_y) const {
+  if (dst.width_ != width_ || dst.height_ != height_) {
+    throw std::invalid_argument(
+        "VideoFrame::convertInto: destination dimensions do not match");
+  }
+  if (dst.borrowed()) {
+    throw std::invalid_argument(
+        "VideoFrame::convertInto: destination must own its buffer");
+  }
+  if (detail::convertNative(*this, dst, flip_y)) {
+    return;
+  }
+
+  VideoFrame converted = convertViaFfi(*this, dst.type_, flip_y);
+  if (converted.dataSize() > dst.dataSize()) {
+    throw std::runtime_error(
+        "VideoFrame::convertInto: converted frame does not fit destination");
+  }
+  std::memcpy(dst.data(), converted.data(), converted.dataSize());
+}
+
+void VideoFrame::scaleInto(VideoFrame &dst) const {
+  if (dst.type_ != type_) {
+    throw std::invalid_argument(
+        "VideoFrame::scaleInto: destination format does not match");
+  }
+  if (dst.borrowed()) {
+    throw std::invalid_argument(
+        "VideoFrame::scaleInto: destination must own its buffer");
+  }
+  if (!detail::scaleNative(*this, dst)) {
+    throw std::invalid_argument(
+        "VideoFrame::scaleInto: unsupported format or frame layout");
+  }
+}
+
 VideoFrame VideoFrame::fromOwnedInfo(const proto::OwnedVideoBuffer &owned) {
+  // Pack the planes into an owned buffer; the temporary native frame releases
+  // the FFI-owned buffer once the copy is done.
+  return wrapOwnedInfo(owned).toOwned();
+}
+
+VideoFrame VideoFrame::wrapOwnedInfo(const proto::OwnedVideoBuffer &owned) {
   const auto &info = owned.info();
-  const int width = static_cast<int>(info.width());
-  const int height = static_cast<int>(info.height());
-  const VideoBufferType type = fromProto(info.type());
 
-  std::vector<std::uint8_t> buffer;
+  VideoFrame frame;
+  // Take ownership first so the buffer is dropped even if validation throws.
+  frame.native_handle_ =
+      FfiHandle(static_cast<std::uintptr_t>(owned.handle().id()),
+                ResourceKind::kVideoBuffer, FfiHandle::Disposal::kDeferrable);
+  frame.width_ = static_cast<int>(info.width());
+  frame.height_ = static_cast<int>(info.height());
+  frame.type_ = fromProto(info.type());
 
+  VideoPlanes planes;
   if (info.components_size() > 0) {
-    // Multi-plane (e.g. I420, NV12, etc.). We pack planes back-to-back.
-    std::size_t total_size = 0;
-    for (const auto &comp : info.components()) {
-      total_size += static_cast<std::size_t>(comp.size());
+    // Multi-plane (e.g. I420, NV12, etc.): use the native layout as-is.
+    if (static_cast<std::size_t>(info.components_size()) > kMaxVideoPlanes) {
+      throw std::runtime_error("VideoFrame::wrapOwnedInfo: too many planes");
     }
-
-    buffer.resize(total_size);
-    std::size_t offset = 0;
     for (const auto &comp : info.components()) {
-      const auto sz = static_cast<std::size_t>(comp.size());
-      const auto src_ptr = reinterpret_cast<const std::uint8_t *>(
-          static_cast<std::uintptr_t>(comp.data_ptr()));
-
-      std::memcpy(buffer.data() + offset, src_ptr, sz);
-      offset += sz;
+      VideoPlaneInfo &plane = planes[planes.count++];
+      plane.data_ptr = static_cast<std::uintptr_t>(comp.data_ptr());
+      plane.stride = comp.stride();
+      plane.size = comp.size();
     }
   } else {
     // Packed format: treat top-level data_ptr as a single contiguous buffer.
-    const auto src_ptr = reinterpret_cast<const std::uint8_t *>(
-        static_cast<std::uintptr_t>(info.data_ptr()));
-
-    std::size_t total_size = 0;
+    if (info.width() == 0 || info.height() == 0) {
+      throw std::runtime_error("VideoFrame::wrapOwnedInfo: empty packed frame");
+    }
+    VideoPlaneInfo &plane = planes[planes.count++];
+    plane.data_ptr = static_cast<std::uintptr_t>(info.data_ptr());
     if (info.has_stride()) {
-      // Use stride * height as total size (includes per-row padding if any).
-      total_size = static_cast<std::size_t>(info.stride()) *
-                   static_cast<std::size_t>(height);
+      // stride * height includes per-row padding if any.
+      plane.stride = info.stride();
+      plane.size = info.stride() * info.height();
     } else {
-      // Use our generic buffer-size helper (width/height/type).
-      total_size = computeBufferSize(width, height, type);
+      const std::size_t size =
+          computeBufferSize(frame.width_, frame.height_, frame.type_);
+      plane.stride = static_cast<std::uint32_t>(size / info.height());
+      plane.size = static_cast<std::uint32_t>(size);
     }
+  }
 
-    buffer.resize(total_size);
-    std::memcpy(buffer.data(), src_ptr, total_size);
+  if (planes.empty() || planes[0].data_ptr == 0) {
+    throw std::runtime_error("VideoFrame::wrapOwnedInfo: null data_ptr");
   }
+  frame.adoptPlanes(planes);
+  return frame;
+}
 
-  // Release the FFI-owned buffer after copying the data.
-  {
-    FfiHandle owned_handle(static_cast<std::uintptr_t>(owned.handle().id()));
-    // owned_handle destroyed at end of scope → native buffer disposed.
+std::size_t VideoFrame::nativePackedSize() const {
+  std::size_t total_size = 0;
+  for (const auto &plane : native_planes_) {
+    total_size += static_cast<std::size_t>(plane.size);
+  }
+  if (isExternal()) {
+    // Row padding is dropped; wrapExternal() checked the layout.
+    total_size = computeBufferSize(width_, height_, type_);
   }
+  return total_size;
+}
 
-  return VideoFrame(width, height, type, std::move(buffer));
+void VideoFrame::packNativePlanes(std::uint8_t *dst) const {
+  const VideoPlanes packed =
+      isExternal() ? computePlanes(reinterpret_cast<std::uintptr_t>(dst),
+                                   width_, height_, type_)
+                   : VideoPlanes{};
+  std::size_t offset = 0;
+  for (std::size_t i = 0; i < native_planes_.size(); ++i) {
+    const VideoPlaneInfo &plane = native_planes_[i];
+    const auto *src_ptr =
+        reinterpret_cast<const std::uint8_t *>(plane.data_ptr);
+    if (packed.empty() || plane.stride == packed[i].stride) {
+      const std::size_t size =
+          packed.empty() ? plane.size : std::min(plane.size, packed[i].size);
+      std::memcpy(dst + offset, src_ptr, size);
+      offset += size;
+      continue;
+    }
+    // Strided external plane: copy the visible part of each row.
+    const std::uint32_t rows = packed[i].size / packed[i].stride;
+    for (std::uint32_t row = 0; row < rows; ++row) {
+      std::memcpy(dst + offset, src_ptr + std::size_t{row} * plane.stride,
+                  packed[i].stride);
+      offset += packed[i].stride;
+    }
+  }
 }
 
+VideoFrame VideoFrame::toOwned() const {
+  if (!borrowed()) {
+    std::vector<std::uint8_t> buf = data_;
+    return VideoFrame(width_, height_, type_, std::move(buf));
+  }
+
+  std::vector<std::uint8_t> buffer(nativePackedSize());
+  packNativePlanes(buffer.data());
+  return VideoFrame(width_, height_, type_, std::move(buffer));
+}
+
+VideoFrame VideoFrame::toOwned(VideoFramePool &pool) const {
+  const std::size_t size = borrowed() ? nativePackedSize() : data_.size();
+  VideoFrame frame = pool.acquireBytes(width_, height_, type_, size);
+  if (borrowed()) {
+    packNativePlanes(frame.data());
+  } else if (size > 0) {
+    std::memcpy(frame.data(), data_.data(), size);
+  }
+  return frame;
+}
+
+// ----------------------------------------------------------------------------
+// VideoFramePool implementation
+// ----------------------------------------------------------------------------
+
+VideoFramePool::VideoFramePool(std::size_t max_buffers_per_bucket)
+    : pool_(std::make_shared<detail::FrameBufferPool<std::uint8_t>>(
+          max_buffers_per_bucket)) {}
+
+VideoFrame VideoFramePool::acquire(int width, int height,
+                                   VideoBufferType type) {
+  return acquireBytes(width, height, type,
+                      computeBufferSize(width, height, type));
+}
+
+VideoFrame VideoFramePool::acquireBytes(int width, int height,
+                                        VideoBufferType type,
+                                        std::size_t bytes) {
+  VideoFrame frame(width, height, type, pool_->acquire(bytes));
+  frame.pool_ = pool_;
+  return frame;
+}
+
+std::size_t VideoFramePool::cachedBuffers() const {
+  return pool_->cachedBuffers();
+}
+
+void VideoFramePool::clear() { pool_->clear(); }
+
 } // namespace livekit
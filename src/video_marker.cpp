@@ -0,0 +1,261 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "video_marker.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+constexpr int kColumns = 32;
+constexpr int kRows = 5;
+constexpr int kPayloadBytes = kColumns * kRows / 8; // magic + 16 + crc
+constexpr int kCellDivisor = 40; // cell edge = width / kCellDivisor
+constexpr int kMinCellPixels = 2;
+constexpr std::uint16_t kMagic = 0x4C4B;
+constexpr std::uint8_t kBlack = 16;
+constexpr std::uint8_t kWhite = 235;
+
+using Payload = std::array<std::uint8_t, kPayloadBytes>;
+
+// Per-format pixel layout of the plane holding luma (or packed RGB).
+struct Layout {
+  int bytes_per_pixel; // of plane 0
+  int sample_offset;   // byte read back by readFrameMarker()
+  int alpha_offset;    // -1 if none
+  int chroma_x_shift;  // planar YUV only
+  int chroma_y_shift;
+  bool planar;
+};
+
+bool layoutFor(VideoBufferType type, Layout &out) noexcept {
+  switch (type) {
+  case VideoBufferType::RGBA:
+  case VideoBufferType::BGRA:
+    out = {4, 1, 3, 0, 0, false};
+    return true;
+  case VideoBufferType::ARGB:
+  case VideoBufferType::ABGR:
+    out = {4, 1, 0, 0, 0, false};
+    return true;
+  case VideoBufferType::RGB24:
+    out = {3, 1, -1, 0, 0, false};
+    return true;
+  case VideoBufferType::I420:
+  case VideoBufferType::I420A:
+  case VideoBufferType::NV12:
+    out = {1, 0, -1, 1, 1, true};
+    return true;
+  case VideoBufferType::I422:
+    out = {1, 0, -1, 1, 0, true};
+    return true;
+  case VideoBufferType::I444:
+    out = {1, 0, -1, 0, 0, true};
+    return true;
+  case VideoBufferType::I010:
+    return false;
+  }
+  return false;
+}
+
+std::uint16_t crc16(const std::uint8_t *data, std::size_t size) noexcept {
+  std::uint16_t crc = 0xFFFF; // CRC-16/CCITT-FALSE
+  for (std::size_t i = 0; i < size; ++i) {
+    crc ^= static_cast<std::uint16_t>(data[i] << 8);
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = static_cast<std::uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021
+                                                      : crc << 1);
+    }
+  }
+  return crc;
+}
+
+void putBigEndian(std::uint8_t *dst, std::uint64_t value, int bytes) {
+  for (int i = bytes - 1; i >= 0; --i) {
+    dst[i] = static_cast<std::uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+std::uint64_t getBigEndian(const std::uint8_t *src, int bytes) {
+  std::uint64_t value = 0;
+  for (int i = 0; i < bytes; ++i) {
+    value = (value << 8) | src[i];
+  }
+  return value;
+}
+
+Payload encode(const VideoFrameMetadata &metadata) {
+  Payload p{};
+  putBigEndian(p.data(), kMagic, 2);
+  putBigEndian(p.data() + 2, metadata.id, 8);
+  putBigEndian(p.data() + 10,
+               static_cast<std::uint64_t>(metadata.capture_wallclock_us), 8);
+  putBigEndian(p.data() + 18, crc16(p.data(), kPayloadBytes - 2), 2);
+  return p;
+}
+
+bool bitAt(const Payload &p, int i) {
+  return (p[static_cast<std::size_t>(i / 8)] >> (7 - i % 8)) & 1;
+}
+
+// Cell edge in pixels, or 0 if the grid does not fit the frame.
+double cellSize(int width, int height) {
+  const double cell = static_cast<double>(width) / kCellDivisor;
+  if (cell < kMinCellPixels || cell * kRows > height) {
+    return 0;
+  }
+  return cell;
+}
+
+int edge(int index, double cell) {
+  return static_cast<int>(std::lround(index * cell));
+}
+
+std::uint8_t *row(const VideoPlaneInfo &plane, int y) {
+  return reinterpret_cast<std::uint8_t *>(plane.data_ptr) +
+         static_cast<std::size_t>(y) * plane.stride;
+}
+
+void fillRect(const VideoPlaneInfo &plane, int x0, int y0, int x1, int y1,
+              int bytes_per_pixel, std::uint8_t value) {
+  for (int y = y0; y < y1; ++y) {
+    std::uint8_t *p = row(plane, y) + x0 * bytes_per_pixel;
+    std::fill(p, p + (x1 - x0) * bytes_per_pixel, value);
+  }
+}
+
+int shiftUp(int value, int shift) {
+  return (value + (1 << shift) - 1) >> shift;
+}
+
+} // namespace
+
+bool canMarkFrame(const VideoFrame &frame) noexcept {
+  Layout layout;
+  return layoutFor(frame.type(), layout) &&
+         cellSize(frame.width(), frame.height()) > 0;
+}
+
+void writeFrameMarker(VideoFrame &frame, const VideoFrameMetadata &metadata) {
+  Layout layout;
+  if (!layoutFor(frame.type(), layout)) {
+    throw std::invalid_argument(
+        "writeFrameMarker: pixel format not supported");
+  }
+  const double cell = cellSize(frame.width(), frame.height());
+  if (cell == 0) {
+    throw std::invalid_argument("writeFrameMarker: frame too small");
+  }
+  const VideoPlanes planes = frame.planes();
+  const Payload payload = encode(metadata);
+
+  for (int r = 0; r < kRows; ++r) {
+    for (int c = 0; c < kColumns; ++c) {
+      const std::uint8_t value =
+          bitAt(payload, r * kColumns + c) ? kWhite : kBlack;
+      fillRect(planes[0], edge(c, cell), edge(r, cell), edge(c + 1, cell),
+               edge(r + 1, cell), layout.bytes_per_pixel, value);
+    }
+  }
+
+  const int grid_w = edge(kColumns, cell);
+  const int grid_h = edge(kRows, cell);
+  if (layout.alpha_offset >= 0) {
+    for (int y = 0; y < grid_h; ++y) {
+      std::uint8_t *p = row(planes[0], y) + layout.alpha_offset;
+      for (int x = 0; x < grid_w; ++x) {
+        p[x * layout.bytes_per_pixel] = 0xFF;
+      }
+    }
+  }
+  if (!layout.planar) {
+    return;
+  }
+
+  // Neutral chroma keeps the cells grey rather than tinted by the picture.
+  const int cw = shiftUp(grid_w, layout.chroma_x_shift);
+  const int ch = shiftUp(grid_h, layout.chroma_y_shift);
+  if (frame.type() == VideoBufferType::NV12) {
+    fillRect(planes[1], 0, 0, cw, ch, 2, 128);
+    return;
+  }
+  fillRect(planes[1], 0, 0, cw, ch, 1, 128);
+  fillRect(planes[2], 0, 0, cw, ch, 1, 128);
+  if (frame.type() == VideoBufferType::I420A) {
+    fillRect(planes[3], 0, 0, grid_w, grid_h, 1, 0xFF);
+  }
+}
+
+std::optional<VideoFrameMetadata> readFrameMarker(const VideoFrame &frame) {
+  Layout layout;
+  if (!layoutFor(frame.type(), layout)) {
+    return std::nullopt;
+  }
+  const double cell = cellSize(frame.width(), frame.height());
+  if (cell == 0) {
+    return std::nullopt;
+  }
+  const VideoPlanes planes = frame.planes();
+  if (planes.empty()) {
+    return std::nullopt;
+  }
+
+  Payload payload{};
+  for (int r = 0; r < kRows; ++r) {
+    for (int c = 0; c < kColumns; ++c) {
+      // Average the middle half of the cell, away from ringing at its edges.
+      const int x0 = edge(c, cell), x1 = edge(c + 1, cell);
+      const int y0 = edge(r, cell), y1 = edge(r + 1, cell);
+      const int mx = (x1 - x0) / 4, my = (y1 - y0) / 4;
+      std::uint32_t sum = 0, count = 0;
+      for (int y = y0 + my; y < y1 - my; ++y) {
+        const std::uint8_t *p = row(planes[0], y) + layout.sample_offset;
+        for (int x = x0 + mx; x < x1 - mx; ++x) {
+          sum += p[x * layout.bytes_per_pixel];
+          ++count;
+        }
+      }
+      if (count != 0 && sum >= 128 * count) {
+        const int bit = r * kColumns + c;
+        payload[static_cast<std::size_t>(bit / 8)] |=
+            static_cast<std::uint8_t>(0x80 >> (bit % 8));
+      }
+    }
+  }
+
+  if (getBigEndian(payload.data(), 2) != kMagic ||
+      getBigEndian(payload.data() + 18, 2) !=
+          crc16(payload.data(), kPayloadBytes - 2)) {
+    return std::nullopt;
+  }
+  VideoFrameMetadata metadata;
+  metadata.id = getBigEndian(payload.data() + 2, 8);
+  metadata.capture_wallclock_us =
+      static_cast<std::int64_t>(getBigEndian(payload.data() + 10, 8));
+  return metadata;
+}
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/video_frame.h"
+
+#include <optional>
+
+namespace livekit {
+namespace detail {
+
+// In-band carrier for VideoFrameMetadata. The FFI capture request has no
+// side channel for per-frame data, so the tag travels in the pixels: a
+// 32x5 grid of black/white cells over the top-left corner, holding a magic
+// word, the 16 metadata bytes and a CRC-16.
+//
+// Cells are sized from the frame width (width / 40 each way), so the
+// marker survives simulcast layers and receive-side scaling as long as a
+// cell stays a few pixels wide; lossy encoding only nudges the levels.
+//
+// Supported formats: RGBA, BGRA, ARGB, ABGR, RGB24, I420, I420A, I422,
+// I444 and NV12.
+bool canMarkFrame(const VideoFrame &frame) noexcept;
+
+// Draw `metadata` into `frame`, which must own or wrap writable memory.
+// Throws std::invalid_argument if the format is unsupported or the frame is
+// too small to hold the grid.
+void writeFrameMarker(VideoFrame &frame, const VideoFrameMetadata &metadata);
+
+// Decode a marker drawn by writeFrameMarker(); nullopt if there is none or
+// it fails the checksum. Reads native frames in place.
+std::optional<VideoFrameMetadata> readFrameMarker(const VideoFrame &frame);
+
+} // namespace detail
+} // namespace livekit
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "video_scale.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIVEKIT_VIDEO_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LIVEKIT_VIDEO_SIMD_NEON 1
+#endif
+
+namespace livekit {
+namespace detail {
+
+namespace {
+
+// Pixel grid of one plane: `channels` interleaved bytes per pixel.
+struct PlaneGeometry {
+  int width;
+  int height;
+  int channels;
+};
+
+using PlaneGeometries = std::array<PlaneGeometry, kMaxVideoPlanes>;
+
+// Per-plane geometry from the format's layout; the box filter works on
+// 8-bit samples, so I010 is not supported.
+std::size_t planeGeometry(VideoBufferType type, int w, int h,
+                          PlaneGeometries &out) {
+  if (type == VideoBufferType::I010) {
+    return 0;
+  }
+  const VideoFormatLayout layout = videoFormatLayout(type);
+  for (std::size_t i = 0; i < layout.num_planes; ++i) {
+    const VideoPlaneFormat &plane = layout.planes[i];
+    out[i] = PlaneGeometry{static_cast<int>(plane.width(w)),
+                           static_cast<int>(plane.rows(h)),
+                           plane.bytes_per_sample};
+  }
+  return layout.num_planes;
+}
+
+// Source span [begin, end) covered by destination index `d` of `dst_len`.
+// Always at least one source element, so upscaling degrades to nearest.
+inline void sourceSpan(int d, int src_len, int dst_len, int &begin,
+                       int &end) noexcept {
+  begin = static_cast<int>(static_cast<std::int64_t>(d) * src_len / dst_len);
+  end = static_cast<int>(static_cast<std::int64_t>(d + 1) * src_len / dst_len);
+  end = std::max(end, begin + 1);
+}
+
+// acc[i] += row[i] for `n` bytes. 16-bit lanes hold up to 257 rows of 255.
+inline void accumulateRow(const std::uint8_t *row, std::uint16_t *acc,
+                          int n) noexcept {
+  int i = 0;
+#if defined(LIVEKIT_VIDEO_SIMD_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= n; i += 16) {
+    const __m128i px =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+    auto *a = reinterpret_cast<__m128i *>(acc + i);
+    _mm_storeu_si128(a, _mm_add_epi16(_mm_loadu_si128(a),
+                                      _mm_unpacklo_epi8(px, zero)));
+    _mm_storeu_si128(a + 1, _mm_add_epi16(_mm_loadu_si128(a + 1),
+                                          _mm_unpackhi_epi8(px, zero)));
+  }
+#elif defined(LIVEKIT_VIDEO_SIMD_NEON)
+  for (; i + 16 <= n; i += 16) {
+    const uint8x16_t px = vld1q_u8(row + i);
+    vst1q_u16(acc + i, vaddw_u8(vld1q_u16(acc + i), vget_low_u8(px)));
+    vst1q_u16(acc + i + 8,
+              vaddw_u8(vld1q_u16(acc + i + 8), vget_high_u8(px)));
+  }
+#endif
+  for (; i < n; ++i) {
+    acc[i] = static_cast<std::uint16_t>(acc[i] + row[i]);
+  }
+}
+
+// Resample destination rows [dy_begin, dy_end) of one plane. `acc32`/`acc16`
+// are scratch space for one source row of column sums, reused across planes.
+void scalePlane(const std::uint8_t *src, int src_stride,
+                const PlaneGeometry &sg, std::uint8_t *dst, int dst_stride,
+                const PlaneGeometry &dg, int dy_begin, int dy_end,
+                std::vector<std::uint32_t> &acc32,
+                std::vector<std::uint16_t> &acc16) {
+  const int c = sg.channels;
+  const int row_bytes = sg.width * c;
+  acc16.resize(static_cast<std::size_t>(row_bytes));
+  acc32.resize(static_cast<std::size_t>(row_bytes));
+
+  // Horizontal spans are the same for every row.
+  std::vector<int> x_begin(static_cast<std::size_t>(dg.width));
+  std::vector<int> x_end(static_cast<std::size_t>(dg.width));
+  for (int dx = 0; dx < dg.width; ++dx) {
+    sourceSpan(dx, sg.width, dg.width, x_begin[dx], x_end[dx]);
+  }
+
+  for (int dy = dy_begin; dy < dy_end; ++dy) {
+    int y0 = 0, y1 = 0;
+    sourceSpan(dy, sg.height, dg.height, y0, y1);
+    const int rows = y1 - y0;
+    const std::uint8_t *first = src + static_cast<std::size_t>(y0) * src_stride;
+
+    // Vertical pass: one row of column sums.
+    if (rows == 1) {
+      for (int i = 0; i < row_bytes; ++i) {
+        acc32[i] = first[i];
+      }
+    } else if (rows <= 257) {
+      std::fill(acc16.begin(), acc16.end(), 0);
+      for (int y = 0; y < rows; ++y) {
+        accumulateRow(first + static_cast<std::size_t>(y) * src_stride,
+                      acc16.data(), row_bytes);
+      }
+      std::copy(acc16.begin(), acc16.end(), acc32.begin());
+    } else {
+      std::fill(acc32.begin(), acc32.end(), 0);
+      for (int y = 0; y < rows; ++y) {
+        const std::uint8_t *row =
+            first + static_cast<std::size_t>(y) * src_stride;
+        for (int i = 0; i < row_bytes; ++i) {
+          acc32[i] += row[i];
+        }
+      }
+    }
+
+    // Horizontal pass: average the spans, rounding to nearest.
+    std::uint8_t *out = dst + static_cast<std::size_t>(dy) * dst_stride;
+    for (int dx = 0; dx < dg.width; ++dx) {
+      const int x0 = x_begin[dx];
+      const int x1 = x_end[dx];
+      const std::uint32_t count = static_cast<std::uint32_t>(rows) *
+                                  static_cast<std::uint32_t>(x1 - x0);
+      for (int k = 0; k < c; ++k) {
+        std::uint32_t sum = 0;
+        for (int x = x0; x < x1; ++x) {
+          sum += acc32[static_cast<std::size_t>(x) * c + k];
+        }
+        out[dx * c + k] = static_cast<std::uint8_t>((sum + count / 2) / count);
+      }
+    }
+  }
+}
+
+} // namespace
+
+bool canScaleNative(VideoBufferType type) noexcept {
+  PlaneGeometries geometry;
+  return planeGeometry(type, 1, 1, geometry) > 0;
+}
+
+bool scaleNative(const VideoFrame &src, VideoFrame &dst) {
+  return scaleNativeRows(src, dst, 0, dst.height());
+}
+
+bool scaleNativeRows(const VideoFrame &src, VideoFrame &dst, int row_begin,
+                     int row_end) {
+  PlaneGeometries sg, dg;
+  if (src.type() != dst.type() || src.width() <= 0 || src.height() <= 0 ||
+      dst.width() <= 0 || dst.height() <= 0 || row_begin < 0 ||
+      row_end > dst.height() || row_begin >= row_end) {
+    return false;
+  }
+  const std::size_t num_planes =
+      planeGeometry(src.type(), src.width(), src.height(), sg);
+  if (num_planes == 0) {
+    return false;
+  }
+  planeGeometry(dst.type(), dst.width(), dst.height(), dg);
+  const VideoPlanes sp = src.planes();
+  const VideoPlanes dp = dst.planes();
+  if (sp.size() < num_planes || dp.size() < num_planes) {
+    return false;
+  }
+  for (std::size_t i = 0; i < num_planes; ++i) {
+    const std::uint64_t s_need =
+        static_cast<std::uint64_t>(sp[i].stride) * (sg[i].height - 1) +
+        static_cast<std::uint64_t>(sg[i].width) * sg[i].channels;
+    const std::uint64_t d_need =
+        static_cast<std::uint64_t>(dp[i].stride) * (dg[i].height - 1) +
+        static_cast<std::uint64_t>(dg[i].width) * dg[i].channels;
+    if (s_need > sp[i].size || d_need > dp[i].size) {
+      return false;
+    }
+  }
+
+  const VideoFormatLayout layout = videoFormatLayout(dst.type());
+  std::vector<std::uint32_t> acc32;
+  std::vector<std::uint16_t> acc16;
+  for (std::size_t i = 0; i < num_planes; ++i) {
+    const auto *s = reinterpret_cast<const std::uint8_t *>(sp[i].data_ptr);
+    auto *d = reinterpret_cast<std::uint8_t *>(dp[i].data_ptr);
+    // Subsampled planes cover the rows whose top luma row is in range.
+    const int y_begin = static_cast<int>(layout.planes[i].rows(row_begin));
+    const int y_end = static_cast<int>(layout.planes[i].rows(row_end));
+    if (sg[i].width == dg[i].width && sg[i].height == dg[i].height) {
+      const std::size_t row_bytes =
+          static_cast<std::size_t>(sg[i].width) * sg[i].channels;
+      for (int y = y_begin; y < y_end; ++y) {
+        std::memcpy(d + static_cast<std::size_t>(y) * dp[i].stride,
+                    s + static_cast<std::size_t>(y) * sp[i].stride, row_bytes);
+      }
+      continue;
+    }
+    scalePlane(s, static_cast<int>(sp[i].stride), sg[i], d,
+               static_cast<int>(dp[i].stride), dg[i], y_begin, y_end, acc32,
+               acc16);
+  }
+  return true;
+}
+
+} // namespace detail
+} // namespace livekit
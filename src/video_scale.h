@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "livekit/video_frame.h"
+
+namespace livekit {
+namespace detail {
+
+// In-process resampling between two frames of the same pixel format, used
+// by VideoFrame::scaleInto() and VideoStream's target_width/target_height.
+//
+// Downscaling averages every source pixel covered by a destination pixel
+// (box filter); the vertical sums use SSE2/NEON where available. Upscaling
+// repeats pixels (nearest neighbour). Chroma planes are resampled on their
+// own grid, so I420/NV12 never round-trip through RGB.
+//
+// Supported formats: RGBA, BGRA, ARGB, ABGR, RGB24, I420, I420A, I422,
+// I444 and NV12.
+bool canScaleNative(VideoBufferType type) noexcept;
+
+// Resample `src` into `dst` (format = src.type(), any non-zero size).
+// Returns false, leaving `dst` untouched, if the format is unsupported or
+// the formats differ.
+bool scaleNative(const VideoFrame &src, VideoFrame &dst);
+
+// Same as scaleNative(), writing only destination rows [row_begin, row_end)
+// (luma rows; subsampled planes follow), so one scale can be split across
+// threads by row band. Band edges must be even for vertically subsampled
+// formats. The result is identical to a whole-frame scale.
+bool scaleNativeRows(const VideoFrame &src, VideoFrame &dst, int row_begin,
+                     int row_end);
+
+} // namespace detail
+} // namespace livekit
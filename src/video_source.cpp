@@ -16,19 +16,162 @@
 
 #include "livekit/video_source.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 
+#include "dma_buf.h"
 #include "ffi.pb.h"
+#include "ffi_arena.h"
 #include "ffi_client.h"
+#include "latency_trace.h"
 #include "livekit/video_frame.h"
+#include "thread_util.h"
 #include "video_frame.pb.h"
+#include "video_marker.h"
 #include "video_utils.h"
 
 namespace livekit {
 
+namespace {
+
+void sendCaptureRequest(std::uint64_t source_handle, const VideoFrame &frame,
+                        std::int64_t timestamp_us, VideoRotation rotation) {
+  detail::TraceSpan span(TraceMedia::kVideo, TraceStage::kCapture,
+                         timestamp_us);
+  FfiArenaScope arena;
+  auto &req = *arena.create<proto::FfiRequest>();
+  auto *msg = req.mutable_capture_video_frame();
+  msg->set_source_handle(source_handle);
+  toProto(frame, msg->mutable_buffer());
+  msg->set_timestamp_us(timestamp_us);
+  msg->set_rotation(static_cast<proto::VideoRotation>(rotation));
+  const proto::FfiResponse &resp =
+      FfiClient::instance().sendRequest(req, arena);
+  if (!resp.has_capture_video_frame()) {
+    throw std::runtime_error("FfiResponse missing capture_video_frame");
+  }
+}
+
+} // namespace
+
+// Bounded drop-oldest queue drained by one worker thread. The capture
+// request is synchronous on the Rust side, so a frame is "acknowledged" (and
+// may be released) once sendRequest returns.
+struct VideoSource::AsyncCapture {
+  struct Item {
+    VideoFrame frame;
+    std::int64_t timestamp_us;
+    VideoRotation rotation;
+    std::promise<bool> done;
+    // Set only while latency tracing is on.
+    detail::TraceClock::time_point queued{};
+  };
+
+  AsyncCapture(std::uint64_t handle, std::size_t capacity)
+      : source_handle(handle), capacity(capacity) {
+    worker = std::thread([this] {
+      detail::registerThread(ThreadRole::kVideo, "lk-video-cap");
+      run();
+    });
+  }
+
+  ~AsyncCapture() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    cv.notify_all();
+    if (worker.joinable()) {
+      worker.join();
+    }
+    for (auto &item : queue) {
+      item.done.set_value(false);
+    }
+  }
+
+  std::future<bool> push(Item &&item) {
+    std::future<bool> fut = item.done.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (queue.size() >= capacity) {
+        queue.front().done.set_value(false);
+        queue.pop_front();
+      }
+      queue.push_back(std::move(item));
+    }
+    cv.notify_one();
+    return fut;
+  }
+
+  std::size_t pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size() + (busy ? 1 : 0);
+  }
+
+  void run() {
+    for (;;) {
+      Item item;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return stop || !queue.empty(); });
+        if (stop) {
+          return;
+        }
+        item = std::move(queue.front());
+        queue.pop_front();
+        busy = true;
+      }
+      if (item.queued != detail::TraceClock::time_point{}) {
+        detail::LatencyTracer::instance().record(
+            TraceMedia::kVideo, TraceStage::kCaptureQueue, item.queued,
+            detail::TraceClock::now(), item.timestamp_us);
+      }
+      try {
+        sendCaptureRequest(source_handle, item.frame, item.timestamp_us,
+                           item.rotation);
+        item.done.set_value(true);
+      } catch (...) {
+        item.done.set_exception(std::current_exception());
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        busy = false;
+      }
+    }
+  }
+
+  const std::uint64_t source_handle;
+  const std::size_t capacity;
+  mutable std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<Item> queue;
+  bool busy{false};
+  bool stop{false};
+  std::thread worker;
+};
+
+// Producers may race on the first captureFrameAsync() and pollers read
+// pendingFrames() concurrently, so creation is serialized and the result
+// published through an atomic.
+struct VideoSource::AsyncSlot {
+  std::mutex mutex;
+  std::atomic<AsyncCapture *> capture{nullptr};
+  std::unique_ptr<AsyncCapture> owner;
+};
+
 VideoSource::VideoSource(int width, int height)
-    : width_(width), height_(height) {
+    : VideoSource(width, height, 2) {}
+
+VideoSource::VideoSource(int width, int height, std::size_t queue_size_frames)
+    : width_(width), height_(height),
+      queue_size_frames_(queue_size_frames == 0 ? 1 : queue_size_frames),
+      async_(std::make_unique<AsyncSlot>()) {
 
   proto::FfiRequest req;
   auto *msg = req.mutable_new_video_source();
@@ -41,7 +184,8 @@ VideoSource::VideoSource(int width, int height)
     throw std::runtime_error("VideoSource: missing new_video_source");
   }
 
-  handle_ = FfiHandle(resp.new_video_source().source().handle().id());
+  handle_ = FfiHandle(resp.new_video_source().source().handle().id(),
+                      ResourceKind::kVideoSource);
 }
 
 void VideoSource::captureFrame(const VideoFrame &frame,
@@ -51,17 +195,95 @@ void VideoSource::captureFrame(const VideoFrame &frame,
     return;
   }
 
-  proto::VideoBufferInfo buf = toProto(frame);
-  proto::FfiRequest req;
-  auto *msg = req.mutable_capture_video_frame();
-  msg->set_source_handle(handle_.get());
-  msg->mutable_buffer()->CopyFrom(buf);
-  msg->set_timestamp_us(timestamp_us);
-  msg->set_rotation(static_cast<proto::VideoRotation>(rotation));
-  proto::FfiResponse resp = FfiClient::instance().sendRequest(req);
-  if (!resp.has_capture_video_frame()) {
-    throw std::runtime_error("FfiResponse missing capture_video_frame");
+  sendCaptureRequest(handle_.get(), frame, timestamp_us, rotation);
+}
+
+void VideoSource::captureFrame(const VideoFrame &frame,
+                               const VideoFrameMetadata &metadata,
+                               std::int64_t timestamp_us,
+                               VideoRotation rotation) {
+  if (!handle_) {
+    return;
   }
+
+  VideoFrameMetadata tag = metadata;
+  if (tag.capture_wallclock_us == 0) {
+    tag.capture_wallclock_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+  }
+  VideoFrame marked = frame.toOwned(frame_pool_);
+  detail::writeFrameMarker(marked, tag);
+  sendCaptureRequest(handle_.get(), marked, timestamp_us, rotation);
+}
+
+std::future<bool> VideoSource::captureFrameAsync(VideoFrame &&frame,
+                                                 std::int64_t timestamp_us,
+                                                 VideoRotation rotation) {
+  if (!handle_) {
+    std::promise<bool> dropped;
+    dropped.set_value(false);
+    return dropped.get_future();
+  }
+  AsyncCapture::Item item{std::move(frame), timestamp_us, rotation, {}};
+  if (detail::tracingOn()) {
+    item.queued = detail::TraceClock::now();
+  }
+  return asyncCapture()->push(std::move(item));
+}
+
+std::size_t VideoSource::pendingFrames() const {
+  const AsyncCapture *async =
+      async_ ? async_->capture.load(std::memory_order_acquire) : nullptr;
+  return async ? async->pending() : 0;
+}
+
+VideoSource::AsyncCapture *VideoSource::asyncCapture() {
+  if (AsyncCapture *async = async_->capture.load(std::memory_order_acquire)) {
+    return async;
+  }
+  std::lock_guard<std::mutex> lock(async_->mutex);
+  if (!async_->owner) {
+    async_->owner =
+        std::make_unique<AsyncCapture>(handle_.get(), queue_size_frames_);
+    async_->capture.store(async_->owner.get(), std::memory_order_release);
+  }
+  return async_->owner.get();
+}
+
+void VideoSource::captureNativeFrame(NativeVideoBuffer &&buffer,
+                                     std::int64_t timestamp_us,
+                                     VideoRotation rotation) {
+  auto it = native_mappers_.find(buffer.kind);
+  VideoFrame frame;
+  if (it != native_mappers_.end()) {
+    frame = it->second(std::move(buffer));
+  } else if (buffer.kind == NativeBufferKind::kDmaBuf) {
+    frame = detail::mapDmaBuf(std::move(buffer));
+  } else {
+    if (buffer.release) {
+      buffer.release();
+    }
+    throw std::runtime_error(
+        "VideoSource::captureNativeFrame: no mapper for this buffer kind");
+  }
+  captureFrame(frame, timestamp_us, rotation);
+}
+
+void VideoSource::setNativeBufferMapper(NativeBufferKind kind,
+                                        NativeBufferMapper mapper) {
+  if (mapper) {
+    native_mappers_[kind] = std::move(mapper);
+  } else {
+    native_mappers_.erase(kind);
+  }
+}
+
+VideoSource::~VideoSource() = default;
+
+VideoFrame VideoSource::acquireFrame(VideoBufferType type) {
+  return frame_pool_.acquire(width_, height_, type);
 }
 
 } // namespace livekit
\ No newline at end of file
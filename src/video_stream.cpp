@@ -1,11 +1,23 @@
 #include "livekit/video_stream.h"
 
+#include <algorithm>
+#include <stdexcept>
 #include <utility>
 
+#include "adaptive_stream.h"
 #include "ffi.pb.h"
 #include "ffi_client.h"
+#include "latency_trace.h"
+#include "livekit/remote_track_publication.h"
+#include "livekit/shared_frame_ring.h"
 #include "livekit/track.h"
+#include "log.h"
+#include "media_stream_stats.h"
+#include "sdk_metrics.h"
+#include "spsc_ring.h"
 #include "video_frame.pb.h"
+#include "video_marker.h"
+#include "video_scale.h"
 #include "video_utils.h"
 
 namespace livekit {
@@ -13,6 +25,20 @@ namespace livekit {
 using proto::FfiEvent;
 using proto::FfiRequest;
 using proto::VideoStreamEvent;
+using TimePoint = std::chrono::steady_clock::time_point;
+
+namespace {
+
+// Traces arrival to on_frame invocation, once the callback is about to run.
+void traceCallback(TimePoint arrived, std::int64_t timestamp_us) {
+  if (arrived != TimePoint{}) {
+    detail::LatencyTracer::instance().record(
+        TraceMedia::kVideo, TraceStage::kReceiveTotal, arrived,
+        detail::TraceClock::now(), timestamp_us);
+  }
+}
+
+} // namespace
 
 std::shared_ptr<VideoStream>
 VideoStream::fromTrack(const std::shared_ptr<Track> &track,
@@ -30,12 +56,37 @@ VideoStream::fromParticipant(Participant &participant, TrackSource track_source,
   return stream;
 }
 
+VideoStream::VideoStream()
+    : stats_(std::make_unique<detail::MediaStreamStatsRecorder>()) {}
+
 VideoStream::~VideoStream() { close(); }
 
 VideoStream::VideoStream(VideoStream &&other) noexcept {
   std::lock_guard<std::mutex> lock(other.mutex_);
   queue_ = std::move(other.queue_);
   capacity_ = other.capacity_;
+  zero_copy_ = other.zero_copy_;
+  latest_only_ = other.latest_only_;
+  read_metadata_ = other.read_metadata_;
+  export_ring_ = std::move(other.export_ring_);
+  export_only_ = other.export_only_;
+  adaptive_publication_ = std::move(other.adaptive_publication_);
+  reported_width_ = other.reported_width_;
+  reported_height_ = other.reported_height_;
+  target_width_ = other.target_width_;
+  target_height_ = other.target_height_;
+  frame_interval_us_ = other.frame_interval_us_;
+  next_frame_due_us_ = other.next_frame_due_us_;
+  frame_due_set_ = other.frame_due_set_;
+  frame_pool_ = std::move(other.frame_pool_);
+  on_frame_ = std::move(other.on_frame_);
+  on_eos_ = std::move(other.on_eos_);
+  callback_executor_ = std::move(other.callback_executor_);
+  ring_ = std::move(other.ring_);
+  stats_ = std::move(other.stats_);
+  metrics_depth_.store(other.metrics_depth_.exchange(0));
+  metrics_bytes_.store(other.metrics_bytes_.exchange(0));
+  metrics_ring_dropped_.store(other.metrics_ring_dropped_.exchange(0));
   eof_ = other.eof_;
   closed_ = other.closed_;
   stream_handle_ = std::move(other.stream_handle_);
@@ -57,6 +108,28 @@ VideoStream &VideoStream::operator=(VideoStream &&other) noexcept {
 
     queue_ = std::move(other.queue_);
     capacity_ = other.capacity_;
+    zero_copy_ = other.zero_copy_;
+    latest_only_ = other.latest_only_;
+    read_metadata_ = other.read_metadata_;
+    export_ring_ = std::move(other.export_ring_);
+    export_only_ = other.export_only_;
+    adaptive_publication_ = std::move(other.adaptive_publication_);
+    reported_width_ = other.reported_width_;
+    reported_height_ = other.reported_height_;
+    target_width_ = other.target_width_;
+    target_height_ = other.target_height_;
+    frame_interval_us_ = other.frame_interval_us_;
+    next_frame_due_us_ = other.next_frame_due_us_;
+    frame_due_set_ = other.frame_due_set_;
+    frame_pool_ = std::move(other.frame_pool_);
+    on_frame_ = std::move(other.on_frame_);
+    on_eos_ = std::move(other.on_eos_);
+    callback_executor_ = std::move(other.callback_executor_);
+    ring_ = std::move(other.ring_);
+    stats_ = std::move(other.stats_);
+    metrics_depth_.store(other.metrics_depth_.exchange(0));
+    metrics_bytes_.store(other.metrics_bytes_.exchange(0));
+    metrics_ring_dropped_.store(other.metrics_ring_dropped_.exchange(0));
     eof_ = other.eof_;
     closed_ = other.closed_;
     stream_handle_ = std::move(other.stream_handle_);
@@ -72,26 +145,164 @@ VideoStream &VideoStream::operator=(VideoStream &&other) noexcept {
 // --------------------- Public API ---------------------
 
 bool VideoStream::read(VideoFrameEvent &out) {
-  std::unique_lock<std::mutex> lock(mutex_);
+  QueuedFrame queued;
+  if (ring_) {
+    if (!ring_->pop(queued)) {
+      return false;
+    }
+  } else {
+    std::unique_lock<std::mutex> lock(mutex_);
 
-  cv_.wait(lock, [this] { return !queue_.empty() || eof_ || closed_; });
+    cv_.wait(lock, [this] { return !queue_.empty() || eof_ || closed_; });
 
-  if (closed_ || (queue_.empty() && eof_)) {
-    return false; // EOS / closed
+    if (closed_ || (queue_.empty() && eof_)) {
+      return false; // EOS / closed
+    }
+
+    queued = std::move(queue_.front());
+    queue_.pop_front();
   }
+  takeFrame(queued, out);
+  return true;
+}
 
-  out = std::move(queue_.front());
-  queue_.pop_front();
+bool VideoStream::tryRead(VideoFrameEvent &out) {
+  QueuedFrame queued;
+  if (ring_) {
+    if (!ring_->tryPop(queued)) {
+      return false;
+    }
+  } else {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_ || queue_.empty()) {
+      return false;
+    }
+    queued = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  takeFrame(queued, out);
+  return true;
+}
+
+bool VideoStream::readFor(VideoFrameEvent &out,
+                          std::chrono::milliseconds timeout) {
+  QueuedFrame queued;
+  if (ring_) {
+    if (!ring_->popFor(queued, timeout)) {
+      return false;
+    }
+  } else {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, timeout,
+                 [this] { return !queue_.empty() || eof_ || closed_; });
+    if (closed_ || queue_.empty()) {
+      return false; // timeout / EOS / closed
+    }
+    queued = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  takeFrame(queued, out);
   return true;
 }
 
+std::size_t VideoStream::readBatch(std::vector<VideoFrameEvent> &out,
+                                   std::size_t max_events) {
+  std::size_t n = 0;
+  if (ring_) {
+    QueuedFrame queued;
+    while (n < max_events && ring_->tryPop(queued)) {
+      out.emplace_back();
+      takeFrame(queued, out.back());
+      ++n;
+    }
+    return n;
+  }
+
+  if (latest_only_) {
+    // At most one frame is pending; keep the copy out of the queue lock.
+    if (max_events == 0) {
+      return 0;
+    }
+    out.emplace_back();
+    if (tryRead(out.back())) {
+      return 1;
+    }
+    out.pop_back();
+    return 0;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    return 0;
+  }
+  n = std::min(max_events, queue_.size());
+  auto end = queue_.begin() + static_cast<std::ptrdiff_t>(n);
+  out.reserve(out.size() + n);
+  for (auto it = queue_.begin(); it != end; ++it) {
+    out.emplace_back();
+    takeFrame(*it, out.back());
+  }
+  queue_.erase(queue_.begin(), end);
+  return n;
+}
+
+void VideoStream::setRenderSize(int width, int height) {
+  std::lock_guard<std::mutex> lock(adaptive_mutex_);
+  if (!adaptive_publication_) {
+    return;
+  }
+  width = std::max(width, 0);
+  height = std::max(height, 0);
+  const detail::RenderSizeReport report = detail::renderSizeReport(
+      reported_width_, reported_height_, width, height);
+  if (report == detail::RenderSizeReport::kNone) {
+    return;
+  }
+
+  if (report == detail::RenderSizeReport::kPause) {
+    adaptive_publication_->setEnabled(false);
+  } else {
+    if (!adaptive_publication_->enabled()) {
+      adaptive_publication_->setEnabled(true);
+    }
+    adaptive_publication_->setVideoDimensions(
+        static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height));
+  }
+  reported_width_ = width;
+  reported_height_ = height;
+}
+
+bool VideoStream::isEnded() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    return true;
+  }
+  if (!eof_) {
+    return false;
+  }
+  return ring_ ? ring_->size() == 0 : queue_.empty();
+}
+
+MediaStreamStats VideoStream::stats() const {
+  if (!stats_) {
+    return {}; // moved-from
+  }
+  if (ring_) {
+    return stats_->snapshot(ring_->size(), ring_->dropped());
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_->snapshot(queue_.size(), 0);
+}
+
 void VideoStream::close() {
+  std::size_t discarded = 0;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     if (closed_) {
       return;
     }
     closed_ = true;
+    discarded = queue_.size();
   }
 
   // Dispose FFI handle
@@ -105,19 +316,123 @@ void VideoStream::close() {
     listener_id_ = 0;
   }
 
+  auto &metrics = detail::SdkMetrics::instance().video;
+  if (ring_) {
+    metrics.observeRingDrops(ring_->dropped(), metrics_ring_dropped_);
+    discarded = ring_->size();
+  }
+  metrics.release(discarded, metrics_depth_);
+  metrics.releaseBytes(metrics_bytes_);
+
   // Wake any waiting readers
+  if (ring_) {
+    ring_->close(/*discard_pending=*/true);
+  }
   cv_.notify_all();
 }
 
 // --------------------- Internal helpers ---------------------
 
-void VideoStream::initFromTrack(const std::shared_ptr<Track> &track,
-                                const Options &options) {
+void VideoStream::applyOptions(const Options &options) {
+  if (options.target_width < 0 || options.target_height < 0) {
+    throw std::invalid_argument("VideoStream: negative target size");
+  }
+  if ((options.target_width > 0 || options.target_height > 0) &&
+      !detail::canScaleNative(options.format)) {
+    throw std::invalid_argument(
+        "VideoStream: target size needs a format VideoFrame::scaleInto() "
+        "supports");
+  }
+  target_width_ = options.target_width;
+  target_height_ = options.target_height;
+  frame_interval_us_ =
+      options.max_fps > 0
+          ? static_cast<std::int64_t>(1000000.0 / options.max_fps + 0.5)
+          : 0;
   capacity_ = options.capacity;
+  zero_copy_ = options.zero_copy;
+  latest_only_ = options.latest_only && !options.on_frame;
+  read_metadata_ = options.read_metadata;
+  if (options.export_ring &&
+      options.export_ring->kind() != SharedFrameRing::Kind::kVideo) {
+    throw std::invalid_argument("VideoStream: export_ring is not a video ring");
+  }
+  export_ring_ = options.export_ring;
+  export_only_ = options.export_only && export_ring_ != nullptr;
+  on_frame_ = options.on_frame;
+  on_eos_ = options.on_eos;
+  callback_executor_ = options.callback_executor;
+  frame_pool_ = options.frame_pool ? options.frame_pool
+                                   : std::make_shared<VideoFramePool>();
+  {
+    std::lock_guard<std::mutex> lock(adaptive_mutex_);
+    adaptive_publication_ = options.adaptive_publication;
+  }
+  if (options.target_width > 0 && options.target_height > 0) {
+    setRenderSize(options.target_width, options.target_height);
+  }
+  if (latest_only_) {
+    // A one-slot drop-oldest queue; pushFrame() overwrites in place.
+    capacity_ = 1;
+  } else if (options.spsc_ring && capacity_ > 0) {
+    ring_ = std::make_unique<detail::SpscRing<QueuedFrame>>(capacity_);
+  }
+}
 
-  // Subscribe to FFI events, this is essential to get video frames from FFI.
-  listener_id_ = FfiClient::instance().AddListener(
-      [this](const proto::FfiEvent &e) { this->onFfiEvent(e); });
+bool VideoStream::admitFrame(std::int64_t timestamp_us) {
+  if (frame_interval_us_ == 0) {
+    return true;
+  }
+  if (frame_due_set_ && timestamp_us < next_frame_due_us_ &&
+      next_frame_due_us_ - timestamp_us <= frame_interval_us_) {
+    return false;
+  }
+  // Advance on a fixed grid so the average rate matches max_fps even when
+  // frames arrive slightly off it; restart the grid after a gap or if the
+  // timestamps jump backwards.
+  if (frame_due_set_ && timestamp_us >= next_frame_due_us_ &&
+      timestamp_us - next_frame_due_us_ < frame_interval_us_) {
+    next_frame_due_us_ += frame_interval_us_;
+  } else {
+    next_frame_due_us_ = timestamp_us + frame_interval_us_;
+  }
+  frame_due_set_ = true;
+  return true;
+}
+
+bool VideoStream::scaledSize(const VideoFrame &frame, int &width,
+                             int &height) const {
+  if ((target_width_ == 0 && target_height_ == 0) || frame.width() <= 0 ||
+      frame.height() <= 0) {
+    return false;
+  }
+  width = target_width_;
+  height = target_height_;
+  if (width == 0) {
+    width = static_cast<int>(static_cast<std::int64_t>(frame.width()) *
+                             height / frame.height());
+  } else if (height == 0) {
+    height = static_cast<int>(static_cast<std::int64_t>(frame.height()) *
+                              width / frame.width());
+  }
+  width = std::max(width, 1);
+  height = std::max(height, 1);
+  return frame.width() > width || frame.height() > height;
+}
+
+VideoFrame VideoStream::materialize(const VideoFrame &native) {
+  int width = 0, height = 0;
+  if (!scaledSize(native, width, height)) {
+    return native.toOwned(*frame_pool_);
+  }
+  VideoFrame scaled = frame_pool_->acquire(width, height, native.type());
+  native.scaleInto(scaled);
+  return scaled;
+}
+
+void VideoStream::initFromTrack(const std::shared_ptr<Track> &track,
+                                const Options &options) {
+  applyOptions(options);
 
   // Send FFI request to create a new video stream bound to this track
   FfiRequest req;
@@ -128,28 +443,31 @@ void VideoStream::initFromTrack(const std::shared_ptr<Track> &track,
   new_video_stream->set_normalize_stride(true);
   new_video_stream->set_format(toProto(options.format));
 
+  // Anything the FFI emits for the new stream before the listener is in
+  // place is held for it rather than dropped.
+  auto hold =
+      FfiClient::instance().holdHandleEvents(FfiEvent::kVideoStreamEvent);
   auto resp = FfiClient::instance().sendRequest(req);
   if (!resp.has_new_video_stream()) {
-    std::cerr << "VideoStream::initFromTrack: FFI response missing "
-                 "new_video_stream()\n";
+    LK_LOG_ERROR("livekit::video_stream",
+                 "VideoStream::initFromTrack: FFI response missing "
+                 "new_video_stream()");
     throw std::runtime_error("new_video_stream FFI request failed");
   }
   // Adjust field names to match your proto exactly:
   const auto &stream = resp.new_video_stream().stream();
-  stream_handle_ = FfiHandle(static_cast<uintptr_t>(stream.handle().id()));
+  stream_handle_ = FfiHandle(static_cast<uintptr_t>(stream.handle().id()),
+                             ResourceKind::kVideoStream);
+  subscribeToStreamEvents();
   // TODO, do we need to cache the metadata from stream.info ?
 }
 
 void VideoStream::initFromParticipant(Participant &participant,
                                       TrackSource track_source,
                                       const Options &options) {
-  capacity_ = options.capacity;
+  applyOptions(options);
 
-  // 1) Subscribe to FFI events
-  listener_id_ = FfiClient::instance().AddListener(
-      [this](const FfiEvent &e) { this->onFfiEvent(e); });
-
-  // 2) Send FFI request to create a video stream from participant + track
+  // Send FFI request to create a video stream from participant + track
   // source
   FfiRequest req;
   auto *vs = req.mutable_video_stream_from_participant();
@@ -159,10 +477,23 @@ void VideoStream::initFromParticipant(Participant &participant,
   vs->set_normalize_stride(true);
   vs->set_format(toProto(options.format));
 
+  auto hold =
+      FfiClient::instance().holdHandleEvents(FfiEvent::kVideoStreamEvent);
   auto resp = FfiClient::instance().sendRequest(req);
   // Adjust field names to match your proto exactly:
   const auto &stream = resp.video_stream_from_participant().stream();
-  stream_handle_ = FfiHandle(static_cast<uintptr_t>(stream.handle().id()));
+  stream_handle_ = FfiHandle(static_cast<uintptr_t>(stream.handle().id()),
+                             ResourceKind::kVideoStream);
+  subscribeToStreamEvents();
+}
+
+void VideoStream::subscribeToStreamEvents() {
+  // Events are routed by stream handle, so this listener only ever sees
+  // events for this stream.
+  listener_id_ = FfiClient::instance().AddHandleListener(
+      FfiEvent::kVideoStreamEvent,
+      static_cast<std::uint64_t>(stream_handle_.get()),
+      [this](const FfiEvent &e) { this->onFfiEvent(e); });
 }
 
 void VideoStream::onFfiEvent(const proto::FfiEvent &event) {
@@ -178,20 +509,88 @@ void VideoStream::onFfiEvent(const proto::FfiEvent &event) {
   // Handle frame_received or eos.
   if (vse.has_frame_received()) {
     const auto &fr = vse.frame_received();
+    const auto arrived =
+        detail::tracingOn() ? detail::TraceClock::now() : TimePoint{};
+    if (!admitFrame(fr.timestamp_us())) {
+      // Dropping the handle releases the FFI buffer; no pixel is read.
+      FfiHandle released(static_cast<uintptr_t>(fr.buffer().handle().id()),
+                         ResourceKind::kVideoBuffer,
+                         FfiHandle::Disposal::kDeferrable);
+      auto &metrics = detail::SdkMetrics::instance().video;
+      metrics.frames_received.add();
+      metrics.frames_dropped.add();
+      stats_->onReceived();
+      stats_->onEvicted();
+      return;
+    }
 
-    // Convert owned buffer->VideoFrame via a helper.
-    // You should implement this static function in your VideoFrame class.
-    VideoFrame frame = VideoFrame::fromOwnedInfo(fr.buffer());
+    // Either borrow the native buffer or copy (and maybe scale) it into a
+    // pooled frame; the native frame releases the FFI buffer after the copy.
+    // In latest_only mode the copy is left to takeFrame().
+    VideoFrame frame = VideoFrame::wrapOwnedInfo(fr.buffer());
+    if (export_ring_) {
+      export_ring_->write(frame, fr.timestamp_us(),
+                          static_cast<VideoRotation>(fr.rotation()));
+      if (export_only_) {
+        detail::SdkMetrics::instance().video.frames_received.add();
+        stats_->onReceived();
+        stats_->onDelivered();
+        return;
+      }
+    }
+    std::optional<VideoFrameMetadata> metadata;
+    if (read_metadata_) {
+      metadata = detail::readFrameMarker(frame);
+    }
+    int width = 0, height = 0;
+    if (!latest_only_ &&
+        (!zero_copy_ || scaledSize(frame, width, height))) {
+      frame = materialize(frame);
+    }
+    if (arrived != TimePoint{}) {
+      detail::LatencyTracer::instance().record(
+          TraceMedia::kVideo, TraceStage::kReceiveConvert, arrived,
+          detail::TraceClock::now(), fr.timestamp_us());
+    }
 
     VideoFrameEvent ev{std::move(frame), fr.timestamp_us(),
-                       static_cast<VideoRotation>(fr.rotation())};
-    pushFrame(std::move(ev));
+                       static_cast<VideoRotation>(fr.rotation()), metadata};
+    pushFrame(std::move(ev), arrived);
   } else if (vse.has_eos()) {
     pushEos();
   }
 }
 
-void VideoStream::pushFrame(VideoFrameEvent &&ev) {
+void VideoStream::pushFrame(VideoFrameEvent &&ev, TimePoint arrived) {
+  auto &metrics = detail::SdkMetrics::instance().video;
+  metrics.frames_received.add();
+  if (on_frame_) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_ || eof_) {
+        return;
+      }
+    }
+    stats_->onReceived();
+    stats_->onDelivered();
+    deliverToCallback(std::move(ev), arrived);
+    return;
+  }
+  const std::size_t frame_bytes = ev.frame.dataSize();
+  if (ring_) {
+    // Lock-free path: the ring applies drop-oldest itself and wakes a parked
+    // reader only when needed.
+    if (!ring_->closed()) {
+      stats_->onReceived();
+      ring_->push(QueuedFrame{std::move(ev), TimePoint::clock::now(), arrived});
+      const std::size_t depth = ring_->size();
+      stats_->onQueued(depth);
+      metrics.observeRingDrops(ring_->dropped(), metrics_ring_dropped_);
+      metrics.observeDepth(depth, metrics_depth_);
+      metrics.observeBytes(depth * frame_bytes, metrics_bytes_);
+    }
+    return;
+  }
   {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -199,12 +598,25 @@ void VideoStream::pushFrame(VideoFrameEvent &&ev) {
       return;
     }
 
-    if (capacity_ > 0 && queue_.size() >= capacity_) {
-      // Ring behavior: drop oldest frame.
-      queue_.pop_front();
+    stats_->onReceived();
+    const auto now = std::chrono::steady_clock::now();
+    if (latest_only_ && !queue_.empty()) {
+      // Overwrite the slot; the replaced native frame is released here.
+      queue_.front() = QueuedFrame{std::move(ev), now, arrived};
+      metrics.frames_dropped.add();
+      stats_->onEvicted();
+    } else {
+      if (capacity_ > 0 && queue_.size() >= capacity_) {
+        // Ring behavior: drop oldest frame.
+        queue_.pop_front();
+        metrics.frames_dropped.add();
+        stats_->onEvicted();
+      }
+      queue_.push_back(QueuedFrame{std::move(ev), now, arrived});
     }
-
-    queue_.push_back(std::move(ev));
+    stats_->onQueued(queue_.size());
+    metrics.observeDepth(queue_.size(), metrics_depth_);
+    metrics.observeBytes(queue_.size() * frame_bytes, metrics_bytes_);
   }
   cv_.notify_one();
 }
@@ -217,7 +629,53 @@ void VideoStream::pushEos() {
     }
     eof_ = true;
   }
+  if (ring_) {
+    ring_->close();
+  }
   cv_.notify_all();
+
+  if (on_frame_ && on_eos_) {
+    if (callback_executor_) {
+      callback_executor_(on_eos_);
+    } else {
+      on_eos_();
+    }
+  }
+}
+
+void VideoStream::takeFrame(QueuedFrame &queued, VideoFrameEvent &out) {
+  stats_->onDelivered(queued.enqueued, std::chrono::steady_clock::now());
+  out = std::move(queued.event);
+  int width = 0, height = 0;
+  if (latest_only_ && out.frame.isNative() &&
+      (!zero_copy_ || scaledSize(out.frame, width, height))) {
+    // Copy outside the queue lock; dropping the native frame releases the
+    // FFI buffer.
+    out.frame = materialize(out.frame);
+  }
+  if (queued.arrived != TimePoint{}) {
+    auto &tracer = detail::LatencyTracer::instance();
+    const auto now = detail::TraceClock::now();
+    tracer.record(TraceMedia::kVideo, TraceStage::kReceiveQueue,
+                  queued.enqueued, now, out.timestamp_us);
+    tracer.record(TraceMedia::kVideo, TraceStage::kReceiveTotal,
+                  queued.arrived, now, out.timestamp_us);
+  }
+}
+
+void VideoStream::deliverToCallback(VideoFrameEvent &&ev, TimePoint arrived) {
+  if (!callback_executor_) {
+    traceCallback(arrived, ev.timestamp_us);
+    on_frame_(std::move(ev));
+    return;
+  }
+  // std::function needs a copyable target, so the move-only frame travels
+  // behind a shared_ptr.
+  auto frame = std::make_shared<VideoFrameEvent>(std::move(ev));
+  callback_executor_([cb = on_frame_, frame, arrived] {
+    traceCallback(arrived, frame->timestamp_us);
+    cb(std::move(*frame));
+  });
 }
 
 } // namespace livekit
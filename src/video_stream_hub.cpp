@@ -0,0 +1,304 @@
+/*
+ * Copyright 2025 LiveKit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an “AS IS” BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "livekit/video_stream_hub.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "media_stream_stats.h"
+
+namespace livekit {
+
+// --------------------- SharedVideoFrame ---------------------
+
+SharedVideoFrame::SharedVideoFrame(VideoFrame source, std::int64_t timestamp_us,
+                                   VideoRotation rotation,
+                                   std::shared_ptr<VideoFramePool> pool)
+    : source_(std::make_shared<const VideoFrame>(std::move(source))),
+      timestamp_us_(timestamp_us), rotation_(rotation),
+      pool_(std::move(pool)) {}
+
+std::shared_ptr<const VideoFrame>
+SharedVideoFrame::as(VideoBufferType format) const {
+  if (format == source_->type()) {
+    return source_;
+  }
+  // Held across the conversion so concurrent consumers asking for the same
+  // format wait for one result instead of converting twice.
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = conversions_.find(format);
+  if (it != conversions_.end()) {
+    return it->second;
+  }
+  std::shared_ptr<const VideoFrame> converted;
+  if (pool_) {
+    VideoFrame dst =
+        pool_->acquire(source_->width(), source_->height(), format);
+    source_->convertInto(dst);
+    converted = std::make_shared<const VideoFrame>(std::move(dst));
+  } else {
+    converted = std::make_shared<const VideoFrame>(source_->convert(format));
+  }
+  conversions_.emplace(format, converted);
+  return converted;
+}
+
+// --------------------- VideoStreamConsumer ---------------------
+
+VideoStreamConsumer::VideoStreamConsumer(Options options)
+    : options_(options),
+      stats_(std::make_unique<detail::MediaStreamStatsRecorder>()) {}
+
+VideoStreamConsumer::~VideoStreamConsumer() { close(); }
+
+bool VideoStreamConsumer::read(SharedVideoFrameEvent &out) {
+  QueuedFrame queued;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !queue_.empty() || eof_ || closed_; });
+    if (closed_ || queue_.empty()) {
+      return false;
+    }
+    queued = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  take(queued, out);
+  return true;
+}
+
+bool VideoStreamConsumer::tryRead(SharedVideoFrameEvent &out) {
+  QueuedFrame queued;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_ || queue_.empty()) {
+      return false;
+    }
+    queued = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  take(queued, out);
+  return true;
+}
+
+bool VideoStreamConsumer::readFor(SharedVideoFrameEvent &out,
+                                  std::chrono::milliseconds timeout) {
+  QueuedFrame queued;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, timeout,
+                 [this] { return !queue_.empty() || eof_ || closed_; });
+    if (closed_ || queue_.empty()) {
+      return false;
+    }
+    queued = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  take(queued, out);
+  return true;
+}
+
+bool VideoStreamConsumer::isEnded() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return closed_ || (eof_ && queue_.empty());
+}
+
+MediaStreamStats VideoStreamConsumer::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_->snapshot(queue_.size(), 0);
+}
+
+void VideoStreamConsumer::close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) {
+      return;
+    }
+    closed_ = true;
+    queue_.clear(); // release the shared native buffers now
+  }
+  cv_.notify_all();
+}
+
+bool VideoStreamConsumer::deliver(
+    const std::shared_ptr<const SharedVideoFrame> &frame) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) {
+      return false;
+    }
+    if (eof_) {
+      return true;
+    }
+    stats_->onReceived();
+    if (options_.capacity > 0 && queue_.size() >= options_.capacity) {
+      stats_->onEvicted();
+      if (options_.policy == VideoConsumerPolicy::kDropNewest) {
+        return true;
+      }
+      queue_.pop_front();
+    }
+    queue_.push_back(QueuedFrame{frame, std::chrono::steady_clock::now()});
+    stats_->onQueued(queue_.size());
+  }
+  cv_.notify_one();
+  return true;
+}
+
+void VideoStreamConsumer::finish() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    eof_ = true;
+  }
+  cv_.notify_all();
+}
+
+void VideoStreamConsumer::take(QueuedFrame &queued,
+                               SharedVideoFrameEvent &out) {
+  stats_->onDelivered(queued.enqueued, std::chrono::steady_clock::now());
+  out.frame = queued.frame->as(options_.format);
+  out.timestamp_us = queued.frame->timestampUs();
+  out.rotation = queued.frame->rotation();
+}
+
+// --------------------- VideoStreamHub ---------------------
+
+VideoStreamHub::VideoStreamHub(const Options &options)
+    : frame_pool_(options.frame_pool ? options.frame_pool
+                                     : std::make_shared<VideoFramePool>()) {}
+
+VideoStreamHub::~VideoStreamHub() { close(); }
+
+VideoStream::Options VideoStreamHub::streamOptions(const Options &options) {
+  // Push mode with borrowed buffers: the hub takes each frame once, without
+  // a queue hop or a copy, and consumers share it.
+  VideoStream::Options opts;
+  opts.format = options.format;
+  opts.zero_copy = true;
+  opts.on_frame = [this](VideoFrameEvent &&ev) { onFrame(std::move(ev)); };
+  opts.on_eos = [this] { onEos(); };
+  return opts;
+}
+
+std::shared_ptr<VideoStreamHub>
+VideoStreamHub::fromTrack(const std::shared_ptr<Track> &track,
+                          const Options &options) {
+  auto hub = std::shared_ptr<VideoStreamHub>(new VideoStreamHub(options));
+  hub->stream_ = VideoStream::fromTrack(track, hub->streamOptions(options));
+  return hub;
+}
+
+std::shared_ptr<VideoStreamHub>
+VideoStreamHub::fromParticipant(Participant &participant,
+                                TrackSource track_source,
+                                const Options &options) {
+  auto hub = std::shared_ptr<VideoStreamHub>(new VideoStreamHub(options));
+  hub->stream_ = VideoStream::fromParticipant(participant, track_source,
+                                              hub->streamOptions(options));
+  return hub;
+}
+
+std::shared_ptr<VideoStreamConsumer>
+VideoStreamHub::addConsumer(const VideoStreamConsumer::Options &options) {
+  auto consumer =
+      std::shared_ptr<VideoStreamConsumer>(new VideoStreamConsumer(options));
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ended_) {
+    consumer->finish();
+  } else {
+    consumers_.push_back(consumer);
+  }
+  return consumer;
+}
+
+std::size_t VideoStreamHub::consumerCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::size_t n = 0;
+  for (const auto &weak : consumers_) {
+    if (auto consumer = weak.lock()) {
+      n += consumer->isEnded() ? 0 : 1;
+    }
+  }
+  return n;
+}
+
+MediaStreamStats VideoStreamHub::stats() const {
+  return stream_ ? stream_->stats() : MediaStreamStats{};
+}
+
+void VideoStreamHub::close() {
+  // Stop the producer first so onFrame() cannot race the teardown.
+  if (stream_) {
+    stream_->close();
+  }
+  onEos();
+}
+
+void VideoStreamHub::onFrame(VideoFrameEvent &&ev) {
+  std::vector<std::shared_ptr<VideoStreamConsumer>> live;
+  bool prune = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    live.reserve(consumers_.size());
+    for (const auto &weak : consumers_) {
+      if (auto consumer = weak.lock()) {
+        live.push_back(std::move(consumer));
+      } else {
+        prune = true;
+      }
+    }
+  }
+  // With no consumer the native buffer is released without any copy.
+  if (!live.empty()) {
+    auto frame = std::make_shared<const SharedVideoFrame>(
+        std::move(ev.frame), ev.timestamp_us, ev.rotation, frame_pool_);
+    for (auto &consumer : live) {
+      if (!consumer->deliver(frame)) {
+        prune = true;
+      }
+    }
+  }
+  if (prune) {
+    // Forget closed and destroyed consumers.
+    std::lock_guard<std::mutex> lock(mutex_);
+    consumers_.erase(
+        std::remove_if(consumers_.begin(), consumers_.end(),
+                       [](const std::weak_ptr<VideoStreamConsumer> &weak) {
+                         auto consumer = weak.lock();
+                         return !consumer || consumer->isEnded();
+                       }),
+        consumers_.end());
+  }
+}
+
+void VideoStreamHub::onEos() {
+  std::vector<std::weak_ptr<VideoStreamConsumer>> consumers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ended_) {
+      return;
+    }
+    ended_ = true;
+    consumers.swap(consumers_);
+  }
+  for (const auto &weak : consumers) {
+    if (auto consumer = weak.lock()) {
+      consumer->finish();
+    }
+  }
+}
+
+} // namespace livekit
@@ -88,6 +88,12 @@ VideoBufferType fromProto(proto::VideoBufferType t) {
 
 proto::VideoBufferInfo toProto(const VideoFrame &frame) {
   proto::VideoBufferInfo info;
+  toProto(frame, &info);
+  return info;
+}
+
+void toProto(const VideoFrame &frame, proto::VideoBufferInfo *out) {
+  proto::VideoBufferInfo &info = *out;
 
   const int w = frame.width();
   const int h = frame.height();
@@ -100,7 +106,8 @@ proto::VideoBufferInfo toProto(const VideoFrame &frame) {
   info.set_data_ptr(base_ptr);
 
   // Compute plane layout for the current format
-  auto planes = frame.planeInfos();
+  const VideoPlanes planes = frame.planes();
+  info.clear_components();
   for (const auto &plane : planes) {
     auto *cmpt = info.add_components();
     cmpt->set_data_ptr(static_cast<std::uint64_t>(plane.data_ptr));
@@ -108,24 +115,13 @@ proto::VideoBufferInfo toProto(const VideoFrame &frame) {
     cmpt->set_size(plane.size);
   }
 
-  // Stride for main packed formats.
-  std::uint32_t stride = 0;
-  switch (frame.type()) {
-  case VideoBufferType::ARGB:
-  case VideoBufferType::ABGR:
-  case VideoBufferType::RGBA:
-  case VideoBufferType::BGRA:
-    stride = static_cast<std::uint32_t>(w) * 4;
-    break;
-  case VideoBufferType::RGB24:
-    stride = static_cast<std::uint32_t>(w) * 3;
-    break;
-  default:
-    stride = 0; // not used / unknown for planar formats
-    break;
-  }
+  // Stride for packed (single-plane) formats, taken from the plane so padded
+  // rows (VideoFrame::wrapExternal()) reach the FFI unchanged; unused for
+  // planar formats.
+  const bool packed = videoFormatLayout(frame.type()).num_planes == 1;
+  const std::uint32_t stride =
+      packed && !planes.empty() ? planes[0].stride : 0;
   info.set_stride(stride);
-  return info;
 }
 
 VideoFrame fromOwnedProto(const proto::OwnedVideoBuffer &owned) {
@@ -152,7 +148,8 @@ VideoFrame fromOwnedProto(const proto::OwnedVideoBuffer &owned) {
 
   // Drop the owned FFI handle to let the core free its side.
   {
-    FfiHandle tmp(owned.handle().id());
+    FfiHandle tmp(owned.handle().id(), ResourceKind::kVideoBuffer,
+                  FfiHandle::Disposal::kDeferrable);
     // tmp destructor will dispose the handle via FFI.
   }
 
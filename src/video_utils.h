@@ -23,6 +23,8 @@ namespace livekit {
 
 // Video FFI Utils
 proto::VideoBufferInfo toProto(const VideoFrame &frame);
+// Fills `info` in place, e.g. a field of an arena-allocated request.
+void toProto(const VideoFrame &frame, proto::VideoBufferInfo *info);
 VideoFrame fromOwnedProto(const proto::OwnedVideoBuffer &owned);
 VideoFrame convertViaFfi(const VideoFrame &frame, VideoBufferType dst,
                            bool flip_y);